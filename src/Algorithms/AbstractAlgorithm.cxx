@@ -23,7 +23,17 @@
 using namespace std;
 using namespace caret;
 
-AbstractAlgorithm::AbstractAlgorithm(ProgressObject* myProgressObject)
+AbstractAlgorithm::AbstractAlgorithm(ProgressObject* myProgressObject) : m_profileScope("unnamed algorithm", "algorithm")
+{
+    initProgress(myProgressObject);
+}
+
+AbstractAlgorithm::AbstractAlgorithm(ProgressObject* myProgressObject, const AString& profileName) : m_profileScope(profileName, "algorithm")
+{
+    initProgress(myProgressObject);
+}
+
+void AbstractAlgorithm::initProgress(ProgressObject* myProgressObject)
 {
     m_progObj = myProgressObject;
     m_finish = true;
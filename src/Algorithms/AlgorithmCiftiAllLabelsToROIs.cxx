@@ -22,8 +22,11 @@
 #include "AlgorithmException.h"
 
 #include "CiftiFile.h"
+#include "CiftiRowStreamHelper.h"
 #include "GiftiLabelTable.h"
+#include "LabelKeyRemap.h"
 
+#include <algorithm>
 #include <cmath>
 #include <map>
 #include <vector>
@@ -31,6 +34,23 @@
 using namespace caret;
 using namespace std;
 
+namespace
+{
+    class AllLabelsRowFunction : public CiftiRowStreamHelper::RowFunction
+    {
+        const LabelKeyRemap& m_keyToMap;
+        int m_whichMap;
+    public:
+        AllLabelsRowFunction(const LabelKeyRemap& keyToMap, const int& whichMap) : m_keyToMap(keyToMap), m_whichMap(whichMap) { }
+        void processRow(const float* inRow, const int64_t&, float* outRow, const int64_t& outRowLength, const int64_t&)
+        {//one lookup per row gives the single map that gets a 1
+            fill(outRow, outRow + outRowLength, 0.0f);
+            int32_t outMap = m_keyToMap.remap((int32_t)floor(inRow[m_whichMap] + 0.5f));
+            if (outMap >= 0) outRow[outMap] = 1.0f;
+        }
+    };
+}
+
 AString AlgorithmCiftiAllLabelsToROIs::getCommandSwitch()
 {
     return "-cifti-all-labels-to-rois";
@@ -74,7 +94,7 @@ void AlgorithmCiftiAllLabelsToROIs::useParameters(OperationParameters* myParams,
     AlgorithmCiftiAllLabelsToROIs(myProgObj, myLabel, whichMap, myCiftiOut);
 }
 
-AlgorithmCiftiAllLabelsToROIs::AlgorithmCiftiAllLabelsToROIs(ProgressObject* myProgObj, const CiftiFile* myLabel, const int& whichMap, CiftiFile* myCiftiOut) : AbstractAlgorithm(myProgObj)
+AlgorithmCiftiAllLabelsToROIs::AlgorithmCiftiAllLabelsToROIs(ProgressObject* myProgObj, const CiftiFile* myLabel, const int& whichMap, CiftiFile* myCiftiOut) : AbstractAlgorithm(myProgObj, getCommandSwitch())
 {
     LevelProgress myProgress(myProgObj);
     const CiftiXMLOld& myXML = myLabel->getCiftiXMLOld();
@@ -90,7 +110,7 @@ AlgorithmCiftiAllLabelsToROIs::AlgorithmCiftiAllLabelsToROIs(ProgressObject* myP
     {
         throw AlgorithmException("label table doesn't contain any keys besides the ??? key");
     }
-    map<int32_t, int> keyToMap;//lookup from keys to column
+    map<int32_t, int32_t> keyToMap;//lookup from keys to column
     CiftiXMLOld outXML = myXML;
     outXML.resetDirectionToScalars(CiftiXMLOld::ALONG_ROW, numKeys - 1);
     int counter = 0;
@@ -102,23 +122,9 @@ AlgorithmCiftiAllLabelsToROIs::AlgorithmCiftiAllLabelsToROIs(ProgressObject* myP
         ++counter;
     }
     myCiftiOut->setCiftiXML(outXML);
-    vector<float> outRowScratch(numKeys - 1, 0.0f), inRowScratch(myXML.getNumberOfColumns());
-    int64_t numRows = myXML.getNumberOfRows();
-    for (int64_t i = 0; i < numRows; ++i)
-    {
-        myLabel->getRow(inRowScratch.data(), i);
-        int32_t thisKey = (int32_t)floor(inRowScratch[whichMap] + 0.5f);
-        map<int32_t, int>::iterator iter = keyToMap.find(thisKey);
-        if (iter != keyToMap.end())
-        {
-            outRowScratch[iter->second] = 1.0f;//set the single element for the correct map
-        }
-        myCiftiOut->setRow(outRowScratch.data(), i);
-        if (iter != keyToMap.end())
-        {
-            outRowScratch[iter->second] = 0.0f;//and rezero it to get ready for the next row
-        }
-    }
+    const LabelKeyRemap keyLookup(keyToMap, -1);//keys not in the table, and the ??? key, aren't in any output map
+    AllLabelsRowFunction myFunction(keyLookup, whichMap);
+    CiftiRowStreamHelper::streamRows(myLabel, myCiftiOut, &myFunction);
 }
 
 float AlgorithmCiftiAllLabelsToROIs::getAlgorithmInternalWeight()
@@ -36,6 +36,34 @@
 using namespace caret;
 using namespace std;
 
+namespace
+{
+    //three dot products sharing the second vector, with split accumulators so the compiler can vectorize
+    void dotProduct3(const float* a0, const float* a1, const float* a2, const float* b, const int& length, float& r0, float& r1, float& r2)
+    {
+        float s0[4] = { 0.0f, 0.0f, 0.0f, 0.0f }, s1[4] = { 0.0f, 0.0f, 0.0f, 0.0f }, s2[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+        int i = 0;
+        for (; i + 3 < length; i += 4)
+        {
+            for (int k = 0; k < 4; ++k)
+            {
+                s0[k] += a0[i + k] * b[i + k];
+                s1[k] += a1[i + k] * b[i + k];
+                s2[k] += a2[i + k] * b[i + k];
+            }
+        }
+        for (; i < length; ++i)
+        {
+            s0[0] += a0[i] * b[i];
+            s1[0] += a1[i] * b[i];
+            s2[0] += a2[i] * b[i];
+        }
+        r0 = (s0[0] + s0[1]) + (s0[2] + s0[3]);
+        r1 = (s1[0] + s1[1]) + (s1[2] + s1[3]);
+        r2 = (s2[0] + s2[1]) + (s2[2] + s2[3]);
+    }
+}
+
 AString AlgorithmCiftiCorrelationGradient::getCommandSwitch()
 {
     return "-cifti-correlation-gradient";
@@ -186,7 +214,7 @@ AlgorithmCiftiCorrelationGradient::AlgorithmCiftiCorrelationGradient(ProgressObj
                                                                      SurfaceFile* myLeftSurf, SurfaceFile* myRightSurf, SurfaceFile* myCerebSurf,
                                                                      const MetricFile* myLeftAreas, const MetricFile* myRightAreas, const MetricFile* myCerebAreas,
                                                                      const float& surfKern, const float& volKern, const bool& undoFisherInput, const bool& applyFisher,
-                                                                     const float& surfaceExclude, const float& volumeExclude, const float& memLimitGB) : AbstractAlgorithm(myProgObj)
+                                                                     const float& surfaceExclude, const float& volumeExclude, const float& memLimitGB) : AbstractAlgorithm(myProgObj, getCommandSwitch())
 {
     LevelProgress myProgress(myProgObj);
     init(myCifti, undoFisherInput, applyFisher);
@@ -261,7 +289,10 @@ AlgorithmCiftiCorrelationGradient::AlgorithmCiftiCorrelationGradient(ProgressObj
         {
             processSurfaceComponent(surfaceList[whichStruct], surfKern, surfaceExclude, memLimitGB, mySurf, myAreas);
         } else {
-            processSurfaceComponent(surfaceList[whichStruct], surfKern, memLimitGB, mySurf, myAreas);
+            if (!processSurfaceComponentLowRank(surfaceList[whichStruct], surfKern, memLimitGB, mySurf, myAreas))
+            {
+                processSurfaceComponent(surfaceList[whichStruct], surfKern, memLimitGB, mySurf, myAreas);
+            }
         }
     }
     for (int whichStruct = 0; whichStruct < (int)volumeList.size(); ++whichStruct)
@@ -579,6 +610,121 @@ void AlgorithmCiftiCorrelationGradient::processSurfaceComponent(StructureEnum::E
     }
 }
 
+//the correlation of two rows is the dot product of their demeaned, unit length rows, so the correlation matrix of a structure is Z * Z', where Z only has as many
+//columns as the input has timepoints - surface smoothing and the gradient regression are linear, so they are applied to Z once instead of to every column of the
+//correlation matrix, which leaves only the gradient magnitudes, computed in blocks of rows and columns so the operands stay in cache
+//returns false when this method doesn't apply (fisher output, constant rows) or doesn't fit in the memory limit, so the caller can use the general method
+bool AlgorithmCiftiCorrelationGradient::processSurfaceComponentLowRank(StructureEnum::Enum& myStructure, const float& surfKern, const float& memLimitGB, SurfaceFile* mySurf, const MetricFile* myAreas)
+{
+    if (m_applyFisher) return false;//fisher transform of the correlation is not linear
+    const CiftiXMLOld& myXML = m_inputCifti->getCiftiXMLOld();
+    vector<CiftiSurfaceMap> myMap;
+    myXML.getSurfaceMapForColumns(myMap, myStructure);
+    int mapSize = (int)myMap.size();
+    int numNodes = mySurf->getNumberOfNodes();
+    if (mapSize < 1 || m_numCols < 1) return false;
+    int64_t factorRows = numNodes + 3 * (int64_t)mapSize;//factor, and the gradient operator applied to the factor
+    if (surfKern > 0.0f) factorRows += numNodes;//smoothed factor
+    if (memLimitGB >= 0.0f && factorRows * m_numCols * (int64_t)sizeof(float) > (int64_t)(memLimitGB * 1024 * 1024 * 1024))
+    {
+        return false;
+    }
+    vector<float> factor((int64_t)numNodes * m_numCols, 0.0f);
+    for (int i = 0; i < mapSize; ++i)
+    {
+        float rrs;
+        const float* myRow = getRow(myMap[i].m_ciftiIndex, rrs);
+        if (!(rrs > 0.0f)) return false;//constant rows make NaN correlations, leave them to the general method
+        float* factorRow = factor.data() + (int64_t)myMap[i].m_surfaceNode * m_numCols;
+        for (int t = 0; t < m_numCols; ++t)
+        {
+            factorRow[t] = myRow[t] / rrs;
+        }
+    }
+    const float* areaData = NULL;
+    if (myAreas != NULL)
+    {
+        areaData = myAreas->getValuePointerForColumn(0);
+    }
+    MetricFile myRoi;
+    myRoi.setNumberOfNodesAndColumns(numNodes, 1);
+    myRoi.initializeColumn(0);
+    for (int i = 0; i < mapSize; ++i)
+    {
+        myRoi.setValue(myMap[i].m_surfaceNode, 0, 1.0f);
+    }
+    vector<float> smoothedFactor;
+    const float* gradientInput = factor.data();
+    if (surfKern > 0.0f)
+    {
+        MetricSmoothingObject mySmooth(mySurf, surfKern, &myRoi, MetricSmoothingObject::GEO_GAUSS_AREA, areaData);
+        smoothedFactor.resize((int64_t)numNodes * m_numCols);
+        mySmooth.smoothNodeVectors(factor.data(), m_numCols, smoothedFactor.data());
+        gradientInput = smoothedFactor.data();
+    }
+    vector<vector<int32_t> > gradNeighbors;
+    vector<vector<float> > gradWeights;
+    AlgorithmMetricGradient::computeLinearWeights(mySurf, myRoi.getValuePointerForColumn(0), myAreas, gradNeighbors, gradWeights);
+    int64_t opStride = 3 * (int64_t)m_numCols;
+    vector<float> gradOperator(mapSize * opStride, 0.0f);//x, y, z components of the gradient of every correlation column at this vertex, as rows to dot with Z
+#pragma omp CARET_PARFOR schedule(dynamic)
+    for (int i = 0; i < mapSize; ++i)
+    {
+        int node = myMap[i].m_surfaceNode;
+        const vector<int32_t>& neighRef = gradNeighbors[node];
+        const vector<float>& weightRef = gradWeights[node];
+        const float* centerRow = gradientInput + (int64_t)node * m_numCols;
+        float* opX = gradOperator.data() + i * opStride;
+        float* opY = opX + m_numCols;
+        float* opZ = opY + m_numCols;
+        int numNeigh = (int)neighRef.size();
+        for (int k = 0; k < numNeigh; ++k)
+        {
+            const float* neighRow = gradientInput + (int64_t)neighRef[k] * m_numCols;
+            float wx = weightRef[k * 3], wy = weightRef[k * 3 + 1], wz = weightRef[k * 3 + 2];
+            for (int t = 0; t < m_numCols; ++t)
+            {
+                float diff = neighRow[t] - centerRow[t];
+                opX[t] += wx * diff;
+                opY[t] += wy * diff;
+                opZ[t] += wz * diff;
+            }
+        }
+    }
+    vector<float>().swap(smoothedFactor);//release before the expensive part
+    const int blockSize = 32;//rows of the operator and of Z handled together, small enough that both blocks stay in cache
+    int numBlocks = (mapSize + blockSize - 1) / blockSize;
+    vector<double> accum(mapSize, 0.0);
+#pragma omp CARET_PARFOR schedule(dynamic)
+    for (int iBlock = 0; iBlock < numBlocks; ++iBlock)
+    {
+        int istart = iBlock * blockSize;
+        int iend = min(istart + blockSize, mapSize);
+        for (int jstart = 0; jstart < mapSize; jstart += blockSize)
+        {
+            int jend = min(jstart + blockSize, mapSize);
+            for (int i = istart; i < iend; ++i)
+            {
+                const float* opX = gradOperator.data() + i * opStride;
+                double blockSum = 0.0;
+                for (int j = jstart; j < jend; ++j)
+                {
+                    const float* zRow = factor.data() + (int64_t)myMap[j].m_surfaceNode * m_numCols;
+                    float gx, gy, gz;
+                    dotProduct3(opX, opX + m_numCols, opX + 2 * m_numCols, zRow, m_numCols, gx, gy, gz);
+                    blockSum += sqrt(gx * gx + gy * gy + gz * gz);
+                }
+                accum[i] += blockSum;
+            }
+        }
+    }
+    for (int i = 0; i < mapSize; ++i)
+    {
+        m_outColumn[myMap[i].m_ciftiIndex] = accum[i] / mapSize;
+    }
+    return true;
+}
+
 void AlgorithmCiftiCorrelationGradient::processVolumeComponent(StructureEnum::Enum& myStructure, const float& volKern, const float& memLimitGB)
 {
     const CiftiXMLOld& myXML = m_inputCifti->getCiftiXMLOld();
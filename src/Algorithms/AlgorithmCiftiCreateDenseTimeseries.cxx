@@ -145,7 +145,7 @@ void AlgorithmCiftiCreateDenseTimeseries::useParameters(OperationParameters* myP
 AlgorithmCiftiCreateDenseTimeseries::AlgorithmCiftiCreateDenseTimeseries(ProgressObject* myProgObj, CiftiFile* myCiftiOut, const VolumeFile* myVol,
                                                                          const VolumeFile* myVolLabel, const MetricFile* leftData, const MetricFile* leftRoi,
                                                                          const MetricFile* rightData, const MetricFile* rightRoi, const MetricFile* cerebData,
-                                                                         const MetricFile* cerebRoi, const float& timestep, const float& timestart) : AbstractAlgorithm(myProgObj)
+                                                                         const MetricFile* cerebRoi, const float& timestep, const float& timestart) : AbstractAlgorithm(myProgObj, getCommandSwitch())
 {
     CaretAssert(myCiftiOut != NULL);
     LevelProgress myProgress(myProgObj);
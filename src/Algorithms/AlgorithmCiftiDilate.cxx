@@ -27,14 +27,153 @@
 #include "AlgorithmMetricDilate.h"
 #include "AlgorithmVolumeDilate.h"
 #include "CiftiFile.h"
+#include "CiftiRowStreamHelper.h"
 #include "LabelFile.h"
 #include "MetricFile.h"
 #include "SurfaceFile.h"
 #include "VolumeFile.h"
 
+#include <algorithm>
+
 using namespace caret;
 using namespace std;
 
+namespace
+{
+    ///dilates all structures of a file along one direction, or blocks of rows of a file in the row direction
+    class DilateBlockFunction : public CiftiRowStreamHelper::BlockFunction
+    {
+        const CiftiXMLOld& m_xml;
+        const vector<StructureEnum::Enum>& m_surfaceList, m_volumeList;
+        float m_surfDist, m_volDist;
+        const SurfaceFile* m_leftSurf, *m_rightSurf, *m_cerebSurf;
+        const CiftiFile* m_roi;
+        bool m_nearest, m_mergedVolume;
+        //every block has the same mapping, and often the same bad brainordinates, so keep each structure's plan for the following blocks
+        vector<AlgorithmMetricDilate::PlanCache> m_surfPlans;
+        vector<AlgorithmVolumeDilate::PlanCache> m_volPlans;
+        AlgorithmVolumeDilate::PlanCache m_mergedVolPlan;
+    public:
+        DilateBlockFunction(const CiftiXMLOld& myXML, const vector<StructureEnum::Enum>& surfaceList, const vector<StructureEnum::Enum>& volumeList,
+                            const float& surfDist, const float& volDist, const SurfaceFile* myLeftSurf, const SurfaceFile* myRightSurf, const SurfaceFile* myCerebSurf,
+                            const CiftiFile* myRoi, const bool& nearest, const bool& mergedVolume) : m_xml(myXML), m_surfaceList(surfaceList), m_volumeList(volumeList)
+        {
+            m_surfDist = surfDist;
+            m_volDist = volDist;
+            m_leftSurf = myLeftSurf;
+            m_rightSurf = myRightSurf;
+            m_cerebSurf = myCerebSurf;
+            m_roi = myRoi;
+            m_nearest = nearest;
+            m_mergedVolume = mergedVolume;
+            m_surfPlans.resize(m_surfaceList.size());
+            m_volPlans.resize(m_volumeList.size());
+        }
+        
+        void dilateFile(const CiftiFile* myCifti, const int& myDir, CiftiFile* myCiftiOut)
+        {//output xml must already be set, label or metric dilation is decided by the original xml, not a block's scalar columns
+            for (int whichStruct = 0; whichStruct < (int)m_surfaceList.size(); ++whichStruct)
+            {
+                const SurfaceFile* mySurf = NULL;
+                switch (m_surfaceList[whichStruct])
+                {
+                    case StructureEnum::CORTEX_LEFT:
+                        mySurf = m_leftSurf;
+                        break;
+                    case StructureEnum::CORTEX_RIGHT:
+                        mySurf = m_rightSurf;
+                        break;
+                    case StructureEnum::CEREBELLUM:
+                        mySurf = m_cerebSurf;
+                        break;
+                    default:
+                        break;
+                }
+                MetricFile roiMetric, dataRoiMetric;
+                MetricFile* roiPtr = NULL;
+                if (m_roi != NULL)
+                {
+                    AlgorithmCiftiSeparate(NULL, m_roi, CiftiXMLOld::ALONG_COLUMN, m_surfaceList[whichStruct], &roiMetric);
+                    roiPtr = &roiMetric;
+                }
+                if (m_xml.getMappingType(1 - myDir) == CIFTI_INDEX_TYPE_LABELS)
+                {
+                    LabelFile myLabel, myLabelOut;
+                    AlgorithmCiftiSeparate(NULL, myCifti, myDir, m_surfaceList[whichStruct], &myLabel);
+                    AlgorithmLabelDilate(NULL, &myLabel, mySurf, m_surfDist, &myLabelOut, roiPtr);
+                    AlgorithmCiftiReplaceStructure(NULL, myCiftiOut, myDir, m_surfaceList[whichStruct], &myLabelOut);
+                } else {
+                    MetricFile myMetric, myMetricOut;
+                    AlgorithmCiftiSeparate(NULL, myCifti, myDir, m_surfaceList[whichStruct], &myMetric, &dataRoiMetric);
+                    AlgorithmMetricDilate(NULL, &myMetric, mySurf, m_surfDist, &myMetricOut, roiPtr, &dataRoiMetric, -1, m_nearest, false, 2.0f, &m_surfPlans[whichStruct]);
+                    AlgorithmCiftiReplaceStructure(NULL, myCiftiOut, myDir, m_surfaceList[whichStruct], &myMetricOut);
+                }
+            }
+            if (m_mergedVolume)
+            {
+                if (m_xml.hasVolumeData(myDir))
+                {
+                    VolumeFile myVol, roiVol, myVolOut;
+                    VolumeFile* roiPtr = NULL;
+                    int64_t offset[3];
+                    AlgorithmVolumeDilate::Method myMethod = AlgorithmVolumeDilate::WEIGHTED;
+                    if (m_nearest || m_xml.getMappingType(1 - myDir) == CIFTI_INDEX_TYPE_LABELS)
+                    {
+                        myMethod = AlgorithmVolumeDilate::NEAREST;
+                    }
+                    if (m_roi != NULL)
+                    {
+                        AlgorithmCiftiSeparate(NULL, m_roi, CiftiXMLOld::ALONG_COLUMN, &roiVol, offset, NULL, true);
+                        roiPtr = &roiVol;
+                    }
+                    AlgorithmCiftiSeparate(NULL, myCifti, myDir, &myVol, offset, NULL, true);
+                    AlgorithmVolumeDilate(NULL, &myVol, m_volDist, myMethod, &myVolOut, roiPtr, NULL, -1, &m_mergedVolPlan);
+                    AlgorithmCiftiReplaceStructure(NULL, myCiftiOut, myDir, &myVolOut, true);
+                }
+            } else {
+                AlgorithmVolumeDilate::Method myMethod = AlgorithmVolumeDilate::WEIGHTED;
+                if (m_nearest || m_xml.getMappingType(1 - myDir) == CIFTI_INDEX_TYPE_LABELS)
+                {
+                    myMethod = AlgorithmVolumeDilate::NEAREST;
+                }
+                for (int whichStruct = 0; whichStruct < (int)m_volumeList.size(); ++whichStruct)
+                {
+                    VolumeFile myVol, badRoiVol, myVolOut, dataRoiVol;
+                    VolumeFile* roiPtr = NULL;
+                    int64_t offset[3];
+                    if (m_roi != NULL)
+                    {
+                        AlgorithmCiftiSeparate(NULL, m_roi, CiftiXMLOld::ALONG_COLUMN, m_volumeList[whichStruct], &badRoiVol, offset, NULL, true);
+                        roiPtr = &badRoiVol;
+                    }
+                    AlgorithmCiftiSeparate(NULL, myCifti, myDir, m_volumeList[whichStruct], &myVol, offset, &dataRoiVol, true);
+                    AlgorithmVolumeDilate(NULL, &myVol, m_volDist, myMethod, &myVolOut, roiPtr, &dataRoiVol, -1, &m_volPlans[whichStruct]);
+                    AlgorithmCiftiReplaceStructure(NULL, myCiftiOut, myDir, m_volumeList[whichStruct], &myVolOut, true);
+                }
+            }
+        }
+        
+        void processBlock(const float* inRows, const int64_t& inRowLength, float* outRows, const int64_t& outRowLength,
+                          const int64_t&, const int64_t& numRows)
+        {//rows are dilated independently in the row direction, so a block of rows is a complete in-memory file with scalar columns
+            CiftiXMLOld blockXML = m_xml;
+            blockXML.resetColumnsToScalars(numRows);
+            CiftiFile blockIn, blockOut;
+            blockIn.setCiftiXML(blockXML);
+            blockIn.setRows(inRows, 0, numRows);
+            blockOut.setCiftiXML(blockXML);
+            dilateFile(&blockIn, CiftiXMLOld::ALONG_ROW, &blockOut);
+            fill(outRows, outRows + numRows * outRowLength, 0.0f);
+            blockOut.getRows(outRows, 0, numRows);
+        }
+        
+        int64_t getExtraBytesPerRow(const int64_t& inRowLength, const int64_t& outRowLength) const
+        {//in-memory block files, plus the separated input and dilated output of one structure
+            return 2 * (inRowLength + outRowLength) * (int64_t)sizeof(float);
+        }
+    };
+}
+
 AString AlgorithmCiftiDilate::getCommandSwitch()
 {
     return "-cifti-dilate";
@@ -129,7 +268,7 @@ void AlgorithmCiftiDilate::useParameters(OperationParameters* myParams, Progress
 
 AlgorithmCiftiDilate::AlgorithmCiftiDilate(ProgressObject* myProgObj, const CiftiFile* myCifti, const int& myDir, const float& surfDist, const float& volDist, CiftiFile* myCiftiOut,
                                            const SurfaceFile* myLeftSurf, const SurfaceFile* myRightSurf, const SurfaceFile* myCerebSurf,
-                                           const CiftiFile* myRoi, const bool& nearest, const bool& mergedVolume) : AbstractAlgorithm(myProgObj)
+                                           const CiftiFile* myRoi, const bool& nearest, const bool& mergedVolume) : AbstractAlgorithm(myProgObj, getCommandSwitch())
 {
     LevelProgress myProgress(myProgObj);
     CiftiXMLOld myXML = myCifti->getCiftiXMLOld();
@@ -172,84 +311,12 @@ AlgorithmCiftiDilate::AlgorithmCiftiDilate(ProgressObject* myProgObj, const Cift
         }
     }
     myCiftiOut->setCiftiXML(myXML);
-    for (int whichStruct = 0; whichStruct < (int)surfaceList.size(); ++whichStruct)
-    {
-        const SurfaceFile* mySurf = NULL;
-        switch (surfaceList[whichStruct])
-        {
-            case StructureEnum::CORTEX_LEFT:
-                mySurf = myLeftSurf;
-                break;
-            case StructureEnum::CORTEX_RIGHT:
-                mySurf = myRightSurf;
-                break;
-            case StructureEnum::CEREBELLUM:
-                mySurf = myCerebSurf;
-                break;
-            default:
-                break;
-        }
-        MetricFile roiMetric, dataRoiMetric;
-        MetricFile* roiPtr = NULL;
-        if (myRoi != NULL)
-        {
-            AlgorithmCiftiSeparate(NULL, myRoi, CiftiXMLOld::ALONG_COLUMN, surfaceList[whichStruct], &roiMetric);
-            roiPtr = &roiMetric;
-        }
-        if (myXML.getMappingType(1 - myDir) == CIFTI_INDEX_TYPE_LABELS)
-        {
-            LabelFile myLabel, myLabelOut;
-            AlgorithmCiftiSeparate(NULL, myCifti, myDir, surfaceList[whichStruct], &myLabel);
-            AlgorithmLabelDilate(NULL, &myLabel, mySurf, surfDist, &myLabelOut, roiPtr);
-            AlgorithmCiftiReplaceStructure(NULL, myCiftiOut, myDir, surfaceList[whichStruct], &myLabelOut);
-        } else {
-            MetricFile myMetric, myMetricOut;
-            AlgorithmCiftiSeparate(NULL, myCifti, myDir, surfaceList[whichStruct], &myMetric, &dataRoiMetric);
-            AlgorithmMetricDilate(NULL, &myMetric, mySurf, surfDist, &myMetricOut, roiPtr, &dataRoiMetric, -1, nearest);
-            AlgorithmCiftiReplaceStructure(NULL, myCiftiOut, myDir, surfaceList[whichStruct], &myMetricOut);
-        }
-    }
-    if (mergedVolume)
-    {
-        if (myCifti->getCiftiXMLOld().hasVolumeData(myDir))
-        {
-            VolumeFile myVol, roiVol, myVolOut;
-            VolumeFile* roiPtr = NULL;
-            int64_t offset[3];
-            AlgorithmVolumeDilate::Method myMethod = AlgorithmVolumeDilate::WEIGHTED;
-            if (nearest || myXML.getMappingType(1 - myDir) == CIFTI_INDEX_TYPE_LABELS)
-            {
-                myMethod = AlgorithmVolumeDilate::NEAREST;
-            }
-            if (myRoi != NULL)
-            {
-                AlgorithmCiftiSeparate(NULL, myRoi, CiftiXMLOld::ALONG_COLUMN, &roiVol, offset, NULL, true);
-                roiPtr = &roiVol;
-            }
-            AlgorithmCiftiSeparate(NULL, myCifti, myDir, &myVol, offset, NULL, true);
-            AlgorithmVolumeDilate(NULL, &myVol, volDist, myMethod, &myVolOut, roiPtr);
-            AlgorithmCiftiReplaceStructure(NULL, myCiftiOut, myDir, &myVolOut, true);
-        }
+    DilateBlockFunction myFunction(myXML, surfaceList, volumeList, surfDist, volDist, myLeftSurf, myRightSurf, myCerebSurf, myRoi, nearest, mergedVolume);
+    if (myDir == CiftiXMLOld::ALONG_ROW && myXML.getMappingType(CiftiXMLOld::ALONG_COLUMN) != CIFTI_INDEX_TYPE_LABELS)
+    {//each row is dilated on its own, so stream blocks of rows to bound memory use on large files, label tables can't be split into blocks
+        CiftiRowStreamHelper::streamRows(myCifti, myCiftiOut, &myFunction);
     } else {
-        AlgorithmVolumeDilate::Method myMethod = AlgorithmVolumeDilate::WEIGHTED;
-        if (nearest || myXML.getMappingType(1 - myDir) == CIFTI_INDEX_TYPE_LABELS)
-        {
-            myMethod = AlgorithmVolumeDilate::NEAREST;
-        }
-        for (int whichStruct = 0; whichStruct < (int)volumeList.size(); ++whichStruct)
-        {
-            VolumeFile myVol, badRoiVol, myVolOut, dataRoiVol;
-            VolumeFile* roiPtr = NULL;
-            int64_t offset[3];
-            if (myRoi != NULL)
-            {
-                AlgorithmCiftiSeparate(NULL, myRoi, CiftiXMLOld::ALONG_COLUMN, volumeList[whichStruct], &badRoiVol, offset, NULL, true);
-                roiPtr = &badRoiVol;
-            }
-            AlgorithmCiftiSeparate(NULL, myCifti, myDir, volumeList[whichStruct], &myVol, offset, &dataRoiVol, true);
-            AlgorithmVolumeDilate(NULL, &myVol, volDist, myMethod, &myVolOut, roiPtr, &dataRoiVol);
-            AlgorithmCiftiReplaceStructure(NULL, myCiftiOut, myDir, volumeList[whichStruct], &myVolOut, true);
-        }
+        myFunction.dilateFile(myCifti, myDir, myCiftiOut);
     }
 }
 
@@ -124,7 +124,7 @@ void AlgorithmCiftiGradient::useParameters(OperationParameters* myParams, Progre
 
 AlgorithmCiftiGradient::AlgorithmCiftiGradient(ProgressObject* myProgObj, const CiftiFile* myCifti, const int& myDir,
                                                CiftiFile* myCiftiOut, const float& surfKern, const float& volKern, SurfaceFile* myLeftSurf, SurfaceFile* myRightSurf,
-                                               SurfaceFile* myCerebSurf, bool outputAverage) : AbstractAlgorithm(myProgObj)
+                                               SurfaceFile* myCerebSurf, bool outputAverage) : AbstractAlgorithm(myProgObj, getCommandSwitch())
 {
     LevelProgress myProgress(myProgObj);
     const CiftiXMLOld& myXML = myCifti->getCiftiXMLOld();
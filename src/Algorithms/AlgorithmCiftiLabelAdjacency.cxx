@@ -23,9 +23,10 @@
 
 #include "AlgorithmCiftiParcellate.h"
 #include "AlgorithmCiftiSeparate.h" //for cropped volume space
+#include "BorderTracingHelper.h"
+#include "CaretOMP.h"
 #include "CiftiFile.h"
 #include "SurfaceFile.h"
-#include "TopologyHelper.h"
 
 using namespace caret;
 using namespace std;
@@ -91,7 +92,7 @@ void AlgorithmCiftiLabelAdjacency::useParameters(OperationParameters* myParams,
 }
 
 AlgorithmCiftiLabelAdjacency::AlgorithmCiftiLabelAdjacency(ProgressObject* myProgObj, const CiftiFile* myLabelIn, CiftiFile* myAdjOut,
-                                                           const SurfaceFile* myLeftSurf, const SurfaceFile* myRightSurf, const SurfaceFile* myCerebSurf) : AbstractAlgorithm(myProgObj)
+                                                           const SurfaceFile* myLeftSurf, const SurfaceFile* myRightSurf, const SurfaceFile* myCerebSurf) : AbstractAlgorithm(myProgObj, getCommandSwitch())
 {
     LevelProgress myProgress(myProgObj);
     const CiftiXML& myLabelXML = myLabelIn->getCiftiXML();
@@ -162,30 +163,26 @@ AlgorithmCiftiLabelAdjacency::AlgorithmCiftiLabelAdjacency(ProgressObject* myPro
                 throw AlgorithmException("found surface model with unexpected type: " + StructureEnum::toName(surfaceList[whichStruct]));
                 break;
         }
-        CaretPointer<TopologyHelper> myHelp = mySurf->getTopologyHelper();
         int numNodes = mySurf->getNumberOfNodes();
-        for (int i = 0; i < numNodes - 1; ++i)//to avoid double counting, only count pairs that are in ascending order - this means the last node won't have any valid edges
+        vector<int> nodeParcel(numNodes, -1);
+        for (int i = 0; i < numNodes; ++i)
         {
             int64_t baseIndex = myDenseMap.getIndexForNode(i, surfaceList[whichStruct]);
             if (baseIndex < 0) continue;
-            int baseLabel = indexToParcel[baseIndex];//translate on the fly, to do separate we would need to put indexToParcel into a temporary CiftiFile
-            if (baseLabel < 0) continue;
-            const vector<int32_t>& neighbors = myHelp->getNodeNeighbors(i);
-            int numNeighbors = (int)neighbors.size();
-            for (int j = 0; j < numNeighbors; ++j)
+            nodeParcel[i] = indexToParcel[baseIndex];
+        }
+        BorderTracingHelper myHelper(mySurf);//same boundary edge index that label-to-border traces from
+        vector<int64_t> parcelStart;
+        vector<BorderTracingHelper::BoundaryEdge> boundaryEdges;
+        myHelper.findBoundaryEdges(nodeParcel, numParcels, parcelStart, boundaryEdges);
+#pragma omp CARET_PARFOR schedule(dynamic)
+        for (int parcel = 0; parcel < numParcels; ++parcel)
+        {//every edge between two parcels is listed once under each of them, so each parcel only counts into its own row
+            for (int64_t e = parcelStart[parcel]; e < parcelStart[parcel + 1]; ++e)
             {
-                if (neighbors[j] > i)
-                {
-                    int64_t neighIndex = myDenseMap.getIndexForNode(neighbors[j], surfaceList[whichStruct]);
-                    if (neighIndex < 0) continue;
-                    int neighLabel = indexToParcel[neighIndex];
-                    if (neighLabel < 0) continue;
-                    if (baseLabel != neighLabel)
-                    {
-                        ++adjCount[baseLabel][neighLabel];
-                        ++adjCount[neighLabel][baseLabel];
-                    }
-                }
+                int neighLabel = nodeParcel[boundaryEdges[e].outNode];
+                if (neighLabel < 0) continue;
+                ++adjCount[parcel][neighLabel];
             }
         }
     }
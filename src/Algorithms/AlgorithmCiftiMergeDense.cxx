@@ -28,6 +28,8 @@
 #include "MetricFile.h"
 #include "VolumeFile.h"
 
+#include <algorithm>
+
 using namespace caret;
 using namespace std;
 
@@ -80,7 +82,7 @@ void AlgorithmCiftiMergeDense::useParameters(OperationParameters* myParams, Prog
     AlgorithmCiftiMergeDense(myProgObj, myDir, ciftiList, myCiftiOut);
 }
 
-AlgorithmCiftiMergeDense::AlgorithmCiftiMergeDense(ProgressObject* myProgObj, const int& myDir, const vector<const CiftiFile*>& ciftiList, CiftiFile* myCiftiOut) : AbstractAlgorithm(myProgObj)
+AlgorithmCiftiMergeDense::AlgorithmCiftiMergeDense(ProgressObject* myProgObj, const int& myDir, const vector<const CiftiFile*>& ciftiList, CiftiFile* myCiftiOut) : AbstractAlgorithm(myProgObj, getCommandSwitch())
 {
     LevelProgress myProgress(myProgObj);
     if (ciftiList.size() == 0) throw AlgorithmException("no files specified");
@@ -169,87 +171,123 @@ AlgorithmCiftiMergeDense::AlgorithmCiftiMergeDense(ProgressObject* myProgObj, co
     }
     CaretAssert((int)sourceCifti.size() == outXML.getNumberOfBrainModels(myDir));
     myCiftiOut->setCiftiXML(outXML);
+    int numCifti = (int)ciftiList.size();
+    vector<vector<int64_t> > outIndices(numCifti);//where each index along the merge dimension of each input goes in the output, -1 if not copied directly
+    vector<int> labelSurfaceModels;
+    for (int i = 0; i < numCifti; ++i)
+    {
+        outIndices[i].resize(ciftiList[i]->getDimensions()[myDir], -1);
+    }
     for (int i = 0; i < (int)sourceCifti.size(); ++i)
     {
         CiftiBrainModelInfo myInfo = outXML.getBrainModelInfo(myDir, i);
+        const CiftiXMLOld& otherXML = ciftiList[sourceCifti[i]]->getCiftiXMLOld();
+        vector<int64_t>& thisIndices = outIndices[sourceCifti[i]];
         switch (myInfo.m_type)
         {
             case CIFTI_MODEL_TYPE_SURFACE:
             {
                 if (isLabel)
                 {
-                    LabelFile tempFile;
-                    AlgorithmCiftiSeparate(NULL, ciftiList[sourceCifti[i]], myDir, myInfo.m_structure, &tempFile);//using this because dealing with label tables is nasty, but doesn't happen on large files
-                    AlgorithmCiftiReplaceStructure(NULL, myCiftiOut, myDir, myInfo.m_structure, &tempFile);
-                } else {//for everything else, just use rows directly, because making large metric files in-memory is problematic
-                    vector<CiftiSurfaceMap> inMap, outMap;
-                    const CiftiXMLOld& otherXML = ciftiList[sourceCifti[i]]->getCiftiXMLOld();
-                    outXML.getSurfaceMap(myDir, outMap, myInfo.m_structure);
-                    otherXML.getSurfaceMap(myDir, inMap, myInfo.m_structure);
-                    CaretAssert(inMap.size() == outMap.size());
-                    vector<float> rowscratch(outXML.getNumberOfColumns()), otherscratch(otherXML.getNumberOfColumns());
-                    if (myDir == CiftiXMLOld::ALONG_ROW)
-                    {
-                        for (int j = 0; j < outXML.getNumberOfRows(); ++j)
-                        {
-                            myCiftiOut->getRow(rowscratch.data(), j, true);
-                            ciftiList[sourceCifti[i]]->getRow(otherscratch.data(), j);
-                            for (int k = 0; k < (int)inMap.size(); ++k)
-                            {
-                                CaretAssert(inMap[k].m_surfaceNode == outMap[k].m_surfaceNode);
-                                rowscratch[outMap[k].m_ciftiIndex] = otherscratch[inMap[k].m_ciftiIndex];
-                            }
-                            myCiftiOut->setRow(rowscratch.data(), j);
-                        }
-                    } else {
-                        for (int k = 0; k < (int)inMap.size(); ++k)
-                        {
-                            CaretAssert(inMap[k].m_surfaceNode == outMap[k].m_surfaceNode);
-                            ciftiList[sourceCifti[i]]->getRow(otherscratch.data(), inMap[k].m_ciftiIndex);
-                            myCiftiOut->setRow(otherscratch.data(), outMap[k].m_ciftiIndex);
-                        }
-                    }
+                    labelSurfaceModels.push_back(i);//dealing with label tables is nasty, but doesn't happen on large files
+                    break;
+                }
+                vector<CiftiSurfaceMap> inMap, outMap;
+                outXML.getSurfaceMap(myDir, outMap, myInfo.m_structure);
+                otherXML.getSurfaceMap(myDir, inMap, myInfo.m_structure);
+                CaretAssert(inMap.size() == outMap.size());
+                for (int k = 0; k < (int)inMap.size(); ++k)
+                {
+                    CaretAssert(inMap[k].m_surfaceNode == outMap[k].m_surfaceNode);
+                    thisIndices[inMap[k].m_ciftiIndex] = outMap[k].m_ciftiIndex;
                 }
                 break;
             }
             case CIFTI_MODEL_TYPE_VOXELS:
             {
                 vector<CiftiVolumeMap> inMap, outMap;
-                const CiftiXMLOld& otherXML = ciftiList[sourceCifti[i]]->getCiftiXMLOld();
                 outXML.getVolumeStructureMap(myDir, outMap, myInfo.m_structure);
                 otherXML.getVolumeStructureMap(myDir, inMap, myInfo.m_structure);
                 CaretAssert(inMap.size() == outMap.size());
-                vector<float> rowscratch(outXML.getNumberOfColumns()), otherscratch(otherXML.getNumberOfColumns());
-                if (myDir == CiftiXMLOld::ALONG_ROW)
+                for (int k = 0; k < (int)inMap.size(); ++k)
                 {
-                    for (int j = 0; j < outXML.getNumberOfRows(); ++j)
+                    CaretAssert(inMap[k].m_ijk[0] == outMap[k].m_ijk[0]);
+                    CaretAssert(inMap[k].m_ijk[1] == outMap[k].m_ijk[1]);
+                    CaretAssert(inMap[k].m_ijk[2] == outMap[k].m_ijk[2]);
+                    thisIndices[inMap[k].m_ciftiIndex] = outMap[k].m_ciftiIndex;
+                }
+                break;
+            }
+            default:
+                throw AlgorithmException("encountered unknown model type in cifti merge dense");
+        }
+    }
+    int64_t outRowLength = outXML.getNumberOfColumns(), outNumRows = outXML.getNumberOfRows();
+    int64_t blockRows = CiftiFile::getRowBlockSize(outRowLength);
+    if (myDir == CiftiXMLOld::ALONG_ROW)
+    {//each output row gathers from the same row of every input, so write every output row exactly once instead of read-modify-write per structure
+        blockRows = min(blockRows, outNumRows);
+        int64_t maxInLength = 0;
+        for (int i = 0; i < numCifti; ++i)
+        {
+            maxInLength = max(maxInLength, (int64_t)outIndices[i].size());
+        }
+        vector<float> outRows(blockRows * outRowLength, 0.0f), scratchRows(blockRows * maxInLength);
+        for (int64_t start = 0; start < outNumRows; start += blockRows)
+        {
+            int64_t thisBlock = min(blockRows, outNumRows - start);
+            for (int i = 0; i < numCifti; ++i)
+            {
+                const vector<int64_t>& thisIndices = outIndices[i];
+                int64_t inLength = (int64_t)thisIndices.size();
+                ciftiList[i]->getRows(scratchRows.data(), start, thisBlock);
+                for (int64_t row = 0; row < thisBlock; ++row)
+                {
+                    const float* inRow = scratchRows.data() + row * inLength;
+                    float* outRow = outRows.data() + row * outRowLength;
+                    for (int64_t k = 0; k < inLength; ++k)
                     {
-                        myCiftiOut->getRow(rowscratch.data(), j, true);
-                        ciftiList[sourceCifti[i]]->getRow(otherscratch.data(), j);
-                        for (int k = 0; k < (int)inMap.size(); ++k)
+                        if (thisIndices[k] != -1)
                         {
-                            CaretAssert(inMap[k].m_ijk[0] == outMap[k].m_ijk[0]);
-                            CaretAssert(inMap[k].m_ijk[1] == outMap[k].m_ijk[1]);
-                            CaretAssert(inMap[k].m_ijk[2] == outMap[k].m_ijk[2]);
-                            rowscratch[outMap[k].m_ciftiIndex] = otherscratch[inMap[k].m_ciftiIndex];
+                            outRow[thisIndices[k]] = inRow[k];
                         }
-                        myCiftiOut->setRow(rowscratch.data(), j);
-                    }
-                } else {
-                    for (int k = 0; k < (int)inMap.size(); ++k)
-                    {
-                        CaretAssert(inMap[k].m_ijk[0] == outMap[k].m_ijk[0]);
-                        CaretAssert(inMap[k].m_ijk[1] == outMap[k].m_ijk[1]);
-                        CaretAssert(inMap[k].m_ijk[2] == outMap[k].m_ijk[2]);
-                        ciftiList[sourceCifti[i]]->getRow(otherscratch.data(), inMap[k].m_ciftiIndex);
-                        myCiftiOut->setRow(otherscratch.data(), outMap[k].m_ciftiIndex);
                     }
                 }
-                break;
             }
-            default:
-                throw AlgorithmException("encountered unknown model type in cifti merge dense");
+            myCiftiOut->setRows(outRows.data(), start, thisBlock);
         }
+    } else {//whole rows move unchanged, so copy runs of consecutive rows in large blocks
+        vector<float> scratchRows(min(blockRows, outNumRows) * outRowLength);
+        for (int i = 0; i < numCifti; ++i)
+        {
+            const vector<int64_t>& thisIndices = outIndices[i];
+            int64_t inRows = (int64_t)thisIndices.size();
+            int64_t k = 0;
+            while (k < inRows)
+            {
+                if (thisIndices[k] == -1)
+                {
+                    ++k;
+                    continue;
+                }
+                int64_t runLength = 1;
+                while (k + runLength < inRows && runLength < blockRows && thisIndices[k + runLength] == thisIndices[k] + runLength)
+                {
+                    ++runLength;
+                }
+                ciftiList[i]->getRows(scratchRows.data(), k, runLength);
+                myCiftiOut->setRows(scratchRows.data(), thisIndices[k], runLength);
+                k += runLength;
+            }
+        }
+    }
+    for (int i = 0; i < (int)labelSurfaceModels.size(); ++i)
+    {
+        int whichModel = labelSurfaceModels[i];
+        CiftiBrainModelInfo myInfo = outXML.getBrainModelInfo(myDir, whichModel);
+        LabelFile tempFile;
+        AlgorithmCiftiSeparate(NULL, ciftiList[sourceCifti[whichModel]], myDir, myInfo.m_structure, &tempFile);
+        AlgorithmCiftiReplaceStructure(NULL, myCiftiOut, myDir, myInfo.m_structure, &tempFile);
     }
 }
 
@@ -20,17 +20,117 @@
 
 #include "AlgorithmCiftiParcellate.h"
 #include "AlgorithmException.h"
+#include "CaretOMP.h"
 #include "CiftiFile.h"
 #include "GiftiLabel.h"
 #include "GiftiLabelTable.h"
-#include "ReductionOperation.h"
 
+#include <algorithm>
 #include <cmath>
 #include <map>
 
 using namespace caret;
 using namespace std;
 
+namespace
+{
+    const int64_t BLOCK_BYTES = 64 * 1024 * 1024;//how much input to hold in memory per block of rows
+    
+    //parcel membership in compressed sparse row form, so the members of each parcel are contiguous and in file order
+    class ParcelPlan
+    {
+        vector<int64_t> m_offsets, m_members;
+    public:
+        ParcelPlan(const vector<int>& indexToParcel, const int& numParcels)
+        {
+            m_offsets.resize(numParcels + 1, 0);
+            int64_t numIndices = (int64_t)indexToParcel.size();
+            for (int64_t i = 0; i < numIndices; ++i)
+            {
+                int parcel = indexToParcel[i];
+                CaretAssert(parcel > -2 && parcel < numParcels);
+                if (parcel != -1)
+                {
+                    ++m_offsets[parcel + 1];
+                }
+            }
+            for (int i = 0; i < numParcels; ++i)
+            {
+                m_offsets[i + 1] += m_offsets[i];
+            }
+            m_members.resize(m_offsets[numParcels]);
+            vector<int64_t> fillPos(m_offsets.begin(), m_offsets.end() - 1);
+            for (int64_t i = 0; i < numIndices; ++i)
+            {
+                int parcel = indexToParcel[i];
+                if (parcel != -1)
+                {
+                    m_members[fillPos[parcel]] = i;
+                    ++fillPos[parcel];
+                }
+            }
+        }
+        int64_t getCount(const int& parcel) const { return m_offsets[parcel + 1] - m_offsets[parcel]; }
+        const int64_t* getMembers(const int& parcel) const { return m_members.data() + m_offsets[parcel]; }
+        int64_t getMaxCount() const
+        {
+            int64_t ret = 0;
+            for (int i = 0; i < (int)m_offsets.size() - 1; ++i)
+            {
+                ret = max(ret, getCount(i));
+            }
+            return ret;
+        }
+    };
+    
+    //same result as ReductionOperation MODE (smallest value wins ties), but sorts in place instead of copying
+    float sortedMode(float* data, const int64_t& count)
+    {
+        CaretAssert(count > 0);
+        sort(data, data + count);
+        int64_t bestCount = 0, curCount = 1;
+        float bestVal = data[0], curVal = data[0];
+        for (int64_t i = 1; i < count; ++i)
+        {
+            if (data[i] == curVal)
+            {
+                ++curCount;
+            } else {
+                if (curCount > bestCount)
+                {
+                    bestVal = curVal;
+                    bestCount = curCount;
+                }
+                curVal = data[i];
+                curCount = 1;
+            }
+        }
+        if (curCount > bestCount)
+        {
+            bestVal = curVal;
+        }
+        return bestVal;
+    }
+    
+    double gatherSum(const float* data, const int64_t* members, const int64_t& count)
+    {
+        double sum[4] = { 0.0, 0.0, 0.0, 0.0 };//independent accumulators, to not serialize on the add latency
+        int64_t k = 0;
+        for (; k + 3 < count; k += 4)
+        {
+            sum[0] += data[members[k]];
+            sum[1] += data[members[k + 1]];
+            sum[2] += data[members[k + 2]];
+            sum[3] += data[members[k + 3]];
+        }
+        for (; k < count; ++k)
+        {
+            sum[0] += data[members[k]];
+        }
+        return (sum[0] + sum[1]) + (sum[2] + sum[3]);
+    }
+}
+
 AString AlgorithmCiftiParcellate::getCommandSwitch()
 {
     return "-cifti-parcellate";
@@ -82,7 +182,7 @@ void AlgorithmCiftiParcellate::useParameters(OperationParameters* myParams, Prog
     AlgorithmCiftiParcellate(myProgObj, myCiftiIn, myCiftiLabel, direction, myCiftiOut);
 }
 
-AlgorithmCiftiParcellate::AlgorithmCiftiParcellate(ProgressObject* myProgObj, const CiftiFile* myCiftiIn, const CiftiFile* myCiftiLabel, const int& direction, CiftiFile* myCiftiOut) : AbstractAlgorithm(myProgObj)
+AlgorithmCiftiParcellate::AlgorithmCiftiParcellate(ProgressObject* myProgObj, const CiftiFile* myCiftiIn, const CiftiFile* myCiftiLabel, const int& direction, CiftiFile* myCiftiOut) : AbstractAlgorithm(myProgObj, getCommandSwitch())
 {
     LevelProgress myProgress(myProgObj);
     const CiftiXML& myInputXML = myCiftiIn->getCiftiXML();
@@ -125,157 +225,173 @@ AlgorithmCiftiParcellate::AlgorithmCiftiParcellate(ProgressObject* myProgObj, co
     myOutXML.setMap(direction, outParcelMap);
     myCiftiOut->setCiftiXML(myOutXML);
     int64_t numCols = myInputXML.getDimensionLength(CiftiXML::ALONG_ROW), numRows = myInputXML.getDimensionLength(CiftiXML::ALONG_COLUMN);
-    vector<float> scratchRow(numCols);
-    vector<int64_t> parcelCounts(numParcels, 0);
-    for (int64_t j = 0; j < (int64_t)indexToParcel.size(); ++j)
-    {
-        int parcel = indexToParcel[j];
-        CaretAssert(parcel > -2 && parcel < numParcels);
-        if (parcel != -1)
-        {
-            ++parcelCounts[parcel];
-        }
-    }
+    ParcelPlan myPlan(indexToParcel, numParcels);
     bool isLabel = (myInputXML.getMappingType(1 - direction) == CiftiMappingType::LABELS);//we already checked it is 2D
+    int64_t maxParcelSize = myPlan.getMaxCount();
     if (direction == CiftiXML::ALONG_ROW)
     {
-        vector<float> scratchOutRow(numParcels);
+        if (numRows == 0) return;//no rows to write, and the block bookkeeping below assumes at least one block
+        vector<float> unassignedKeys;
         if (isLabel)
         {
-            vector<vector<float> > parcelData(numParcels);//float so we can use ReductionOperation (when not considering vertex area, etc)
-            for (int j = 0; j < numParcels; ++j)
+            unassignedKeys.resize(numRows);
+            for (int64_t i = 0; i < numRows; ++i)
             {
-                parcelData[j].reserve(parcelCounts[j]);
+                unassignedKeys[i] = myOutXML.getLabelsMap(CiftiXML::ALONG_COLUMN).getMapLabelTable(i)->getUnassignedLabelKey();
             }
-            for (int64_t i = 0; i < numRows; ++i)
+        }
+        int64_t blockRows = max((int64_t)1, min(numRows, BLOCK_BYTES / (int64_t)(numCols * sizeof(float))));
+        int64_t numBlocks = (numRows + blockRows - 1) / blockRows;
+        vector<float> inBlocks[2], outBlocks[2];//double buffered, so one thread can do file IO for the neighboring blocks while the rest compute
+        for (int i = 0; i < 2; ++i)
+        {
+            inBlocks[i].resize(blockRows * numCols);
+            outBlocks[i].resize(blockRows * numParcels);
+        }
+        for (int64_t i = 0; i < blockRows; ++i)
+        {
+            myCiftiIn->getRow(inBlocks[0].data() + i * numCols, i);
+        }
+        for (int64_t block = 0; block < numBlocks; ++block)
+        {
+            int cur = block % 2, other = 1 - cur;
+            int64_t startRow = block * blockRows, endRow = min(numRows, startRow + blockRows);
+            bool ioFailed = false;
+            AString ioError;
+#pragma omp CARET_PAR
             {
-                for (int j = 0; j < numParcels; ++j)
+#pragma omp single nowait
                 {
-                    parcelData[j].clear();//doesn't change allocation
-                }
-                myCiftiIn->getRow(scratchRow.data(), i);
-                for (int64_t j = 0; j < numCols; ++j)
-                {
-                    int parcel = indexToParcel[j];
-                    if (parcel != -1)
+                    try
                     {
-                        parcelData[parcel].push_back(floor(scratchRow[j] + 0.5f));//round to nearest integer to be safe
+                        if (block > 0)
+                        {
+                            for (int64_t i = startRow - blockRows; i < startRow; ++i)
+                            {
+                                myCiftiOut->setRow(outBlocks[other].data() + (i - startRow + blockRows) * numParcels, i);
+                            }
+                        }
+                        int64_t nextEnd = min(numRows, endRow + blockRows);
+                        for (int64_t i = endRow; i < nextEnd; ++i)
+                        {
+                            myCiftiIn->getRow(inBlocks[other].data() + (i - endRow) * numCols, i);
+                        }
+                    } catch (CaretException& e) {//can't throw out of a parallel region
+                        ioFailed = true;
+                        ioError = e.whatString();
                     }
                 }
-                for (int j = 0; j < numParcels; ++j)
+                vector<float> scratch(isLabel ? maxParcelSize : 0);
+#pragma omp CARET_FOR schedule(dynamic)
+                for (int64_t i = startRow; i < endRow; ++i)
                 {
-                    CaretAssert(parcelCounts[j] == (int64_t)parcelData[j].size());
-                    if (parcelCounts[j] > 0)
+                    const float* inRow = inBlocks[cur].data() + (i - startRow) * numCols;
+                    float* outRow = outBlocks[cur].data() + (i - startRow) * numParcels;
+                    for (int j = 0; j < numParcels; ++j)
                     {
-                        scratchOutRow[j] = ReductionOperation::reduce(parcelData[j].data(), parcelData[j].size(), ReductionEnum::MODE);
-                    } else {
-                        scratchOutRow[j] = myOutXML.getLabelsMap(CiftiXML::ALONG_COLUMN).getMapLabelTable(i)->getUnassignedLabelKey();
+                        int64_t count = myPlan.getCount(j);
+                        const int64_t* members = myPlan.getMembers(j);
+                        if (count > 0)
+                        {
+                            if (isLabel)
+                            {
+                                for (int64_t k = 0; k < count; ++k)
+                                {
+                                    scratch[k] = floor(inRow[members[k]] + 0.5f);//round to nearest integer to be safe
+                                }
+                                outRow[j] = sortedMode(scratch.data(), count);
+                            } else {
+                                outRow[j] = gatherSum(inRow, members, count) / count;
+                            }
+                        } else {
+                            outRow[j] = (isLabel ? unassignedKeys[i] : 0.0f);
+                        }
                     }
                 }
-                myCiftiOut->setRow(scratchOutRow.data(), i);
             }
-        } else {
-            for (int64_t i = 0; i < numRows; ++i)
+            if (ioFailed)
             {
-                vector<double> scratchAccum(numParcels, 0.0);
-                myCiftiIn->getRow(scratchRow.data(), i);
-                for (int64_t j = 0; j < numCols; ++j)
-                {
-                    int parcel = indexToParcel[j];
-                    if (parcel != -1)
-                    {
-                        scratchAccum[parcel] += scratchRow[j];
-                    }
-                }
-                for (int j = 0; j < numParcels; ++j)
-                {
-                    if (parcelCounts[j] > 0)
-                    {
-                        scratchOutRow[j] = scratchAccum[j] / parcelCounts[j];
-                    } else {
-                        scratchOutRow[j] = 0.0f;
-                    }
-                }
-                myCiftiOut->setRow(scratchOutRow.data(), i);
+                throw AlgorithmException(ioError);
             }
+            myProgress.reportProgress(((float)block + 1) / numBlocks);
+        }
+        int64_t lastStart = (numBlocks - 1) * blockRows;
+        for (int64_t i = lastStart; i < numRows; ++i)
+        {
+            myCiftiOut->setRow(outBlocks[(numBlocks - 1) % 2].data() + (i - lastStart) * numParcels, i);
         }
     } else if (direction == CiftiXML::ALONG_COLUMN) {
         vector<float> scratchOutRow(numCols);
         if (isLabel)
         {
-            vector<vector<vector<float> > > parcelData(numParcels, vector<vector<float> >(numCols));//float so we can use ReductionOperation (when not considering vertex area, etc)
-            for (int i = 0; i < numParcels; ++i)
-            {
-                for (int j = 0; j < numCols; ++j)
-                {
-                    parcelData[i][j].reserve(parcelCounts[i]);
-                }
-            }
-            for (int64_t i = 0; i < numRows; ++i)
+            vector<float> unassignedKeys(numCols);
+            for (int64_t j = 0; j < numCols; ++j)
             {
-                int parcel = indexToParcel[i];
-                if (parcel != -1)
-                {
-                    myCiftiIn->getRow(scratchRow.data(), i);
-                    vector<vector<float> >& parcelRef = parcelData[parcel];
-                    for (int j = 0; j < numCols; ++j)
-                    {
-                        parcelRef[j].push_back(floor(scratchRow[j] + 0.5f));
-                    }
-                }
+                unassignedKeys[j] = myOutXML.getLabelsMap(CiftiXML::ALONG_ROW).getMapLabelTable(j)->getUnassignedLabelKey();
             }
+            vector<float> parcelRows(maxParcelSize * numCols);//only one parcel at a time, transposed so each column is contiguous for the mode
+            vector<float> scratchRow(numCols);
             for (int i = 0; i < numParcels; ++i)
             {
-                int64_t count = parcelCounts[i];
-                vector<vector<float> >& parcelRef = parcelData[i];
+                int64_t count = myPlan.getCount(i);
+                const int64_t* members = myPlan.getMembers(i);
                 if (count > 0)
                 {
-                    for (int j = 0; j < numCols; ++j)
+                    for (int64_t k = 0; k < count; ++k)
                     {
-                        CaretAssert((int64_t)parcelRef[j].size() == count);
-                        scratchOutRow[j] = ReductionOperation::reduce(parcelRef[j].data(), parcelRef[j].size(), ReductionEnum::MODE);
+                        myCiftiIn->getRow(scratchRow.data(), members[k]);
+                        for (int64_t j = 0; j < numCols; ++j)
+                        {
+                            parcelRows[j * count + k] = floor(scratchRow[j] + 0.5f);
+                        }
                     }
-                } else {
-                    for (int j = 0; j < numCols; ++j)
+#pragma omp CARET_PARFOR schedule(dynamic, 64)
+                    for (int64_t j = 0; j < numCols; ++j)
                     {
-                        CaretAssert((int64_t)parcelRef[j].size() == count);
-                        scratchOutRow[j] = myOutXML.getLabelsMap(CiftiXML::ALONG_ROW).getMapLabelTable(j)->getUnassignedLabelKey();
+                        scratchOutRow[j] = sortedMode(parcelRows.data() + j * count, count);
                     }
-                }
-                myCiftiOut->setRow(scratchOutRow.data(), i);
-            }
-        } else {
-            vector<vector<double> > accumRows(numParcels, vector<double>(numCols, 0.0f));
-            for (int64_t i = 0; i < numRows; ++i)
-            {
-                int parcel = indexToParcel[i];
-                if (parcel != -1)
-                {
-                    myCiftiIn->getRow(scratchRow.data(), i);
-                    vector<double>& parcelRowRef = accumRows[parcel];
+                } else {
                     for (int64_t j = 0; j < numCols; ++j)
                     {
-                        parcelRowRef[j] += scratchRow[j];
+                        scratchOutRow[j] = unassignedKeys[j];
                     }
                 }
+                myCiftiOut->setRow(scratchOutRow.data(), i);
+                myProgress.reportProgress(((float)i + 1) / numParcels);
             }
+        } else {
+            int64_t blockRows = max((int64_t)1, min(maxParcelSize, BLOCK_BYTES / (int64_t)(numCols * sizeof(float))));
+            vector<float> inBlock(blockRows * numCols);
+            vector<double> accum(numCols);
             for (int i = 0; i < numParcels; ++i)
             {
-                int64_t count = parcelCounts[i];
-                if (count > 0)
+                int64_t count = myPlan.getCount(i);
+                const int64_t* members = myPlan.getMembers(i);
+                accum.assign(numCols, 0.0);
+                for (int64_t start = 0; start < count; start += blockRows)
                 {
-                    vector<double>& parcelRowRef = accumRows[i];
-                    for (int64_t j = 0; j < numCols; ++j)
+                    int64_t end = min(count, start + blockRows);
+                    for (int64_t k = start; k < end; ++k)
                     {
-                        scratchOutRow[j] = parcelRowRef[j] / count;
+                        myCiftiIn->getRow(inBlock.data() + (k - start) * numCols, members[k]);
                     }
-                } else {
+#pragma omp CARET_PARFOR schedule(static) if(numCols > 4096)
                     for (int64_t j = 0; j < numCols; ++j)
                     {
-                        scratchOutRow[j] = 0.0f;
+                        double sum = accum[j];
+                        for (int64_t k = 0; k < end - start; ++k)
+                        {
+                            sum += inBlock[k * numCols + j];
+                        }
+                        accum[j] = sum;
                     }
                 }
+                for (int64_t j = 0; j < numCols; ++j)
+                {
+                    scratchOutRow[j] = (count > 0 ? accum[j] / count : 0.0f);
+                }
                 myCiftiOut->setRow(scratchOutRow.data(), i);
+                myProgress.reportProgress(((float)i + 1) / numParcels);
             }
         }
     } else {
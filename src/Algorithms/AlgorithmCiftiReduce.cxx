@@ -21,6 +21,7 @@
 #include "AlgorithmCiftiReduce.h"
 #include "AlgorithmException.h"
 #include "CiftiFile.h"
+#include "CiftiRowStreamHelper.h"
 #include "ReductionOperation.h"
 
 #include <vector>
@@ -28,6 +29,40 @@
 using namespace caret;
 using namespace std;
 
+namespace
+{
+    class ReduceRowFunction : public CiftiRowStreamHelper::RowFunction
+    {
+        ReductionEnum::Enum m_reduce;
+        bool m_excludeOutliers;
+        float m_sigmaBelow, m_sigmaAbove;
+    public:
+        ReduceRowFunction(const ReductionEnum::Enum& myReduce)
+        {
+            m_reduce = myReduce;
+            m_excludeOutliers = false;
+            m_sigmaBelow = 0.0f;
+            m_sigmaAbove = 0.0f;
+        }
+        ReduceRowFunction(const ReductionEnum::Enum& myReduce, const float& sigmaBelow, const float& sigmaAbove)
+        {
+            m_reduce = myReduce;
+            m_excludeOutliers = true;
+            m_sigmaBelow = sigmaBelow;
+            m_sigmaAbove = sigmaAbove;
+        }
+        void processRow(const float* inRow, const int64_t& inRowLength, float* outRow, const int64_t&, const int64_t&)
+        {
+            if (m_excludeOutliers)
+            {
+                outRow[0] = ReductionOperation::reduceExcludeDev(inRow, inRowLength, m_reduce, m_sigmaBelow, m_sigmaAbove);
+            } else {
+                outRow[0] = ReductionOperation::reduce(inRow, inRowLength, m_reduce);
+            }
+        }
+    };
+}
+
 AString AlgorithmCiftiReduce::getCommandSwitch()
 {
     return "-cifti-reduce";
@@ -75,7 +110,7 @@ void AlgorithmCiftiReduce::useParameters(OperationParameters* myParams, Progress
     }
 }
 
-AlgorithmCiftiReduce::AlgorithmCiftiReduce(ProgressObject* myProgObj, const CiftiFile* ciftiIn, const ReductionEnum::Enum& myReduce, CiftiFile* ciftiOut) : AbstractAlgorithm(myProgObj)
+AlgorithmCiftiReduce::AlgorithmCiftiReduce(ProgressObject* myProgObj, const CiftiFile* ciftiIn, const ReductionEnum::Enum& myReduce, CiftiFile* ciftiOut) : AbstractAlgorithm(myProgObj, getCommandSwitch())
 {
     LevelProgress myProgress(myProgObj);
     int64_t numRows = ciftiIn->getNumberOfRows();
@@ -85,16 +120,11 @@ AlgorithmCiftiReduce::AlgorithmCiftiReduce(ProgressObject* myProgObj, const Cift
     myOutXML.resetRowsToScalars(1);
     myOutXML.setMapNameForRowIndex(0, ReductionEnum::toName(myReduce));
     ciftiOut->setCiftiXML(myOutXML);
-    vector<float> scratchRow(numCols), outCol(numRows);
-    for (int64_t i = 0; i < numRows; ++i)
-    {
-        ciftiIn->getRow(scratchRow.data(), i);
-        outCol[i] = ReductionOperation::reduce(scratchRow.data(), numCols, myReduce);
-    }
-    ciftiOut->setColumn(outCol.data(), 0);
+    ReduceRowFunction myFunction(myReduce);
+    CiftiRowStreamHelper::streamRows(ciftiIn, ciftiOut, &myFunction);//output rows have one element, so this also avoids setColumn on an on-disk output
 }
 
-AlgorithmCiftiReduce::AlgorithmCiftiReduce(ProgressObject* myProgObj, const CiftiFile* ciftiIn, const ReductionEnum::Enum& myReduce, CiftiFile* ciftiOut, const float& sigmaBelow, const float& sigmaAbove) : AbstractAlgorithm(myProgObj)
+AlgorithmCiftiReduce::AlgorithmCiftiReduce(ProgressObject* myProgObj, const CiftiFile* ciftiIn, const ReductionEnum::Enum& myReduce, CiftiFile* ciftiOut, const float& sigmaBelow, const float& sigmaAbove) : AbstractAlgorithm(myProgObj, getCommandSwitch())
 {
     LevelProgress myProgress(myProgObj);
     int64_t numRows = ciftiIn->getNumberOfRows();
@@ -104,13 +134,8 @@ AlgorithmCiftiReduce::AlgorithmCiftiReduce(ProgressObject* myProgObj, const Cift
     myOutXML.resetRowsToScalars(1);
     myOutXML.setMapNameForRowIndex(0, ReductionEnum::toName(myReduce));
     ciftiOut->setCiftiXML(myOutXML);
-    vector<float> scratchRow(numCols), outCol(numRows);
-    for (int64_t i = 0; i < numRows; ++i)
-    {
-        ciftiIn->getRow(scratchRow.data(), i);
-        outCol[i] = ReductionOperation::reduceExcludeDev(scratchRow.data(), numCols, myReduce, sigmaBelow, sigmaAbove);
-    }
-    ciftiOut->setColumn(outCol.data(), 0);
+    ReduceRowFunction myFunction(myReduce, sigmaBelow, sigmaAbove);
+    CiftiRowStreamHelper::streamRows(ciftiIn, ciftiOut, &myFunction);
 }
 
 float AlgorithmCiftiReduce::getAlgorithmInternalWeight()
@@ -20,6 +20,7 @@
 
 #include "AlgorithmCiftiSeparate.h"
 #include "AlgorithmException.h"
+#include "CaretAssert.h"
 #include "CaretLogger.h"
 #include "CaretPointer.h"
 #include "CiftiFile.h"
@@ -29,12 +30,45 @@
 #include "Vector3D.h"
 #include "VolumeFile.h"
 
+#include <algorithm>
 #include <cstdlib>
 #include <map>
 
 using namespace caret;
 using namespace std;
 
+namespace
+{
+    class RowBlockReader
+    {//hands out rows from large block reads, so walking through a file in increasing row order does few large reads
+        const CiftiFile* m_file;
+        int64_t m_rowSize, m_numRows, m_blockRows, m_blockStart, m_blockCount;
+        vector<float> m_block;
+    public:
+        RowBlockReader(const CiftiFile* file)
+        {
+            m_file = file;
+            m_rowSize = file->getNumberOfColumns();
+            m_numRows = file->getNumberOfRows();
+            m_blockRows = min(m_numRows, CiftiFile::getRowBlockSize(m_rowSize));
+            m_blockStart = 0;
+            m_blockCount = 0;
+            m_block.resize(m_blockRows * m_rowSize);
+        }
+        const float* getRow(const int64_t& row)
+        {
+            CaretAssert(row >= 0 && row < m_numRows);
+            if (row < m_blockStart || row >= m_blockStart + m_blockCount)
+            {
+                m_blockStart = row;
+                m_blockCount = min(m_blockRows, m_numRows - row);
+                m_file->getRows(m_block.data(), m_blockStart, m_blockCount);
+            }
+            return m_block.data() + (row - m_blockStart) * m_rowSize;
+        }
+    };
+}
+
 AString AlgorithmCiftiSeparate::getCommandSwitch()
 {
     return "-cifti-separate";
@@ -189,7 +223,7 @@ void AlgorithmCiftiSeparate::useParameters(OperationParameters* myParams, Progre
 }
 
 AlgorithmCiftiSeparate::AlgorithmCiftiSeparate(ProgressObject* myProgObj, const CiftiFile* ciftiIn, const int& myDir,
-                                               const StructureEnum::Enum& myStruct, MetricFile* metricOut, MetricFile* roiOut) : AbstractAlgorithm(myProgObj)
+                                               const StructureEnum::Enum& myStruct, MetricFile* metricOut, MetricFile* roiOut) : AbstractAlgorithm(myProgObj, getCommandSwitch())
 {
     LevelProgress myProgress(myProgObj);
     const CiftiXML& myXML = ciftiIn->getCiftiXML();
@@ -211,11 +245,11 @@ AlgorithmCiftiSeparate::AlgorithmCiftiSeparate(ProgressObject* myProgObj, const
             roiOut->setStructure(myStruct);
         }
         int mapSize = (int)myMap.size();
-        CaretArray<float> rowScratch(rowSize);
+        RowBlockReader rowReader(ciftiIn);
         CaretArray<float> nodeUsed(numNodes, 0.0f);
         for (int i = 0; i < mapSize; ++i)
         {
-            ciftiIn->getRow(rowScratch, myMap[i].m_ciftiIndex);
+            const float* rowScratch = rowReader.getRow(myMap[i].m_ciftiIndex);
             nodeUsed[myMap[i].m_surfaceNode] = 1.0f;
             for (int j = 0; j < rowSize; ++j)
             {
@@ -246,7 +280,8 @@ AlgorithmCiftiSeparate::AlgorithmCiftiSeparate(ProgressObject* myProgObj, const
             roiOut->setStructure(myStruct);
         }
         int mapSize = (int)myMap.size();
-        CaretArray<float> rowScratch(rowSize), metricScratch(numNodes, 0.0f);
+        RowBlockReader rowReader(ciftiIn);
+        CaretArray<float> metricScratch(numNodes, 0.0f);
         if (roiOut != NULL)
         {
             CaretArray<float> nodeUsed(numNodes, 0.0f);
@@ -258,7 +293,7 @@ AlgorithmCiftiSeparate::AlgorithmCiftiSeparate(ProgressObject* myProgObj, const
         }
         for (int i = 0; i < colSize; ++i)
         {
-            ciftiIn->getRow(rowScratch, i);
+            const float* rowScratch = rowReader.getRow(i);
             for (int j = 0; j < mapSize; ++j)
             {
                 metricScratch[myMap[j].m_surfaceNode] = rowScratch[myMap[j].m_ciftiIndex];
@@ -269,7 +304,7 @@ AlgorithmCiftiSeparate::AlgorithmCiftiSeparate(ProgressObject* myProgObj, const
 }
 
 AlgorithmCiftiSeparate::AlgorithmCiftiSeparate(ProgressObject* myProgObj, const CiftiFile* ciftiIn, const int& myDir,
-                                               const StructureEnum::Enum& myStruct, LabelFile* labelOut, MetricFile* roiOut) : AbstractAlgorithm(myProgObj)
+                                               const StructureEnum::Enum& myStruct, LabelFile* labelOut, MetricFile* roiOut) : AbstractAlgorithm(myProgObj, getCommandSwitch())
 {
     LevelProgress myProgress(myProgObj);
     const CiftiXML& myXML = ciftiIn->getCiftiXML();
@@ -292,7 +327,7 @@ AlgorithmCiftiSeparate::AlgorithmCiftiSeparate(ProgressObject* myProgObj, const
             roiOut->setStructure(myStruct);
         }
         int64_t mapSize = (int64_t)myMap.size();
-        CaretArray<float> rowScratch(rowSize);
+        RowBlockReader rowReader(ciftiIn);
         CaretArray<float> nodeUsed(numNodes, 0.0f);
         GiftiLabelTable myTable;
         map<int32_t, int32_t> cumulativeRemap;
@@ -303,7 +338,7 @@ AlgorithmCiftiSeparate::AlgorithmCiftiSeparate(ProgressObject* myProgObj, const
         }
         for (int64_t i = 0; i < mapSize; ++i)
         {
-            ciftiIn->getRow(rowScratch, myMap[i].m_ciftiIndex);
+            const float* rowScratch = rowReader.getRow(myMap[i].m_ciftiIndex);
             nodeUsed[myMap[i].m_surfaceNode] = 1.0f;
             for (int j = 0; j < rowSize; ++j)
             {
@@ -352,7 +387,7 @@ AlgorithmCiftiSeparate::AlgorithmCiftiSeparate(ProgressObject* myProgObj, const
             }
             roiOut->setValuesForColumn(0, nodeUsed);
         }
-        CaretArray<float> rowScratch(rowSize);
+        RowBlockReader rowReader(ciftiIn);
         CaretArray<int> nodeUsed(numNodes, 0);
         for (int64_t j = 0; j < mapSize; ++j)
         {
@@ -369,7 +404,7 @@ AlgorithmCiftiSeparate::AlgorithmCiftiSeparate(ProgressObject* myProgObj, const
         int32_t unusedLabel = myTable.getUnassignedLabelKey();
         for (int64_t i = 0; i < colSize; ++i)
         {
-            ciftiIn->getRow(rowScratch, i);
+            const float* rowScratch = rowReader.getRow(i);
             for (int64_t j = 0; j < mapSize; ++j)
             {
                 int32_t inVal = (int32_t)floor(rowScratch[j] + 0.5f);
@@ -394,7 +429,7 @@ AlgorithmCiftiSeparate::AlgorithmCiftiSeparate(ProgressObject* myProgObj, const
 
 AlgorithmCiftiSeparate::AlgorithmCiftiSeparate(ProgressObject* myProgObj, const CiftiFile* ciftiIn, const int& myDir,
                                                const StructureEnum::Enum& myStruct, VolumeFile* volOut, int64_t offsetOut[3],
-                                               VolumeFile* roiOut, const bool& cropVol) : AbstractAlgorithm(myProgObj)
+                                               VolumeFile* roiOut, const bool& cropVol) : AbstractAlgorithm(myProgObj, getCommandSwitch())
 {
     LevelProgress myProgress(myProgObj);
     const CiftiXML& myXML = ciftiIn->getCiftiXML();
@@ -425,7 +460,7 @@ AlgorithmCiftiSeparate::AlgorithmCiftiSeparate(ProgressObject* myProgObj, const
         roiOut->reinitialize(newdims, mySform);
         roiOut->setValueAllVoxels(0.0f);
     }
-    CaretArray<float> rowScratch(rowSize);
+    RowBlockReader rowReader(ciftiIn);
     if (myDir == CiftiXML::ALONG_COLUMN)
     {
         if (rowSize > 1) newdims.push_back(rowSize);
@@ -447,7 +482,7 @@ AlgorithmCiftiSeparate::AlgorithmCiftiSeparate(ProgressObject* myProgObj, const
             {
                 roiOut->setValue(1.0f, thisvoxel);
             }
-            ciftiIn->getRow(rowScratch, myMap[i].m_ciftiIndex);
+            const float* rowScratch = rowReader.getRow(myMap[i].m_ciftiIndex);
             for (int j = 0; j < rowSize; ++j)
             {
                 volOut->setValue(rowScratch[j], thisvoxel, j);
@@ -468,7 +503,7 @@ AlgorithmCiftiSeparate::AlgorithmCiftiSeparate(ProgressObject* myProgObj, const
         }
         for (int64_t i = 0; i < colSize; ++i)
         {
-            ciftiIn->getRow(rowScratch, i);
+            const float* rowScratch = rowReader.getRow(i);
             for (int64_t j = 0; j < numVoxels; ++j)
             {
                 int64_t thisvoxel[3] = { myMap[j].m_ijk[0] - offsetOut[0], myMap[j].m_ijk[1] - offsetOut[1], myMap[j].m_ijk[2] - offsetOut[2] };
@@ -483,7 +518,7 @@ AlgorithmCiftiSeparate::AlgorithmCiftiSeparate(ProgressObject* myProgObj, const
 }
 
 AlgorithmCiftiSeparate::AlgorithmCiftiSeparate(ProgressObject* myProgObj, const CiftiFile* ciftiIn, const int& myDir, VolumeFile* volOut, int64_t offsetOut[3],
-                                               VolumeFile* roiOut, const bool& cropVol, VolumeFile* labelOut): AbstractAlgorithm(myProgObj)
+                                               VolumeFile* roiOut, const bool& cropVol, VolumeFile* labelOut): AbstractAlgorithm(myProgObj, getCommandSwitch())
 {
     LevelProgress myProgress(myProgObj);
     const CiftiXML& myXML = ciftiIn->getCiftiXML();
@@ -532,7 +567,7 @@ AlgorithmCiftiSeparate::AlgorithmCiftiSeparate(ProgressObject* myProgObj, const
     }
     vector<CiftiBrainModelsMap::VolumeMap> myMap = myBrainMap.getFullVolumeMap();
     int64_t numVoxels = (int64_t)myMap.size();
-    CaretArray<float> rowScratch(rowSize);
+    RowBlockReader rowReader(ciftiIn);
     if (myDir == CiftiXML::ALONG_COLUMN)
     {
         if (rowSize > 1) newdims.push_back(rowSize);
@@ -554,7 +589,7 @@ AlgorithmCiftiSeparate::AlgorithmCiftiSeparate(ProgressObject* myProgObj, const
             {
                 roiOut->setValue(1.0f, thisvoxel);
             }
-            ciftiIn->getRow(rowScratch, myMap[i].m_ciftiIndex);
+            const float* rowScratch = rowReader.getRow(myMap[i].m_ciftiIndex);
             for (int j = 0; j < rowSize; ++j)
             {
                 volOut->setValue(rowScratch[j], thisvoxel, j);
@@ -575,7 +610,7 @@ AlgorithmCiftiSeparate::AlgorithmCiftiSeparate(ProgressObject* myProgObj, const
         }
         for (int64_t i = 0; i < colSize; ++i)
         {
-            ciftiIn->getRow(rowScratch, i);
+            const float* rowScratch = rowReader.getRow(i);
             for (int64_t j = 0; j < numVoxels; ++j)
             {
                 int64_t thisvoxel[3] = { myMap[j].m_ijk[0] - offsetOut[0], myMap[j].m_ijk[1] - offsetOut[1], myMap[j].m_ijk[2] - offsetOut[2] };
@@ -20,18 +20,141 @@
 
 #include "AlgorithmCiftiSmoothing.h"
 #include "AlgorithmException.h"
-#include "AlgorithmMetricSmoothing.h"
 #include "AlgorithmVolumeSmoothing.h"
+#include "CaretPointer.h"
 #include "CiftiFile.h"
+#include "CiftiRowStreamHelper.h"
 #include "MetricFile.h"
+#include "MetricSmoothingObject.h"
 #include "VolumeFile.h"
 #include "SurfaceFile.h"
 #include "AlgorithmCiftiSeparate.h"
 #include "AlgorithmCiftiReplaceStructure.h"
 
+#include <algorithm>
+
 using namespace caret;
 using namespace std;
 
+namespace
+{
+    ///smooths all structures of a file along one direction, or blocks of rows of a file in the row direction
+    class SmoothingBlockFunction : public CiftiRowStreamHelper::BlockFunction
+    {
+        const CiftiXMLOld& m_xml;
+        const vector<StructureEnum::Enum>& m_surfaceList, m_volumeList;
+        const SurfaceFile* m_leftSurf, *m_rightSurf, *m_cerebSurf;
+        const MetricFile* m_leftAreas, *m_rightAreas, *m_cerebAreas;
+        const CiftiFile* m_roiCifti;
+        float m_surfKern, m_volKern;
+        bool m_fixZerosVol, m_fixZerosSurf;
+        //every block has the same mapping, so the weights for each structure are built on first use and reused by the following blocks
+        std::vector<CaretPointer<MetricSmoothingObject> > m_surfSmoothers;
+        std::vector<CaretPointer<AlgorithmVolumeSmoothing::Kernel> > m_volKernels;
+    public:
+        SmoothingBlockFunction(const CiftiXMLOld& myXML, const vector<StructureEnum::Enum>& surfaceList, const vector<StructureEnum::Enum>& volumeList,
+                               const float& surfKern, const float& volKern,
+                               const SurfaceFile* myLeftSurf, const MetricFile* myLeftAreas,
+                               const SurfaceFile* myRightSurf, const MetricFile* myRightAreas,
+                               const SurfaceFile* myCerebSurf, const MetricFile* myCerebAreas,
+                               const CiftiFile* roiCifti, bool fixZerosVol, bool fixZerosSurf) : m_xml(myXML), m_surfaceList(surfaceList), m_volumeList(volumeList)
+        {
+            m_surfKern = surfKern;
+            m_volKern = volKern;
+            m_leftSurf = myLeftSurf;
+            m_leftAreas = myLeftAreas;
+            m_rightSurf = myRightSurf;
+            m_rightAreas = myRightAreas;
+            m_cerebSurf = myCerebSurf;
+            m_cerebAreas = myCerebAreas;
+            m_roiCifti = roiCifti;
+            m_fixZerosVol = fixZerosVol;
+            m_fixZerosSurf = fixZerosSurf;
+            m_surfSmoothers.resize(m_surfaceList.size());
+            m_volKernels.resize(m_volumeList.size());
+        }
+        
+        void smoothFile(const CiftiFile* myCifti, const int& myDir, CiftiFile* myCiftiOut)
+        {//output xml must already be set
+            for (int whichStruct = 0; whichStruct < (int)m_surfaceList.size(); ++whichStruct)
+            {
+                const SurfaceFile* mySurf = NULL;
+                const MetricFile* myAreas = NULL;
+                switch (m_surfaceList[whichStruct])
+                {
+                    case StructureEnum::CORTEX_LEFT:
+                        mySurf = m_leftSurf;
+                        myAreas = m_leftAreas;
+                        break;
+                    case StructureEnum::CORTEX_RIGHT:
+                        mySurf = m_rightSurf;
+                        myAreas = m_rightAreas;
+                        break;
+                    case StructureEnum::CEREBELLUM:
+                        mySurf = m_cerebSurf;
+                        myAreas = m_cerebAreas;
+                        break;
+                    default:
+                        break;
+                }
+                MetricFile myMetric, myRoi, myMetricOut;
+                AlgorithmCiftiSeparate(NULL, myCifti, myDir, m_surfaceList[whichStruct], &myMetric, &myRoi);
+                if (m_roiCifti != NULL)
+                {//due to testing in the algorithm, we know the structure mask is the same, so just overwrite the ROI from the mask
+                    AlgorithmCiftiSeparate(NULL, m_roiCifti, CiftiXMLOld::ALONG_COLUMN, m_surfaceList[whichStruct], &myRoi);
+                }
+                if (m_surfSmoothers[whichStruct] == NULL)
+                {
+                    if (m_surfKern <= 0.0f)
+                    {
+                        throw AlgorithmException("invalid kernel size");
+                    }
+                    const float* areaData = NULL;
+                    if (myAreas != NULL) areaData = myAreas->getValuePointerForColumn(0);
+                    m_surfSmoothers[whichStruct].grabNew(new MetricSmoothingObject(mySurf, m_surfKern, &myRoi, MetricSmoothingObject::GEO_GAUSS_AREA, areaData));
+                }
+                m_surfSmoothers[whichStruct]->smoothMetric(&myMetric, &myMetricOut, &myRoi, m_fixZerosSurf);//same as AlgorithmMetricSmoothing with a static roi
+                AlgorithmCiftiReplaceStructure(NULL, myCiftiOut, myDir, m_surfaceList[whichStruct], &myMetricOut);
+            }
+            for (int whichStruct = 0; whichStruct < (int)m_volumeList.size(); ++whichStruct)
+            {
+                VolumeFile myVol, myRoi, myVolOut;
+                int64_t offset[3];
+                AlgorithmCiftiSeparate(NULL, myCifti, myDir, m_volumeList[whichStruct], &myVol, offset, &myRoi, true);
+                if (m_roiCifti != NULL)
+                {//due to testing in the algorithm, we know the structure mask is the same, so just overwrite the ROI from the mask
+                    AlgorithmCiftiSeparate(NULL, m_roiCifti, CiftiXMLOld::ALONG_COLUMN, m_volumeList[whichStruct], &myRoi, offset, NULL, true);
+                }
+                if (m_volKernels[whichStruct] == NULL)
+                {
+                    m_volKernels[whichStruct].grabNew(new AlgorithmVolumeSmoothing::Kernel(&myVol, m_volKern));
+                }
+                AlgorithmVolumeSmoothing(NULL, &myVol, *(m_volKernels[whichStruct]), &myVolOut, &myRoi, m_fixZerosVol);
+                AlgorithmCiftiReplaceStructure(NULL, myCiftiOut, myDir, m_volumeList[whichStruct], &myVolOut, true);
+            }
+        }
+        
+        void processBlock(const float* inRows, const int64_t& inRowLength, float* outRows, const int64_t& outRowLength,
+                          const int64_t&, const int64_t& numRows)
+        {//rows are smoothed independently in the row direction, so a block of rows is a complete in-memory file with scalar columns
+            CiftiXMLOld blockXML = m_xml;
+            blockXML.resetColumnsToScalars(numRows);
+            CiftiFile blockIn, blockOut;
+            blockIn.setCiftiXML(blockXML);
+            blockIn.setRows(inRows, 0, numRows);
+            blockOut.setCiftiXML(blockXML);
+            smoothFile(&blockIn, CiftiXMLOld::ALONG_ROW, &blockOut);
+            fill(outRows, outRows + numRows * outRowLength, 0.0f);
+            blockOut.getRows(outRows, 0, numRows);
+        }
+        
+        int64_t getExtraBytesPerRow(const int64_t& inRowLength, const int64_t& outRowLength) const
+        {//in-memory block files, plus the separated input and smoothed output of one structure
+            return 2 * (inRowLength + outRowLength) * (int64_t)sizeof(float);
+        }
+    };
+}
+
 AString AlgorithmCiftiSmoothing::getCommandSwitch()
 {
     return "-cifti-smoothing";
@@ -149,7 +272,7 @@ AlgorithmCiftiSmoothing::AlgorithmCiftiSmoothing(ProgressObject* myProgObj, cons
                                                  const SurfaceFile* myLeftSurf, const MetricFile* myLeftAreas,
                                                  const SurfaceFile* myRightSurf, const MetricFile* myRightAreas,
                                                  const SurfaceFile* myCerebSurf, const MetricFile* myCerebAreas,
-                                                 const CiftiFile* roiCifti, bool fixZerosVol, bool fixZerosSurf) : AbstractAlgorithm(myProgObj)
+                                                 const CiftiFile* roiCifti, bool fixZerosVol, bool fixZerosSurf) : AbstractAlgorithm(myProgObj, getCommandSwitch())
 {
     LevelProgress myProgress(myProgObj);
     const CiftiXMLOld& myXML = myCifti->getCiftiXMLOld();
@@ -219,47 +342,13 @@ AlgorithmCiftiSmoothing::AlgorithmCiftiSmoothing(ProgressObject* myProgObj, cons
         }
     }
     myCiftiOut->setCiftiXML(myXML);
-    for (int whichStruct = 0; whichStruct < (int)surfaceList.size(); ++whichStruct)
-    {
-        const SurfaceFile* mySurf = NULL;
-        const MetricFile* myAreas = NULL;
-        switch (surfaceList[whichStruct])
-        {
-            case StructureEnum::CORTEX_LEFT:
-                mySurf = myLeftSurf;
-                myAreas = myLeftAreas;
-                break;
-            case StructureEnum::CORTEX_RIGHT:
-                mySurf = myRightSurf;
-                myAreas = myRightAreas;
-                break;
-            case StructureEnum::CEREBELLUM:
-                mySurf = myCerebSurf;
-                myAreas = myCerebAreas;
-                break;
-            default:
-                break;
-        }
-        MetricFile myMetric, myRoi, myMetricOut;
-        AlgorithmCiftiSeparate(NULL, myCifti, myDir, surfaceList[whichStruct], &myMetric, &myRoi);
-        if (roiCifti != NULL)
-        {//due to above testing, we know the structure mask is the same, so just overwrite the ROI from the mask
-            AlgorithmCiftiSeparate(NULL, roiCifti, CiftiXMLOld::ALONG_COLUMN, surfaceList[whichStruct], &myRoi);
-        }
-        AlgorithmMetricSmoothing(NULL, mySurf, &myMetric, surfKern, &myMetricOut, &myRoi, false, fixZerosSurf, -1, myAreas);
-        AlgorithmCiftiReplaceStructure(NULL, myCiftiOut, myDir, surfaceList[whichStruct], &myMetricOut);
-    }
-    for (int whichStruct = 0; whichStruct < (int)volumeList.size(); ++whichStruct)
-    {
-        VolumeFile myVol, myRoi, myVolOut;
-        int64_t offset[3];
-        AlgorithmCiftiSeparate(NULL, myCifti, myDir, volumeList[whichStruct], &myVol, offset, &myRoi, true);
-        if (roiCifti != NULL)
-        {//due to above testing, we know the structure mask is the same, so just overwrite the ROI from the mask
-            AlgorithmCiftiSeparate(NULL, roiCifti, CiftiXMLOld::ALONG_COLUMN, volumeList[whichStruct], &myRoi, offset, NULL, true);
-        }
-        AlgorithmVolumeSmoothing(NULL, &myVol, volKern, &myVolOut, &myRoi, fixZerosVol);
-        AlgorithmCiftiReplaceStructure(NULL, myCiftiOut, myDir, volumeList[whichStruct], &myVolOut, true);
+    SmoothingBlockFunction myFunction(myXML, surfaceList, volumeList, surfKern, volKern, myLeftSurf, myLeftAreas, myRightSurf, myRightAreas,
+                                      myCerebSurf, myCerebAreas, roiCifti, fixZerosVol, fixZerosSurf);
+    if (myDir == CiftiXMLOld::ALONG_ROW)
+    {//each row is smoothed on its own, so stream blocks of rows to bound memory use on large files like dconn
+        CiftiRowStreamHelper::streamRows(myCifti, myCiftiOut, &myFunction);
+    } else {
+        myFunction.smoothFile(myCifti, myDir, myCiftiOut);
     }
 }
 
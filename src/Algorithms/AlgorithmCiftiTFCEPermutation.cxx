@@ -0,0 +1,409 @@
+/*LICENSE_START*/
+/*
+ *  Copyright (C) 2014  Washington University School of Medicine
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+/*LICENSE_END*/
+
+#include "AlgorithmCiftiTFCEPermutation.h"
+#include "AlgorithmException.h"
+
+#include "AlgorithmMetricTFCE.h"
+#include "AlgorithmVolumeTFCE.h"
+#include "CaretOMP.h"
+#include "CaretPointer.h"
+#include "CiftiFile.h"
+#include "MetricFile.h"
+#include "PermutationTestHelper.h"
+#include "SurfaceFile.h"
+#include "TopologyHelper.h"
+#include "Vector3D.h"
+
+#include <cmath>
+#include <vector>
+
+using namespace caret;
+using namespace std;
+
+AString AlgorithmCiftiTFCEPermutation::getCommandSwitch()
+{
+    return "-cifti-tfce-permutation";
+}
+
+AString AlgorithmCiftiTFCEPermutation::getShortDescription()
+{
+    return "TFCE PERMUTATION TEST ON A CIFTI FILE";
+}
+
+OperationParameters* AlgorithmCiftiTFCEPermutation::getParameters()
+{
+    OperationParameters* ret = new OperationParameters();
+    ret->addCiftiParameter(1, "cifti-in", "the input cifti, with one map per subject");
+    
+    ret->addCiftiOutputParameter(2, "p-value-out", "output - the family-wise error corrected p-values");
+    
+    OptionalParameter* leftSurfOpt = ret->createOptionalParameter(3, "-left-surface", "specify the left surface to use");
+    leftSurfOpt->addSurfaceParameter(1, "surface", "the left surface file");
+    OptionalParameter* leftCorrAreasOpt = leftSurfOpt->createOptionalParameter(2, "-left-corrected-areas", "vertex areas to use instead of computing them from the left surface");
+    leftCorrAreasOpt->addMetricParameter(1, "area-metric", "the corrected vertex areas, as a metric");
+    
+    OptionalParameter* rightSurfOpt = ret->createOptionalParameter(4, "-right-surface", "specify the right surface to use");
+    rightSurfOpt->addSurfaceParameter(1, "surface", "the right surface file");
+    OptionalParameter* rightCorrAreasOpt = rightSurfOpt->createOptionalParameter(2, "-right-corrected-areas", "vertex areas to use instead of computing them from the right surface");
+    rightCorrAreasOpt->addMetricParameter(1, "area-metric", "the corrected vertex areas, as a metric");
+    
+    OptionalParameter* cerebSurfOpt = ret->createOptionalParameter(5, "-cerebellum-surface", "specify the cerebellum surface to use");
+    cerebSurfOpt->addSurfaceParameter(1, "surface", "the cerebellum surface file");
+    OptionalParameter* cerebCorrAreasOpt = cerebSurfOpt->createOptionalParameter(2, "-cerebellum-corrected-areas", "vertex areas to use instead of computing them from the cerebellum surface");
+    cerebCorrAreasOpt->addMetricParameter(1, "area-metric", "the corrected vertex areas, as a metric");
+    
+    OptionalParameter* surfParamsOpt = ret->createOptionalParameter(6, "-surface-parameters", "set parameters for the surface TFCE integral");
+    surfParamsOpt->addDoubleParameter(1, "E", "exponent for cluster area (default 1.0)");
+    surfParamsOpt->addDoubleParameter(2, "H", "exponent for threshold value (default 2.0)");
+    
+    OptionalParameter* volParamsOpt = ret->createOptionalParameter(7, "-volume-parameters", "set parameters for the volume TFCE integral");
+    volParamsOpt->addDoubleParameter(1, "E", "exponent for cluster volume (default 0.5)");
+    volParamsOpt->addDoubleParameter(2, "H", "exponent for threshold value (default 2.0)");
+    
+    OptionalParameter* twoSampleOpt = ret->createOptionalParameter(8, "-two-sample", "compare two groups instead of testing the mean against zero");
+    twoSampleOpt->addIntegerParameter(1, "first-group-size", "the number of maps in the first group, the remaining maps are the second group");
+    
+    OptionalParameter* numPermOpt = ret->createOptionalParameter(9, "-permutations", "set the number of permutations");
+    numPermOpt->addIntegerParameter(1, "number", "the number of permutations (default 5000)");
+    
+    OptionalParameter* seedOpt = ret->createOptionalParameter(10, "-seed", "set the seed for generating permutations");
+    seedOpt->addIntegerParameter(1, "seed", "the seed (default 0)");
+    
+    OptionalParameter* tfceOutOpt = ret->createOptionalParameter(11, "-tfce-out", "output the TFCE-enhanced t-statistic of the unpermuted data");
+    tfceOutOpt->addCiftiOutputParameter(1, "tfce-out", "the enhanced statistic");
+    
+    ret->setHelpText(
+        AString("Runs a nonparametric permutation test using the TFCE-enhanced t-statistic.  ") +
+        "The input must have a brain models mapping along columns, with one map per subject, as in a .dscalar.nii file.  " +
+        "By default, the mean is tested against zero by randomly flipping the sign of each subject's data.  " +
+        "With -two-sample, the first maps are compared against the remaining maps by randomly permuting group membership.\n\n" +
+        "Each surface structure is enhanced on its own surface, which must be specified, and all voxels are enhanced together as one volume.  " +
+        "Topology, vertex areas and the mapping to the surfaces and volume are computed once and shared by all permutations, " +
+        "and only the maximum absolute value of each permuted map, across all structures, is kept.  " +
+        "The output p-values are two-sided and corrected for multiple comparisons across all grayordinates by the max statistic method, " +
+        "where the unpermuted data counts as one of the permutations, so the smallest possible p-value is 1 / (permutations + 1).  " +
+        "Permutations are generated from the seed, so results are reproducible regardless of the number of threads.\n\n" +
+        "See -metric-tfce and -volume-tfce for a description of TFCE and its parameters."
+    );
+    return ret;
+}
+
+void AlgorithmCiftiTFCEPermutation::useParameters(OperationParameters* myParams, ProgressObject* myProgObj)
+{
+    CiftiFile* myCifti = myParams->getCifti(1);
+    CiftiFile* myPValueOut = myParams->getOutputCifti(2);
+    SurfaceFile* myLeftSurf = NULL, *myRightSurf = NULL, *myCerebSurf = NULL;
+    MetricFile* myLeftAreas = NULL, *myRightAreas = NULL, *myCerebAreas = NULL;
+    OptionalParameter* leftSurfOpt = myParams->getOptionalParameter(3);
+    if (leftSurfOpt->m_present)
+    {
+        myLeftSurf = leftSurfOpt->getSurface(1);
+        OptionalParameter* leftCorrAreasOpt = leftSurfOpt->getOptionalParameter(2);
+        if (leftCorrAreasOpt->m_present)
+        {
+            myLeftAreas = leftCorrAreasOpt->getMetric(1);
+        }
+    }
+    OptionalParameter* rightSurfOpt = myParams->getOptionalParameter(4);
+    if (rightSurfOpt->m_present)
+    {
+        myRightSurf = rightSurfOpt->getSurface(1);
+        OptionalParameter* rightCorrAreasOpt = rightSurfOpt->getOptionalParameter(2);
+        if (rightCorrAreasOpt->m_present)
+        {
+            myRightAreas = rightCorrAreasOpt->getMetric(1);
+        }
+    }
+    OptionalParameter* cerebSurfOpt = myParams->getOptionalParameter(5);
+    if (cerebSurfOpt->m_present)
+    {
+        myCerebSurf = cerebSurfOpt->getSurface(1);
+        OptionalParameter* cerebCorrAreasOpt = cerebSurfOpt->getOptionalParameter(2);
+        if (cerebCorrAreasOpt->m_present)
+        {
+            myCerebAreas = cerebCorrAreasOpt->getMetric(1);
+        }
+    }
+    float surf_e = 1.0f, surf_h = 2.0f;
+    OptionalParameter* surfParamsOpt = myParams->getOptionalParameter(6);
+    if (surfParamsOpt->m_present)
+    {
+        surf_e = (float)surfParamsOpt->getDouble(1);
+        surf_h = (float)surfParamsOpt->getDouble(2);
+    }
+    float vol_e = 0.5f, vol_h = 2.0f;
+    OptionalParameter* volParamsOpt = myParams->getOptionalParameter(7);
+    if (volParamsOpt->m_present)
+    {
+        vol_e = (float)volParamsOpt->getDouble(1);
+        vol_h = (float)volParamsOpt->getDouble(2);
+    }
+    int numFirstGroup = -1;
+    OptionalParameter* twoSampleOpt = myParams->getOptionalParameter(8);
+    if (twoSampleOpt->m_present)
+    {
+        numFirstGroup = (int)twoSampleOpt->getInteger(1);
+        if (numFirstGroup < 1) throw AlgorithmException("first group size must be positive");
+    }
+    int numPermutations = 5000;
+    OptionalParameter* numPermOpt = myParams->getOptionalParameter(9);
+    if (numPermOpt->m_present)
+    {
+        numPermutations = (int)numPermOpt->getInteger(1);
+        if (numPermutations < 1) throw AlgorithmException("number of permutations must be positive");
+    }
+    int64_t seed = 0;
+    OptionalParameter* seedOpt = myParams->getOptionalParameter(10);
+    if (seedOpt->m_present)
+    {
+        seed = seedOpt->getInteger(1);
+    }
+    CiftiFile* myTFCEOut = NULL;
+    OptionalParameter* tfceOutOpt = myParams->getOptionalParameter(11);
+    if (tfceOutOpt->m_present)
+    {
+        myTFCEOut = tfceOutOpt->getOutputCifti(1);
+    }
+    AlgorithmCiftiTFCEPermutation(myProgObj, myCifti, myPValueOut, numPermutations, numFirstGroup, myLeftSurf, myRightSurf, myCerebSurf,
+                                  myLeftAreas, myRightAreas, myCerebAreas, surf_e, surf_h, vol_e, vol_h, myTFCEOut, seed);
+}
+
+namespace _algorithm_cifti_tfce_permutation
+{//hidden namespace just to make sure things don't collide
+    struct SurfaceComponent
+    {//everything needed to run TFCE on one surface structure, computed once for all permutations
+        const SurfaceFile* m_surface;
+        vector<CiftiBrainModelsMap::SurfaceMap> m_map;
+        vector<float> m_roi, m_areas;
+    };
+    
+    struct VolumeComponent
+    {
+        vector<CiftiBrainModelsMap::VolumeMap> m_map;
+        vector<float> m_roi;
+        int64_t m_dims[3];
+        float m_voxelVolume;
+    };
+    
+    struct ThreadScratch
+    {
+        vector<CaretPointer<TopologyHelper> > m_helpers;
+        vector<float> m_surfIn, m_surfOut, m_volIn, m_volOut;
+    };
+    
+    void enhance(const float* statIn, float* enhancedOut, const vector<SurfaceComponent>& surfComponents, const VolumeComponent* volComponent, ThreadScratch& scratch,
+                 const float& surf_e, const float& surf_h, const float& vol_e, const float& vol_h)
+    {
+        for (int i = 0; i < (int)surfComponents.size(); ++i)
+        {
+            const SurfaceComponent& thisComp = surfComponents[i];
+            const int numNodes = thisComp.m_surface->getNumberOfNodes();
+            scratch.m_surfIn.assign(numNodes, 0.0f);
+            scratch.m_surfOut.resize(numNodes);
+            const int64_t mapSize = (int64_t)thisComp.m_map.size();
+            for (int64_t j = 0; j < mapSize; ++j)
+            {
+                scratch.m_surfIn[thisComp.m_map[j].m_surfaceNode] = statIn[thisComp.m_map[j].m_ciftiIndex];
+            }
+            AlgorithmMetricTFCE::processColumn(scratch.m_helpers[i], scratch.m_surfIn.data(), scratch.m_surfOut.data(), thisComp.m_roi.data(), surf_e, surf_h, thisComp.m_areas.data());
+            for (int64_t j = 0; j < mapSize; ++j)
+            {
+                enhancedOut[thisComp.m_map[j].m_ciftiIndex] = scratch.m_surfOut[thisComp.m_map[j].m_surfaceNode];
+            }
+        }
+        if (volComponent != NULL)
+        {
+            const int64_t* dims = volComponent->m_dims;
+            scratch.m_volIn.assign(dims[0] * dims[1] * dims[2], 0.0f);
+            scratch.m_volOut.resize(dims[0] * dims[1] * dims[2]);
+            const int64_t mapSize = (int64_t)volComponent->m_map.size();
+            for (int64_t j = 0; j < mapSize; ++j)
+            {
+                const int64_t* ijk = volComponent->m_map[j].m_ijk;
+                scratch.m_volIn[ijk[0] + dims[0] * (ijk[1] + dims[1] * ijk[2])] = statIn[volComponent->m_map[j].m_ciftiIndex];
+            }
+            AlgorithmVolumeTFCE::processFrame(scratch.m_volIn.data(), dims, volComponent->m_voxelVolume, scratch.m_volOut.data(), volComponent->m_roi.data(), vol_e, vol_h);
+            for (int64_t j = 0; j < mapSize; ++j)
+            {
+                const int64_t* ijk = volComponent->m_map[j].m_ijk;
+                enhancedOut[volComponent->m_map[j].m_ciftiIndex] = scratch.m_volOut[ijk[0] + dims[0] * (ijk[1] + dims[1] * ijk[2])];
+            }
+        }
+    }
+}
+
+using namespace _algorithm_cifti_tfce_permutation;
+
+AlgorithmCiftiTFCEPermutation::AlgorithmCiftiTFCEPermutation(ProgressObject* myProgObj, const CiftiFile* myCifti, CiftiFile* myPValueOut, const int& numPermutations, const int& numFirstGroup,
+                                                             const SurfaceFile* myLeftSurf, const SurfaceFile* myRightSurf, const SurfaceFile* myCerebSurf,
+                                                             const MetricFile* myLeftAreas, const MetricFile* myRightAreas, const MetricFile* myCerebAreas,
+                                                             const float& surf_e, const float& surf_h, const float& vol_e, const float& vol_h,
+                                                             CiftiFile* myTFCEOut, const int64_t& seed) : AbstractAlgorithm(myProgObj, getCommandSwitch())
+{
+    LevelProgress myProgress(myProgObj);
+    const CiftiXML& myXML = myCifti->getCiftiXML();
+    if (myXML.getNumberOfDimensions() != 2) throw AlgorithmException("input cifti file must have 2 dimensions");
+    if (myXML.getMappingType(CiftiXML::ALONG_COLUMN) != CiftiMappingType::BRAIN_MODELS) throw AlgorithmException("input cifti file must have brain models mapping along column");
+    const CiftiBrainModelsMap& myDenseMap = myXML.getBrainModelsMap(CiftiXML::ALONG_COLUMN);
+    const int64_t numRows = myCifti->getNumberOfRows();
+    const int numSubjects = (int)myCifti->getNumberOfColumns();
+    PermutationTestHelper myPermHelper(numSubjects, numFirstGroup, numPermutations, (uint64_t)seed);
+    vector<SurfaceComponent> surfComponents;
+    vector<StructureEnum::Enum> surfaceList = myDenseMap.getSurfaceStructureList();
+    for (int i = 0; i < (int)surfaceList.size(); ++i)
+    {
+        const SurfaceFile* mySurf = NULL;
+        const MetricFile* myAreas = NULL;
+        AString surfType;
+        switch (surfaceList[i])
+        {
+            case StructureEnum::CORTEX_LEFT:
+                mySurf = myLeftSurf;
+                myAreas = myLeftAreas;
+                surfType = "left";
+                break;
+            case StructureEnum::CORTEX_RIGHT:
+                mySurf = myRightSurf;
+                myAreas = myRightAreas;
+                surfType = "right";
+                break;
+            case StructureEnum::CEREBELLUM:
+                mySurf = myCerebSurf;
+                myAreas = myCerebAreas;
+                surfType = "cerebellum";
+                break;
+            default:
+                throw AlgorithmException("found surface model with incorrect type: " + StructureEnum::toName(surfaceList[i]));
+                break;
+        }
+        if (mySurf == NULL) throw AlgorithmException(surfType + " surface required but not provided");
+        const int numNodes = mySurf->getNumberOfNodes();
+        if (numNodes != myDenseMap.getSurfaceNumberOfNodes(surfaceList[i])) throw AlgorithmException(surfType + " surface has the wrong number of vertices");
+        if (myAreas != NULL && myAreas->getNumberOfNodes() != numNodes) throw AlgorithmException(surfType + " corrected vertex areas metric has the wrong number of vertices");
+        SurfaceComponent thisComp;
+        thisComp.m_surface = mySurf;
+        thisComp.m_map = myDenseMap.getSurfaceMap(surfaceList[i]);
+        thisComp.m_roi.resize(numNodes, 0.0f);
+        for (int64_t j = 0; j < (int64_t)thisComp.m_map.size(); ++j)
+        {
+            thisComp.m_roi[thisComp.m_map[j].m_surfaceNode] = 1.0f;
+        }
+        if (myAreas == NULL)
+        {
+            mySurf->computeNodeAreas(thisComp.m_areas);
+        } else {
+            const float* areaData = myAreas->getValuePointerForColumn(0);
+            thisComp.m_areas.assign(areaData, areaData + numNodes);
+        }
+        surfComponents.push_back(thisComp);
+    }
+    CaretPointer<VolumeComponent> volComponent;
+    if (myDenseMap.hasVolumeData())
+    {
+        volComponent.grabNew(new VolumeComponent());
+        const VolumeSpace& mySpace = myDenseMap.getVolumeSpace();
+        const int64_t* dims = mySpace.getDims();
+        for (int i = 0; i < 3; ++i) volComponent->m_dims[i] = dims[i];
+        Vector3D ivec, jvec, kvec, origin;
+        mySpace.getSpacingVectors(ivec, jvec, kvec, origin);
+        volComponent->m_voxelVolume = abs(ivec.dot(jvec.cross(kvec)));
+        volComponent->m_map = myDenseMap.getFullVolumeMap();
+        volComponent->m_roi.resize(dims[0] * dims[1] * dims[2], 0.0f);
+        for (int64_t j = 0; j < (int64_t)volComponent->m_map.size(); ++j)
+        {
+            volComponent->m_roi[mySpace.getIndex(volComponent->m_map[j].m_ijk)] = 1.0f;
+        }
+    }
+    vector<vector<float> > subjectStorage(numSubjects, vector<float>(numRows));//transpose so each subject's map is contiguous
+    {
+        vector<float> scratchRow(numSubjects);
+        for (int64_t row = 0; row < numRows; ++row)
+        {
+            myCifti->getRow(scratchRow.data(), row);
+            for (int s = 0; s < numSubjects; ++s)
+            {
+                subjectStorage[s][row] = scratchRow[s];
+            }
+        }
+    }
+    vector<const float*> subjectData(numSubjects);
+    for (int s = 0; s < numSubjects; ++s)
+    {
+        subjectData[s] = subjectStorage[s].data();
+    }
+    vector<float> observedTFCE(numRows);
+    {
+        ThreadScratch scratch;
+        for (int i = 0; i < (int)surfComponents.size(); ++i)
+        {
+            scratch.m_helpers.push_back(surfComponents[i].m_surface->getTopologyHelper());
+        }
+        vector<float> observedStat(numRows);
+        myPermHelper.computeStatistic(-1, subjectData, numRows, observedStat.data());
+        enhance(observedStat.data(), observedTFCE.data(), surfComponents, volComponent, scratch, surf_e, surf_h, vol_e, vol_h);
+    }
+    vector<float> maxDistribution(numPermutations);
+#pragma omp CARET_PAR
+    {
+        ThreadScratch scratch;
+        for (int i = 0; i < (int)surfComponents.size(); ++i)
+        {
+            scratch.m_helpers.push_back(surfComponents[i].m_surface->getTopologyHelper());
+        }
+        vector<float> permStat(numRows), permTFCE(numRows);
+#pragma omp CARET_FOR schedule(dynamic)
+        for (int perm = 0; perm < numPermutations; ++perm)
+        {
+            myPermHelper.computeStatistic(perm, subjectData, numRows, permStat.data());
+            enhance(permStat.data(), permTFCE.data(), surfComponents, volComponent, scratch, surf_e, surf_h, vol_e, vol_h);
+            maxDistribution[perm] = PermutationTestHelper::maxAbsolute(permTFCE.data(), numRows);
+        }
+    }
+    vector<float> pValues(numRows);
+    PermutationTestHelper::computeCorrectedPValues(maxDistribution, observedTFCE.data(), numRows, pValues.data());
+    CiftiXML outXML;
+    outXML.setNumberOfDimensions(2);
+    outXML.setMap(CiftiXML::ALONG_COLUMN, myDenseMap);
+    CiftiScalarsMap outRowMap;
+    outRowMap.setLength(1);
+    outRowMap.setMapName(0, "TFCE FWE p-value");
+    outXML.setMap(CiftiXML::ALONG_ROW, outRowMap);
+    myPValueOut->setCiftiXML(outXML);
+    myPValueOut->setColumn(pValues.data(), 0);
+    if (myTFCEOut != NULL)
+    {
+        outRowMap.setMapName(0, "TFCE t-statistic");
+        outXML.setMap(CiftiXML::ALONG_ROW, outRowMap);
+        myTFCEOut->setCiftiXML(outXML);
+        myTFCEOut->setColumn(observedTFCE.data(), 0);
+    }
+}
+
+float AlgorithmCiftiTFCEPermutation::getAlgorithmInternalWeight()
+{
+    return 1.0f;//override this if needed, if the progress bar isn't smooth
+}
+
+float AlgorithmCiftiTFCEPermutation::getSubAlgorithmWeight()
+{
+    //return AlgorithmInsertNameHere::getAlgorithmWeight();//if you use a subalgorithm
+    return 0.0f;
+}
@@ -23,9 +23,11 @@
 
 #include "GiftiLabelTable.h"
 #include "LabelFile.h"
+#include "LabelKeyRemap.h"
 #include "MetricFile.h"
 
 #include <map>
+#include <vector>
 
 using namespace caret;
 using namespace std;
@@ -69,7 +71,7 @@ void AlgorithmGiftiAllLabelsToROIs::useParameters(OperationParameters* myParams,
     AlgorithmGiftiAllLabelsToROIs(myProgObj, myLabel, whichMap, myMetricOut);
 }
 
-AlgorithmGiftiAllLabelsToROIs::AlgorithmGiftiAllLabelsToROIs(ProgressObject* myProgObj, const LabelFile* myLabel, const int& whichMap, MetricFile* myMetricOut) : AbstractAlgorithm(myProgObj)
+AlgorithmGiftiAllLabelsToROIs::AlgorithmGiftiAllLabelsToROIs(ProgressObject* myProgObj, const LabelFile* myLabel, const int& whichMap, MetricFile* myMetricOut) : AbstractAlgorithm(myProgObj, getCommandSwitch())
 {
     LevelProgress myProgress(myProgObj);
     if (whichMap < 0 || whichMap >= myLabel->getNumberOfMaps())
@@ -85,7 +87,7 @@ AlgorithmGiftiAllLabelsToROIs::AlgorithmGiftiAllLabelsToROIs(ProgressObject* myP
         throw AlgorithmException("label table doesn't contain any keys besides the ??? key");
     }
     int numNodes = myLabel->getNumberOfNodes();
-    map<int32_t, int> keyToMap;//lookup from keys to column
+    map<int32_t, int32_t> keyToMap;//lookup from keys to column
     myMetricOut->setNumberOfNodesAndColumns(numNodes, numKeys - 1);//skip the ??? label
     myMetricOut->setStructure(myLabel->getStructure());
     for (int i = 0; i < numKeys - 1; ++i)
@@ -100,13 +102,13 @@ AlgorithmGiftiAllLabelsToROIs::AlgorithmGiftiAllLabelsToROIs(ProgressObject* myP
         myMetricOut->setMapName(counter, myTable->getLabelName(*iter));
         ++counter;
     }
-    const int32_t* myColumn = myLabel->getLabelKeyPointerForColumn(whichMap);
+    vector<int32_t> nodeMaps(numNodes);//which output map each node is in, -1 for none
+    LabelKeyRemap(keyToMap, -1).apply(myLabel->getLabelKeyPointerForColumn(whichMap), nodeMaps.data(), numNodes);
     for (int i = 0; i < numNodes; ++i)
     {
-        map<int32_t, int>::iterator iter = keyToMap.find(myColumn[i]);
-        if (iter != keyToMap.end())
+        if (nodeMaps[i] >= 0)
         {
-            myMetricOut->setValue(i, iter->second, 1.0f);
+            myMetricOut->setValue(i, nodeMaps[i], 1.0f);
         }
     }
 }
@@ -93,7 +93,7 @@ void AlgorithmLabelDilate::useParameters(OperationParameters* myParams, Progress
 }
 
 AlgorithmLabelDilate::AlgorithmLabelDilate(ProgressObject* myProgObj, const LabelFile* myLabel, const SurfaceFile* mySurf, float myDist, LabelFile* myLabelOut,
-                                           const MetricFile* badNodeRoi, int columnNum) : AbstractAlgorithm(myProgObj)
+                                           const MetricFile* badNodeRoi, int columnNum) : AbstractAlgorithm(myProgObj, getCommandSwitch())
 {
     LevelProgress myProgress(myProgObj);
     int32_t unusedLabel = myLabel->getLabelTable()->getUnassignedLabelKey();
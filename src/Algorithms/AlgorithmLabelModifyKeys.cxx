@@ -25,6 +25,7 @@
 #include "GiftiLabel.h"
 #include "GiftiLabelTable.h"
 #include "LabelFile.h"
+#include "LabelKeyRemap.h"
 
 #include <fstream>
 #include <vector>
@@ -97,7 +98,7 @@ void AlgorithmLabelModifyKeys::useParameters(OperationParameters* myParams, Prog
     AlgorithmLabelModifyKeys(myProgObj, labelIn, remap, labelOut, column);
 }
 
-AlgorithmLabelModifyKeys::AlgorithmLabelModifyKeys(ProgressObject* myProgObj, const LabelFile* labelIn, const map<int32_t, int32_t>& remap, LabelFile* labelOut, const int& column) : AbstractAlgorithm(myProgObj)
+AlgorithmLabelModifyKeys::AlgorithmLabelModifyKeys(ProgressObject* myProgObj, const LabelFile* labelIn, const map<int32_t, int32_t>& remap, LabelFile* labelOut, const int& column) : AbstractAlgorithm(myProgObj, getCommandSwitch())
 {
     LevelProgress myProgress(myProgObj);
     const GiftiLabelTable* oldTable = labelIn->getLabelTable();
@@ -169,6 +170,7 @@ AlgorithmLabelModifyKeys::AlgorithmLabelModifyKeys(ProgressObject* myProgObj, co
         newTable.insertLabel(&newLabel);//insert forces it to use the key in the label, even if it causes a duplicate name (which the original might theoretically have)
         valueChanges[*iter] = newKey;
     }
+    const LabelKeyRemap myRemap(valueChanges);//keys that weren't changed keep their value
     int numNodes = labelIn->getNumberOfNodes(), numColumns = labelIn->getNumberOfColumns();
     vector<int32_t> scratchCol(numNodes);
     if (column == -1)
@@ -179,17 +181,7 @@ AlgorithmLabelModifyKeys::AlgorithmLabelModifyKeys(ProgressObject* myProgObj, co
         for (int i = 0; i < numColumns; ++i)
         {
             labelOut->setColumnName(i, labelIn->getColumnName(i));
-            const int32_t* inCol = labelIn->getLabelKeyPointerForColumn(i);
-            for (int j = 0; j < numNodes; ++j)
-            {
-                map<int32_t, int32_t>::const_iterator iter = valueChanges.find(inCol[j]);
-                if (iter == valueChanges.end())
-                {
-                    scratchCol[j] = inCol[j];
-                } else {
-                    scratchCol[j] = iter->second;
-                }
-            }
+            myRemap.apply(labelIn->getLabelKeyPointerForColumn(i), scratchCol.data(), numNodes);
             labelOut->setLabelKeysForColumn(i, scratchCol.data());
         }
     } else {
@@ -197,17 +189,7 @@ AlgorithmLabelModifyKeys::AlgorithmLabelModifyKeys(ProgressObject* myProgObj, co
         labelOut->setStructure(labelIn->getStructure());
         *(labelOut->getLabelTable()) = newTable;
         labelOut->setColumnName(0, labelIn->getColumnName(column));
-        const int32_t* inCol = labelIn->getLabelKeyPointerForColumn(column);
-        for (int j = 0; j < numNodes; ++j)
-        {
-            map<int32_t, int32_t>::const_iterator iter = valueChanges.find(inCol[j]);
-            if (iter == valueChanges.end())
-            {
-                scratchCol[j] = inCol[j];
-            } else {
-                scratchCol[j] = iter->second;
-            }
-        }
+        myRemap.apply(labelIn->getLabelKeyPointerForColumn(column), scratchCol.data(), numNodes);
         labelOut->setLabelKeysForColumn(0, scratchCol.data());
     }
 }
@@ -28,6 +28,9 @@
 #include "LabelFile.h"
 #include "SurfaceFile.h"
 
+#include <map>
+#include <set>
+
 using namespace caret;
 using namespace std;
 
@@ -88,7 +91,7 @@ void AlgorithmLabelToBorder::useParameters(OperationParameters* myParams, Progre
 }
 
 AlgorithmLabelToBorder::AlgorithmLabelToBorder(ProgressObject* myProgObj, const SurfaceFile* mySurf, const LabelFile* myLabel, BorderFile* myBorderOut,
-                                               const float& placement, const int& columnNum) : AbstractAlgorithm(myProgObj)
+                                               const float& placement, const int& columnNum) : AbstractAlgorithm(myProgObj, getCommandSwitch())
 {
     LevelProgress myProgress(myProgObj);
     if (mySurf->getNumberOfNodes() != myLabel->getNumberOfNodes()) throw AlgorithmException("label file does not match surface file number of vertices");
@@ -97,42 +100,49 @@ AlgorithmLabelToBorder::AlgorithmLabelToBorder(ProgressObject* myProgObj, const
     myBorderOut->setStructure(mySurf->getStructure());
     myBorderOut->setNumberOfNodes(mySurf->getNumberOfNodes());
     BorderTracingHelper myHelper(mySurf);
-    if (columnNum == -1)
+    const GiftiLabelTable* myTable = myLabel->getLabelTable();
+    set<int32_t> myKeys = myTable->getKeys();
+    int32_t unassignedKey = myTable->getUnassignedLabelKey();
+    vector<int32_t> regionKeys;//trace all labels of a map at once, each label is a region
+    map<int32_t, int> keyToRegion;
+    for (set<int32_t>::iterator iter = myKeys.begin(); iter != myKeys.end(); ++iter)
+    {
+        if (*iter == unassignedKey) continue;
+        keyToRegion[*iter] = (int)regionKeys.size();
+        regionKeys.push_back(*iter);
+        myBorderOut->getNameColorTable()->addLabel(myTable->getLabel(*iter));
+    }
+    int numRegions = (int)regionKeys.size();
+    int numNodes = mySurf->getNumberOfNodes();
+    vector<int> regionOfNode(numNodes);
+    int startCol = 0, endCol = myLabel->getNumberOfColumns();
+    if (columnNum != -1)
+    {
+        startCol = columnNum;
+        endCol = columnNum + 1;
+    }
+    for (int col = startCol; col < endCol; ++col)
     {
-        for (int col = 0; col < myLabel->getNumberOfColumns(); ++col)
+        const int32_t* colData = myLabel->getLabelKeyPointerForColumn(col);
+        for (int i = 0; i < numNodes; ++i)
         {
-            const GiftiLabelTable* myTable = myLabel->getLabelTable();
-            set<int32_t> myKeys = myTable->getKeys();
-            int32_t unassignedKey = myTable->getUnassignedLabelKey();
-            for (set<int32_t>::iterator iter = myKeys.begin(); iter != myKeys.end(); ++iter)
+            map<int32_t, int>::const_iterator iter = keyToRegion.find(colData[i]);
+            if (iter == keyToRegion.end())
             {
-                if (*iter == unassignedKey) continue;
-                vector<CaretPointer<Border> > result = myHelper.traceData(myLabel->getLabelKeyPointerForColumn(col), BorderTracingHelper::LabelSelect(*iter), placement);
-                AString borderName = myTable->getLabelName(*iter);
-                myBorderOut->getNameColorTable()->addLabel(myTable->getLabel(*iter));
-                for (int i = 0; i < (int)result.size(); ++i)
-                {
-                    result[i]->setClassName(myLabel->getMapName(col));
-                    result[i]->setName(borderName);
-                    myBorderOut->addBorder(result[i].releasePointer());//NOTE: addBorder takes ownership of a RAW POINTER, shared_ptr won't release the pointer
-                }
+                regionOfNode[i] = -1;
+            } else {
+                regionOfNode[i] = iter->second;
             }
         }
-    } else {
-        const GiftiLabelTable* myTable = myLabel->getLabelTable();
-        set<int32_t> myKeys = myTable->getKeys();
-        int32_t unassignedKey = myTable->getUnassignedLabelKey();
-        for (set<int32_t>::iterator iter = myKeys.begin(); iter != myKeys.end(); ++iter)
+        vector<vector<CaretPointer<Border> > > result = myHelper.traceRegions(regionOfNode, numRegions, placement);
+        for (int r = 0; r < numRegions; ++r)
         {
-            if (*iter == unassignedKey) continue;
-            vector<CaretPointer<Border> > result = myHelper.traceData(myLabel->getLabelKeyPointerForColumn(columnNum), BorderTracingHelper::LabelSelect(*iter), placement);
-            AString borderName = myTable->getLabelName(*iter);
-            myBorderOut->getNameColorTable()->addLabel(myTable->getLabel(*iter));
-            for (int i = 0; i < (int)result.size(); ++i)
+            AString borderName = myTable->getLabelName(regionKeys[r]);
+            for (int i = 0; i < (int)result[r].size(); ++i)
             {
-                result[i]->setClassName(myLabel->getMapName(columnNum));
-                result[i]->setName(borderName);
-                myBorderOut->addBorder(result[i].releasePointer());//ditto
+                result[r][i]->setClassName(myLabel->getMapName(col));
+                result[r][i]->setName(borderName);
+                myBorderOut->addBorder(result[r][i].releasePointer());//NOTE: addBorder takes ownership of a RAW POINTER, shared_ptr won't release the pointer
             }
         }
     }
@@ -23,6 +23,7 @@
 
 #include "CaretAssert.h"
 #include "CaretOMP.h"
+#include "DilationPlan.h"
 #include "GeodesicHelper.h"
 #include "MetricFile.h"
 #include "PaletteColorMapping.h"
@@ -36,6 +37,16 @@
 using namespace caret;
 using namespace std;
 
+namespace
+{
+    enum NodeStatus
+    {
+        NODE_IGNORE = 0,//outside the data roi, copied unchanged and not used for dilation
+        NODE_GOOD = 1,
+        NODE_BAD = 2
+    };
+}
+
 AString AlgorithmMetricDilate::getCommandSwitch()
 {
     return "-metric-dilate";
@@ -126,7 +137,8 @@ void AlgorithmMetricDilate::useParameters(OperationParameters* myParams, Progres
 }
 
 AlgorithmMetricDilate::AlgorithmMetricDilate(ProgressObject* myProgObj, const MetricFile* myMetric, const SurfaceFile* mySurf, const float& distance, MetricFile* myMetricOut,
-                                             const MetricFile* badNodeRoi, const MetricFile* dataRoi, const int& columnNum, const bool& nearest, const bool& linear, const float& exponent) : AbstractAlgorithm(myProgObj)
+                                             const MetricFile* badNodeRoi, const MetricFile* dataRoi, const int& columnNum, const bool& nearest, const bool& linear, const float& exponent,
+                                             PlanCache* planCache) : AbstractAlgorithm(myProgObj, getCommandSwitch())
 {
     LevelProgress myProgress(myProgObj);
     if (nearest && linear) throw AlgorithmException("cannot dilate in nearest and linear modes together");
@@ -152,106 +164,113 @@ AlgorithmMetricDilate::AlgorithmMetricDilate(ProgressObject* myProgObj, const Me
         throw AlgorithmException("invalid distance specified");
     }
     myMetricOut->setStructure(mySurf->getStructure());
-    vector<pair<int, StencilElem> > myStencils;//because we need to iterate over it in parallel
-    vector<pair<int, int> > myNearest;
-    vector<float> colScratch(numNodes);
-    vector<float> myAreas;
-    mySurf->computeNodeAreas(myAreas);
-    if (!linear && badNodeRoi != NULL)
+    PlanCache localCache;
+    PlanCache& myCache = (planCache != NULL ? *planCache : localCache);
+    if (myCache.m_surface != mySurf || myCache.m_distance != distance || myCache.m_nearest != nearest || myCache.m_exponent != exponent)
+    {//a plan only applies to the surface and settings it was built with
+        myCache.m_surface = mySurf;
+        myCache.m_distance = distance;
+        myCache.m_nearest = nearest;
+        myCache.m_exponent = exponent;
+        myCache.m_planValid = false;
+        mySurf->computeNodeAreas(myCache.m_areas);
+    }
+    const vector<float>& myAreas = myCache.m_areas;
+    vector<int> columnList;
+    if (columnNum == -1)
     {
-        if (nearest)
+        for (int thisCol = 0; thisCol < myMetric->getNumberOfColumns(); ++thisCol)
         {
-            precomputeNearest(myNearest, mySurf, badNodeRoi, dataRoi, distance);
-        } else {
-            precomputeStencils(myStencils, mySurf, myAreas.data(), badNodeRoi, dataRoi, distance, exponent);
+            columnList.push_back(thisCol);
         }
+    } else {
+        columnList.push_back(columnNum);
     }
-    if (columnNum == -1)
+    int numOutCols = (int)columnList.size();
+    myMetricOut->setNumberOfNodesAndColumns(numNodes, numOutCols);
+    for (int outCol = 0; outCol < numOutCols; ++outCol)
     {
-        myMetricOut->setNumberOfNodesAndColumns(numNodes, myMetric->getNumberOfColumns());
-        for (int thisCol = 0; thisCol < myMetric->getNumberOfColumns(); ++thisCol)
+        *(myMetricOut->getMapPaletteColorMapping(outCol)) = *(myMetric->getMapPaletteColorMapping(columnList[outCol]));
+        myMetricOut->setColumnName(outCol, myMetric->getColumnName(columnList[outCol]));
+    }
+    if (linear)
+    {//depends on the data values, not just which vertices are bad
+        vector<float> colScratch(numNodes);
+        for (int outCol = 0; outCol < numOutCols; ++outCol)
+        {
+            processColumn(colScratch.data(), myMetric->getValuePointerForColumn(columnList[outCol]), mySurf, myAreas.data(), badNodeRoi, dataRoi, distance, nearest, linear, exponent);
+            myMetricOut->setValuesForColumn(outCol, colScratch.data());
+            myProgress.reportProgress(((float)outCol + 1) / numOutCols);
+        }
+        return;
+    }
+    //the geodesic searches only depend on which vertices are bad and good, so compute them once per distinct mask (once per file with a bad vertex roi, or when all columns have the same zeros)
+    const int batchSize = 16;
+    DilationPlan& myPlan = myCache.m_plan;
+    vector<char>& planStatus = myCache.m_status;
+    vector<char> colStatus;
+    vector<vector<float> > batchScratch(min(batchSize, numOutCols), vector<float>(numNodes));
+    for (int outCol = 0; outCol < numOutCols; )
+    {
+        computeNodeStatus(colStatus, numNodes, myMetric->getValuePointerForColumn(columnList[outCol]), badNodeRoi, dataRoi);
+        if (!myCache.m_planValid || colStatus != planStatus)
         {
-            *(myMetricOut->getMapPaletteColorMapping(thisCol)) = *(myMetric->getMapPaletteColorMapping(thisCol));
-            const float* myInputData = myMetric->getValuePointerForColumn(thisCol);
-            myMetricOut->setColumnName(thisCol, myMetric->getColumnName(thisCol));
-            if (linear || badNodeRoi == NULL)
+            planStatus.swap(colStatus);
+            myCache.m_planValid = false;//in case building it throws
+            if (nearest)
             {
-                processColumn(colScratch.data(), myInputData, mySurf, myAreas.data(), badNodeRoi, dataRoi, distance, nearest, linear, exponent);
+                precomputeNearest(myPlan, mySurf, planStatus, distance);
             } else {
-                if (nearest)
-                {
-                    processColumn(colScratch.data(), numNodes, myInputData, myNearest);
-                } else {
-                    processColumn(colScratch.data(), numNodes, myInputData, myStencils);
-                }
+                precomputeStencils(myPlan, mySurf, myAreas.data(), planStatus, distance, exponent);
             }
-            myMetricOut->setValuesForColumn(thisCol, colScratch.data());
+            myCache.m_planValid = true;
         }
-    } else {
-        myMetricOut->setNumberOfNodesAndColumns(numNodes, 1);
-        *(myMetricOut->getMapPaletteColorMapping(0)) = *(myMetric->getMapPaletteColorMapping(columnNum));
-        const float* myInputData = myMetric->getValuePointerForColumn(columnNum);
-        myMetricOut->setColumnName(0, myMetric->getColumnName(columnNum));
-        if (linear || badNodeRoi == NULL)
+        vector<const float*> batchIn(1, myMetric->getValuePointerForColumn(columnList[outCol]));
+        vector<float*> batchOut(1, batchScratch[0].data());
+        int batchEnd = outCol + 1;
+        while (batchEnd < numOutCols && batchEnd - outCol < batchSize)
         {
-            processColumn(colScratch.data(), myInputData, mySurf, myAreas.data(), badNodeRoi, dataRoi, distance, nearest, linear, exponent);
-        } else {
-            if (nearest)
+            const float* nextData = myMetric->getValuePointerForColumn(columnList[batchEnd]);
+            if (badNodeRoi == NULL)
             {
-                processColumn(colScratch.data(), numNodes, myInputData, myNearest);
-            } else {
-                processColumn(colScratch.data(), numNodes, myInputData, myStencils);
+                computeNodeStatus(colStatus, numNodes, nextData, badNodeRoi, dataRoi);
+                if (colStatus != planStatus) break;
             }
+            batchIn.push_back(nextData);
+            batchOut.push_back(batchScratch[batchEnd - outCol].data());
+            ++batchEnd;
         }
-        myMetricOut->setValuesForColumn(0, colScratch.data());
-    }
-}
-
-void AlgorithmMetricDilate::processColumn(float* colScratch, const int& numNodes, const float* myInputData, vector<pair<int, int> > myNearest)
-{
-    for (int i = 0; i < numNodes; ++i)
-    {
-        colScratch[i] = myInputData[i];//precopy so that the parallel part doesn't have to worry about vertices that don't get dilated to
-    }
-    int numStencils = (int)myNearest.size();
-#pragma omp CARET_PARFOR schedule(dynamic)
-    for (int i = 0; i < numStencils; ++i)//no idea if parallel actually helps here
-    {
-        const int& node = myNearest[i].first;
-        const int& nearest = myNearest[i].second;
-        if (nearest != -1)
+        myPlan.apply(batchIn, batchOut, numNodes);
+        for (int i = outCol; i < batchEnd; ++i)
         {
-            colScratch[node] = myInputData[nearest];
-        } else {
-            colScratch[node] = 0.0f;
+            myMetricOut->setValuesForColumn(i, batchOut[i - outCol]);
         }
+        outCol = batchEnd;
+        myProgress.reportProgress(((float)outCol) / numOutCols);
     }
 }
 
-void AlgorithmMetricDilate::processColumn(float* colScratch, const int& numNodes, const float* myInputData, vector<pair<int, StencilElem> > myStencils)
+void AlgorithmMetricDilate::computeNodeStatus(vector<char>& statusOut, const int& numNodes, const float* myInputData, const MetricFile* badNodeRoi, const MetricFile* dataRoi)
 {
+    const float* badNodeData = NULL, *dataRoiVals = NULL;
+    if (badNodeRoi != NULL) badNodeData = badNodeRoi->getValuePointerForColumn(0);
+    if (dataRoi != NULL) dataRoiVals = dataRoi->getValuePointerForColumn(0);
+    statusOut.resize(numNodes);
     for (int i = 0; i < numNodes; ++i)
     {
-        colScratch[i] = myInputData[i];//precopy so that the parallel part doesn't have to worry about vertices that don't get dilated to
-    }
-    int numStencils = (int)myStencils.size();
-#pragma omp CARET_PARFOR schedule(dynamic)
-    for (int i = 0; i < numStencils; ++i)//does parallel help here?
-    {
-        const int& node = myStencils[i].first;
-        const StencilElem& stencil = myStencils[i].second;
-        int numWeights = (int)stencil.m_weightlist.size();
-        if (numWeights > 0)
+        if (dataRoiVals != NULL && !(dataRoiVals[i] > 0.0f))
         {
-            double accum = 0.0;
-            for (int j = 0; j < numWeights; ++j)
-            {
-                accum += myInputData[stencil.m_weightlist[j].first] * stencil.m_weightlist[j].second;
-            }
-            colScratch[node] = accum / stencil.m_weightsum;
+            statusOut[i] = NODE_IGNORE;
+            continue;
+        }
+        bool badNode;
+        if (badNodeData != NULL)
+        {
+            badNode = (badNodeData[i] > 0.0f);//in case some clown uses NaN as "bad" in the ROI
         } else {
-            colScratch[node] = 0.0f;
+            badNode = (myInputData[i] == 0.0f);
         }
+        statusOut[i] = (badNode ? NODE_BAD : NODE_GOOD);
     }
 }
 
@@ -450,12 +469,9 @@ void AlgorithmMetricDilate::processColumn(float* colScratch, const float* myInpu
     }
 }
 
-void AlgorithmMetricDilate::precomputeStencils(vector<pair<int, StencilElem> >& myStencils, const SurfaceFile* mySurf, const float* myAreas,
-                                               const MetricFile* badNodeRoi, const MetricFile* dataRoi,
+void AlgorithmMetricDilate::precomputeStencils(DilationPlan& myPlan, const SurfaceFile* mySurf, const float* myAreas, const vector<char>& nodeStatus,
                                                const float& distance, const float& exponent)
 {
-    CaretAssert(badNodeRoi != NULL);//because it should never be called if we don't know exactly what nodes we are replacing
-    const float* badNodeData = badNodeRoi->getValuePointerForColumn(0);
     float cutoffRatio = 1.5f, test = pow(10.0f, 1.0f / exponent);//find what cutoff ratio corresponds to a tenth of weight, but don't use more than a 1.5 * nearest cutoff
     if (test > 1.0f && test < cutoffRatio)//if it is less than 1, the exponent is weird, so simply ignore it and use default
     {
@@ -468,191 +484,111 @@ void AlgorithmMetricDilate::precomputeStencils(vector<pair<int, StencilElem> >&
     }
     int numNodes = mySurf->getNumberOfNodes();
     vector<char> charRoi(numNodes);
-    const float* dataRoiVals = NULL;
-    int badCount = 0;
-    if (dataRoi != NULL)
+    vector<int64_t> targets;
+    for (int i = 0; i < numNodes; ++i)
     {
-        dataRoiVals = dataRoi->getValuePointerForColumn(0);
-        for (int i = 0; i < numNodes; ++i)
-        {
-            if (!(badNodeData[i] > 0.0f))//in case some clown uses NaN as "bad" in the ROI
-            {
-                if (dataRoiVals[i] > 0.0f)
-                {
-                    charRoi[i] = 1;
-                } else {
-                    charRoi[i] = 0;
-                }
-            } else {
-                if (dataRoiVals[i] > 0.0f)
-                {
-                    ++badCount;
-                }
-                charRoi[i] = 0;
-            }
-        }
-    } else {
-        for (int i = 0; i < numNodes; ++i)
-        {
-            if (!(badNodeData[i] > 0.0f))
-            {
-                charRoi[i] = 1;
-            } else {
-                ++badCount;
-                charRoi[i] = 0;
-            }
-        }
+        charRoi[i] = (nodeStatus[i] == NODE_GOOD ? 1 : 0);
+        if (nodeStatus[i] == NODE_BAD) targets.push_back(i);
     }
-    myStencils.resize(badCount);//initializes all stencils to have empty lists
-    badCount = 0;
+    int numTargets = (int)targets.size();
+    vector<vector<pair<int64_t, float> > > sources(numTargets);
 #pragma omp CARET_PAR
     {
         CaretPointer<TopologyHelper> myTopoHelp = mySurf->getTopologyHelper();
         CaretPointer<GeodesicHelper> myGeoHelp = mySurf->getGeodesicHelper();
 #pragma omp CARET_FOR schedule(dynamic)
-        for (int i = 0; i < numNodes; ++i)
+        for (int t = 0; t < numTargets; ++t)
         {
-            if (badNodeData[i] > 0.0f && (dataRoiVals == NULL || dataRoiVals[i] > 0.0f))
+            int i = (int)targets[t];
+            float closestDist;
+            int closestNode = myGeoHelp->getClosestNodeInRoi(i, charRoi.data(), distance, closestDist);
+            if (closestNode == -1)//check neighbors, to ensure we dilate by at least one node everywhere
             {
-                int myIndex;
-#pragma omp critical
+                const vector<int32_t>& nodeList = myTopoHelp->getNodeNeighbors(i);
+                vector<float> distList;
+                myGeoHelp->getGeoToTheseNodes(i, nodeList, distList);//ok, its a little silly to do this
+                const int numInRange = (int)nodeList.size();
+                for (int j = 0; j < numInRange; ++j)
                 {
-                    myIndex = badCount;
-                    ++badCount;
-                }
-                myStencils[myIndex].first = i;
-                StencilElem& myElem = myStencils[myIndex].second;
-                float closestDist;
-                int closestNode = myGeoHelp->getClosestNodeInRoi(i, charRoi.data(), distance, closestDist);
-                if (closestNode == -1)//check neighbors, to ensure we dilate by at least one node everywhere
-                {
-                    const vector<int32_t>& nodeList = myTopoHelp->getNodeNeighbors(i);
-                    vector<float> distList;
-                    myGeoHelp->getGeoToTheseNodes(i, nodeList, distList);//ok, its a little silly to do this
-                    const int numInRange = (int)nodeList.size();
-                    for (int j = 0; j < numInRange; ++j)
+                    if (charRoi[nodeList[j]] != 0 && (closestNode == -1 || distList[j] < closestDist))
                     {
-                        if (charRoi[nodeList[j]] != 0 && (closestNode == -1 || distList[j] < closestDist))
-                        {
-                            closestNode = nodeList[j];
-                            closestDist = distList[j];
-                        }
+                        closestNode = nodeList[j];
+                        closestDist = distList[j];
                     }
                 }
-                if (closestNode != -1)
+            }
+            if (closestNode != -1)
+            {
+                vector<int32_t> nodeList;
+                vector<float> distList;
+                myGeoHelp->getNodesToGeoDist(i, closestDist * cutoffRatio, nodeList, distList);
+                int numInRange = (int)nodeList.size();
+                for (int j = 0; j < numInRange; ++j)
                 {
-                    vector<int32_t> nodeList;
-                    vector<float> distList;
-                    myGeoHelp->getNodesToGeoDist(i, closestDist * cutoffRatio, nodeList, distList);
-                    int numInRange = (int)nodeList.size();
-                    myElem.m_weightsum = 0.0f;
-                    for (int j = 0; j < numInRange; ++j)
+                    if (charRoi[nodeList[j]] != 0)
                     {
-                        if (charRoi[nodeList[j]] != 0)
+                        float weight;
+                        const float tolerance = 0.9f;//distances should NEVER be less than closestDist, for obvious reasons
+                        float divdist = distList[j] / closestDist;
+                        if (divdist > tolerance)//tricky: if closestDist is zero, this filters between NaN and inf, resulting in a straight average between nodes with 0 distance
                         {
-                            float weight;
-                            const float tolerance = 0.9f;//distances should NEVER be less than closestDist, for obvious reasons
-                            float divdist = distList[j] / closestDist;
-                            if (divdist > tolerance)//tricky: if closestDist is zero, this filters between NaN and inf, resulting in a straight average between nodes with 0 distance
-                            {
-                                weight = myAreas[nodeList[j]] / pow(divdist, exponent);
-                            } else {
-                                weight = myAreas[nodeList[j]] / pow(tolerance, exponent);
-                            }
-                            myElem.m_weightsum += weight;
-                            myElem.m_weightlist.push_back(pair<int, float>(nodeList[j], weight));
+                            weight = myAreas[nodeList[j]] / pow(divdist, exponent);
+                        } else {
+                            weight = myAreas[nodeList[j]] / pow(tolerance, exponent);
                         }
-                    }
-                    if (myElem.m_weightsum == 0.0f)//set list to empty instead of making NaNs
-                    {
-                        myElem.m_weightlist.clear();
+                        sources[t].push_back(pair<int64_t, float>(nodeList[j], weight));
                     }
                 }
             }
         }
     }
+    myPlan.setTargets(targets, sources);
 }
 
-void AlgorithmMetricDilate::precomputeNearest(vector<pair<int, int> >& myNearest, const SurfaceFile* mySurf, const MetricFile* badNodeRoi, const MetricFile* dataRoi, const float& distance)
+void AlgorithmMetricDilate::precomputeNearest(DilationPlan& myPlan, const SurfaceFile* mySurf, const vector<char>& nodeStatus, const float& distance)
 {
-    CaretAssert(badNodeRoi != NULL);//because it should never be called if we don't know exactly what nodes we are replacing
-    const float* badNodeData = badNodeRoi->getValuePointerForColumn(0);
     int numNodes = mySurf->getNumberOfNodes();
     vector<char> charRoi(numNodes);
-    const float* dataRoiVals = NULL;
-    int badCount = 0;
-    if (dataRoi != NULL)
+    vector<int64_t> targets;
+    for (int i = 0; i < numNodes; ++i)
     {
-        dataRoiVals = dataRoi->getValuePointerForColumn(0);
-        for (int i = 0; i < numNodes; ++i)
-        {
-            if (!(badNodeData[i] > 0.0f))//in case some clown uses NaN as "bad" in the ROI
-            {
-                if (dataRoiVals[i] > 0.0f)
-                {
-                    charRoi[i] = 1;
-                } else {
-                    charRoi[i] = 0;
-                }
-            } else {
-                if (dataRoiVals[i] > 0.0f)
-                {
-                    ++badCount;
-                }
-                charRoi[i] = 0;
-            }
-        }
-    } else {
-        for (int i = 0; i < numNodes; ++i)
-        {
-            if (!(badNodeData[i] > 0.0f))
-            {
-                charRoi[i] = 1;
-            } else {
-                ++badCount;
-                charRoi[i] = 0;
-            }
-        }
+        charRoi[i] = (nodeStatus[i] == NODE_GOOD ? 1 : 0);
+        if (nodeStatus[i] == NODE_BAD) targets.push_back(i);
     }
-    myNearest.resize(badCount);
-    badCount = 0;
+    int numTargets = (int)targets.size();
+    vector<vector<pair<int64_t, float> > > sources(numTargets);
 #pragma omp CARET_PAR
     {
         CaretPointer<TopologyHelper> myTopoHelp = mySurf->getTopologyHelper();
         CaretPointer<GeodesicHelper> myGeoHelp = mySurf->getGeodesicHelper();
 #pragma omp CARET_FOR schedule(dynamic)
-        for (int i = 0; i < numNodes; ++i)
+        for (int t = 0; t < numTargets; ++t)
         {
-            if (badNodeData[i] > 0.0f && (dataRoiVals == NULL || dataRoiVals[i] > 0.0f))
+            int i = (int)targets[t];
+            float closestDist;
+            int closestNode = myGeoHelp->getClosestNodeInRoi(i, charRoi.data(), distance, closestDist);
+            if (closestNode == -1)//check neighbors, to ensure we dilate by at least one node everywhere
             {
-                int myIndex;
-#pragma omp critical
+                const vector<int32_t>& nodeList = myTopoHelp->getNodeNeighbors(i);
+                vector<float> distList;
+                myGeoHelp->getGeoToTheseNodes(i, nodeList, distList);//ok, its a little silly to do this
+                const int numInRange = (int)nodeList.size();
+                for (int j = 0; j < numInRange; ++j)
                 {
-                    myIndex = badCount;
-                    ++badCount;
-                }
-                myNearest[myIndex].first = i;
-                float closestDist;
-                int closestNode = myGeoHelp->getClosestNodeInRoi(i, charRoi.data(), distance, closestDist);
-                if (closestNode == -1)//check neighbors, to ensure we dilate by at least one node everywhere
-                {
-                    const vector<int32_t>& nodeList = myTopoHelp->getNodeNeighbors(i);
-                    vector<float> distList;
-                    myGeoHelp->getGeoToTheseNodes(i, nodeList, distList);//ok, its a little silly to do this
-                    const int numInRange = (int)nodeList.size();
-                    for (int j = 0; j < numInRange; ++j)
+                    if (charRoi[nodeList[j]] != 0 && (closestNode == -1 || distList[j] < closestDist))
                     {
-                        if (charRoi[nodeList[j]] != 0 && (closestNode == -1 || distList[j] < closestDist))
-                        {
-                            closestNode = nodeList[j];
-                            closestDist = distList[j];
-                        }
+                        closestNode = nodeList[j];
+                        closestDist = distList[j];
                     }
                 }
-                myNearest[myIndex].second = closestNode;
+            }
+            if (closestNode != -1)
+            {
+                sources[t].push_back(pair<int64_t, float>(closestNode, 1.0f));
             }
         }
     }
+    myPlan.setTargets(targets, sources);
 }
 
 float AlgorithmMetricDilate::getAlgorithmInternalWeight()
@@ -22,22 +22,34 @@
 /*LICENSE_END*/
 
 #include "AbstractAlgorithm.h"
+#include "DilationPlan.h"
+
+#include <vector>
 
 namespace caret {
     
     class AlgorithmMetricDilate : public AbstractAlgorithm
     {
-        struct StencilElem
+    public:
+        ///keeps the last plan and the vertex mask it was built for, so calls on data with the same mask (such as blocks of a streamed cifti file) don't redo the geodesic searches
+        class PlanCache
         {
-            std::vector<std::pair<int, float> > m_weightlist;
-            float m_weightsum;
+            const SurfaceFile* m_surface;
+            float m_distance, m_exponent;
+            bool m_nearest, m_planValid;
+            std::vector<float> m_areas;
+            std::vector<char> m_status;
+            DilationPlan m_plan;
+            friend class AlgorithmMetricDilate;
+        public:
+            PlanCache() : m_surface(NULL), m_distance(0.0f), m_exponent(0.0f), m_nearest(false), m_planValid(false) { }
         };
+    private:
         AlgorithmMetricDilate();
-        void precomputeStencils(std::vector<std::pair<int, StencilElem> >& myStencils, const SurfaceFile* mySurf, const float* myAreas, const MetricFile* badNodeRoi, const MetricFile* dataRoi,
+        static void computeNodeStatus(std::vector<char>& statusOut, const int& numNodes, const float* myInputData, const MetricFile* badNodeRoi, const MetricFile* dataRoi);
+        void precomputeStencils(DilationPlan& myPlan, const SurfaceFile* mySurf, const float* myAreas, const std::vector<char>& nodeStatus,
                                 const float& distance, const float& exponent);
-        void precomputeNearest(std::vector<std::pair<int, int> >& myNearest, const SurfaceFile* mySurf, const MetricFile* badNodeRoi, const MetricFile* dataRoi, const float& distance);
-        void processColumn(float* colScratch, const int& numNodes, const float* myInputData, std::vector<std::pair<int, int> > myNearest);
-        void processColumn(float* colScratch, const int& numNodes, const float* myInputData, std::vector<std::pair<int, StencilElem> > myStencils);
+        void precomputeNearest(DilationPlan& myPlan, const SurfaceFile* mySurf, const std::vector<char>& nodeStatus, const float& distance);
         void processColumn(float* colScratch, const float* myInputData, const SurfaceFile* mySurf, const float* myAreas, const MetricFile* badNodeRoi, const MetricFile* dataRoi,
                            const float& distance, const bool& nearest, const bool& linear, const float& exponent);
     protected:
@@ -45,7 +57,8 @@ namespace caret {
         static float getAlgorithmInternalWeight();
     public:
         AlgorithmMetricDilate(ProgressObject* myProgObj, const MetricFile* myMetric, const SurfaceFile* mySurf, const float& distance,
-                              MetricFile* myMetricOut, const MetricFile* badNodeRoi = NULL, const MetricFile* dataRoi = NULL, const int& columnNum = -1, const bool& nearest = false, const bool& linear = false, const float& exponent = 2.0f);
+                              MetricFile* myMetricOut, const MetricFile* badNodeRoi = NULL, const MetricFile* dataRoi = NULL, const int& columnNum = -1, const bool& nearest = false, const bool& linear = false, const float& exponent = 2.0f,
+                              PlanCache* planCache = NULL);
         static OperationParameters* getParameters();
         static void useParameters(OperationParameters* myParams, ProgressObject* myProgObj);
         static AString getCommandSwitch();
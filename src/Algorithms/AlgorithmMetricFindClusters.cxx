@@ -22,9 +22,9 @@
 #include "AlgorithmException.h"
 
 #include "CaretLogger.h"
+#include "ConnectedComponentsHelper.h"
 #include "MetricFile.h"
 #include "SurfaceFile.h"
-#include "TopologyHelper.h"
 
 #include <vector>
 
@@ -116,7 +116,7 @@ void AlgorithmMetricFindClusters::useParameters(OperationParameters* myParams, P
 }
 
 AlgorithmMetricFindClusters::AlgorithmMetricFindClusters(ProgressObject* myProgObj, const SurfaceFile* mySurf, const MetricFile* myMetric, const float& threshVal, const float& minArea,
-                                                         MetricFile* myMetricOut, const bool& lessThan, const MetricFile* myRoi, const MetricFile* myAreas, const int& columnNum, const int& startVal, int* endVal) : AbstractAlgorithm(myProgObj)
+                                                         MetricFile* myMetricOut, const bool& lessThan, const MetricFile* myRoi, const MetricFile* myAreas, const int& columnNum, const int& startVal, int* endVal) : AbstractAlgorithm(myProgObj, getCommandSwitch())
 {
     LevelProgress myProgress(myProgObj);
     int numNodes = mySurf->getNumberOfNodes();
@@ -145,149 +145,58 @@ AlgorithmMetricFindClusters::AlgorithmMetricFindClusters(ProgressObject* myProgO
     } else {
         nodeAreas = myAreas->getValuePointerForColumn(0);
     }
-    CaretPointer<TopologyHelper> myHelp = mySurf->getTopologyHelper();
-    vector<int> toSearch;
-    int markVal = startVal;//give each cluster a different value, including across maps
+    ConnectedComponentsHelper myComponents(mySurf);//neighbor lists are built once for all columns
+    vector<int> columnList;
     if (columnNum == -1)
     {
-        myMetricOut->setNumberOfNodesAndColumns(numNodes, numCols);
-        myMetricOut->setStructure(mySurf->getStructure());
         for (int c = 0; c < numCols; ++c)
         {
-            myMetricOut->setColumnName(c, myMetric->getColumnName(c));
-            vector<float> outData(numNodes, 0.0f);
-            const float* data = myMetric->getValuePointerForColumn(c);
-            vector<int> marked(numNodes, 0);
-            if (lessThan)
-            {
-                for (int i = 0; i < numNodes; ++i)
-                {
-                    if ((roiData == NULL || roiData[i] > 0.0f) && data[i] < threshVal)
-                    {
-                        marked[i] = 1;
-                    }
-                }
-            } else {
-                for (int i = 0; i < numNodes; ++i)
-                {
-                    if ((roiData == NULL || roiData[i] > 0.0f) && data[i] > threshVal)
-                    {
-                        marked[i] = 1;
-                    }
-                }
-            }
-            for (int i = 0; i < numNodes; ++i)
-            {
-                if (marked[i])
-                {
-                    float area = 0.0f;
-                    toSearch.push_back(i);
-                    marked[i] = 0;//unmark it when added to list to prevent multiples
-                    for (int index = 0; index < (int)toSearch.size(); ++index)//NOTE: vector grows inside loop
-                    {
-                        int node = toSearch[index];//keep list around so we can put it into the output immediately if it is large enough
-                        area += nodeAreas[node];
-                        const vector<int32_t>& neighbors = myHelp->getNodeNeighbors(node);
-                        int numNeigh = (int)neighbors.size();
-                        for (int n = 0; n < numNeigh; ++n)
-                        {
-                            const int32_t& neighbor = neighbors[n];
-                            if (marked[neighbor])
-                            {
-                                toSearch.push_back(neighbor);
-                                marked[neighbor] = 0;
-                            }
-                        }
-                    }
-                    if (area > minArea)
-                    {
-                        if (markVal == 0)
-                        {
-                            CaretLogInfo("skipping 0 for cluster marking");
-                            ++markVal;
-                        }
-                        float tempVal = markVal;
-                        if ((int)tempVal != markVal) throw AlgorithmException("too many clusters, unable to mark them uniquely");
-                        int clusterCount = (int)toSearch.size();
-                        for (int index = 0; index < clusterCount; ++index)
-                        {
-                            outData[toSearch[index]] = tempVal;
-                        }
-                        ++markVal;
-                    }
-                    toSearch.clear();
-                }
-            }
-            myMetricOut->setValuesForColumn(c, outData.data());
+            columnList.push_back(c);
         }
     } else {
-        myMetricOut->setNumberOfNodesAndColumns(numNodes, 1);
-        myMetricOut->setStructure(mySurf->getStructure());
-        myMetricOut->setColumnName(0, myMetric->getColumnName(columnNum));
-        vector<float> outData(numNodes, 0.0f);
-        const float* data = myMetric->getValuePointerForColumn(columnNum);
-        vector<int> marked(numNodes, 0);
-        if (lessThan)
+        columnList.push_back(columnNum);
+    }
+    int numOutCols = (int)columnList.size();
+    myMetricOut->setNumberOfNodesAndColumns(numNodes, numOutCols);
+    myMetricOut->setStructure(mySurf->getStructure());
+    int markVal = startVal;//give each cluster a different value, including across maps
+    vector<char> marked(numNodes);
+    vector<int64_t> clusterLabels;
+    vector<double> clusterAreas;
+    vector<float> outData(numNodes);
+    for (int outCol = 0; outCol < numOutCols; ++outCol)
+    {
+        int c = columnList[outCol];
+        myMetricOut->setColumnName(outCol, myMetric->getColumnName(c));
+        const float* data = myMetric->getValuePointerForColumn(c);
+        for (int i = 0; i < numNodes; ++i)
         {
-            for (int i = 0; i < numNodes; ++i)
-            {
-                if ((roiData == NULL || roiData[i] > 0.0f) && data[i] < threshVal)
-                {
-                    marked[i] = 1;
-                }
-            }
-        } else {
-            for (int i = 0; i < numNodes; ++i)
-            {
-                if ((roiData == NULL || roiData[i] > 0.0f) && data[i] > threshVal)
-                {
-                    marked[i] = 1;
-                }
-            }
+            marked[i] = ((roiData == NULL || roiData[i] > 0.0f) && (lessThan ? data[i] < threshVal : data[i] > threshVal));
         }
-        for (int i = 0; i < numNodes; ++i)
+        myComponents.findComponents(marked.data(), nodeAreas, clusterLabels, clusterAreas);
+        int numClusters = (int)clusterAreas.size();
+        vector<float> clusterValues(numClusters, 0.0f);//clusters come out in order of their lowest vertex, so numbering is the same as a serial search
+        for (int k = 0; k < numClusters; ++k)
         {
-            if (marked[i])
+            if (clusterAreas[k] > minArea)
             {
-                float area = 0.0f;
-                toSearch.push_back(i);
-                marked[i] = 0;//unmark it when added to list to prevent multiples
-                for (int index = 0; index < (int)toSearch.size(); ++index)//NOTE: vector grows inside loop
-                {
-                    int node = toSearch[index];//keep list around so we can put it into the output immediately if it is large enough
-                    area += nodeAreas[node];
-                    const vector<int32_t>& neighbors = myHelp->getNodeNeighbors(node);
-                    int numNeigh = (int)neighbors.size();
-                    for (int n = 0; n < numNeigh; ++n)
-                    {
-                        const int32_t& neighbor = neighbors[n];
-                        if (marked[neighbor])
-                        {
-                            toSearch.push_back(neighbor);
-                            marked[neighbor] = 0;
-                        }
-                    }
-                }
-                if (area > minArea)
+                if (markVal == 0)
                 {
-                    if (markVal == 0)
-                    {
-                        CaretLogInfo("skipping 0 for cluster marking");
-                        ++markVal;
-                    }
-                    float tempVal = markVal;
-                    if ((int)tempVal != markVal) throw AlgorithmException("too many clusters, unable to mark them uniquely");
-                    int clusterCount = (int)toSearch.size();
-                    for (int index = 0; index < clusterCount; ++index)
-                    {
-                        outData[toSearch[index]] = markVal;
-                    }
+                    CaretLogInfo("skipping 0 for cluster marking");
                     ++markVal;
                 }
-                toSearch.clear();
+                float tempVal = markVal;
+                if ((int)tempVal != markVal) throw AlgorithmException("too many clusters, unable to mark them uniquely");
+                clusterValues[k] = tempVal;
+                ++markVal;
             }
         }
-        myMetricOut->setValuesForColumn(0, outData.data());
+        for (int i = 0; i < numNodes; ++i)
+        {
+            outData[i] = (clusterLabels[i] == -1 ? 0.0f : clusterValues[clusterLabels[i]]);
+        }
+        myMetricOut->setValuesForColumn(outCol, outData.data());
+        myProgress.reportProgress(((float)outCol + 1) / numOutCols);
     }
     if (endVal != NULL) *endVal = markVal;
 }
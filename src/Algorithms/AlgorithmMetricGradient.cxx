@@ -150,7 +150,7 @@ AlgorithmMetricGradient::AlgorithmMetricGradient(ProgressObject* myProgObj,
                                                  const bool myAvgNormals,
                                                  const int32_t myColumn,
                                                  const MetricFile* corrAreaMetric,
-                                                 const bool matchRoiColumns) : AbstractAlgorithm(myProgObj)
+                                                 const bool matchRoiColumns) : AbstractAlgorithm(myProgObj, getCommandSwitch())
 {
     ProgressObject* smoothProgress = NULL;
     if (myProgObj != NULL && myPresmooth > 0.0f)
@@ -614,6 +614,173 @@ AlgorithmMetricGradient::AlgorithmMetricGradient(ProgressObject* myProgObj,
     }
 }
 
+//the gradient vector at a vertex is a linear function of the differences between its in-roi neighbors and itself, so for many columns on the same surface,
+//the weights can be computed once and applied to each column (or to a factor of the columns), this uses the same regression and fallback as the main algorithm
+//(without averaged normals), but gets the solution for all neighbors at once, so results match within rounding
+//weightsOut[i] has 3 floats (x, y, z) per entry in neighborsOut[i], gradient of vertex i is sum over k of weights[3k..3k+2] * (value[neighbors[k]] - value[i])
+void AlgorithmMetricGradient::computeLinearWeights(SurfaceFile* mySurf, const float* roiData, const MetricFile* corrAreaMetric,
+                                                   vector<vector<int32_t> >& neighborsOut, vector<vector<float> >& weightsOut)
+{
+    int32_t numNodes = mySurf->getNumberOfNodes();
+    if (corrAreaMetric != NULL && corrAreaMetric->getNumberOfNodes() != numNodes)
+    {
+        throw AlgorithmException("corrected areas metric does not match surface in number of vertices");
+    }
+    neighborsOut.clear();
+    neighborsOut.resize(numNodes);
+    weightsOut.clear();
+    weightsOut.resize(numNodes);
+    mySurf->computeNormals();
+    const float* myNormals = mySurf->getNormalData();
+    vector<float> sqrtCorrAreas;//same logic as GeodesicHelper
+    vector<float> sqrtVertAreas;
+    const float* vertAreas = NULL;
+    vector<float> areaData;
+    if (corrAreaMetric != NULL)
+    {
+        sqrtCorrAreas.resize(numNodes);
+        mySurf->computeNodeAreas(sqrtVertAreas);
+        const float* corrAreaData = corrAreaMetric->getValuePointerForColumn(0);
+        for (int i = 0; i < numNodes; ++i)
+        {
+            sqrtCorrAreas[i] = sqrt(corrAreaData[i]);
+            sqrtVertAreas[i] = sqrt(sqrtVertAreas[i]);
+        }
+        vertAreas = corrAreaData;
+    } else {
+        mySurf->computeNodeAreas(areaData);
+        vertAreas = areaData.data();
+    }
+    const float* myCoords = mySurf->getCoordinateData();
+#pragma omp CARET_PAR
+    {
+        Vector3D somevec, xhat, yhat;
+        vector<float> xmags, ymags, scales;
+        CaretPointer<TopologyHelper> myTopoHelp = mySurf->getTopologyHelper();
+#pragma omp CARET_FOR schedule(dynamic)
+        for (int32_t i = 0; i < numNodes; ++i)
+        {
+            if (roiData != NULL && roiData[i] <= 0.0f) continue;
+            int32_t numNeigh;
+            int32_t i3 = i * 3;
+            const int32_t* myNeighbors = myTopoHelp->getNodeNeighbors(i, numNeigh);
+            Vector3D myNormal = Vector3D(myNormals + i3).normal();
+            Vector3D myCoord = myCoords + i3;
+            somevec[2] = 0.0;
+            if (myNormal[0] > myNormal[1])
+            {//generate a vector not parallel to normal
+                somevec[0] = 0.0;
+                somevec[1] = 1.0;
+            } else {
+                somevec[0] = 1.0;
+                somevec[1] = 0.0;
+            }
+            xhat = myNormal.cross(somevec).normal();
+            yhat = myNormal.cross(xhat).normal();
+            vector<int32_t>& neighRef = neighborsOut[i];
+            xmags.clear();
+            ymags.clear();
+            scales.clear();
+            for (int32_t j = 0; j < numNeigh; ++j)
+            {
+                int32_t whichNode = myNeighbors[j];
+                if (roiData == NULL || roiData[whichNode] > 0.0f)
+                {
+                    Vector3D neighCoord = myCoords + whichNode * 3;
+                    somevec = neighCoord - myCoord;
+                    float origMag = somevec.length();
+                    float unrollMag = origMag;
+                    float opposite = somevec.dot(myNormal);
+                    if (abs(opposite) > 0.035f * origMag)
+                    {
+                        unrollMag = origMag * asin(opposite / origMag) * origMag / opposite;
+                    }
+                    if (corrAreaMetric != NULL)
+                    {
+                        unrollMag *= (sqrtCorrAreas[i] + sqrtCorrAreas[whichNode]) / (sqrtVertAreas[i] + sqrtVertAreas[whichNode]);
+                    }
+                    float xmag = xhat.dot(somevec);
+                    float ymag = yhat.dot(somevec);
+                    float mag2d = sqrt(xmag * xmag + ymag * ymag);
+                    neighRef.push_back(whichNode);
+                    xmags.push_back(xmag / mag2d);//normalized 2d direction, scaled by unrolled length or inverse unrolled length below
+                    ymags.push_back(ymag / mag2d);
+                    scales.push_back(unrollMag);
+                }
+            }
+            int neighCount = (int)neighRef.size();
+            vector<float>& weightRef = weightsOut[i];
+            weightRef.resize(neighCount * 3, 0.0f);
+            bool good = false;
+            if (neighCount >= 2)
+            {//augmented regression: one right hand side column per neighbor
+                FloatMatrix myRegress = FloatMatrix::zeros(3, 3 + neighCount);
+                for (int j = 0; j < neighCount; ++j)
+                {
+                    float xmag = xmags[j] * scales[j], ymag = ymags[j] * scales[j];
+                    float area = vertAreas[neighRef[j]];
+                    myRegress[0][0] += xmag * xmag * area;
+                    myRegress[0][1] += xmag * ymag * area;
+                    myRegress[0][2] += xmag * area;
+                    myRegress[1][1] += ymag * ymag * area;
+                    myRegress[1][2] += ymag * area;
+                    myRegress[2][2] += area;
+                    myRegress[0][3 + j] = xmag * area;
+                    myRegress[1][3 + j] = ymag * area;
+                    myRegress[2][3 + j] = area;
+                }
+                myRegress[1][0] = myRegress[0][1];
+                myRegress[2][0] = myRegress[0][2];
+                myRegress[2][1] = myRegress[1][2];
+                myRegress[2][2] += vertAreas[i];
+                FloatMatrix myRref = myRegress.reducedRowEchelon();
+                good = true;
+                for (int j = 0; j < neighCount; ++j)
+                {
+                    somevec = xhat * myRref[0][3 + j] + yhat * myRref[1][3 + j];
+                    float sanity = somevec[0] + somevec[1] + somevec[2];
+                    if (sanity != sanity)
+                    {
+                        good = false;
+                        break;
+                    }
+                    weightRef[j * 3] = somevec[0];
+                    weightRef[j * 3 + 1] = somevec[1];
+                    weightRef[j * 3 + 2] = somevec[2];
+                }
+            }
+            if (neighCount > 0 && !good)
+            {//fallback: weighted average of point estimates
+                float totalWeight = 0.0f;
+                for (int j = 0; j < neighCount; ++j)
+                {
+                    totalWeight += vertAreas[neighRef[j]];
+                }
+                good = true;
+                for (int j = 0; j < neighCount; ++j)
+                {
+                    float tempf = vertAreas[neighRef[j]] / (scales[j] * totalWeight);
+                    somevec = xhat * (xmags[j] * tempf) + yhat * (ymags[j] * tempf);
+                    float sanity = somevec[0] + somevec[1] + somevec[2];
+                    if (sanity != sanity)
+                    {
+                        good = false;
+                        break;
+                    }
+                    weightRef[j * 3] = somevec[0];
+                    weightRef[j * 3 + 1] = somevec[1];
+                    weightRef[j * 3 + 2] = somevec[2];
+                }
+            }
+            if (!good)
+            {//outputs zero, like the main algorithm
+                neighRef.clear();
+                weightRef.clear();
+            }
+        }
+    }
+}
+
 float AlgorithmMetricGradient::getAlgorithmInternalWeight()
 {
     return 1.0f;//override this if needed, if the progress bar isn't smooth
@@ -23,6 +23,8 @@
 
 #include "AbstractAlgorithm.h"
 
+#include <vector>
+
 namespace caret {
     
     class AlgorithmMetricGradient : public AbstractAlgorithm
@@ -43,6 +45,8 @@ namespace caret {
                                 const int32_t myColumn = -1,
                                 const MetricFile* corrAreaMetric = NULL,
                                 bool matchRoiColumns = false);
+        static void computeLinearWeights(SurfaceFile* mySurf, const float* roiData, const MetricFile* corrAreaMetric,
+                                         std::vector<std::vector<int32_t> >& neighborsOut, std::vector<std::vector<float> >& weightsOut);
         static OperationParameters* getParameters();
         static void useParameters(OperationParameters* myParams, ProgressObject* myProgObj);
         static AString getCommandSwitch();
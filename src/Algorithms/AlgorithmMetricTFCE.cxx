@@ -130,7 +130,7 @@ void AlgorithmMetricTFCE::useParameters(OperationParameters* myParams, ProgressO
 }
 
 AlgorithmMetricTFCE::AlgorithmMetricTFCE(ProgressObject* myProgObj, const SurfaceFile* mySurf, const MetricFile* myMetric, MetricFile* myMetricOut, const float& presmooth,
-                                         const MetricFile* myRoi, const float& param_e, const float& param_h, const int& columnNum, const MetricFile* corrAreaMetric) : AbstractAlgorithm(myProgObj)
+                                         const MetricFile* myRoi, const float& param_e, const float& param_h, const int& columnNum, const MetricFile* corrAreaMetric) : AbstractAlgorithm(myProgObj, getCommandSwitch())
 {
     LevelProgress myProgress(myProgObj);
     if (mySurf->getNumberOfNodes() != myMetric->getNumberOfNodes()) throw AlgorithmException("metric and surface have different number of vertices");
@@ -162,10 +162,11 @@ AlgorithmMetricTFCE::AlgorithmMetricTFCE(ProgressObject* myProgObj, const Surfac
 #pragma omp CARET_PAR
         {
             vector<float> outcol(mySurf->getNumberOfNodes(), 0.0f);
+            CaretPointer<TopologyHelper> myHelper = mySurf->getTopologyHelper();//one per thread, rather than one per column
 #pragma omp CARET_FOR
             for (int col = 0; col < numCols; ++col)
             {
-                processColumn(mySurf, toUse->getValuePointerForColumn(col), outcol.data(), roiData, param_e, param_h, areaData);
+                processColumn(myHelper, toUse->getValuePointerForColumn(col), outcol.data(), roiData, param_e, param_h, areaData);
                 myMetricOut->setValuesForColumn(col, outcol.data());
                 myMetricOut->setMapName(col, myMetric->getMapName(col));
             }
@@ -183,17 +184,16 @@ AlgorithmMetricTFCE::AlgorithmMetricTFCE(ProgressObject* myProgObj, const Surfac
         myMetricOut->setNumberOfNodesAndColumns(mySurf->getNumberOfNodes(), 1);
         myMetricOut->setStructure(mySurf->getStructure());
         vector<float> outcol(mySurf->getNumberOfNodes(), 0.0f);
-        processColumn(mySurf, toUse->getValuePointerForColumn(useCol), outcol.data(), roiData, param_e, param_h, areaData);
+        processColumn(mySurf->getTopologyHelper(), toUse->getValuePointerForColumn(useCol), outcol.data(), roiData, param_e, param_h, areaData);
         myMetricOut->setValuesForColumn(0, outcol.data());
         myMetricOut->setMapName(0, myMetric->getMapName(columnNum));
     }
 }
 
-void AlgorithmMetricTFCE::processColumn(const SurfaceFile* mySurf, const float* colData, float* outData, const float* roiData, const float& param_e, const float& param_h, const float* areaData)
+void AlgorithmMetricTFCE::processColumn(const TopologyHelper* myHelper, const float* colData, float* outData, const float* roiData, const float& param_e, const float& param_h, const float* areaData)
 {
-    int numNodes = mySurf->getNumberOfNodes();
+    int numNodes = myHelper->getNumberOfNodes();
     vector<double> accum(numNodes, 0.0);
-    CaretPointer<TopologyHelper> myHelper = mySurf->getTopologyHelper();
     tfce_pos(myHelper, colData, accum.data(), roiData, param_e, param_h, areaData);
     vector<float> negData(numNodes);
     for (int i = 0; i < numNodes; ++i)
@@ -274,7 +274,7 @@ namespace _algorithm_metric_tfce
 
 using namespace _algorithm_metric_tfce;
 
-void AlgorithmMetricTFCE::tfce_pos(TopologyHelper* myHelper, const float* colData, double* accumData, const float* roiData, const float& param_e, const float& param_h, const float* areaData)
+void AlgorithmMetricTFCE::tfce_pos(const TopologyHelper* myHelper, const float* colData, double* accumData, const float* roiData, const float& param_e, const float& param_h, const float* areaData)
 {
     int numNodes = myHelper->getNumberOfNodes();
     vector<int> membership(numNodes, -1);//int is enough as long as numNodes is fine as an int, for obvious reasons
@@ -0,0 +1,214 @@
+/*LICENSE_START*/
+/*
+ *  Copyright (C) 2014  Washington University School of Medicine
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+/*LICENSE_END*/
+
+#include "AlgorithmMetricTFCEPermutation.h"
+#include "AlgorithmException.h"
+
+#include "AlgorithmMetricTFCE.h"
+#include "CaretOMP.h"
+#include "CaretPointer.h"
+#include "MetricFile.h"
+#include "PermutationTestHelper.h"
+#include "SurfaceFile.h"
+#include "TopologyHelper.h"
+
+#include <vector>
+
+using namespace caret;
+using namespace std;
+
+AString AlgorithmMetricTFCEPermutation::getCommandSwitch()
+{
+    return "-metric-tfce-permutation";
+}
+
+AString AlgorithmMetricTFCEPermutation::getShortDescription()
+{
+    return "TFCE PERMUTATION TEST ON A METRIC FILE";
+}
+
+OperationParameters* AlgorithmMetricTFCEPermutation::getParameters()
+{
+    OperationParameters* ret = new OperationParameters();
+    
+    ret->addSurfaceParameter(1, "surface", "the surface to compute on");
+    
+    ret->addMetricParameter(2, "metric-in", "the metric with one column per subject");
+    
+    ret->addMetricOutputParameter(3, "p-value-out", "output - the family-wise error corrected p-values");
+    
+    OptionalParameter* roiOpt = ret->createOptionalParameter(4, "-roi", "select a region of interest to run TFCE on");
+    roiOpt->addMetricParameter(1, "roi-metric", "the area to run TFCE on, as a metric");
+
+    OptionalParameter* paramsOpt = ret->createOptionalParameter(5, "-parameters", "set parameters for TFCE integral");
+    paramsOpt->addDoubleParameter(1, "E", "exponent for cluster area (default 1.0)");
+    paramsOpt->addDoubleParameter(2, "H", "exponent for threshold value (default 2.0)");
+    
+    OptionalParameter* corrAreaOpt = ret->createOptionalParameter(6, "-corrected-areas", "vertex areas to use instead of computing them from the surface");
+    corrAreaOpt->addMetricParameter(1, "area-metric", "the corrected vertex areas, as a metric");
+    
+    OptionalParameter* twoSampleOpt = ret->createOptionalParameter(7, "-two-sample", "compare two groups instead of testing the mean against zero");
+    twoSampleOpt->addIntegerParameter(1, "first-group-size", "the number of columns in the first group, the remaining columns are the second group");
+    
+    OptionalParameter* numPermOpt = ret->createOptionalParameter(8, "-permutations", "set the number of permutations");
+    numPermOpt->addIntegerParameter(1, "number", "the number of permutations (default 5000)");
+    
+    OptionalParameter* seedOpt = ret->createOptionalParameter(9, "-seed", "set the seed for generating permutations");
+    seedOpt->addIntegerParameter(1, "seed", "the seed (default 0)");
+    
+    OptionalParameter* tfceOutOpt = ret->createOptionalParameter(10, "-tfce-out", "output the TFCE-enhanced t-statistic of the unpermuted data");
+    tfceOutOpt->addMetricOutputParameter(1, "tfce-out", "the enhanced statistic");
+    
+    ret->setHelpText(
+        AString("Runs a nonparametric permutation test using the TFCE-enhanced t-statistic.  ") +
+        "By default, each column is a subject, and the mean is tested against zero by randomly flipping the sign of each subject's data.  " +
+        "With -two-sample, the first columns are compared against the remaining columns by randomly permuting group membership.\n\n" +
+        "The surface topology and vertex areas are computed once and shared by all permutations, and only the maximum absolute value of each permuted map is kept.  " +
+        "The output p-values are two-sided and corrected for multiple comparisons across vertices by the max statistic method, " +
+        "where the unpermuted data counts as one of the permutations, so the smallest possible p-value is 1 / (permutations + 1).  " +
+        "Permutations are generated from the seed, so results are reproducible regardless of the number of threads.\n\n" +
+        "See -metric-tfce for a description of TFCE and its parameters."
+    );
+    return ret;
+}
+
+void AlgorithmMetricTFCEPermutation::useParameters(OperationParameters* myParams, ProgressObject* myProgObj)
+{
+    SurfaceFile* mySurf = myParams->getSurface(1);
+    MetricFile* myMetric = myParams->getMetric(2);
+    MetricFile* myPValueOut = myParams->getOutputMetric(3);
+    MetricFile* myRoi = NULL;
+    OptionalParameter* roiOpt = myParams->getOptionalParameter(4);
+    if (roiOpt->m_present)
+    {
+        myRoi = roiOpt->getMetric(1);
+    }
+    float param_e = 1.0f, param_h = 2.0;
+    OptionalParameter* paramsOpt = myParams->getOptionalParameter(5);
+    if (paramsOpt->m_present)
+    {
+        param_e = (float)paramsOpt->getDouble(1);
+        param_h = (float)paramsOpt->getDouble(2);
+    }
+    MetricFile* corrAreaMetric = NULL;
+    OptionalParameter* corrAreaOpt = myParams->getOptionalParameter(6);
+    if (corrAreaOpt->m_present)
+    {
+        corrAreaMetric = corrAreaOpt->getMetric(1);
+    }
+    int numFirstGroup = -1;
+    OptionalParameter* twoSampleOpt = myParams->getOptionalParameter(7);
+    if (twoSampleOpt->m_present)
+    {
+        numFirstGroup = (int)twoSampleOpt->getInteger(1);
+        if (numFirstGroup < 1) throw AlgorithmException("first group size must be positive");
+    }
+    int numPermutations = 5000;
+    OptionalParameter* numPermOpt = myParams->getOptionalParameter(8);
+    if (numPermOpt->m_present)
+    {
+        numPermutations = (int)numPermOpt->getInteger(1);
+        if (numPermutations < 1) throw AlgorithmException("number of permutations must be positive");
+    }
+    int64_t seed = 0;
+    OptionalParameter* seedOpt = myParams->getOptionalParameter(9);
+    if (seedOpt->m_present)
+    {
+        seed = seedOpt->getInteger(1);
+    }
+    MetricFile* myTFCEOut = NULL;
+    OptionalParameter* tfceOutOpt = myParams->getOptionalParameter(10);
+    if (tfceOutOpt->m_present)
+    {
+        myTFCEOut = tfceOutOpt->getOutputMetric(1);
+    }
+    AlgorithmMetricTFCEPermutation(myProgObj, mySurf, myMetric, myPValueOut, numPermutations, numFirstGroup, myRoi, param_e, param_h, corrAreaMetric, myTFCEOut, seed);
+}
+
+AlgorithmMetricTFCEPermutation::AlgorithmMetricTFCEPermutation(ProgressObject* myProgObj, const SurfaceFile* mySurf, const MetricFile* myMetric, MetricFile* myPValueOut, const int& numPermutations,
+                                                               const int& numFirstGroup, const MetricFile* myRoi, const float& param_e, const float& param_h,
+                                                               const MetricFile* corrAreaMetric, MetricFile* myTFCEOut, const int64_t& seed) : AbstractAlgorithm(myProgObj, getCommandSwitch())
+{
+    LevelProgress myProgress(myProgObj);
+    const int numNodes = mySurf->getNumberOfNodes();
+    if (numNodes != myMetric->getNumberOfNodes()) throw AlgorithmException("metric and surface have different number of vertices");
+    if (myRoi != NULL && numNodes != myRoi->getNumberOfNodes()) throw AlgorithmException("roi metric and surface have different number of vertices");
+    if (corrAreaMetric != NULL && numNodes != corrAreaMetric->getNumberOfNodes()) throw AlgorithmException("corrected area metric and surface have different number of vertices");
+    const int numSubjects = myMetric->getNumberOfColumns();
+    PermutationTestHelper myPermHelper(numSubjects, numFirstGroup, numPermutations, (uint64_t)seed);
+    const float* roiData = NULL, *areaData = NULL;
+    vector<float> surfAreaData;
+    if (corrAreaMetric == NULL)
+    {
+        mySurf->computeNodeAreas(surfAreaData);
+        areaData = surfAreaData.data();
+    } else {
+        areaData = corrAreaMetric->getValuePointerForColumn(0);
+    }
+    if (myRoi != NULL) roiData = myRoi->getValuePointerForColumn(0);
+    vector<const float*> subjectData(numSubjects);
+    for (int s = 0; s < numSubjects; ++s)
+    {
+        subjectData[s] = myMetric->getValuePointerForColumn(s);
+    }
+    vector<float> observedTFCE(numNodes);
+    {
+        vector<float> observedStat(numNodes);
+        myPermHelper.computeStatistic(-1, subjectData, numNodes, observedStat.data());
+        AlgorithmMetricTFCE::processColumn(mySurf->getTopologyHelper(), observedStat.data(), observedTFCE.data(), roiData, param_e, param_h, areaData);
+    }
+    vector<float> maxDistribution(numPermutations);
+#pragma omp CARET_PAR
+    {
+        CaretPointer<TopologyHelper> myHelper = mySurf->getTopologyHelper();//neighbor lists are shared, each thread just needs its own helper
+        vector<float> permStat(numNodes), permTFCE(numNodes);
+#pragma omp CARET_FOR schedule(dynamic)
+        for (int perm = 0; perm < numPermutations; ++perm)
+        {
+            myPermHelper.computeStatistic(perm, subjectData, numNodes, permStat.data());
+            AlgorithmMetricTFCE::processColumn(myHelper, permStat.data(), permTFCE.data(), roiData, param_e, param_h, areaData);
+            maxDistribution[perm] = PermutationTestHelper::maxAbsolute(permTFCE.data(), numNodes);
+        }
+    }
+    vector<float> pValues(numNodes);
+    PermutationTestHelper::computeCorrectedPValues(maxDistribution, observedTFCE.data(), numNodes, pValues.data());
+    myPValueOut->setNumberOfNodesAndColumns(numNodes, 1);
+    myPValueOut->setStructure(mySurf->getStructure());
+    myPValueOut->setValuesForColumn(0, pValues.data());
+    myPValueOut->setMapName(0, "TFCE FWE p-value");
+    if (myTFCEOut != NULL)
+    {
+        myTFCEOut->setNumberOfNodesAndColumns(numNodes, 1);
+        myTFCEOut->setStructure(mySurf->getStructure());
+        myTFCEOut->setValuesForColumn(0, observedTFCE.data());
+        myTFCEOut->setMapName(0, "TFCE t-statistic");
+    }
+}
+
+float AlgorithmMetricTFCEPermutation::getAlgorithmInternalWeight()
+{
+    return 1.0f;//override this if needed, if the progress bar isn't smooth
+}
+
+float AlgorithmMetricTFCEPermutation::getSubAlgorithmWeight()
+{
+    //return AlgorithmInsertNameHere::getAlgorithmWeight();//if you use a subalgorithm
+    return 0.0f;
+}
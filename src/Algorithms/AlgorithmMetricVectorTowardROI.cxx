@@ -83,7 +83,7 @@ void AlgorithmMetricVectorTowardROI::useParameters(OperationParameters* myParams
 }
 
 AlgorithmMetricVectorTowardROI::AlgorithmMetricVectorTowardROI(ProgressObject* myProgObj, SurfaceFile* mySurf, const MetricFile* myMetric, const MetricFile* targetRoi,
-                                                               MetricFile* myMetricOut, const bool& normalize, const MetricFile* computeRoi) : AbstractAlgorithm(myProgObj)
+                                                               MetricFile* myMetricOut, const bool& normalize, const MetricFile* computeRoi) : AbstractAlgorithm(myProgObj, getCommandSwitch())
 {
     LevelProgress myProgress(myProgObj);
     int numNodes = mySurf->getNumberOfNodes();
@@ -24,6 +24,7 @@
 
 #include "AlgorithmSurfaceGenerateInflated.h"
 #include "AlgorithmSurfaceInflation.h"
+#include "SurfaceRelaxationHelper.h"
 #include "AlgorithmException.h"
 #include "SurfaceFile.h"
 
@@ -136,7 +137,7 @@ AlgorithmSurfaceGenerateInflated::AlgorithmSurfaceGenerateInflated(ProgressObjec
                                                                    SurfaceFile* inflatedSurfaceFileOut,
                                                                    SurfaceFile* veryInflatedSurfaceFileOut,
                                                                    const float iterationsScaleIn)
-   : AbstractAlgorithm(myProgObj)
+   : AbstractAlgorithm(myProgObj, getCommandSwitch())
 {
     ProgressObject* lowProgress = NULL, *inflatedProgress = NULL, *veryInfProgress = NULL;
     if (myProgObj != NULL) {
@@ -159,7 +160,8 @@ AlgorithmSurfaceGenerateInflated::AlgorithmSurfaceGenerateInflated(ProgressObjec
      * Generate low-smooth surface which is an intermediate surface
      * between anatomical and inflated.
      */
-    SurfaceFile lowSmoothSurface(*anatomicalSurfaceFile);
+    SurfaceRelaxationHelper relaxHelper(anatomicalSurfaceFile);//all stages run on these coordinates, copied into the outputs as needed
+    std::vector<float> coords(relaxHelper.getNumberOfNodes() * 3);
     const int32_t lowSmoothCycles = 1;
     const float lowSmoothStrength = 0.2;
     const int32_t lowSmoothIterations = static_cast<int32_t>(50 * iterationsScale);
@@ -167,8 +169,7 @@ AlgorithmSurfaceGenerateInflated::AlgorithmSurfaceGenerateInflated(ProgressObjec
     myProgress.setTask("Generating Low-smooth Surface");
     AlgorithmSurfaceInflation(lowProgress,
                               anatomicalSurfaceFile,
-                              &lowSmoothSurface,
-                              &lowSmoothSurface,
+                              relaxHelper,
                               lowSmoothCycles,
                               lowSmoothStrength,
                               lowSmoothIterations,
@@ -178,7 +179,6 @@ AlgorithmSurfaceGenerateInflated::AlgorithmSurfaceGenerateInflated(ProgressObjec
     /*
      * Generation the inflated surface
      */
-    *inflatedSurfaceFileOut = lowSmoothSurface;
     const int32_t inflatedSmoothCycles = 2;
     const float inflatedSmoothStrength = 1.0;
     const int32_t inflatedSmoothIterations = static_cast<int32_t>(30 * iterationsScale);
@@ -186,18 +186,22 @@ AlgorithmSurfaceGenerateInflated::AlgorithmSurfaceGenerateInflated(ProgressObjec
     myProgress.setTask("Generating Inflated Surface");
     AlgorithmSurfaceInflation(inflatedProgress,
                               anatomicalSurfaceFile,
-                              inflatedSurfaceFileOut,
-                              inflatedSurfaceFileOut,
+                              relaxHelper,
                               inflatedSmoothCycles,
                               inflatedSmoothStrength,
                               inflatedSmoothIterations,
                               inflatedSmoothInflationFactor);
+    *inflatedSurfaceFileOut = *anatomicalSurfaceFile;
+    if (!coords.empty()) {
+        relaxHelper.getCoordinates(&coords[0]);
+        inflatedSurfaceFileOut->setCoordinates(&coords[0]);
+    }
+    inflatedSurfaceFileOut->computeNormals();
     inflatedSurfaceFileOut->setSurfaceType(SurfaceTypeEnum::INFLATED);
     
     /*
      * Generation the inflated surface
      */
-    *veryInflatedSurfaceFileOut = *inflatedSurfaceFileOut;
     const int32_t veryInflatedSmoothCycles = 4;
     const float veryInflatedSmoothStrength = 1.0;
     const int32_t veryInflatedSmoothIterations = static_cast<int32_t>(30 * iterationsScale);
@@ -205,12 +209,17 @@ AlgorithmSurfaceGenerateInflated::AlgorithmSurfaceGenerateInflated(ProgressObjec
     myProgress.setTask("Generating Very Inflated Surface");
     AlgorithmSurfaceInflation(veryInfProgress,
                               anatomicalSurfaceFile,
-                              veryInflatedSurfaceFileOut,
-                              veryInflatedSurfaceFileOut,
+                              relaxHelper,
                               veryInflatedSmoothCycles,
                               veryInflatedSmoothStrength,
                               veryInflatedSmoothIterations,
                               veryInflatedSmoothInflationFactor);
+    *veryInflatedSurfaceFileOut = *anatomicalSurfaceFile;
+    if (!coords.empty()) {
+        relaxHelper.getCoordinates(&coords[0]);
+        veryInflatedSurfaceFileOut->setCoordinates(&coords[0]);
+    }
+    veryInflatedSurfaceFileOut->computeNormals();
     veryInflatedSurfaceFileOut->setSurfaceType(SurfaceTypeEnum::VERY_INFLATED);
     
     myProgress.setTask("Matching Bounding Boxes");
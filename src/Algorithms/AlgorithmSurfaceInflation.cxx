@@ -22,12 +22,12 @@
 #include <cmath>
 
 #include "AlgorithmSurfaceInflation.h"
-#include "AlgorithmSurfaceSmoothing.h"
 #include "AlgorithmException.h"
 #include "BoundingBox.h"
 #include "CaretAssert.h"
 #include "CaretLogger.h"
 #include "SurfaceFile.h"
+#include "SurfaceRelaxationHelper.h"
 
 using namespace caret;
 
@@ -136,78 +136,117 @@ AlgorithmSurfaceInflation::AlgorithmSurfaceInflation(ProgressObject* myProgObj,
                                                      const float strength,
                                                      const int32_t iterations,
                                                      const float inflationFactorIn)
-   : AbstractAlgorithm(myProgObj)
+   : AbstractAlgorithm(myProgObj, getCommandSwitch())
 {
-    std::vector<ProgressObject*> subAlgProgress;
-    if (myProgObj != NULL) {
-        subAlgProgress.resize(cycles);
-        for (int32_t i = 0; i < cycles; ++i)
-        {
-            subAlgProgress[i] = myProgObj->addAlgorithm(AlgorithmSurfaceSmoothing::getAlgorithmWeight());
-        }
-    }
-    
     /*
      * Sets the algorithm up to use the progress object, and will
      * finish the progress object automatically when the algorithm terminates
      */
-    LevelProgress myProgress(myProgObj, 1.0f, 0.1f);//lower the internal weight
-    
-    const float inflationFactor = inflationFactorIn - 1.0;
+    LevelProgress myProgress(myProgObj);
     
     *outputSurfaceFile = *inputSurfaceFile;
-    outputSurfaceFile->translateToCenterOfMass();
-    
-    const BoundingBox* anatomicalBoundingBox = anatomicalSurfaceFile->getBoundingBox();
-    const float anatomicalRangeX = anatomicalBoundingBox->getDifferenceX();
-    const float anatomicalRangeY = anatomicalBoundingBox->getDifferenceY();
-    const float anatomicalRangeZ = anatomicalBoundingBox->getDifferenceZ();
     
     const int32_t numberOfNodes = outputSurfaceFile->getNumberOfNodes();
+    if (numberOfNodes <= 0) {
+        return;
+    }
+    
+    SurfaceRelaxationHelper relaxHelper(outputSurfaceFile);
+    inflateCoordinates(myProgress,
+                       anatomicalSurfaceFile,
+                       relaxHelper,
+                       cycles,
+                       strength,
+                       iterations,
+                       inflationFactorIn);
     
+    std::vector<float> coords(numberOfNodes * 3);
+    relaxHelper.getCoordinates(&coords[0]);
+    outputSurfaceFile->setCoordinates(&coords[0]);
+    outputSurfaceFile->computeNormals();
+}
+
+/**
+ * Constructor that inflates coordinates already in a relaxation
+ * helper, so that a sequence of inflations (such as those of
+ * AlgorithmSurfaceGenerateInflated) can run without copying
+ * surfaces or rebuilding neighbor lists in between.
+ *
+ * Calling the constructor will execute the algorithm
+ *
+ * @param myProgObj
+ *     Parameters for algorithm
+ */
+AlgorithmSurfaceInflation::AlgorithmSurfaceInflation(ProgressObject* myProgObj,
+                                                     const SurfaceFile* anatomicalSurfaceFile,
+                                                     SurfaceRelaxationHelper& relaxHelper,
+                                                     const int32_t cycles,
+                                                     const float strength,
+                                                     const int32_t iterations,
+                                                     const float inflationFactorIn)
+   : AbstractAlgorithm(myProgObj, getCommandSwitch())
+{
+    LevelProgress myProgress(myProgObj);
+    
+    inflateCoordinates(myProgress,
+                       anatomicalSurfaceFile,
+                       relaxHelper,
+                       cycles,
+                       strength,
+                       iterations,
+                       inflationFactorIn);
+}
+
+/**
+ * Perform cycles of smoothing followed by inflation
+ * (to correct shrinkage caused by smoothing).
+ */
+void
+AlgorithmSurfaceInflation::inflateCoordinates(LevelProgress& myProgress,
+                                              const SurfaceFile* anatomicalSurfaceFile,
+                                              SurfaceRelaxationHelper& relaxHelper,
+                                              const int32_t cycles,
+                                              const float strength,
+                                              const int32_t iterations,
+                                              const float inflationFactorIn)
+{
+    if ((strength < 0.0)
+        || (strength > 1.0)) {
+        throw AlgorithmException("Invalid smoothing strength outside [0.0, 1.0]: "
+                                 + QString::number(strength, 'f', 5));
+    }
+    
+    if (iterations <= 0) {
+        throw AlgorithmException("Invalid iterations value [1, infinity]: "
+                                 + QString::number(iterations));
+    }
+    
+    relaxHelper.translateToCenterOfMass();
+    
+    const BoundingBox* anatomicalBoundingBox = anatomicalSurfaceFile->getBoundingBox();
+    const float anatomicalRange[3] = {
+        anatomicalBoundingBox->getDifferenceX(),
+        anatomicalBoundingBox->getDifferenceY(),
+        anatomicalBoundingBox->getDifferenceZ()
+    };
+    
+    const float totalIterations = static_cast<float>(cycles) * iterations;
     for (int iCycle = 0; iCycle < cycles; iCycle++) {
         /*
          * Smooth
          */
-        ProgressObject* subProgress = NULL;
-        if (myProgObj != NULL)
-        {
-            subProgress = subAlgProgress[iCycle];
+        for (int32_t iter = 0; iter < iterations; iter++) {
+            relaxHelper.smoothIteration(strength);
+            myProgress.reportProgress((static_cast<float>(iCycle) * iterations + iter + 1)
+                                      / totalIterations);
         }
-        AlgorithmSurfaceSmoothing(subProgress,
-                                  outputSurfaceFile,
-                                  outputSurfaceFile,
-                                  strength,
-                                  iterations);
         
         /*
          * Inflate
          */
-        float xyz[3];
-        for (int32_t iNode = 0; iNode < numberOfNodes; iNode++) {
-            outputSurfaceFile->getCoordinate(iNode,
-                                             xyz);
-            
-            const float x = xyz[0] / anatomicalRangeX;
-            const float y = xyz[1] / anatomicalRangeY;
-            const float z = xyz[2] / anatomicalRangeZ;
-            
-            const float radius = std::sqrt(x*x + y*y + z*z);
-            const float scale  = 1.0 + inflationFactor * (1.0 - radius);
-            
-            xyz[0] *= scale;
-            xyz[1] *= scale;
-            xyz[2] *= scale;
-            
-            outputSurfaceFile->setCoordinate(iNode,
-                                             xyz);
-        }
-        
-        myProgress.reportProgress(static_cast<float>(iCycle +1)
-                                  / static_cast<float>(cycles));
+        relaxHelper.inflate(inflationFactorIn,
+                            anatomicalRange);
     }
-    
-    outputSurfaceFile->computeNormals();
 }
 
 /**
@@ -219,7 +258,7 @@ AlgorithmSurfaceInflation::getAlgorithmInternalWeight()
     /*
      * override this if needed, if the progress bar isn't smooth
      */
-    return 0.1f;//all this does internally is rescale the coordinates, lower the internal weight
+    return 1.0f;//the smoothing iterations are done internally
 }
 
 /**
@@ -231,6 +270,7 @@ AlgorithmSurfaceInflation::getSubAlgorithmWeight()
     /*
      * If you use a subalgorithm
      */
-    return AlgorithmSurfaceSmoothing::getAlgorithmWeight();
+    //return AlgorithmInsertNameHere::getAlgorithmWeight()
+    return 0.0f;
 }
 
@@ -26,11 +26,22 @@
 
 namespace caret {
 
+    class LevelProgress;
+    class SurfaceRelaxationHelper;
+    
     class AlgorithmSurfaceInflation : public AbstractAlgorithm {
 
     private:
         AlgorithmSurfaceInflation(); 
 
+        static void inflateCoordinates(LevelProgress& myProgress,
+                                       const SurfaceFile* anatomicalSurfaceFile,
+                                       SurfaceRelaxationHelper& relaxHelper,
+                                       const int32_t cycles,
+                                       const float strength,
+                                       const int32_t iterations,
+                                       const float inflationFactorIn);
+
     protected:
         static float getSubAlgorithmWeight();
 
@@ -46,6 +57,14 @@ namespace caret {
                                   const int32_t iterations,
                                   const float inflationFactorIn);
 
+        AlgorithmSurfaceInflation(ProgressObject* myProgObj,
+                                  const SurfaceFile* anatomicalSurfaceFile,
+                                  SurfaceRelaxationHelper& relaxHelper,
+                                  const int32_t cycles,
+                                  const float strength,
+                                  const int32_t iterations,
+                                  const float inflationFactorIn);
+
         static OperationParameters* getParameters();
 
         static void useParameters(OperationParameters* myParams,
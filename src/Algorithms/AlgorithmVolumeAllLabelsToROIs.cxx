@@ -22,9 +22,9 @@
 #include "AlgorithmException.h"
 
 #include "GiftiLabelTable.h"
+#include "LabelKeyRemap.h"
 #include "VolumeFile.h"
 
-#include <cmath>
 #include <map>
 #include <vector>
 
@@ -70,7 +70,7 @@ void AlgorithmVolumeAllLabelsToROIs::useParameters(OperationParameters* myParams
     AlgorithmVolumeAllLabelsToROIs(myProgObj, myLabel, whichMap, myVolOut);
 }
 
-AlgorithmVolumeAllLabelsToROIs::AlgorithmVolumeAllLabelsToROIs(ProgressObject* myProgObj, const VolumeFile* myLabel, const int& whichMap, VolumeFile* myVolOut) : AbstractAlgorithm(myProgObj)
+AlgorithmVolumeAllLabelsToROIs::AlgorithmVolumeAllLabelsToROIs(ProgressObject* myProgObj, const VolumeFile* myLabel, const int& whichMap, VolumeFile* myVolOut) : AbstractAlgorithm(myProgObj, getCommandSwitch())
 {
     LevelProgress myProgress(myProgObj);
     if (myLabel->getType() != SubvolumeAttributes::LABEL)
@@ -89,7 +89,7 @@ AlgorithmVolumeAllLabelsToROIs::AlgorithmVolumeAllLabelsToROIs(ProgressObject* m
     {
         throw AlgorithmException("label table doesn't contain any keys besides the ??? key");
     }
-    map<int32_t, int> keyToMap;//lookup from keys to subvolume
+    map<int32_t, int32_t> keyToMap;//lookup from keys to subvolume
     vector<int64_t> outDims = myLabel->getOriginalDimensions();
     outDims.resize(4);
     outDims[3] = numKeys - 1;//don't include the ??? key
@@ -103,18 +103,21 @@ AlgorithmVolumeAllLabelsToROIs::AlgorithmVolumeAllLabelsToROIs(ProgressObject* m
         myVolOut->setMapName(counter, myTable->getLabelName(*iter));
         ++counter;
     }
+    const int64_t frameSize = outDims[0] * outDims[1] * outDims[2];
+    vector<int32_t> voxelMaps(frameSize);//which output subvolume each voxel is in, -1 for none, so the output only gets one pass
+    LabelKeyRemap(keyToMap, -1).apply(myLabel->getFrame(whichMap), voxelMaps.data(), frameSize);
+    int64_t index = 0;
     for (int64_t k = 0; k < outDims[2]; ++k)//because we need to set voxels in the output, rather than in a temporary frame, for single pass without duplicating the memory
     {
         for (int64_t j = 0; j < outDims[1]; ++j)
         {
             for (int64_t i = 0; i < outDims[0]; ++i)
             {
-                int32_t thisKey = (int32_t)floor(myLabel->getValue(i, j, k, whichMap) + 0.5f);
-                map<int32_t, int>::iterator iter = keyToMap.find(thisKey);
-                if (iter != keyToMap.end())
+                if (voxelMaps[index] >= 0)
                 {
-                    myVolOut->setValue(1.0f, i, j, k, iter->second);
+                    myVolOut->setValue(1.0f, i, j, k, voxelMaps[index]);
                 }
+                ++index;
             }
         }
     }
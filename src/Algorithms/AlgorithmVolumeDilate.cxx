@@ -21,19 +21,34 @@
 #include "AlgorithmVolumeDilate.h"
 
 #include "AlgorithmException.h"
+#include "CaretAssert.h"
 #include "CaretHeap.h"
 #include "CaretLogger.h"
 #include "CaretOMP.h"
+#include "DilationPlan.h"
 #include "FloatMatrix.h"
 #include "Vector3D.h"
 #include "VolumeFile.h"
 #include "VoxelIJK.h"
 
+#include <algorithm>
 #include <cmath>
 
 using namespace caret;
 using namespace std;
 
+namespace
+{
+    enum VoxelStatus
+    {
+        VOXEL_IGNORE = 0,//copied unchanged and not used for dilation
+        VOXEL_GOOD = 1,
+        VOXEL_BAD = 2
+    };
+    
+    const int64_t MAX_PLAN_SOURCES = ((int64_t)1) << 25;//WEIGHTED plans grow with distance cubed per bad voxel, above this many sources (about 400MB) dilate each frame from the stencil instead
+}
+
 AString AlgorithmVolumeDilate::getCommandSwitch()
 {
     return "-volume-dilate";
@@ -115,7 +130,8 @@ void AlgorithmVolumeDilate::useParameters(OperationParameters* myParams, Progres
 }
 
 AlgorithmVolumeDilate::AlgorithmVolumeDilate(ProgressObject* myProgObj, const VolumeFile* volIn, const float& distance, const Method& myMethod,
-                                             VolumeFile* volOut, const VolumeFile* badRoi, const VolumeFile* dataRoi, const int& subvol) : AbstractAlgorithm(myProgObj)
+                                             VolumeFile* volOut, const VolumeFile* badRoi, const VolumeFile* dataRoi, const int& subvol,
+                                             PlanCache* planCache) : AbstractAlgorithm(myProgObj, getCommandSwitch())
 {
     LevelProgress myProgress(myProgObj);
     vector<int64_t> myDims;
@@ -140,71 +156,86 @@ AlgorithmVolumeDilate::AlgorithmVolumeDilate(ProgressObject* myProgObj, const Vo
     {
         CaretLogWarning("dilating a volume label file with weighted method, expect strangeness");
     }
-    vector<vector<float> > volSpace = volIn->getSform();
-    Vector3D ivec, jvec, kvec, origin, ijorth, jkorth, kiorth;
-    FloatMatrix(volSpace).getAffineVectors(ivec, jvec, kvec, origin);
-    ijorth = ivec.cross(jvec).normal();//find the bounding box that encloses a sphere of radius kernBox
-    jkorth = jvec.cross(kvec).normal();
-    kiorth = kvec.cross(ivec).normal();
-    int irange = (int)floor(abs(distance / ivec.dot(jkorth)));
-    int jrange = (int)floor(abs(distance / jvec.dot(kiorth)));
-    int krange = (int)floor(abs(distance / kvec.dot(ijorth)));
-    if (irange < 1) irange = 1;//don't underflow
-    if (jrange < 1) jrange = 1;
-    if (krange < 1) krange = 1;
-    Vector3D kscratch, jscratch, iscratch;
-    vector<int> stencil;
-    vector<float> stenWeights;
-    for (int k = -krange; k <= krange; ++k)
-    {
-        kscratch = kvec * k;
-        for (int j = -jrange; j <= jrange; ++j)
+    PlanCache localCache;
+    PlanCache& myCache = (planCache != NULL ? *planCache : localCache);
+    vector<int64_t> frameDims(myDims.begin(), myDims.begin() + 3);
+    vector<int>& stencil = myCache.m_stencil;
+    vector<float>& stenWeights = myCache.m_stenWeights;
+    if (!myCache.m_stencilValid || myCache.m_distance != distance || myCache.m_method != myMethod || myCache.m_dims != frameDims || myCache.m_sform != volIn->getSform())
+    {//a plan only applies to the volume space and settings it was built with
+        myCache.m_stencilValid = false;
+        myCache.m_planValid = false;
+        stencil.clear();
+        stenWeights.clear();
+        vector<vector<float> > volSpace = volIn->getSform();
+        Vector3D ivec, jvec, kvec, origin, ijorth, jkorth, kiorth;
+        FloatMatrix(volSpace).getAffineVectors(ivec, jvec, kvec, origin);
+        ijorth = ivec.cross(jvec).normal();//find the bounding box that encloses a sphere of radius kernBox
+        jkorth = jvec.cross(kvec).normal();
+        kiorth = kvec.cross(ivec).normal();
+        int irange = (int)floor(abs(distance / ivec.dot(jkorth)));
+        int jrange = (int)floor(abs(distance / jvec.dot(kiorth)));
+        int krange = (int)floor(abs(distance / kvec.dot(ijorth)));
+        if (irange < 1) irange = 1;//don't underflow
+        if (jrange < 1) jrange = 1;
+        if (krange < 1) krange = 1;
+        Vector3D kscratch, jscratch, iscratch;
+        for (int k = -krange; k <= krange; ++k)
         {
-            jscratch = kscratch + jvec * j;
-            for (int i = -irange; i <= irange; ++i)
+            kscratch = kvec * k;
+            for (int j = -jrange; j <= jrange; ++j)
             {
-                if (k == 0 && j == 0 && i == 0) continue;
-                iscratch = jscratch + ivec * i;
-                float tempf = iscratch.length();
-                if (tempf <= distance || abs(i) + abs(j) + abs(k) == 1)
+                jscratch = kscratch + jvec * j;
+                for (int i = -irange; i <= irange; ++i)
                 {
-                    stencil.push_back(i);
-                    stencil.push_back(j);
-                    stencil.push_back(k);
-                    switch (myMethod)
+                    if (k == 0 && j == 0 && i == 0) continue;
+                    iscratch = jscratch + ivec * i;
+                    float tempf = iscratch.length();
+                    if (tempf <= distance || abs(i) + abs(j) + abs(k) == 1)
                     {
-                        case NEAREST:
-                            stenWeights.push_back(tempf);
-                            break;
-                        case WEIGHTED:
-                            if (tempf == 0.0f) throw AlgorithmException("volume space is degenerate, aborting");
-                            stenWeights.push_back(1.0f / (tempf * tempf));
-                            break;
+                        stencil.push_back(i);
+                        stencil.push_back(j);
+                        stencil.push_back(k);
+                        switch (myMethod)
+                        {
+                            case NEAREST:
+                                stenWeights.push_back(tempf);
+                                break;
+                            case WEIGHTED:
+                                if (tempf == 0.0f) throw AlgorithmException("volume space is degenerate, aborting");
+                                stenWeights.push_back(1.0f / (tempf * tempf));
+                                break;
+                        }
                     }
                 }
             }
         }
-    }
-    if (myMethod == NEAREST)
-    {//sort the stencil by distance, so we can stop early
-        CaretSimpleMinHeap<VoxelIJK, float> myHeap;
-        int stencilSize = (int)stenWeights.size();
-        myHeap.reserve(stencilSize);
-        for (int i = 0; i < stencilSize; ++i)
-        {
-            myHeap.push(VoxelIJK(stencil.data() + i * 3), stenWeights[i]);
-        }
-        stencil.clear();
-        stenWeights.clear();
-        while (!myHeap.isEmpty())
-        {
-            float tempf;
-            VoxelIJK myTriple = myHeap.pop(&tempf);
-            stenWeights.push_back(tempf);
-            stencil.push_back(myTriple.m_ijk[0]);
-            stencil.push_back(myTriple.m_ijk[1]);
-            stencil.push_back(myTriple.m_ijk[2]);
+        if (myMethod == NEAREST)
+        {//sort the stencil by distance, so we can stop early
+            CaretSimpleMinHeap<VoxelIJK, float> myHeap;
+            int stencilSize = (int)stenWeights.size();
+            myHeap.reserve(stencilSize);
+            for (int i = 0; i < stencilSize; ++i)
+            {
+                myHeap.push(VoxelIJK(stencil.data() + i * 3), stenWeights[i]);
+            }
+            stencil.clear();
+            stenWeights.clear();
+            while (!myHeap.isEmpty())
+            {
+                float tempf;
+                VoxelIJK myTriple = myHeap.pop(&tempf);
+                stenWeights.push_back(tempf);
+                stencil.push_back(myTriple.m_ijk[0]);
+                stencil.push_back(myTriple.m_ijk[1]);
+                stencil.push_back(myTriple.m_ijk[2]);
+            }
         }
+        myCache.m_distance = distance;
+        myCache.m_method = myMethod;
+        myCache.m_dims = frameDims;
+        myCache.m_sform = volIn->getSform();
+        myCache.m_stencilValid = true;
     }
     if (subvol == -1)
     {
@@ -231,157 +262,245 @@ AlgorithmVolumeDilate::AlgorithmVolumeDilate(ProgressObject* myProgObj, const Vo
         }
         volOut->setMapName(0, volIn->getMapName(subvol) + " dilate " + AString::number(distance));
     }
+    vector<int> frameSubvols, frameOutSubvols, frameComponents;//in the order the frames were processed before
     if (subvol == -1)
     {
         for (int s = 0; s < myDims[3]; ++s)
         {
             for (int c = 0; c < myDims[4]; ++c)
             {
-                dilateFrame(volIn, s, c, volOut, s, badRoi, dataRoi, myMethod, stencil, stenWeights);
+                frameSubvols.push_back(s);
+                frameOutSubvols.push_back(s);
+                frameComponents.push_back(c);
             }
         }
     } else {
         for (int c = 0; c < myDims[4]; ++c)
         {
-            dilateFrame(volIn, subvol, c, volOut, 0, badRoi, dataRoi, myMethod, stencil, stenWeights);
+            frameSubvols.push_back(subvol);
+            frameOutSubvols.push_back(0);
+            frameComponents.push_back(c);
+        }
+    }
+    //the stencil searches only depend on which voxels are bad and good, so compute them once per distinct mask (once per file with a bad voxel roi, or when all frames have the same zeros)
+    const int batchSize = 16;
+    int numFrames = (int)frameSubvols.size();
+    int64_t frameSize = myDims[0] * myDims[1] * myDims[2];
+    DilationPlan& myPlan = myCache.m_plan;
+    vector<char>& planStatus = myCache.m_status;
+    vector<char> frameStatus;
+    vector<vector<float> > batchScratch(min(batchSize, numFrames), vector<float>(frameSize));
+    for (int f = 0; f < numFrames; )
+    {
+        const float* frameData = volIn->getFrame(frameSubvols[f], frameComponents[f]);
+        computeVoxelStatus(frameStatus, frameSize, frameData, badRoi, dataRoi);
+        if (!myCache.m_planValid || frameStatus != planStatus)
+        {
+            planStatus.swap(frameStatus);
+            myCache.m_planValid = false;//in case building it throws
+            myCache.m_planTooLarge = !buildPlan(myPlan, volIn, planStatus, myMethod, stencil, stenWeights);
+            myCache.m_planValid = true;
+        }
+        vector<const float*> batchIn(1, frameData);
+        vector<float*> batchOut(1, batchScratch[0].data());
+        int batchEnd = f + 1;
+        while (batchEnd < numFrames && batchEnd - f < batchSize)
+        {
+            const float* nextData = volIn->getFrame(frameSubvols[batchEnd], frameComponents[batchEnd]);
+            if (badRoi == NULL)
+            {
+                computeVoxelStatus(frameStatus, frameSize, nextData, badRoi, dataRoi);
+                if (frameStatus != planStatus) break;
+            }
+            batchIn.push_back(nextData);
+            batchOut.push_back(batchScratch[batchEnd - f].data());
+            ++batchEnd;
+        }
+        if (myCache.m_planTooLarge)
+        {
+            applyDirect(volIn, planStatus, myMethod, stencil, stenWeights, batchIn, batchOut);
+        } else {
+            myPlan.apply(batchIn, batchOut, frameSize);
+        }
+        for (int i = f; i < batchEnd; ++i)
+        {
+            volOut->setFrame(batchOut[i - f], frameOutSubvols[i], frameComponents[i]);
         }
+        f = batchEnd;
+        myProgress.reportProgress(((float)f) / numFrames);
     }
 }
 
-void AlgorithmVolumeDilate::dilateFrame(const VolumeFile* volIn, const int& insubvol, const int& component, VolumeFile* volOut, const int& outsubvol,
-                                        const VolumeFile* badRoi, const VolumeFile* dataRoi, const Method& myMethod, const vector<int>& stencil, const vector<float>& stenWeights)
+void AlgorithmVolumeDilate::computeVoxelStatus(vector<char>& statusOut, const int64_t& frameSize, const float* frameData, const VolumeFile* badRoi, const VolumeFile* dataRoi)
+{
+    const float* badFrame = NULL, *dataRoiFrame = NULL;
+    if (badRoi != NULL) badFrame = badRoi->getFrame();
+    if (dataRoi != NULL) dataRoiFrame = dataRoi->getFrame();
+    statusOut.resize(frameSize);
+    for (int64_t i = 0; i < frameSize; ++i)
+    {
+        bool inData = (dataRoiFrame == NULL || dataRoiFrame[i] > 0.0f);
+        if (badFrame != NULL)
+        {
+            if (badFrame[i] > 0.0f)//in case some clown uses NaNs as bad in an roi
+            {
+                statusOut[i] = VOXEL_BAD;//the bad roi overrides the data roi
+            } else {
+                statusOut[i] = (inData ? VOXEL_GOOD : VOXEL_IGNORE);
+            }
+        } else {
+            if (!inData)
+            {
+                statusOut[i] = VOXEL_IGNORE;
+            } else {
+                statusOut[i] = (frameData[i] != 0.0f ? VOXEL_GOOD : VOXEL_BAD);
+            }
+        }
+    }
+}
+
+void AlgorithmVolumeDilate::getTargets(vector<int64_t>& targetsOut, const vector<char>& voxelStatus)
+{
+    targetsOut.clear();
+    int64_t frameSize = (int64_t)voxelStatus.size();
+    for (int64_t i = 0; i < frameSize; ++i)
+    {
+        if (voxelStatus[i] == VOXEL_BAD) targetsOut.push_back(i);
+    }
+}
+
+int64_t AlgorithmVolumeDilate::countSources(const VolumeFile* volIn, const vector<int64_t>& targets, const vector<char>& voxelStatus, const Method& myMethod,
+                                            const vector<int>& stencil)
+{
+    vector<int64_t> myDims;
+    volIn->getDimensions(myDims);
+    int64_t numTargets = (int64_t)targets.size();
+    int stensize = (int)stencil.size() / 3;
+    int64_t ret = 0;
+#pragma omp CARET_PARFOR schedule(dynamic, 64) reduction(+:ret)
+    for (int64_t t = 0; t < numTargets; ++t)
+    {
+        int64_t i = targets[t] % myDims[0], j = (targets[t] / myDims[0]) % myDims[1], k = targets[t] / (myDims[0] * myDims[1]);
+        for (int stenind = 0; stenind < stensize; ++stenind)
+        {
+            int base = stenind * 3;
+            int64_t tempindex[3];
+            tempindex[0] = stencil[base] + i;
+            tempindex[1] = stencil[base + 1] + j;
+            tempindex[2] = stencil[base + 2] + k;
+            if (volIn->indexValid(tempindex) && voxelStatus[volIn->getIndex(tempindex)] == VOXEL_GOOD)
+            {
+                ++ret;
+                if (myMethod == NEAREST) break;
+            }
+        }
+    }
+    return ret;
+}
+
+bool AlgorithmVolumeDilate::buildPlan(DilationPlan& myPlan, const VolumeFile* volIn, const vector<char>& voxelStatus, const Method& myMethod,
+                                      const vector<int>& stencil, const vector<float>& stenWeights)
 {
     vector<int64_t> myDims;
     volIn->getDimensions(myDims);
+    vector<int64_t> targets;
+    getTargets(targets, voxelStatus);
+    int64_t numTargets = (int64_t)targets.size();
     int stensize = (int)stenWeights.size();
-#pragma omp CARET_PARFOR schedule(dynamic)
-    for (int k = 0; k < myDims[2]; ++k)
+    if (numTargets * stensize > MAX_PLAN_SOURCES && countSources(volIn, targets, voxelStatus, myMethod, stencil) > MAX_PLAN_SOURCES)
+    {//only count exactly when the bound is over, most bad voxels have few good neighbors
+        myPlan = DilationPlan();//release the previous plan
+        return false;
+    }
+    vector<vector<pair<int64_t, float> > > sources(numTargets);
+#pragma omp CARET_PARFOR schedule(dynamic, 64)
+    for (int64_t t = 0; t < numTargets; ++t)
     {
-        for (int j = 0; j < myDims[1]; ++j)
+        int64_t i = targets[t] % myDims[0], j = (targets[t] / myDims[0]) % myDims[1], k = targets[t] / (myDims[0] * myDims[1]);
+        for (int stenind = 0; stenind < stensize; ++stenind)
         {
-            for (int i = 0; i < myDims[0]; ++i)
+            int base = stenind * 3;
+            int64_t tempindex[3];
+            tempindex[0] = stencil[base] + i;
+            tempindex[1] = stencil[base + 1] + j;
+            tempindex[2] = stencil[base + 2] + k;
+            if (volIn->indexValid(tempindex))
             {
-                bool copy = true;
-                if (badRoi == NULL)
+                int64_t neighIndex = volIn->getIndex(tempindex);
+                if (voxelStatus[neighIndex] == VOXEL_GOOD)
                 {
-                    copy = volIn->getValue(i, j, k, insubvol, component) != 0.0f || (dataRoi != NULL && !(dataRoi->getValue(i, j, k) > 0.0f));
-                } else {
-                    copy = !(badRoi->getValue(i, j, k) > 0.0f);//in case some clown uses NaNs as bad in an roi
+                    if (myMethod == NEAREST)
+                    {//stencil is sorted by distance
+                        sources[t].push_back(pair<int64_t, float>(neighIndex, 1.0f));
+                        break;
+                    }
+                    sources[t].push_back(pair<int64_t, float>(neighIndex, stenWeights[stenind]));
                 }
-                if (copy)
+            }
+        }
+    }
+    myPlan.setTargets(targets, sources);
+    return true;
+}
+
+void AlgorithmVolumeDilate::applyDirect(const VolumeFile* volIn, const vector<char>& voxelStatus, const Method& myMethod, const vector<int>& stencil, const vector<float>& stenWeights,
+                                        const vector<const float*>& inputs, const vector<float*>& outputs)
+{//same results as building the plan and applying it, but searches the stencil for every batch of frames
+    CaretAssert(inputs.size() == outputs.size());
+    vector<int64_t> myDims;
+    volIn->getDimensions(myDims);
+    int64_t frameSize = (int64_t)voxelStatus.size();
+    int numMaps = (int)inputs.size();
+    for (int m = 0; m < numMaps; ++m)
+    {
+        CaretAssert(outputs[m] != inputs[m]);
+        for (int64_t i = 0; i < frameSize; ++i)
+        {
+            outputs[m][i] = inputs[m][i];
+        }
+    }
+    vector<int64_t> targets;
+    getTargets(targets, voxelStatus);
+    int64_t numTargets = (int64_t)targets.size();
+    int stensize = (int)stenWeights.size();
+#pragma omp CARET_PAR
+    {
+        vector<double> accum(numMaps);
+#pragma omp CARET_FOR schedule(dynamic, 64)
+        for (int64_t t = 0; t < numTargets; ++t)
+        {
+            int64_t i = targets[t] % myDims[0], j = (targets[t] / myDims[0]) % myDims[1], k = targets[t] / (myDims[0] * myDims[1]);
+            for (int m = 0; m < numMaps; ++m)
+            {
+                accum[m] = 0.0;
+            }
+            float weightSum = 0.0f;
+            for (int stenind = 0; stenind < stensize; ++stenind)
+            {
+                int base = stenind * 3;
+                int64_t tempindex[3];
+                tempindex[0] = stencil[base] + i;
+                tempindex[1] = stencil[base + 1] + j;
+                tempindex[2] = stencil[base + 2] + k;
+                if (volIn->indexValid(tempindex))
                 {
-                    volOut->setValue(volIn->getValue(i, j, k, insubvol, component), i, j, k, outsubvol, component);
-                } else {
-                    Vector3D voxcoord;
-                    volIn->indexToSpace(i, j, k, voxcoord);
-                    switch (myMethod)
+                    int64_t neighIndex = volIn->getIndex(tempindex);
+                    if (voxelStatus[neighIndex] == VOXEL_GOOD)
                     {
-                        case NEAREST:
-                        {
-                            int best = -1;
-                            if (badRoi == NULL)
-                            {
-                                for (int stenind = 0; stenind < stensize; ++stenind)
-                                {
-                                    int base = stenind * 3;
-                                    int64_t tempindex[3];
-                                    tempindex[0] = stencil[base] + i;
-                                    tempindex[1] = stencil[base + 1] + j;
-                                    tempindex[2] = stencil[base + 2] + k;
-                                    if (volIn->indexValid(tempindex))
-                                    {
-                                        if ((dataRoi == NULL || dataRoi->getValue(tempindex) > 0.0f) && volIn->getValue(tempindex, insubvol, component) != 0.0f)
-                                        {
-                                            best = stenind;
-                                            break;
-                                        }
-                                    }
-                                }
-                            } else {
-                                for (int stenind = 0; stenind < stensize; ++stenind)
-                                {
-                                    int base = stenind * 3;
-                                    int64_t tempindex[3];
-                                    tempindex[0] = stencil[base] + i;
-                                    tempindex[1] = stencil[base + 1] + j;
-                                    tempindex[2] = stencil[base + 2] + k;
-                                    if (volIn->indexValid(tempindex))
-                                    {
-                                        if ((dataRoi == NULL || dataRoi->getValue(tempindex) > 0.0f) && !(badRoi->getValue(tempindex) > 0.0f))
-                                        {
-                                            best = stenind;
-                                            break;
-                                        }
-                                    }
-                                }
-                            }
-                            if (best == -1)
-                            {
-                                volOut->setValue(0.0f, i, j, k, outsubvol, component);
-                            } else {
-                                int base = best * 3;
-                                int64_t tempindex[3];
-                                tempindex[0] = stencil[base] + i;
-                                tempindex[1] = stencil[base + 1] + j;
-                                tempindex[2] = stencil[base + 2] + k;
-                                volOut->setValue(volIn->getValue(tempindex, insubvol, component), i, j, k, outsubvol, component);
-                            }
-                            break;
-                        }
-                        case WEIGHTED:
+                        float weight = (myMethod == NEAREST ? 1.0f : stenWeights[stenind]);
+                        weightSum += weight;
+                        for (int m = 0; m < numMaps; ++m)
                         {
-                            double sum = 0.0, weightsum = 0.0;
-                            if (badRoi == NULL)
-                            {
-                                for (int stenind = 0; stenind < stensize; ++stenind)
-                                {
-                                    int base = stenind * 3;
-                                    int64_t tempindex[3];
-                                    tempindex[0] = stencil[base] + i;
-                                    tempindex[1] = stencil[base + 1] + j;
-                                    tempindex[2] = stencil[base + 2] + k;
-                                    if (volIn->indexValid(tempindex))
-                                    {
-                                        float tempf = volIn->getValue(tempindex, insubvol, component);
-                                        if ((dataRoi == NULL || dataRoi->getValue(tempindex) > 0.0f) && tempf != 0.0f)
-                                        {
-                                            float weight = stenWeights[stenind];
-                                            sum += weight * tempf;
-                                            weightsum += weight;
-                                        }
-                                    }
-                                }
-                            } else {
-                                for (int stenind = 0; stenind < stensize; ++stenind)
-                                {
-                                    int base = stenind * 3;
-                                    int64_t tempindex[3];
-                                    tempindex[0] = stencil[base] + i;
-                                    tempindex[1] = stencil[base + 1] + j;
-                                    tempindex[2] = stencil[base + 2] + k;
-                                    if (volIn->indexValid(tempindex))
-                                    {
-                                        if ((dataRoi == NULL || dataRoi->getValue(tempindex) > 0.0f) && !(badRoi->getValue(tempindex) > 0.0f))
-                                        {
-                                            float tempf = volIn->getValue(tempindex, insubvol, component);
-                                            float weight = stenWeights[stenind];
-                                            sum += weight * tempf;
-                                            weightsum += weight;
-                                        }
-                                    }
-                                }
-                            }
-                            if (weightsum != 0.0)
-                            {
-                                volOut->setValue(sum / weightsum, i, j, k, outsubvol, component);
-                            } else {
-                                volOut->setValue(0.0f, i, j, k, outsubvol, component);
-                            }
-                            break;
+                            accum[m] += inputs[m][neighIndex] * weight;
                         }
+                        if (myMethod == NEAREST) break;
                     }
                 }
             }
+            for (int m = 0; m < numMaps; ++m)
+            {
+                outputs[m][targets[t]] = (weightSum != 0.0f ? accum[m] / weightSum : 0.0f);
+            }
         }
     }
 }
@@ -22,6 +22,9 @@
 /*LICENSE_END*/
 
 #include "AbstractAlgorithm.h"
+#include "DilationPlan.h"
+
+#include <vector>
 
 namespace caret {
     
@@ -37,15 +40,38 @@ namespace caret {
             NEAREST,
             WEIGHTED
         };
+        ///keeps the stencil, the last plan, and the voxel mask it was built for, so calls on data with the same mask (such as blocks of a streamed cifti file) don't redo the neighbor searches
+        class PlanCache
+        {
+            float m_distance;
+            Method m_method;
+            std::vector<int64_t> m_dims;
+            std::vector<std::vector<float> > m_sform;
+            bool m_stencilValid, m_planValid, m_planTooLarge;//when the plan would be too large, frames are dilated directly from the stencil
+            std::vector<int> m_stencil;
+            std::vector<float> m_stenWeights;
+            std::vector<char> m_status;
+            DilationPlan m_plan;
+            friend class AlgorithmVolumeDilate;
+        public:
+            PlanCache() : m_distance(0.0f), m_method(NEAREST), m_stencilValid(false), m_planValid(false), m_planTooLarge(false) { }
+        };
         AlgorithmVolumeDilate(ProgressObject* myProgObj, const VolumeFile* volIn, const float& distance, const Method& myMethod,
-                              VolumeFile* volOut, const VolumeFile* badRoi = NULL, const VolumeFile* dataRoi = NULL, const int& subvol = -1);
+                              VolumeFile* volOut, const VolumeFile* badRoi = NULL, const VolumeFile* dataRoi = NULL, const int& subvol = -1,
+                              PlanCache* planCache = NULL);
         static OperationParameters* getParameters();
         static void useParameters(OperationParameters* myParams, ProgressObject* myProgObj);
         static AString getCommandSwitch();
         static AString getShortDescription();
     private:
-        void dilateFrame(const VolumeFile* volIn, const int& insubvol, const int& component, VolumeFile* volOut, const int& outsubvol, const VolumeFile* badRoi,
-                         const VolumeFile* dataRoi, const Method& myMethod, const std::vector<int>& stencil, const std::vector<float>& stenWeights);
+        static void computeVoxelStatus(std::vector<char>& statusOut, const int64_t& frameSize, const float* frameData, const VolumeFile* badRoi, const VolumeFile* dataRoi);
+        static void getTargets(std::vector<int64_t>& targetsOut, const std::vector<char>& voxelStatus);
+        static int64_t countSources(const VolumeFile* volIn, const std::vector<int64_t>& targets, const std::vector<char>& voxelStatus, const Method& myMethod,
+                                    const std::vector<int>& stencil);
+        bool buildPlan(DilationPlan& myPlan, const VolumeFile* volIn, const std::vector<char>& voxelStatus, const Method& myMethod,
+                       const std::vector<int>& stencil, const std::vector<float>& stenWeights);//returns false without building if the plan would be too large
+        static void applyDirect(const VolumeFile* volIn, const std::vector<char>& voxelStatus, const Method& myMethod, const std::vector<int>& stencil, const std::vector<float>& stenWeights,
+                                const std::vector<const float*>& inputs, const std::vector<float*>& outputs);
     };
 
     typedef TemplateAutoOperation<AlgorithmVolumeDilate> AutoAlgorithmVolumeDilate;
@@ -22,8 +22,8 @@
 #include "AlgorithmException.h"
 
 #include "CaretLogger.h"
+#include "ConnectedComponentsHelper.h"
 #include "VolumeFile.h"
-#include "VoxelIJK.h"
 
 #include <cmath>
 #include <vector>
@@ -104,7 +104,7 @@ void AlgorithmVolumeFindClusters::useParameters(OperationParameters* myParams, P
 }
 
 AlgorithmVolumeFindClusters::AlgorithmVolumeFindClusters(ProgressObject* myProgObj, const VolumeFile* volIn, const float& threshValue, const float& minVolume, VolumeFile* volOut,
-                                                         const bool& lessThan, const VolumeFile* myRoi, const int& subvolNum, const int& startVal, int* endVal) : AbstractAlgorithm(myProgObj)
+                                                         const bool& lessThan, const VolumeFile* myRoi, const int& subvolNum, const int& startVal, int* endVal) : AbstractAlgorithm(myProgObj, getCommandSwitch())
 {
     LevelProgress myProgress(myProgObj);
     const VolumeSpace& mySpace = volIn->getVolumeSpace();
@@ -120,169 +120,60 @@ AlgorithmVolumeFindClusters::AlgorithmVolumeFindClusters(ProgressObject* myProgO
     int64_t minVoxels = (int64_t)ceil(minVolume / voxelVolume);
     vector<int64_t> dims = volIn->getDimensions();
     int64_t frameSize = dims[0] * dims[1] * dims[2];
-    vector<VoxelIJK> neighbors;
-    neighbors.push_back(VoxelIJK(1, 0, 0));
-    neighbors.push_back(VoxelIJK(-1, 0, 0));
-    neighbors.push_back(VoxelIJK(0, 1, 0));
-    neighbors.push_back(VoxelIJK(0, -1, 0));
-    neighbors.push_back(VoxelIJK(0, 0, 1));
-    neighbors.push_back(VoxelIJK(0, 0, -1));
-    int markVal = startVal;
+    ConnectedComponentsHelper myComponents(dims);//face neighbors, same as searching with a 6 voxel stencil
+    vector<int64_t> subvolList;
     if (subvolNum == -1)
     {
         volOut->reinitialize(volIn->getOriginalDimensions(), volIn->getSform(), dims[4]);
-        volOut->setValueAllVoxels(0.0f);
-        for (int64_t c = 0; c < dims[4]; ++c)
+        for (int64_t s = 0; s < dims[3]; ++s)
         {
-            for (int64_t s = 0; s < dims[3]; ++s)
-            {
-                vector<char> marked(frameSize, 0);
-                const float* inFrame = volIn->getFrame(s, c);
-                if (lessThan)
-                {
-                    for (int64_t i = 0; i < frameSize; ++i)
-                    {
-                        if ((roiFrame == NULL || roiFrame[i] > 0.0f) && inFrame[i] < threshValue)
-                        {
-                            marked[i] = 1;
-                        }
-                    }
-                } else {
-                    for (int64_t i = 0; i < frameSize; ++i)
-                    {
-                        if ((roiFrame == NULL || roiFrame[i] > 0.0f) && inFrame[i] > threshValue)
-                        {
-                            marked[i] = 1;
-                        }
-                    }
-                }
-                for (int64_t k = 0; k < dims[2]; ++k)
-                {
-                    for (int64_t j = 0; j < dims[1]; ++j)
-                    {
-                        for (int64_t i = 0; i < dims[0]; ++i)
-                        {
-                            if (marked[volIn->getIndex(i, j, k)])
-                            {
-                                vector<VoxelIJK> voxelList;
-                                voxelList.push_back(VoxelIJK(i, j, k));
-                                marked[volIn->getIndex(i, j, k)] = 0;//don't let voxels get duplicated in the list
-                                for (int64_t index = 0; index < (int64_t)voxelList.size(); ++index)//NOTE: vector grows inside loop
-                                {
-                                    const VoxelIJK& thisVoxel = voxelList[index];
-                                    for (int n = 0; n < (int)neighbors.size(); ++n)
-                                    {
-                                        VoxelIJK neighVox(thisVoxel.m_ijk[0] + neighbors[n].m_ijk[0],
-                                                          thisVoxel.m_ijk[1] + neighbors[n].m_ijk[1],
-                                                          thisVoxel.m_ijk[2] + neighbors[n].m_ijk[2]);
-                                        if (volIn->indexValid(neighVox.m_ijk))
-                                        {
-                                            int64_t neighIndex = volIn->getIndex(neighVox.m_ijk);
-                                            if (marked[neighIndex])
-                                            {
-                                                voxelList.push_back(neighVox);
-                                                marked[neighIndex] = 0;
-                                            }
-                                        }
-                                    }
-                                }
-                                if ((int64_t)voxelList.size() >= minVoxels)
-                                {
-                                    if (markVal == 0)
-                                    {
-                                        CaretLogInfo("skipping 0 for cluster marking");
-                                        ++markVal;
-                                    }
-                                    float tempVal = markVal;
-                                    if ((int)tempVal != markVal) throw AlgorithmException("too many clusters, unable to mark them uniquely");
-                                    for (int64_t index = 0; index < (int64_t)voxelList.size(); ++index)
-                                    {
-                                        volOut->setValue(tempVal, voxelList[index].m_ijk, s, c);
-                                    }
-                                    ++markVal;
-                                }
-                            }
-                        }
-                    }
-                }
-            }
+            subvolList.push_back(s);
         }
     } else {
         vector<int64_t> outDims = volIn->getOriginalDimensions();
         outDims.resize(3);
         volOut->reinitialize(outDims, volIn->getSform(), dims[4]);
-        volOut->setValueAllVoxels(0.0f);
-        for (int64_t c = 0; c < dims[4]; ++c)
+        subvolList.push_back(subvolNum);
+    }
+    int markVal = startVal;
+    vector<char> marked(frameSize);
+    vector<int64_t> clusterLabels;
+    vector<double> clusterSizes;
+    vector<float> outFrame(frameSize);
+    int64_t numSubvols = (int64_t)subvolList.size();
+    for (int64_t c = 0; c < dims[4]; ++c)
+    {
+        for (int64_t outSubvol = 0; outSubvol < numSubvols; ++outSubvol)
         {
-            vector<char> marked(frameSize, 0);
-            const float* inFrame = volIn->getFrame(subvolNum, c);
-            if (lessThan)
+            const float* inFrame = volIn->getFrame(subvolList[outSubvol], c);
+            for (int64_t i = 0; i < frameSize; ++i)
             {
-                for (int64_t i = 0; i < frameSize; ++i)
-                {
-                    if ((roiFrame == NULL || roiFrame[i] > 0.0f) && inFrame[i] < threshValue)
-                    {
-                        marked[i] = 1;
-                    }
-                }
-            } else {
-                for (int64_t i = 0; i < frameSize; ++i)
-                {
-                    if ((roiFrame == NULL || roiFrame[i] > 0.0f) && inFrame[i] > threshValue)
-                    {
-                        marked[i] = 1;
-                    }
-                }
+                marked[i] = ((roiFrame == NULL || roiFrame[i] > 0.0f) && (lessThan ? inFrame[i] < threshValue : inFrame[i] > threshValue));
             }
-            for (int64_t k = 0; k < dims[2]; ++k)
+            myComponents.findComponents(marked.data(), NULL, clusterLabels, clusterSizes);
+            int64_t numClusters = (int64_t)clusterSizes.size();
+            vector<float> clusterValues(numClusters, 0.0f);//clusters come out in order of their lowest voxel index, so numbering is the same as a serial search
+            for (int64_t k = 0; k < numClusters; ++k)
             {
-                for (int64_t j = 0; j < dims[1]; ++j)
+                if ((int64_t)clusterSizes[k] >= minVoxels)
                 {
-                    for (int64_t i = 0; i < dims[0]; ++i)
+                    if (markVal == 0)
                     {
-                        if (marked[volIn->getIndex(i, j, k)])
-                        {
-                            vector<VoxelIJK> voxelList;
-                            voxelList.push_back(VoxelIJK(i, j, k));
-                            marked[volIn->getIndex(i, j, k)] = 0;//don't let voxels get duplicated in the list
-                            for (int64_t index = 0; index < (int64_t)voxelList.size(); ++index)//NOTE: vector grows inside loop
-                            {
-                                const VoxelIJK& thisVoxel = voxelList[index];
-                                for (int n = 0; n < (int)neighbors.size(); ++n)
-                                {
-                                    VoxelIJK neighVox(thisVoxel.m_ijk[0] + neighbors[n].m_ijk[0],
-                                                        thisVoxel.m_ijk[1] + neighbors[n].m_ijk[1],
-                                                        thisVoxel.m_ijk[2] + neighbors[n].m_ijk[2]);
-                                    if (volIn->indexValid(neighVox.m_ijk))
-                                    {
-                                        int64_t neighIndex = volIn->getIndex(neighVox.m_ijk);
-                                        if (marked[neighIndex])
-                                        {
-                                            voxelList.push_back(neighVox);
-                                            marked[neighIndex] = 0;
-                                        }
-                                    }
-                                }
-                            }
-                            if ((int64_t)voxelList.size() >= minVoxels)
-                            {
-                                if (markVal == 0)
-                                {
-                                    CaretLogInfo("skipping 0 for cluster marking");
-                                    ++markVal;
-                                }
-                                float tempVal = markVal;
-                                if ((int)tempVal != markVal) throw AlgorithmException("too many clusters, unable to mark them uniquely");
-                                for (int64_t index = 0; index < (int64_t)voxelList.size(); ++index)
-                                {
-                                    volOut->setValue(tempVal, voxelList[index].m_ijk, 0, c);
-                                }
-                                ++markVal;
-                            }
-                        }
+                        CaretLogInfo("skipping 0 for cluster marking");
+                        ++markVal;
                     }
+                    float tempVal = markVal;
+                    if ((int)tempVal != markVal) throw AlgorithmException("too many clusters, unable to mark them uniquely");
+                    clusterValues[k] = tempVal;
+                    ++markVal;
                 }
             }
+            for (int64_t i = 0; i < frameSize; ++i)
+            {
+                outFrame[i] = (clusterLabels[i] == -1 ? 0.0f : clusterValues[clusterLabels[i]]);
+            }
+            volOut->setFrame(outFrame.data(), outSubvol, c);
+            myProgress.reportProgress(((float)c * numSubvols + outSubvol + 1) / (dims[4] * numSubvols));
         }
     }
     if (endVal != NULL) *endVal = markVal;
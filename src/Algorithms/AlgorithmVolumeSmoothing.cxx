@@ -97,11 +97,115 @@ void AlgorithmVolumeSmoothing::useParameters(OperationParameters* myParams, Prog
     AlgorithmVolumeSmoothing(myProgObj, myVol, myKernel, myOutVol, roiVol, fixZeros, subvolNum);
 }
 
-AlgorithmVolumeSmoothing::AlgorithmVolumeSmoothing(ProgressObject* myProgObj, const VolumeFile* inVol, const float& kernel, VolumeFile* outVol, const VolumeFile* roiVol, const bool& fixZeros, const int& subvol) : AbstractAlgorithm(myProgObj)
+AlgorithmVolumeSmoothing::Kernel::Kernel(const VolumeFile* spaceVol, const float& kernel)
+{
+    CaretAssert(spaceVol != NULL);
+    if (kernel <= 0.0f)
+    {
+        throw AlgorithmException("kernel too small");
+    }
+    m_kernel = kernel;
+    m_sform = spaceVol->getSform();
+    float kernBox = kernel * 3.0f;
+    Vector3D ivec, jvec, kvec, ijorth, jkorth, kiorth;
+    ivec[0] = m_sform[0][0]; jvec[0] = m_sform[0][1]; kvec[0] = m_sform[0][2];
+    ivec[1] = m_sform[1][0]; jvec[1] = m_sform[1][1]; kvec[1] = m_sform[1][2];
+    ivec[2] = m_sform[2][0]; jvec[2] = m_sform[2][1]; kvec[2] = m_sform[2][2];
+    const float ORTH_TOLERANCE = 0.001f;//tolerate this much deviation from orthogonal (dot product divided by product of lengths) to use orthogonal assumptions to smooth
+    m_orthogonal = (abs(ivec.dot(jvec.normal())) / ivec.length() < ORTH_TOLERANCE && abs(jvec.dot(kvec.normal())) / jvec.length() < ORTH_TOLERANCE && abs(kvec.dot(ivec.normal())) / kvec.length() < ORTH_TOLERANCE);
+    if (m_orthogonal)
+    {//if our axes are orthogonal, optimize by doing three 1-dimensional smoothings for O(voxels * (ki + kj + kk)) instead of O(voxels * (ki * kj * kk))
+        float ispace = ivec.length(), jspace = jvec.length(), kspace = kvec.length();
+        m_irange = (int)floor(kernBox / ispace);
+        m_jrange = (int)floor(kernBox / jspace);
+        m_krange = (int)floor(kernBox / kspace);
+        if (m_irange < 1) m_irange = 1;//don't underflow
+        if (m_jrange < 1) m_jrange = 1;
+        if (m_krange < 1) m_krange = 1;
+        int isize = m_irange * 2 + 1;//and construct a precomputed kernel in the box
+        int jsize = m_jrange * 2 + 1;
+        int ksize = m_krange * 2 + 1;
+        m_iweights = CaretArray<float>(isize);
+        m_jweights = CaretArray<float>(jsize);
+        m_kweights = CaretArray<float>(ksize);
+        for (int i = 0; i < isize; ++i)
+        {
+            float tempf = ispace * (i - m_irange) / kernel;
+            m_iweights[i] = exp(-tempf * tempf / 2.0f);
+        }
+        for (int j = 0; j < jsize; ++j)
+        {
+            float tempf = jspace * (j - m_jrange) / kernel;
+            m_jweights[j] = exp(-tempf * tempf / 2.0f);
+        }
+        for (int k = 0; k < ksize; ++k)
+        {
+            float tempf = kspace * (k - m_krange) / kernel;
+            m_kweights[k] = exp(-tempf * tempf / 2.0f);
+        }
+    } else {
+        if (!haveWarned)
+        {
+            CaretLogWarning("input volume is not orthogonal, smoothing will take longer");
+            haveWarned = true;
+        }
+        ijorth = ivec.cross(jvec).normal();//find the bounding box that encloses a sphere of radius kernBox
+        jkorth = jvec.cross(kvec).normal();
+        kiorth = kvec.cross(ivec).normal();
+        m_irange = (int)floor(abs(kernBox / ivec.dot(jkorth)));
+        m_jrange = (int)floor(abs(kernBox / jvec.dot(kiorth)));
+        m_krange = (int)floor(abs(kernBox / kvec.dot(ijorth)));
+        if (m_irange < 1) m_irange = 1;//don't underflow
+        if (m_jrange < 1) m_jrange = 1;
+        if (m_krange < 1) m_krange = 1;
+        int isize = m_irange * 2 + 1;//and construct a precomputed kernel in the box
+        int jsize = m_jrange * 2 + 1;
+        int ksize = m_krange * 2 + 1;
+        m_weights = CaretArray<float**>(ksize);//so I don't need to explicitly delete[] if I throw
+        m_weights2 = CaretArray<float*>(ksize * jsize);//construct flat arrays and index them into 3D
+        m_weights3 = CaretArray<float>(ksize * jsize * isize);//index i comes last because that is linear for volume frames
+        Vector3D kscratch, jscratch, iscratch;
+        for (int k = 0; k < ksize; ++k)
+        {
+            kscratch = kvec * (k - m_krange);
+            m_weights[k] = m_weights2 + k * jsize;
+            for (int j = 0; j < jsize; ++j)
+            {
+                jscratch = kscratch + jvec * (j - m_jrange);
+                m_weights[k][j] = m_weights3 + ((k * jsize) + j) * isize;
+                for (int i = 0; i < isize; ++i)
+                {
+                    iscratch = jscratch + ivec * (i - m_irange);
+                    float tempf = iscratch.length();
+                    if (tempf > kernBox)
+                    {
+                        m_weights[k][j][i] = 0.0f;//test for zero to avoid some multiplies/adds, cheaper or cleaner than checking bounds on indexes from an index list
+                    } else {
+                        m_weights[k][j][i] = exp(-tempf * tempf / kernel / kernel / 2.0f);//optimization here isn't critical
+                    }
+                }
+            }
+        }
+    }
+}
+
+AlgorithmVolumeSmoothing::AlgorithmVolumeSmoothing(ProgressObject* myProgObj, const VolumeFile* inVol, const float& kernel, VolumeFile* outVol, const VolumeFile* roiVol, const bool& fixZeros, const int& subvol) : AbstractAlgorithm(myProgObj, getCommandSwitch())
 {
     CaretAssert(inVol != NULL);
-    CaretAssert(outVol != NULL);
     LevelProgress myProgress(myProgObj);
+    smoothVolume(inVol, Kernel(inVol, kernel), outVol, roiVol, fixZeros, subvol);
+}
+
+AlgorithmVolumeSmoothing::AlgorithmVolumeSmoothing(ProgressObject* myProgObj, const VolumeFile* inVol, const Kernel& myKernel, VolumeFile* outVol, const VolumeFile* roiVol, const bool& fixZeros, const int& subvol) : AbstractAlgorithm(myProgObj, getCommandSwitch())
+{
+    LevelProgress myProgress(myProgObj);
+    smoothVolume(inVol, myKernel, outVol, roiVol, fixZeros, subvol);
+}
+
+void AlgorithmVolumeSmoothing::smoothVolume(const VolumeFile* inVol, const Kernel& myKernel, VolumeFile* outVol, const VolumeFile* roiVol, const bool& fixZeros, const int& subvol)
+{
+    CaretAssert(inVol != NULL);
+    CaretAssert(outVol != NULL);
     if (roiVol != NULL && !inVol->matchesVolumeSpace(roiVol))
     {
         throw AlgorithmException("volume roi space does not match input volume");
@@ -112,51 +216,28 @@ AlgorithmVolumeSmoothing::AlgorithmVolumeSmoothing(ProgressObject* myProgObj, co
     {
         throw AlgorithmException("invalid subvolume specified");
     }
-    if (kernel <= 0.0f)
+    vector<vector<float> > volSpace = inVol->getSform();
+    for (int i = 0; i < 3; ++i)
     {
-        throw AlgorithmException("kernel too small");
+        for (int j = 0; j < 3; ++j)
+        {
+            if (volSpace[i][j] != myKernel.m_sform[i][j])
+            {
+                throw AlgorithmException("smoothing kernel was built for a volume with different voxel spacing");
+            }
+        }
     }
+    const float kernel = myKernel.m_kernel;
+    const int irange = myKernel.m_irange, jrange = myKernel.m_jrange, krange = myKernel.m_krange;
     CaretArray<float> scratchFrame(myDims[0] * myDims[1] * myDims[2]);//it could be faster to preinitialize with zeros, then generate a usable voxels list if there is a small ROI...
-    float kernBox = kernel * 3.0f;
-    vector<vector<float> > volSpace = inVol->getSform();
-    Vector3D ivec, jvec, kvec, origin, ijorth, jkorth, kiorth;
-    ivec[0] = volSpace[0][0]; jvec[0] = volSpace[0][1]; kvec[0] = volSpace[0][2]; origin[0] = volSpace[0][3];
-    ivec[1] = volSpace[1][0]; jvec[1] = volSpace[1][1]; kvec[1] = volSpace[1][2]; origin[1] = volSpace[1][3];
-    ivec[2] = volSpace[2][0]; jvec[2] = volSpace[2][1]; kvec[2] = volSpace[2][2]; origin[2] = volSpace[2][3];
-    const float ORTH_TOLERANCE = 0.001f;//tolerate this much deviation from orthogonal (dot product divided by product of lengths) to use orthogonal assumptions to smooth
-    if (abs(ivec.dot(jvec.normal())) / ivec.length() < ORTH_TOLERANCE && abs(jvec.dot(kvec.normal())) / jvec.length() < ORTH_TOLERANCE && abs(kvec.dot(ivec.normal())) / kvec.length() < ORTH_TOLERANCE)
-    {//if our axes are orthogonal, optimize by doing three 1-dimensional smoothings for O(voxels * (ki + kj + kk)) instead of O(voxels * (ki * kj * kk))
+    if (myKernel.m_orthogonal)
+    {
         CaretArray<float> scratchFrame2(myDims[0] * myDims[1] * myDims[2]), scratchWeights(myDims[0] * myDims[1] * myDims[2]), scratchWeights2(myDims[0] * myDims[1] * myDims[2]), scratchFrame3;
         if (roiVol != NULL)
         {
             scratchFrame3 = CaretArray<float> (myDims[0] * myDims[1] * myDims[2]);
         }
-        float ispace = ivec.length(), jspace = jvec.length(), kspace = kvec.length();
-        int irange = (int)floor(kernBox / ispace);
-        int jrange = (int)floor(kernBox / jspace);
-        int krange = (int)floor(kernBox / kspace);
-        if (irange < 1) irange = 1;//don't underflow
-        if (jrange < 1) jrange = 1;
-        if (krange < 1) krange = 1;
-        int isize = irange * 2 + 1;//and construct a precomputed kernel in the box
-        int jsize = jrange * 2 + 1;
-        int ksize = krange * 2 + 1;
-        CaretArray<float> iweights(isize), jweights(jsize), kweights(ksize);
-        for (int i = 0; i < isize; ++i)
-        {
-            float tempf = ispace * (i - irange) / kernel;
-            iweights[i] = exp(-tempf * tempf / 2.0f);
-        }
-        for (int j = 0; j < jsize; ++j)
-        {
-            float tempf = jspace * (j - jrange) / kernel;
-            jweights[j] = exp(-tempf * tempf / 2.0f);
-        }
-        for (int k = 0; k < ksize; ++k)
-        {
-            float tempf = kspace * (k - krange) / kernel;
-            kweights[k] = exp(-tempf * tempf / 2.0f);
-        }
+        const CaretArray<float>& iweights = myKernel.m_iweights, &jweights = myKernel.m_jweights, &kweights = myKernel.m_kweights;
         if (subvol == -1)
         {
             vector<int64_t> origDims = inVol->getOriginalDimensions();
@@ -199,48 +280,7 @@ AlgorithmVolumeSmoothing::AlgorithmVolumeSmoothing(ProgressObject* myProgObj, co
             }
         }
     } else {
-        if (!haveWarned)
-        {
-            CaretLogWarning("input volume is not orthogonal, smoothing will take longer");
-            haveWarned = true;
-        }
-        ijorth = ivec.cross(jvec).normal();//find the bounding box that encloses a sphere of radius kernBox
-        jkorth = jvec.cross(kvec).normal();
-        kiorth = kvec.cross(ivec).normal();
-        int irange = (int)floor(abs(kernBox / ivec.dot(jkorth)));
-        int jrange = (int)floor(abs(kernBox / jvec.dot(kiorth)));
-        int krange = (int)floor(abs(kernBox / kvec.dot(ijorth)));
-        if (irange < 1) irange = 1;//don't underflow
-        if (jrange < 1) jrange = 1;
-        if (krange < 1) krange = 1;
-        int isize = irange * 2 + 1;//and construct a precomputed kernel in the box
-        int jsize = jrange * 2 + 1;
-        int ksize = krange * 2 + 1;
-        CaretArray<float**> weights(ksize);//so I don't need to explicitly delete[] if I throw
-        CaretArray<float*> weights2(ksize * jsize);//construct flat arrays and index them into 3D
-        CaretArray<float> weights3(ksize * jsize * isize);//index i comes last because that is linear for volume frames
-        Vector3D kscratch, jscratch, iscratch;
-        for (int k = 0; k < ksize; ++k)
-        {
-            kscratch = kvec * (k - krange);
-            weights[k] = weights2 + k * jsize;
-            for (int j = 0; j < jsize; ++j)
-            {
-                jscratch = kscratch + jvec * (j - jrange);
-                weights[k][j] = weights3 + ((k * jsize) + j) * isize;
-                for (int i = 0; i < isize; ++i)
-                {
-                    iscratch = jscratch + ivec * (i - irange);
-                    float tempf = iscratch.length();
-                    if (tempf > kernBox)
-                    {
-                        weights[k][j][i] = 0.0f;//test for zero to avoid some multiplies/adds, cheaper or cleaner than checking bounds on indexes from an index list
-                    } else {
-                        weights[k][j][i] = exp(-tempf * tempf / kernel / kernel / 2.0f);//optimization here isn't critical
-                    }
-                }
-            }
-        }
+        const CaretArray<float**>& weights = myKernel.m_weights;
         if (subvol == -1)
         {
             vector<int64_t> origDims = inVol->getOriginalDimensions();
@@ -29,6 +29,24 @@ namespace caret {
     {
         AlgorithmVolumeSmoothing();
         static bool haveWarned;
+    public:
+        ///precomputed kernel weights for one voxel spacing, to smooth many volumes in the same space without rebuilding them
+        class Kernel
+        {
+            float m_kernel;
+            bool m_orthogonal;
+            int m_irange, m_jrange, m_krange;
+            std::vector<std::vector<float> > m_sform;
+            CaretArray<float> m_iweights, m_jweights, m_kweights;//separable weights, for orthogonal volumes
+            CaretArray<float**> m_weights;//full box of weights for non-orthogonal volumes, [k][j][i] points into the two arrays below
+            CaretArray<float*> m_weights2;
+            CaretArray<float> m_weights3;
+            friend class AlgorithmVolumeSmoothing;
+        public:
+            Kernel(const VolumeFile* spaceVol, const float& kernel);
+        };
+    private:
+        void smoothVolume(const VolumeFile* inVol, const Kernel& myKernel, VolumeFile* outVol, const VolumeFile* roiVol, const bool& fixZeros, const int& subvol);
     protected:
         static float getSubAlgorithmWeight();
         static float getAlgorithmInternalWeight();
@@ -43,6 +61,8 @@ namespace caret {
     public:
         AlgorithmVolumeSmoothing(ProgressObject* myProgObj, const VolumeFile* inVol, const float& kernel, VolumeFile* outVol,
                                  const VolumeFile* roiVol = NULL, const bool& fixZeros = false, const int& subvol = -1);
+        AlgorithmVolumeSmoothing(ProgressObject* myProgObj, const VolumeFile* inVol, const Kernel& myKernel, VolumeFile* outVol,
+                                 const VolumeFile* roiVol = NULL, const bool& fixZeros = false, const int& subvol = -1);
         static OperationParameters* getParameters();
         static void useParameters(OperationParameters* myParams, ProgressObject* myProgObj);
         static AString getCommandSwitch();
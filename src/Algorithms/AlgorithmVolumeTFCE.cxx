@@ -115,7 +115,7 @@ void AlgorithmVolumeTFCE::useParameters(OperationParameters* myParams, ProgressO
 }
 
 AlgorithmVolumeTFCE::AlgorithmVolumeTFCE(ProgressObject* myProgObj, const VolumeFile* myVol, VolumeFile* myVolOut, const float& presmooth, const VolumeFile* myRoi,
-                                         const float& param_e, const float& param_h, const int64_t& subvolNum) : AbstractAlgorithm(myProgObj)
+                                         const float& param_e, const float& param_h, const int64_t& subvolNum) : AbstractAlgorithm(myProgObj, getCommandSwitch())
 {
     LevelProgress myProgress(myProgObj);
     if (myRoi != NULL && !myVol->getVolumeSpace().matches(myRoi->getVolumeSpace())) throw AlgorithmException("roi volume has different volume space than input");
@@ -123,6 +123,9 @@ AlgorithmVolumeTFCE::AlgorithmVolumeTFCE(ProgressObject* myProgObj, const Volume
     vector<int64_t> dims = myVol->getDimensions();
     const float* roiFrame = NULL;
     if (myRoi != NULL) roiFrame = myRoi->getFrame();
+    Vector3D ivec, jvec, kvec, origin;//compute the volume of a voxel so different resolutions have comparable values - as if it matters, but hey
+    myVol->getVolumeSpace().getSpacingVectors(ivec, jvec, kvec, origin);//who knows, maybe we'll have distortion correction in volume someday
+    const float voxelVolume = abs(ivec.dot(jvec.cross(kvec)));
     if (subvolNum == -1)
     {
         myVolOut->reinitialize(myVol->getOriginalDimensions(), myVol->getSform(), dims[4]);
@@ -141,7 +144,7 @@ AlgorithmVolumeTFCE::AlgorithmVolumeTFCE(ProgressObject* myProgObj, const Volume
             {
                 for (int64_t c = 0; c < dims[4]; ++c)
                 {
-                    processFrame(toUse, b, c, outframe.data(), roiFrame, param_e, param_h);
+                    processFrame(toUse->getFrame(b, c), dims.data(), voxelVolume, outframe.data(), roiFrame, param_e, param_h);
                     myVolOut->setFrame(outframe.data(), b, c);
                 }
             }
@@ -162,20 +165,18 @@ AlgorithmVolumeTFCE::AlgorithmVolumeTFCE(ProgressObject* myProgObj, const Volume
         vector<float> outframe(dims[0] * dims[1] * dims[2]);
         for (int64_t c = 0; c < dims[4]; ++c)
         {
-            processFrame(toUse, useFrame, c, outframe.data(), roiFrame, param_e, param_h);
+            processFrame(toUse->getFrame(useFrame, c), dims.data(), voxelVolume, outframe.data(), roiFrame, param_e, param_h);
             myVolOut->setFrame(outframe.data(), 0, c);
         }
     }
 }
 
-void AlgorithmVolumeTFCE::processFrame(const VolumeFile* inVol, const int64_t& b, const int64_t& c, float* outData, const float* roiData, const float& param_e, const float& param_h)
+void AlgorithmVolumeTFCE::processFrame(const float* inData, const int64_t dims[3], const float& voxelVolume, float* outData, const float* roiData, const float& param_e, const float& param_h)
 {
-    vector<int64_t> dims = inVol->getDimensions();
     int64_t frameSize = dims[0] * dims[1] * dims[2];
     vector<double> accum(frameSize, 0.0);
-    tfce(inVol, b, c, accum.data(), roiData, param_e, param_h, false);//don't negate - positives
-    tfce(inVol, b, c, accum.data(), roiData, param_e, param_h, true);//negate - negatives - NOTE: output is still positive!!!
-    const float* inData = inVol->getFrame(b, c);
+    tfce(inData, dims, voxelVolume, accum.data(), roiData, param_e, param_h, false);//don't negate - positives
+    tfce(inData, dims, voxelVolume, accum.data(), roiData, param_e, param_h, true);//negate - negatives - NOTE: output is still positive!!!
     for (int64_t i = 0; i < frameSize; ++i)
     {
         if (inData[i] > 0.0f)//negate the results from negative inputs
@@ -189,6 +190,16 @@ void AlgorithmVolumeTFCE::processFrame(const VolumeFile* inVol, const int64_t& b
 
 namespace _algorithm_volume_tfce
 {//hidden namespace just to make sure things don't collide
+    inline int64_t getIndex(const int64_t dims[3], const int64_t& i, const int64_t& j, const int64_t& k)
+    {
+        return i + dims[0] * (j + dims[1] * k);
+    }
+    
+    inline bool indexValid(const int64_t dims[3], const int64_t ijk[3])
+    {
+        return ijk[0] >= 0 && ijk[0] < dims[0] && ijk[1] >= 0 && ijk[1] < dims[1] && ijk[2] >= 0 && ijk[2] < dims[2];
+    }
+    
     struct Cluster
     {
         double accumVal, totalVolume;
@@ -244,14 +255,9 @@ namespace _algorithm_volume_tfce
 
 using namespace _algorithm_volume_tfce;
 
-void AlgorithmVolumeTFCE::tfce(const VolumeFile* inVol, const int64_t& b, const int64_t& c, double* accumData, const float* roiData, const float& param_e, const float& param_h, const bool& negate)
+void AlgorithmVolumeTFCE::tfce(const float* frameData, const int64_t dims[3], const float& voxelVolume, double* accumData, const float* roiData, const float& param_e, const float& param_h, const bool& negate)
 {
-    vector<int64_t> dims = inVol->getDimensions();
-    Vector3D ivec, jvec, kvec, origin;//compute the volume of a voxel so different resolutions have comparable values - as if it matters, but hey
-    inVol->getVolumeSpace().getSpacingVectors(ivec, jvec, kvec, origin);//who knows, maybe we'll have distortion correction in volume someday
-    float voxelVolume = abs(ivec.dot(jvec.cross(kvec)));
     const int64_t frameSize = dims[0] * dims[1] * dims[2];
-    const float* frameData = inVol->getFrame(b, c);
     vector<int64_t> membership(frameSize, -1);//use int64_t just in case we get an absurd number of clusters
     vector<Cluster> clusterList;
     set<int64_t> deadClusters;//to allow reallocation without changing indices
@@ -262,7 +268,7 @@ void AlgorithmVolumeTFCE::tfce(const VolumeFile* inVol, const int64_t& b, const
         {
             for (int64_t k = 0; k < dims[2]; ++k)
             {
-                int64_t index = inVol->getIndex(i, j, k);
+                int64_t index = getIndex(dims, i, j, k);
                 if ((roiData == NULL || roiData[index] > 0.0f))
                 {
                     if (negate)
@@ -292,14 +298,14 @@ void AlgorithmVolumeTFCE::tfce(const VolumeFile* inVol, const int64_t& b, const
     {
         float value;
         VoxelIJK voxel = voxelHeap.pop(&value);
-        int64_t voxelIndex = inVol->getIndex(voxel.m_ijk);
+        int64_t voxelIndex = getIndex(dims, voxel.m_ijk[0], voxel.m_ijk[1], voxel.m_ijk[2]);
         set<int64_t> touchingClusters;
         for (int i = 0; i < STENCIL_SIZE; i += 3)
         {
             VoxelIJK neighVoxel(voxel.m_ijk[0] + stencil[i], voxel.m_ijk[1] + stencil[i + 1], voxel.m_ijk[2] + stencil[i + 2]);
-            if (inVol->indexValid(neighVoxel.m_ijk))
+            if (indexValid(dims, neighVoxel.m_ijk))
             {
-                int64_t neighIndex = inVol->getIndex(neighVoxel.m_ijk);
+                int64_t neighIndex = getIndex(dims, neighVoxel.m_ijk[0], neighVoxel.m_ijk[1], neighVoxel.m_ijk[2]);
                 if (membership[neighIndex] != -1)
                 {
                     touchingClusters.insert(membership[neighIndex]);
@@ -348,7 +354,8 @@ void AlgorithmVolumeTFCE::tfce(const VolumeFile* inVol, const int64_t& b, const
                         double correctionVal = thisCluster.accumVal - mergedCluster.accumVal;//fix the accum values in the side cluster so we can add the merged cluster's accum to everything at the end
                         for (int64_t j = 0; j < numMembers; ++j)//add the correction value to every member so that we have the current integrated values correct
                         {
-                            int64_t memberIndex = inVol->getIndex(thisCluster.members[j].m_ijk);
+                            const int64_t* memberIJK = thisCluster.members[j].m_ijk;
+                            int64_t memberIndex = getIndex(dims, memberIJK[0], memberIJK[1], memberIJK[2]);
                             accumData[memberIndex] += correctionVal;//apply the correction
                             membership[memberIndex] = mergedIndex;//and update membership
                         }
@@ -374,7 +381,8 @@ void AlgorithmVolumeTFCE::tfce(const VolumeFile* inVol, const int64_t& b, const
         int numMembers = (int)thisCluster.members.size();
         for (int j = 0; j < numMembers; ++j)
         {
-            accumData[inVol->getIndex(thisCluster.members[j].m_ijk)] += thisCluster.accumVal;//add the resulting slice to all members - their stored data contains the offset between the cluster peak and their corect value
+            const int64_t* memberIJK = thisCluster.members[j].m_ijk;
+            accumData[getIndex(dims, memberIJK[0], memberIJK[1], memberIJK[2])] += thisCluster.accumVal;//add the resulting slice to all members - their stored data contains the offset between the cluster peak and their corect value
         }
     }
 }
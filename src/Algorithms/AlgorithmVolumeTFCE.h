@@ -28,8 +28,7 @@ namespace caret {
     class AlgorithmVolumeTFCE : public AbstractAlgorithm
     {
         AlgorithmVolumeTFCE();
-        void processFrame(const VolumeFile* inVol, const int64_t& b, const int64_t& c, float* outData, const float* roiData, const float& param_e, const float& param_h);
-        void tfce(const VolumeFile* inVol, const int64_t& b, const int64_t& c, double* accumData, const float* roiData, const float& param_e, const float& param_h, const bool& negate);
+        static void tfce(const float* frameData, const int64_t dims[3], const float& voxelVolume, double* accumData, const float* roiData, const float& param_e, const float& param_h, const bool& negate);
     protected:
         static float getSubAlgorithmWeight();
         static float getAlgorithmInternalWeight();
@@ -40,6 +39,9 @@ namespace caret {
         static void useParameters(OperationParameters* myParams, ProgressObject* myProgObj);
         static AString getCommandSwitch();
         static AString getShortDescription();
+        
+        ///run TFCE on one frame of data, so that callers with data not in a VolumeFile (or many frames in the same space) can use it directly
+        static void processFrame(const float* inData, const int64_t dims[3], const float& voxelVolume, float* outData, const float* roiData, const float& param_e, const float& param_h);
     };
 
     typedef TemplateAutoOperation<AlgorithmVolumeTFCE> AutoAlgorithmVolumeTFCE;
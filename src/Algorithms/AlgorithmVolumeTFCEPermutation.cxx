@@ -0,0 +1,195 @@
+/*LICENSE_START*/
+/*
+ *  Copyright (C) 2014  Washington University School of Medicine
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+/*LICENSE_END*/
+
+#include "AlgorithmVolumeTFCEPermutation.h"
+#include "AlgorithmException.h"
+
+#include "AlgorithmVolumeTFCE.h"
+#include "CaretOMP.h"
+#include "PermutationTestHelper.h"
+#include "Vector3D.h"
+#include "VolumeFile.h"
+
+#include <cmath>
+#include <vector>
+
+using namespace caret;
+using namespace std;
+
+AString AlgorithmVolumeTFCEPermutation::getCommandSwitch()
+{
+    return "-volume-tfce-permutation";
+}
+
+AString AlgorithmVolumeTFCEPermutation::getShortDescription()
+{
+    return "TFCE PERMUTATION TEST ON A VOLUME FILE";
+}
+
+OperationParameters* AlgorithmVolumeTFCEPermutation::getParameters()
+{
+    OperationParameters* ret = new OperationParameters();
+    
+    ret->addVolumeParameter(1, "volume-in", "the volume with one subvolume per subject");
+    
+    ret->addVolumeOutputParameter(2, "p-value-out", "output - the family-wise error corrected p-values");
+    
+    OptionalParameter* roiOpt = ret->createOptionalParameter(3, "-roi", "select a region of interest to run TFCE on");
+    roiOpt->addVolumeParameter(1, "roi-volume", "the area to run TFCE on, as a volume");
+
+    OptionalParameter* paramsOpt = ret->createOptionalParameter(4, "-parameters", "set parameters for TFCE integral");
+    paramsOpt->addDoubleParameter(1, "E", "exponent for cluster volume (default 0.5)");
+    paramsOpt->addDoubleParameter(2, "H", "exponent for threshold value (default 2.0)");
+    
+    OptionalParameter* twoSampleOpt = ret->createOptionalParameter(5, "-two-sample", "compare two groups instead of testing the mean against zero");
+    twoSampleOpt->addIntegerParameter(1, "first-group-size", "the number of subvolumes in the first group, the remaining subvolumes are the second group");
+    
+    OptionalParameter* numPermOpt = ret->createOptionalParameter(6, "-permutations", "set the number of permutations");
+    numPermOpt->addIntegerParameter(1, "number", "the number of permutations (default 5000)");
+    
+    OptionalParameter* seedOpt = ret->createOptionalParameter(7, "-seed", "set the seed for generating permutations");
+    seedOpt->addIntegerParameter(1, "seed", "the seed (default 0)");
+    
+    OptionalParameter* tfceOutOpt = ret->createOptionalParameter(8, "-tfce-out", "output the TFCE-enhanced t-statistic of the unpermuted data");
+    tfceOutOpt->addVolumeOutputParameter(1, "tfce-out", "the enhanced statistic");
+    
+    ret->setHelpText(
+        AString("Runs a nonparametric permutation test using the TFCE-enhanced t-statistic.  ") +
+        "By default, each subvolume is a subject, and the mean is tested against zero by randomly flipping the sign of each subject's data.  " +
+        "With -two-sample, the first subvolumes are compared against the remaining subvolumes by randomly permuting group membership.\n\n" +
+        "Only the maximum absolute value of each permuted map is kept.  " +
+        "The output p-values are two-sided and corrected for multiple comparisons across voxels by the max statistic method, " +
+        "where the unpermuted data counts as one of the permutations, so the smallest possible p-value is 1 / (permutations + 1).  " +
+        "Permutations are generated from the seed, so results are reproducible regardless of the number of threads.\n\n" +
+        "See -volume-tfce for a description of TFCE and its parameters."
+    );
+    return ret;
+}
+
+void AlgorithmVolumeTFCEPermutation::useParameters(OperationParameters* myParams, ProgressObject* myProgObj)
+{
+    VolumeFile* myVol = myParams->getVolume(1);
+    VolumeFile* myPValueOut = myParams->getOutputVolume(2);
+    VolumeFile* myRoi = NULL;
+    OptionalParameter* roiOpt = myParams->getOptionalParameter(3);
+    if (roiOpt->m_present)
+    {
+        myRoi = roiOpt->getVolume(1);
+    }
+    float param_e = 0.5f, param_h = 2.0;
+    OptionalParameter* paramsOpt = myParams->getOptionalParameter(4);
+    if (paramsOpt->m_present)
+    {
+        param_e = (float)paramsOpt->getDouble(1);
+        param_h = (float)paramsOpt->getDouble(2);
+    }
+    int numFirstGroup = -1;
+    OptionalParameter* twoSampleOpt = myParams->getOptionalParameter(5);
+    if (twoSampleOpt->m_present)
+    {
+        numFirstGroup = (int)twoSampleOpt->getInteger(1);
+        if (numFirstGroup < 1) throw AlgorithmException("first group size must be positive");
+    }
+    int numPermutations = 5000;
+    OptionalParameter* numPermOpt = myParams->getOptionalParameter(6);
+    if (numPermOpt->m_present)
+    {
+        numPermutations = (int)numPermOpt->getInteger(1);
+        if (numPermutations < 1) throw AlgorithmException("number of permutations must be positive");
+    }
+    int64_t seed = 0;
+    OptionalParameter* seedOpt = myParams->getOptionalParameter(7);
+    if (seedOpt->m_present)
+    {
+        seed = seedOpt->getInteger(1);
+    }
+    VolumeFile* myTFCEOut = NULL;
+    OptionalParameter* tfceOutOpt = myParams->getOptionalParameter(8);
+    if (tfceOutOpt->m_present)
+    {
+        myTFCEOut = tfceOutOpt->getOutputVolume(1);
+    }
+    AlgorithmVolumeTFCEPermutation(myProgObj, myVol, myPValueOut, numPermutations, numFirstGroup, myRoi, param_e, param_h, myTFCEOut, seed);
+}
+
+AlgorithmVolumeTFCEPermutation::AlgorithmVolumeTFCEPermutation(ProgressObject* myProgObj, const VolumeFile* myVol, VolumeFile* myPValueOut, const int& numPermutations,
+                                                               const int& numFirstGroup, const VolumeFile* myRoi, const float& param_e, const float& param_h,
+                                                               VolumeFile* myTFCEOut, const int64_t& seed) : AbstractAlgorithm(myProgObj, getCommandSwitch())
+{
+    LevelProgress myProgress(myProgObj);
+    if (myRoi != NULL && !myVol->getVolumeSpace().matches(myRoi->getVolumeSpace())) throw AlgorithmException("roi volume has different volume space than input");
+    vector<int64_t> dims = myVol->getDimensions();
+    if (dims[4] != 1) throw AlgorithmException("input volume must not have multiple components");
+    const int numSubjects = (int)dims[3];
+    PermutationTestHelper myPermHelper(numSubjects, numFirstGroup, numPermutations, (uint64_t)seed);
+    const int64_t frameSize = dims[0] * dims[1] * dims[2];
+    const float* roiFrame = NULL;
+    if (myRoi != NULL) roiFrame = myRoi->getFrame();
+    Vector3D ivec, jvec, kvec, origin;
+    myVol->getVolumeSpace().getSpacingVectors(ivec, jvec, kvec, origin);
+    const float voxelVolume = abs(ivec.dot(jvec.cross(kvec)));
+    vector<const float*> subjectData(numSubjects);
+    for (int s = 0; s < numSubjects; ++s)
+    {
+        subjectData[s] = myVol->getFrame(s);
+    }
+    vector<float> observedTFCE(frameSize);
+    {
+        vector<float> observedStat(frameSize);
+        myPermHelper.computeStatistic(-1, subjectData, frameSize, observedStat.data());
+        AlgorithmVolumeTFCE::processFrame(observedStat.data(), dims.data(), voxelVolume, observedTFCE.data(), roiFrame, param_e, param_h);
+    }
+    vector<float> maxDistribution(numPermutations);
+#pragma omp CARET_PAR
+    {
+        vector<float> permStat(frameSize), permTFCE(frameSize);
+#pragma omp CARET_FOR schedule(dynamic)
+        for (int perm = 0; perm < numPermutations; ++perm)
+        {
+            myPermHelper.computeStatistic(perm, subjectData, frameSize, permStat.data());
+            AlgorithmVolumeTFCE::processFrame(permStat.data(), dims.data(), voxelVolume, permTFCE.data(), roiFrame, param_e, param_h);
+            maxDistribution[perm] = PermutationTestHelper::maxAbsolute(permTFCE.data(), frameSize);
+        }
+    }
+    vector<float> pValues(frameSize);
+    PermutationTestHelper::computeCorrectedPValues(maxDistribution, observedTFCE.data(), frameSize, pValues.data());
+    vector<int64_t> outDims = dims;
+    outDims.resize(3);
+    myPValueOut->reinitialize(outDims, myVol->getSform());
+    myPValueOut->setFrame(pValues.data());
+    myPValueOut->setMapName(0, "TFCE FWE p-value");
+    if (myTFCEOut != NULL)
+    {
+        myTFCEOut->reinitialize(outDims, myVol->getSform());
+        myTFCEOut->setFrame(observedTFCE.data());
+        myTFCEOut->setMapName(0, "TFCE t-statistic");
+    }
+}
+
+float AlgorithmVolumeTFCEPermutation::getAlgorithmInternalWeight()
+{
+    return 1.0f;//override this if needed, if the progress bar isn't smooth
+}
+
+float AlgorithmVolumeTFCEPermutation::getSubAlgorithmWeight()
+{
+    //return AlgorithmInsertNameHere::getAlgorithmWeight();//if you use a subalgorithm
+    return 0.0f;
+}
@@ -48,6 +48,9 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "AlgorithmVolumeToSurfaceMapping.h"
 #include "AlgorithmException.h"
 
+#include "CaretAssert.h"
+#include "CaretBinaryFile.h"
+#include "CaretLogger.h"
 #include "CaretOMP.h"
 #include "FloatMatrix.h"
 #include "MathFunctions.h"
@@ -57,11 +60,32 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "Vector3D.h"
 #include "VolumeFile.h"
 
+#include <QFile>
+
+#include <algorithm>
 #include <cmath>
+#include <cstring>
 
 using namespace caret;
 using namespace std;
 
+namespace
+{
+    const int64_t FRAME_BLOCK = 16;//frames mapped per pass over the weights
+    const char WEIGHTS_CACHE_MAGIC[8] = { 'W', 'B', 'R', 'W', 'G', 'T', '0', '1' };//last two characters are the format version
+    
+    //FNV-1a, only needs to tell whether the weights would come out the same
+    void hashBytes(uint64_t& hash, const void* data, const int64_t& numBytes)
+    {
+        const unsigned char* bytes = (const unsigned char*)data;
+        for (int64_t i = 0; i < numBytes; ++i)
+        {
+            hash ^= bytes[i];
+            hash *= 0x100000001B3ULL;
+        }
+    }
+}
+
 AString AlgorithmVolumeToSurfaceMapping::getCommandSwitch()
 {
     return "-volume-to-surface-mapping";
@@ -97,6 +121,8 @@ OperationParameters* AlgorithmVolumeToSurfaceMapping::getParameters()
     OptionalParameter* ribbonWeights = ribbonOpt->createOptionalParameter(5, "-output-weights", "write the voxel weights for a vertex to a volume file");
     ribbonWeights->addIntegerParameter(1, "vertex", "the vertex number to get the voxel weights for, 0-based");
     ribbonWeights->addVolumeOutputParameter(2, "weights-out", "volume to write the weights to");
+    OptionalParameter* ribbonCache = ribbonOpt->createOptionalParameter(6, "-weights-cache", "reuse voxel weights from a previous run with the same surfaces");
+    ribbonCache->addStringParameter(1, "cache-file", "file to read the weights from, or write them to if it doesn't match");
     
     OptionalParameter* myelinStyleOpt = ret->createOptionalParameter(9, "-myelin-style", "use the method from myelin mapping");
     myelinStyleOpt->addVolumeParameter(1, "ribbon-roi", "an roi volume of the cortical ribbon for this hemisphere");
@@ -114,7 +140,10 @@ OperationParameters* AlgorithmVolumeToSurfaceMapping::getParameters()
         "The volume ROI is useful to exclude partial volume effects of voxels the surfaces pass through, and will cause the mapping to ignore " +
         "voxels that don't have a positive value in the mask.  The subdivision number specifies how it approximates the amount of the volume the polyhedron " +
         "intersects, by splitting each voxel into NxNxN pieces, and checking whether the center of each piece is inside the polyhedron.  If you have very large " +
-        "voxels, consider increasing this if you get zeros in your output.\n\n" +
+        "voxels, consider increasing this if you get zeros in your output.  " +
+        "Computing the ribbon weights is usually the slowest part of this method, so when mapping several volumes in the same space with the same surfaces, " +
+        "use -weights-cache with the same file for each: if the file was made from the same surfaces, volume space, roi, and subdivisions, the weights are read from it, " +
+        "otherwise they are computed and the file is overwritten.\n\n" +
         "The myelin style method uses part of the caret5 myelin mapping command to do the mapping: for each surface vertex, take all voxels closer than the thickness at the vertex " +
         "that are within the ribbon ROI, and less than half the thickness value away from the vertex along the direction of the surface normal, and apply a gaussian kernel " +
         "with the specified sigma to them to get the weights to use."
@@ -228,7 +257,13 @@ void AlgorithmVolumeToSurfaceMapping::useParameters(OperationParameters* myParam
                 weightsOutVertex = (int)ribbonWeights->getInteger(1);
                 weightsOut = ribbonWeights->getOutputVolume(2);
             }
-            AlgorithmVolumeToSurfaceMapping(myProgObj, myVolume, mySurface, myMetricOut, innerSurf, outerSurf, myRoiVol, subdivisions, mySubVol, weightsOutVertex, weightsOut);
+            AString weightsCacheFile;
+            OptionalParameter* ribbonCache = ribbonOpt->getOptionalParameter(6);
+            if (ribbonCache->m_present)
+            {
+                weightsCacheFile = ribbonCache->getString(1);
+            }
+            AlgorithmVolumeToSurfaceMapping(myProgObj, myVolume, mySurface, myMetricOut, innerSurf, outerSurf, myRoiVol, subdivisions, mySubVol, weightsOutVertex, weightsOut, weightsCacheFile);
             break;
         }
         case MYELIN_STYLE:
@@ -246,7 +281,7 @@ void AlgorithmVolumeToSurfaceMapping::useParameters(OperationParameters* myParam
 
 //interpolation mapping
 AlgorithmVolumeToSurfaceMapping::AlgorithmVolumeToSurfaceMapping(ProgressObject* myProgObj, const VolumeFile* myVolume, const SurfaceFile* mySurface, MetricFile* myMetricOut,
-                                                                 const VolumeFile::InterpType& myMethod, const int64_t& mySubVol) : AbstractAlgorithm(myProgObj)
+                                                                 const VolumeFile::InterpType& myMethod, const int64_t& mySubVol) : AbstractAlgorithm(myProgObj, getCommandSwitch())
 {
     LevelProgress myProgress(myProgObj);
     vector<int64_t> myVolDims;
@@ -341,7 +376,8 @@ AlgorithmVolumeToSurfaceMapping::AlgorithmVolumeToSurfaceMapping(ProgressObject*
 //ribbon mapping
 AlgorithmVolumeToSurfaceMapping::AlgorithmVolumeToSurfaceMapping(ProgressObject* myProgObj, const VolumeFile* myVolume, const SurfaceFile* mySurface, MetricFile* myMetricOut,
                                                                  const SurfaceFile* innerSurf, const SurfaceFile* outerSurf, const VolumeFile* roiVol,
-                                                                 const int32_t& subdivisions, const int64_t& mySubVol, const int& weightsOutVertex, VolumeFile* weightsOut) : AbstractAlgorithm(myProgObj)
+                                                                 const int32_t& subdivisions, const int64_t& mySubVol, const int& weightsOutVertex, VolumeFile* weightsOut,
+                                                                 const AString& weightsCacheFile) : AbstractAlgorithm(myProgObj, getCommandSwitch())
 {
     LevelProgress myProgress(myProgObj);
     vector<int64_t> myVolDims;
@@ -375,94 +411,40 @@ AlgorithmVolumeToSurfaceMapping::AlgorithmVolumeToSurfaceMapping(ProgressObject*
         weightDims.resize(3);
         weightsOut->reinitialize(weightDims, myVolume->getSform());
     }
-    vector<vector<VoxelWeight> > myWeights;
-    precomputeWeightsRibbon(myWeights, myVolume, innerSurf, outerSurf, roiVol, subdivisions);
-    if (weightsOut != NULL)
+    VoxelWeightMatrix myWeights;
+    uint64_t cacheKey = 0;
+    bool haveWeights = false;
+    if (weightsCacheFile != "")
     {
-        weightsOut->setValueAllVoxels(0.0f);
-        const vector<VoxelWeight>& vertexWeights = myWeights[weightsOutVertex];
-        int numWeights = (int)vertexWeights.size();
-        for (int i = 0; i < numWeights; ++i)
-        {
-            weightsOut->setValue(vertexWeights[i].weight, vertexWeights[i].ijk);
-        }
+        cacheKey = computeRibbonCacheKey(myVolume, innerSurf, outerSurf, roiVol, subdivisions);
+        haveWeights = myWeights.readCache(weightsCacheFile, cacheKey, numNodes, myVolDims[0] * myVolDims[1] * myVolDims[2]);
     }
-    CaretArray<float> myScratchArray(numNodes);
-    float* myScratch = myScratchArray.getArray();
-    if (mySubVol == -1)
+    if (!haveWeights)
     {
-        for (int64_t i = 0; i < myVolDims[3]; ++i)
+        vector<vector<VoxelWeight> > weightLists;
+        precomputeWeightsRibbon(weightLists, myVolume, innerSurf, outerSurf, roiVol, subdivisions);
+        myWeights.setFromLists(weightLists, myVolDims, true);
+        if (weightsCacheFile != "")
         {
-            for (int64_t j = 0; j < myVolDims[4]; ++j)
-            {
-                int64_t thisCol = i * myVolDims[4] + j;
-                AString metricLabel = myVolume->getMapName(i);
-                if (myVolDims[4] != 1)
-                {
-                    metricLabel += " component " + AString::number(j);
-                }
-                metricLabel += " ribbon constrained";
-                myMetricOut->setColumnName(thisCol, metricLabel);
-#pragma omp CARET_PARFOR schedule(dynamic)
-                for (int64_t node = 0; node < numNodes; ++node)
-                {
-                    myScratch[node] = 0.0f;
-                    float totalWeight = 0.0f;
-                    int numVoxels = (int)myWeights[node].size();
-                    for (int voxel = 0; voxel < numVoxels; ++voxel)
-                    {
-                        float thisWeight = myWeights[node][voxel].weight;
-                        totalWeight += thisWeight;
-                        myScratch[node] += thisWeight * myVolume->getValue(myWeights[node][voxel].ijk, i, j);
-                    }
-                    if (totalWeight != 0.0f)
-                    {
-                        myScratch[node] /= totalWeight;
-                    } else {
-                        myScratch[node] = 0.0f;
-                    }
-                }
-                myMetricOut->setValuesForColumn(thisCol, myScratch);
-            }
+            myWeights.writeCache(weightsCacheFile, cacheKey);
         }
-    } else {
-        for (int64_t j = 0; j < myVolDims[4]; ++j)
+    }
+    if (weightsOut != NULL)
+    {
+        weightsOut->setValueAllVoxels(0.0f);
+        for (int64_t entry = myWeights.m_offsets[weightsOutVertex]; entry < myWeights.m_offsets[weightsOutVertex + 1]; ++entry)
         {
-            AString metricLabel = myVolume->getMapName(mySubVol);
-            if (myVolDims[4] != 1)
-            {
-                metricLabel += " component " + AString::number(j);
-            }
-            metricLabel += " ribbon constrained";
-            int64_t thisCol = j;
-            myMetricOut->setColumnName(thisCol, metricLabel);
-#pragma omp CARET_PARFOR schedule(dynamic)
-            for (int64_t node = 0; node < numNodes; ++node)
-            {
-                    myScratch[node] = 0.0f;
-                    float totalWeight = 0.0f;
-                    int numVoxels = (int)myWeights[node].size();
-                    for (int voxel = 0; voxel < numVoxels; ++voxel)
-                    {
-                        float thisWeight = myWeights[node][voxel].weight;
-                        totalWeight += thisWeight;
-                        myScratch[node] += thisWeight * myVolume->getValue(myWeights[node][voxel].ijk, mySubVol, j);
-                    }
-                    if (totalWeight != 0.0f)
-                    {
-                        myScratch[node] /= totalWeight;
-                    } else {
-                        myScratch[node] = 0.0f;
-                    }
-            }
-            myMetricOut->setValuesForColumn(thisCol, myScratch);
+            int64_t index = myWeights.m_voxelIndices[entry];
+            int64_t ijk[3] = { index % myVolDims[0], (index / myVolDims[0]) % myVolDims[1], index / (myVolDims[0] * myVolDims[1]) };
+            weightsOut->setValue(myWeights.m_weights[entry], ijk);
         }
     }
+    mapWithWeights(myWeights, myVolume, myMetricOut, mySubVol, " ribbon constrained");
 }
 
 //myelin style mapping
 AlgorithmVolumeToSurfaceMapping::AlgorithmVolumeToSurfaceMapping(ProgressObject* myProgObj, const VolumeFile* myVolume, const SurfaceFile* mySurface, MetricFile* myMetricOut,
-                                                                 const VolumeFile* roiVol, const MetricFile* thickness, const float& sigma, const int64_t& mySubVol): AbstractAlgorithm(myProgObj)
+                                                                 const VolumeFile* roiVol, const MetricFile* thickness, const float& sigma, const int64_t& mySubVol): AbstractAlgorithm(myProgObj, getCommandSwitch())
 {
     LevelProgress myProgress(myProgObj);
     vector<int64_t> myVolDims;
@@ -485,60 +467,244 @@ AlgorithmVolumeToSurfaceMapping::AlgorithmVolumeToSurfaceMapping(ProgressObject*
     int64_t numNodes = mySurface->getNumberOfNodes();
     myMetricOut->setNumberOfNodesAndColumns(numNodes, numColumns);
     myMetricOut->setStructure(mySurface->getStructure());
-    vector<vector<VoxelWeight> > myWeights;
-    precomputeWeightsMyelin(myWeights, mySurface, roiVol, thickness, sigma);
-    vector<float> myScratch(numNodes);
+    vector<vector<VoxelWeight> > weightLists;
+    precomputeWeightsMyelin(weightLists, mySurface, roiVol, thickness, sigma);
+    VoxelWeightMatrix myWeights;
+    myWeights.setFromLists(weightLists, myVolDims, false);//weights have already been normalized in precompute, for this method
+    weightLists.clear();
+    mapWithWeights(myWeights, myVolume, myMetricOut, mySubVol, " ribbon constrained");
+}
+
+void AlgorithmVolumeToSurfaceMapping::mapWithWeights(const VoxelWeightMatrix& myWeights, const VolumeFile* myVolume, MetricFile* myMetricOut, const int64_t& mySubVol, const AString& methodName)
+{
+    vector<int64_t> myVolDims;
+    myVolume->getDimensions(myVolDims);
+    int64_t numNodes = myWeights.getNumberOfNodes();
+    vector<int64_t> colBricks, colComponents;//frame that each output column comes from
     if (mySubVol == -1)
     {
         for (int64_t i = 0; i < myVolDims[3]; ++i)
         {
             for (int64_t j = 0; j < myVolDims[4]; ++j)
             {
-                int64_t thisCol = i * myVolDims[4] + j;
-                AString metricLabel = myVolume->getMapName(i);
-                if (myVolDims[4] != 1)
-                {
-                    metricLabel += " component " + AString::number(j);
-                }
-                metricLabel += " ribbon constrained";
-                myMetricOut->setColumnName(thisCol, metricLabel);
-#pragma omp CARET_PARFOR schedule(dynamic)
-                for (int64_t node = 0; node < numNodes; ++node)
-                {
-                    double accum = 0.0;
-                    int numVoxels = (int)myWeights[node].size();
-                    for (int voxel = 0; voxel < numVoxels; ++voxel)
-                    {
-                        accum += myWeights[node][voxel].weight * myVolume->getValue(myWeights[node][voxel].ijk, i, j);//weights have already been normalized in precompute, for this method
-                    }
-                    myScratch[node] = accum;
-                }
-                myMetricOut->setValuesForColumn(thisCol, myScratch.data());
+                colBricks.push_back(i);
+                colComponents.push_back(j);
             }
         }
     } else {
         for (int64_t j = 0; j < myVolDims[4]; ++j)
         {
-            AString metricLabel = myVolume->getMapName(mySubVol);
-            if (myVolDims[4] != 1)
+            colBricks.push_back(mySubVol);
+            colComponents.push_back(j);
+        }
+    }
+    int64_t numColumns = (int64_t)colBricks.size();
+    for (int64_t col = 0; col < numColumns; ++col)
+    {
+        AString metricLabel = myVolume->getMapName(colBricks[col]);
+        if (myVolDims[4] != 1)
+        {
+            metricLabel += " component " + AString::number(colComponents[col]);
+        }
+        metricLabel += methodName;
+        myMetricOut->setColumnName(col, metricLabel);
+    }
+    vector<vector<float> > myScratch(min(FRAME_BLOCK, numColumns), vector<float>(numNodes));
+    vector<const float*> frames;
+    vector<float*> outputs;
+    for (int64_t base = 0; base < numColumns; base += FRAME_BLOCK)
+    {//one pass over the weights per block of frames, rather than per frame
+        int64_t blockCount = min(FRAME_BLOCK, numColumns - base);
+        frames.resize(blockCount);
+        outputs.resize(blockCount);
+        for (int64_t b = 0; b < blockCount; ++b)
+        {
+            frames[b] = myVolume->getFrame(colBricks[base + b], colComponents[base + b]);
+            outputs[b] = myScratch[b].data();
+        }
+        myWeights.mapFrames(frames, outputs);
+        for (int64_t b = 0; b < blockCount; ++b)
+        {
+            myMetricOut->setValuesForColumn(base + b, outputs[b]);
+        }
+    }
+}
+
+uint64_t AlgorithmVolumeToSurfaceMapping::computeRibbonCacheKey(const VolumeFile* myVol, const SurfaceFile* innerSurf, const SurfaceFile* outerSurf, const VolumeFile* roiVol, const int& numDivisions)
+{
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    vector<int64_t> myDims;
+    myVol->getDimensions(myDims);
+    hashBytes(hash, myDims.data(), 3 * sizeof(int64_t));
+    const vector<vector<float> >& myVolSpace = myVol->getSform();
+    for (int i = 0; i < 3; ++i)
+    {
+        hashBytes(hash, myVolSpace[i].data(), 4 * sizeof(float));
+    }
+    int32_t numNodes = innerSurf->getNumberOfNodes(), numTris = innerSurf->getNumberOfTriangles();
+    hashBytes(hash, &numNodes, sizeof(int32_t));
+    hashBytes(hash, &numTris, sizeof(int32_t));
+    hashBytes(hash, innerSurf->getCoordinateData(), numNodes * 3 * sizeof(float));
+    hashBytes(hash, outerSurf->getCoordinateData(), numNodes * 3 * sizeof(float));
+    if (numTris > 0)
+    {
+        hashBytes(hash, innerSurf->getTriangle(0), numTris * 3 * sizeof(int32_t));//the polyhedra use the inner surface's topology
+    }
+    hashBytes(hash, &numDivisions, sizeof(int));
+    int32_t haveRoi = (roiVol != NULL ? 1 : 0);
+    hashBytes(hash, &haveRoi, sizeof(int32_t));
+    if (roiVol != NULL)
+    {
+        hashBytes(hash, roiVol->getFrame(), myDims[0] * myDims[1] * myDims[2] * sizeof(float));
+    }
+    return hash;
+}
+
+void VoxelWeightMatrix::setFromLists(const vector<vector<VoxelWeight> >& weightLists, const vector<int64_t>& dims, const bool& normalize)
+{
+    int64_t numNodes = (int64_t)weightLists.size();
+    m_offsets.resize(numNodes + 1);
+    m_offsets[0] = 0;
+    for (int64_t node = 0; node < numNodes; ++node)
+    {
+        m_offsets[node + 1] = m_offsets[node] + (int64_t)weightLists[node].size();
+    }
+    m_voxelIndices.resize(m_offsets[numNodes]);
+    m_weights.resize(m_offsets[numNodes]);
+#pragma omp CARET_PARFOR schedule(dynamic, 256)
+    for (int64_t node = 0; node < numNodes; ++node)
+    {
+        int64_t numVoxels = (int64_t)weightLists[node].size();
+        for (int64_t voxel = 0; voxel < numVoxels; ++voxel)
+        {
+            const VoxelWeight& thisWeight = weightLists[node][voxel];
+            int64_t entry = m_offsets[node] + voxel;
+            m_voxelIndices[entry] = thisWeight.ijk[0] + dims[0] * (thisWeight.ijk[1] + dims[1] * thisWeight.ijk[2]);
+            m_weights[entry] = thisWeight.weight;
+        }
+    }
+    computeScales(normalize);
+}
+
+void VoxelWeightMatrix::computeScales(const bool& normalize)
+{
+    int64_t numNodes = (int64_t)m_offsets.size() - 1;
+    m_scales.resize(numNodes);
+    for (int64_t node = 0; node < numNodes; ++node)
+    {
+        if (!normalize)
+        {
+            m_scales[node] = 1.0f;
+            continue;
+        }
+        float totalWeight = 0.0f;
+        for (int64_t entry = m_offsets[node]; entry < m_offsets[node + 1]; ++entry)
+        {
+            totalWeight += m_weights[entry];
+        }
+        if (totalWeight != 0.0f)
+        {
+            m_scales[node] = 1.0f / totalWeight;
+        } else {
+            m_scales[node] = 0.0f;
+        }
+    }
+}
+
+bool VoxelWeightMatrix::readCache(const AString& fileName, const uint64_t& key, const int64_t& numNodes, const int64_t& frameSize)
+{
+    if (!QFile::exists(fileName)) return false;
+    try
+    {
+        CaretBinaryFile myFile(fileName);
+        char magic[8];
+        myFile.read(magic, 8);
+        if (memcmp(magic, WEIGHTS_CACHE_MAGIC, 8) != 0) return false;
+        uint64_t fileKey;//also rejects files written with the other byte order
+        int64_t fileNodes, numEntries;
+        myFile.read(&fileKey, sizeof(uint64_t));
+        myFile.read(&fileNodes, sizeof(int64_t));
+        myFile.read(&numEntries, sizeof(int64_t));
+        if (fileKey != key || fileNodes != numNodes || numEntries < 0) return false;
+        m_offsets.resize(numNodes + 1);
+        myFile.read(m_offsets.data(), (numNodes + 1) * sizeof(int64_t));
+        if (m_offsets[0] != 0 || m_offsets[numNodes] != numEntries) return false;
+        for (int64_t node = 0; node < numNodes; ++node)
+        {
+            if (m_offsets[node + 1] < m_offsets[node]) return false;
+        }
+        m_voxelIndices.resize(numEntries);
+        m_weights.resize(numEntries);
+        if (numEntries > 0)
+        {
+            myFile.read(m_voxelIndices.data(), numEntries * sizeof(int64_t));
+            myFile.read(m_weights.data(), numEntries * sizeof(float));
+        }
+        for (int64_t entry = 0; entry < numEntries; ++entry)
+        {
+            if (m_voxelIndices[entry] < 0 || m_voxelIndices[entry] >= frameSize) return false;
+        }
+    } catch (CaretException& e) {//unreadable or truncated, just recompute
+        return false;
+    }
+    computeScales(true);
+    return true;
+}
+
+void VoxelWeightMatrix::writeCache(const AString& fileName, const uint64_t& key) const
+{
+    int64_t numNodes = (int64_t)m_offsets.size() - 1, numEntries = (int64_t)m_weights.size();
+    try
+    {
+        CaretBinaryFile myFile(fileName, CaretBinaryFile::WRITE_TRUNCATE);
+        myFile.write(WEIGHTS_CACHE_MAGIC, 8);
+        myFile.write(&key, sizeof(uint64_t));
+        myFile.write(&numNodes, sizeof(int64_t));
+        myFile.write(&numEntries, sizeof(int64_t));
+        myFile.write(m_offsets.data(), (numNodes + 1) * sizeof(int64_t));
+        if (numEntries > 0)
+        {
+            myFile.write(m_voxelIndices.data(), numEntries * sizeof(int64_t));
+            myFile.write(m_weights.data(), numEntries * sizeof(float));
+        }
+    } catch (CaretException& e) {//the cache only saves time, so the mapping still succeeds
+        CaretLogWarning("failed to write weights cache '" + fileName + "': " + e.whatString());
+        QFile::remove(fileName);//don't leave a partial file, even though reading would reject it
+    }
+}
+
+void VoxelWeightMatrix::mapFrames(const vector<const float*>& frames, const vector<float*>& outputs) const
+{
+    CaretAssert(frames.size() == outputs.size());
+    int64_t numFrames = (int64_t)frames.size();
+    int64_t numNodes = getNumberOfNodes();
+    for (int64_t base = 0; base < numFrames; base += FRAME_BLOCK)
+    {
+        const int64_t blockCount = min(FRAME_BLOCK, numFrames - base);
+        const float* const* blockFrames = frames.data() + base;
+        float* const* blockOutputs = outputs.data() + base;
+#pragma omp CARET_PARFOR schedule(dynamic, 64)
+        for (int64_t node = 0; node < numNodes; ++node)
+        {
+            double accum[FRAME_BLOCK];
+            for (int64_t b = 0; b < blockCount; ++b)
             {
-                metricLabel += " component " + AString::number(j);
+                accum[b] = 0.0;
             }
-            metricLabel += " ribbon constrained";
-            int64_t thisCol = j;
-            myMetricOut->setColumnName(thisCol, metricLabel);
-#pragma omp CARET_PARFOR schedule(dynamic)
-            for (int64_t node = 0; node < numNodes; ++node)
-            {
-                double accum = 0.0;
-                int numVoxels = (int)myWeights[node].size();
-                for (int voxel = 0; voxel < numVoxels; ++voxel)
+            const int64_t entryEnd = m_offsets[node + 1];
+            for (int64_t entry = m_offsets[node]; entry < entryEnd; ++entry)
+            {//each index and weight is loaded once for the whole block of frames
+                const int64_t index = m_voxelIndices[entry];
+                const double weight = m_weights[entry];
+                for (int64_t b = 0; b < blockCount; ++b)
                 {
-                    accum += myWeights[node][voxel].weight * myVolume->getValue(myWeights[node][voxel].ijk, mySubVol, j);//weights have already been normalized in precompute, for this method
+                    accum[b] += weight * blockFrames[b][index];
                 }
-                myScratch[node] = accum;
             }
-            myMetricOut->setValuesForColumn(thisCol, myScratch.data());
+            for (int64_t b = 0; b < blockCount; ++b)
+            {
+                blockOutputs[b][node] = (float)(accum[b] * m_scales[node]);
+            }
         }
     }
 }
@@ -44,6 +44,20 @@ namespace caret {
         }
     };
     
+    struct VoxelWeightMatrix
+    {//compressed per-vertex weights, so that all frames can be mapped through them in blocks, and so they can be cached between runs
+        std::vector<int64_t> m_offsets;//numNodes + 1 entries, start of each vertex's weights
+        std::vector<int64_t> m_voxelIndices;//index within a single frame
+        std::vector<float> m_weights;
+        std::vector<float> m_scales;//per vertex multiplier for the weighted sum, 1 / total weight if normalizing
+        void setFromLists(const std::vector<std::vector<VoxelWeight> >& weightLists, const std::vector<int64_t>& dims, const bool& normalize);
+        void computeScales(const bool& normalize);
+        int64_t getNumberOfNodes() const { return (int64_t)m_scales.size(); }
+        bool readCache(const AString& fileName, const uint64_t& key, const int64_t& numNodes, const int64_t& frameSize);//returns false if missing, unreadable, or made from different inputs
+        void writeCache(const AString& fileName, const uint64_t& key) const;//logs a warning if the file can't be written
+        void mapFrames(const std::vector<const float*>& frames, const std::vector<float*>& outputs) const;//each output is numNodes long
+    };
+    
     struct TriInfo
     {
         Vector3D m_xyz[3];
@@ -75,6 +89,8 @@ namespace caret {
         void precomputeWeightsRibbon(std::vector<std::vector<VoxelWeight> >& myWeights, const VolumeFile* myVol, const SurfaceFile* innerSurf, const SurfaceFile* outerSurf, const VolumeFile* roiVol, const int& numDivisions);//surfaces MUST be in node correspondence, otherwise SEVERE strangeness, possible crashes
         float computeVoxelFraction(const VolumeFile* myVolume, const int64_t* ijk, PolyInfo& myPoly, const int divisions, const Vector3D& ivec, const Vector3D& jvec, const Vector3D& kvec);
         void precomputeWeightsMyelin(std::vector<std::vector<VoxelWeight> >& myWeights, const SurfaceFile* mySurface, const VolumeFile* roiVol, const MetricFile* thickness, const float& sigma);
+        static uint64_t computeRibbonCacheKey(const VolumeFile* myVol, const SurfaceFile* innerSurf, const SurfaceFile* outerSurf, const VolumeFile* roiVol, const int& numDivisions);
+        void mapWithWeights(const VoxelWeightMatrix& myWeights, const VolumeFile* myVolume, MetricFile* myMetricOut, const int64_t& mySubVol, const AString& methodName);
         enum Method
         {
             TRILINEAR,
@@ -91,7 +107,7 @@ namespace caret {
                                         const int64_t& mySubVol = -1);
         AlgorithmVolumeToSurfaceMapping(ProgressObject* myProgObj, const VolumeFile* myVolume, const SurfaceFile* mySurface, MetricFile* myMetricOut,
                                         const SurfaceFile* innerSurf, const SurfaceFile* outerSurf, const VolumeFile* roiVol = NULL, const int32_t& subdivisions = 3,
-                                        const int64_t& mySubVol = -1, const int& weightsOutVertex = -1, VolumeFile* weightsOut = NULL);
+                                        const int64_t& mySubVol = -1, const int& weightsOutVertex = -1, VolumeFile* weightsOut = NULL, const AString& weightsCacheFile = "");
         AlgorithmVolumeToSurfaceMapping(ProgressObject* myProgObj, const VolumeFile* myVolume, const SurfaceFile* mySurface, MetricFile* myMetricOut,
                                         const VolumeFile* roiVol, const MetricFile* thickness, const float& sigma, const int64_t& mySubVol = -1);
         static OperationParameters* getParameters();
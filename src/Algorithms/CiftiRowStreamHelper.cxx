@@ -0,0 +1,202 @@
+/*LICENSE_START*/
+/*
+ *  Copyright (C) 2014  Washington University School of Medicine
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+/*LICENSE_END*/
+
+#include "CiftiRowStreamHelper.h"
+
+#include "AlgorithmException.h"
+#include "CaretAssert.h"
+#include "CaretException.h"
+#include "CaretOMP.h"
+#include "CiftiFile.h"
+
+#include <QThread>
+
+#include <algorithm>
+#include <exception>
+#include <vector>
+
+using namespace caret;
+using namespace std;
+
+int64_t CiftiRowStreamHelper::s_memoryBudget = ((int64_t)1) << 29;//512MB, enough for large blocks of dconn rows
+
+namespace
+{
+    ///one step of the background file access: write the previous output block, then read the next input block
+    class RowBlockIOThread : public QThread
+    {
+        const CiftiFile* m_input;
+        CiftiFile* m_output;
+        const float* m_writeRows;
+        float* m_readRows;
+        int64_t m_writeStart, m_writeCount, m_readStart, m_readCount;
+        AString m_error;
+    public:
+        RowBlockIOThread(const CiftiFile* input, CiftiFile* output)
+        {
+            m_input = input;
+            m_output = output;
+            m_writeRows = NULL;
+            m_readRows = NULL;
+            m_writeStart = 0;
+            m_writeCount = 0;
+            m_readStart = 0;
+            m_readCount = 0;
+        }
+        void setWrite(const float* rows, const int64_t& start, const int64_t& count)
+        {
+            m_writeRows = rows;
+            m_writeStart = start;
+            m_writeCount = count;
+        }
+        void setRead(float* rows, const int64_t& start, const int64_t& count)
+        {
+            m_readRows = rows;
+            m_readStart = start;
+            m_readCount = count;
+        }
+        void checkError() const
+        {
+            if (!m_error.isEmpty()) throw AlgorithmException(m_error);
+        }
+    protected:
+        void run()
+        {//exceptions can't cross threads, so save the message for checkError()
+            try
+            {
+                if (m_writeCount > 0) m_output->setRows(m_writeRows, m_writeStart, m_writeCount);
+                if (m_readCount > 0) m_input->getRows(m_readRows, m_readStart, m_readCount);
+            } catch (CaretException& e) {
+                m_error = e.whatString();
+            } catch (exception& e) {
+                m_error = e.what();
+            }
+        }
+    };
+}
+
+int64_t CiftiRowStreamHelper::BlockFunction::getExtraBytesPerRow(const int64_t&, const int64_t&) const
+{
+    return 0;
+}
+
+CiftiRowStreamHelper::BlockFunction::~BlockFunction()
+{
+}
+
+void CiftiRowStreamHelper::RowFunction::processBlock(const float* inRows, const int64_t& inRowLength, float* outRows, const int64_t& outRowLength,
+                                                     const int64_t& startRow, const int64_t& numRows)
+{
+    AString error;
+    bool failed = false;
+#pragma omp CARET_PARFOR schedule(dynamic)
+    for (int64_t i = 0; i < numRows; ++i)
+    {
+        try
+        {
+            processRow(inRows + i * inRowLength, inRowLength, outRows + i * outRowLength, outRowLength, startRow + i);
+        } catch (CaretException& e) {//exceptions can't leave a parallel region, report the first one after it
+#pragma omp critical
+            {
+                if (!failed) error = e.whatString();
+                failed = true;
+            }
+        } catch (exception& e) {
+#pragma omp critical
+            {
+                if (!failed) error = e.what();
+                failed = true;
+            }
+        }
+    }
+    if (failed) throw AlgorithmException(error);
+}
+
+int64_t CiftiRowStreamHelper::getBlockRows(const int64_t& numRows, const int64_t& inRowLength, const int64_t& outRowLength, const int64_t& extraBytesPerRow)
+{
+    int64_t bytesPerRow = 2 * (inRowLength + outRowLength) * (int64_t)sizeof(float) + extraBytesPerRow;//two input and two output blocks are allocated at once
+    int64_t ret = s_memoryBudget / max((int64_t)1, bytesPerRow);
+    return max((int64_t)1, min(numRows, ret));
+}
+
+void CiftiRowStreamHelper::setMemoryBudget(const int64_t& bytes)
+{
+    CaretAssert(bytes > 0);
+    s_memoryBudget = bytes;
+}
+
+void CiftiRowStreamHelper::streamRows(const CiftiFile* input, CiftiFile* output, BlockFunction* function)
+{
+    const vector<int64_t>& inDims = input->getDimensions();
+    const vector<int64_t>& outDims = output->getDimensions();
+    if (inDims.size() != 2 || outDims.size() != 2) throw AlgorithmException("row streaming only supports 2D cifti files");
+    if (inDims[1] != outDims[1]) throw AlgorithmException("row streaming requires the output to have the same number of rows as the input");
+    const int64_t inRowLength = inDims[0], outRowLength = outDims[0], numRows = inDims[1];
+    if (numRows < 1) return;
+    const int64_t blockRows = getBlockRows(numRows, inRowLength, outRowLength, function->getExtraBytesPerRow(inRowLength, outRowLength));
+    const int64_t numBlocks = (numRows + blockRows - 1) / blockRows;
+    if (numBlocks == 1)
+    {//nothing to overlap
+        vector<float> inRows(numRows * inRowLength), outRows(numRows * outRowLength);
+        input->getRows(inRows.data(), 0, numRows);
+        function->processBlock(inRows.data(), inRowLength, outRows.data(), outRowLength, 0, numRows);
+        output->setRows(outRows.data(), 0, numRows);
+        return;
+    }
+    vector<float> inBlocks[2], outBlocks[2];
+    for (int i = 0; i < 2; ++i)
+    {
+        inBlocks[i].resize(blockRows * inRowLength);
+        outBlocks[i].resize(blockRows * outRowLength);
+    }
+    input->getRows(inBlocks[0].data(), 0, blockRows);
+    RowBlockIOThread ioThread(input, output);
+    for (int64_t block = 0; block < numBlocks; ++block)
+    {
+        const int cur = block % 2, other = 1 - cur;
+        const int64_t start = block * blockRows, count = min(blockRows, numRows - start);
+        if (block > 0)
+        {//all blocks but the last are full size
+            ioThread.setWrite(outBlocks[other].data(), start - blockRows, blockRows);
+        } else {
+            ioThread.setWrite(NULL, 0, 0);
+        }
+        if (block + 1 < numBlocks)
+        {
+            ioThread.setRead(inBlocks[other].data(), start + blockRows, min(blockRows, numRows - start - blockRows));
+        } else {
+            ioThread.setRead(NULL, 0, 0);
+        }
+        ioThread.start();
+        try
+        {
+            function->processBlock(inBlocks[cur].data(), inRowLength, outBlocks[cur].data(), outRowLength, start, count);
+        } catch (...) {//don't destroy the buffers while the thread is still using them
+            ioThread.wait();
+            throw;
+        }
+        ioThread.wait();
+        ioThread.checkError();
+        if (block + 1 == numBlocks)
+        {
+            output->setRows(outBlocks[cur].data(), start, count);
+        }
+    }
+}
@@ -0,0 +1,73 @@
+#ifndef __CIFTI_ROW_STREAM_HELPER_H__
+#define __CIFTI_ROW_STREAM_HELPER_H__
+
+/*LICENSE_START*/
+/*
+ *  Copyright (C) 2014  Washington University School of Medicine
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+/*LICENSE_END*/
+
+#include <stdint.h>
+
+namespace caret {
+    
+    class CiftiFile;
+    
+    ///runs a row-independent computation through a 2D cifti file one block of rows at a time, reading the next block and writing the previous one in the background, so memory use stays within the memory budget regardless of file size
+    class CiftiRowStreamHelper
+    {
+        static int64_t s_memoryBudget;
+        CiftiRowStreamHelper();
+    public:
+        ///computes a block of output rows from the same rows of the input, called on the thread that called streamRows, so it can use OpenMP internally
+        class BlockFunction
+        {
+        public:
+            virtual void processBlock(const float* inRows, const int64_t& inRowLength, float* outRows, const int64_t& outRowLength,
+                                      const int64_t& startRow, const int64_t& numRows) = 0;
+            
+            ///working memory needed for each row of a block, in addition to the input and output rows, so it can be counted against the budget
+            virtual int64_t getExtraBytesPerRow(const int64_t& inRowLength, const int64_t& outRowLength) const;
+            
+            virtual ~BlockFunction();
+        };
+        
+        ///computes one output row from the same input row, called for different rows from multiple threads at once, exceptions are rethrown after the block
+        class RowFunction : public BlockFunction
+        {
+        public:
+            void processBlock(const float* inRows, const int64_t& inRowLength, float* outRows, const int64_t& outRowLength,
+                              const int64_t& startRow, const int64_t& numRows);
+            
+            virtual void processRow(const float* inRow, const int64_t& inRowLength, float* outRow, const int64_t& outRowLength, const int64_t& row) = 0;
+        };
+        
+        ///the output must already have its xml set, with the same number of rows as the input
+        static void streamRows(const CiftiFile* input, CiftiFile* output, BlockFunction* function);
+        
+        ///number of rows per block when input and output blocks are double buffered within the memory budget
+        static int64_t getBlockRows(const int64_t& numRows, const int64_t& inRowLength, const int64_t& outRowLength, const int64_t& extraBytesPerRow);
+        
+        ///applies to all streaming, set from the -stream-mem-limit global option
+        static void setMemoryBudget(const int64_t& bytes);
+        
+        static int64_t getMemoryBudget() { return s_memoryBudget; }
+    };
+    
+}
+
+#endif //__CIFTI_ROW_STREAM_HELPER_H__
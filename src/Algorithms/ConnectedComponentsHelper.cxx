@@ -0,0 +1,185 @@
+/*LICENSE_START*/
+/*
+ *  Copyright (C) 2014  Washington University School of Medicine
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+/*LICENSE_END*/
+
+#include "ConnectedComponentsHelper.h"
+
+#include "CaretAssert.h"
+#include "CaretOMP.h"
+#include "SurfaceFile.h"
+#include "TopologyHelper.h"
+
+#include <algorithm>
+#include <utility>
+
+using namespace caret;
+using namespace std;
+
+namespace
+{
+    //roots are always the smallest index of their tree, so a root's final label doesn't depend on the order of merges
+    int64_t findRoot(vector<int64_t>& parent, int64_t index)
+    {
+        while (parent[index] != index)
+        {
+            parent[index] = parent[parent[index]];//path halving
+            index = parent[index];
+        }
+        return index;
+    }
+    
+    void unite(vector<int64_t>& parent, const int64_t& first, const int64_t& second)
+    {
+        int64_t root1 = findRoot(parent, first), root2 = findRoot(parent, second);
+        if (root1 < root2)
+        {
+            parent[root2] = root1;
+        } else if (root2 < root1) {
+            parent[root1] = root2;
+        }
+    }
+    
+    const int64_t MIN_BLOCK_SIZE = 16384;//don't bother splitting small inputs
+}
+
+ConnectedComponentsHelper::ConnectedComponentsHelper(const SurfaceFile* mySurf)
+{
+    m_isGrid = false;
+    m_dims[0] = 0; m_dims[1] = 0; m_dims[2] = 0;
+    m_numElements = mySurf->getNumberOfNodes();
+    CaretPointer<TopologyHelper> myTopoHelp = mySurf->getTopologyHelper();
+    m_lowerStart.resize(m_numElements + 1);
+    m_lowerStart[0] = 0;
+    for (int64_t i = 0; i < m_numElements; ++i)
+    {
+        const vector<int32_t>& neighbors = myTopoHelp->getNodeNeighbors(i);
+        int numNeigh = (int)neighbors.size();
+        for (int n = 0; n < numNeigh; ++n)
+        {
+            if (neighbors[n] < i)
+            {
+                m_lowerNeighbors.push_back(neighbors[n]);
+            }
+        }
+        m_lowerStart[i + 1] = (int64_t)m_lowerNeighbors.size();
+    }
+}
+
+ConnectedComponentsHelper::ConnectedComponentsHelper(const vector<int64_t>& dims)
+{
+    CaretAssert(dims.size() >= 3);
+    m_isGrid = true;
+    m_numElements = 1;
+    for (int i = 0; i < 3; ++i)
+    {
+        m_dims[i] = dims[i];
+        m_numElements *= dims[i];
+    }
+}
+
+int64_t ConnectedComponentsHelper::getLowerNeighbors(const int64_t& index, int64_t neighborsOut[3]) const
+{
+    int64_t ret = 0;
+    int64_t i = index % m_dims[0], j = (index / m_dims[0]) % m_dims[1], k = index / (m_dims[0] * m_dims[1]);
+    if (i > 0) neighborsOut[ret++] = index - 1;
+    if (j > 0) neighborsOut[ret++] = index - m_dims[0];
+    if (k > 0) neighborsOut[ret++] = index - m_dims[0] * m_dims[1];
+    return ret;
+}
+
+void ConnectedComponentsHelper::findComponents(const char* marked, const float* weights, vector<int64_t>& labelsOut, vector<double>& sizesOut) const
+{
+    vector<int64_t> parent(m_numElements);
+    int numBlocks = 1;
+#ifdef CARET_OMP
+    numBlocks = (int)max((int64_t)1, min((int64_t)omp_get_max_threads(), m_numElements / MIN_BLOCK_SIZE));
+#endif
+    vector<vector<pair<int64_t, int64_t> > > crossEdges(numBlocks);
+    //label each contiguous block of indices separately, edges to earlier blocks are saved for merging afterwards
+#pragma omp CARET_PARFOR schedule(static, 1)
+    for (int b = 0; b < numBlocks; ++b)
+    {
+        int64_t start = m_numElements * b / numBlocks, end = m_numElements * (b + 1) / numBlocks;
+        vector<pair<int64_t, int64_t> >& crossRef = crossEdges[b];
+        int64_t gridNeighbors[3];
+        for (int64_t i = start; i < end; ++i)
+        {
+            parent[i] = i;
+            if (!marked[i]) continue;
+            const int64_t* neighbors = gridNeighbors;
+            int64_t numNeigh;
+            if (m_isGrid)
+            {
+                numNeigh = getLowerNeighbors(i, gridNeighbors);
+            } else {
+                neighbors = m_lowerNeighbors.data() + m_lowerStart[i];
+                numNeigh = m_lowerStart[i + 1] - m_lowerStart[i];
+            }
+            for (int64_t n = 0; n < numNeigh; ++n)
+            {
+                int64_t neighbor = neighbors[n];
+                if (!marked[neighbor]) continue;
+                if (neighbor >= start)
+                {
+                    unite(parent, i, neighbor);
+                } else {
+                    crossRef.push_back(make_pair(i, neighbor));
+                }
+            }
+        }
+    }
+    for (int b = 1; b < numBlocks; ++b)//merging is cheap, the number of edges between blocks is small compared to the whole
+    {
+        const vector<pair<int64_t, int64_t> >& crossRef = crossEdges[b];
+        for (int64_t e = 0; e < (int64_t)crossRef.size(); ++e)
+        {
+            unite(parent, crossRef[e].first, crossRef[e].second);
+        }
+    }
+    labelsOut.resize(m_numElements);
+    sizesOut.clear();
+    vector<int64_t> rootToComponent(m_numElements);//only filled in at roots
+    for (int64_t i = 0; i < m_numElements; ++i)
+    {
+        if (marked[i] && parent[i] == i)
+        {
+            rootToComponent[i] = (int64_t)sizesOut.size();
+            sizesOut.push_back(0.0);
+        }
+    }
+#pragma omp CARET_PARFOR schedule(static, MIN_BLOCK_SIZE)
+    for (int64_t i = 0; i < m_numElements; ++i)
+    {
+        if (marked[i])
+        {
+            int64_t root = i;
+            while (parent[root] != root) root = parent[root];//no compression, other threads are reading
+            labelsOut[i] = rootToComponent[root];
+        } else {
+            labelsOut[i] = -1;
+        }
+    }
+    for (int64_t i = 0; i < m_numElements; ++i)
+    {
+        if (labelsOut[i] != -1)
+        {
+            sizesOut[labelsOut[i]] += (weights == NULL ? 1.0 : weights[i]);
+        }
+    }
+}
@@ -0,0 +1,58 @@
+#ifndef __CONNECTED_COMPONENTS_HELPER_H__
+#define __CONNECTED_COMPONENTS_HELPER_H__
+
+/*LICENSE_START*/
+/*
+ *  Copyright (C) 2014  Washington University School of Medicine
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+/*LICENSE_END*/
+
+#include <stdint.h>
+#include <vector>
+
+namespace caret {
+    
+    class SurfaceFile;
+    
+    ///parallel union-find labeling of the connected components of marked vertices or voxels, set up once and reused for any number of maps
+    class ConnectedComponentsHelper
+    {
+        int64_t m_numElements;
+        std::vector<int64_t> m_lowerStart;//compressed sparse row lists of each surface vertex's neighbors with a smaller index, empty for a voxel grid
+        std::vector<int64_t> m_lowerNeighbors;
+        int64_t m_dims[3];//voxel grid, 6-connected
+        bool m_isGrid;
+        
+        int64_t getLowerNeighbors(const int64_t& index, int64_t neighborsOut[3]) const;//grid only
+        ConnectedComponentsHelper();
+    public:
+        ///vertices are connected by the edges of the surface
+        explicit ConnectedComponentsHelper(const SurfaceFile* mySurf);
+        
+        ///voxels are connected to their 6 face neighbors, in the index order of a volume frame
+        explicit ConnectedComponentsHelper(const std::vector<int64_t>& dims);
+        
+        int64_t getNumberOfElements() const { return m_numElements; }
+        
+        ///component index of each marked element, -1 for unmarked, components are numbered in order of their smallest element index
+        ///sizesOut is the sum of weights of each component, or the number of elements if weights is NULL
+        void findComponents(const char* marked, const float* weights, std::vector<int64_t>& labelsOut, std::vector<double>& sizesOut) const;
+    };
+    
+}
+
+#endif //__CONNECTED_COMPONENTS_HELPER_H__
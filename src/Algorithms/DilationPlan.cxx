@@ -0,0 +1,108 @@
+/*LICENSE_START*/
+/*
+ *  Copyright (C) 2014  Washington University School of Medicine
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+/*LICENSE_END*/
+
+#include "DilationPlan.h"
+
+#include "CaretAssert.h"
+#include "CaretOMP.h"
+
+using namespace caret;
+using namespace std;
+
+void DilationPlan::setTargets(const vector<int64_t>& targets, const vector<vector<pair<int64_t, float> > >& sources)
+{
+    CaretAssert(targets.size() == sources.size());
+    int64_t numTargets = (int64_t)targets.size();
+    m_targets = targets;
+    m_sourceStart.resize(numTargets + 1);
+    m_weightSums.resize(numTargets);
+    m_sources.clear();
+    m_weights.clear();
+    m_sourceStart[0] = 0;
+    for (int64_t i = 0; i < numTargets; ++i)
+    {
+        const vector<pair<int64_t, float> >& sourceRef = sources[i];
+        float weightSum = 0.0f;
+        for (int64_t j = 0; j < (int64_t)sourceRef.size(); ++j)
+        {
+            weightSum += sourceRef[j].second;
+        }
+        if (weightSum != 0.0f)//otherwise leave it empty instead of making NaNs
+        {
+            for (int64_t j = 0; j < (int64_t)sourceRef.size(); ++j)
+            {
+                m_sources.push_back(sourceRef[j].first);
+                m_weights.push_back(sourceRef[j].second);
+            }
+        }
+        m_weightSums[i] = weightSum;
+        m_sourceStart[i + 1] = (int64_t)m_sources.size();
+    }
+}
+
+void DilationPlan::apply(const vector<const float*>& inputs, const vector<float*>& outputs, const int64_t& numElements) const
+{
+    CaretAssert(inputs.size() == outputs.size());
+    int numMaps = (int)inputs.size();
+    for (int m = 0; m < numMaps; ++m)
+    {
+        CaretAssert(outputs[m] != inputs[m]);//in place would change sources before they are used
+        for (int64_t i = 0; i < numElements; ++i)
+        {
+            outputs[m][i] = inputs[m][i];
+        }
+    }
+    int64_t numTargets = (int64_t)m_targets.size();
+#pragma omp CARET_PAR
+    {
+        vector<double> accum(numMaps);
+#pragma omp CARET_FOR schedule(dynamic, 64)
+        for (int64_t i = 0; i < numTargets; ++i)
+        {
+            int64_t start = m_sourceStart[i], end = m_sourceStart[i + 1];
+            int64_t target = m_targets[i];
+            if (start == end)
+            {
+                for (int m = 0; m < numMaps; ++m)
+                {
+                    outputs[m][target] = 0.0f;
+                }
+                continue;
+            }
+            for (int m = 0; m < numMaps; ++m)
+            {
+                accum[m] = 0.0;
+            }
+            for (int64_t j = start; j < end; ++j)
+            {
+                int64_t source = m_sources[j];
+                float weight = m_weights[j];
+                for (int m = 0; m < numMaps; ++m)
+                {
+                    accum[m] += inputs[m][source] * weight;
+                }
+            }
+            for (int m = 0; m < numMaps; ++m)
+            {
+                outputs[m][target] = accum[m] / m_weightSums[i];
+            }
+        }
+    }
+}
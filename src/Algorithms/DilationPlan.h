@@ -0,0 +1,49 @@
+#ifndef __DILATION_PLAN_H__
+#define __DILATION_PLAN_H__
+
+/*LICENSE_START*/
+/*
+ *  Copyright (C) 2014  Washington University School of Medicine
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+/*LICENSE_END*/
+
+#include <stdint.h>
+#include <utility>
+#include <vector>
+
+namespace caret {
+    
+    ///the replacement of each bad location by a weighted average of good locations, computed once for a mask and applied to any number of maps with the same mask
+    class DilationPlan
+    {
+        std::vector<int64_t> m_targets;
+        std::vector<int64_t> m_sourceStart;//compressed sparse row, sources of target i are m_sources[m_sourceStart[i]] up to m_sources[m_sourceStart[i + 1]]
+        std::vector<int64_t> m_sources;
+        std::vector<float> m_weights, m_weightSums;
+    public:
+        ///each target gets the weighted average of its sources, or 0 if it has no sources or they sum to 0 weight
+        void setTargets(const std::vector<int64_t>& targets, const std::vector<std::vector<std::pair<int64_t, float> > >& sources);
+        
+        int64_t getNumberOfTargets() const { return (int64_t)m_targets.size(); }
+        
+        ///copy each input to its (separate) output, then replace the targets, the maps are processed together so each target's sources are only looked up once
+        void apply(const std::vector<const float*>& inputs, const std::vector<float*>& outputs, const int64_t& numElements) const;
+    };
+    
+}
+
+#endif //__DILATION_PLAN_H__
@@ -0,0 +1,97 @@
+/*LICENSE_START*/
+/*
+ *  Copyright (C) 2014  Washington University School of Medicine
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+/*LICENSE_END*/
+
+#include "LabelImportHelper.h"
+
+#include "AlgorithmException.h"
+#include "CaretLogger.h"
+#include "GiftiLabel.h"
+#include "GiftiLabelTable.h"
+#include "LabelKeyRemap.h"
+
+#include <cstdlib>
+
+using namespace caret;
+using namespace std;
+
+namespace
+{
+    template<typename T>
+    void translateLabelsImpl(const float* valuesIn, T* labelsOut, const int64_t& numValues, GiftiLabelTable& myTable, map<int32_t, int32_t>& translate,
+                             set<int32_t>& usedValues, const bool& dropUnused, const bool& discardOthers, const int32_t& unusedLabel)
+    {
+        vector<int32_t> foundValues = LabelKeyRemap::findKeysInOrder(valuesIn, numValues);//in order of first appearance, so new labels are made in the same order as a serial scan
+        if (dropUnused)
+        {
+            usedValues.insert(foundValues.begin(), foundValues.end());
+        }
+        if (!discardOthers)
+        {
+            LabelImportHelper::addLabelsForKeys(foundValues, myTable, translate);
+        }
+        LabelKeyRemap(translate, unusedLabel).apply(valuesIn, labelsOut, numValues);//every value is now in translate unless we are discarding the others
+    }
+}
+
+void LabelImportHelper::addLabelsForKeys(const vector<int32_t>& foundKeys, GiftiLabelTable& myTable, map<int32_t, int32_t>& translate)
+{
+    for (int i = 0; i < (int)foundKeys.size(); ++i)
+    {
+        int32_t labelval = foundKeys[i];
+        if (translate.find(labelval) != translate.end()) continue;
+        //use a random color, but fully opaque for the label
+        GiftiLabel myLabel(labelval, AString("LABEL_") + AString::number(labelval), rand() & 255, rand() & 255, rand() & 255, 255);
+        if (myTable.getLabelKeyFromName(myLabel.getName()) != GiftiLabel::getInvalidLabelKey())
+        {
+            AString nameBase = myLabel.getName(), newName;//resolve collision by generating a name with an additional number on it
+            bool success = false;
+            for (int extra = 1; extra < 100; ++extra)//but stop at 100, because really...
+            {
+                newName = nameBase + "_" + AString::number(extra);
+                if (myTable.getLabelKeyFromName(newName) == GiftiLabel::getInvalidLabelKey())
+                {
+                    success = true;
+                    break;
+                }
+            }
+            if (success)
+            {
+                CaretLogWarning("name collision in auto-generated name '" + nameBase + "', changed to '" + newName + "'");
+            } else {
+                throw AlgorithmException("giving up on resolving name collision for auto-generated name '" + nameBase + "'");
+            }
+            myLabel.setName(newName);
+        }
+        int32_t newValue = myTable.addLabel(&myLabel);//don't overwrite any values in the table
+        translate[labelval] = newValue;
+    }
+}
+
+void LabelImportHelper::translateLabels(const float* valuesIn, int32_t* labelsOut, const int64_t& numValues, GiftiLabelTable& myTable, map<int32_t, int32_t>& translate,
+                                        set<int32_t>& usedValues, const bool& dropUnused, const bool& discardOthers, const int32_t& unusedLabel)
+{
+    translateLabelsImpl(valuesIn, labelsOut, numValues, myTable, translate, usedValues, dropUnused, discardOthers, unusedLabel);
+}
+
+void LabelImportHelper::translateLabels(const float* valuesIn, float* labelsOut, const int64_t& numValues, GiftiLabelTable& myTable, map<int32_t, int32_t>& translate,
+                                        set<int32_t>& usedValues, const bool& dropUnused, const bool& discardOthers, const int32_t& unusedLabel)
+{
+    translateLabelsImpl(valuesIn, labelsOut, numValues, myTable, translate, usedValues, dropUnused, discardOthers, unusedLabel);
+}
@@ -0,0 +1,51 @@
+#ifndef __LABEL_IMPORT_HELPER_H__
+#define __LABEL_IMPORT_HELPER_H__
+
+/*LICENSE_START*/
+/*
+ *  Copyright (C) 2014  Washington University School of Medicine
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+/*LICENSE_END*/
+
+#include <map>
+#include <set>
+#include <stdint.h>
+#include <vector>
+
+namespace caret {
+    
+    class GiftiLabelTable;
+    
+    ///shared parts of the label import operations: making labels for keys that weren't in the label list, and translating values to label keys
+    class LabelImportHelper
+    {
+        LabelImportHelper();
+    public:
+        ///adds a LABEL_<key> label with a random opaque color for each key that isn't in translate yet, in the order given, and records its new key in translate
+        static void addLabelsForKeys(const std::vector<int32_t>& foundKeys, GiftiLabelTable& myTable, std::map<int32_t, int32_t>& translate);
+        
+        ///translates one map of values, adding labels for new values unless discardOthers, and recording the values found in usedValues if dropUnused
+        static void translateLabels(const float* valuesIn, int32_t* labelsOut, const int64_t& numValues, GiftiLabelTable& myTable, std::map<int32_t, int32_t>& translate,
+                                    std::set<int32_t>& usedValues, const bool& dropUnused, const bool& discardOthers, const int32_t& unusedLabel);
+        
+        static void translateLabels(const float* valuesIn, float* labelsOut, const int64_t& numValues, GiftiLabelTable& myTable, std::map<int32_t, int32_t>& translate,
+                                    std::set<int32_t>& usedValues, const bool& dropUnused, const bool& discardOthers, const int32_t& unusedLabel);
+    };
+    
+}
+
+#endif //__LABEL_IMPORT_HELPER_H__
@@ -25,9 +25,19 @@
 #undef __OVERLAP_LOGIC_ENUM_DECLARE__
 
 #include "CaretAssert.h"
+#include "CaretMutex.h"
 
 using namespace caret;
 
+namespace
+{
+    CaretMutex& getInitializeMutex()
+    {//function-local, so it exists even if the enum is first used while initializing another static
+        static CaretMutex s_initializeMutex;
+        return s_initializeMutex;
+    }
+}
+
     
 /**
  * \class caret::OverlapLogicEnum 
@@ -73,10 +83,10 @@ OverlapLogicEnum::~OverlapLogicEnum()
 void
 OverlapLogicEnum::initialize()
 {
+    CaretMutexLocker locker(&getInitializeMutex());//always lock, an unlocked check of the flag could see it set before the data it guards
     if (initializedFlag) {
         return;
     }
-    initializedFlag = true;
 
     enumData.push_back(OverlapLogicEnum(ALLOW, 
                                     0, 
@@ -93,6 +103,7 @@ OverlapLogicEnum::initialize()
                                     "EXCLUDE", 
                                     "Exclude"));
     
+    initializedFlag = true;
 }
 
 /**
@@ -105,7 +116,7 @@ OverlapLogicEnum::initialize()
 const OverlapLogicEnum*
 OverlapLogicEnum::findData(const Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
 
     size_t num = enumData.size();
     for (size_t i = 0; i < num; i++) {
@@ -127,7 +138,7 @@ OverlapLogicEnum::findData(const Enum enumValue)
  */
 AString 
 OverlapLogicEnum::toName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const OverlapLogicEnum* enumInstance = findData(enumValue);
     return enumInstance->name;
@@ -146,7 +157,7 @@ OverlapLogicEnum::toName(Enum enumValue) {
 OverlapLogicEnum::Enum 
 OverlapLogicEnum::fromName(const AString& name, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = ALLOW;
@@ -180,7 +191,7 @@ OverlapLogicEnum::fromName(const AString& name, bool* isValidOut)
  */
 AString 
 OverlapLogicEnum::toGuiName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const OverlapLogicEnum* enumInstance = findData(enumValue);
     return enumInstance->guiName;
@@ -199,7 +210,7 @@ OverlapLogicEnum::toGuiName(Enum enumValue) {
 OverlapLogicEnum::Enum 
 OverlapLogicEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = ALLOW;
@@ -233,7 +244,7 @@ OverlapLogicEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 int32_t
 OverlapLogicEnum::toIntegerCode(Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     const OverlapLogicEnum* enumInstance = findData(enumValue);
     return enumInstance->integerCode;
 }
@@ -252,7 +263,7 @@ OverlapLogicEnum::toIntegerCode(Enum enumValue)
 OverlapLogicEnum::Enum
 OverlapLogicEnum::fromIntegerCode(const int32_t integerCode, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = ALLOW;
@@ -287,7 +298,7 @@ OverlapLogicEnum::fromIntegerCode(const int32_t integerCode, bool* isValidOut)
 void
 OverlapLogicEnum::getAllEnums(std::vector<OverlapLogicEnum::Enum>& allEnums)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allEnums.clear();
     
@@ -309,7 +320,7 @@ OverlapLogicEnum::getAllEnums(std::vector<OverlapLogicEnum::Enum>& allEnums)
 void
 OverlapLogicEnum::getAllNames(std::vector<AString>& allNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allNames.clear();
     
@@ -335,7 +346,7 @@ OverlapLogicEnum::getAllNames(std::vector<AString>& allNames, const bool isSorte
 void
 OverlapLogicEnum::getAllGuiNames(std::vector<AString>& allGuiNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allGuiNames.clear();
     
@@ -0,0 +1,174 @@
+/*LICENSE_START*/
+/*
+ *  Copyright (C) 2014  Washington University School of Medicine
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+/*LICENSE_END*/
+
+#include "PermutationTestHelper.h"
+
+#include "AlgorithmException.h"
+#include "CaretAssert.h"
+#include "CaretOMP.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace caret;
+using namespace std;
+
+/**
+ * \class caret::PermutationTestHelper
+ * \brief Relabelings and statistics for nonparametric permutation tests
+ *
+ * All relabelings are generated up front from the seed, so the results do not
+ * depend on the number of threads used to process the permutations.  The
+ * max statistic method is used for family-wise error correction, so only the
+ * maximum of each permuted map needs to be kept.
+ */
+
+PermutationTestHelper::PermutationTestHelper(const int& numSubjects, const int& numFirstGroup, const int& numPermutations, const uint64_t& seed)
+{
+    if (numPermutations < 1) throw AlgorithmException("number of permutations must be positive");
+    if (numFirstGroup == -1)
+    {
+        if (numSubjects < 2) throw AlgorithmException("one sample test requires at least 2 subjects");
+    } else {
+        if (numFirstGroup < 2 || numSubjects - numFirstGroup < 2) throw AlgorithmException("two sample test requires at least 2 subjects in each group");
+    }
+    m_numSubjects = numSubjects;
+    m_numFirstGroup = numFirstGroup;
+    m_randState = seed;
+    m_relabelings.resize(numPermutations, vector<int>(numSubjects));
+    for (int perm = 0; perm < numPermutations; ++perm)
+    {
+        vector<int>& thisLabeling = m_relabelings[perm];
+        if (m_numFirstGroup == -1)
+        {
+            for (int s = 0; s < numSubjects; ++s)
+            {
+                thisLabeling[s] = ((nextRandom() >> 32) & 1) ? 1 : -1;
+            }
+        } else {
+            for (int s = 0; s < numSubjects; ++s)
+            {
+                thisLabeling[s] = s;
+            }
+            for (int s = numSubjects - 1; s > 0; --s)//Fisher-Yates
+            {
+                swap(thisLabeling[s], thisLabeling[randomBelow(s + 1)]);
+            }
+        }
+    }
+}
+
+uint64_t PermutationTestHelper::nextRandom()
+{//splitmix64, we need reproducible results across platforms, which rand() doesn't guarantee
+    m_randState += 0x9E3779B97F4A7C15ULL;
+    uint64_t z = m_randState;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+int PermutationTestHelper::randomBelow(const int& limit)
+{
+    CaretAssert(limit > 0);
+    return (int)(nextRandom() % (uint64_t)limit);//bias is negligible for any reasonable number of subjects
+}
+
+void PermutationTestHelper::computeStatistic(const int& permutation, const vector<const float*>& subjectData, const int64_t& numElements, float* statOut) const
+{
+    CaretAssert((int)subjectData.size() == m_numSubjects);
+    CaretAssert(permutation >= -1 && permutation < getNumberOfPermutations());
+    vector<double> values(m_numSubjects);
+    for (int64_t i = 0; i < numElements; ++i)
+    {
+        for (int s = 0; s < m_numSubjects; ++s)
+        {
+            if (permutation == -1)
+            {
+                values[s] = subjectData[s][i];
+            } else {
+                if (m_numFirstGroup == -1)
+                {
+                    values[s] = m_relabelings[permutation][s] * subjectData[s][i];
+                } else {
+                    values[s] = subjectData[m_relabelings[permutation][s]][i];
+                }
+            }
+        }
+        if (m_numFirstGroup == -1)
+        {
+            double mean = 0.0;
+            for (int s = 0; s < m_numSubjects; ++s) mean += values[s];
+            mean /= m_numSubjects;
+            double sumSquares = 0.0;
+            for (int s = 0; s < m_numSubjects; ++s)
+            {
+                double diff = values[s] - mean;
+                sumSquares += diff * diff;
+            }
+            double stdErr = sqrt(sumSquares / (m_numSubjects - 1) / m_numSubjects);
+            statOut[i] = (stdErr > 0.0) ? (float)(mean / stdErr) : 0.0f;//constant data has no meaningful t, don't produce inf
+        } else {
+            const int numSecondGroup = m_numSubjects - m_numFirstGroup;
+            double mean1 = 0.0, mean2 = 0.0;
+            for (int s = 0; s < m_numFirstGroup; ++s) mean1 += values[s];
+            for (int s = m_numFirstGroup; s < m_numSubjects; ++s) mean2 += values[s];
+            mean1 /= m_numFirstGroup;
+            mean2 /= numSecondGroup;
+            double sumSquares = 0.0;
+            for (int s = 0; s < m_numFirstGroup; ++s)
+            {
+                double diff = values[s] - mean1;
+                sumSquares += diff * diff;
+            }
+            for (int s = m_numFirstGroup; s < m_numSubjects; ++s)
+            {
+                double diff = values[s] - mean2;
+                sumSquares += diff * diff;
+            }
+            double pooledVar = sumSquares / (m_numSubjects - 2);
+            double stdErr = sqrt(pooledVar * (1.0 / m_numFirstGroup + 1.0 / numSecondGroup));
+            statOut[i] = (stdErr > 0.0) ? (float)((mean1 - mean2) / stdErr) : 0.0f;
+        }
+    }
+}
+
+float PermutationTestHelper::maxAbsolute(const float* data, const int64_t& numElements)
+{
+    float ret = 0.0f;
+    for (int64_t i = 0; i < numElements; ++i)
+    {
+        float absVal = fabs(data[i]);
+        if (absVal > ret) ret = absVal;
+    }
+    return ret;
+}
+
+void PermutationTestHelper::computeCorrectedPValues(const vector<float>& maxDistribution, const float* observed, const int64_t& numElements, float* pValuesOut)
+{
+    vector<float> sortedMax = maxDistribution;
+    sort(sortedMax.begin(), sortedMax.end());
+    const int64_t numPerms = (int64_t)sortedMax.size();
+#pragma omp CARET_PARFOR schedule(dynamic, 1024)
+    for (int64_t i = 0; i < numElements; ++i)
+    {//count the observed map as one of the permutations, so p is never 0
+        int64_t numAtLeast = sortedMax.end() - lower_bound(sortedMax.begin(), sortedMax.end(), fabs(observed[i]));
+        pValuesOut[i] = (float)(numAtLeast + 1) / (float)(numPerms + 1);
+    }
+}
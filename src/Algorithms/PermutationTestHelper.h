@@ -0,0 +1,57 @@
+#ifndef __PERMUTATION_TEST_HELPER_H__
+#define __PERMUTATION_TEST_HELPER_H__
+
+/*LICENSE_START*/
+/*
+ *  Copyright (C) 2014  Washington University School of Medicine
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+/*LICENSE_END*/
+
+#include <stdint.h>
+#include <vector>
+
+namespace caret {
+    
+    class PermutationTestHelper
+    {
+        int m_numSubjects, m_numFirstGroup;//m_numFirstGroup is -1 for a one sample test
+        std::vector<std::vector<int> > m_relabelings;//per permutation, sign (1 or -1) of each subject for one sample, or the order of the subjects for two sample
+        uint64_t m_randState;
+        uint64_t nextRandom();
+        int randomBelow(const int& limit);
+        PermutationTestHelper();
+    public:
+        ///one sample t-test by sign flipping when numFirstGroup is -1, otherwise the first numFirstGroup subjects are compared against the rest by permuting group membership
+        PermutationTestHelper(const int& numSubjects, const int& numFirstGroup, const int& numPermutations, const uint64_t& seed);
+        
+        int getNumberOfPermutations() const { return (int)m_relabelings.size(); }
+        
+        bool isTwoSample() const { return m_numFirstGroup != -1; }
+        
+        ///compute the t-statistic of each element, subjectData[s] points to numElements values for subject s, use permutation -1 for the unpermuted data
+        void computeStatistic(const int& permutation, const std::vector<const float*>& subjectData, const int64_t& numElements, float* statOut) const;
+        
+        ///maximum absolute value, the statistic to record for each permutation
+        static float maxAbsolute(const float* data, const int64_t& numElements);
+        
+        ///family-wise error corrected (two-sided) p-value of each element, from the maximum absolute statistic of every permutation
+        static void computeCorrectedPValues(const std::vector<float>& maxDistribution, const float* observed, const int64_t& numElements, float* pValuesOut);
+    };
+    
+}
+
+#endif //__PERMUTATION_TEST_HELPER_H__
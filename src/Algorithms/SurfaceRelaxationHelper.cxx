@@ -0,0 +1,177 @@
+/*LICENSE_START*/
+/*
+ *  Copyright (C) 2014  Washington University School of Medicine
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+/*LICENSE_END*/
+
+#include "SurfaceRelaxationHelper.h"
+
+#include "CaretAssert.h"
+#include "CaretOMP.h"
+#include "SurfaceFile.h"
+#include "TopologyHelper.h"
+
+#include <cmath>
+
+using namespace caret;
+using namespace std;
+
+SurfaceRelaxationHelper::SurfaceRelaxationHelper(const SurfaceFile* mySurf)
+{
+    m_numNodes = mySurf->getNumberOfNodes();
+    CaretPointer<TopologyHelper> myTopoHelp = mySurf->getTopologyHelper(true);
+    m_neighborStart.resize(m_numNodes + 1);
+    m_neighborStart[0] = 0;
+    for (int32_t i = 0; i < m_numNodes; ++i)
+    {
+        int32_t numNeighbors = 0;
+        myTopoHelp->getNodeNeighbors(i, numNeighbors);
+        m_neighborStart[i + 1] = m_neighborStart[i] + numNeighbors;
+    }
+    m_neighbors.resize(m_neighborStart[m_numNodes]);
+    for (int32_t i = 0; i < m_numNodes; ++i)
+    {
+        int32_t numNeighbors = 0;
+        const int32_t* neighbors = myTopoHelp->getNodeNeighbors(i, numNeighbors);
+        for (int32_t j = 0; j < numNeighbors; ++j)
+        {
+            m_neighbors[m_neighborStart[i] + j] = neighbors[j];
+        }
+    }
+    for (int k = 0; k < 3; ++k)
+    {
+        m_coords[k].resize(m_numNodes);
+        m_newCoords[k].resize(m_numNodes);
+    }
+    if (m_numNodes > 0)
+    {
+        setCoordinates(mySurf->getCoordinateData());
+    }
+}
+
+void SurfaceRelaxationHelper::smoothIteration(const float& strength)
+{
+    const float inverseStrength = 1.0f - strength;
+    const float* x = m_coords[0].data(), *y = m_coords[1].data(), *z = m_coords[2].data();
+    float* newX = m_newCoords[0].data(), *newY = m_newCoords[1].data(), *newZ = m_newCoords[2].data();
+#pragma omp CARET_PARFOR schedule(static, 1024)
+    for (int32_t i = 0; i < m_numNodes; ++i)
+    {
+        int32_t start = m_neighborStart[i], end = m_neighborStart[i + 1];
+        if (end - start < 2)
+        {
+            newX[i] = x[i];
+            newY[i] = y[i];
+            newZ[i] = z[i];
+            continue;
+        }
+        double totalArea = 0.0, sumX = 0.0, sumY = 0.0, sumZ = 0.0;
+        for (int32_t j = start; j < end; ++j)
+        {
+            int32_t n1 = m_neighbors[j], n2 = m_neighbors[(j + 1 < end) ? j + 1 : start];
+            //same area formula as MathFunctions::triangleArea, on the separate arrays
+            double dx = x[i] - x[n1], dy = y[i] - y[n1], dz = z[i] - z[n1];
+            double a = dx * dx + dy * dy + dz * dz;
+            dx = x[n1] - x[n2]; dy = y[n1] - y[n2]; dz = z[n1] - z[n2];
+            double b = dx * dx + dy * dy + dz * dz;
+            dx = x[n2] - x[i]; dy = y[n2] - y[i]; dz = z[n2] - z[i];
+            double c = dx * dx + dy * dy + dz * dz;
+            float area = (float)(0.25 * sqrt(abs(4.0 * a * c - (a - b + c) * (a - b + c))));
+            totalArea += area;
+            sumX += area * (x[i] + x[n1] + x[n2]);
+            sumY += area * (y[i] + y[n1] + y[n2]);
+            sumZ += area * (z[i] + z[n1] + z[n2]);
+        }
+        float avgX = 0.0f, avgY = 0.0f, avgZ = 0.0f;//nodes with only degenerate triangles are pulled toward the origin, as before
+        if (totalArea > 0.0)
+        {
+            avgX = sumX / (3.0 * totalArea);
+            avgY = sumY / (3.0 * totalArea);
+            avgZ = sumZ / (3.0 * totalArea);
+        }
+        newX[i] = x[i] * inverseStrength + avgX * strength;
+        newY[i] = y[i] * inverseStrength + avgY * strength;
+        newZ[i] = z[i] * inverseStrength + avgZ * strength;
+    }
+    for (int k = 0; k < 3; ++k)
+    {
+        m_coords[k].swap(m_newCoords[k]);
+    }
+}
+
+void SurfaceRelaxationHelper::translateToCenterOfMass()
+{
+    double center[3] = { 0.0, 0.0, 0.0 };
+    int64_t count = 0;
+    for (int32_t i = 0; i < m_numNodes; ++i)
+    {
+        if (m_neighborStart[i + 1] > m_neighborStart[i])
+        {
+            for (int k = 0; k < 3; ++k)
+            {
+                center[k] += m_coords[k][i];
+            }
+            ++count;
+        }
+    }
+    if (count == 0) return;
+    for (int k = 0; k < 3; ++k)
+    {
+        float shift = (float)(center[k] / count);
+        float* coords = m_coords[k].data();
+        for (int32_t i = 0; i < m_numNodes; ++i)
+        {
+            coords[i] -= shift;
+        }
+    }
+}
+
+void SurfaceRelaxationHelper::inflate(const float& inflationFactor, const float anatomicalRange[3])
+{
+    const float factor = inflationFactor - 1.0f;
+    float* x = m_coords[0].data(), *y = m_coords[1].data(), *z = m_coords[2].data();
+#pragma omp CARET_PARFOR schedule(static, 1024)
+    for (int32_t i = 0; i < m_numNodes; ++i)
+    {
+        const float relX = x[i] / anatomicalRange[0], relY = y[i] / anatomicalRange[1], relZ = z[i] / anatomicalRange[2];
+        const float radius = sqrt(relX * relX + relY * relY + relZ * relZ);
+        const float scale = 1.0f + factor * (1.0f - radius);
+        x[i] *= scale;
+        y[i] *= scale;
+        z[i] *= scale;
+    }
+}
+
+void SurfaceRelaxationHelper::getCoordinates(float* coordsOut) const
+{
+    for (int32_t i = 0; i < m_numNodes; ++i)
+    {
+        coordsOut[i * 3] = m_coords[0][i];
+        coordsOut[i * 3 + 1] = m_coords[1][i];
+        coordsOut[i * 3 + 2] = m_coords[2][i];
+    }
+}
+
+void SurfaceRelaxationHelper::setCoordinates(const float* coordsIn)
+{
+    for (int32_t i = 0; i < m_numNodes; ++i)
+    {
+        m_coords[0][i] = coordsIn[i * 3];
+        m_coords[1][i] = coordsIn[i * 3 + 1];
+        m_coords[2][i] = coordsIn[i * 3 + 2];
+    }
+}
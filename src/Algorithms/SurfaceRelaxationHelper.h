@@ -0,0 +1,60 @@
+#ifndef __SURFACE_RELAXATION_HELPER_H__
+#define __SURFACE_RELAXATION_HELPER_H__
+
+/*LICENSE_START*/
+/*
+ *  Copyright (C) 2014  Washington University School of Medicine
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+/*LICENSE_END*/
+
+#include <stdint.h>
+#include <vector>
+
+namespace caret {
+    
+    class SurfaceFile;
+    
+    ///neighbor lists in compressed sparse row form and coordinates as separate x, y, z arrays, for the iterative smoothing and inflation algorithms
+    class SurfaceRelaxationHelper
+    {
+        int32_t m_numNodes;
+        std::vector<int32_t> m_neighborStart, m_neighbors;//neighbors of node i are m_neighbors[m_neighborStart[i]] up to m_neighbors[m_neighborStart[i + 1]], in sorted topology order
+        std::vector<float> m_coords[3], m_newCoords[3];//each smoothing iteration reads m_coords and writes m_newCoords, then swaps them
+        SurfaceRelaxationHelper();
+    public:
+        explicit SurfaceRelaxationHelper(const SurfaceFile* mySurf);
+        
+        int32_t getNumberOfNodes() const { return m_numNodes; }
+        
+        ///move each node toward the area weighted average of the centers of its triangles, all nodes use the coordinates from before the iteration
+        void smoothIteration(const float& strength);
+        
+        ///translate so the average of all nodes with neighbors is at the origin
+        void translateToCenterOfMass();
+        
+        ///push nodes outward, by more for nodes closer to the center relative to the anatomical extents
+        void inflate(const float& inflationFactor, const float anatomicalRange[3]);
+        
+        ///xyz interleaved, as SurfaceFile uses
+        void getCoordinates(float* coordsOut) const;
+        
+        void setCoordinates(const float* coordsIn);
+    };
+    
+}
+
+#endif //__SURFACE_RELAXATION_HELPER_H__
@@ -25,9 +25,19 @@
 #undef __BORDER_DRAWING_TYPE_ENUM_DECLARE__
 
 #include "CaretAssert.h"
+#include "CaretMutex.h"
 
 using namespace caret;
 
+namespace
+{
+    CaretMutex& getInitializeMutex()
+    {//function-local, so it exists even if the enum is first used while initializing another static
+        static CaretMutex s_initializeMutex;
+        return s_initializeMutex;
+    }
+}
+
     
 /**
  * \class caret::BorderDrawingTypeEnum 
@@ -69,10 +79,10 @@ BorderDrawingTypeEnum::~BorderDrawingTypeEnum()
 void
 BorderDrawingTypeEnum::initialize()
 {
+    CaretMutexLocker locker(&getInitializeMutex());//always lock, an unlocked check of the flag could see it set before the data it guards
     if (initializedFlag) {
         return;
     }
-    initializedFlag = true;
 
     enumData.push_back(BorderDrawingTypeEnum(DRAW_AS_LINES, 
                                     "DRAW_AS_LINES", 
@@ -90,6 +100,7 @@ BorderDrawingTypeEnum::initialize()
                                     "DRAW_AS_POINTS_AND_LINES", 
                                     "Spheres and Lines"));
     
+    initializedFlag = true;
 }
 
 /**
@@ -102,7 +113,7 @@ BorderDrawingTypeEnum::initialize()
 const BorderDrawingTypeEnum*
 BorderDrawingTypeEnum::findData(const Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
 
     size_t num = enumData.size();
     for (size_t i = 0; i < num; i++) {
@@ -124,7 +135,7 @@ BorderDrawingTypeEnum::findData(const Enum enumValue)
  */
 AString 
 BorderDrawingTypeEnum::toName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const BorderDrawingTypeEnum* enumInstance = findData(enumValue);
     return enumInstance->name;
@@ -143,7 +154,7 @@ BorderDrawingTypeEnum::toName(Enum enumValue) {
 BorderDrawingTypeEnum::Enum 
 BorderDrawingTypeEnum::fromName(const AString& name, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = DRAW_AS_LINES;
@@ -177,7 +188,7 @@ BorderDrawingTypeEnum::fromName(const AString& name, bool* isValidOut)
  */
 AString 
 BorderDrawingTypeEnum::toGuiName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const BorderDrawingTypeEnum* enumInstance = findData(enumValue);
     return enumInstance->guiName;
@@ -196,7 +207,7 @@ BorderDrawingTypeEnum::toGuiName(Enum enumValue) {
 BorderDrawingTypeEnum::Enum 
 BorderDrawingTypeEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = DRAW_AS_LINES;
@@ -230,7 +241,7 @@ BorderDrawingTypeEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 int32_t
 BorderDrawingTypeEnum::toIntegerCode(Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     const BorderDrawingTypeEnum* enumInstance = findData(enumValue);
     return enumInstance->integerCode;
 }
@@ -249,7 +260,7 @@ BorderDrawingTypeEnum::toIntegerCode(Enum enumValue)
 BorderDrawingTypeEnum::Enum
 BorderDrawingTypeEnum::fromIntegerCode(const int32_t integerCode, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = DRAW_AS_LINES;
@@ -284,7 +295,7 @@ BorderDrawingTypeEnum::fromIntegerCode(const int32_t integerCode, bool* isValidO
 void
 BorderDrawingTypeEnum::getAllEnums(std::vector<BorderDrawingTypeEnum::Enum>& allEnums)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allEnums.clear();
     
@@ -306,7 +317,7 @@ BorderDrawingTypeEnum::getAllEnums(std::vector<BorderDrawingTypeEnum::Enum>& all
 void
 BorderDrawingTypeEnum::getAllNames(std::vector<AString>& allNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allNames.clear();
     
@@ -332,7 +343,7 @@ BorderDrawingTypeEnum::getAllNames(std::vector<AString>& allNames, const bool is
 void
 BorderDrawingTypeEnum::getAllGuiNames(std::vector<AString>& allGuiNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allGuiNames.clear();
     
@@ -39,6 +39,7 @@
 #include "CiftiBrainordinateDataSeriesFile.h"
 #include "CiftiBrainordinateLabelFile.h"
 #include "CiftiBrainordinateScalarFile.h"
+#include "CiftiConnectivityMatrixDenseDynamicFile.h"
 #include "CiftiConnectivityMatrixDenseFile.h"
 #include "CiftiConnectivityMatrixDenseParcelFile.h"
 #include "CiftiFiberOrientationFile.h"
@@ -3885,6 +3886,18 @@ Brain::getAllCiftiConnectivityMatrixFiles(std::vector<CiftiMappableConnectivityM
             allCiftiConnectivityMatrixFiles.push_back(cmdf);
         }
     }
+    
+    /*
+     * Connectivity computed from data series files
+     */
+    for (std::vector<CiftiBrainordinateDataSeriesFile*>::const_iterator dsIter = m_connectivityDataSeriesFiles.begin();
+         dsIter != m_connectivityDataSeriesFiles.end();
+         dsIter++) {
+        CiftiConnectivityMatrixDenseDynamicFile* dynamicFile = (*dsIter)->getConnectivityMatrixDenseDynamicFile();
+        if ( ! dynamicFile->isEmpty()) {
+            allCiftiConnectivityMatrixFiles.push_back(dynamicFile);
+        }
+    }
 }
 
 /**
@@ -5692,6 +5705,18 @@ Brain::getAllMappableDataFiles(std::vector<CaretMappableDataFile*>& allCaretMapp
             allCaretMappableDataFilesOut.push_back(cmdf);
         }
     }
+    
+    /*
+     * Connectivity computed from data series files
+     */
+    for (std::vector<CiftiBrainordinateDataSeriesFile*>::const_iterator dsIter = m_connectivityDataSeriesFiles.begin();
+         dsIter != m_connectivityDataSeriesFiles.end();
+         dsIter++) {
+        CiftiConnectivityMatrixDenseDynamicFile* dynamicFile = (*dsIter)->getConnectivityMatrixDenseDynamicFile();
+        if ( ! dynamicFile->isEmpty()) {
+            allCaretMappableDataFilesOut.push_back(dynamicFile);
+        }
+    }
 }
     
 /**
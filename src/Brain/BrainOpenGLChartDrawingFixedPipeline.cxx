@@ -997,10 +997,31 @@ BrainOpenGLChartDrawingFixedPipeline::drawChartGraphicsMatrix(const int32_t view
     
     int32_t numberOfRows = 0;
     int32_t numberOfColumns = 0;
+    chartMatrixInterface->getMatrixDimensions(numberOfRows,
+                                              numberOfColumns);
+    
+    /*
+     * Large matrices are drawn as a texture of the visible region,
+     * colored at a resolution matching the screen, instead of
+     * coloring and drawing a quad for every cell.
+     */
+    const bool drawTilesFlag = (chartMatrixInterface->isMatrixDataRGBAForRegionSupported()
+                                && ((static_cast<int64_t>(numberOfRows) * numberOfColumns)
+                                    > MATRIX_TILE_DRAWING_MINIMUM_CELLS));
+    
+    bool matrixValidFlag = false;
     std::vector<float> matrixRGBA;
-    if (chartMatrixInterface->getMatrixDataRGBA(numberOfRows,
-                                       numberOfColumns,
-                                       matrixRGBA)) {
+    if (drawTilesFlag) {
+        matrixValidFlag = ((numberOfRows > 0)
+                           && (numberOfColumns > 0));
+    }
+    else {
+        matrixValidFlag = chartMatrixInterface->getMatrixDataRGBA(numberOfRows,
+                                                                  numberOfColumns,
+                                                                  matrixRGBA);
+    }
+    
+    if (matrixValidFlag) {
         std::set<int32_t> selectedColumnIndices;
         std::set<int32_t> selectedRowIndices;
         
@@ -1138,168 +1159,180 @@ BrainOpenGLChartDrawingFixedPipeline::drawChartGraphicsMatrix(const int32_t view
                          0.0);
         }
         
-        int32_t rgbaOffset = 0;
-        std::vector<float> quadVerticesXYZ;
-        quadVerticesXYZ.reserve(numberOfRows * numberOfColumns * 3);
-        std::vector<float> quadVerticesFloatRGBA;
-        quadVerticesFloatRGBA.reserve(numberOfRows * numberOfColumns * 4);
-        std::vector<uint8_t> quadVerticesByteRGBA;
-        quadVerticesByteRGBA.reserve(numberOfRows * numberOfColumns * 4);
+        if (drawTilesFlag) {
+            drawChartGraphicsMatrixTiles(chartMatrixInterface,
+                                         numberOfRows,
+                                         numberOfColumns,
+                                         cellWidth,
+                                         cellHeight,
+                                         displayGridLinesFlag);
+        }
+        else {
+            int32_t rgbaOffset = 0;
+            std::vector<float> quadVerticesXYZ;
+            quadVerticesXYZ.reserve(numberOfRows * numberOfColumns * 3);
+            std::vector<float> quadVerticesFloatRGBA;
+            quadVerticesFloatRGBA.reserve(numberOfRows * numberOfColumns * 4);
+            std::vector<uint8_t> quadVerticesByteRGBA;
+            quadVerticesByteRGBA.reserve(numberOfRows * numberOfColumns * 4);
         
-        float cellY = (numberOfRows - 1) * cellHeight;
-        for (int32_t rowIndex = 0; rowIndex < numberOfRows; rowIndex++) {
-            float cellX = 0;
-            for (int32_t columnIndex = 0; columnIndex < numberOfColumns; columnIndex++) {
-                CaretAssertVectorIndex(matrixRGBA, rgbaOffset+3);
-                const float* rgba = &matrixRGBA[rgbaOffset];
-                rgbaOffset += 4;
+            float cellY = (numberOfRows - 1) * cellHeight;
+            for (int32_t rowIndex = 0; rowIndex < numberOfRows; rowIndex++) {
+                float cellX = 0;
+                for (int32_t columnIndex = 0; columnIndex < numberOfColumns; columnIndex++) {
+                    CaretAssertVectorIndex(matrixRGBA, rgbaOffset+3);
+                    const float* rgba = &matrixRGBA[rgbaOffset];
+                    rgbaOffset += 4;
                 
-                uint8_t idRGBA[4];
-                if (m_identificationModeFlag) {
-                    addToChartMatrixIdentification(rowIndex,
-                                                   columnIndex,
-                                                   idRGBA);
-                }
+                    uint8_t idRGBA[4];
+                    if (m_identificationModeFlag) {
+                        addToChartMatrixIdentification(rowIndex,
+                                                       columnIndex,
+                                                       idRGBA);
+                    }
                 
-                if (m_identificationModeFlag) {
-                    quadVerticesByteRGBA.push_back(idRGBA[0]);
-                    quadVerticesByteRGBA.push_back(idRGBA[1]);
-                    quadVerticesByteRGBA.push_back(idRGBA[2]);
-                    quadVerticesByteRGBA.push_back(idRGBA[3]);
-                }
-                else {
-                    quadVerticesFloatRGBA.push_back(rgba[0]);
-                    quadVerticesFloatRGBA.push_back(rgba[1]);
-                    quadVerticesFloatRGBA.push_back(rgba[2]);
-                    quadVerticesFloatRGBA.push_back(rgba[3]);
-                }
-                quadVerticesXYZ.push_back(cellX);
-                quadVerticesXYZ.push_back(cellY);
-                quadVerticesXYZ.push_back(0.0);
+                    if (m_identificationModeFlag) {
+                        quadVerticesByteRGBA.push_back(idRGBA[0]);
+                        quadVerticesByteRGBA.push_back(idRGBA[1]);
+                        quadVerticesByteRGBA.push_back(idRGBA[2]);
+                        quadVerticesByteRGBA.push_back(idRGBA[3]);
+                    }
+                    else {
+                        quadVerticesFloatRGBA.push_back(rgba[0]);
+                        quadVerticesFloatRGBA.push_back(rgba[1]);
+                        quadVerticesFloatRGBA.push_back(rgba[2]);
+                        quadVerticesFloatRGBA.push_back(rgba[3]);
+                    }
+                    quadVerticesXYZ.push_back(cellX);
+                    quadVerticesXYZ.push_back(cellY);
+                    quadVerticesXYZ.push_back(0.0);
                 
-                if (m_identificationModeFlag) {
-                    quadVerticesByteRGBA.push_back(idRGBA[0]);
-                    quadVerticesByteRGBA.push_back(idRGBA[1]);
-                    quadVerticesByteRGBA.push_back(idRGBA[2]);
-                    quadVerticesByteRGBA.push_back(idRGBA[3]);
-                }
-                else {
-                    quadVerticesFloatRGBA.push_back(rgba[0]);
-                    quadVerticesFloatRGBA.push_back(rgba[1]);
-                    quadVerticesFloatRGBA.push_back(rgba[2]);
-                    quadVerticesFloatRGBA.push_back(rgba[3]);
-                }
-                quadVerticesXYZ.push_back(cellX + cellWidth);
-                quadVerticesXYZ.push_back(cellY);
-                quadVerticesXYZ.push_back(0.0);
+                    if (m_identificationModeFlag) {
+                        quadVerticesByteRGBA.push_back(idRGBA[0]);
+                        quadVerticesByteRGBA.push_back(idRGBA[1]);
+                        quadVerticesByteRGBA.push_back(idRGBA[2]);
+                        quadVerticesByteRGBA.push_back(idRGBA[3]);
+                    }
+                    else {
+                        quadVerticesFloatRGBA.push_back(rgba[0]);
+                        quadVerticesFloatRGBA.push_back(rgba[1]);
+                        quadVerticesFloatRGBA.push_back(rgba[2]);
+                        quadVerticesFloatRGBA.push_back(rgba[3]);
+                    }
+                    quadVerticesXYZ.push_back(cellX + cellWidth);
+                    quadVerticesXYZ.push_back(cellY);
+                    quadVerticesXYZ.push_back(0.0);
                 
-                if (m_identificationModeFlag) {
-                    quadVerticesByteRGBA.push_back(idRGBA[0]);
-                    quadVerticesByteRGBA.push_back(idRGBA[1]);
-                    quadVerticesByteRGBA.push_back(idRGBA[2]);
-                    quadVerticesByteRGBA.push_back(idRGBA[3]);
-                }
-                else {
-                    quadVerticesFloatRGBA.push_back(rgba[0]);
-                    quadVerticesFloatRGBA.push_back(rgba[1]);
-                    quadVerticesFloatRGBA.push_back(rgba[2]);
-                    quadVerticesFloatRGBA.push_back(rgba[3]);
-                }
-                quadVerticesXYZ.push_back(cellX + cellWidth);
-                quadVerticesXYZ.push_back(cellY + cellHeight);
-                quadVerticesXYZ.push_back(0.0);
+                    if (m_identificationModeFlag) {
+                        quadVerticesByteRGBA.push_back(idRGBA[0]);
+                        quadVerticesByteRGBA.push_back(idRGBA[1]);
+                        quadVerticesByteRGBA.push_back(idRGBA[2]);
+                        quadVerticesByteRGBA.push_back(idRGBA[3]);
+                    }
+                    else {
+                        quadVerticesFloatRGBA.push_back(rgba[0]);
+                        quadVerticesFloatRGBA.push_back(rgba[1]);
+                        quadVerticesFloatRGBA.push_back(rgba[2]);
+                        quadVerticesFloatRGBA.push_back(rgba[3]);
+                    }
+                    quadVerticesXYZ.push_back(cellX + cellWidth);
+                    quadVerticesXYZ.push_back(cellY + cellHeight);
+                    quadVerticesXYZ.push_back(0.0);
                 
-                if (m_identificationModeFlag) {
-                    quadVerticesByteRGBA.push_back(idRGBA[0]);
-                    quadVerticesByteRGBA.push_back(idRGBA[1]);
-                    quadVerticesByteRGBA.push_back(idRGBA[2]);
-                    quadVerticesByteRGBA.push_back(idRGBA[3]);
-                }
-                else {
-                    quadVerticesFloatRGBA.push_back(rgba[0]);
-                    quadVerticesFloatRGBA.push_back(rgba[1]);
-                    quadVerticesFloatRGBA.push_back(rgba[2]);
-                    quadVerticesFloatRGBA.push_back(rgba[3]);
-                }
-                quadVerticesXYZ.push_back(cellX);
-                quadVerticesXYZ.push_back(cellY + cellHeight);
-                quadVerticesXYZ.push_back(0.0);
+                    if (m_identificationModeFlag) {
+                        quadVerticesByteRGBA.push_back(idRGBA[0]);
+                        quadVerticesByteRGBA.push_back(idRGBA[1]);
+                        quadVerticesByteRGBA.push_back(idRGBA[2]);
+                        quadVerticesByteRGBA.push_back(idRGBA[3]);
+                    }
+                    else {
+                        quadVerticesFloatRGBA.push_back(rgba[0]);
+                        quadVerticesFloatRGBA.push_back(rgba[1]);
+                        quadVerticesFloatRGBA.push_back(rgba[2]);
+                        quadVerticesFloatRGBA.push_back(rgba[3]);
+                    }
+                    quadVerticesXYZ.push_back(cellX);
+                    quadVerticesXYZ.push_back(cellY + cellHeight);
+                    quadVerticesXYZ.push_back(0.0);
                 
                 
-                cellX += cellWidth;
-            }
-            
-            cellY -= cellHeight;
-        }
-        
-        /*
-         * Draw the matrix elements.
-         */
-        if (m_identificationModeFlag) {
-            CaretAssert((quadVerticesXYZ.size() / 3) == (quadVerticesByteRGBA.size() / 4));
-            const int32_t numberQuadVertices = static_cast<int32_t>(quadVerticesXYZ.size() / 3);
-            glBegin(GL_QUADS);
-            for (int32_t i = 0; i < numberQuadVertices; i++) {
-                CaretAssertVectorIndex(quadVerticesByteRGBA, i*4 + 3);
-                glColor4ubv(&quadVerticesByteRGBA[i*4]);
-                CaretAssertVectorIndex(quadVerticesXYZ, i*3 + 2);
-                glVertex3fv(&quadVerticesXYZ[i*3]);
-            }
-            glEnd();
-        }
-        else {
-            /*
-             * Enable alpha blending so voxels that are not drawn from higher layers
-             * allow voxels from lower layers to be seen.
-             */
-            glEnable(GL_BLEND);
-            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+                    cellX += cellWidth;
+                }
             
-            CaretAssert((quadVerticesXYZ.size() / 3) == (quadVerticesFloatRGBA.size() / 4));
-            const int32_t numberQuadVertices = static_cast<int32_t>(quadVerticesXYZ.size() / 3);
-            glBegin(GL_QUADS);
-            for (int32_t i = 0; i < numberQuadVertices; i++) {
-                CaretAssertVectorIndex(quadVerticesFloatRGBA, i*4 + 3);
-                glColor4fv(&quadVerticesFloatRGBA[i*4]);
-                CaretAssertVectorIndex(quadVerticesXYZ, i*3 + 2);
-                glVertex3fv(&quadVerticesXYZ[i*3]);
+                cellY -= cellHeight;
             }
-            glEnd();
-            
-            glDisable(GL_BLEND);
-
-            
+        
             /*
-             * Drawn an outline around the matrix elements.
+             * Draw the matrix elements.
              */
-            if (displayGridLinesFlag) {
-                uint8_t gridLineColorBytes[3];
-                prefs->getColorChartMatrixGridLines(gridLineColorBytes);
-                float gridLineColorFloats[4];
-                CaretPreferences::byteRgbToFloatRgb(gridLineColorBytes,
-                                                    gridLineColorFloats);
-                gridLineColorFloats[3] = 1.0;
-                std::vector<float> outlineRGBA;
-                outlineRGBA.reserve(numberQuadVertices * 4);
+            if (m_identificationModeFlag) {
+                CaretAssert((quadVerticesXYZ.size() / 3) == (quadVerticesByteRGBA.size() / 4));
+                const int32_t numberQuadVertices = static_cast<int32_t>(quadVerticesXYZ.size() / 3);
+                glBegin(GL_QUADS);
                 for (int32_t i = 0; i < numberQuadVertices; i++) {
-                    outlineRGBA.push_back(gridLineColorFloats[0]);
-                    outlineRGBA.push_back(gridLineColorFloats[1]);
-                    outlineRGBA.push_back(gridLineColorFloats[2]);
-                    outlineRGBA.push_back(gridLineColorFloats[3]);
+                    CaretAssertVectorIndex(quadVerticesByteRGBA, i*4 + 3);
+                    glColor4ubv(&quadVerticesByteRGBA[i*4]);
+                    CaretAssertVectorIndex(quadVerticesXYZ, i*3 + 2);
+                    glVertex3fv(&quadVerticesXYZ[i*3]);
                 }
-                
-                glPolygonMode(GL_FRONT, GL_LINE);
-                glLineWidth(1.0);
+                glEnd();
+            }
+            else {
+                /*
+                 * Enable alpha blending so voxels that are not drawn from higher layers
+                 * allow voxels from lower layers to be seen.
+                 */
+                glEnable(GL_BLEND);
+                glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+            
+                CaretAssert((quadVerticesXYZ.size() / 3) == (quadVerticesFloatRGBA.size() / 4));
+                const int32_t numberQuadVertices = static_cast<int32_t>(quadVerticesXYZ.size() / 3);
                 glBegin(GL_QUADS);
                 for (int32_t i = 0; i < numberQuadVertices; i++) {
-                    CaretAssertVectorIndex(outlineRGBA, i*4 + 3);
-                    glColor4fv(&outlineRGBA[i*4]);
+                    CaretAssertVectorIndex(quadVerticesFloatRGBA, i*4 + 3);
+                    glColor4fv(&quadVerticesFloatRGBA[i*4]);
                     CaretAssertVectorIndex(quadVerticesXYZ, i*3 + 2);
                     glVertex3fv(&quadVerticesXYZ[i*3]);
                 }
                 glEnd();
-            }
             
+                glDisable(GL_BLEND);
+
+            
+                /*
+                 * Drawn an outline around the matrix elements.
+                 */
+                if (displayGridLinesFlag) {
+                    uint8_t gridLineColorBytes[3];
+                    prefs->getColorChartMatrixGridLines(gridLineColorBytes);
+                    float gridLineColorFloats[4];
+                    CaretPreferences::byteRgbToFloatRgb(gridLineColorBytes,
+                                                        gridLineColorFloats);
+                    gridLineColorFloats[3] = 1.0;
+                    std::vector<float> outlineRGBA;
+                    outlineRGBA.reserve(numberQuadVertices * 4);
+                    for (int32_t i = 0; i < numberQuadVertices; i++) {
+                        outlineRGBA.push_back(gridLineColorFloats[0]);
+                        outlineRGBA.push_back(gridLineColorFloats[1]);
+                        outlineRGBA.push_back(gridLineColorFloats[2]);
+                        outlineRGBA.push_back(gridLineColorFloats[3]);
+                    }
+                
+                    glPolygonMode(GL_FRONT, GL_LINE);
+                    glLineWidth(1.0);
+                    glBegin(GL_QUADS);
+                    for (int32_t i = 0; i < numberQuadVertices; i++) {
+                        CaretAssertVectorIndex(outlineRGBA, i*4 + 3);
+                        glColor4fv(&outlineRGBA[i*4]);
+                        CaretAssertVectorIndex(quadVerticesXYZ, i*3 + 2);
+                        glVertex3fv(&quadVerticesXYZ[i*3]);
+                    }
+                    glEnd();
+                }
+            }
+        }
+        
+        if ( ! m_identificationModeFlag) {
             if ( (! selectedRowIndices.empty())
                 && highlightSelectedRowColumnFlag) {
                 std::vector<float> rowXYZ;
@@ -1452,6 +1485,302 @@ BrainOpenGLChartDrawingFixedPipeline::drawChartGraphicsMatrix(const int32_t view
     }
 }
 
+/**
+ * Draw the visible region of a large matrix as a texture.  The region is
+ * colored by the file at the coarsest resolution level in which each
+ * cell still covers at least one pixel, so the amount of data colored
+ * and sent to OpenGL depends upon the size of the viewport, not the
+ * size of the matrix.
+ *
+ * @param chartMatrixInterface
+ *     Chart that is drawn.
+ * @param numberOfRows
+ *     Number of rows in the matrix.
+ * @param numberOfColumns
+ *     Number of columns in the matrix.
+ * @param cellWidth
+ *     Width of a matrix cell.
+ * @param cellHeight
+ *     Height of a matrix cell.
+ * @param displayGridLinesFlag
+ *     If true, draw grid lines when cells are at full resolution.
+ */
+void
+BrainOpenGLChartDrawingFixedPipeline::drawChartGraphicsMatrixTiles(ChartableMatrixInterface* chartMatrixInterface,
+                                                                   const int32_t numberOfRows,
+                                                                   const int32_t numberOfColumns,
+                                                                   const float cellWidth,
+                                                                   const float cellHeight,
+                                                                   const bool displayGridLinesFlag)
+{
+    CaretAssert(chartMatrixInterface);
+    if ((numberOfRows <= 0)
+        || (numberOfColumns <= 0)
+        || (cellWidth <= 0.0)
+        || (cellHeight <= 0.0)) {
+        return;
+    }
+    
+    GLint viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    GLdouble modelviewMatrix[16];
+    glGetDoublev(GL_MODELVIEW_MATRIX, modelviewMatrix);
+    GLdouble projectionMatrix[16];
+    glGetDoublev(GL_PROJECTION_MATRIX, projectionMatrix);
+    
+    const float matrixWidth  = numberOfColumns * cellWidth;
+    const float matrixHeight = numberOfRows * cellHeight;
+    
+    if (m_identificationModeFlag) {
+        /*
+         * Only the cell under the mouse is drawn for identification.
+         */
+        GLdouble modelX, modelY, modelZ;
+        if ( ! gluUnProject(m_fixedPipelineDrawing->mouseX,
+                            m_fixedPipelineDrawing->mouseY,
+                            0.0,
+                            modelviewMatrix,
+                            projectionMatrix,
+                            viewport,
+                            &modelX,
+                            &modelY,
+                            &modelZ)) {
+            return;
+        }
+        if ((modelX < 0.0)
+            || (modelX >= matrixWidth)
+            || (modelY < 0.0)
+            || (modelY >= matrixHeight)) {
+            return;
+        }
+        
+        const int32_t columnIndex = std::min(static_cast<int32_t>(modelX / cellWidth),
+                                             numberOfColumns - 1);
+        const int32_t rowIndex = std::max(numberOfRows - 1 - static_cast<int32_t>(modelY / cellHeight),
+                                          0);
+        uint8_t idRGBA[4];
+        addToChartMatrixIdentification(rowIndex,
+                                       columnIndex,
+                                       idRGBA);
+        
+        const float cellX = columnIndex * cellWidth;
+        const float cellY = (numberOfRows - rowIndex - 1) * cellHeight;
+        glColor4ubv(idRGBA);
+        glBegin(GL_QUADS);
+        glVertex3f(cellX, cellY, 0.0);
+        glVertex3f(cellX + cellWidth, cellY, 0.0);
+        glVertex3f(cellX + cellWidth, cellY + cellHeight, 0.0);
+        glVertex3f(cellX, cellY + cellHeight, 0.0);
+        glEnd();
+        return;
+    }
+    
+    /*
+     * Find the region of the matrix that is inside the viewport.
+     */
+    GLdouble bottomLeft[3];
+    GLdouble topRight[3];
+    if ( ! (gluUnProject(viewport[0],
+                         viewport[1],
+                         0.0,
+                         modelviewMatrix,
+                         projectionMatrix,
+                         viewport,
+                         &bottomLeft[0],
+                         &bottomLeft[1],
+                         &bottomLeft[2])
+            && gluUnProject(viewport[0] + viewport[2],
+                            viewport[1] + viewport[3],
+                            0.0,
+                            modelviewMatrix,
+                            projectionMatrix,
+                            viewport,
+                            &topRight[0],
+                            &topRight[1],
+                            &topRight[2]))) {
+        return;
+    }
+    const double visibleWidth  = topRight[0] - bottomLeft[0];
+    const double visibleHeight = topRight[1] - bottomLeft[1];
+    if ((visibleWidth <= 0.0)
+        || (visibleHeight <= 0.0)) {
+        return;
+    }
+    const float visibleMinX = std::max(bottomLeft[0], 0.0);
+    const float visibleMaxX = std::min(topRight[0], static_cast<double>(matrixWidth));
+    const float visibleMinY = std::max(bottomLeft[1], 0.0);
+    const float visibleMaxY = std::min(topRight[1], static_cast<double>(matrixHeight));
+    if ((visibleMinX >= visibleMaxX)
+        || (visibleMinY >= visibleMaxY)) {
+        return;
+    }
+    
+    /*
+     * Use the coarsest level in which a cell is at least one pixel and
+     * the region fits into a texture.
+     */
+    const float cellPixels = std::min(cellWidth * (viewport[2] / visibleWidth),
+                                      cellHeight * (viewport[3] / visibleHeight));
+    int32_t level = 0;
+    while (((cellPixels * (1 << level)) < 1.0)
+           && (level < 30)) {
+        level++;
+    }
+    
+    GLint maximumTextureSize = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maximumTextureSize);
+    maximumTextureSize = std::max(maximumTextureSize, 64);
+    
+    float levelCellWidth = 0.0;
+    float levelCellHeight = 0.0;
+    int32_t firstRow = 0;
+    int32_t firstColumn = 0;
+    int32_t regionRows = 0;
+    int32_t regionColumns = 0;
+    while (true) {
+        const int32_t levelScale = (1 << level);
+        const int32_t levelRows    = (numberOfRows + levelScale - 1) / levelScale;
+        const int32_t levelColumns = (numberOfColumns + levelScale - 1) / levelScale;
+        levelCellWidth  = cellWidth * levelScale;
+        levelCellHeight = cellHeight * levelScale;
+        
+        /*
+         * Row zero is at the top of the matrix.
+         */
+        firstColumn = std::min(static_cast<int32_t>(visibleMinX / levelCellWidth),
+                               levelColumns - 1);
+        const int32_t lastColumn = std::min(static_cast<int32_t>(std::ceil(visibleMaxX / levelCellWidth)),
+                                            levelColumns) - 1;
+        firstRow = std::min(static_cast<int32_t>((matrixHeight - visibleMaxY) / levelCellHeight),
+                            levelRows - 1);
+        const int32_t lastRow = std::min(static_cast<int32_t>(std::ceil((matrixHeight - visibleMinY) / levelCellHeight)),
+                                         levelRows) - 1;
+        regionColumns = std::max(lastColumn - firstColumn + 1, 1);
+        regionRows    = std::max(lastRow - firstRow + 1, 1);
+        
+        if (((regionColumns <= maximumTextureSize)
+             && (regionRows <= maximumTextureSize))
+            || (level >= 30)) {
+            break;
+        }
+        level++;
+    }
+    
+    std::vector<uint8_t> regionRGBA;
+    if ( ! chartMatrixInterface->getMatrixDataRGBAForRegion(level,
+                                                            firstRow,
+                                                            firstColumn,
+                                                            regionRows,
+                                                            regionColumns,
+                                                            regionRGBA)) {
+        return;
+    }
+    CaretAssert(static_cast<int64_t>(regionRGBA.size()) == (static_cast<int64_t>(regionRows) * regionColumns * 4));
+    
+    /*
+     * Texture dimensions are a power of two for older OpenGL.
+     */
+    int32_t textureWidth = 1;
+    while (textureWidth < regionColumns) {
+        textureWidth *= 2;
+    }
+    int32_t textureHeight = 1;
+    while (textureHeight < regionRows) {
+        textureHeight *= 2;
+    }
+    
+    GLuint textureName = 0;
+    glGenTextures(1, &textureName);
+    glBindTexture(GL_TEXTURE_2D, textureName);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP);
+    glTexImage2D(GL_TEXTURE_2D,
+                 0,
+                 GL_RGBA,
+                 textureWidth,
+                 textureHeight,
+                 0,
+                 GL_RGBA,
+                 GL_UNSIGNED_BYTE,
+                 NULL);
+    glTexSubImage2D(GL_TEXTURE_2D,
+                    0,
+                    0,
+                    0,
+                    regionColumns,
+                    regionRows,
+                    GL_RGBA,
+                    GL_UNSIGNED_BYTE,
+                    &regionRGBA[0]);
+    glTexEnvf(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_REPLACE);
+    
+    /*
+     * The last row and column of a reduced level may cover fewer
+     * cells than the others, so clip the quad at the edge of the matrix.
+     */
+    const float quadMinX = firstColumn * levelCellWidth;
+    const float quadMaxX = std::min((firstColumn + regionColumns) * levelCellWidth,
+                                    matrixWidth);
+    const float quadMaxY = matrixHeight - (firstRow * levelCellHeight);
+    const float quadMinY = std::max(matrixHeight - ((firstRow + regionRows) * levelCellHeight),
+                                    0.0f);
+    const float maxS = ((quadMaxX - quadMinX) / levelCellWidth) / textureWidth;
+    const float maxT = ((quadMaxY - quadMinY) / levelCellHeight) / textureHeight;
+    
+    /*
+     * Blend as when each cell is drawn as a quad.
+     */
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glEnable(GL_TEXTURE_2D);
+    
+    glBegin(GL_QUADS);
+    glTexCoord2f(0.0, maxT);
+    glVertex3f(quadMinX, quadMinY, 0.0);
+    glTexCoord2f(maxS, maxT);
+    glVertex3f(quadMaxX, quadMinY, 0.0);
+    glTexCoord2f(maxS, 0.0);
+    glVertex3f(quadMaxX, quadMaxY, 0.0);
+    glTexCoord2f(0.0, 0.0);
+    glVertex3f(quadMinX, quadMaxY, 0.0);
+    glEnd();
+    
+    glDisable(GL_TEXTURE_2D);
+    glDisable(GL_BLEND);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glDeleteTextures(1, &textureName);
+    
+    /*
+     * Grid lines are only useful when each cell is drawn.
+     */
+    if (displayGridLinesFlag
+        && (level == 0)) {
+        CaretPreferences* prefs = SessionManager::get()->getCaretPreferences();
+        uint8_t gridLineColorBytes[3];
+        prefs->getColorChartMatrixGridLines(gridLineColorBytes);
+        
+        glLineWidth(1.0);
+        glColor3ubv(gridLineColorBytes);
+        glBegin(GL_LINES);
+        for (int32_t iCol = 0; iCol <= regionColumns; iCol++) {
+            const float x = std::min((firstColumn + iCol) * cellWidth,
+                                     matrixWidth);
+            glVertex3f(x, quadMinY, 0.0);
+            glVertex3f(x, quadMaxY, 0.0);
+        }
+        for (int32_t iRow = 0; iRow <= regionRows; iRow++) {
+            const float y = std::max(matrixHeight - ((firstRow + iRow) * cellHeight),
+                                     0.0f);
+            glVertex3f(quadMinX, y, 0.0);
+            glVertex3f(quadMaxX, y, 0.0);
+        }
+        glEnd();
+    }
+}
+
 /**
  * Save the state of OpenGL.
  * Copied from Qt's qgl.cpp, qt_save_gl_state().
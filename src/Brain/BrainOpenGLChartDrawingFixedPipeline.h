@@ -90,6 +90,13 @@ namespace caret {
                                      ChartableMatrixInterface* chartMatrixInterface,
                                      const int32_t scalarDataSeriesMapIndex);
 
+        void drawChartGraphicsMatrixTiles(ChartableMatrixInterface* chartMatrixInterface,
+                                          const int32_t numberOfRows,
+                                          const int32_t numberOfColumns,
+                                          const float cellWidth,
+                                          const float cellHeight,
+                                          const bool displayGridLinesFlag);
+
         void drawChartGraphicsBoxAndSetViewport(const float vpX,
                                const float vpY,
                                const float vpWidth,
@@ -170,11 +177,15 @@ namespace caret {
 
         static const int32_t IDENTIFICATION_INDICES_PER_CHART_LINE;
         static const int32_t IDENTIFICATION_INDICES_PER_MATRIX_ELEMENT;
+        
+        /** Matrices with more cells than this are drawn by region at reduced resolution */
+        static const int64_t MATRIX_TILE_DRAWING_MINIMUM_CELLS;
     };
     
 #ifdef __BRAIN_OPEN_G_L_CHART_DRAWING_FIXED_PIPELINE_DECLARE__
     const int32_t BrainOpenGLChartDrawingFixedPipeline::IDENTIFICATION_INDICES_PER_CHART_LINE = 2;
     const int32_t BrainOpenGLChartDrawingFixedPipeline::IDENTIFICATION_INDICES_PER_MATRIX_ELEMENT = 2;
+    const int64_t BrainOpenGLChartDrawingFixedPipeline::MATRIX_TILE_DRAWING_MINIMUM_CELLS = 512 * 512;
 #endif // __BRAIN_OPEN_G_L_CHART_DRAWING_FIXED_PIPELINE_DECLARE__
 
 } // namespace
@@ -46,6 +46,7 @@
 #include "BrainOpenGLShapeCube.h"
 #include "BrainOpenGLShapeCylinder.h"
 #include "BrainOpenGLShapeSphere.h"
+#include "BrainOpenGLSurfaceBuffers.h"
 #include "BrainOpenGLViewportContent.h"
 #include "BrainStructure.h"
 #include "BrowserTabContent.h"
@@ -118,6 +119,7 @@
 #include "PaletteFile.h"
 #include "PaletteScalarAndColor.h"
 #include "Plane.h"
+#include "RayIntersectionHelper.h"
 #include "SessionManager.h"
 #include "Surface.h"
 #include "SurfaceMontageViewport.h"
@@ -156,6 +158,7 @@ BrainOpenGLFixedPipeline::BrainOpenGLFixedPipeline(BrainOpenGLTextRenderInterfac
     m_shapeCube   = NULL;
     m_shapeCubeRounded = NULL;
     this->surfaceNodeColoring = new SurfaceNodeColoring();
+    m_surfaceBuffers = new BrainOpenGLSurfaceBuffers();
     m_brain = NULL;
     m_clippingPlaneGroup = NULL;
 }
@@ -189,6 +192,10 @@ BrainOpenGLFixedPipeline::~BrainOpenGLFixedPipeline()
         delete this->surfaceNodeColoring;
         this->surfaceNodeColoring = NULL;
     }
+    if (m_surfaceBuffers != NULL) {
+        delete m_surfaceBuffers;
+        m_surfaceBuffers = NULL;
+    }
     delete this->colorIdentification;
     this->colorIdentification = NULL;
 }
@@ -366,6 +373,8 @@ BrainOpenGLFixedPipeline::drawModels(std::vector<BrainOpenGLViewportContent*>& v
     
     this->checkForOpenGLError(NULL, "At beginning of drawModels()");
     
+    m_surfaceBuffers->startFrame();
+    
     /*
      * Default the background colors to first model
      * NOTE: If there are no models, the surface background color is used
@@ -1363,10 +1372,21 @@ BrainOpenGLFixedPipeline::drawSurface(Surface* surface,
              */
             glShadeModel(GL_FLAT); 
             if (drawingType != SurfaceDrawingTypeEnum::DRAW_HIDE) {
-                this->drawSurfaceNodes(surface,
-                                       nodeColoringRGBA);
-                this->drawSurfaceTriangles(surface,
+                /*
+                 * Triangles are identified by casting a ray from the mouse
+                 * which avoids drawing every node and triangle with
+                 * an identification color.
+                 */
+                bool identifiedWithRay = false;
+                if (drawingType == SurfaceDrawingTypeEnum::DRAW_AS_TRIANGLES) {
+                    identifiedWithRay = this->identifySurfaceWithRayCast(surface);
+                }
+                if ( ! identifiedWithRay) {
+                    this->drawSurfaceNodes(surface,
                                            nodeColoringRGBA);
+                    this->drawSurfaceTriangles(surface,
+                                               nodeColoringRGBA);
+                }
             }
 
             this->disableClippingPlanes();
@@ -1388,8 +1408,14 @@ BrainOpenGLFixedPipeline::drawSurface(Surface* surface,
              */
             glShadeModel(GL_FLAT);
             if (drawingType != SurfaceDrawingTypeEnum::DRAW_HIDE) {
-                this->drawSurfaceTriangles(surface,
-                                           nodeColoringRGBA);
+                bool projectedWithRay = false;
+                if (drawingType == SurfaceDrawingTypeEnum::DRAW_AS_TRIANGLES) {
+                    projectedWithRay = this->identifySurfaceWithRayCast(surface);
+                }
+                if ( ! projectedWithRay) {
+                    this->drawSurfaceTriangles(surface,
+                                               nodeColoringRGBA);
+                }
             }
             /*
              * Re-enable shading since ID info is encoded in rgba coloring
@@ -1703,6 +1729,214 @@ BrainOpenGLFixedPipeline::drawSurfaceTriangles(Surface* surface,
     }
 }
 
+/**
+ * Identify the triangle and node beneath the mouse (or, in projection
+ * mode, the projected position) by casting a ray from the mouse through
+ * the surface.  Unlike drawSurfaceTriangles() and drawSurfaceNodes(),
+ * nothing is drawn and no pixels are read.  The nearest intersection
+ * that is not removed by the clipping planes is used.
+ *
+ * @param surface
+ *    Surface that is identified.
+ * @return
+ *    True if the ray was cast (even if it missed the surface), false if
+ *    the ray could not be created and identification must be performed
+ *    by drawing.
+ */
+bool
+BrainOpenGLFixedPipeline::identifySurfaceWithRayCast(Surface* surface)
+{
+    SelectionItemSurfaceTriangle* triangleID = NULL;
+    SelectionItemSurfaceNode* nodeID = NULL;
+    bool isProjection = false;
+    switch (this->mode) {
+        case MODE_DRAWING:
+            return false;
+            break;
+        case MODE_IDENTIFICATION:
+            triangleID = m_brain->getSelectionManager()->getSurfaceTriangleIdentification();
+            if ( ! triangleID->isEnabledForSelection()) {
+                triangleID = NULL;
+            }
+            nodeID = m_brain->getSelectionManager()->getSurfaceNodeIdentification();
+            if ( ! nodeID->isEnabledForSelection()) {
+                nodeID = NULL;
+            }
+            if ((triangleID == NULL)
+                && (nodeID == NULL)) {
+                return true;
+            }
+            break;
+        case MODE_PROJECTION:
+            isProjection = true;
+            break;
+    }
+    
+    if (surface->getNumberOfTriangles() <= 0) {
+        return true;
+    }
+    
+    GLdouble selectionModelviewMatrix[16];
+    glGetDoublev(GL_MODELVIEW_MATRIX, selectionModelviewMatrix);
+    
+    GLdouble selectionProjectionMatrix[16];
+    glGetDoublev(GL_PROJECTION_MATRIX, selectionProjectionMatrix);
+    
+    GLint selectionViewport[4];
+    glGetIntegerv(GL_VIEWPORT, selectionViewport);
+    
+    /*
+     * Ray from the near clipping plane to the far clipping plane
+     * through the mouse position, in model coordinates
+     */
+    double nearXYZ[3];
+    double farXYZ[3];
+    if ( ! (gluUnProject(this->mouseX,
+                         this->mouseY,
+                         0.0,
+                         selectionModelviewMatrix,
+                         selectionProjectionMatrix,
+                         selectionViewport,
+                         &nearXYZ[0],
+                         &nearXYZ[1],
+                         &nearXYZ[2])
+            && gluUnProject(this->mouseX,
+                            this->mouseY,
+                            1.0,
+                            selectionModelviewMatrix,
+                            selectionProjectionMatrix,
+                            selectionViewport,
+                            &farXYZ[0],
+                            &farXYZ[1],
+                            &farXYZ[2]))) {
+        return false;
+    }
+    const float rayOrigin[3] = {
+        static_cast<float>(nearXYZ[0]),
+        static_cast<float>(nearXYZ[1]),
+        static_cast<float>(nearXYZ[2])
+    };
+    const float rayDirection[3] = {
+        static_cast<float>(farXYZ[0] - nearXYZ[0]),
+        static_cast<float>(farXYZ[1] - nearXYZ[1]),
+        static_cast<float>(farXYZ[2] - nearXYZ[2])
+    };
+    
+    const StructureEnum::Enum structure = surface->getStructure();
+    bool testClipping = false;
+    if (browserTabContent != NULL) {
+        CaretAssert(m_clippingPlaneGroup);
+        testClipping = m_clippingPlaneGroup->isSurfaceSelected();
+    }
+    
+    CaretPointer<const RayIntersectionHelper> rayHelper = surface->getRayIntersectionHelper();
+    RayIntersection hit;
+    bool haveHit = false;
+    if (testClipping) {
+        std::vector<RayIntersection> allHits;
+        rayHelper->allIntersections(rayOrigin,
+                                    rayDirection,
+                                    allHits);
+        for (std::vector<RayIntersection>::iterator iter = allHits.begin();
+             iter != allHits.end();
+             iter++) {
+            if (isCoordinateInsideClippingPlanesForStructure(structure,
+                                                             iter->point)) {
+                hit = *iter;
+                haveHit = true;
+                break;
+            }
+        }
+    }
+    else {
+        haveHit = rayHelper->closestIntersection(rayOrigin,
+                                                 rayDirection,
+                                                 hit);
+    }
+    if ( ! haveHit) {
+        return true;
+    }
+    
+    /*
+     * Screen depth of the intersection is same as value read from depth buffer
+     */
+    double hitWindowXYZ[3];
+    if ( ! gluProject(hit.point[0],
+                      hit.point[1],
+                      hit.point[2],
+                      selectionModelviewMatrix,
+                      selectionProjectionMatrix,
+                      selectionViewport,
+                      &hitWindowXYZ[0],
+                      &hitWindowXYZ[1],
+                      &hitWindowXYZ[2])) {
+        return true;
+    }
+    const float depth = hitWindowXYZ[2];
+    
+    if (isProjection) {
+        this->setProjectionModeData(depth,
+                                    hit.point,
+                                    structure,
+                                    hit.baryWeights,
+                                    hit.nodes,
+                                    surface->getNumberOfNodes());
+        return true;
+    }
+    
+    const float* nearestNodeXYZ = surface->getCoordinate(hit.nearestNode);
+    const double nearestNodeModelXYZ[3] = {
+        nearestNodeXYZ[0],
+        nearestNodeXYZ[1],
+        nearestNodeXYZ[2]
+    };
+    double nearestNodeWindowXYZ[3];
+    const bool haveNearestNodeWindowXYZ = gluProject(nearestNodeModelXYZ[0],
+                                                     nearestNodeModelXYZ[1],
+                                                     nearestNodeModelXYZ[2],
+                                                     selectionModelviewMatrix,
+                                                     selectionProjectionMatrix,
+                                                     selectionViewport,
+                                                     &nearestNodeWindowXYZ[0],
+                                                     &nearestNodeWindowXYZ[1],
+                                                     &nearestNodeWindowXYZ[2]);
+    
+    if (triangleID != NULL) {
+        if (triangleID->isOtherScreenDepthCloserToViewer(depth)) {
+            triangleID->setBrain(surface->getBrainStructure()->getBrain());
+            triangleID->setSurface(surface);
+            triangleID->setTriangleNumber(hit.triangle);
+            triangleID->setNearestNode(hit.nearestNode);
+            triangleID->setScreenDepth(depth);
+            this->setSelectedItemScreenXYZ(triangleID, hit.point);
+            if (haveNearestNodeWindowXYZ) {
+                triangleID->setNearestNodeScreenXYZ(nearestNodeWindowXYZ);
+                triangleID->setNearestNodeModelXYZ(nearestNodeModelXYZ);
+            }
+            CaretLogFine("Selected Triangle: " + triangleID->toString());
+        }
+        else {
+            CaretLogFine("Rejecting Selected Triangle but still using: " + triangleID->toString());
+        }
+    }
+    
+    if (nodeID != NULL) {
+        if (nodeID->isOtherScreenDepthCloserToViewer(depth)) {
+            nodeID->setBrain(surface->getBrainStructure()->getBrain());
+            nodeID->setSurface(surface);
+            nodeID->setNodeNumber(hit.nearestNode);
+            nodeID->setScreenDepth(depth);
+            this->setSelectedItemScreenXYZ(nodeID, nearestNodeXYZ);
+            CaretLogFine("Selected Vertex: " + nodeID->toString());
+        }
+        else {
+            CaretLogFine("Rejecting Selected Vertex: " + nodeID->toString());
+        }
+    }
+    
+    return true;
+}
+
 /**
  * During projection mode, set the projected data.  If the 
  * projection data is already set, it will be overridden
@@ -1852,6 +2086,17 @@ void
 BrainOpenGLFixedPipeline::drawSurfaceTrianglesWithVertexArrays(const Surface* surface,
                                                                const float* nodeColoringRGBA)
 {
+    /*
+     * When vertex buffers are available, the surface geometry and
+     * coloring are kept on the graphics card and only uploaded
+     * when they change.
+     */
+    if (m_surfaceBuffers->drawTriangles(surface,
+                                        nodeColoringRGBA,
+                                        m_backgroundColorFloat)) {
+        return;
+    }
+    
     glEnableClientState(GL_VERTEX_ARRAY);
     if (nodeColoringRGBA != NULL) {
         glEnableClientState(GL_COLOR_ARRAY);
@@ -51,6 +51,7 @@ namespace caret {
     class BrainOpenGLShapeCube;
     class BrainOpenGLShapeCylinder;
     class BrainOpenGLShapeSphere;
+    class BrainOpenGLSurfaceBuffers;
     class BrainOpenGLViewportContent;
     class BrowserTabContent;
     class CaretMappableDataFile;
@@ -184,6 +185,8 @@ namespace caret {
         void drawSurfaceTriangles(Surface* surface,
                                   const float* nodeColoringRGBA);
         
+        bool identifySurfaceWithRayCast(Surface* surface);
+        
         void drawSurfaceNodeAttributes(Surface* surface);
         
         void drawSurfaceBorderBeingDrawn(const Surface* surface);
@@ -519,6 +522,9 @@ namespace caret {
         
         /** Performs node coloring */
         SurfaceNodeColoring* surfaceNodeColoring;
+        
+        /** Surface geometry and coloring kept in vertex buffers */
+        BrainOpenGLSurfaceBuffers* m_surfaceBuffers;
          
         /** Sphere symbol */
         BrainOpenGLShapeSphere* m_shapeSphere;
@@ -0,0 +1,413 @@
+
+/*LICENSE_START*/
+/*
+ *  Copyright (C) 2014  Washington University School of Medicine
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+/*LICENSE_END*/
+
+#define __BRAIN_OPEN_GL_SURFACE_BUFFERS_DECLARE__
+#include "BrainOpenGLSurfaceBuffers.h"
+#undef __BRAIN_OPEN_GL_SURFACE_BUFFERS_DECLARE__
+
+#include "CaretAssert.h"
+#include "CaretLogger.h"
+#include "CaretOMP.h"
+#include "Surface.h"
+
+using namespace caret;
+
+
+
+/**
+ * \class caret::BrainOpenGLSurfaceBuffers
+ * \brief Keeps surface geometry and coloring in OpenGL vertex buffers.
+ *
+ * Coordinates, normal vectors, and triangles of a surface are uploaded
+ * once and are only uploaded again when the surface's geometry
+ * modification number changes.  Each node coloring of a surface (there
+ * is one for each tab and model type that displays the surface) has its
+ * own color buffer that is uploaded only when the surface's coloring
+ * modification number changes.  Colors are converted to bytes before
+ * upload to reduce the amount of data transferred.
+ *
+ * Buffer IDs belong to the OpenGL context in which they are created,
+ * so an instance must only be used with one context, which must be
+ * current when any method is called.
+ */
+
+/**
+ * Constructor.
+ */
+BrainOpenGLSurfaceBuffers::BrainOpenGLSurfaceBuffers()
+: CaretObject()
+{
+    m_frameNumber = 0;
+}
+
+/**
+ * Destructor.
+ */
+BrainOpenGLSurfaceBuffers::~BrainOpenGLSurfaceBuffers()
+{
+    releaseAllBuffers();
+}
+
+/**
+ * Start drawing of a new frame.  Buffers for surfaces or colorings that
+ * have not been drawn recently are released, which also disposes of
+ * buffers for surfaces that no longer exist.
+ */
+void
+BrainOpenGLSurfaceBuffers::startFrame()
+{
+    ++m_frameNumber;
+
+    std::map<const Surface*, SurfaceBuffers>::iterator surfaceIter = m_surfaceBuffers.begin();
+    while (surfaceIter != m_surfaceBuffers.end()) {
+        SurfaceBuffers& buffers = surfaceIter->second;
+        if ((m_frameNumber - buffers.m_lastFrameUsed) > s_framesUntilRelease) {
+            releaseSurfaceBuffers(buffers);
+            m_surfaceBuffers.erase(surfaceIter++);
+            continue;
+        }
+
+        std::map<const float*, ColorBuffer>::iterator colorIter = buffers.m_colorBuffers.begin();
+        while (colorIter != buffers.m_colorBuffers.end()) {
+            if ((m_frameNumber - colorIter->second.m_lastFrameUsed) > s_framesUntilRelease) {
+                releaseBufferID(colorIter->second.m_bufferID);
+                buffers.m_colorBuffers.erase(colorIter++);
+            }
+            else {
+                ++colorIter;
+            }
+        }
+        ++surfaceIter;
+    }
+}
+
+/**
+ * Draw the triangles of a surface using vertex buffers.
+ *
+ * @param surface
+ *    Surface that is drawn.
+ * @param nodeColoringRGBA
+ *    RGBA coloring for the nodes.  If NULL, the surface is drawn
+ *    with the background color.
+ * @param backgroundRGB
+ *    The background color.
+ * @return
+ *    True if the surface was drawn, false if vertex buffers are not
+ *    available in which case the caller must draw the surface.
+ */
+bool
+BrainOpenGLSurfaceBuffers::drawTriangles(const Surface* surface,
+                                         const float* nodeColoringRGBA,
+                                         const float backgroundRGB[3])
+{
+    CaretAssert(surface);
+
+#ifdef BRAIN_OPENGL_INFO_SUPPORTS_VERTEX_BUFFERS
+    if (BrainOpenGL::getBestDrawingMode() != BrainOpenGL::DRAW_MODE_VERTEX_BUFFERS) {
+        return false;
+    }
+    if ((surface->getNumberOfNodes() <= 0)
+        || (surface->getNumberOfTriangles() <= 0)) {
+        return true;
+    }
+
+    SurfaceBuffers& buffers = m_surfaceBuffers[surface];
+    buffers.m_lastFrameUsed = m_frameNumber;
+    updateGeometry(surface,
+                   buffers);
+    if ((buffers.m_coordinateBufferID == 0)
+        || (buffers.m_normalBufferID == 0)
+        || (buffers.m_triangleBufferID == 0)) {
+        return false;
+    }
+
+    GLuint colorBufferID = 0;
+    if (nodeColoringRGBA != NULL) {
+        ColorBuffer& colorBuffer = buffers.m_colorBuffers[nodeColoringRGBA];
+        colorBuffer.m_lastFrameUsed = m_frameNumber;
+        updateColoring(surface,
+                       nodeColoringRGBA,
+                       colorBuffer);
+        colorBufferID = colorBuffer.m_bufferID;
+        if (colorBufferID == 0) {
+            return false;
+        }
+    }
+
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_NORMAL_ARRAY);
+
+    glBindBuffer(GL_ARRAY_BUFFER,
+                 buffers.m_coordinateBufferID);
+    glVertexPointer(3,
+                    GL_FLOAT,
+                    0,
+                    (GLvoid*)0);
+
+    glBindBuffer(GL_ARRAY_BUFFER,
+                 buffers.m_normalBufferID);
+    glNormalPointer(GL_FLOAT,
+                    0,
+                    (GLvoid*)0);
+
+    if (colorBufferID > 0) {
+        glEnableClientState(GL_COLOR_ARRAY);
+        glBindBuffer(GL_ARRAY_BUFFER,
+                     colorBufferID);
+        glColorPointer(4,
+                       GL_UNSIGNED_BYTE,
+                       0,
+                       (GLvoid*)0);
+    }
+    else {
+        glColor3fv(backgroundRGB);
+    }
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER,
+                 buffers.m_triangleBufferID);
+    glDrawElements(GL_TRIANGLES,
+                   (3 * buffers.m_numberOfTriangles),
+                   GL_UNSIGNED_INT,
+                   (GLvoid*)0);
+
+    /*
+     * Deselect active buffer.
+     */
+    glBindBuffer(GL_ARRAY_BUFFER,
+                 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER,
+                 0);
+
+    glDisableClientState(GL_VERTEX_ARRAY);
+    glDisableClientState(GL_COLOR_ARRAY);
+    glDisableClientState(GL_NORMAL_ARRAY);
+
+    return true;
+#else // BRAIN_OPENGL_INFO_SUPPORTS_VERTEX_BUFFERS
+    return false;
+#endif // BRAIN_OPENGL_INFO_SUPPORTS_VERTEX_BUFFERS
+}
+
+/**
+ * Upload the coordinates, normals, and triangles of the surface if they
+ * have not been uploaded or have changed since they were uploaded.
+ *
+ * @param surface
+ *    The surface.
+ * @param buffers
+ *    Buffers for the surface.
+ */
+void
+BrainOpenGLSurfaceBuffers::updateGeometry(const Surface* surface,
+                                          SurfaceBuffers& buffers)
+{
+#ifdef BRAIN_OPENGL_INFO_SUPPORTS_VERTEX_BUFFERS
+    const int64_t geometryModificationNumber = surface->getGeometryModificationNumber();
+    if ((buffers.m_geometryModificationNumber == geometryModificationNumber)
+        && (buffers.m_coordinateBufferID > 0)) {
+        return;
+    }
+
+    const int32_t numberOfNodes = surface->getNumberOfNodes();
+    const int32_t numberOfTriangles = surface->getNumberOfTriangles();
+
+    /*
+     * Node count change invalidates all colorings
+     */
+    if (numberOfNodes != buffers.m_numberOfNodes) {
+        for (std::map<const float*, ColorBuffer>::iterator iter = buffers.m_colorBuffers.begin();
+             iter != buffers.m_colorBuffers.end();
+             iter++) {
+            iter->second.m_coloringModificationNumber = -1;
+        }
+    }
+
+    if (buffers.m_coordinateBufferID == 0) {
+        buffers.m_coordinateBufferID = createBufferID();
+    }
+    if (buffers.m_normalBufferID == 0) {
+        buffers.m_normalBufferID = createBufferID();
+    }
+    if (buffers.m_triangleBufferID == 0) {
+        buffers.m_triangleBufferID = createBufferID();
+    }
+    if ((buffers.m_coordinateBufferID == 0)
+        || (buffers.m_normalBufferID == 0)
+        || (buffers.m_triangleBufferID == 0)) {
+        return;
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER,
+                 buffers.m_coordinateBufferID);
+    glBufferData(GL_ARRAY_BUFFER,
+                 numberOfNodes * 3 * sizeof(GLfloat),
+                 surface->getCoordinateData(),
+                 GL_STATIC_DRAW);
+
+    glBindBuffer(GL_ARRAY_BUFFER,
+                 buffers.m_normalBufferID);
+    glBufferData(GL_ARRAY_BUFFER,
+                 numberOfNodes * 3 * sizeof(GLfloat),
+                 surface->getNormalData(),
+                 GL_STATIC_DRAW);
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER,
+                 buffers.m_triangleBufferID);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER,
+                 numberOfTriangles * 3 * sizeof(GLuint),
+                 surface->getTriangle(0),
+                 GL_STATIC_DRAW);
+
+    glBindBuffer(GL_ARRAY_BUFFER,
+                 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER,
+                 0);
+
+    buffers.m_numberOfNodes = numberOfNodes;
+    buffers.m_numberOfTriangles = numberOfTriangles;
+    buffers.m_geometryModificationNumber = geometryModificationNumber;
+#endif // BRAIN_OPENGL_INFO_SUPPORTS_VERTEX_BUFFERS
+}
+
+/**
+ * Upload the node coloring if it has not been uploaded or the coloring
+ * of the surface has changed since it was uploaded.
+ *
+ * @param surface
+ *    The surface.
+ * @param nodeColoringRGBA
+ *    RGBA coloring for the nodes.
+ * @param colorBuffer
+ *    Buffer for the coloring.
+ */
+void
+BrainOpenGLSurfaceBuffers::updateColoring(const Surface* surface,
+                                          const float* nodeColoringRGBA,
+                                          ColorBuffer& colorBuffer)
+{
+#ifdef BRAIN_OPENGL_INFO_SUPPORTS_VERTEX_BUFFERS
+    const int64_t coloringModificationNumber = surface->getNodeColoringModificationNumber(nodeColoringRGBA);
+    if ((colorBuffer.m_coloringModificationNumber == coloringModificationNumber)
+        && (colorBuffer.m_bufferID > 0)) {
+        return;
+    }
+
+    if (colorBuffer.m_bufferID == 0) {
+        colorBuffer.m_bufferID = createBufferID();
+        if (colorBuffer.m_bufferID == 0) {
+            return;
+        }
+    }
+
+    const int64_t numberOfComponents = static_cast<int64_t>(surface->getNumberOfNodes()) * 4;
+    m_rgbaByteScratch.resize(numberOfComponents);
+    uint8_t* rgbaByte = &m_rgbaByteScratch[0];
+#pragma omp CARET_PARFOR schedule(static)
+    for (int64_t i = 0; i < numberOfComponents; i++) {
+        float value = nodeColoringRGBA[i];
+        if (value < 0.0f) value = 0.0f;
+        if (value > 1.0f) value = 1.0f;
+        rgbaByte[i] = static_cast<uint8_t>(value * 255.0f + 0.5f);
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER,
+                 colorBuffer.m_bufferID);
+    glBufferData(GL_ARRAY_BUFFER,
+                 numberOfComponents * sizeof(GLubyte),
+                 rgbaByte,
+                 GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER,
+                 0);
+
+    colorBuffer.m_coloringModificationNumber = coloringModificationNumber;
+#endif // BRAIN_OPENGL_INFO_SUPPORTS_VERTEX_BUFFERS
+}
+
+/**
+ * Release all buffers for all surfaces.
+ */
+void
+BrainOpenGLSurfaceBuffers::releaseAllBuffers()
+{
+    for (std::map<const Surface*, SurfaceBuffers>::iterator iter = m_surfaceBuffers.begin();
+         iter != m_surfaceBuffers.end();
+         iter++) {
+        releaseSurfaceBuffers(iter->second);
+    }
+    m_surfaceBuffers.clear();
+}
+
+/**
+ * Release the buffers for one surface.
+ *
+ * @param buffers
+ *    Buffers for the surface.
+ */
+void
+BrainOpenGLSurfaceBuffers::releaseSurfaceBuffers(SurfaceBuffers& buffers)
+{
+    releaseBufferID(buffers.m_coordinateBufferID);
+    releaseBufferID(buffers.m_normalBufferID);
+    releaseBufferID(buffers.m_triangleBufferID);
+    for (std::map<const float*, ColorBuffer>::iterator iter = buffers.m_colorBuffers.begin();
+         iter != buffers.m_colorBuffers.end();
+         iter++) {
+        releaseBufferID(iter->second.m_bufferID);
+    }
+    buffers.m_colorBuffers.clear();
+}
+
+/**
+ * @return A new buffer ID for use with OpenGL.
+ * A return value of zero indicates that creation of buffer ID failed.
+ */
+GLuint
+BrainOpenGLSurfaceBuffers::createBufferID()
+{
+    GLuint id = 0;
+#ifdef BRAIN_OPENGL_INFO_SUPPORTS_VERTEX_BUFFERS
+    glGenBuffers(1, &id);
+    if (id == 0) {
+        CaretLogSevere("Failed to create a new OpenGL Vertex Buffer for surface");
+    }
+#endif // BRAIN_OPENGL_INFO_SUPPORTS_VERTEX_BUFFERS
+    return id;
+}
+
+/**
+ * Release a buffer ID and set it to zero.
+ *
+ * @param bufferID
+ *    Buffer ID that was previously returned by createBufferID().
+ */
+void
+BrainOpenGLSurfaceBuffers::releaseBufferID(GLuint& bufferID)
+{
+#ifdef BRAIN_OPENGL_INFO_SUPPORTS_VERTEX_BUFFERS
+    if (bufferID > 0) {
+        if (glIsBuffer(bufferID)) {
+            glDeleteBuffers(1, &bufferID);
+        }
+    }
+#endif // BRAIN_OPENGL_INFO_SUPPORTS_VERTEX_BUFFERS
+    bufferID = 0;
+}
+
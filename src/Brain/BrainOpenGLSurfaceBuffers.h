@@ -0,0 +1,121 @@
+#ifndef __BRAIN_OPEN_GL_SURFACE_BUFFERS__H_
+#define __BRAIN_OPEN_GL_SURFACE_BUFFERS__H_
+
+/*LICENSE_START*/
+/*
+ *  Copyright (C) 2014  Washington University School of Medicine
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+/*LICENSE_END*/
+
+#include <map>
+#include <stdint.h>
+#include <vector>
+
+#include "BrainOpenGL.h"
+
+namespace caret {
+
+    class Surface;
+
+    class BrainOpenGLSurfaceBuffers : public CaretObject {
+
+    public:
+        BrainOpenGLSurfaceBuffers();
+
+        virtual ~BrainOpenGLSurfaceBuffers();
+
+        // ADD_NEW_METHODS_HERE
+
+        void startFrame();
+
+        bool drawTriangles(const Surface* surface,
+                           const float* nodeColoringRGBA,
+                           const float backgroundRGB[3]);
+
+        void releaseAllBuffers();
+
+    private:
+        BrainOpenGLSurfaceBuffers(const BrainOpenGLSurfaceBuffers&);
+
+        BrainOpenGLSurfaceBuffers& operator=(const BrainOpenGLSurfaceBuffers&);
+
+        /** Buffer holding one set of node colors for a surface */
+        struct ColorBuffer {
+            ColorBuffer() : m_bufferID(0), m_coloringModificationNumber(-1), m_lastFrameUsed(0) { }
+
+            GLuint m_bufferID;
+
+            int64_t m_coloringModificationNumber;
+
+            int64_t m_lastFrameUsed;
+        };
+
+        /** Buffers holding the geometry of one surface and all of its colorings */
+        struct SurfaceBuffers {
+            SurfaceBuffers() : m_coordinateBufferID(0), m_normalBufferID(0), m_triangleBufferID(0),
+                m_numberOfNodes(0), m_numberOfTriangles(0), m_geometryModificationNumber(-1), m_lastFrameUsed(0) { }
+
+            GLuint m_coordinateBufferID;
+
+            GLuint m_normalBufferID;
+
+            GLuint m_triangleBufferID;
+
+            int32_t m_numberOfNodes;
+
+            int32_t m_numberOfTriangles;
+
+            int64_t m_geometryModificationNumber;
+
+            int64_t m_lastFrameUsed;
+
+            /** Keyed by the address of the coloring, one per tab/model using the surface */
+            std::map<const float*, ColorBuffer> m_colorBuffers;
+        };
+
+        void updateGeometry(const Surface* surface,
+                            SurfaceBuffers& buffers);
+
+        void updateColoring(const Surface* surface,
+                            const float* nodeColoringRGBA,
+                            ColorBuffer& colorBuffer);
+
+        void releaseSurfaceBuffers(SurfaceBuffers& buffers);
+
+        GLuint createBufferID();
+
+        void releaseBufferID(GLuint& bufferID);
+
+        // ADD_NEW_MEMBERS_HERE
+
+        std::map<const Surface*, SurfaceBuffers> m_surfaceBuffers;
+
+        /** Conversion of float coloring to bytes before upload */
+        std::vector<uint8_t> m_rgbaByteScratch;
+
+        int64_t m_frameNumber;
+
+        /** Buffers not used for this many frames are released */
+        static const int64_t s_framesUntilRelease;
+    };
+
+#ifdef __BRAIN_OPEN_GL_SURFACE_BUFFERS_DECLARE__
+    const int64_t BrainOpenGLSurfaceBuffers::s_framesUntilRelease = 100;
+#endif // __BRAIN_OPEN_GL_SURFACE_BUFFERS_DECLARE__
+
+} // namespace
+#endif  //__BRAIN_OPEN_GL_SURFACE_BUFFERS__H_
@@ -35,6 +35,7 @@
 #include "ScenePrimitiveArray.h"
 #include "Surface.h"
 #include "SurfaceFile.h"
+#include "TopologyHelper.h"
 
 using namespace caret;
 
@@ -178,6 +179,18 @@ CiftiConnectivityMatrixDataFileManager::loadDataForSurfaceNode(Brain* brain,
     
     PaletteFile* paletteFile = brain->getPaletteFile();
     
+    /*
+     * Rows for nodes near the selected node are read in the background
+     * since they are likely to be selected next when the user drags
+     * the mouse.
+     */
+    std::vector<int32_t> neighborNodeIndices;
+    if ( ! ciftiMatrixFiles.empty()) {
+        surfaceFile->getTopologyHelper()->getNodeNeighborsToDepth(nodeIndex,
+                                                                  s_prefetchNeighborDepth,
+                                                                  neighborNodeIndices);
+    }
+    
     bool haveData = false;
     for (std::vector<CiftiMappableConnectivityMatrixDataFile*>::iterator iter = ciftiMatrixFiles.begin();
          iter != ciftiMatrixFiles.end();
@@ -195,6 +208,9 @@ CiftiConnectivityMatrixDataFileManager::loadDataForSurfaceNode(Brain* brain,
                                            columnIndex);
             cmf->updateScalarColoringForMap(mapIndex,
                                             paletteFile);
+            cmf->prefetchRowsForSurfaceNodes(surfaceFile->getNumberOfNodes(),
+                                             surfaceFile->getStructure(),
+                                             neighborNodeIndices);
             haveData = true;
             
             if (rowIndex >= 0) {
@@ -77,10 +77,13 @@ namespace caret {
     private:
 
         // ADD_NEW_MEMBERS_HERE
+        
+        /** Depth of neighbors of a selected node whose rows are prefetched */
+        static const int32_t s_prefetchNeighborDepth;
     };
     
 #ifdef __CIFTI_CONNECTIVITY_MATRIX_DATA_FILE_MANAGER_DECLARE__
-    // <PLACE DECLARATIONS OF STATIC MEMBERS HERE>
+    const int32_t CiftiConnectivityMatrixDataFileManager::s_prefetchNeighborDepth = 2;
 #endif // __CIFTI_CONNECTIVITY_MATRIX_DATA_FILE_MANAGER_DECLARE__
 
 } // namespace
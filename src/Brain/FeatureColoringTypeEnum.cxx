@@ -25,9 +25,19 @@
 #undef __FEATURE_COLORING_TYPE_ENUM_DECLARE__
 
 #include "CaretAssert.h"
+#include "CaretMutex.h"
 
 using namespace caret;
 
+namespace
+{
+    CaretMutex& getInitializeMutex()
+    {//function-local, so it exists even if the enum is first used while initializing another static
+        static CaretMutex s_initializeMutex;
+        return s_initializeMutex;
+    }
+}
+
     
 /**
  * \class caret::FeatureColoringTypeEnum 
@@ -69,10 +79,10 @@ FeatureColoringTypeEnum::~FeatureColoringTypeEnum()
 void
 FeatureColoringTypeEnum::initialize()
 {
+    CaretMutexLocker locker(&getInitializeMutex());//always lock, an unlocked check of the flag could see it set before the data it guards
     if (initializedFlag) {
         return;
     }
-    initializedFlag = true;
 
     enumData.push_back(FeatureColoringTypeEnum(FEATURE_COLORING_TYPE_CLASS,
                                                "FEATURE_COLORING_TYPE_CLASS",
@@ -81,6 +91,8 @@ FeatureColoringTypeEnum::initialize()
     enumData.push_back(FeatureColoringTypeEnum(FEATURE_COLORING_TYPE_NAME,
                                                "FEATURE_COLORING_TYPE_NAME",
                                                "Name"));
+    
+    initializedFlag = true;
 }
 
 /**
@@ -93,7 +105,7 @@ FeatureColoringTypeEnum::initialize()
 const FeatureColoringTypeEnum*
 FeatureColoringTypeEnum::findData(const Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
 
     size_t num = enumData.size();
     for (size_t i = 0; i < num; i++) {
@@ -115,7 +127,7 @@ FeatureColoringTypeEnum::findData(const Enum enumValue)
  */
 AString 
 FeatureColoringTypeEnum::toName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const FeatureColoringTypeEnum* enumInstance = findData(enumValue);
     return enumInstance->name;
@@ -146,7 +158,7 @@ FeatureColoringTypeEnum::fromName(const AString& nameIn, bool* isValidOut)
         name = "FEATURE_COLORING_TYPE_NAME";
     }
     
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = FEATURE_COLORING_TYPE_NAME;
@@ -180,7 +192,7 @@ FeatureColoringTypeEnum::fromName(const AString& nameIn, bool* isValidOut)
  */
 AString 
 FeatureColoringTypeEnum::toGuiName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const FeatureColoringTypeEnum* enumInstance = findData(enumValue);
     return enumInstance->guiName;
@@ -199,7 +211,7 @@ FeatureColoringTypeEnum::toGuiName(Enum enumValue) {
 FeatureColoringTypeEnum::Enum 
 FeatureColoringTypeEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = FEATURE_COLORING_TYPE_NAME;
@@ -233,7 +245,7 @@ FeatureColoringTypeEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 int32_t
 FeatureColoringTypeEnum::toIntegerCode(Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     const FeatureColoringTypeEnum* enumInstance = findData(enumValue);
     return enumInstance->integerCode;
 }
@@ -252,7 +264,7 @@ FeatureColoringTypeEnum::toIntegerCode(Enum enumValue)
 FeatureColoringTypeEnum::Enum
 FeatureColoringTypeEnum::fromIntegerCode(const int32_t integerCode, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = FEATURE_COLORING_TYPE_NAME;
@@ -287,7 +299,7 @@ FeatureColoringTypeEnum::fromIntegerCode(const int32_t integerCode, bool* isVali
 void
 FeatureColoringTypeEnum::getAllEnums(std::vector<FeatureColoringTypeEnum::Enum>& allEnums)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allEnums.clear();
     
@@ -309,7 +321,7 @@ FeatureColoringTypeEnum::getAllEnums(std::vector<FeatureColoringTypeEnum::Enum>&
 void
 FeatureColoringTypeEnum::getAllNames(std::vector<AString>& allNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allNames.clear();
     
@@ -335,7 +347,7 @@ FeatureColoringTypeEnum::getAllNames(std::vector<AString>& allNames, const bool
 void
 FeatureColoringTypeEnum::getAllGuiNames(std::vector<AString>& allGuiNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allGuiNames.clear();
     
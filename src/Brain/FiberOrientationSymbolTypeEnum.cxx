@@ -25,9 +25,19 @@
 #undef __FIBER_ORIENTATION_SYMBOL_TYPE_ENUM_DECLARE__
 
 #include "CaretAssert.h"
+#include "CaretMutex.h"
 
 using namespace caret;
 
+namespace
+{
+    CaretMutex& getInitializeMutex()
+    {//function-local, so it exists even if the enum is first used while initializing another static
+        static CaretMutex s_initializeMutex;
+        return s_initializeMutex;
+    }
+}
+
     
 /**
  * \class caret::FiberOrientationSymbolTypeEnum 
@@ -69,10 +79,10 @@ FiberOrientationSymbolTypeEnum::~FiberOrientationSymbolTypeEnum()
 void
 FiberOrientationSymbolTypeEnum::initialize()
 {
+    CaretMutexLocker locker(&getInitializeMutex());//always lock, an unlocked check of the flag could see it set before the data it guards
     if (initializedFlag) {
         return;
     }
-    initializedFlag = true;
 
     enumData.push_back(FiberOrientationSymbolTypeEnum(FIBER_SYMBOL_FANS,
                                     "FIBER_SYMBOL_FANS", 
@@ -82,6 +92,7 @@ FiberOrientationSymbolTypeEnum::initialize()
                                     "FIBER_SYMBOL_LINES", 
                                     "Lines"));
     
+    initializedFlag = true;
 }
 
 /**
@@ -94,7 +105,7 @@ FiberOrientationSymbolTypeEnum::initialize()
 const FiberOrientationSymbolTypeEnum*
 FiberOrientationSymbolTypeEnum::findData(const Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
 
     size_t num = enumData.size();
     for (size_t i = 0; i < num; i++) {
@@ -116,7 +127,7 @@ FiberOrientationSymbolTypeEnum::findData(const Enum enumValue)
  */
 AString 
 FiberOrientationSymbolTypeEnum::toName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const FiberOrientationSymbolTypeEnum* enumInstance = findData(enumValue);
     return enumInstance->name;
@@ -135,7 +146,7 @@ FiberOrientationSymbolTypeEnum::toName(Enum enumValue) {
 FiberOrientationSymbolTypeEnum::Enum 
 FiberOrientationSymbolTypeEnum::fromName(const AString& name, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = FIBER_SYMBOL_LINES;
@@ -169,7 +180,7 @@ FiberOrientationSymbolTypeEnum::fromName(const AString& name, bool* isValidOut)
  */
 AString 
 FiberOrientationSymbolTypeEnum::toGuiName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const FiberOrientationSymbolTypeEnum* enumInstance = findData(enumValue);
     return enumInstance->guiName;
@@ -188,7 +199,7 @@ FiberOrientationSymbolTypeEnum::toGuiName(Enum enumValue) {
 FiberOrientationSymbolTypeEnum::Enum 
 FiberOrientationSymbolTypeEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = FIBER_SYMBOL_LINES;
@@ -222,7 +233,7 @@ FiberOrientationSymbolTypeEnum::fromGuiName(const AString& guiName, bool* isVali
 int32_t
 FiberOrientationSymbolTypeEnum::toIntegerCode(Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     const FiberOrientationSymbolTypeEnum* enumInstance = findData(enumValue);
     return enumInstance->integerCode;
 }
@@ -241,7 +252,7 @@ FiberOrientationSymbolTypeEnum::toIntegerCode(Enum enumValue)
 FiberOrientationSymbolTypeEnum::Enum
 FiberOrientationSymbolTypeEnum::fromIntegerCode(const int32_t integerCode, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = FIBER_SYMBOL_LINES;
@@ -276,7 +287,7 @@ FiberOrientationSymbolTypeEnum::fromIntegerCode(const int32_t integerCode, bool*
 void
 FiberOrientationSymbolTypeEnum::getAllEnums(std::vector<FiberOrientationSymbolTypeEnum::Enum>& allEnums)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allEnums.clear();
     
@@ -298,7 +309,7 @@ FiberOrientationSymbolTypeEnum::getAllEnums(std::vector<FiberOrientationSymbolTy
 void
 FiberOrientationSymbolTypeEnum::getAllNames(std::vector<AString>& allNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allNames.clear();
     
@@ -324,7 +335,7 @@ FiberOrientationSymbolTypeEnum::getAllNames(std::vector<AString>& allNames, cons
 void
 FiberOrientationSymbolTypeEnum::getAllGuiNames(std::vector<AString>& allGuiNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allGuiNames.clear();
     
@@ -25,9 +25,19 @@
 #undef __FOCI_DRAWING_TYPE_ENUM_DECLARE__
 
 #include "CaretAssert.h"
+#include "CaretMutex.h"
 
 using namespace caret;
 
+namespace
+{
+    CaretMutex& getInitializeMutex()
+    {//function-local, so it exists even if the enum is first used while initializing another static
+        static CaretMutex s_initializeMutex;
+        return s_initializeMutex;
+    }
+}
+
     
 /**
  * \class caret::FociDrawingTypeEnum 
@@ -69,10 +79,10 @@ FociDrawingTypeEnum::~FociDrawingTypeEnum()
 void
 FociDrawingTypeEnum::initialize()
 {
+    CaretMutexLocker locker(&getInitializeMutex());//always lock, an unlocked check of the flag could see it set before the data it guards
     if (initializedFlag) {
         return;
     }
-    initializedFlag = true;
 
     enumData.push_back(FociDrawingTypeEnum(DRAW_AS_SPHERES, 
                                     "DRAW_AS_SPHERES", 
@@ -82,6 +92,7 @@ FociDrawingTypeEnum::initialize()
                                     "DRAW_AS_SQUARES", 
                                     "Squares"));
     
+    initializedFlag = true;
 }
 
 /**
@@ -94,7 +105,7 @@ FociDrawingTypeEnum::initialize()
 const FociDrawingTypeEnum*
 FociDrawingTypeEnum::findData(const Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
 
     size_t num = enumData.size();
     for (size_t i = 0; i < num; i++) {
@@ -116,7 +127,7 @@ FociDrawingTypeEnum::findData(const Enum enumValue)
  */
 AString 
 FociDrawingTypeEnum::toName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const FociDrawingTypeEnum* enumInstance = findData(enumValue);
     return enumInstance->name;
@@ -135,7 +146,7 @@ FociDrawingTypeEnum::toName(Enum enumValue) {
 FociDrawingTypeEnum::Enum 
 FociDrawingTypeEnum::fromName(const AString& name, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = DRAW_AS_SPHERES;
@@ -169,7 +180,7 @@ FociDrawingTypeEnum::fromName(const AString& name, bool* isValidOut)
  */
 AString 
 FociDrawingTypeEnum::toGuiName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const FociDrawingTypeEnum* enumInstance = findData(enumValue);
     return enumInstance->guiName;
@@ -188,7 +199,7 @@ FociDrawingTypeEnum::toGuiName(Enum enumValue) {
 FociDrawingTypeEnum::Enum 
 FociDrawingTypeEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = DRAW_AS_SPHERES;
@@ -222,7 +233,7 @@ FociDrawingTypeEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 int32_t
 FociDrawingTypeEnum::toIntegerCode(Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     const FociDrawingTypeEnum* enumInstance = findData(enumValue);
     return enumInstance->integerCode;
 }
@@ -241,7 +252,7 @@ FociDrawingTypeEnum::toIntegerCode(Enum enumValue)
 FociDrawingTypeEnum::Enum
 FociDrawingTypeEnum::fromIntegerCode(const int32_t integerCode, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = DRAW_AS_SPHERES;
@@ -276,7 +287,7 @@ FociDrawingTypeEnum::fromIntegerCode(const int32_t integerCode, bool* isValidOut
 void
 FociDrawingTypeEnum::getAllEnums(std::vector<FociDrawingTypeEnum::Enum>& allEnums)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allEnums.clear();
     
@@ -298,7 +309,7 @@ FociDrawingTypeEnum::getAllEnums(std::vector<FociDrawingTypeEnum::Enum>& allEnum
 void
 FociDrawingTypeEnum::getAllNames(std::vector<AString>& allNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allNames.clear();
     
@@ -324,7 +335,7 @@ FociDrawingTypeEnum::getAllNames(std::vector<AString>& allNames, const bool isSo
 void
 FociDrawingTypeEnum::getAllGuiNames(std::vector<AString>& allGuiNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allGuiNames.clear();
     
@@ -24,9 +24,19 @@
 #undef __MODEL_DISPLAY_CONTROLLER_TYPE_ENUM_DECLARE__
 
 #include "CaretAssert.h"
+#include "CaretMutex.h"
 
 using namespace caret;
 
+namespace
+{
+    CaretMutex& getInitializeMutex()
+    {//function-local, so it exists even if the enum is first used while initializing another static
+        static CaretMutex s_initializeMutex;
+        return s_initializeMutex;
+    }
+}
+
 /**
  * Constructor.
  *
@@ -65,10 +75,10 @@ ModelTypeEnum::~ModelTypeEnum()
 void
 ModelTypeEnum::initialize()
 {
+    CaretMutexLocker locker(&getInitializeMutex());//always lock, an unlocked check of the flag could see it set before the data it guards
     if (initializedFlag) {
         return;
     }
-    initializedFlag = true;
 
     enumData.push_back(ModelTypeEnum(MODEL_TYPE_INVALID, 
                                     0, 
@@ -100,6 +110,7 @@ ModelTypeEnum::initialize()
                                     "MODEL_TYPE_WHOLE_BRAIN", 
                                     "Whole Brain"));
     
+    initializedFlag = true;
 }
 
 /**
@@ -112,7 +123,7 @@ ModelTypeEnum::initialize()
 const ModelTypeEnum*
 ModelTypeEnum::findData(const Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
 
     size_t num = enumData.size();
     for (size_t i = 0; i < num; i++) {
@@ -134,7 +145,7 @@ ModelTypeEnum::findData(const Enum enumValue)
  */
 AString 
 ModelTypeEnum::toName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const ModelTypeEnum* enumInstance = findData(enumValue);
     return enumInstance->name;
@@ -153,7 +164,7 @@ ModelTypeEnum::toName(Enum enumValue) {
 ModelTypeEnum::Enum 
 ModelTypeEnum::fromName(const AString& name, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = MODEL_TYPE_INVALID;
@@ -187,7 +198,7 @@ ModelTypeEnum::fromName(const AString& name, bool* isValidOut)
  */
 AString 
 ModelTypeEnum::toGuiName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const ModelTypeEnum* enumInstance = findData(enumValue);
     return enumInstance->guiName;
@@ -206,7 +217,7 @@ ModelTypeEnum::toGuiName(Enum enumValue) {
 ModelTypeEnum::Enum 
 ModelTypeEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = MODEL_TYPE_INVALID;
@@ -241,7 +252,7 @@ ModelTypeEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 int32_t
 ModelTypeEnum::toIntegerCode(Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     const ModelTypeEnum* enumInstance = findData(enumValue);
     return enumInstance->integerCode;
 }
@@ -260,7 +271,7 @@ ModelTypeEnum::toIntegerCode(Enum enumValue)
 ModelTypeEnum::Enum
 ModelTypeEnum::fromIntegerCode(const int32_t integerCode, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = MODEL_TYPE_INVALID;
@@ -295,7 +306,7 @@ ModelTypeEnum::fromIntegerCode(const int32_t integerCode, bool* isValidOut)
 void
 ModelTypeEnum::getAllEnums(std::vector<ModelTypeEnum::Enum>& allEnums)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allEnums.clear();
     
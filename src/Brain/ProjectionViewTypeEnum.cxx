@@ -25,9 +25,19 @@
 #undef __PROJECTION_VIEW_TYPE_ENUM_DECLARE__
 
 #include "CaretAssert.h"
+#include "CaretMutex.h"
 
 using namespace caret;
 
+namespace
+{
+    CaretMutex& getInitializeMutex()
+    {//function-local, so it exists even if the enum is first used while initializing another static
+        static CaretMutex s_initializeMutex;
+        return s_initializeMutex;
+    }
+}
+
     
 /**
  * \class caret::ProjectionViewTypeEnum 
@@ -68,10 +78,10 @@ ProjectionViewTypeEnum::~ProjectionViewTypeEnum()
 void
 ProjectionViewTypeEnum::initialize()
 {
+    CaretMutexLocker locker(&getInitializeMutex());//always lock, an unlocked check of the flag could see it set before the data it guards
     if (initializedFlag) {
         return;
     }
-    initializedFlag = true;
 
     enumData.push_back(ProjectionViewTypeEnum(PROJECTION_VIEW_CEREBELLUM_ANTERIOR,
                                               "PROJECTION_VIEW_CEREBELLUM_ANTERIOR",
@@ -117,6 +127,7 @@ ProjectionViewTypeEnum::initialize()
                                               "PROJECTION_VIEW_RIGHT_FLAT_SURFACE",
                                               "Right Flat"));
     
+    initializedFlag = true;
 }
 
 /**
@@ -129,7 +140,7 @@ ProjectionViewTypeEnum::initialize()
 const ProjectionViewTypeEnum*
 ProjectionViewTypeEnum::findData(const Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
 
     size_t num = enumData.size();
     for (size_t i = 0; i < num; i++) {
@@ -151,7 +162,7 @@ ProjectionViewTypeEnum::findData(const Enum enumValue)
  */
 AString 
 ProjectionViewTypeEnum::toName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const ProjectionViewTypeEnum* enumInstance = findData(enumValue);
     return enumInstance->name;
@@ -170,7 +181,7 @@ ProjectionViewTypeEnum::toName(Enum enumValue) {
 ProjectionViewTypeEnum::Enum 
 ProjectionViewTypeEnum::fromName(const AString& name, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = PROJECTION_VIEW_LEFT_LATERAL;
@@ -204,7 +215,7 @@ ProjectionViewTypeEnum::fromName(const AString& name, bool* isValidOut)
  */
 AString 
 ProjectionViewTypeEnum::toGuiName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const ProjectionViewTypeEnum* enumInstance = findData(enumValue);
     return enumInstance->guiName;
@@ -223,7 +234,7 @@ ProjectionViewTypeEnum::toGuiName(Enum enumValue) {
 ProjectionViewTypeEnum::Enum 
 ProjectionViewTypeEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = PROJECTION_VIEW_LEFT_LATERAL;
@@ -257,7 +268,7 @@ ProjectionViewTypeEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 int32_t
 ProjectionViewTypeEnum::toIntegerCode(Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     const ProjectionViewTypeEnum* enumInstance = findData(enumValue);
     return enumInstance->integerCode;
 }
@@ -276,7 +287,7 @@ ProjectionViewTypeEnum::toIntegerCode(Enum enumValue)
 ProjectionViewTypeEnum::Enum
 ProjectionViewTypeEnum::fromIntegerCode(const int32_t integerCode, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = PROJECTION_VIEW_LEFT_LATERAL;
@@ -311,7 +322,7 @@ ProjectionViewTypeEnum::fromIntegerCode(const int32_t integerCode, bool* isValid
 void
 ProjectionViewTypeEnum::getAllEnums(std::vector<ProjectionViewTypeEnum::Enum>& allEnums)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allEnums.clear();
     
@@ -333,7 +344,7 @@ ProjectionViewTypeEnum::getAllEnums(std::vector<ProjectionViewTypeEnum::Enum>& a
 void
 ProjectionViewTypeEnum::getAllNames(std::vector<AString>& allNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allNames.clear();
     
@@ -359,7 +370,7 @@ ProjectionViewTypeEnum::getAllNames(std::vector<AString>& allNames, const bool i
 void
 ProjectionViewTypeEnum::getAllGuiNames(std::vector<AString>& allGuiNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allGuiNames.clear();
     
@@ -25,9 +25,19 @@
 #undef __SELECTION_ITEM_DATA_TYPE_ENUM_DECLARE__
 
 #include "CaretAssert.h"
+#include "CaretMutex.h"
 
 using namespace caret;
 
+namespace
+{
+    CaretMutex& getInitializeMutex()
+    {//function-local, so it exists even if the enum is first used while initializing another static
+        static CaretMutex s_initializeMutex;
+        return s_initializeMutex;
+    }
+}
+
 /**
  * Constructor.
  *
@@ -62,10 +72,10 @@ SelectionItemDataTypeEnum::~SelectionItemDataTypeEnum()
 void
 SelectionItemDataTypeEnum::initialize()
 {
+    CaretMutexLocker locker(&getInitializeMutex());//always lock, an unlocked check of the flag could see it set before the data it guards
     if (initializedFlag) {
         return;
     }
-    initializedFlag = true;
 
     enumData.push_back(SelectionItemDataTypeEnum(INVALID, 
                                     "INVALID", 
@@ -123,6 +133,7 @@ SelectionItemDataTypeEnum::initialize()
                                     "VOXEL", 
                                     "Voxel"));
     
+    initializedFlag = true;
 }
 
 /**
@@ -135,7 +146,7 @@ SelectionItemDataTypeEnum::initialize()
 const SelectionItemDataTypeEnum*
 SelectionItemDataTypeEnum::findData(const Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
 
     size_t num = enumData.size();
     for (size_t i = 0; i < num; i++) {
@@ -157,7 +168,7 @@ SelectionItemDataTypeEnum::findData(const Enum enumValue)
  */
 AString 
 SelectionItemDataTypeEnum::toName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const SelectionItemDataTypeEnum* enumInstance = findData(enumValue);
     return enumInstance->name;
@@ -176,7 +187,7 @@ SelectionItemDataTypeEnum::toName(Enum enumValue) {
 SelectionItemDataTypeEnum::Enum 
 SelectionItemDataTypeEnum::fromName(const AString& name, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = INVALID;
@@ -210,7 +221,7 @@ SelectionItemDataTypeEnum::fromName(const AString& name, bool* isValidOut)
  */
 AString 
 SelectionItemDataTypeEnum::toGuiName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const SelectionItemDataTypeEnum* enumInstance = findData(enumValue);
     return enumInstance->guiName;
@@ -229,7 +240,7 @@ SelectionItemDataTypeEnum::toGuiName(Enum enumValue) {
 SelectionItemDataTypeEnum::Enum 
 SelectionItemDataTypeEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = INVALID;
@@ -263,7 +274,7 @@ SelectionItemDataTypeEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 int32_t
 SelectionItemDataTypeEnum::toIntegerCode(Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     const SelectionItemDataTypeEnum* enumInstance = findData(enumValue);
     return enumInstance->integerCode;
 }
@@ -282,7 +293,7 @@ SelectionItemDataTypeEnum::toIntegerCode(Enum enumValue)
 SelectionItemDataTypeEnum::Enum
 SelectionItemDataTypeEnum::fromIntegerCode(const int32_t integerCode, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = INVALID;
@@ -317,7 +328,7 @@ SelectionItemDataTypeEnum::fromIntegerCode(const int32_t integerCode, bool* isVa
 void
 SelectionItemDataTypeEnum::getAllEnums(std::vector<SelectionItemDataTypeEnum::Enum>& allEnums)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allEnums.clear();
     
@@ -339,7 +350,7 @@ SelectionItemDataTypeEnum::getAllEnums(std::vector<SelectionItemDataTypeEnum::En
 void
 SelectionItemDataTypeEnum::getAllNames(std::vector<AString>& allNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allNames.clear();
     
@@ -365,7 +376,7 @@ SelectionItemDataTypeEnum::getAllNames(std::vector<AString>& allNames, const boo
 void
 SelectionItemDataTypeEnum::getAllGuiNames(std::vector<AString>& allGuiNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allGuiNames.clear();
     
@@ -25,9 +25,19 @@
 #undef __SURFACE_DRAWING_TYPE_ENUM_DECLARE__
 
 #include "CaretAssert.h"
+#include "CaretMutex.h"
 
 using namespace caret;
 
+namespace
+{
+    CaretMutex& getInitializeMutex()
+    {//function-local, so it exists even if the enum is first used while initializing another static
+        static CaretMutex s_initializeMutex;
+        return s_initializeMutex;
+    }
+}
+
     
 /**
  * \class caret::SurfaceDrawingTypeEnum 
@@ -69,10 +79,10 @@ SurfaceDrawingTypeEnum::~SurfaceDrawingTypeEnum()
 void
 SurfaceDrawingTypeEnum::initialize()
 {
+    CaretMutexLocker locker(&getInitializeMutex());//always lock, an unlocked check of the flag could see it set before the data it guards
     if (initializedFlag) {
         return;
     }
-    initializedFlag = true;
 
     enumData.push_back(SurfaceDrawingTypeEnum(DRAW_HIDE,
                                               "DRAW_HIDE",
@@ -90,6 +100,7 @@ SurfaceDrawingTypeEnum::initialize()
                                     "DRAW_AS_TRIANGLES", 
                                     "Triangles"));
     
+    initializedFlag = true;
 }
 
 /**
@@ -102,7 +113,7 @@ SurfaceDrawingTypeEnum::initialize()
 const SurfaceDrawingTypeEnum*
 SurfaceDrawingTypeEnum::findData(const Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
 
     size_t num = enumData.size();
     for (size_t i = 0; i < num; i++) {
@@ -124,7 +135,7 @@ SurfaceDrawingTypeEnum::findData(const Enum enumValue)
  */
 AString 
 SurfaceDrawingTypeEnum::toName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const SurfaceDrawingTypeEnum* enumInstance = findData(enumValue);
     return enumInstance->name;
@@ -143,7 +154,7 @@ SurfaceDrawingTypeEnum::toName(Enum enumValue) {
 SurfaceDrawingTypeEnum::Enum 
 SurfaceDrawingTypeEnum::fromName(const AString& name, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = DRAW_AS_TRIANGLES;
@@ -177,7 +188,7 @@ SurfaceDrawingTypeEnum::fromName(const AString& name, bool* isValidOut)
  */
 AString 
 SurfaceDrawingTypeEnum::toGuiName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const SurfaceDrawingTypeEnum* enumInstance = findData(enumValue);
     return enumInstance->guiName;
@@ -196,7 +207,7 @@ SurfaceDrawingTypeEnum::toGuiName(Enum enumValue) {
 SurfaceDrawingTypeEnum::Enum 
 SurfaceDrawingTypeEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = DRAW_AS_TRIANGLES;
@@ -230,7 +241,7 @@ SurfaceDrawingTypeEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 int32_t
 SurfaceDrawingTypeEnum::toIntegerCode(Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     const SurfaceDrawingTypeEnum* enumInstance = findData(enumValue);
     return enumInstance->integerCode;
 }
@@ -249,7 +260,7 @@ SurfaceDrawingTypeEnum::toIntegerCode(Enum enumValue)
 SurfaceDrawingTypeEnum::Enum
 SurfaceDrawingTypeEnum::fromIntegerCode(const int32_t integerCode, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = DRAW_AS_TRIANGLES;
@@ -284,7 +295,7 @@ SurfaceDrawingTypeEnum::fromIntegerCode(const int32_t integerCode, bool* isValid
 void
 SurfaceDrawingTypeEnum::getAllEnums(std::vector<SurfaceDrawingTypeEnum::Enum>& allEnums)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allEnums.clear();
     
@@ -306,7 +317,7 @@ SurfaceDrawingTypeEnum::getAllEnums(std::vector<SurfaceDrawingTypeEnum::Enum>& a
 void
 SurfaceDrawingTypeEnum::getAllNames(std::vector<AString>& allNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allNames.clear();
     
@@ -332,7 +343,7 @@ SurfaceDrawingTypeEnum::getAllNames(std::vector<AString>& allNames, const bool i
 void
 SurfaceDrawingTypeEnum::getAllGuiNames(std::vector<AString>& allGuiNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allGuiNames.clear();
     
@@ -25,9 +25,19 @@
 #undef __SURFACE_MONTAGE_CONFIGURATION_TYPE_ENUM_DECLARE__
 
 #include "CaretAssert.h"
+#include "CaretMutex.h"
 
 using namespace caret;
 
+namespace
+{
+    CaretMutex& getInitializeMutex()
+    {//function-local, so it exists even if the enum is first used while initializing another static
+        static CaretMutex s_initializeMutex;
+        return s_initializeMutex;
+    }
+}
+
     
 /**
  * \class caret::SurfaceMontageConfigurationTypeEnum 
@@ -103,10 +113,10 @@ SurfaceMontageConfigurationTypeEnum::~SurfaceMontageConfigurationTypeEnum()
 void
 SurfaceMontageConfigurationTypeEnum::initialize()
 {
+    CaretMutexLocker locker(&getInitializeMutex());//always lock, an unlocked check of the flag could see it set before the data it guards
     if (initializedFlag) {
         return;
     }
-    initializedFlag = true;
 
     enumData.push_back(SurfaceMontageConfigurationTypeEnum(CEREBELLAR_CORTEX_CONFIGURATION, 
                                     "CEREBELLAR_CORTEX_CONFIGURATION", 
@@ -120,6 +130,7 @@ SurfaceMontageConfigurationTypeEnum::initialize()
                                     "FLAT_CONFIGURATION", 
                                     "Flat Maps"));
     
+    initializedFlag = true;
 }
 
 /**
@@ -132,7 +143,7 @@ SurfaceMontageConfigurationTypeEnum::initialize()
 const SurfaceMontageConfigurationTypeEnum*
 SurfaceMontageConfigurationTypeEnum::findData(const Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
 
     size_t num = enumData.size();
     for (size_t i = 0; i < num; i++) {
@@ -154,7 +165,7 @@ SurfaceMontageConfigurationTypeEnum::findData(const Enum enumValue)
  */
 AString 
 SurfaceMontageConfigurationTypeEnum::toName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const SurfaceMontageConfigurationTypeEnum* enumInstance = findData(enumValue);
     return enumInstance->name;
@@ -173,7 +184,7 @@ SurfaceMontageConfigurationTypeEnum::toName(Enum enumValue) {
 SurfaceMontageConfigurationTypeEnum::Enum 
 SurfaceMontageConfigurationTypeEnum::fromName(const AString& name, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = SurfaceMontageConfigurationTypeEnum::enumData[0].enumValue;
@@ -207,7 +218,7 @@ SurfaceMontageConfigurationTypeEnum::fromName(const AString& name, bool* isValid
  */
 AString 
 SurfaceMontageConfigurationTypeEnum::toGuiName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const SurfaceMontageConfigurationTypeEnum* enumInstance = findData(enumValue);
     return enumInstance->guiName;
@@ -226,7 +237,7 @@ SurfaceMontageConfigurationTypeEnum::toGuiName(Enum enumValue) {
 SurfaceMontageConfigurationTypeEnum::Enum 
 SurfaceMontageConfigurationTypeEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = SurfaceMontageConfigurationTypeEnum::enumData[0].enumValue;
@@ -260,7 +271,7 @@ SurfaceMontageConfigurationTypeEnum::fromGuiName(const AString& guiName, bool* i
 int32_t
 SurfaceMontageConfigurationTypeEnum::toIntegerCode(Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     const SurfaceMontageConfigurationTypeEnum* enumInstance = findData(enumValue);
     return enumInstance->integerCode;
 }
@@ -279,7 +290,7 @@ SurfaceMontageConfigurationTypeEnum::toIntegerCode(Enum enumValue)
 SurfaceMontageConfigurationTypeEnum::Enum
 SurfaceMontageConfigurationTypeEnum::fromIntegerCode(const int32_t integerCode, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = SurfaceMontageConfigurationTypeEnum::enumData[0].enumValue;
@@ -314,7 +325,7 @@ SurfaceMontageConfigurationTypeEnum::fromIntegerCode(const int32_t integerCode,
 void
 SurfaceMontageConfigurationTypeEnum::getAllEnums(std::vector<SurfaceMontageConfigurationTypeEnum::Enum>& allEnums)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allEnums.clear();
     
@@ -336,7 +347,7 @@ SurfaceMontageConfigurationTypeEnum::getAllEnums(std::vector<SurfaceMontageConfi
 void
 SurfaceMontageConfigurationTypeEnum::getAllNames(std::vector<AString>& allNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allNames.clear();
     
@@ -362,7 +373,7 @@ SurfaceMontageConfigurationTypeEnum::getAllNames(std::vector<AString>& allNames,
 void
 SurfaceMontageConfigurationTypeEnum::getAllGuiNames(std::vector<AString>& allGuiNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allGuiNames.clear();
     
@@ -25,9 +25,19 @@
 #undef __SURFACE_MONTAGE_LAYOUT_ORIENTATION_ENUM_DECLARE__
 
 #include "CaretAssert.h"
+#include "CaretMutex.h"
 
 using namespace caret;
 
+namespace
+{
+    CaretMutex& getInitializeMutex()
+    {//function-local, so it exists even if the enum is first used while initializing another static
+        static CaretMutex s_initializeMutex;
+        return s_initializeMutex;
+    }
+}
+
     
 /**
  * \class caret::SurfaceMontageLayoutOrientationEnum 
@@ -103,10 +113,10 @@ SurfaceMontageLayoutOrientationEnum::~SurfaceMontageLayoutOrientationEnum()
 void
 SurfaceMontageLayoutOrientationEnum::initialize()
 {
+    CaretMutexLocker locker(&getInitializeMutex());//always lock, an unlocked check of the flag could see it set before the data it guards
     if (initializedFlag) {
         return;
     }
-    initializedFlag = true;
 
     enumData.push_back(SurfaceMontageLayoutOrientationEnum(LANDSCAPE_LAYOUT_ORIENTATION, 
                                     "LANDSCAPE_LAYOUT_ORIENTATION", 
@@ -116,6 +126,7 @@ SurfaceMontageLayoutOrientationEnum::initialize()
                                     "PORTRAIT_LAYOUT_ORIENTATION", 
                                     "Portrait"));
     
+    initializedFlag = true;
 }
 
 /**
@@ -128,7 +139,7 @@ SurfaceMontageLayoutOrientationEnum::initialize()
 const SurfaceMontageLayoutOrientationEnum*
 SurfaceMontageLayoutOrientationEnum::findData(const Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
 
     size_t num = enumData.size();
     for (size_t i = 0; i < num; i++) {
@@ -150,7 +161,7 @@ SurfaceMontageLayoutOrientationEnum::findData(const Enum enumValue)
  */
 AString 
 SurfaceMontageLayoutOrientationEnum::toName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const SurfaceMontageLayoutOrientationEnum* enumInstance = findData(enumValue);
     return enumInstance->name;
@@ -169,7 +180,7 @@ SurfaceMontageLayoutOrientationEnum::toName(Enum enumValue) {
 SurfaceMontageLayoutOrientationEnum::Enum 
 SurfaceMontageLayoutOrientationEnum::fromName(const AString& name, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = SurfaceMontageLayoutOrientationEnum::enumData[0].enumValue;
@@ -203,7 +214,7 @@ SurfaceMontageLayoutOrientationEnum::fromName(const AString& name, bool* isValid
  */
 AString 
 SurfaceMontageLayoutOrientationEnum::toGuiName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const SurfaceMontageLayoutOrientationEnum* enumInstance = findData(enumValue);
     return enumInstance->guiName;
@@ -222,7 +233,7 @@ SurfaceMontageLayoutOrientationEnum::toGuiName(Enum enumValue) {
 SurfaceMontageLayoutOrientationEnum::Enum 
 SurfaceMontageLayoutOrientationEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = SurfaceMontageLayoutOrientationEnum::enumData[0].enumValue;
@@ -256,7 +267,7 @@ SurfaceMontageLayoutOrientationEnum::fromGuiName(const AString& guiName, bool* i
 int32_t
 SurfaceMontageLayoutOrientationEnum::toIntegerCode(Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     const SurfaceMontageLayoutOrientationEnum* enumInstance = findData(enumValue);
     return enumInstance->integerCode;
 }
@@ -275,7 +286,7 @@ SurfaceMontageLayoutOrientationEnum::toIntegerCode(Enum enumValue)
 SurfaceMontageLayoutOrientationEnum::Enum
 SurfaceMontageLayoutOrientationEnum::fromIntegerCode(const int32_t integerCode, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = SurfaceMontageLayoutOrientationEnum::enumData[0].enumValue;
@@ -310,7 +321,7 @@ SurfaceMontageLayoutOrientationEnum::fromIntegerCode(const int32_t integerCode,
 void
 SurfaceMontageLayoutOrientationEnum::getAllEnums(std::vector<SurfaceMontageLayoutOrientationEnum::Enum>& allEnums)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allEnums.clear();
     
@@ -332,7 +343,7 @@ SurfaceMontageLayoutOrientationEnum::getAllEnums(std::vector<SurfaceMontageLayou
 void
 SurfaceMontageLayoutOrientationEnum::getAllNames(std::vector<AString>& allNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allNames.clear();
     
@@ -358,7 +369,7 @@ SurfaceMontageLayoutOrientationEnum::getAllNames(std::vector<AString>& allNames,
 void
 SurfaceMontageLayoutOrientationEnum::getAllGuiNames(std::vector<AString>& allGuiNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allGuiNames.clear();
     
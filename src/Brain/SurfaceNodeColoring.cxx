@@ -19,6 +19,8 @@
  */
 /*LICENSE_END*/
 
+#include <algorithm>
+
 #define __SURFACE_NODE_COLORING_DECLARE__
 #include "SurfaceNodeColoring.h"
 #undef __SURFACE_NODE_COLORING_DECLARE__
@@ -72,7 +74,7 @@ using namespace caret;
 SurfaceNodeColoring::SurfaceNodeColoring()
 : CaretObject()
 {
-    
+    EventManager::get()->addEventListener(this, EventTypeEnum::EVENT_SURFACE_COLORING_INVALIDATE);
 }
 
 /**
@@ -80,7 +82,98 @@ SurfaceNodeColoring::SurfaceNodeColoring()
  */
 SurfaceNodeColoring::~SurfaceNodeColoring()
 {
+    EventManager::get()->removeAllEventsFromListener(this);
+}
+
+/**
+ * Receive an event.
+ *
+ * @param event
+ *     The event that the receive can respond to.
+ */
+void
+SurfaceNodeColoring::receiveEvent(Event* event)
+{
+    if (event->getEventType() == EventTypeEnum::EVENT_SURFACE_COLORING_INVALIDATE) {
+        /*
+         * Do not set the event processed, surface files also receive it.
+         */
+        m_overlayColoringCache.clear();
+    }
+}
+
+/**
+ * Is the coloring of the given type of file cacheable?  Coloring is
+ * cacheable when it depends only upon the file's data and palette for
+ * a structure and not upon the surface, tab, or display properties.
+ *
+ * @param dataFileType
+ *     Type of data file.
+ * @return
+ *     True if cacheable, else false.
+ */
+bool
+SurfaceNodeColoring::isOverlayColoringCacheable(const DataFileTypeEnum::Enum dataFileType)
+{
+    switch (dataFileType) {
+        case DataFileTypeEnum::CONNECTIVITY_DENSE_SCALAR:
+        case DataFileTypeEnum::CONNECTIVITY_DENSE_TIME_SERIES:
+        case DataFileTypeEnum::CONNECTIVITY_PARCEL_SCALAR:
+        case DataFileTypeEnum::CONNECTIVITY_PARCEL_SERIES:
+        case DataFileTypeEnum::METRIC:
+            return true;
+        default:
+            break;
+    }
+    return false;
+}
+
+/**
+ * Get coloring from the cache.
+ *
+ * @param key
+ *     Identifies file, map, and structure.
+ * @param rgbv
+ *     Output containing the coloring if found in the cache.
+ * @return
+ *     True if the coloring was found in the cache, else false.
+ */
+bool
+SurfaceNodeColoring::getCachedOverlayColoring(const OverlayColoringKey& key,
+                                              float* rgbv) const
+{
+    std::map<OverlayColoringKey, std::vector<float> >::const_iterator iter = m_overlayColoringCache.find(key);
+    if (iter == m_overlayColoringCache.end()) {
+        return false;
+    }
     
+    const std::vector<float>& cachedRGBV = iter->second;
+    CaretAssert(static_cast<int64_t>(cachedRGBV.size()) == (static_cast<int64_t>(key.m_numberOfNodes) * 4));
+    std::copy(cachedRGBV.begin(),
+              cachedRGBV.end(),
+              rgbv);
+    return true;
+}
+
+/**
+ * Add coloring to the cache.
+ *
+ * @param key
+ *     Identifies file, map, and structure.
+ * @param rgbv
+ *     The coloring.
+ */
+void
+SurfaceNodeColoring::cacheOverlayColoring(const OverlayColoringKey& key,
+                                          const float* rgbv)
+{
+    if (static_cast<int32_t>(m_overlayColoringCache.size()) >= s_maximumOverlayColoringCacheSize) {
+        m_overlayColoringCache.clear();
+    }
+    
+    std::vector<float>& cachedRGBV = m_overlayColoringCache[key];
+    cachedRGBV.assign(rgbv,
+                      rgbv + (static_cast<int64_t>(key.m_numberOfNodes) * 4));
 }
 
 /**
@@ -285,146 +378,170 @@ SurfaceNodeColoring::colorSurfaceNodes(const DisplayPropertiesLabels* displayPro
             }
             
             bool isColoringValid = false;
-            switch (mapDataFileType) {
-                case DataFileTypeEnum::BORDER:
-                    break;
-                case DataFileTypeEnum::CONNECTIVITY_DENSE:
-                {
-                    CiftiMappableConnectivityMatrixDataFile* cmf = dynamic_cast<CiftiMappableConnectivityMatrixDataFile*>(selectedMapFile);
-                    isColoringValid = assignCiftiMappableConnectivityMatrixColoring(brainStructure,
-                                                                                    cmf,
-                                                                                    selectedMapIndex,
-                                                                                    numNodes,
-                                                                                    overlayRGBV);
-                }
-                    break;
-                case DataFileTypeEnum::CONNECTIVITY_DENSE_LABEL:
-                    isColoringValid = this->assignCiftiDenseLabelColoring(displayPropertiesLabels,
-                                                                     browserTabIndex,
-                                                                     brainStructure,
-                                                                          surface,
-                                                                      dynamic_cast<CiftiBrainordinateLabelFile*>(selectedMapFile),
-                                                                     selectedMapIndex,
-                                                                      numNodes,
-                                                                      overlayRGBV);
-                    break;
-                case DataFileTypeEnum::CONNECTIVITY_DENSE_PARCEL:
-                {
-                    CiftiMappableConnectivityMatrixDataFile* cmf = dynamic_cast<CiftiMappableConnectivityMatrixDataFile*>(selectedMapFile);
-                    isColoringValid = assignCiftiMappableConnectivityMatrixColoring(brainStructure,
-                                                                            cmf,
-                                                                                    selectedMapIndex,
-                                                                            numNodes,
-                                                                            overlayRGBV);
-                }
-                    break;
-                case DataFileTypeEnum::CONNECTIVITY_DENSE_SCALAR:
-                    isColoringValid = this->assignCiftiScalarColoring(brainStructure,
-                                                                 dynamic_cast<CiftiBrainordinateScalarFile*>(selectedMapFile),
-                                                                      selectedMapIndex,
-                                                                 numNodes,
-                                                                 overlayRGBV);
-                    break;
-                case DataFileTypeEnum::CONNECTIVITY_DENSE_TIME_SERIES:
-                    isColoringValid = this->assignCiftiDataSeriesColoring(brainStructure,
-                                                                      dynamic_cast<CiftiBrainordinateDataSeriesFile*>(selectedMapFile),
+            
+            /*
+             * Palette coloring does not depend upon the surface so
+             * other surfaces of the structure may have already
+             * produced the coloring for this map.
+             */
+            const bool cacheableFlag = isOverlayColoringCacheable(mapDataFileType);
+            const OverlayColoringKey coloringKey(selectedMapFile,
+                                                 selectedMapIndex,
+                                                 brainStructure->getStructure(),
+                                                 numNodes);
+            if (cacheableFlag) {
+                isColoringValid = getCachedOverlayColoring(coloringKey,
+                                                           overlayRGBV);
+            }
+            
+            if ( ! isColoringValid) {
+                switch (mapDataFileType) {
+                    case DataFileTypeEnum::BORDER:
+                        break;
+                    case DataFileTypeEnum::CONNECTIVITY_DENSE:
+                    {
+                        CiftiMappableConnectivityMatrixDataFile* cmf = dynamic_cast<CiftiMappableConnectivityMatrixDataFile*>(selectedMapFile);
+                        isColoringValid = assignCiftiMappableConnectivityMatrixColoring(brainStructure,
+                                                                                        cmf,
+                                                                                        selectedMapIndex,
+                                                                                        numNodes,
+                                                                                        overlayRGBV);
+                    }
+                        break;
+                    case DataFileTypeEnum::CONNECTIVITY_DENSE_LABEL:
+                        isColoringValid = this->assignCiftiDenseLabelColoring(displayPropertiesLabels,
+                                                                         browserTabIndex,
+                                                                         brainStructure,
+                                                                              surface,
+                                                                          dynamic_cast<CiftiBrainordinateLabelFile*>(selectedMapFile),
+                                                                         selectedMapIndex,
+                                                                          numNodes,
+                                                                          overlayRGBV);
+                        break;
+                    case DataFileTypeEnum::CONNECTIVITY_DENSE_PARCEL:
+                    {
+                        CiftiMappableConnectivityMatrixDataFile* cmf = dynamic_cast<CiftiMappableConnectivityMatrixDataFile*>(selectedMapFile);
+                        isColoringValid = assignCiftiMappableConnectivityMatrixColoring(brainStructure,
+                                                                                cmf,
+                                                                                        selectedMapIndex,
+                                                                                numNodes,
+                                                                                overlayRGBV);
+                    }
+                        break;
+                    case DataFileTypeEnum::CONNECTIVITY_DENSE_SCALAR:
+                        isColoringValid = this->assignCiftiScalarColoring(brainStructure,
+                                                                     dynamic_cast<CiftiBrainordinateScalarFile*>(selectedMapFile),
                                                                           selectedMapIndex,
-                                                                      numNodes,
-                                                                      overlayRGBV);
-                    break;
-                case DataFileTypeEnum::CONNECTIVITY_FIBER_ORIENTATIONS_TEMPORARY:
-                    break;
-                case DataFileTypeEnum::CONNECTIVITY_FIBER_TRAJECTORY_TEMPORARY:
-                    break;
-                case DataFileTypeEnum::CONNECTIVITY_PARCEL:
-                {
-                    CiftiMappableConnectivityMatrixDataFile* cmf = dynamic_cast<CiftiMappableConnectivityMatrixDataFile*>(selectedMapFile);
-                    isColoringValid = assignCiftiMappableConnectivityMatrixColoring(brainStructure,
-                                                                            cmf,
-                                                                                    selectedMapIndex,
-                                                                            numNodes,
-                                                                            overlayRGBV);
-                }
-                    break;
-                case DataFileTypeEnum::CONNECTIVITY_PARCEL_DENSE:
-                {
-                    CiftiMappableConnectivityMatrixDataFile* cmf = dynamic_cast<CiftiMappableConnectivityMatrixDataFile*>(selectedMapFile);
-                    isColoringValid = assignCiftiMappableConnectivityMatrixColoring(brainStructure,
-                                                                            cmf,
-                                                                                    selectedMapIndex,
-                                                                            numNodes,
-                                                                            overlayRGBV);
+                                                                     numNodes,
+                                                                     overlayRGBV);
+                        break;
+                    case DataFileTypeEnum::CONNECTIVITY_DENSE_TIME_SERIES:
+                        isColoringValid = this->assignCiftiDataSeriesColoring(brainStructure,
+                                                                          dynamic_cast<CiftiBrainordinateDataSeriesFile*>(selectedMapFile),
+                                                                              selectedMapIndex,
+                                                                          numNodes,
+                                                                          overlayRGBV);
+                        break;
+                    case DataFileTypeEnum::CONNECTIVITY_FIBER_ORIENTATIONS_TEMPORARY:
+                        break;
+                    case DataFileTypeEnum::CONNECTIVITY_FIBER_TRAJECTORY_TEMPORARY:
+                        break;
+                    case DataFileTypeEnum::CONNECTIVITY_PARCEL:
+                    {
+                        CiftiMappableConnectivityMatrixDataFile* cmf = dynamic_cast<CiftiMappableConnectivityMatrixDataFile*>(selectedMapFile);
+                        isColoringValid = assignCiftiMappableConnectivityMatrixColoring(brainStructure,
+                                                                                cmf,
+                                                                                        selectedMapIndex,
+                                                                                numNodes,
+                                                                                overlayRGBV);
+                    }
+                        break;
+                    case DataFileTypeEnum::CONNECTIVITY_PARCEL_DENSE:
+                    {
+                        CiftiMappableConnectivityMatrixDataFile* cmf = dynamic_cast<CiftiMappableConnectivityMatrixDataFile*>(selectedMapFile);
+                        isColoringValid = assignCiftiMappableConnectivityMatrixColoring(brainStructure,
+                                                                                cmf,
+                                                                                        selectedMapIndex,
+                                                                                numNodes,
+                                                                                overlayRGBV);
+                    }
+                        break;
+                    case DataFileTypeEnum::CONNECTIVITY_PARCEL_LABEL:
+                    {
+                        CiftiParcelLabelFile* cplf = dynamic_cast<CiftiParcelLabelFile*>(selectedMapFile);
+                        isColoringValid = assignCiftiParcelLabelColoring(displayPropertiesLabels,
+                                                       browserTabIndex,
+                                                       brainStructure,
+                                                                         surface,
+                                                       cplf,
+                                                       selectedMapIndex,
+                                                       numNodes,
+                                                       overlayRGBV);
+                    }
+                        break;
+                    case DataFileTypeEnum::CONNECTIVITY_PARCEL_SCALAR:
+                        isColoringValid = this->assignCiftiParcelScalarColoring(brainStructure,
+                                                                                dynamic_cast<CiftiParcelScalarFile*>(selectedMapFile),
+                                                                                selectedMapIndex,
+                                                                                numNodes,
+                                                                                overlayRGBV);
+                        break;
+                    case DataFileTypeEnum::CONNECTIVITY_PARCEL_SERIES:
+                        isColoringValid = this->assignCiftiParcelSeriesColoring(brainStructure,
+                                                                                dynamic_cast<CiftiParcelSeriesFile*>(selectedMapFile),
+                                                                                selectedMapIndex,
+                                                                                numNodes,
+                                                                                overlayRGBV);
+                        break;
+                    case DataFileTypeEnum::CONNECTIVITY_SCALAR_DATA_SERIES:
+                        break;
+                    case DataFileTypeEnum::FOCI:
+                        break;
+                    case DataFileTypeEnum::IMAGE:
+                        break;
+                    case DataFileTypeEnum::LABEL:
+                        isColoringValid = this->assignLabelColoring(displayPropertiesLabels,
+                                                                    browserTabIndex,
+                                                                    brainStructure,
+                                                                    surface,
+                                                                    dynamic_cast<LabelFile*>(selectedMapFile),
+                                                                    selectedMapIndex,
+                                                                    numNodes, 
+                                                                    overlayRGBV);
+                        break;
+                    case DataFileTypeEnum::METRIC:
+                        isColoringValid = this->assignMetricColoring(brainStructure, 
+                                                                     dynamic_cast<MetricFile*>(selectedMapFile),
+                                                                     selectedMapIndex,
+                                                                     numNodes, 
+                                                                     overlayRGBV);
+                        break;
+                    case DataFileTypeEnum::PALETTE:
+                        break;
+                    case DataFileTypeEnum::RGBA:
+                        isColoringValid = this->assignRgbaColoring(brainStructure, 
+                                                                   dynamic_cast<RgbaFile*>(selectedMapFile),
+                                                                   selectedMapIndex,
+                                                                   numNodes, 
+                                                                   overlayRGBV);
+                        break;
+                    case DataFileTypeEnum::SCENE:
+                        break;
+                    case DataFileTypeEnum::SPECIFICATION:
+                        break;
+                    case DataFileTypeEnum::SURFACE:
+                        break;
+                    case DataFileTypeEnum::VOLUME:
+                        break;
+                    case DataFileTypeEnum::UNKNOWN:
+                        break;
                 }
-                    break;
-                case DataFileTypeEnum::CONNECTIVITY_PARCEL_LABEL:
-                {
-                    CiftiParcelLabelFile* cplf = dynamic_cast<CiftiParcelLabelFile*>(selectedMapFile);
-                    isColoringValid = assignCiftiParcelLabelColoring(displayPropertiesLabels,
-                                                   browserTabIndex,
-                                                   brainStructure,
-                                                                     surface,
-                                                   cplf,
-                                                   selectedMapIndex,
-                                                   numNodes,
-                                                   overlayRGBV);
+                
+                if (cacheableFlag
+                    && isColoringValid) {
+                    cacheOverlayColoring(coloringKey,
+                                         overlayRGBV);
                 }
-                    break;
-                case DataFileTypeEnum::CONNECTIVITY_PARCEL_SCALAR:
-                    isColoringValid = this->assignCiftiParcelScalarColoring(brainStructure,
-                                                                            dynamic_cast<CiftiParcelScalarFile*>(selectedMapFile),
-                                                                            selectedMapIndex,
-                                                                            numNodes,
-                                                                            overlayRGBV);
-                    break;
-                case DataFileTypeEnum::CONNECTIVITY_PARCEL_SERIES:
-                    isColoringValid = this->assignCiftiParcelSeriesColoring(brainStructure,
-                                                                            dynamic_cast<CiftiParcelSeriesFile*>(selectedMapFile),
-                                                                            selectedMapIndex,
-                                                                            numNodes,
-                                                                            overlayRGBV);
-                    break;
-                case DataFileTypeEnum::CONNECTIVITY_SCALAR_DATA_SERIES:
-                    break;
-                case DataFileTypeEnum::FOCI:
-                    break;
-                case DataFileTypeEnum::IMAGE:
-                    break;
-                case DataFileTypeEnum::LABEL:
-                    isColoringValid = this->assignLabelColoring(displayPropertiesLabels,
-                                                                browserTabIndex,
-                                                                brainStructure,
-                                                                surface,
-                                                                dynamic_cast<LabelFile*>(selectedMapFile),
-                                                                selectedMapIndex,
-                                                                numNodes, 
-                                                                overlayRGBV);
-                    break;
-                case DataFileTypeEnum::METRIC:
-                    isColoringValid = this->assignMetricColoring(brainStructure, 
-                                                                 dynamic_cast<MetricFile*>(selectedMapFile),
-                                                                 selectedMapIndex,
-                                                                 numNodes, 
-                                                                 overlayRGBV);
-                    break;
-                case DataFileTypeEnum::PALETTE:
-                    break;
-                case DataFileTypeEnum::RGBA:
-                    isColoringValid = this->assignRgbaColoring(brainStructure, 
-                                                               dynamic_cast<RgbaFile*>(selectedMapFile),
-                                                               selectedMapIndex,
-                                                               numNodes, 
-                                                               overlayRGBV);
-                    break;
-                case DataFileTypeEnum::SCENE:
-                    break;
-                case DataFileTypeEnum::SPECIFICATION:
-                    break;
-                case DataFileTypeEnum::SURFACE:
-                    break;
-                case DataFileTypeEnum::VOLUME:
-                    break;
-                case DataFileTypeEnum::UNKNOWN:
-                    break;
             }
             
             if (isColoringValid) {
@@ -21,16 +21,23 @@
  */
 /*LICENSE_END*/
 
+#include <map>
+#include <vector>
+
 #include "CaretColorEnum.h"
 #include "CaretObject.h"
 #include "CaretPointer.h"
+#include "DataFileTypeEnum.h"
 #include "DisplayGroupEnum.h"
+#include "EventListenerInterface.h"
 #include "LabelDrawingTypeEnum.h"
+#include "StructureEnum.h"
 
 namespace caret {
 
     class BrainStructure;
     class BrowserTabContent;
+    class CaretMappableDataFile;
     class CiftiMappableConnectivityMatrixDataFile;
     class CiftiBrainordinateDataSeriesFile;
     class CiftiBrainordinateLabelFile;
@@ -51,7 +58,7 @@ namespace caret {
     class TopologyHelper;
     
     /// Performs coloring of surface nodes
-    class SurfaceNodeColoring : public CaretObject {
+    class SurfaceNodeColoring : public CaretObject, public EventListenerInterface {
         
     public:
         SurfaceNodeColoring();
@@ -62,6 +69,8 @@ namespace caret {
                                  Surface* surface,
                                  const int32_t browserTabIndex);
         
+        virtual void receiveEvent(Event* event);
+        
     private:
         SurfaceNodeColoring(const SurfaceNodeColoring&);
 
@@ -78,6 +87,35 @@ namespace caret {
             METRIC_COLOR_TYPE_DO_NOT_COLOR
         };        
         
+        /** Identifies the coloring of one map for one structure */
+        struct OverlayColoringKey {
+            OverlayColoringKey(const CaretMappableDataFile* mapFile,
+                               const int32_t mapIndex,
+                               const StructureEnum::Enum structure,
+                               const int32_t numberOfNodes)
+            : m_mapFile(mapFile), m_mapIndex(mapIndex), m_structure(structure), m_numberOfNodes(numberOfNodes) { }
+            
+            bool operator<(const OverlayColoringKey& rhs) const {
+                if (m_mapFile != rhs.m_mapFile) return (m_mapFile < rhs.m_mapFile);
+                if (m_mapIndex != rhs.m_mapIndex) return (m_mapIndex < rhs.m_mapIndex);
+                if (m_structure != rhs.m_structure) return (m_structure < rhs.m_structure);
+                return (m_numberOfNodes < rhs.m_numberOfNodes);
+            }
+            
+            const CaretMappableDataFile* m_mapFile;
+            int32_t m_mapIndex;
+            StructureEnum::Enum m_structure;
+            int32_t m_numberOfNodes;
+        };
+        
+        static bool isOverlayColoringCacheable(const DataFileTypeEnum::Enum dataFileType);
+        
+        bool getCachedOverlayColoring(const OverlayColoringKey& key,
+                                      float* rgbv) const;
+        
+        void cacheOverlayColoring(const OverlayColoringKey& key,
+                                  const float* rgbv);
+        
         void colorSurfaceNodes(const DisplayPropertiesLabels* dpl,
                                const int32_t browserTabIndex,
                                const Surface* surface,
@@ -162,9 +200,19 @@ namespace caret {
                                     const std::vector<float>& labelIndices,
                                     const bool drawMedialWallFilledFlag,
                                     float* rgbv);
+        
+        /**
+         * Palette coloring of overlays, shared by all surfaces of a structure
+         * (such as those in a montage or in other tabs) until coloring is invalidated.
+         */
+        std::map<OverlayColoringKey, std::vector<float> > m_overlayColoringCache;
+        
+        /** Limits memory used by the overlay coloring cache */
+        static const int32_t s_maximumOverlayColoringCacheSize;
     };
     
 #ifdef __SURFACE_NODE_COLORING_DECLARE__
+    const int32_t SurfaceNodeColoring::s_maximumOverlayColoringCacheSize = 32;
 #endif // __SURFACE_NODE_COLORING_DECLARE__
 
 } // namespace
@@ -25,9 +25,19 @@
 #undef __VOLUME_SLICE_DRAWING_TYPE_ENUM_DECLARE__
 
 #include "CaretAssert.h"
+#include "CaretMutex.h"
 
 using namespace caret;
 
+namespace
+{
+    CaretMutex& getInitializeMutex()
+    {//function-local, so it exists even if the enum is first used while initializing another static
+        static CaretMutex s_initializeMutex;
+        return s_initializeMutex;
+    }
+}
+
     
 /**
  * \class caret::VolumeSliceDrawingTypeEnum 
@@ -103,10 +113,10 @@ VolumeSliceDrawingTypeEnum::~VolumeSliceDrawingTypeEnum()
 void
 VolumeSliceDrawingTypeEnum::initialize()
 {
+    CaretMutexLocker locker(&getInitializeMutex());//always lock, an unlocked check of the flag could see it set before the data it guards
     if (initializedFlag) {
         return;
     }
-    initializedFlag = true;
 
     enumData.push_back(VolumeSliceDrawingTypeEnum(VOLUME_SLICE_DRAW_MONTAGE, 
                                     "VOLUME_SLICE_DRAW_MONTAGE", 
@@ -116,6 +126,7 @@ VolumeSliceDrawingTypeEnum::initialize()
                                     "VOLUME_SLICE_DRAW_SINGLE", 
                                     "Draw a single slice"));
     
+    initializedFlag = true;
 }
 
 /**
@@ -128,7 +139,7 @@ VolumeSliceDrawingTypeEnum::initialize()
 const VolumeSliceDrawingTypeEnum*
 VolumeSliceDrawingTypeEnum::findData(const Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
 
     size_t num = enumData.size();
     for (size_t i = 0; i < num; i++) {
@@ -150,7 +161,7 @@ VolumeSliceDrawingTypeEnum::findData(const Enum enumValue)
  */
 AString 
 VolumeSliceDrawingTypeEnum::toName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const VolumeSliceDrawingTypeEnum* enumInstance = findData(enumValue);
     return enumInstance->name;
@@ -169,7 +180,7 @@ VolumeSliceDrawingTypeEnum::toName(Enum enumValue) {
 VolumeSliceDrawingTypeEnum::Enum 
 VolumeSliceDrawingTypeEnum::fromName(const AString& name, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = VolumeSliceDrawingTypeEnum::enumData[0].enumValue;
@@ -203,7 +214,7 @@ VolumeSliceDrawingTypeEnum::fromName(const AString& name, bool* isValidOut)
  */
 AString 
 VolumeSliceDrawingTypeEnum::toGuiName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const VolumeSliceDrawingTypeEnum* enumInstance = findData(enumValue);
     return enumInstance->guiName;
@@ -222,7 +233,7 @@ VolumeSliceDrawingTypeEnum::toGuiName(Enum enumValue) {
 VolumeSliceDrawingTypeEnum::Enum 
 VolumeSliceDrawingTypeEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = VolumeSliceDrawingTypeEnum::enumData[0].enumValue;
@@ -256,7 +267,7 @@ VolumeSliceDrawingTypeEnum::fromGuiName(const AString& guiName, bool* isValidOut
 int32_t
 VolumeSliceDrawingTypeEnum::toIntegerCode(Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     const VolumeSliceDrawingTypeEnum* enumInstance = findData(enumValue);
     return enumInstance->integerCode;
 }
@@ -275,7 +286,7 @@ VolumeSliceDrawingTypeEnum::toIntegerCode(Enum enumValue)
 VolumeSliceDrawingTypeEnum::Enum
 VolumeSliceDrawingTypeEnum::fromIntegerCode(const int32_t integerCode, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = VolumeSliceDrawingTypeEnum::enumData[0].enumValue;
@@ -310,7 +321,7 @@ VolumeSliceDrawingTypeEnum::fromIntegerCode(const int32_t integerCode, bool* isV
 void
 VolumeSliceDrawingTypeEnum::getAllEnums(std::vector<VolumeSliceDrawingTypeEnum::Enum>& allEnums)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allEnums.clear();
     
@@ -332,7 +343,7 @@ VolumeSliceDrawingTypeEnum::getAllEnums(std::vector<VolumeSliceDrawingTypeEnum::
 void
 VolumeSliceDrawingTypeEnum::getAllNames(std::vector<AString>& allNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allNames.clear();
     
@@ -358,7 +369,7 @@ VolumeSliceDrawingTypeEnum::getAllNames(std::vector<AString>& allNames, const bo
 void
 VolumeSliceDrawingTypeEnum::getAllGuiNames(std::vector<AString>& allGuiNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allGuiNames.clear();
     
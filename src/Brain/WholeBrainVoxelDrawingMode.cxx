@@ -25,9 +25,19 @@
 #undef __WHOLE_BRAIN_VOXEL_DRAWING_MODE_ENUM_DECLARE__
 
 #include "CaretAssert.h"
+#include "CaretMutex.h"
 
 using namespace caret;
 
+namespace
+{
+    CaretMutex& getInitializeMutex()
+    {//function-local, so it exists even if the enum is first used while initializing another static
+        static CaretMutex s_initializeMutex;
+        return s_initializeMutex;
+    }
+}
+
     
 /**
  * \class caret::WholeBrainVoxelDrawingMode 
@@ -68,10 +78,10 @@ WholeBrainVoxelDrawingMode::~WholeBrainVoxelDrawingMode()
 void
 WholeBrainVoxelDrawingMode::initialize()
 {
+    CaretMutexLocker locker(&getInitializeMutex());//always lock, an unlocked check of the flag could see it set before the data it guards
     if (initializedFlag) {
         return;
     }
-    initializedFlag = true;
 
     enumData.push_back(WholeBrainVoxelDrawingMode(DRAW_VOXELS_AS_THREE_D_CUBES, 
                                     "DRAW_VOXELS_AS_THREE_D_CUBES", 
@@ -85,6 +95,7 @@ WholeBrainVoxelDrawingMode::initialize()
                                     "DRAW_VOXELS_ON_TWO_D_SLICES", 
                                     "Draw Voxels on Slices (2D)"));
     
+    initializedFlag = true;
 }
 
 /**
@@ -97,7 +108,7 @@ WholeBrainVoxelDrawingMode::initialize()
 const WholeBrainVoxelDrawingMode*
 WholeBrainVoxelDrawingMode::findData(const Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
 
     size_t num = enumData.size();
     for (size_t i = 0; i < num; i++) {
@@ -119,7 +130,7 @@ WholeBrainVoxelDrawingMode::findData(const Enum enumValue)
  */
 AString 
 WholeBrainVoxelDrawingMode::toName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const WholeBrainVoxelDrawingMode* enumInstance = findData(enumValue);
     return enumInstance->name;
@@ -138,7 +149,7 @@ WholeBrainVoxelDrawingMode::toName(Enum enumValue) {
 WholeBrainVoxelDrawingMode::Enum 
 WholeBrainVoxelDrawingMode::fromName(const AString& name, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = DRAW_VOXELS_ON_TWO_D_SLICES;
@@ -172,7 +183,7 @@ WholeBrainVoxelDrawingMode::fromName(const AString& name, bool* isValidOut)
  */
 AString 
 WholeBrainVoxelDrawingMode::toGuiName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const WholeBrainVoxelDrawingMode* enumInstance = findData(enumValue);
     return enumInstance->guiName;
@@ -191,7 +202,7 @@ WholeBrainVoxelDrawingMode::toGuiName(Enum enumValue) {
 WholeBrainVoxelDrawingMode::Enum 
 WholeBrainVoxelDrawingMode::fromGuiName(const AString& guiName, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = DRAW_VOXELS_ON_TWO_D_SLICES;
@@ -225,7 +236,7 @@ WholeBrainVoxelDrawingMode::fromGuiName(const AString& guiName, bool* isValidOut
 int32_t
 WholeBrainVoxelDrawingMode::toIntegerCode(Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     const WholeBrainVoxelDrawingMode* enumInstance = findData(enumValue);
     return enumInstance->integerCode;
 }
@@ -244,7 +255,7 @@ WholeBrainVoxelDrawingMode::toIntegerCode(Enum enumValue)
 WholeBrainVoxelDrawingMode::Enum
 WholeBrainVoxelDrawingMode::fromIntegerCode(const int32_t integerCode, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = DRAW_VOXELS_ON_TWO_D_SLICES;
@@ -279,7 +290,7 @@ WholeBrainVoxelDrawingMode::fromIntegerCode(const int32_t integerCode, bool* isV
 void
 WholeBrainVoxelDrawingMode::getAllEnums(std::vector<WholeBrainVoxelDrawingMode::Enum>& allEnums)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allEnums.clear();
     
@@ -301,7 +312,7 @@ WholeBrainVoxelDrawingMode::getAllEnums(std::vector<WholeBrainVoxelDrawingMode::
 void
 WholeBrainVoxelDrawingMode::getAllNames(std::vector<AString>& allNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allNames.clear();
     
@@ -327,7 +338,7 @@ WholeBrainVoxelDrawingMode::getAllNames(std::vector<AString>& allNames, const bo
 void
 WholeBrainVoxelDrawingMode::getAllGuiNames(std::vector<AString>& allGuiNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allGuiNames.clear();
     
@@ -25,9 +25,19 @@
 #undef __CHART_AXIS_LOCATION_ENUM_DECLARE__
 
 #include "CaretAssert.h"
+#include "CaretMutex.h"
 
 using namespace caret;
 
+namespace
+{
+    CaretMutex& getInitializeMutex()
+    {//function-local, so it exists even if the enum is first used while initializing another static
+        static CaretMutex s_initializeMutex;
+        return s_initializeMutex;
+    }
+}
+
     
 /**
  * \class caret::ChartAxisLocationEnum 
@@ -101,10 +111,10 @@ ChartAxisLocationEnum::~ChartAxisLocationEnum()
 void
 ChartAxisLocationEnum::initialize()
 {
+    CaretMutexLocker locker(&getInitializeMutex());//always lock, an unlocked check of the flag could see it set before the data it guards
     if (initializedFlag) {
         return;
     }
-    initializedFlag = true;
 
     enumData.push_back(ChartAxisLocationEnum(CHART_AXIS_LOCATION_BOTTOM, 
                                     "CHART_AXIS_LOCATION_BOTTOM", 
@@ -122,6 +132,7 @@ ChartAxisLocationEnum::initialize()
                                     "CHART_AXIS_LOCATION_TOP", 
                                     "Top"));
     
+    initializedFlag = true;
 }
 
 /**
@@ -134,7 +145,7 @@ ChartAxisLocationEnum::initialize()
 const ChartAxisLocationEnum*
 ChartAxisLocationEnum::findData(const Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
 
     size_t num = enumData.size();
     for (size_t i = 0; i < num; i++) {
@@ -156,7 +167,7 @@ ChartAxisLocationEnum::findData(const Enum enumValue)
  */
 AString 
 ChartAxisLocationEnum::toName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const ChartAxisLocationEnum* enumInstance = findData(enumValue);
     return enumInstance->name;
@@ -175,7 +186,7 @@ ChartAxisLocationEnum::toName(Enum enumValue) {
 ChartAxisLocationEnum::Enum 
 ChartAxisLocationEnum::fromName(const AString& name, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = ChartAxisLocationEnum::enumData[0].enumValue;
@@ -209,7 +220,7 @@ ChartAxisLocationEnum::fromName(const AString& name, bool* isValidOut)
  */
 AString 
 ChartAxisLocationEnum::toGuiName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const ChartAxisLocationEnum* enumInstance = findData(enumValue);
     return enumInstance->guiName;
@@ -228,7 +239,7 @@ ChartAxisLocationEnum::toGuiName(Enum enumValue) {
 ChartAxisLocationEnum::Enum 
 ChartAxisLocationEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = ChartAxisLocationEnum::enumData[0].enumValue;
@@ -262,7 +273,7 @@ ChartAxisLocationEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 int32_t
 ChartAxisLocationEnum::toIntegerCode(Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     const ChartAxisLocationEnum* enumInstance = findData(enumValue);
     return enumInstance->integerCode;
 }
@@ -281,7 +292,7 @@ ChartAxisLocationEnum::toIntegerCode(Enum enumValue)
 ChartAxisLocationEnum::Enum
 ChartAxisLocationEnum::fromIntegerCode(const int32_t integerCode, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = ChartAxisLocationEnum::enumData[0].enumValue;
@@ -316,7 +327,7 @@ ChartAxisLocationEnum::fromIntegerCode(const int32_t integerCode, bool* isValidO
 void
 ChartAxisLocationEnum::getAllEnums(std::vector<ChartAxisLocationEnum::Enum>& allEnums)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allEnums.clear();
     
@@ -338,7 +349,7 @@ ChartAxisLocationEnum::getAllEnums(std::vector<ChartAxisLocationEnum::Enum>& all
 void
 ChartAxisLocationEnum::getAllNames(std::vector<AString>& allNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allNames.clear();
     
@@ -364,7 +375,7 @@ ChartAxisLocationEnum::getAllNames(std::vector<AString>& allNames, const bool is
 void
 ChartAxisLocationEnum::getAllGuiNames(std::vector<AString>& allGuiNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allGuiNames.clear();
     
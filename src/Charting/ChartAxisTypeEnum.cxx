@@ -25,9 +25,19 @@
 #undef __CHART_AXIS_TYPE_ENUM_DECLARE__
 
 #include "CaretAssert.h"
+#include "CaretMutex.h"
 
 using namespace caret;
 
+namespace
+{
+    CaretMutex& getInitializeMutex()
+    {//function-local, so it exists even if the enum is first used while initializing another static
+        static CaretMutex s_initializeMutex;
+        return s_initializeMutex;
+    }
+}
+
     
 /**
  * \class caret::ChartAxisTypeEnum 
@@ -101,10 +111,10 @@ ChartAxisTypeEnum::~ChartAxisTypeEnum()
 void
 ChartAxisTypeEnum::initialize()
 {
+    CaretMutexLocker locker(&getInitializeMutex());//always lock, an unlocked check of the flag could see it set before the data it guards
     if (initializedFlag) {
         return;
     }
-    initializedFlag = true;
 
     enumData.push_back(ChartAxisTypeEnum(CHART_AXIS_TYPE_NONE, 
                                     "CHART_AXIS_TYPE_NONE", 
@@ -114,6 +124,7 @@ ChartAxisTypeEnum::initialize()
                                     "CHART_AXIS_TYPE_CARTESIAN", 
                                     "Cartesian Axis"));
     
+    initializedFlag = true;
 }
 
 /**
@@ -126,7 +137,7 @@ ChartAxisTypeEnum::initialize()
 const ChartAxisTypeEnum*
 ChartAxisTypeEnum::findData(const Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
 
     size_t num = enumData.size();
     for (size_t i = 0; i < num; i++) {
@@ -148,7 +159,7 @@ ChartAxisTypeEnum::findData(const Enum enumValue)
  */
 AString 
 ChartAxisTypeEnum::toName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const ChartAxisTypeEnum* enumInstance = findData(enumValue);
     return enumInstance->name;
@@ -167,7 +178,7 @@ ChartAxisTypeEnum::toName(Enum enumValue) {
 ChartAxisTypeEnum::Enum 
 ChartAxisTypeEnum::fromName(const AString& name, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = ChartAxisTypeEnum::enumData[0].enumValue;
@@ -201,7 +212,7 @@ ChartAxisTypeEnum::fromName(const AString& name, bool* isValidOut)
  */
 AString 
 ChartAxisTypeEnum::toGuiName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const ChartAxisTypeEnum* enumInstance = findData(enumValue);
     return enumInstance->guiName;
@@ -220,7 +231,7 @@ ChartAxisTypeEnum::toGuiName(Enum enumValue) {
 ChartAxisTypeEnum::Enum 
 ChartAxisTypeEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = ChartAxisTypeEnum::enumData[0].enumValue;
@@ -254,7 +265,7 @@ ChartAxisTypeEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 int32_t
 ChartAxisTypeEnum::toIntegerCode(Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     const ChartAxisTypeEnum* enumInstance = findData(enumValue);
     return enumInstance->integerCode;
 }
@@ -273,7 +284,7 @@ ChartAxisTypeEnum::toIntegerCode(Enum enumValue)
 ChartAxisTypeEnum::Enum
 ChartAxisTypeEnum::fromIntegerCode(const int32_t integerCode, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = ChartAxisTypeEnum::enumData[0].enumValue;
@@ -308,7 +319,7 @@ ChartAxisTypeEnum::fromIntegerCode(const int32_t integerCode, bool* isValidOut)
 void
 ChartAxisTypeEnum::getAllEnums(std::vector<ChartAxisTypeEnum::Enum>& allEnums)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allEnums.clear();
     
@@ -330,7 +341,7 @@ ChartAxisTypeEnum::getAllEnums(std::vector<ChartAxisTypeEnum::Enum>& allEnums)
 void
 ChartAxisTypeEnum::getAllNames(std::vector<AString>& allNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allNames.clear();
     
@@ -356,7 +367,7 @@ ChartAxisTypeEnum::getAllNames(std::vector<AString>& allNames, const bool isSort
 void
 ChartAxisTypeEnum::getAllGuiNames(std::vector<AString>& allGuiNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allGuiNames.clear();
     
@@ -25,9 +25,19 @@
 #undef __CHART_AXIS_UNITS_ENUM_DECLARE__
 
 #include "CaretAssert.h"
+#include "CaretMutex.h"
 
 using namespace caret;
 
+namespace
+{
+    CaretMutex& getInitializeMutex()
+    {//function-local, so it exists even if the enum is first used while initializing another static
+        static CaretMutex s_initializeMutex;
+        return s_initializeMutex;
+    }
+}
+
     
 /**
  * \class caret::ChartAxisUnitsEnum 
@@ -101,10 +111,10 @@ ChartAxisUnitsEnum::~ChartAxisUnitsEnum()
 void
 ChartAxisUnitsEnum::initialize()
 {
+    CaretMutexLocker locker(&getInitializeMutex());//always lock, an unlocked check of the flag could see it set before the data it guards
     if (initializedFlag) {
         return;
     }
-    initializedFlag = true;
 
     enumData.push_back(ChartAxisUnitsEnum(CHART_AXIS_UNITS_NONE, 
                                     "CHART_AXIS_UNITS_NONE", 
@@ -118,6 +128,7 @@ ChartAxisUnitsEnum::initialize()
                                     "CHART_AXIS_UNITS_TIME_SECONDS", 
                                     "Time"));
     
+    initializedFlag = true;
 }
 
 /**
@@ -130,7 +141,7 @@ ChartAxisUnitsEnum::initialize()
 const ChartAxisUnitsEnum*
 ChartAxisUnitsEnum::findData(const Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
 
     size_t num = enumData.size();
     for (size_t i = 0; i < num; i++) {
@@ -152,7 +163,7 @@ ChartAxisUnitsEnum::findData(const Enum enumValue)
  */
 AString 
 ChartAxisUnitsEnum::toName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const ChartAxisUnitsEnum* enumInstance = findData(enumValue);
     return enumInstance->name;
@@ -171,7 +182,7 @@ ChartAxisUnitsEnum::toName(Enum enumValue) {
 ChartAxisUnitsEnum::Enum 
 ChartAxisUnitsEnum::fromName(const AString& name, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = ChartAxisUnitsEnum::enumData[0].enumValue;
@@ -205,7 +216,7 @@ ChartAxisUnitsEnum::fromName(const AString& name, bool* isValidOut)
  */
 AString 
 ChartAxisUnitsEnum::toGuiName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const ChartAxisUnitsEnum* enumInstance = findData(enumValue);
     return enumInstance->guiName;
@@ -224,7 +235,7 @@ ChartAxisUnitsEnum::toGuiName(Enum enumValue) {
 ChartAxisUnitsEnum::Enum 
 ChartAxisUnitsEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = ChartAxisUnitsEnum::enumData[0].enumValue;
@@ -258,7 +269,7 @@ ChartAxisUnitsEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 int32_t
 ChartAxisUnitsEnum::toIntegerCode(Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     const ChartAxisUnitsEnum* enumInstance = findData(enumValue);
     return enumInstance->integerCode;
 }
@@ -277,7 +288,7 @@ ChartAxisUnitsEnum::toIntegerCode(Enum enumValue)
 ChartAxisUnitsEnum::Enum
 ChartAxisUnitsEnum::fromIntegerCode(const int32_t integerCode, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = ChartAxisUnitsEnum::enumData[0].enumValue;
@@ -312,7 +323,7 @@ ChartAxisUnitsEnum::fromIntegerCode(const int32_t integerCode, bool* isValidOut)
 void
 ChartAxisUnitsEnum::getAllEnums(std::vector<ChartAxisUnitsEnum::Enum>& allEnums)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allEnums.clear();
     
@@ -334,7 +345,7 @@ ChartAxisUnitsEnum::getAllEnums(std::vector<ChartAxisUnitsEnum::Enum>& allEnums)
 void
 ChartAxisUnitsEnum::getAllNames(std::vector<AString>& allNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allNames.clear();
     
@@ -360,7 +371,7 @@ ChartAxisUnitsEnum::getAllNames(std::vector<AString>& allNames, const bool isSor
 void
 ChartAxisUnitsEnum::getAllGuiNames(std::vector<AString>& allGuiNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allGuiNames.clear();
     
@@ -25,9 +25,19 @@
 #undef __CHART_DATA_SOURCE_MODE_ENUM_DECLARE__
 
 #include "CaretAssert.h"
+#include "CaretMutex.h"
 
 using namespace caret;
 
+namespace
+{
+    CaretMutex& getInitializeMutex()
+    {//function-local, so it exists even if the enum is first used while initializing another static
+        static CaretMutex s_initializeMutex;
+        return s_initializeMutex;
+    }
+}
+
     
 /**
  * \class caret::ChartDataSourceModeEnum 
@@ -103,10 +113,10 @@ ChartDataSourceModeEnum::~ChartDataSourceModeEnum()
 void
 ChartDataSourceModeEnum::initialize()
 {
+    CaretMutexLocker locker(&getInitializeMutex());//always lock, an unlocked check of the flag could see it set before the data it guards
     if (initializedFlag) {
         return;
     }
-    initializedFlag = true;
 
     enumData.push_back(ChartDataSourceModeEnum(CHART_DATA_SOURCE_MODE_INVALID, 
                                     "CHART_DATA_SOURCE_MODE_INVALID", 
@@ -128,6 +138,7 @@ ChartDataSourceModeEnum::initialize()
                                     "CHART_DATA_SOURCE_MODE_VOXEL_IJK", 
                                     "Chart Source Voxel"));
     
+    initializedFlag = true;
 }
 
 /**
@@ -140,7 +151,7 @@ ChartDataSourceModeEnum::initialize()
 const ChartDataSourceModeEnum*
 ChartDataSourceModeEnum::findData(const Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
 
     size_t num = enumData.size();
     for (size_t i = 0; i < num; i++) {
@@ -162,7 +173,7 @@ ChartDataSourceModeEnum::findData(const Enum enumValue)
  */
 AString 
 ChartDataSourceModeEnum::toName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const ChartDataSourceModeEnum* enumInstance = findData(enumValue);
     return enumInstance->name;
@@ -181,7 +192,7 @@ ChartDataSourceModeEnum::toName(Enum enumValue) {
 ChartDataSourceModeEnum::Enum 
 ChartDataSourceModeEnum::fromName(const AString& name, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = ChartDataSourceModeEnum::enumData[0].enumValue;
@@ -215,7 +226,7 @@ ChartDataSourceModeEnum::fromName(const AString& name, bool* isValidOut)
  */
 AString 
 ChartDataSourceModeEnum::toGuiName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const ChartDataSourceModeEnum* enumInstance = findData(enumValue);
     return enumInstance->guiName;
@@ -234,7 +245,7 @@ ChartDataSourceModeEnum::toGuiName(Enum enumValue) {
 ChartDataSourceModeEnum::Enum 
 ChartDataSourceModeEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = ChartDataSourceModeEnum::enumData[0].enumValue;
@@ -268,7 +279,7 @@ ChartDataSourceModeEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 int32_t
 ChartDataSourceModeEnum::toIntegerCode(Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     const ChartDataSourceModeEnum* enumInstance = findData(enumValue);
     return enumInstance->integerCode;
 }
@@ -287,7 +298,7 @@ ChartDataSourceModeEnum::toIntegerCode(Enum enumValue)
 ChartDataSourceModeEnum::Enum
 ChartDataSourceModeEnum::fromIntegerCode(const int32_t integerCode, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = ChartDataSourceModeEnum::enumData[0].enumValue;
@@ -322,7 +333,7 @@ ChartDataSourceModeEnum::fromIntegerCode(const int32_t integerCode, bool* isVali
 void
 ChartDataSourceModeEnum::getAllEnums(std::vector<ChartDataSourceModeEnum::Enum>& allEnums)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allEnums.clear();
     
@@ -344,7 +355,7 @@ ChartDataSourceModeEnum::getAllEnums(std::vector<ChartDataSourceModeEnum::Enum>&
 void
 ChartDataSourceModeEnum::getAllNames(std::vector<AString>& allNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allNames.clear();
     
@@ -370,7 +381,7 @@ ChartDataSourceModeEnum::getAllNames(std::vector<AString>& allNames, const bool
 void
 ChartDataSourceModeEnum::getAllGuiNames(std::vector<AString>& allGuiNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allGuiNames.clear();
     
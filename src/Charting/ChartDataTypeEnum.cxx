@@ -25,9 +25,19 @@
 #undef __CHART_DATA_TYPE_ENUM_DECLARE__
 
 #include "CaretAssert.h"
+#include "CaretMutex.h"
 
 using namespace caret;
 
+namespace
+{
+    CaretMutex& getInitializeMutex()
+    {//function-local, so it exists even if the enum is first used while initializing another static
+        static CaretMutex s_initializeMutex;
+        return s_initializeMutex;
+    }
+}
+
     
 /**
  * \class caret::ChartDataTypeEnum 
@@ -101,10 +111,10 @@ ChartDataTypeEnum::~ChartDataTypeEnum()
 void
 ChartDataTypeEnum::initialize()
 {
+    CaretMutexLocker locker(&getInitializeMutex());//always lock, an unlocked check of the flag could see it set before the data it guards
     if (initializedFlag) {
         return;
     }
-    initializedFlag = true;
 
     enumData.push_back(ChartDataTypeEnum(CHART_DATA_TYPE_INVALID,
                                          "CHART_DATA_TYPE_INVALID",
@@ -129,6 +139,8 @@ ChartDataTypeEnum::initialize()
     enumData.push_back(ChartDataTypeEnum(CHART_DATA_TYPE_MATRIX_SERIES,
                                          "CHART_DATA_TYPE_MATRIX_SERIES",
                                          "Matrix - Series"));
+    
+    initializedFlag = true;
 }
 
 /**
@@ -141,7 +153,7 @@ ChartDataTypeEnum::initialize()
 const ChartDataTypeEnum*
 ChartDataTypeEnum::findData(const Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
 
     size_t num = enumData.size();
     for (size_t i = 0; i < num; i++) {
@@ -163,7 +175,7 @@ ChartDataTypeEnum::findData(const Enum enumValue)
  */
 AString 
 ChartDataTypeEnum::toName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const ChartDataTypeEnum* enumInstance = findData(enumValue);
     return enumInstance->name;
@@ -182,7 +194,7 @@ ChartDataTypeEnum::toName(Enum enumValue) {
 ChartDataTypeEnum::Enum 
 ChartDataTypeEnum::fromName(const AString& nameIn, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
  
     /*
      * Convert from obsolete names
@@ -230,7 +242,7 @@ ChartDataTypeEnum::fromName(const AString& nameIn, bool* isValidOut)
  */
 AString 
 ChartDataTypeEnum::toGuiName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const ChartDataTypeEnum* enumInstance = findData(enumValue);
     return enumInstance->guiName;
@@ -249,7 +261,7 @@ ChartDataTypeEnum::toGuiName(Enum enumValue) {
 ChartDataTypeEnum::Enum 
 ChartDataTypeEnum::fromGuiName(const AString& guiNameIn, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     AString guiName(guiNameIn);
     if (guiName == "Matrix") {
@@ -288,7 +300,7 @@ ChartDataTypeEnum::fromGuiName(const AString& guiNameIn, bool* isValidOut)
 int32_t
 ChartDataTypeEnum::toIntegerCode(Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     const ChartDataTypeEnum* enumInstance = findData(enumValue);
     return enumInstance->integerCode;
 }
@@ -307,7 +319,7 @@ ChartDataTypeEnum::toIntegerCode(Enum enumValue)
 ChartDataTypeEnum::Enum
 ChartDataTypeEnum::fromIntegerCode(const int32_t integerCode, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = ChartDataTypeEnum::enumData[0].enumValue;
@@ -342,7 +354,7 @@ ChartDataTypeEnum::fromIntegerCode(const int32_t integerCode, bool* isValidOut)
 void
 ChartDataTypeEnum::getAllEnums(std::vector<ChartDataTypeEnum::Enum>& allEnums)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allEnums.clear();
     
@@ -364,7 +376,7 @@ ChartDataTypeEnum::getAllEnums(std::vector<ChartDataTypeEnum::Enum>& allEnums)
 void
 ChartDataTypeEnum::getAllNames(std::vector<AString>& allNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allNames.clear();
     
@@ -390,7 +402,7 @@ ChartDataTypeEnum::getAllNames(std::vector<AString>& allNames, const bool isSort
 void
 ChartDataTypeEnum::getAllGuiNames(std::vector<AString>& allGuiNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allGuiNames.clear();
     
@@ -25,9 +25,19 @@
 #undef __CHART_MATRIX_LOADING_TYPE_ENUM_DECLARE__
 
 #include "CaretAssert.h"
+#include "CaretMutex.h"
 
 using namespace caret;
 
+namespace
+{
+    CaretMutex& getInitializeMutex()
+    {//function-local, so it exists even if the enum is first used while initializing another static
+        static CaretMutex s_initializeMutex;
+        return s_initializeMutex;
+    }
+}
+
     
 /**
  * \class caret::ChartMatrixLoadingDimensionEnum 
@@ -101,10 +111,10 @@ ChartMatrixLoadingDimensionEnum::~ChartMatrixLoadingDimensionEnum()
 void
 ChartMatrixLoadingDimensionEnum::initialize()
 {
+    CaretMutexLocker locker(&getInitializeMutex());//always lock, an unlocked check of the flag could see it set before the data it guards
     if (initializedFlag) {
         return;
     }
-    initializedFlag = true;
 
     enumData.push_back(ChartMatrixLoadingDimensionEnum(CHART_MATRIX_LOADING_BY_ROW,
                                                        "CHART_MATRIX_LOADING_BY_ROW",
@@ -113,6 +123,8 @@ ChartMatrixLoadingDimensionEnum::initialize()
     enumData.push_back(ChartMatrixLoadingDimensionEnum(CHART_MATRIX_LOADING_BY_COLUMN,
                                                        "CHART_MATRIX_LOADING_BY_COLUMN",
                                                        "Column"));
+    
+    initializedFlag = true;
 }
 
 /**
@@ -125,7 +137,7 @@ ChartMatrixLoadingDimensionEnum::initialize()
 const ChartMatrixLoadingDimensionEnum*
 ChartMatrixLoadingDimensionEnum::findData(const Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
 
     size_t num = enumData.size();
     for (size_t i = 0; i < num; i++) {
@@ -147,7 +159,7 @@ ChartMatrixLoadingDimensionEnum::findData(const Enum enumValue)
  */
 AString 
 ChartMatrixLoadingDimensionEnum::toName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const ChartMatrixLoadingDimensionEnum* enumInstance = findData(enumValue);
     return enumInstance->name;
@@ -166,7 +178,7 @@ ChartMatrixLoadingDimensionEnum::toName(Enum enumValue) {
 ChartMatrixLoadingDimensionEnum::Enum 
 ChartMatrixLoadingDimensionEnum::fromName(const AString& name, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = ChartMatrixLoadingDimensionEnum::enumData[0].enumValue;
@@ -200,7 +212,7 @@ ChartMatrixLoadingDimensionEnum::fromName(const AString& name, bool* isValidOut)
  */
 AString 
 ChartMatrixLoadingDimensionEnum::toGuiName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const ChartMatrixLoadingDimensionEnum* enumInstance = findData(enumValue);
     return enumInstance->guiName;
@@ -219,7 +231,7 @@ ChartMatrixLoadingDimensionEnum::toGuiName(Enum enumValue) {
 ChartMatrixLoadingDimensionEnum::Enum 
 ChartMatrixLoadingDimensionEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = ChartMatrixLoadingDimensionEnum::enumData[0].enumValue;
@@ -253,7 +265,7 @@ ChartMatrixLoadingDimensionEnum::fromGuiName(const AString& guiName, bool* isVal
 int32_t
 ChartMatrixLoadingDimensionEnum::toIntegerCode(Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     const ChartMatrixLoadingDimensionEnum* enumInstance = findData(enumValue);
     return enumInstance->integerCode;
 }
@@ -272,7 +284,7 @@ ChartMatrixLoadingDimensionEnum::toIntegerCode(Enum enumValue)
 ChartMatrixLoadingDimensionEnum::Enum
 ChartMatrixLoadingDimensionEnum::fromIntegerCode(const int32_t integerCode, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = ChartMatrixLoadingDimensionEnum::enumData[0].enumValue;
@@ -307,7 +319,7 @@ ChartMatrixLoadingDimensionEnum::fromIntegerCode(const int32_t integerCode, bool
 void
 ChartMatrixLoadingDimensionEnum::getAllEnums(std::vector<ChartMatrixLoadingDimensionEnum::Enum>& allEnums)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allEnums.clear();
     
@@ -329,7 +341,7 @@ ChartMatrixLoadingDimensionEnum::getAllEnums(std::vector<ChartMatrixLoadingDimen
 void
 ChartMatrixLoadingDimensionEnum::getAllNames(std::vector<AString>& allNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allNames.clear();
     
@@ -355,7 +367,7 @@ ChartMatrixLoadingDimensionEnum::getAllNames(std::vector<AString>& allNames, con
 void
 ChartMatrixLoadingDimensionEnum::getAllGuiNames(std::vector<AString>& allGuiNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allGuiNames.clear();
     
@@ -25,9 +25,19 @@
 #undef __CHART_MATRIX_SCALE_MODE_ENUM_DECLARE__
 
 #include "CaretAssert.h"
+#include "CaretMutex.h"
 
 using namespace caret;
 
+namespace
+{
+    CaretMutex& getInitializeMutex()
+    {//function-local, so it exists even if the enum is first used while initializing another static
+        static CaretMutex s_initializeMutex;
+        return s_initializeMutex;
+    }
+}
+
     
 /**
  * \class caret::ChartMatrixScaleModeEnum 
@@ -103,10 +113,10 @@ ChartMatrixScaleModeEnum::~ChartMatrixScaleModeEnum()
 void
 ChartMatrixScaleModeEnum::initialize()
 {
+    CaretMutexLocker locker(&getInitializeMutex());//always lock, an unlocked check of the flag could see it set before the data it guards
     if (initializedFlag) {
         return;
     }
-    initializedFlag = true;
 
     enumData.push_back(ChartMatrixScaleModeEnum(CHART_MATRIX_SCALE_AUTO, 
                                     "CHART_MATRIX_SCALE_AUTO", 
@@ -116,6 +126,7 @@ ChartMatrixScaleModeEnum::initialize()
                                     "CHART_MATRIX_SCALE_MANUAL", 
                                     "Manual"));
     
+    initializedFlag = true;
 }
 
 /**
@@ -128,7 +139,7 @@ ChartMatrixScaleModeEnum::initialize()
 const ChartMatrixScaleModeEnum*
 ChartMatrixScaleModeEnum::findData(const Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
 
     size_t num = enumData.size();
     for (size_t i = 0; i < num; i++) {
@@ -150,7 +161,7 @@ ChartMatrixScaleModeEnum::findData(const Enum enumValue)
  */
 AString 
 ChartMatrixScaleModeEnum::toName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const ChartMatrixScaleModeEnum* enumInstance = findData(enumValue);
     return enumInstance->name;
@@ -169,7 +180,7 @@ ChartMatrixScaleModeEnum::toName(Enum enumValue) {
 ChartMatrixScaleModeEnum::Enum 
 ChartMatrixScaleModeEnum::fromName(const AString& name, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = ChartMatrixScaleModeEnum::enumData[0].enumValue;
@@ -203,7 +214,7 @@ ChartMatrixScaleModeEnum::fromName(const AString& name, bool* isValidOut)
  */
 AString 
 ChartMatrixScaleModeEnum::toGuiName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const ChartMatrixScaleModeEnum* enumInstance = findData(enumValue);
     return enumInstance->guiName;
@@ -222,7 +233,7 @@ ChartMatrixScaleModeEnum::toGuiName(Enum enumValue) {
 ChartMatrixScaleModeEnum::Enum 
 ChartMatrixScaleModeEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = ChartMatrixScaleModeEnum::enumData[0].enumValue;
@@ -256,7 +267,7 @@ ChartMatrixScaleModeEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 int32_t
 ChartMatrixScaleModeEnum::toIntegerCode(Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     const ChartMatrixScaleModeEnum* enumInstance = findData(enumValue);
     return enumInstance->integerCode;
 }
@@ -275,7 +286,7 @@ ChartMatrixScaleModeEnum::toIntegerCode(Enum enumValue)
 ChartMatrixScaleModeEnum::Enum
 ChartMatrixScaleModeEnum::fromIntegerCode(const int32_t integerCode, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = ChartMatrixScaleModeEnum::enumData[0].enumValue;
@@ -310,7 +321,7 @@ ChartMatrixScaleModeEnum::fromIntegerCode(const int32_t integerCode, bool* isVal
 void
 ChartMatrixScaleModeEnum::getAllEnums(std::vector<ChartMatrixScaleModeEnum::Enum>& allEnums)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allEnums.clear();
     
@@ -332,7 +343,7 @@ ChartMatrixScaleModeEnum::getAllEnums(std::vector<ChartMatrixScaleModeEnum::Enum
 void
 ChartMatrixScaleModeEnum::getAllNames(std::vector<AString>& allNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allNames.clear();
     
@@ -358,7 +369,7 @@ ChartMatrixScaleModeEnum::getAllNames(std::vector<AString>& allNames, const bool
 void
 ChartMatrixScaleModeEnum::getAllGuiNames(std::vector<AString>& allGuiNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allGuiNames.clear();
     
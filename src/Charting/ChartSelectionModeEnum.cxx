@@ -25,9 +25,19 @@
 #undef __CHART_SELECTION_MODE_ENUM_DECLARE__
 
 #include "CaretAssert.h"
+#include "CaretMutex.h"
 
 using namespace caret;
 
+namespace
+{
+    CaretMutex& getInitializeMutex()
+    {//function-local, so it exists even if the enum is first used while initializing another static
+        static CaretMutex s_initializeMutex;
+        return s_initializeMutex;
+    }
+}
+
     
 /**
  * \class caret::ChartSelectionModeEnum 
@@ -101,10 +111,10 @@ ChartSelectionModeEnum::~ChartSelectionModeEnum()
 void
 ChartSelectionModeEnum::initialize()
 {
+    CaretMutexLocker locker(&getInitializeMutex());//always lock, an unlocked check of the flag could see it set before the data it guards
     if (initializedFlag) {
         return;
     }
-    initializedFlag = true;
 
     enumData.push_back(ChartSelectionModeEnum(CHART_SELECTION_MODE_ANY, 
                                     "CHART_SELECTION_MODE_ANY", 
@@ -114,6 +124,7 @@ ChartSelectionModeEnum::initialize()
                                     "CHART_SELECTION_MODE_SINGLE", 
                                     "Only one item can be selected"));
     
+    initializedFlag = true;
 }
 
 /**
@@ -126,7 +137,7 @@ ChartSelectionModeEnum::initialize()
 const ChartSelectionModeEnum*
 ChartSelectionModeEnum::findData(const Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
 
     size_t num = enumData.size();
     for (size_t i = 0; i < num; i++) {
@@ -148,7 +159,7 @@ ChartSelectionModeEnum::findData(const Enum enumValue)
  */
 AString 
 ChartSelectionModeEnum::toName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const ChartSelectionModeEnum* enumInstance = findData(enumValue);
     return enumInstance->name;
@@ -167,7 +178,7 @@ ChartSelectionModeEnum::toName(Enum enumValue) {
 ChartSelectionModeEnum::Enum 
 ChartSelectionModeEnum::fromName(const AString& name, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = ChartSelectionModeEnum::enumData[0].enumValue;
@@ -201,7 +212,7 @@ ChartSelectionModeEnum::fromName(const AString& name, bool* isValidOut)
  */
 AString 
 ChartSelectionModeEnum::toGuiName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const ChartSelectionModeEnum* enumInstance = findData(enumValue);
     return enumInstance->guiName;
@@ -220,7 +231,7 @@ ChartSelectionModeEnum::toGuiName(Enum enumValue) {
 ChartSelectionModeEnum::Enum 
 ChartSelectionModeEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = ChartSelectionModeEnum::enumData[0].enumValue;
@@ -254,7 +265,7 @@ ChartSelectionModeEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 int32_t
 ChartSelectionModeEnum::toIntegerCode(Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     const ChartSelectionModeEnum* enumInstance = findData(enumValue);
     return enumInstance->integerCode;
 }
@@ -273,7 +284,7 @@ ChartSelectionModeEnum::toIntegerCode(Enum enumValue)
 ChartSelectionModeEnum::Enum
 ChartSelectionModeEnum::fromIntegerCode(const int32_t integerCode, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = ChartSelectionModeEnum::enumData[0].enumValue;
@@ -308,7 +319,7 @@ ChartSelectionModeEnum::fromIntegerCode(const int32_t integerCode, bool* isValid
 void
 ChartSelectionModeEnum::getAllEnums(std::vector<ChartSelectionModeEnum::Enum>& allEnums)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allEnums.clear();
     
@@ -330,7 +341,7 @@ ChartSelectionModeEnum::getAllEnums(std::vector<ChartSelectionModeEnum::Enum>& a
 void
 ChartSelectionModeEnum::getAllNames(std::vector<AString>& allNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allNames.clear();
     
@@ -356,7 +367,7 @@ ChartSelectionModeEnum::getAllNames(std::vector<AString>& allNames, const bool i
 void
 ChartSelectionModeEnum::getAllGuiNames(std::vector<AString>& allGuiNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allGuiNames.clear();
     
@@ -0,0 +1,90 @@
+/*LICENSE_START*/
+/*
+ *  Copyright (C) 2014  Washington University School of Medicine
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+/*LICENSE_END*/
+
+#include "CiftiDeferredElement.h"
+
+#include "CaretAssert.h"
+#include "CaretException.h"
+
+#include <QXmlStreamReader>
+#include <QXmlStreamWriter>
+
+using namespace caret;
+
+void CiftiDeferredElement::clear()
+{
+    m_text = QString();//release the memory, rather than just truncating
+    m_error = QString();
+    m_present = false;
+}
+
+void CiftiDeferredElement::capture(QXmlStreamReader& xml)
+{
+    CaretAssert(xml.isStartElement());
+    m_text.clear();
+    QXmlStreamWriter writer(&m_text);//only tokenizing and copying text, none of the contents get converted into objects here
+    int depth = 0;
+    for (; !xml.atEnd(); xml.readNext())
+    {
+        writer.writeCurrentToken(xml);
+        if (xml.isStartElement())
+        {
+            ++depth;
+        } else if (xml.isEndElement()) {
+            --depth;
+            if (depth == 0) break;
+        }
+    }
+    m_present = !xml.hasError();
+}
+
+bool CiftiDeferredElement::startReading(QXmlStreamReader& xml) const
+{
+    if (!m_present) return false;
+    xml.clear();
+    xml.addData(m_text);
+    return xml.readNextStartElement();
+}
+
+void CiftiDeferredElement::decodeOnce(Decoder& decoder, const QString& description)
+{
+    CaretMutexLocker locked(&m_mutex);
+    if (!m_error.isEmpty()) throw CaretException(m_error);
+    if (!m_present) return;
+    QXmlStreamReader xml;
+    if (startReading(xml))
+    {
+        try
+        {
+            decoder.decode(xml);
+        } catch (CaretException& e) {
+            m_error = "failed to parse " + description + ": " + e.whatString();
+        }
+        if (m_error.isEmpty() && xml.hasError())
+        {
+            m_error = "failed to parse " + description + ": " + xml.errorString();
+        }
+    } else {
+        m_error = "failed to parse " + description + ": " + xml.errorString();
+    }
+    m_text = QString();
+    m_present = false;
+    if (!m_error.isEmpty()) throw CaretException(m_error);
+}
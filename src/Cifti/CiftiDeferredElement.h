@@ -0,0 +1,58 @@
+#ifndef __CIFTI_DEFERRED_ELEMENT_H__
+#define __CIFTI_DEFERRED_ELEMENT_H__
+
+/*LICENSE_START*/
+/*
+ *  Copyright (C) 2014  Washington University School of Medicine
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+/*LICENSE_END*/
+
+#include "CaretMutex.h"
+
+#include <QString>
+
+class QXmlStreamReader;
+
+namespace caret
+{
+    ///holds the raw text of one xml element (metadata, label table) so that it can be decoded on first access instead of while parsing the header
+    class CiftiDeferredElement
+    {
+        QString m_text, m_error;
+        bool m_present;
+        CaretMutex m_mutex;
+        bool startReading(QXmlStreamReader& xml) const;
+    public:
+        ///decodes one kind of element from a reader positioned at its start element, throws CaretException on failure
+        class Decoder
+        {
+        public:
+            virtual void decode(QXmlStreamReader& xml) = 0;
+            virtual ~Decoder() { }
+        };
+        CiftiDeferredElement() : m_present(false) { }
+        bool isPresent() const { return m_present; }
+        void clear();
+        ///copies the current start element and everything inside it, leaves xml at the matching end element
+        void capture(QXmlStreamReader& xml);
+        ///decodes the captured element on the first call, safe to call from several threads
+        ///if decoding failed, this and every later call throws, so that a bad element can't be silently dropped when the file is written
+        void decodeOnce(Decoder& decoder, const QString& description);
+    };
+}
+
+#endif //__CIFTI_DEFERRED_ELEMENT_H__
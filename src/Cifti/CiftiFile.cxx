@@ -27,9 +27,10 @@
 #include "DataFileException.h"
 #include "FileInformation.h"
 #include "MultiDimArray.h"
-#include "MultiDimIterator.h"
 #include "NiftiIO.h"
 
+#include <algorithm>
+
 using namespace std;
 using namespace caret;
 
@@ -45,10 +46,12 @@ namespace caret
         CiftiOnDiskImpl(const QString& filename, const CiftiXML& xml, const CiftiVersion& version);//make new empty file with read/write
         void getRow(float* dataOut, const std::vector<int64_t>& indexSelect, const bool& tolerateShortRead) const;
         void getColumn(float* dataOut, const int64_t& index) const;
+        void getRows(float* dataOut, const int64_t& startRow, const int64_t& numRows, const std::vector<int64_t>& dims, const bool& tolerateShortRead) const;
         const CiftiXML& getCiftiXML() const { return m_xml; }
         QString getFilename() const { return m_nifti.getFilename(); }
         void setRow(const float* dataIn, const std::vector<int64_t>& indexSelect);
         void setColumn(const float* dataIn, const int64_t& index);
+        void setRows(const float* dataIn, const int64_t& startRow, const int64_t& numRows, const std::vector<int64_t>& dims);
     };
     
     class CiftiMemoryImpl : public CiftiFile::WriteImplInterface
@@ -58,9 +61,11 @@ namespace caret
         CiftiMemoryImpl(const CiftiXML& xml);
         void getRow(float* dataOut, const std::vector<int64_t>& indexSelect, const bool& tolerateShortRead) const;
         void getColumn(float* dataOut, const int64_t& index) const;
+        void getRows(float* dataOut, const int64_t& startRow, const int64_t& numRows, const std::vector<int64_t>& dims, const bool& tolerateShortRead) const;
         bool isInMemory() const { return true; }
         void setRow(const float* dataIn, const std::vector<int64_t>& indexSelect);
         void setColumn(const float* dataIn, const int64_t& index);
+        void setRows(const float* dataIn, const int64_t& startRow, const int64_t& numRows, const std::vector<int64_t>& dims);
     };
     
     class CiftiXnatImpl : public CiftiFile::ReadImplInterface
@@ -87,6 +92,38 @@ CiftiFile::WriteImplInterface::~WriteImplInterface()
 {
 }
 
+namespace
+{
+    const int64_t ROW_BLOCK_BYTES = 1<<24;//16MB per block keeps reads large without holding much memory
+    
+    vector<int64_t> rowIndexToSelect(int64_t row, const vector<int64_t>& dims)
+    {
+        vector<int64_t> ret(dims.size() - 1);
+        for (int i = 1; i < (int)dims.size(); ++i)
+        {
+            ret[i - 1] = row % dims[i];
+            row /= dims[i];
+        }
+        return ret;
+    }
+}
+
+void CiftiFile::ReadImplInterface::getRows(float* dataOut, const int64_t& startRow, const int64_t& numRows, const vector<int64_t>& dims, const bool& tolerateShortRead) const
+{//fallback for implementations that can only get one row at a time
+    for (int64_t i = 0; i < numRows; ++i)
+    {
+        getRow(dataOut + i * dims[0], rowIndexToSelect(startRow + i, dims), tolerateShortRead);
+    }
+}
+
+void CiftiFile::WriteImplInterface::setRows(const float* dataIn, const int64_t& startRow, const int64_t& numRows, const vector<int64_t>& dims)
+{
+    for (int64_t i = 0; i < numRows; ++i)
+    {
+        setRow(dataIn + i * dims[0], rowIndexToSelect(startRow + i, dims));
+    }
+}
+
 CiftiFile::CiftiFile(const QString& fileName)
 {
     openFile(fileName);
@@ -202,6 +239,15 @@ void CiftiFile::getColumn(float* dataOut, const int64_t& index) const
     m_readingImpl->getColumn(dataOut, index);
 }
 
+void CiftiFile::getRows(float* dataOut, const int64_t& startRow, const int64_t& numRows, const bool& tolerateShortRead) const
+{
+    if (m_dims.empty()) throw DataFileException("getRows called on uninitialized CiftiFile");
+    if (m_dims.size() != 2) throw DataFileException("getRows called on non-2D CiftiFile");
+    if (startRow < 0 || numRows < 0 || startRow + numRows > m_dims[1]) throw DataFileException("getRows called with invalid row range");
+    if (m_readingImpl == NULL) return;//NOT an error because we are pretending to have a matrix already, while we are waiting for setRow to actually start writing the file
+    m_readingImpl->getRows(dataOut, startRow, numRows, m_dims, tolerateShortRead);
+}
+
 void CiftiFile::setCiftiXML(const CiftiXML& xml, const bool useOldMetadata)
 {
     if (xml.getNumberOfDimensions() == 0) throw DataFileException("setCiftiXML called with 0-dimensional CiftiXML");
@@ -261,6 +307,19 @@ void CiftiFile::setColumn(const float* dataIn, const int64_t& index)
     m_writingImpl->setColumn(dataIn, index);
 }
 
+void CiftiFile::setRows(const float* dataIn, const int64_t& startRow, const int64_t& numRows)
+{
+    verifyWriteImpl();
+    if (m_dims.size() != 2) throw DataFileException("setRows called on non-2D CiftiFile");
+    if (startRow < 0 || numRows < 0 || startRow + numRows > m_dims[1]) throw DataFileException("setRows called with invalid row range");
+    m_writingImpl->setRows(dataIn, startRow, numRows, m_dims);
+}
+
+int64_t CiftiFile::getRowBlockSize(const int64_t& rowLength)
+{
+    return max((int64_t)1, ROW_BLOCK_BYTES / max((int64_t)1, rowLength * (int64_t)sizeof(float)));
+}
+
 //compatibility with old interface
 void CiftiFile::getRow(float* dataOut, const int64_t& index, const bool& tolerateShortRead) const
 {
@@ -336,12 +395,18 @@ void CiftiFile::verifyWriteImpl()
 
 void CiftiFile::copyImplData(const ReadImplInterface* from, WriteImplInterface* to, const vector<int64_t>& dims)
 {
-    vector<int64_t> iterateDims(dims.begin() + 1, dims.end());
-    vector<float> scratchRow(dims[0]);
-    for (MultiDimIterator<int64_t> iter(iterateDims); !iter.atEnd(); ++iter)
+    int64_t numRows = 1;
+    for (int i = 1; i < (int)dims.size(); ++i)
+    {
+        numRows *= dims[i];
+    }
+    int64_t blockRows = min(numRows, getRowBlockSize(dims[0]));
+    vector<float> scratchRows(blockRows * dims[0]);
+    for (int64_t start = 0; start < numRows; start += blockRows)
     {
-        from->getRow(scratchRow.data(), *iter, false);
-        to->setRow(scratchRow.data(), *iter);
+        int64_t thisBlock = min(blockRows, numRows - start);
+        from->getRows(scratchRows.data(), start, thisBlock, dims, false);
+        to->setRows(scratchRows.data(), start, thisBlock, dims);
     }
 }
 
@@ -374,6 +439,26 @@ void CiftiMemoryImpl::getColumn(float* dataOut, const int64_t& index) const
     }
 }
 
+void CiftiMemoryImpl::getRows(float* dataOut, const int64_t& startRow, const int64_t& numRows, const vector<int64_t>& dims, const bool&) const
+{
+    const float* ref = m_array.get((int)dims.size(), vector<int64_t>()) + startRow * dims[0];//rows are contiguous in memory
+    int64_t numElems = numRows * dims[0];
+    for (int64_t i = 0; i < numElems; ++i)
+    {
+        dataOut[i] = ref[i];
+    }
+}
+
+void CiftiMemoryImpl::setRows(const float* dataIn, const int64_t& startRow, const int64_t& numRows, const vector<int64_t>& dims)
+{
+    float* ref = m_array.get((int)dims.size(), vector<int64_t>()) + startRow * dims[0];
+    int64_t numElems = numRows * dims[0];
+    for (int64_t i = 0; i < numElems; ++i)
+    {
+        ref[i] = dataIn[i];
+    }
+}
+
 void CiftiMemoryImpl::setRow(const float* dataIn, const vector<int64_t>& indexSelect)
 {
     float* ref = m_array.get(1, indexSelect);
@@ -503,6 +588,16 @@ void CiftiOnDiskImpl::setRow(const float* dataIn, const vector<int64_t>& indexSe
     m_nifti.writeData(dataIn, 5, indexSelect);
 }
 
+void CiftiOnDiskImpl::getRows(float* dataOut, const int64_t& startRow, const int64_t& numRows, const vector<int64_t>&, const bool& tolerateShortRead) const
+{
+    m_nifti.readBlocks(dataOut, 5, startRow, numRows, tolerateShortRead);//rows are contiguous on disk, so this is one read
+}
+
+void CiftiOnDiskImpl::setRows(const float* dataIn, const int64_t& startRow, const int64_t& numRows, const vector<int64_t>&)
+{
+    m_nifti.writeBlocks(dataIn, 5, startRow, numRows);
+}
+
 void CiftiOnDiskImpl::setColumn(const float* dataIn, const int64_t& index)
 {
     CaretAssert(m_xml.getNumberOfDimensions() == 2);//otherwise this shouldn't be called
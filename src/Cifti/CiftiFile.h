@@ -50,11 +50,14 @@ namespace caret
         void getRow(float* dataOut, const std::vector<int64_t>& indexSelect, const bool& tolerateShortRead = false) const;//tolerateShortRead is useful for on-disk writing when it is easiest to do RMW multiple times on a new file
         const std::vector<int64_t>& getDimensions() const { return m_dims; }
         void getColumn(float* dataOut, const int64_t& index) const;//for 2D only, will be slow if on disk!
+        void getRows(float* dataOut, const int64_t& startRow, const int64_t& numRows, const bool& tolerateShortRead = false) const;//for 2D only, consecutive rows packed into dataOut, one large read if on disk
         
         void setCiftiXML(const CiftiXML& xml, const bool useOldMetadata = true);
         void setCiftiXML(const CiftiXMLOld &xml, const bool useOldMetadata = true);//set xml from old implementation
         void setRow(const float* dataIn, const std::vector<int64_t>& indexSelect);
         void setColumn(const float* dataIn, const int64_t& index);//for 2D only, will be slow if on disk!
+        void setRows(const float* dataIn, const int64_t& startRow, const int64_t& numRows);//for 2D only, one large write if on disk
+        static int64_t getRowBlockSize(const int64_t& rowLength);//number of rows to use per getRows/setRows call for streaming through a file
         
         void getRow(float* dataOut, const int64_t& index, const bool& tolerateShortRead) const;//backwards compatibility for old CiftiFile/CiftiInterface
         void getRow(float* dataOut, const int64_t& index) const;
@@ -68,6 +71,7 @@ namespace caret
         public:
             virtual void getRow(float* dataOut, const std::vector<int64_t>& indexSelect, const bool& tolerateShortRead) const = 0;
             virtual void getColumn(float* dataOut, const int64_t& index) const = 0;
+            virtual void getRows(float* dataOut, const int64_t& startRow, const int64_t& numRows, const std::vector<int64_t>& dims, const bool& tolerateShortRead) const;//startRow counts across all dimensions after the first
             virtual bool isInMemory() const { return false; }
             virtual ~ReadImplInterface();
         };
@@ -77,6 +81,7 @@ namespace caret
         public:
             virtual void setRow(const float* dataIn, const std::vector<int64_t>& indexSelect) = 0;
             virtual void setColumn(const float* dataIn, const int64_t& index) = 0;
+            virtual void setRows(const float* dataIn, const int64_t& startRow, const int64_t& numRows, const std::vector<int64_t>& dims);
             virtual ~WriteImplInterface();
         };
     private:
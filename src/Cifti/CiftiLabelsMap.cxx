@@ -24,8 +24,35 @@
 #include "CaretException.h"
 #include "CaretLogger.h"
 
+#include <QXmlStreamReader>
+
 using namespace caret;
 
+namespace
+{
+    class MetaDataDecoder : public CiftiDeferredElement::Decoder
+    {
+        GiftiMetaData& m_metaData;
+    public:
+        MetaDataDecoder(GiftiMetaData& metaData) : m_metaData(metaData) { }
+        void decode(QXmlStreamReader& xml)
+        {
+            m_metaData.readCiftiXML2(xml);//cifti-1 and cifti-2 metadata are the same
+        }
+    };
+    
+    class LabelTableDecoder : public CiftiDeferredElement::Decoder
+    {
+        GiftiLabelTable& m_labelTable;
+    public:
+        LabelTableDecoder(GiftiLabelTable& labelTable) : m_labelTable(labelTable) { }
+        void decode(QXmlStreamReader& xml)
+        {
+            m_labelTable.readFromQXmlStreamReader(xml);
+        }
+    };
+}
+
 void CiftiLabelsMap::clear()
 {
     m_maps.clear();
@@ -34,13 +61,27 @@ void CiftiLabelsMap::clear()
 GiftiLabelTable* CiftiLabelsMap::getMapLabelTable(const int64_t& index) const
 {
     CaretAssertVectorIndex(m_maps, index);
-    return &(m_maps[index].m_labelTable);
+    return m_maps[index].getLabelTable();
 }
 
 GiftiMetaData* CiftiLabelsMap::getMapMetadata(const int64_t& index) const
 {
     CaretAssertVectorIndex(m_maps, index);
-    return &(m_maps[index].m_metaData);
+    return m_maps[index].getMetaData();
+}
+
+GiftiMetaData* CiftiLabelsMap::LabelMap::getMetaData() const
+{
+    MetaDataDecoder myDecoder(m_metaData);
+    m_unparsedMetaData.decodeOnce(myDecoder, "map metadata");
+    return &m_metaData;
+}
+
+GiftiLabelTable* CiftiLabelsMap::LabelMap::getLabelTable() const
+{
+    LabelTableDecoder myDecoder(m_labelTable);
+    m_unparsedLabelTable.decodeOnce(myDecoder, "map label table");
+    return &m_labelTable;
 }
 
 const QString& CiftiLabelsMap::getMapName(const int64_t& index) const
@@ -102,8 +143,8 @@ bool CiftiLabelsMap::operator==(const CiftiMappingType& rhs) const
 bool CiftiLabelsMap::LabelMap::operator==(const LabelMap& rhs) const
 {
     if (m_name != rhs.m_name) return false;
-    if (m_labelTable != rhs.m_labelTable) return false;
-    return (m_metaData == rhs.m_metaData);
+    if (*getLabelTable() != *(rhs.getLabelTable())) return false;
+    return (*getMetaData() == *(rhs.getMetaData()));
 }
 
 void CiftiLabelsMap::readXML1(QXmlStreamReader& xml)
@@ -173,7 +214,7 @@ void CiftiLabelsMap::LabelMap::readXML1(QXmlStreamReader& xml)
                     {
                         throw CaretException("MetaData specified multiple times in one NamedMap");
                     }
-                    m_metaData.readCiftiXML1(xml);
+                    m_unparsedMetaData.capture(xml);
                     if (xml.hasError()) return;
                     haveMetaData = true;
                 } else if (name == "LabelTable") {
@@ -181,7 +222,7 @@ void CiftiLabelsMap::LabelMap::readXML1(QXmlStreamReader& xml)
                     {
                         throw CaretException("LabelTable specified multiple times in one NamedMap");
                     }
-                    m_labelTable.readFromQXmlStreamReader(xml);
+                    m_unparsedLabelTable.capture(xml);
                     if (xml.hasError()) return;
                     haveTable = true;
                 } else if (name == "MapName") {
@@ -227,7 +268,7 @@ void CiftiLabelsMap::LabelMap::readXML2(QXmlStreamReader& xml)
                     {
                         throw CaretException("MetaData specified multiple times in one NamedMap");
                     }
-                    m_metaData.readCiftiXML2(xml);
+                    m_unparsedMetaData.capture(xml);
                     if (xml.hasError()) return;
                     haveMetaData = true;
                 } else if (name == "LabelTable") {
@@ -235,7 +276,7 @@ void CiftiLabelsMap::LabelMap::readXML2(QXmlStreamReader& xml)
                     {
                         throw CaretException("LabelTable specified multiple times in one NamedMap");
                     }
-                    m_labelTable.readFromQXmlStreamReader(xml);
+                    m_unparsedLabelTable.capture(xml);
                     if (xml.hasError()) return;
                     haveTable = true;
                 } else if (name == "MapName") {
@@ -274,8 +315,8 @@ void CiftiLabelsMap::writeXML1(QXmlStreamWriter& xml) const
     {
         xml.writeStartElement("NamedMap");
         xml.writeTextElement("MapName", m_maps[i].m_name);
-        m_maps[i].m_metaData.writeCiftiXML1(xml);
-        m_maps[i].m_labelTable.writeAsXML(xml);
+        m_maps[i].getMetaData()->writeCiftiXML1(xml);
+        m_maps[i].getLabelTable()->writeAsXML(xml);
         xml.writeEndElement();
     }
 }
@@ -288,8 +329,8 @@ void CiftiLabelsMap::writeXML2(QXmlStreamWriter& xml) const
     {
         xml.writeStartElement("NamedMap");
         xml.writeTextElement("MapName", m_maps[i].m_name);
-        m_maps[i].m_metaData.writeCiftiXML2(xml);
-        m_maps[i].m_labelTable.writeAsXML(xml);
+        m_maps[i].getMetaData()->writeCiftiXML2(xml);
+        m_maps[i].getLabelTable()->writeAsXML(xml);
         xml.writeEndElement();
     }
 }
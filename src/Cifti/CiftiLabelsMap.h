@@ -23,6 +23,8 @@
 
 #include "CiftiMappingType.h"
 
+#include "CiftiDeferredElement.h"
+
 #include "CaretPointer.h"
 #include "GiftiMetaData.h"
 #include "GiftiLabelTable.h"
@@ -35,6 +37,7 @@ namespace caret
     class CiftiLabelsMap : public CiftiMappingType
     {
     public:
+        //map metadata and label tables are decoded on first use, so getMapMetadata, getMapLabelTable, operator==, and writeXML* throw CaretException if the map's xml is malformed
         GiftiMetaData* getMapMetadata(const int64_t& index) const;//HACK: allow modification of label table and metadata within XML without setting the xml on a file again
         GiftiLabelTable* getMapLabelTable(const int64_t& index) const;
         const QString& getMapName(const int64_t& index) const;
@@ -60,6 +63,9 @@ namespace caret
             mutable QString m_name;//we need a better way to change metadata in an in-memory file
             mutable GiftiMetaData m_metaData;//ditto
             mutable GiftiLabelTable m_labelTable;//ditto
+            mutable CiftiDeferredElement m_unparsedMetaData, m_unparsedLabelTable;//decoded into the above on first access, big label tables are slow to build
+            GiftiMetaData* getMetaData() const;
+            GiftiLabelTable* getLabelTable() const;
             bool operator==(const LabelMap& rhs) const;
             void readXML1(QXmlStreamReader& xml);
             void readXML2(QXmlStreamReader& xml);
@@ -26,8 +26,24 @@
 //HACK: to compare metadata in a const function, we make a copy and remove the palette data - but metadata's copy intentionally breaks == because of the UUID, so we need to reset it
 #include "GiftiMetaDataXmlElements.h"
 
+#include <QXmlStreamReader>
+
 using namespace caret;
 
+namespace
+{
+    class MetaDataDecoder : public CiftiDeferredElement::Decoder
+    {
+        GiftiMetaData& m_metaData;
+    public:
+        MetaDataDecoder(GiftiMetaData& metaData) : m_metaData(metaData) { }
+        void decode(QXmlStreamReader& xml)
+        {
+            m_metaData.readCiftiXML2(xml);//cifti-1 and cifti-2 metadata are the same
+        }
+    };
+}
+
 void CiftiScalarsMap::clear()
 {
     m_maps.clear();
@@ -36,7 +52,14 @@ void CiftiScalarsMap::clear()
 GiftiMetaData* CiftiScalarsMap::getMapMetadata(const int64_t& index) const
 {
     CaretAssertVectorIndex(m_maps, index);
-    return &(m_maps[index].m_metaData);
+    return m_maps[index].getMetaData();
+}
+
+GiftiMetaData* CiftiScalarsMap::ScalarMap::getMetaData() const
+{
+    MetaDataDecoder myDecoder(m_metaData);
+    m_unparsedMetaData.decodeOnce(myDecoder, "map metadata");
+    return &m_metaData;
 }
 
 const QString& CiftiScalarsMap::getMapName(const int64_t& index) const
@@ -76,11 +99,12 @@ PaletteColorMapping* CiftiScalarsMap::ScalarMap::getPalette() const
         return m_palette;
     }
     m_palette.grabNew(new PaletteColorMapping());
-    if (m_metaData.exists("PaletteColorMapping"))
+    const GiftiMetaData* metaData = getMetaData();
+    if (metaData->exists("PaletteColorMapping"))
     {
         try
         {
-            m_palette->decodeFromStringXML(m_metaData.get("PaletteColorMapping"));
+            m_palette->decodeFromStringXML(metaData->get("PaletteColorMapping"));
         } catch (XmlException& e) {
             CaretLogWarning("failed to parse palette settings from metadata: " + e.whatString());
         }
@@ -124,16 +148,17 @@ bool CiftiScalarsMap::ScalarMap::operator==(const CiftiScalarsMap::ScalarMap& rh
 {
     if (m_name != rhs.m_name) return false;
     if (*(getPalette()) != *(rhs.getPalette())) return false;
-    GiftiMetaData mytemp = m_metaData, rhstemp = rhs.m_metaData;
+    const GiftiMetaData& myMetaData = *getMetaData(), &rhsMetaData = *(rhs.getMetaData());
+    GiftiMetaData mytemp = myMetaData, rhstemp = rhsMetaData;
     mytemp.remove("PaletteColorMapping");//we already compared the true palettes, so don't compare the metadata that may or may not encode them
-    if (m_metaData.exists(GiftiMetaDataXmlElements::METADATA_NAME_UNIQUE_ID))//HACK: fix the copy-breaks-UUID silliness
+    if (myMetaData.exists(GiftiMetaDataXmlElements::METADATA_NAME_UNIQUE_ID))//HACK: fix the copy-breaks-UUID silliness
     {
-        mytemp.set(GiftiMetaDataXmlElements::METADATA_NAME_UNIQUE_ID, m_metaData.get(GiftiMetaDataXmlElements::METADATA_NAME_UNIQUE_ID));
+        mytemp.set(GiftiMetaDataXmlElements::METADATA_NAME_UNIQUE_ID, myMetaData.get(GiftiMetaDataXmlElements::METADATA_NAME_UNIQUE_ID));
     }
     rhstemp.remove("PaletteColorMapping");
-    if (rhs.m_metaData.exists(GiftiMetaDataXmlElements::METADATA_NAME_UNIQUE_ID))
+    if (rhsMetaData.exists(GiftiMetaDataXmlElements::METADATA_NAME_UNIQUE_ID))
     {
-        rhstemp.set(GiftiMetaDataXmlElements::METADATA_NAME_UNIQUE_ID, rhs.m_metaData.get(GiftiMetaDataXmlElements::METADATA_NAME_UNIQUE_ID));
+        rhstemp.set(GiftiMetaDataXmlElements::METADATA_NAME_UNIQUE_ID, rhsMetaData.get(GiftiMetaDataXmlElements::METADATA_NAME_UNIQUE_ID));
     }
     return (mytemp == rhstemp);
 }
@@ -205,7 +230,7 @@ void CiftiScalarsMap::ScalarMap::readXML1(QXmlStreamReader& xml)
                     {
                         throw CaretException("MetaData specified multiple times in one NamedMap");
                     }
-                    m_metaData.readCiftiXML1(xml);
+                    m_unparsedMetaData.capture(xml);
                     if (xml.hasError()) return;
                     haveMetaData = true;
                 } else if (name == "MapName") {
@@ -248,7 +273,7 @@ void CiftiScalarsMap::ScalarMap::readXML2(QXmlStreamReader& xml)
                     {
                         throw CaretException("MetaData specified multiple times in one NamedMap");
                     }
-                    m_metaData.readCiftiXML2(xml);
+                    m_unparsedMetaData.capture(xml);
                     if (xml.hasError()) return;
                     haveMetaData = true;
                 } else if (name == "MapName") {
@@ -286,9 +311,9 @@ void CiftiScalarsMap::writeXML1(QXmlStreamWriter& xml) const
         xml.writeTextElement("MapName", m_maps[i].m_name);
         if (m_maps[i].m_palette != NULL)
         {
-            m_maps[i].m_metaData.set("PaletteColorMapping", m_maps[i].m_palette->encodeInXML());
+            m_maps[i].getMetaData()->set("PaletteColorMapping", m_maps[i].m_palette->encodeInXML());
         }
-        m_maps[i].m_metaData.writeCiftiXML1(xml);
+        m_maps[i].getMetaData()->writeCiftiXML1(xml);
         xml.writeEndElement();
     }
 }
@@ -303,9 +328,9 @@ void CiftiScalarsMap::writeXML2(QXmlStreamWriter& xml) const
         xml.writeTextElement("MapName", m_maps[i].m_name);
         if (m_maps[i].m_palette != NULL)
         {
-            m_maps[i].m_metaData.set("PaletteColorMapping", m_maps[i].m_palette->encodeInXML());
+            m_maps[i].getMetaData()->set("PaletteColorMapping", m_maps[i].m_palette->encodeInXML());
         }
-        m_maps[i].m_metaData.writeCiftiXML1(xml);
+        m_maps[i].getMetaData()->writeCiftiXML1(xml);
         xml.writeEndElement();
     }
 }
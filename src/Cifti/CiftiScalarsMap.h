@@ -23,6 +23,8 @@
 
 #include "CiftiMappingType.h"
 
+#include "CiftiDeferredElement.h"
+
 #include "CaretPointer.h"
 #include "GiftiMetaData.h"
 #include "PaletteColorMapping.h"
@@ -35,6 +37,7 @@ namespace caret
     class CiftiScalarsMap : public CiftiMappingType
     {
     public:
+        //map metadata is decoded on first use, so getMapMetadata, getMapPalette, operator==, and writeXML* throw CaretException if the map's xml is malformed
         GiftiMetaData* getMapMetadata(const int64_t& index) const;//HACK: allow modification of palette and metadata within XML without setting the xml on a file again
         PaletteColorMapping* getMapPalette(const int64_t& index) const;
         const QString& getMapName(const int64_t& index) const;
@@ -60,6 +63,8 @@ namespace caret
             mutable QString m_name;//we need a better way to change metadata in an in-memory file
             mutable GiftiMetaData m_metaData;//ditto
             mutable CaretPointer<PaletteColorMapping> m_palette;//ditto - note, this actually gets written into the metadata
+            mutable CiftiDeferredElement m_unparsedMetaData;//decoded into m_metaData on first access, and the palette is only decoded from that when asked for
+            GiftiMetaData* getMetaData() const;
             PaletteColorMapping* getPalette() const;
             bool operator==(const ScalarMap& rhs) const;
             void readXML1(QXmlStreamReader& xml);
@@ -250,8 +250,10 @@ void CiftiXML::readXML(const QString& text)
 
 void CiftiXML::readXML(const QByteArray& data)
 {
-    QString text(data);//constructing a qstring appears to be the simplest way to remove trailing nulls, which otherwise trip an "Extra content at end of document" error
-    readXML(text);//then put it through the string reader, just to simplify code paths
+    int end = data.indexOf('\0');//trailing nulls otherwise trip an "Extra content at end of document" error
+    if (end < 0) end = data.size();
+    QXmlStreamReader xml(QByteArray::fromRawData(data.constData(), end));//parse the utf-8 bytes directly, without first converting the whole header to a QString
+    readXML(xml);
 }
 
 int32_t CiftiXML::getIntentInfo(const CiftiVersion& writingVersion, char intentNameOut[16]) const
@@ -360,7 +360,7 @@ CommandClassCreateAlgorithm::createImplementationFile(const AString& outputFileN
     t += (" *     Parameters for algorithm\n");
     t += (" */\n");
     t += (algorithmClassName + "::" + algorithmClassName + "(ProgressObject* myProgObj /* INSERT PARAMTERS HERE - may get compilation error if no parameters added */)\n");
-    t += ("   : AbstractAlgorithm(myProgObj)\n");
+    t += ("   : AbstractAlgorithm(myProgObj, getCommandSwitch())\n");
     t += ("{\n");
     t += ("    /*\n");
     t += ("     * Uncomment these if you use another algorithm inside here\n");
@@ -342,9 +342,19 @@ CommandClassCreateEnum::createImplementationFile(const AString& outputFileName,
     t += ("#undef " + ifdefNameStaticDeclaration + "\n");
     t += ("\n");
     t += ("#include \"CaretAssert.h\"\n");
+    t += ("#include \"CaretMutex.h\"\n");
     t += ("\n");
     t += ("using namespace caret;\n");
     t += ("\n");
+    t += ("namespace\n");
+    t += ("{\n");
+    t += ("    CaretMutex& getInitializeMutex()\n");
+    t += ("    {//function-local, so it exists even if the enum is first used while initializing another static\n");
+    t += ("        static CaretMutex s_initializeMutex;\n");
+    t += ("        return s_initializeMutex;\n");
+    t += ("    }\n");
+    t += ("}\n");
+    t += ("\n");
     t += ("    \n");
     t += ("/**\n");
     t += (" * \\class caret::" + enumClassName + " \n");
@@ -406,10 +416,10 @@ CommandClassCreateEnum::createImplementationFile(const AString& outputFileName,
     t += ("void\n");
     t += ("" + enumClassName + "::initialize()\n");
     t += ("{\n");
+    t += ("    CaretMutexLocker locker(&getInitializeMutex());//always lock, an unlocked check of the flag could see it set before the data it guards\n");
     t += ("    if (initializedFlag) {\n");
     t += ("        return;\n");
     t += ("    }\n");
-    t += ("    initializedFlag = true;\n");
     t += ("\n");
     
     for (int32_t indx = 0; indx < numberOfEnumValues; indx++) {
@@ -425,6 +435,7 @@ CommandClassCreateEnum::createImplementationFile(const AString& outputFileName,
         t += ("                                    \"\"));\n");
         t += ("    \n");
     }
+    t += ("    initializedFlag = true;\n");
     t += ("}\n");
     t += ("\n");
     
@@ -439,7 +450,7 @@ CommandClassCreateEnum::createImplementationFile(const AString& outputFileName,
     t += ("const " + enumClassName + "*\n");
     t += ("" + enumClassName + "::findData(const Enum enumValue)\n");
     t += ("{\n");
-    t += ("    if (initializedFlag == false) initialize();\n");
+    t += ("    initialize();\n");
     t += ("\n");
     t += ("    size_t num = enumData.size();\n");
     t += ("    for (size_t i = 0; i < num; i++) {\n");
@@ -463,7 +474,7 @@ CommandClassCreateEnum::createImplementationFile(const AString& outputFileName,
     t += (" */\n");
     t += ("AString \n");
     t += ("" + enumClassName + "::toName(Enum enumValue) {\n");
-    t += ("    if (initializedFlag == false) initialize();\n");
+    t += ("    initialize();\n");
     t += ("    \n");
     t += ("    const " + enumClassName + "* enumInstance = findData(enumValue);\n");
     t += ("    return enumInstance->name;\n");
@@ -484,7 +495,7 @@ CommandClassCreateEnum::createImplementationFile(const AString& outputFileName,
     t += ("" + enumClassName + "::Enum \n");
     t += ("" + enumClassName + "::fromName(const AString& name, bool* isValidOut)\n");
     t += ("{\n");
-    t += ("    if (initializedFlag == false) initialize();\n");
+    t += ("    initialize();\n");
     t += ("    \n");
     t += ("    bool validFlag = false;\n");
     t += ("    Enum enumValue = " + enumClassName + "::enumData[0].enumValue;\n");
@@ -520,7 +531,7 @@ CommandClassCreateEnum::createImplementationFile(const AString& outputFileName,
     t += (" */\n");
     t += ("AString \n");
     t += ("" + enumClassName + "::toGuiName(Enum enumValue) {\n");
-    t += ("    if (initializedFlag == false) initialize();\n");
+    t += ("    initialize();\n");
     t += ("    \n");
     t += ("    const " + enumClassName + "* enumInstance = findData(enumValue);\n");
     t += ("    return enumInstance->guiName;\n");
@@ -541,7 +552,7 @@ CommandClassCreateEnum::createImplementationFile(const AString& outputFileName,
     t += ("" + enumClassName + "::Enum \n");
     t += ("" + enumClassName + "::fromGuiName(const AString& guiName, bool* isValidOut)\n");
     t += ("{\n");
-    t += ("    if (initializedFlag == false) initialize();\n");
+    t += ("    initialize();\n");
     t += ("    \n");
     t += ("    bool validFlag = false;\n");
     t += ("    Enum enumValue = " + enumClassName + "::enumData[0].enumValue;\n");
@@ -577,7 +588,7 @@ CommandClassCreateEnum::createImplementationFile(const AString& outputFileName,
     t += ("int32_t\n");
     t += ("" + enumClassName + "::toIntegerCode(Enum enumValue)\n");
     t += ("{\n");
-    t += ("    if (initializedFlag == false) initialize();\n");
+    t += ("    initialize();\n");
     t += ("    const " + enumClassName + "* enumInstance = findData(enumValue);\n");
     t += ("    return enumInstance->integerCode;\n");
     t += ("}\n");
@@ -598,7 +609,7 @@ CommandClassCreateEnum::createImplementationFile(const AString& outputFileName,
     t += ("" + enumClassName + "::Enum\n");
     t += ("" + enumClassName + "::fromIntegerCode(const int32_t integerCode, bool* isValidOut)\n");
     t += ("{\n");
-    t += ("    if (initializedFlag == false) initialize();\n");
+    t += ("    initialize();\n");
     t += ("    \n");
     t += ("    bool validFlag = false;\n");
     t += ("    Enum enumValue = " + enumClassName + "::enumData[0].enumValue;\n");
@@ -635,7 +646,7 @@ CommandClassCreateEnum::createImplementationFile(const AString& outputFileName,
     t += ("void\n");
     t += ("" + enumClassName + "::getAllEnums(std::vector<" + enumClassName + "::Enum>& allEnums)\n");
     t += ("{\n");
-    t += ("    if (initializedFlag == false) initialize();\n");
+    t += ("    initialize();\n");
     t += ("    \n");
     t += ("    allEnums.clear();\n");
     t += ("    \n");
@@ -659,7 +670,7 @@ CommandClassCreateEnum::createImplementationFile(const AString& outputFileName,
     t += ("void\n");
     t += ("" + enumClassName + "::getAllNames(std::vector<AString>& allNames, const bool isSorted)\n");
     t += ("{\n");
-    t += ("    if (initializedFlag == false) initialize();\n");
+    t += ("    initialize();\n");
     t += ("    \n");
     t += ("    allNames.clear();\n");
     t += ("    \n");
@@ -686,7 +697,7 @@ CommandClassCreateEnum::createImplementationFile(const AString& outputFileName,
     t += ("void\n");
     t += ("" + enumClassName + "::getAllGuiNames(std::vector<AString>& allGuiNames, const bool isSorted)\n");
     t += ("{\n");
-    t += ("    if (initializedFlag == false) initialize();\n");
+    t += ("    initialize();\n");
     t += ("    \n");
     t += ("    allGuiNames.clear();\n");
     t += ("    \n");
@@ -53,6 +53,7 @@
 #include "AlgorithmCiftiROIsFromExtrema.h"
 #include "AlgorithmCiftiSeparate.h"
 #include "AlgorithmCiftiSmoothing.h"
+#include "AlgorithmCiftiTFCEPermutation.h"
 #include "AlgorithmCiftiTranspose.h"
 #include "AlgorithmCreateSignedDistanceVolume.h"
 #include "AlgorithmFiberDotProducts.h"
@@ -78,6 +79,7 @@
 #include "AlgorithmMetricROIsToBorder.h"
 #include "AlgorithmMetricSmoothing.h"
 #include "AlgorithmMetricTFCE.h"
+#include "AlgorithmMetricTFCEPermutation.h"
 #include "AlgorithmMetricVectorTowardROI.h"
 #include "AlgorithmNodesInsideBorder.h" //-border-to-rois
 #include "AlgorithmSignedDistanceToSurface.h"
@@ -116,6 +118,7 @@
 #include "AlgorithmVolumeROIsFromExtrema.h"
 #include "AlgorithmVolumeSmoothing.h"
 #include "AlgorithmVolumeTFCE.h"
+#include "AlgorithmVolumeTFCEPermutation.h"
 #include "AlgorithmVolumeToSurfaceMapping.h"
 #include "AlgorithmVolumeWarpfieldResample.h"
 
@@ -200,6 +203,8 @@
 
 #include "AlgorithmException.h"
 #include "ApplicationInformation.h"
+#include "CaretProfiler.h"
+#include "CiftiRowStreamHelper.h"
 #include "CommandParser.h"
 #include "OperationException.h"
 
@@ -210,11 +215,13 @@
 #include "CommandClassCreateOperation.h"
 #include "CommandC11xTesting.h"
 #include "CommandGiftiConvert.h"
+#include "CommandPipeline.h"
 #include "CommandUnitTest.h"
 #include "ProgramParameters.h"
 
 #include "CaretLogger.h"
 
+#include <algorithm>
 #include <iostream>
 
 using namespace caret;
@@ -282,6 +289,7 @@ CommandOperationManager::CommandOperationManager()
     this->commandOperations.push_back(new CommandParser(new AutoAlgorithmCiftiROIsFromExtrema()));
     this->commandOperations.push_back(new CommandParser(new AutoAlgorithmCiftiSeparate()));
     this->commandOperations.push_back(new CommandParser(new AutoAlgorithmCiftiSmoothing()));
+    this->commandOperations.push_back(new CommandParser(new AutoAlgorithmCiftiTFCEPermutation()));
     this->commandOperations.push_back(new CommandParser(new AutoAlgorithmCiftiTranspose()));
     this->commandOperations.push_back(new CommandParser(new AutoAlgorithmCreateSignedDistanceVolume()));
     this->commandOperations.push_back(new CommandParser(new AutoAlgorithmFiberDotProducts()));
@@ -307,6 +315,7 @@ CommandOperationManager::CommandOperationManager()
     this->commandOperations.push_back(new CommandParser(new AutoAlgorithmMetricROIsToBorder()));
     this->commandOperations.push_back(new CommandParser(new AutoAlgorithmMetricSmoothing()));
     this->commandOperations.push_back(new CommandParser(new AutoAlgorithmMetricTFCE()));
+    this->commandOperations.push_back(new CommandParser(new AutoAlgorithmMetricTFCEPermutation()));
     this->commandOperations.push_back(new CommandParser(new AutoAlgorithmMetricVectorTowardROI()));
     this->commandOperations.push_back(new CommandParser(new AutoAlgorithmNodesInsideBorder()));//-border-to-rois
     this->commandOperations.push_back(new CommandParser(new AutoAlgorithmSignedDistanceToSurface()));
@@ -345,6 +354,7 @@ CommandOperationManager::CommandOperationManager()
     this->commandOperations.push_back(new CommandParser(new AutoAlgorithmVolumeROIsFromExtrema()));
     this->commandOperations.push_back(new CommandParser(new AutoAlgorithmVolumeSmoothing()));
     this->commandOperations.push_back(new CommandParser(new AutoAlgorithmVolumeTFCE()));
+    this->commandOperations.push_back(new CommandParser(new AutoAlgorithmVolumeTFCEPermutation()));
     this->commandOperations.push_back(new CommandParser(new AutoAlgorithmVolumeToSurfaceMapping()));
     this->commandOperations.push_back(new CommandParser(new AutoAlgorithmVolumeWarpfieldResample()));
     
@@ -435,6 +445,7 @@ CommandOperationManager::CommandOperationManager()
     this->commandOperations.push_back(new CommandC11xTesting());
 #endif // WORKBENCH_HAVE_C11X
     this->commandOperations.push_back(new CommandGiftiConvert());
+    this->commandOperations.push_back(new CommandPipeline());
     this->commandOperations.push_back(new CommandUnitTest());
     
     this->deprecatedOperations.push_back(new CommandParser(new AutoOperationCiftiSeparateAll()));
@@ -472,8 +483,28 @@ CommandOperationManager::~CommandOperationManager()
 void 
 CommandOperationManager::runCommand(ProgramParameters& parameters)
 {
-    vector<AString> globalOptionArgs;//not used yet
+    vector<AString> globalOptionArgs;
     bool preventProvenance = getGlobalOption(parameters, "-disable-provenance", 0, globalOptionArgs);//check these BEFORE we test if we have a command switch
+    AString profileSummaryFile, profileTraceFile;
+    if (getGlobalOption(parameters, "-profile", 1, globalOptionArgs))
+    {
+        profileSummaryFile = globalOptionArgs[0];
+    }
+    if (getGlobalOption(parameters, "-profile-trace", 1, globalOptionArgs))
+    {
+        profileTraceFile = globalOptionArgs[0];
+    }
+    if (!profileSummaryFile.isEmpty() || !profileTraceFile.isEmpty())
+    {
+        CaretProfiler::enable();
+    }
+    if (getGlobalOption(parameters, "-stream-mem-limit", 1, globalOptionArgs))
+    {
+        bool ok = false;
+        double limitGB = globalOptionArgs[0].toDouble(&ok);
+        if (!ok || limitGB <= 0.0) throw CommandException("memory limit must be a positive number of gigabytes");
+        CiftiRowStreamHelper::setMemoryBudget(max((int64_t)1, (int64_t)(limitGB * (1<<30))));
+    }
 
     const uint64_t numberOfCommands = this->commandOperations.size();
     const uint64_t numberOfDeprecated = this->deprecatedOperations.size();
@@ -534,13 +565,42 @@ CommandOperationManager::runCommand(ProgramParameters& parameters)
             if (!parameters.hasNext() && operation->takesParameters())
             {
                 cout << operation->getHelpInformation(parameters.getProgramName()) << endl;
-            } else {
+            } else if (!CaretProfiler::isEnabled()) {
                 operation->execute(parameters, preventProvenance);
+            } else {
+                try
+                {
+                    {
+                        CaretProfiler::Scope commandScope(commandSwitch, "command");
+                        operation->execute(parameters, preventProvenance);
+                    }
+                } catch (...) {//a profile of a failed command can still be useful, but don't let a problem writing it hide the real error
+                    try
+                    {
+                        writeProfileOutput(profileSummaryFile, profileTraceFile);
+                    } catch (CaretException& e) {
+                        CaretLogWarning(e.whatString());
+                    }
+                    throw;
+                }
+                writeProfileOutput(profileSummaryFile, profileTraceFile);
             }
         }
     }
 }
 
+void CommandOperationManager::writeProfileOutput(const AString& summaryFile, const AString& traceFile)
+{
+    if (!summaryFile.isEmpty())
+    {
+        CaretProfiler::writeSummaryJSON(summaryFile);
+    }
+    if (!traceFile.isEmpty())
+    {
+        CaretProfiler::writeChromeTrace(traceFile);
+    }
+}
+
 bool CommandOperationManager::getGlobalOption(ProgramParameters& parameters, const AString& optionString, const int& numArgs, vector<AString>& arguments)
 {
     parameters.setParameterIndex(0);//this ends up being slightly redundant, but whatever
@@ -556,9 +616,9 @@ bool CommandOperationManager::getGlobalOption(ProgramParameters& parameters, con
                 if (!parameters.hasNext())
                 {
                     throw CommandException("missing argument #" + AString::number(i + 1) + " to global option '" + optionString + "'");
-                    arguments.push_back(parameters.nextString("global option argument"));
-                    parameters.remove();
                 }
+                arguments.push_back(parameters.nextString("global option argument"));
+                parameters.remove();
             }
             parameters.setParameterIndex(0);
             return true;
@@ -724,6 +784,12 @@ void CommandOperationManager::printHelpInfo()
     cout << "                                  info - VERY LONG" << endl;
     cout << endl << "Global options (can be added to any command):" << endl;
     cout << "   -disable-provenance         don't generate provenance info in output files" << endl;
+    cout << "   -profile <file>             write a json summary of time, cpu, memory, and" << endl;
+    cout << "                                  bytes read/written for each step" << endl;
+    cout << "   -profile-trace <file>       write the same steps as a chrome trace-event file" << endl;
+    cout << "   -stream-mem-limit <limit-GB>" << endl;
+    cout << "                               memory to use for blocks of rows in commands that" << endl;
+    cout << "                                  stream through cifti files (default 0.5)" << endl;
     cout << endl;
     cout << "If the first argument is not recognized, all processing commands that start" << endl;
     cout << "   with the argument are displayed" << endl;
@@ -69,6 +69,8 @@ namespace caret {
         
         bool getGlobalOption(ProgramParameters& parameters, const AString& optionString, const int& numArgs, std::vector<AString>& arguments);
         
+        void writeProfileOutput(const AString& summaryFile, const AString& traceFile);
+        
     private:
         std::vector<CommandOperation*> commandOperations, deprecatedOperations;
         
@@ -27,6 +27,8 @@
 #include "CaretCommandLine.h"
 #include "CaretDataFileHelper.h"
 #include "CaretLogger.h"
+#include "CaretOMP.h"
+#include "CaretProfiler.h"
 #include "CiftiFile.h"
 #include "DataFileException.h"
 #include "FileInformation.h"
@@ -41,6 +43,7 @@
 #include <QDir>
 
 #include <iostream>
+#include <map>
 
 using namespace caret;
 using namespace std;
@@ -50,6 +53,216 @@ const AString CommandParser::PARENT_PROVENANCE_NAME = "ParentProvenance";
 const AString CommandParser::PROGRAM_PROVENANCE_NAME = "ProgramProvenance";
 const AString CommandParser::CWD_PROVENANCE_NAME = "WorkingDirectory";
 
+namespace
+{
+    //files kept between the steps of a pipeline, keyed by handle name, or by canonical path for surfaces read from disk
+    struct PipelineFile
+    {
+        OperationParametersEnum::Enum m_type;
+        CaretPointer<BorderFile> m_border;
+        CaretPointer<CiftiFile> m_cifti;
+        CaretPointer<FociFile> m_foci;
+        CaretPointer<LabelFile> m_label;
+        CaretPointer<MetricFile> m_metric;
+        CaretPointer<SurfaceFile> m_surface;
+        CaretPointer<VolumeFile> m_volume;
+        void set(const CaretPointer<BorderFile>& file) { m_type = OperationParametersEnum::BORDER; m_border = file; }
+        void set(const CaretPointer<CiftiFile>& file) { m_type = OperationParametersEnum::CIFTI; m_cifti = file; }
+        void set(const CaretPointer<FociFile>& file) { m_type = OperationParametersEnum::FOCI; m_foci = file; }
+        void set(const CaretPointer<LabelFile>& file) { m_type = OperationParametersEnum::LABEL; m_label = file; }
+        void set(const CaretPointer<MetricFile>& file) { m_type = OperationParametersEnum::METRIC; m_metric = file; }
+        void set(const CaretPointer<SurfaceFile>& file) { m_type = OperationParametersEnum::SURFACE; m_surface = file; }
+        void set(const CaretPointer<VolumeFile>& file) { m_type = OperationParametersEnum::VOLUME; m_volume = file; }
+        bool get(CaretPointer<BorderFile>& file) const { file = m_border; return m_type == OperationParametersEnum::BORDER; }
+        bool get(CaretPointer<CiftiFile>& file) const { file = m_cifti; return m_type == OperationParametersEnum::CIFTI; }
+        bool get(CaretPointer<FociFile>& file) const { file = m_foci; return m_type == OperationParametersEnum::FOCI; }
+        bool get(CaretPointer<LabelFile>& file) const { file = m_label; return m_type == OperationParametersEnum::LABEL; }
+        bool get(CaretPointer<MetricFile>& file) const { file = m_metric; return m_type == OperationParametersEnum::METRIC; }
+        bool get(CaretPointer<SurfaceFile>& file) const { file = m_surface; return m_type == OperationParametersEnum::SURFACE; }
+        bool get(CaretPointer<VolumeFile>& file) const { file = m_volume; return m_type == OperationParametersEnum::VOLUME; }
+    };
+    
+    bool s_pipelineActive = false;
+    map<AString, PipelineFile> s_pipelineFiles;
+    
+    template <typename T>
+    bool findPipelineFile(const AString& name, CaretPointer<T>& fileOut)
+    {
+        if (!CommandParser::isPipelineHandle(name)) return false;
+        map<AString, PipelineFile>::const_iterator iter = s_pipelineFiles.find(name);
+        if (iter == s_pipelineFiles.end())
+        {
+            throw CommandException("pipeline handle '" + name + "' was not created by an earlier step");
+        }
+        if (!iter->second.get(fileOut))
+        {
+            throw CommandException("pipeline handle '" + name + "' holds a file of type " + OperationParametersEnum::toName(iter->second.m_type) + ", which can't be used here");
+        }
+        return true;
+    }
+    
+    template <typename T>
+    void storePipelineFile(const AString& handle, const CaretPointer<T>& file)
+    {
+        s_pipelineFiles[handle].set(file);
+    }
+    
+    bool findCachedSurface(const AString& fileName, CaretPointer<SurfaceFile>& fileOut)
+    {
+        if (!s_pipelineActive) return false;
+        map<AString, PipelineFile>::const_iterator iter = s_pipelineFiles.find(FileInformation(fileName).getCanonicalFilePath());
+        if (iter == s_pipelineFiles.end()) return false;
+        return iter->second.get(fileOut);
+    }
+    
+    void cacheSurface(const AString& fileName, const CaretPointer<SurfaceFile>& file)
+    {
+        if (!s_pipelineActive) return;
+        AString canonical = FileInformation(fileName).getCanonicalFilePath();
+        if (canonical != "") storePipelineFile(canonical, file);
+    }
+    
+    //input files that an earlier pipeline step already has in memory
+    bool findPipelineInput(AbstractParameter* myParam, const AString& fileName)
+    {
+        switch (myParam->getType())
+        {
+            case OperationParametersEnum::BORDER:
+                return findPipelineFile(fileName, ((BorderParameter*)myParam)->m_parameter);
+            case OperationParametersEnum::CIFTI:
+                return findPipelineFile(fileName, ((CiftiParameter*)myParam)->m_parameter);
+            case OperationParametersEnum::FOCI:
+                return findPipelineFile(fileName, ((FociParameter*)myParam)->m_parameter);
+            case OperationParametersEnum::LABEL:
+                return findPipelineFile(fileName, ((LabelParameter*)myParam)->m_parameter);
+            case OperationParametersEnum::METRIC:
+                return findPipelineFile(fileName, ((MetricParameter*)myParam)->m_parameter);
+            case OperationParametersEnum::SURFACE:
+                return findPipelineFile(fileName, ((SurfaceParameter*)myParam)->m_parameter) ||
+                       findCachedSurface(fileName, ((SurfaceParameter*)myParam)->m_parameter);
+            case OperationParametersEnum::VOLUME:
+                return findPipelineFile(fileName, ((VolumeParameter*)myParam)->m_parameter);
+            default:
+                return false;
+        }
+    }
+    
+    //volume and cifti go through CaretBinaryFile, which counts bytes for -profile itself, the xml-based formats are counted by file size
+    bool isCountedByFileSize(const OperationParametersEnum::Enum& type)
+    {
+        switch (type)
+        {
+            case OperationParametersEnum::BORDER:
+            case OperationParametersEnum::FOCI:
+            case OperationParametersEnum::LABEL:
+            case OperationParametersEnum::METRIC:
+            case OperationParametersEnum::SURFACE:
+                return true;
+            default:
+                return false;
+        }
+    }
+    
+    //file constructors and destructors can register with EventManager, which isn't thread safe, so objects are only made on the main thread
+    void createInputFile(AbstractParameter* myParam)
+    {
+        switch (myParam->getType())
+        {
+            case OperationParametersEnum::BORDER:
+                ((BorderParameter*)myParam)->m_parameter.grabNew(new BorderFile());
+                break;
+            case OperationParametersEnum::CIFTI:
+                ((CiftiParameter*)myParam)->m_parameter.grabNew(new CiftiFile());
+                break;
+            case OperationParametersEnum::FOCI:
+                ((FociParameter*)myParam)->m_parameter.grabNew(new FociFile());
+                break;
+            case OperationParametersEnum::LABEL:
+                ((LabelParameter*)myParam)->m_parameter.grabNew(new LabelFile());
+                break;
+            case OperationParametersEnum::METRIC:
+                ((MetricParameter*)myParam)->m_parameter.grabNew(new MetricFile());
+                break;
+            case OperationParametersEnum::SURFACE:
+                ((SurfaceParameter*)myParam)->m_parameter.grabNew(new SurfaceFile());
+                break;
+            case OperationParametersEnum::VOLUME:
+                ((VolumeParameter*)myParam)->m_parameter.grabNew(new VolumeFile());
+                break;
+            default:
+                CaretAssert(false);
+                break;
+        }
+    }
+    
+    //called from multiple threads at once, so it must only touch the file object createInputFile() made for its own parameter
+    void readInputFile(AbstractParameter* myParam, const AString& fileName)
+    {
+        CaretProfiler::Scope readScope("read " + fileName, "read");
+        switch (myParam->getType())
+        {
+            case OperationParametersEnum::BORDER:
+                ((BorderParameter*)myParam)->m_parameter->readFile(fileName);
+                break;
+            case OperationParametersEnum::CIFTI:
+                ((CiftiParameter*)myParam)->m_parameter->openFile(fileName);
+                break;
+            case OperationParametersEnum::FOCI:
+                ((FociParameter*)myParam)->m_parameter->readFile(fileName);
+                break;
+            case OperationParametersEnum::LABEL:
+                ((LabelParameter*)myParam)->m_parameter->readFile(fileName);
+                break;
+            case OperationParametersEnum::METRIC:
+                ((MetricParameter*)myParam)->m_parameter->readFile(fileName);
+                break;
+            case OperationParametersEnum::SURFACE:
+                ((SurfaceParameter*)myParam)->m_parameter->readFile(fileName);
+                break;
+            case OperationParametersEnum::VOLUME:
+                ((VolumeParameter*)myParam)->m_parameter->readFile(fileName);
+                break;
+            default:
+                CaretAssert(false);
+                break;
+        }
+        if (CaretProfiler::isEnabled() && isCountedByFileSize(myParam->getType()))
+        {
+            CaretProfiler::addBytesRead(FileInformation(fileName).size());
+        }
+    }
+    
+    const GiftiMetaData* getInputMetaData(AbstractParameter* myParam)
+    {
+        switch (myParam->getType())
+        {
+            case OperationParametersEnum::BORDER:
+                return ((BorderParameter*)myParam)->m_parameter->getFileMetaData();
+            case OperationParametersEnum::CIFTI:
+                return ((CiftiParameter*)myParam)->m_parameter->getCiftiXML().getFileMetaData();
+            case OperationParametersEnum::FOCI:
+                return ((FociParameter*)myParam)->m_parameter->getFileMetaData();
+            case OperationParametersEnum::LABEL:
+                return ((LabelParameter*)myParam)->m_parameter->getFileMetaData();
+            case OperationParametersEnum::METRIC:
+                return ((MetricParameter*)myParam)->m_parameter->getFileMetaData();
+            case OperationParametersEnum::SURFACE:
+                return ((SurfaceParameter*)myParam)->m_parameter->getFileMetaData();
+            case OperationParametersEnum::VOLUME:
+                return ((VolumeParameter*)myParam)->m_parameter->getFileMetaData();
+            default:
+                return NULL;
+        }
+    }
+    
+    void forgetCachedFile(const AString& fileName)
+    {//an earlier step may have cached the file we are about to overwrite
+        if (!s_pipelineActive) return;
+        AString canonical = FileInformation(fileName).getCanonicalFilePath();
+        if (canonical != "") s_pipelineFiles.erase(canonical);
+    }
+}
+
 CommandParser::CommandParser(AutoOperationInterface* myAutoOper) :
     CommandOperation(myAutoOper->getCommandSwitch(), myAutoOper->getShortDescription()),
     OperationParserInterface(myAutoOper)
@@ -72,13 +285,25 @@ void CommandParser::executeOperation(ProgramParameters& parameters)
     //the parent provenance should never be generated manually
     m_parentProvenance = "";//in case someone tries to use the same instance more than once
     m_workingDir = QDir::currentPath();//get the current path, in case some stupid command changes the working directory
+    m_inputCiftiNames.clear();//a pipeline runs the same instance once per step
     //these get set on output files during writeOutput (and for on-disk in provenanceBeforeOperation)
-    parseComponent(myAlgParams.getPointer(), parameters, myOutAssoc);//parsing block
-    parameters.verifyAllParametersProcessed();
+    m_inputAssoc.clear();
+    {
+        CaretProfiler::Scope parseScope("parse arguments", "parse");
+        parseComponent(myAlgParams.getPointer(), parameters, myOutAssoc);//parsing block
+        parameters.verifyAllParametersProcessed();
+    }
+    {
+        CaretProfiler::Scope inputScope("read inputs", "read");
+        loadInputs();
+    }
     makeOnDiskOutputs(myOutAssoc);//check for input on-disk files used as output on-disk files
     //code to show what arguments map to what parameters should go here
     if (m_doProvenance) provenanceBeforeOperation(myOutAssoc);
-    m_autoOper->useParameters(myAlgParams.getPointer(), NULL);//TODO: progress status for caret_command? would probably get messed up by any command info output
+    {
+        CaretProfiler::Scope computeScope("compute", "compute");//algorithms add their own scopes below this, on-disk cifti reads and writes are counted here
+        m_autoOper->useParameters(myAlgParams.getPointer(), NULL);//TODO: progress status for caret_command? would probably get messed up by any command info output
+    }
     vector<AString> uncheckedWarnings = myAlgParams->findUncheckedParams("the command");
     for (size_t i = 0; i < uncheckedWarnings.size(); ++i)
     {
@@ -86,6 +311,7 @@ void CommandParser::executeOperation(ProgramParameters& parameters)
     }
     if (m_doProvenance) provenanceAfterOperation(myOutAssoc);
     //TODO: deallocate input files - give abstract parameter a virtual deallocate method? use CaretPointer and rely on reference counting?
+    CaretProfiler::Scope outputScope("write outputs", "write");
     writeOutput(myOutAssoc);
 }
 
@@ -94,8 +320,10 @@ void CommandParser::showParsedOperation(ProgramParameters& parameters)
     CaretPointer<OperationParameters> myAlgParams(m_autoOper->getParameters());//could be an autopointer, but this is safer
     vector<OutputAssoc> myOutAssoc;
     
+    m_inputAssoc.clear();
     parseComponent(myAlgParams.getPointer(), parameters, myOutAssoc, true);//parsing block
     parameters.verifyAllParametersProcessed();
+    loadInputs(true);
     //don't execute or write parsed output
 }
 
@@ -125,7 +353,6 @@ void CommandParser::parseComponent(ParameterComponent* myComponent, ProgramParam
                 continue;//so skip trying to parse it as a required argument
             }
         }
-        const OperationParametersEnum::Enum nextType = myComponent->m_paramList[i]->getType();// need in catch statement below
         try {
             switch (myComponent->m_paramList[i]->getType())
             {
@@ -141,56 +368,17 @@ void CommandParser::parseComponent(ParameterComponent* myComponent, ProgramParam
                     break;
                 }
                 case OperationParametersEnum::BORDER:
-                {
-                    CaretPointer<BorderFile> myFile(new BorderFile());
-                    myFile->readFile(nextArg);
-                    if (m_doProvenance)
-                    {
-                        const GiftiMetaData* md = myFile->getFileMetaData();
-                        if (md != NULL)
-                        {
-                            AString prov = md->get(PROVENANCE_NAME);
-                            if (prov != "")
-                            {
-                                m_parentProvenance += nextArg + ":\n" + prov + "\n\n";
-                            }
-                        }
-                    }
-                    ((BorderParameter*)myComponent->m_paramList[i])->m_parameter = myFile;
-                    if (debug)
-                    {
-                        cout << "Parameter <" << myComponent->m_paramList[i]->m_shortName << "> opened file with name ";
-                        cout << nextArg << endl;
-                    }
-                    break;
-                }
                 case OperationParametersEnum::CIFTI:
-                {
-                    FileInformation myInfo(nextArg);
-                    CaretPointer<CiftiFile> myFile(new CiftiFile());
-                    myFile->openFile(nextArg);
-                    m_inputCiftiNames.insert(myInfo.getCanonicalFilePath());//track only names of input cifti, because inputs are always on-disk
-                    if (m_doProvenance)//just an optimization, if we aren't going to write provenance, don't generate it, either
-                    {
-                        const GiftiMetaData* md = myFile->getCiftiXML().getFileMetaData();
-                        if (md != NULL)
-                        {
-                            if (md->exists(PROVENANCE_NAME))
-                            {
-                                AString provenance = md->get(PROVENANCE_NAME);
-                                if (provenance != "")
-                                {
-                                    m_parentProvenance += nextArg + ":\n" + provenance + "\n\n";
-                                }
-                            }
-                        }
-                    }
-                    ((CiftiParameter*)myComponent->m_paramList[i])->m_parameter = myFile;
-                    if (debug)
-                    {
-                        cout << "Parameter <" << myComponent->m_paramList[i]->m_shortName << "> opened file with name ";
-                        cout << nextArg << endl;
-                    }
+                case OperationParametersEnum::FOCI:
+                case OperationParametersEnum::LABEL:
+                case OperationParametersEnum::METRIC:
+                case OperationParametersEnum::SURFACE:
+                case OperationParametersEnum::VOLUME:
+                {//files are opened by loadInputs() after parsing, so that they can be read concurrently
+                    InputAssoc tempItem;
+                    tempItem.m_fileName = nextArg;
+                    tempItem.m_param = myComponent->m_paramList[i];
+                    m_inputAssoc.push_back(tempItem);
                     break;
                 }
                 case OperationParametersEnum::DOUBLE:
@@ -204,30 +392,6 @@ void CommandParser::parseComponent(ParameterComponent* myComponent, ProgramParam
                     }
                     break;
                 }
-                case OperationParametersEnum::FOCI:
-                {
-                    CaretPointer<FociFile> myFile(new FociFile());
-                    myFile->readFile(nextArg);
-                    if (m_doProvenance)
-                    {
-                        const GiftiMetaData* md = myFile->getFileMetaData();
-                        if (md != NULL)
-                        {
-                            AString prov = md->get(PROVENANCE_NAME);
-                            if (prov != "")
-                            {
-                                m_parentProvenance += nextArg + ":\n" + prov + "\n\n";
-                            }
-                        }
-                    }
-                    ((FociParameter*)myComponent->m_paramList[i])->m_parameter = myFile;
-                    if (debug)
-                    {
-                        cout << "Parameter <" << myComponent->m_paramList[i]->m_shortName << "> opened file with name ";
-                        cout << nextArg << endl;
-                    }
-                    break;
-                }
                 case OperationParametersEnum::INT:
                 {
                     parameters.backup();
@@ -239,54 +403,6 @@ void CommandParser::parseComponent(ParameterComponent* myComponent, ProgramParam
                     }
                     break;
                 }
-                case OperationParametersEnum::LABEL:
-                {
-                    CaretPointer<LabelFile> myFile(new LabelFile());
-                    myFile->readFile(nextArg);
-                    if (m_doProvenance)
-                    {
-                        const GiftiMetaData* md = myFile->getFileMetaData();
-                        if (md != NULL)
-                        {
-                            AString prov = md->get(PROVENANCE_NAME);
-                            if (prov != "")
-                            {
-                                m_parentProvenance += nextArg + ":\n" + prov + "\n\n";
-                            }
-                        }
-                    }
-                    ((LabelParameter*)myComponent->m_paramList[i])->m_parameter = myFile;
-                    if (debug)
-                    {
-                        cout << "Parameter <" << myComponent->m_paramList[i]->m_shortName << "> opened file with name ";
-                        cout << nextArg << endl;
-                    }
-                    break;
-                }
-                case OperationParametersEnum::METRIC:
-                {
-                    CaretPointer<MetricFile> myFile(new MetricFile());
-                    myFile->readFile(nextArg);
-                    if (m_doProvenance)
-                    {
-                        const GiftiMetaData* md = myFile->getFileMetaData();
-                        if (md != NULL)
-                        {
-                            AString prov = md->get(PROVENANCE_NAME);
-                            if (prov != "")
-                            {
-                                m_parentProvenance += nextArg + ":\n" + prov + "\n\n";
-                            }
-                        }
-                    }
-                    ((MetricParameter*)myComponent->m_paramList[i])->m_parameter = myFile;
-                    if (debug)
-                    {
-                        cout << "Parameter <" << myComponent->m_paramList[i]->m_shortName << "> opened file with name ";
-                        cout << nextArg << endl;
-                    }
-                    break;
-                }
                 case OperationParametersEnum::STRING:
                 {
                     ((StringParameter*)myComponent->m_paramList[i])->m_parameter = nextArg;
@@ -297,83 +413,11 @@ void CommandParser::parseComponent(ParameterComponent* myComponent, ProgramParam
                     }
                     break;
                 }
-                case OperationParametersEnum::SURFACE:
-                {
-                    CaretPointer<SurfaceFile> myFile(new SurfaceFile());
-                    myFile->readFile(nextArg);
-                    if (m_doProvenance)
-                    {
-                        const GiftiMetaData* md = myFile->getFileMetaData();
-                        if (md != NULL)
-                        {
-                            AString prov = md->get(PROVENANCE_NAME);
-                            if (prov != "")
-                            {
-                                m_parentProvenance += nextArg + ":\n" + prov + "\n\n";
-                            }
-                        }
-                    }
-                    ((SurfaceParameter*)myComponent->m_paramList[i])->m_parameter = myFile;
-                    if (debug)
-                    {
-                        cout << "Parameter <" << myComponent->m_paramList[i]->m_shortName << "> opened file with name ";
-                        cout << nextArg << endl;
-                    }
-                    break;
-                }
-                case OperationParametersEnum::VOLUME:
-                {
-                    CaretPointer<VolumeFile> myFile(new VolumeFile());
-                    myFile->readFile(nextArg);
-                    if (m_doProvenance)
-                    {
-                        const GiftiMetaData* md = myFile->getFileMetaData();
-                        if (md != NULL)
-                        {
-                            AString prov = md->get(PROVENANCE_NAME);
-                            if (prov != "")
-                            {
-                                m_parentProvenance += nextArg + ":\n" + prov + "\n\n";
-                            }
-                        }
-                    }
-                    ((VolumeParameter*)myComponent->m_paramList[i])->m_parameter = myFile;
-                    if (debug)
-                    {
-                        cout << "Parameter <" << myComponent->m_paramList[i]->m_shortName << "> opened file with name ";
-                        cout << nextArg << endl;
-                    }
-                    break;
-                }
             };
         }
         catch (const bad_alloc&) {
-            switch (nextType)
-            {
-                case OperationParametersEnum::BORDER:
-                case OperationParametersEnum::CIFTI:
-                case OperationParametersEnum::FOCI:
-                case OperationParametersEnum::LABEL:
-                case OperationParametersEnum::METRIC:
-                case OperationParametersEnum::SURFACE:
-                case OperationParametersEnum::VOLUME:
-                    /*
-                     * Provide information to the user about which
-                     * file caused the std::bad_alloc including
-                     * the size of the file.
-                     */
-                    throw DataFileException(nextArg,
-                                            CaretDataFileHelper::createBadAllocExceptionMessage(nextArg));
-
-                    break;
-                case OperationParametersEnum::DOUBLE:
-                case OperationParametersEnum::INT:
-                case OperationParametersEnum::STRING:
-                case OperationParametersEnum::BOOL:
-                    throw DataFileException("Unable to allocate memory for input: "
-                                            + nextArg);
-                    break;
-            }
+            throw DataFileException("Unable to allocate memory for input: "
+                                    + nextArg);
         }
     }
     for (i = 0; i < myComponent->m_outputList.size(); ++i)
@@ -513,6 +557,87 @@ void CommandParser::parseRemainingOptions(ParameterComponent* myComponent, Progr
     }
 }
 
+void CommandParser::loadInputs(bool debug)
+{
+    const int numInputs = (int)m_inputAssoc.size();
+    vector<char> needsRead(numInputs, 0);
+    int numToRead = 0;
+    for (int i = 0; i < numInputs; ++i)
+    {
+        if (!findPipelineInput(m_inputAssoc[i].m_param, m_inputAssoc[i].m_fileName))
+        {
+            needsRead[i] = 1;
+            ++numToRead;
+            createInputFile(m_inputAssoc[i].m_param);
+        }
+    }
+    vector<AString> errors(numInputs);
+    vector<char> failed(numInputs, 0), outOfMemory(numInputs, 0);
+#pragma omp CARET_PARFOR schedule(dynamic, 1) if (numToRead > 1)
+    for (int i = 0; i < numInputs; ++i)
+    {
+        if (!needsRead[i]) continue;
+        try
+        {
+            readInputFile(m_inputAssoc[i].m_param, m_inputAssoc[i].m_fileName);
+        } catch (const bad_alloc&) {//tell the user which file caused the std::bad_alloc, including the size of the file
+            errors[i] = CaretDataFileHelper::createBadAllocExceptionMessage(m_inputAssoc[i].m_fileName);
+            failed[i] = 1;
+            outOfMemory[i] = 1;
+        } catch (CaretException& e) {
+            errors[i] = e.whatString();
+            failed[i] = 1;
+        } catch (exception& e) {
+            errors[i] = e.what();
+            failed[i] = 1;
+        }
+    }
+    for (int i = 0; i < numInputs; ++i)
+    {//report the first failure in argument order, the same error a serial read would have stopped at
+        if (failed[i])
+        {
+            if (outOfMemory[i])
+            {
+                throw DataFileException(m_inputAssoc[i].m_fileName, errors[i]);
+            }
+            throw DataFileException("error reading input <" + m_inputAssoc[i].m_param->m_shortName + ">: " + errors[i]);
+        }
+    }
+    for (int i = 0; i < numInputs; ++i)
+    {//bookkeeping and provenance in argument order, so they don't depend on which read finished first
+        const AString& fileName = m_inputAssoc[i].m_fileName;
+        AbstractParameter* myParam = m_inputAssoc[i].m_param;
+        if (needsRead[i])
+        {
+            if (myParam->getType() == OperationParametersEnum::CIFTI)
+            {
+                m_inputCiftiNames.insert(FileInformation(fileName).getCanonicalFilePath());//track only names of on-disk input cifti
+            }
+            if (myParam->getType() == OperationParametersEnum::SURFACE)
+            {
+                cacheSurface(fileName, ((SurfaceParameter*)myParam)->m_parameter);//surfaces are typically shared by many steps of a pipeline, so only read them once
+            }
+        }
+        if (m_doProvenance)//just an optimization, if we aren't going to write provenance, don't generate it, either
+        {
+            const GiftiMetaData* md = getInputMetaData(myParam);
+            if (md != NULL)
+            {
+                AString prov = md->get(PROVENANCE_NAME);
+                if (prov != "")
+                {
+                    m_parentProvenance += fileName + ":\n" + prov + "\n\n";
+                }
+            }
+        }
+        if (debug)
+        {
+            cout << "Parameter <" << myParam->m_shortName << "> opened file with name ";
+            cout << fileName << endl;
+        }
+    }
+}
+
 void CommandParser::provenanceBeforeOperation(const vector<OutputAssoc>& outAssociation)
 {
     vector<AString> versionInfo;//need this for on-disk outputs, because we have to set it before the command executes
@@ -635,6 +760,11 @@ void CommandParser::makeOnDiskOutputs(const vector<OutputAssoc>& outAssociation)
             case OperationParametersEnum::CIFTI:
             {
                 CiftiParameter* myCiftiParam = (CiftiParameter*)myParam;
+                if (isPipelineHandle(outAssociation[i].m_fileName))
+                {
+                    myCiftiParam->m_parameter.grabNew(new CiftiFile());//stays in memory for later steps
+                    break;
+                }
                 FileInformation myInfo(outAssociation[i].m_fileName);
                 set<AString>::iterator iter = m_inputCiftiNames.find(myInfo.getCanonicalFilePath());
                 if (iter != m_inputCiftiNames.end())
@@ -661,6 +791,39 @@ void CommandParser::writeOutput(const vector<OutputAssoc>& outAssociation)
     for (uint32_t i = 0; i < outAssociation.size(); ++i)
     {
         AbstractParameter* myParam = outAssociation[i].m_param;
+        if (isPipelineHandle(outAssociation[i].m_fileName))
+        {//keep the file in memory for later pipeline steps instead of writing it
+            const AString& handle = outAssociation[i].m_fileName;
+            switch (myParam->getType())
+            {
+                case OperationParametersEnum::BORDER:
+                    storePipelineFile(handle, ((BorderParameter*)myParam)->m_parameter);
+                    continue;
+                case OperationParametersEnum::CIFTI:
+                    storePipelineFile(handle, ((CiftiParameter*)myParam)->m_parameter);
+                    continue;
+                case OperationParametersEnum::FOCI:
+                    storePipelineFile(handle, ((FociParameter*)myParam)->m_parameter);
+                    continue;
+                case OperationParametersEnum::LABEL:
+                    storePipelineFile(handle, ((LabelParameter*)myParam)->m_parameter);
+                    continue;
+                case OperationParametersEnum::METRIC:
+                    storePipelineFile(handle, ((MetricParameter*)myParam)->m_parameter);
+                    continue;
+                case OperationParametersEnum::SURFACE:
+                    storePipelineFile(handle, ((SurfaceParameter*)myParam)->m_parameter);
+                    continue;
+                case OperationParametersEnum::VOLUME:
+                    storePipelineFile(handle, ((VolumeParameter*)myParam)->m_parameter);
+                    continue;
+                default:
+                    break;//primitive outputs are printed as usual
+            }
+        } else {
+            forgetCachedFile(outAssociation[i].m_fileName);
+        }
+        CaretProfiler::Scope writeScope("write " + outAssociation[i].m_fileName, "write");
         switch (myParam->getType())
         {
             case OperationParametersEnum::BOOL://ignores the name you give the output for now, but what gives primitive type output and how is it used?
@@ -721,6 +884,10 @@ void CommandParser::writeOutput(const vector<OutputAssoc>& outAssociation)
                 CaretAssertMessage(false, "Writing of this parameter type has not been implemented in this parser");//assert instead of throw because this is a code error, not a user error
                 throw CommandException("Internal parsing error, please let the developers know what you just tried to do");//but don't let release pass by it either
         }
+        if (CaretProfiler::isEnabled() && isCountedByFileSize(myParam->getType()))
+        {
+            CaretProfiler::addBytesWritten(FileInformation(outAssociation[i].m_fileName).size());
+        }
     }
 }
 
@@ -894,3 +1061,70 @@ bool CommandParser::takesParameters()
 {
     return m_autoOper->takesParameters();
 }
+
+void CommandParser::beginPipeline()
+{
+    s_pipelineFiles.clear();
+    s_pipelineActive = true;
+}
+
+void CommandParser::endPipeline()
+{
+    s_pipelineFiles.clear();
+    s_pipelineActive = false;
+}
+
+bool CommandParser::isPipelineHandle(const AString& name)
+{
+    return s_pipelineActive && name.size() > 1 && name[0] == '@';
+}
+
+void CommandParser::writePipelineHandle(const AString& handle, const AString& fileName)
+{
+    if (!isPipelineHandle(handle))
+    {
+        throw CommandException("'" + handle + "' is not a pipeline handle");
+    }
+    map<AString, PipelineFile>::iterator iter = s_pipelineFiles.find(handle);
+    if (iter == s_pipelineFiles.end())
+    {
+        throw CommandException("pipeline handle '" + handle + "' was not created by an earlier step");
+    }
+    forgetCachedFile(fileName);
+    const PipelineFile& myFile = iter->second;
+    switch (myFile.m_type)
+    {
+        case OperationParametersEnum::BORDER:
+            myFile.m_border->writeFile(fileName);
+            break;
+        case OperationParametersEnum::CIFTI:
+            myFile.m_cifti->writeFile(fileName);
+            break;
+        case OperationParametersEnum::FOCI:
+            myFile.m_foci->writeFile(fileName);
+            break;
+        case OperationParametersEnum::LABEL:
+            myFile.m_label->writeFile(fileName);
+            break;
+        case OperationParametersEnum::METRIC:
+            myFile.m_metric->writeFile(fileName);
+            break;
+        case OperationParametersEnum::SURFACE:
+            myFile.m_surface->writeFile(fileName);
+            break;
+        case OperationParametersEnum::VOLUME:
+            myFile.m_volume->writeFile(fileName);
+            break;
+        default:
+            CaretAssertMessage(false, "pipeline handle stored with non-file type");
+            throw CommandException("Internal parsing error, please let the developers know what you just tried to do");
+    }
+}
+
+void CommandParser::releasePipelineHandle(const AString& handle)
+{
+    if (s_pipelineFiles.erase(handle) == 0)
+    {
+        throw CommandException("pipeline handle '" + handle + "' was not created by an earlier step");
+    }
+}
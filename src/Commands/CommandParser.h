@@ -44,9 +44,16 @@ namespace caret {
             AString m_fileName;
             AbstractParameter* m_param;
         };
+        struct InputAssoc
+        {//input files are read after parsing is finished, see loadInputs()
+            AString m_fileName;
+            AbstractParameter* m_param;
+        };
+        std::vector<InputAssoc> m_inputAssoc;
         void parseComponent(ParameterComponent* myComponent, ProgramParameters& parameters, std::vector<OutputAssoc>& outAssociation, bool debug = false);
         bool parseOption(const AString& mySwitch, ParameterComponent* myComponent, ProgramParameters& parameters, std::vector<OutputAssoc>& outAssociation, bool debug);
         void parseRemainingOptions(ParameterComponent* myAlgParams, ProgramParameters& parameters, std::vector<OutputAssoc>& outAssociation, bool debug);
+        void loadInputs(bool debug = false);//reads all input files found while parsing, concurrently
         void provenanceBeforeOperation(const std::vector<OutputAssoc>& outAssociation);
         void provenanceAfterOperation(const std::vector<OutputAssoc>& outAssociation);
         void makeOnDiskOutputs(const std::vector<OutputAssoc>& outAssociation);//ensures on-disk inputs aren't used as on-disk outputs, converting outputs to in-memory when needed
@@ -65,6 +72,13 @@ namespace caret {
         void showParsedOperation(ProgramParameters& parameters);
         AString getHelpInformation(const AString& programName);
         bool takesParameters();
+        
+        ///while a pipeline is active, arguments starting with '@' name in-memory files instead of files on disk, and surfaces read from disk are kept for later steps
+        static void beginPipeline();
+        static void endPipeline();
+        static bool isPipelineHandle(const AString& name);
+        static void writePipelineHandle(const AString& handle, const AString& fileName);
+        static void releasePipelineHandle(const AString& handle);
     };
 
 };
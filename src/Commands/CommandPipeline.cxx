@@ -0,0 +1,246 @@
+
+/*LICENSE_START*/
+/*
+ *  Copyright (C) 2014  Washington University School of Medicine
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+/*LICENSE_END*/
+
+#include "CommandPipeline.h"
+
+#include "CaretCommandLine.h"
+#include "CommandOperationManager.h"
+#include "CommandParser.h"
+#include "ProgramParameters.h"
+
+#include <QFile>
+#include <QTextStream>
+
+#include <vector>
+
+using namespace caret;
+using namespace std;
+
+namespace
+{
+    //splits a script statement into arguments, honoring quotes and backslash escapes like a simple shell, and stopping at a # comment
+    vector<AString> splitStatement(const AString& statement)
+    {
+        vector<AString> ret;
+        AString current;
+        bool inArgument = false;
+        QChar quote = 0;
+        for (int i = 0; i < statement.size(); ++i)
+        {
+            QChar c = statement[i];
+            if (quote != 0)
+            {
+                if (c == quote)
+                {
+                    quote = 0;
+                } else if (c == '\\' && quote == '"' && i + 1 < statement.size()) {
+                    current += statement[++i];
+                } else {
+                    current += c;
+                }
+                continue;
+            }
+            if (c.isSpace())
+            {
+                if (inArgument)
+                {
+                    ret.push_back(current);
+                    current = "";
+                    inArgument = false;
+                }
+                continue;
+            }
+            if (c == '#' && !inArgument) break;
+            inArgument = true;
+            if (c == '"' || c == '\'')
+            {
+                quote = c;
+            } else if (c == '\\' && i + 1 < statement.size()) {
+                current += statement[++i];
+            } else {
+                current += c;
+            }
+        }
+        if (quote != 0)
+        {
+            throw CommandException("unterminated quote");
+        }
+        if (inArgument) ret.push_back(current);
+        return ret;
+    }
+    
+    //makes sure the in-memory files are released and the command line is restored, even if a step throws
+    class PipelineScope
+    {
+        AString m_savedCommandLine;
+    public:
+        PipelineScope()
+        {
+            m_savedCommandLine = caret_global_commandLine;
+            CommandParser::beginPipeline();
+        }
+        ~PipelineScope()
+        {
+            CommandParser::endPipeline();
+            caret_global_commandLine = m_savedCommandLine;
+        }
+    };
+}
+
+/**
+ * Constructor.
+ */
+CommandPipeline::CommandPipeline()
+: CommandOperation("-pipeline",
+                   "RUN A SCRIPT OF COMMANDS IN ONE PROCESS")
+{
+    m_preventProvenance = false;
+}
+
+/**
+ * Destructor.
+ */
+CommandPipeline::~CommandPipeline()
+{
+    
+}
+
+void CommandPipeline::disableProvenance()
+{
+    m_preventProvenance = true;
+}
+
+/**
+ * @return The help information.
+ */
+AString
+CommandPipeline::getHelpInformation(const AString& programName)
+{
+    AString helpInfo = ("Run a script of commands in one process\n"
+                        "\n"
+                        "Usage:  <script-file>\n"
+                        "    \n"
+                        "    script-file\n"
+                        "        Text file with one command per line, written as it would be\n"
+                        "        on the command line, but without '" + programName + "' in front.\n"
+                        "        Quotes and backslashes work as in the shell, a line ending in a\n"
+                        "        backslash continues on the next line, and '#' starts a comment.\n"
+                        "    \n"
+                        "    Any input or output file name that starts with '@', like '@smoothed',\n"
+                        "    names a file kept in memory instead of a file on disk, so that later\n"
+                        "    commands in the script can use it without writing and reading it\n"
+                        "    again.  Surface files read from disk are also kept in memory and\n"
+                        "    reused by later commands.  In-memory files are discarded when the\n"
+                        "    script finishes, unless written with one of these script lines:\n"
+                        "    \n"
+                        "    -write <handle> <file-name>\n"
+                        "        Write the in-memory file to disk.\n"
+                        "    \n"
+                        "    -release <handle>\n"
+                        "        Discard the in-memory file, to reduce memory usage.\n"
+                        "    \n"
+                        "    Any error stops the script, reporting the line where it happened.\n"
+                        "\n");
+    return helpInfo;
+}
+
+/**
+ * Execute the operation.
+ * 
+ * @param parameters
+ *   Parameters for the operation.
+ * @throws CommandException
+ *   If the command failed.
+ * @throws ProgramParametersException
+ *   If there is an error in the parameters.
+ */
+void 
+CommandPipeline::executeOperation(ProgramParameters& parameters)
+{
+    const AString scriptName = parameters.nextString("Script File Name");
+    parameters.verifyAllParametersProcessed();
+    QFile scriptFile(scriptName);
+    if (!scriptFile.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        throw CommandException("unable to open script file '" + scriptName + "'");
+    }
+    QTextStream scriptStream(&scriptFile);
+    vector<CommandOperation*> operations = CommandOperationManager::getCommandOperationManager()->getCommandOperations();
+    PipelineScope myScope;
+    int lineNumber = 0;
+    while (!scriptStream.atEnd())
+    {
+        ++lineNumber;
+        const int statementLine = lineNumber;
+        AString statement = scriptStream.readLine();
+        while (statement.endsWith("\\") && !scriptStream.atEnd())
+        {
+            ++lineNumber;
+            statement.chop(1);
+            statement += " " + scriptStream.readLine();
+        }
+        try
+        {
+            vector<AString> arguments = splitStatement(statement);
+            if (arguments.empty()) continue;
+            if (arguments[0] == "-write")
+            {
+                if (arguments.size() != 3) throw CommandException("-write takes a handle and a file name");
+                CommandParser::writePipelineHandle(arguments[1], arguments[2]);
+                continue;
+            }
+            if (arguments[0] == "-release")
+            {
+                if (arguments.size() != 2) throw CommandException("-release takes a handle");
+                CommandParser::releasePipelineHandle(arguments[1]);
+                continue;
+            }
+            if (arguments[0] == getCommandLineSwitch())
+            {
+                throw CommandException("pipelines can't be nested");
+            }
+            CommandOperation* operation = NULL;
+            for (int i = 0; i < (int)operations.size(); ++i)
+            {
+                if (operations[i]->getCommandLineSwitch() == arguments[0])
+                {
+                    operation = operations[i];
+                    break;
+                }
+            }
+            if (operation == NULL)
+            {
+                throw CommandException("Command \"" + arguments[0] + "\" not found.");
+            }
+            ProgramParameters stepParameters;
+            for (int i = 1; i < (int)arguments.size(); ++i)
+            {
+                stepParameters.addParameter(arguments[i]);
+            }
+            caret_global_commandLine = parameters.getProgramName() + " " + statement.trimmed();//provenance of each output should be the step that made it
+            operation->execute(stepParameters, m_preventProvenance);
+        }
+        catch (CaretException& e)
+        {
+            throw CommandException(scriptName + ", line " + AString::number(statementLine) + ": " + e.whatString());
+        }
+    }
+}
@@ -25,9 +25,19 @@
 #undef __APPLICATION_TYPE_ENUM_DECLARE__
 
 #include "CaretAssert.h"
+#include "CaretMutex.h"
 
 using namespace caret;
 
+namespace
+{
+    CaretMutex& getInitializeMutex()
+    {//function-local, so it exists even if the enum is first used while initializing another static
+        static CaretMutex s_initializeMutex;
+        return s_initializeMutex;
+    }
+}
+
     
 /**
  * \class caret::ApplicationTypeEnum 
@@ -103,10 +113,10 @@ ApplicationTypeEnum::~ApplicationTypeEnum()
 void
 ApplicationTypeEnum::initialize()
 {
+    CaretMutexLocker locker(&getInitializeMutex());//always lock, an unlocked check of the flag could see it set before the data it guards
     if (initializedFlag) {
         return;
     }
-    initializedFlag = true;
 
     enumData.push_back(ApplicationTypeEnum(APPLICATION_TYPE_INVALID, 
                                     "APPLICATION_TYPE_INVALID", 
@@ -120,6 +130,7 @@ ApplicationTypeEnum::initialize()
                                     "APPLICATION_TYPE_GRAPHICAL_USER_INTERFACE", 
                                     "Graphical User Interface Application"));
     
+    initializedFlag = true;
 }
 
 /**
@@ -132,7 +143,7 @@ ApplicationTypeEnum::initialize()
 const ApplicationTypeEnum*
 ApplicationTypeEnum::findData(const Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
 
     size_t num = enumData.size();
     for (size_t i = 0; i < num; i++) {
@@ -154,7 +165,7 @@ ApplicationTypeEnum::findData(const Enum enumValue)
  */
 AString 
 ApplicationTypeEnum::toName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const ApplicationTypeEnum* enumInstance = findData(enumValue);
     return enumInstance->name;
@@ -173,7 +184,7 @@ ApplicationTypeEnum::toName(Enum enumValue) {
 ApplicationTypeEnum::Enum 
 ApplicationTypeEnum::fromName(const AString& name, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = ApplicationTypeEnum::enumData[0].enumValue;
@@ -207,7 +218,7 @@ ApplicationTypeEnum::fromName(const AString& name, bool* isValidOut)
  */
 AString 
 ApplicationTypeEnum::toGuiName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const ApplicationTypeEnum* enumInstance = findData(enumValue);
     return enumInstance->guiName;
@@ -226,7 +237,7 @@ ApplicationTypeEnum::toGuiName(Enum enumValue) {
 ApplicationTypeEnum::Enum 
 ApplicationTypeEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = ApplicationTypeEnum::enumData[0].enumValue;
@@ -260,7 +271,7 @@ ApplicationTypeEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 int32_t
 ApplicationTypeEnum::toIntegerCode(Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     const ApplicationTypeEnum* enumInstance = findData(enumValue);
     return enumInstance->integerCode;
 }
@@ -279,7 +290,7 @@ ApplicationTypeEnum::toIntegerCode(Enum enumValue)
 ApplicationTypeEnum::Enum
 ApplicationTypeEnum::fromIntegerCode(const int32_t integerCode, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = ApplicationTypeEnum::enumData[0].enumValue;
@@ -314,7 +325,7 @@ ApplicationTypeEnum::fromIntegerCode(const int32_t integerCode, bool* isValidOut
 void
 ApplicationTypeEnum::getAllEnums(std::vector<ApplicationTypeEnum::Enum>& allEnums)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allEnums.clear();
     
@@ -336,7 +347,7 @@ ApplicationTypeEnum::getAllEnums(std::vector<ApplicationTypeEnum::Enum>& allEnum
 void
 ApplicationTypeEnum::getAllNames(std::vector<AString>& allNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allNames.clear();
     
@@ -362,7 +373,7 @@ ApplicationTypeEnum::getAllNames(std::vector<AString>& allNames, const bool isSo
 void
 ApplicationTypeEnum::getAllGuiNames(std::vector<AString>& allGuiNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allGuiNames.clear();
     
@@ -23,9 +23,19 @@
 #include "ByteOrderEnum.h"
 #undef __BYTE_ORDER_DECLARE__
 
+#include "CaretMutex.h"
 
 using namespace caret;
 
+namespace
+{
+    CaretMutex& getInitializeMutex()
+    {//function-local, so it exists even if the enum is first used while initializing another static
+        static CaretMutex s_initializeMutex;
+        return s_initializeMutex;
+    }
+}
+
 /**
  * Constructor.
  *
@@ -89,10 +99,10 @@ ByteOrderEnum::isSystemBigEndian()
 void
 ByteOrderEnum::initialize()
 {
+    CaretMutexLocker locker(&getInitializeMutex());//always lock, an unlocked check of the flag could see it set before the data it guards
     if (initializedFlag) {
         return;
     }
-    initializedFlag = true;
 
     enumData.push_back(ByteOrderEnum(ENDIAN_BIG,"ENDIAN_BIG"));
     enumData.push_back(ByteOrderEnum(ENDIAN_LITTLE,"ENDIAN_LITTLE"));
@@ -102,6 +112,8 @@ ByteOrderEnum::initialize()
     
     ByteOrderEnum::systemEndian = ByteOrderEnum::ENDIAN_BIG;
     if (*c == 0x01) systemEndian = ByteOrderEnum::ENDIAN_LITTLE;
+    
+    initializedFlag = true;
 }
 
 /**
@@ -27,6 +27,7 @@
 
 #include "CaretBinaryFile.h"
 #include "CaretLogger.h"
+#include "CaretProfiler.h"
 #include "DataFileException.h"
 
 #include <QFile>
@@ -122,6 +123,7 @@ void CaretBinaryFile::read(void* dataOut, const int64_t& count, int64_t* numRead
 {
     if (!getOpenForRead()) throw DataFileException("file is not open for reading");
     m_impl->read(dataOut, count, numRead);
+    if (CaretProfiler::isEnabled()) CaretProfiler::addBytesRead(numRead != NULL ? *numRead : count);//uncompressed bytes, for .gz
 }
 
 void CaretBinaryFile::seek(const int64_t& position)
@@ -140,6 +142,7 @@ void CaretBinaryFile::write(const void* dataIn, const int64_t& count)
 {
     if (!getOpenForWrite()) throw DataFileException("file is not open for writing");
     m_impl->write(dataIn, count);
+    if (CaretProfiler::isEnabled()) CaretProfiler::addBytesWritten(count);
 }
 
 #ifdef ZLIB_VERSION
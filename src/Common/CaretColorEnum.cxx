@@ -25,9 +25,19 @@
 #undef __CARET_COLOR_ENUM_DECLARE__
 
 #include "CaretAssert.h"
+#include "CaretMutex.h"
 
 using namespace caret;
 
+namespace
+{
+    CaretMutex& getInitializeMutex()
+    {//function-local, so it exists even if the enum is first used while initializing another static
+        static CaretMutex s_initializeMutex;
+        return s_initializeMutex;
+    }
+}
+
     
 /**
  * \class caret::CaretColorEnum 
@@ -82,10 +92,10 @@ CaretColorEnum::~CaretColorEnum()
 void
 CaretColorEnum::initialize()
 {
+    CaretMutexLocker locker(&getInitializeMutex());//always lock, an unlocked check of the flag could see it set before the data it guards
     if (initializedFlag) {
         return;
     }
-    initializedFlag = true;
 
     enumData.push_back(CaretColorEnum(AQUA, 
                                       "AQUA", 
@@ -198,6 +208,8 @@ CaretColorEnum::initialize()
                                       1,
                                       1,
                                       0));
+    
+    initializedFlag = true;
 }
 
 /**
@@ -210,7 +222,7 @@ CaretColorEnum::initialize()
 const CaretColorEnum*
 CaretColorEnum::findData(const Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
 
     size_t num = enumData.size();
     for (size_t i = 0; i < num; i++) {
@@ -232,7 +244,7 @@ CaretColorEnum::findData(const Enum enumValue)
  */
 AString 
 CaretColorEnum::toName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const CaretColorEnum* enumInstance = findData(enumValue);
     return enumInstance->name;
@@ -251,7 +263,7 @@ CaretColorEnum::toName(Enum enumValue) {
 CaretColorEnum::Enum 
 CaretColorEnum::fromName(const AString& name, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = BLACK;
@@ -285,7 +297,7 @@ CaretColorEnum::fromName(const AString& name, bool* isValidOut)
  */
 AString 
 CaretColorEnum::toGuiName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const CaretColorEnum* enumInstance = findData(enumValue);
     return enumInstance->guiName;
@@ -300,7 +312,7 @@ CaretColorEnum::toGuiName(Enum enumValue) {
 const float* 
 CaretColorEnum::toRGB(Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const CaretColorEnum* enumInstance = findData(enumValue);
     return enumInstance->rgb;
@@ -317,7 +329,7 @@ void
 CaretColorEnum::toRGBFloat(Enum enumValue,
                            float rgbOut[3])
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const CaretColorEnum* enumInstance = findData(enumValue);
     rgbOut[0] = enumInstance->rgb[0];
@@ -358,7 +370,7 @@ CaretColorEnum::toRGBByte(Enum enumValue,
 CaretColorEnum::Enum 
 CaretColorEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = BLACK;
@@ -392,7 +404,7 @@ CaretColorEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 int32_t
 CaretColorEnum::toIntegerCode(Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     const CaretColorEnum* enumInstance = findData(enumValue);
     return enumInstance->integerCode;
 }
@@ -411,7 +423,7 @@ CaretColorEnum::toIntegerCode(Enum enumValue)
 CaretColorEnum::Enum
 CaretColorEnum::fromIntegerCode(const int32_t integerCode, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = BLACK;
@@ -446,7 +458,7 @@ CaretColorEnum::fromIntegerCode(const int32_t integerCode, bool* isValidOut)
 void
 CaretColorEnum::getAllEnums(std::vector<CaretColorEnum::Enum>& allEnums)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allEnums.clear();
     
@@ -469,7 +481,7 @@ void
 CaretColorEnum::getAllNames(std::vector<AString>& allNames, 
                             const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allNames.clear();
     
@@ -498,7 +510,7 @@ void
 CaretColorEnum::getAllGuiNames(std::vector<AString>& allGuiNames, 
                                const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allGuiNames.clear();
     
@@ -58,7 +58,9 @@ CaretObject::~CaretObject()
      * Erase returns the number of objects deleted.
      * If zero, then the object has already been deleted.
      */
-    uint64_t numDeleted = CaretObject::allocatedObjects.erase(this);
+    uint64_t numDeleted = 0;
+#pragma omp critical (CaretObjectTracker)
+    numDeleted = CaretObject::allocatedObjects.erase(this);//objects can be created and deleted in parallel regions, such as while reading files concurrently
     if (numDeleted <= 0) {
         std::cerr << "Destructor for a CaretObject called but the object is not allocated "
                   << "and this implies that the object has already been deleted.";
@@ -81,6 +83,7 @@ CaretObject::initializeMembersCaretObject()
 #ifndef NDEBUG
     SystemBacktrace myBacktrace;
     SystemUtilities::getBackTrace(myBacktrace);
+#pragma omp critical (CaretObjectTracker)
     CaretObject::allocatedObjects.insert(
                std::make_pair(this,
                               myBacktrace));
@@ -0,0 +1,375 @@
+/*LICENSE_START*/
+/*
+ *  Copyright (C) 2014  Washington University School of Medicine
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+/*LICENSE_END*/
+
+#include "CaretProfiler.h"
+
+#include "CaretAssert.h"
+#include "CaretCommandLine.h"
+#include "CaretException.h"
+#include "CaretMutex.h"
+#include "CaretOMP.h"
+#include "ElapsedTimer.h"
+
+#include <QThread>
+
+#include <fstream>
+#include <map>
+#include <vector>
+
+#ifdef CARET_OS_WINDOWS
+#include "windows.h"
+#else
+#include <sys/resource.h>
+#endif
+
+using namespace caret;
+using namespace std;
+
+bool CaretProfiler::s_enabled = false;
+
+namespace
+{
+    struct ProfileEvent
+    {
+        AString m_name, m_category;
+        int32_t m_thread;
+        int64_t m_parent;
+        double m_startSeconds, m_endSeconds, m_cpuStartSeconds, m_cpuEndSeconds;
+        int64_t m_bytesRead, m_bytesWritten, m_peakResidentBytes;
+        bool m_finished;
+    };
+    
+    CaretMutex s_profileMutex;
+    ElapsedTimer s_profileTimer;
+    Qt::HANDLE s_mainThread = 0;
+    vector<ProfileEvent> s_events;
+    map<Qt::HANDLE, int32_t> s_threadNumbers;
+    map<Qt::HANDLE, vector<int64_t> > s_openScopes;
+    int64_t s_totalBytesRead = 0, s_totalBytesWritten = 0;
+    
+    //call with the mutex held
+    int32_t getThreadNumber(const Qt::HANDLE& thread)
+    {
+        map<Qt::HANDLE, int32_t>::iterator iter = s_threadNumbers.find(thread);
+        if (iter != s_threadNumbers.end()) return iter->second;
+        int32_t ret = (int32_t)s_threadNumbers.size();
+        s_threadNumbers[thread] = ret;
+        return ret;
+    }
+    
+    //call with the mutex held, returns -1 if there is no open scope to attribute things to
+    int64_t getCurrentScope(const Qt::HANDLE& thread)
+    {
+        map<Qt::HANDLE, vector<int64_t> >::const_iterator iter = s_openScopes.find(thread);
+        if (iter != s_openScopes.end() && !iter->second.empty()) return iter->second.back();
+        iter = s_openScopes.find(s_mainThread);//worker threads of a parallel section belong under whatever the main thread is doing
+        if (iter != s_openScopes.end() && !iter->second.empty()) return iter->second.back();
+        return -1;
+    }
+    
+    AString escapeJSON(const AString& in)
+    {
+        AString ret;
+        for (int i = 0; i < in.size(); ++i)
+        {
+            QChar c = in[i];
+            if (c == '"' || c == '\\')
+            {
+                ret += QChar('\\');
+                ret += c;
+            } else if (c == '\n') {
+                ret += "\\n";
+            } else if (c.unicode() < 32) {
+                ret += "\\u" + AString::number((int)c.unicode(), 16).rightJustified(4, '0');
+            } else {
+                ret += c;
+            }
+        }
+        return ret;
+    }
+    
+    void writeSummaryScope(ofstream& out, const vector<vector<int64_t> >& children, const int64_t& index, const int& numThreads, const AString& indent)
+    {
+        const ProfileEvent& myEvent = s_events[index];
+        double wall = myEvent.m_endSeconds - myEvent.m_startSeconds, cpu = myEvent.m_cpuEndSeconds - myEvent.m_cpuStartSeconds;
+        out << indent << "{" << endl;
+        out << indent << "    \"name\": \"" << escapeJSON(myEvent.m_name) << "\"," << endl;
+        out << indent << "    \"category\": \"" << escapeJSON(myEvent.m_category) << "\"," << endl;
+        out << indent << "    \"thread\": " << myEvent.m_thread << "," << endl;
+        out << indent << "    \"start_seconds\": " << myEvent.m_startSeconds << "," << endl;
+        out << indent << "    \"wall_seconds\": " << wall << "," << endl;
+        out << indent << "    \"process_cpu_seconds\": " << cpu << "," << endl;
+        out << indent << "    \"thread_utilization\": " << (wall > 0.0 ? cpu / (wall * numThreads) : 0.0) << "," << endl;
+        out << indent << "    \"bytes_read\": " << myEvent.m_bytesRead << "," << endl;
+        out << indent << "    \"bytes_written\": " << myEvent.m_bytesWritten << "," << endl;
+        out << indent << "    \"peak_resident_bytes\": " << myEvent.m_peakResidentBytes << "," << endl;
+        out << indent << "    \"children\": [";
+        for (int i = 0; i < (int)children[index].size(); ++i)
+        {
+            out << (i == 0 ? "" : ",") << endl;
+            writeSummaryScope(out, children, children[index][i], numThreads, indent + "        ");
+        }
+        out << (children[index].empty() ? "" : "\n" + indent + "    ") << "]" << endl;
+        out << indent << "}";
+    }
+    
+    //call with the mutex held, closes anything left open by an exception so the output is well formed
+    void finishOpenScopes()
+    {
+        double now = s_profileTimer.getElapsedTimeSeconds(), cpu = CaretProfiler::getProcessCPUSeconds();
+        for (int64_t i = 0; i < (int64_t)s_events.size(); ++i)
+        {
+            if (!s_events[i].m_finished)
+            {
+                s_events[i].m_endSeconds = now;
+                s_events[i].m_cpuEndSeconds = cpu;
+                s_events[i].m_peakResidentBytes = CaretProfiler::getPeakResidentBytes();
+            }
+        }
+    }
+    
+    int getNumberOfThreads()
+    {
+#ifdef CARET_OMP
+        return omp_get_max_threads();
+#else
+        return 1;
+#endif
+    }
+}
+
+/**
+ * Start recording.  Scopes opened before this are ignored.
+ */
+void
+CaretProfiler::enable()
+{
+    CaretMutexLocker locked(&s_profileMutex);
+    if (s_enabled) return;
+    s_mainThread = QThread::currentThreadId();
+    s_profileTimer.start();
+    s_enabled = true;
+}
+
+/**
+ * Count bytes read from files, for the totals and for the current scope.
+ *
+ * @param bytes
+ *    Number of bytes read.
+ */
+void
+CaretProfiler::addBytesRead(const int64_t& bytes)
+{
+    if (!s_enabled) return;
+    CaretMutexLocker locked(&s_profileMutex);
+    s_totalBytesRead += bytes;
+    int64_t current = getCurrentScope(QThread::currentThreadId());
+    if (current >= 0) s_events[current].m_bytesRead += bytes;
+}
+
+/**
+ * Count bytes written to files, for the totals and for the current scope.
+ *
+ * @param bytes
+ *    Number of bytes written.
+ */
+void
+CaretProfiler::addBytesWritten(const int64_t& bytes)
+{
+    if (!s_enabled) return;
+    CaretMutexLocker locked(&s_profileMutex);
+    s_totalBytesWritten += bytes;
+    int64_t current = getCurrentScope(QThread::currentThreadId());
+    if (current >= 0) s_events[current].m_bytesWritten += bytes;
+}
+
+/**
+ * @return CPU time used so far by all threads of the process, in seconds.
+ */
+double
+CaretProfiler::getProcessCPUSeconds()
+{
+#ifdef CARET_OS_WINDOWS
+    FILETIME creationTime, exitTime, kernelTime, userTime;
+    if (!GetProcessTimes(GetCurrentProcess(), &creationTime, &exitTime, &kernelTime, &userTime)) return 0.0;
+    uint64_t kernel = ((uint64_t)kernelTime.dwHighDateTime << 32) | kernelTime.dwLowDateTime;
+    uint64_t user = ((uint64_t)userTime.dwHighDateTime << 32) | userTime.dwLowDateTime;
+    return (kernel + user) / 10000000.0;//100 nanosecond units
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0.0;
+    return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1000000.0;
+#endif
+}
+
+/**
+ * @return Peak resident memory of the process so far in bytes, or -1 if it
+ * is not available on this platform.
+ */
+int64_t
+CaretProfiler::getPeakResidentBytes()
+{
+#ifdef CARET_OS_WINDOWS
+    return -1;//GetProcessMemoryInfo needs psapi, which we don't otherwise link
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return -1;
+#ifdef CARET_OS_MACOSX
+    return usage.ru_maxrss;//bytes on mac
+#else
+    return ((int64_t)usage.ru_maxrss) * 1024;//kilobytes on linux
+#endif
+#endif
+}
+
+/**
+ * Write the scopes as a tree, with process totals, as JSON.
+ *
+ * @param fileName
+ *    Name of the output file.
+ */
+void
+CaretProfiler::writeSummaryJSON(const AString& fileName)
+{
+    CaretMutexLocker locked(&s_profileMutex);
+    finishOpenScopes();
+    ofstream out(fileName.toLocal8Bit().constData());
+    if (!out) throw CaretException("failed to open profile output file '" + fileName + "'");
+    int numThreads = getNumberOfThreads();
+    double wall = s_profileTimer.getElapsedTimeSeconds(), cpu = getProcessCPUSeconds();
+    vector<vector<int64_t> > children(s_events.size());
+    vector<int64_t> roots;
+    for (int64_t i = 0; i < (int64_t)s_events.size(); ++i)
+    {
+        if (s_events[i].m_parent < 0)
+        {
+            roots.push_back(i);
+        } else {
+            children[s_events[i].m_parent].push_back(i);
+        }
+    }
+    out << "{" << endl;
+    out << "    \"command_line\": \"" << escapeJSON(caret_global_commandLine) << "\"," << endl;
+    out << "    \"wall_seconds\": " << wall << "," << endl;
+    out << "    \"process_cpu_seconds\": " << cpu << "," << endl;
+    out << "    \"threads\": " << numThreads << "," << endl;
+    out << "    \"thread_utilization\": " << (wall > 0.0 ? cpu / (wall * numThreads) : 0.0) << "," << endl;
+    out << "    \"peak_resident_bytes\": " << getPeakResidentBytes() << "," << endl;
+    out << "    \"bytes_read\": " << s_totalBytesRead << "," << endl;
+    out << "    \"bytes_written\": " << s_totalBytesWritten << "," << endl;
+    out << "    \"scopes\": [";
+    for (int i = 0; i < (int)roots.size(); ++i)
+    {
+        out << (i == 0 ? "" : ",") << endl;
+        writeSummaryScope(out, children, roots[i], numThreads, "        ");
+    }
+    out << endl << "    ]" << endl;
+    out << "}" << endl;
+}
+
+/**
+ * Write the scopes in the Chrome trace event format, for chrome://tracing or Perfetto.
+ *
+ * @param fileName
+ *    Name of the output file.
+ */
+void
+CaretProfiler::writeChromeTrace(const AString& fileName)
+{
+    CaretMutexLocker locked(&s_profileMutex);
+    finishOpenScopes();
+    ofstream out(fileName.toLocal8Bit().constData());
+    if (!out) throw CaretException("failed to open profile output file '" + fileName + "'");
+    out << "{\"traceEvents\": [";
+    bool first = true;
+    for (map<Qt::HANDLE, int32_t>::const_iterator iter = s_threadNumbers.begin(); iter != s_threadNumbers.end(); ++iter)
+    {
+        out << (first ? "" : ",") << endl;
+        first = false;
+        out << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << iter->second
+            << ", \"args\": {\"name\": \"" << (iter->first == s_mainThread ? AString("main") : "worker " + AString::number(iter->second)) << "\"}}";
+    }
+    for (int64_t i = 0; i < (int64_t)s_events.size(); ++i)
+    {
+        const ProfileEvent& myEvent = s_events[i];
+        out << (first ? "" : ",") << endl;
+        first = false;
+        out << "{\"name\": \"" << escapeJSON(myEvent.m_name) << "\", \"cat\": \"" << escapeJSON(myEvent.m_category)
+            << "\", \"ph\": \"X\", \"pid\": 1, \"tid\": " << myEvent.m_thread
+            << ", \"ts\": " << (int64_t)(myEvent.m_startSeconds * 1000000.0)
+            << ", \"dur\": " << (int64_t)((myEvent.m_endSeconds - myEvent.m_startSeconds) * 1000000.0)
+            << ", \"args\": {\"process_cpu_seconds\": " << (myEvent.m_cpuEndSeconds - myEvent.m_cpuStartSeconds)
+            << ", \"bytes_read\": " << myEvent.m_bytesRead << ", \"bytes_written\": " << myEvent.m_bytesWritten
+            << ", \"peak_resident_bytes\": " << myEvent.m_peakResidentBytes << "}}";
+    }
+    out << endl << "], \"displayTimeUnit\": \"ms\", \"otherData\": {\"command_line\": \"" << escapeJSON(caret_global_commandLine)
+        << "\", \"threads\": " << getNumberOfThreads() << ", \"peak_resident_bytes\": " << getPeakResidentBytes()
+        << ", \"bytes_read\": " << s_totalBytesRead << ", \"bytes_written\": " << s_totalBytesWritten << "}}" << endl;
+}
+
+/**
+ * Start timing a scope, if profiling is enabled.
+ *
+ * @param name
+ *    What is being timed.
+ * @param category
+ *    Kind of work, for instance "read", "write", or "algorithm".
+ */
+CaretProfiler::Scope::Scope(const AString& name, const AString& category)
+{
+    m_eventIndex = -1;
+    if (!s_enabled) return;
+    Qt::HANDLE thread = QThread::currentThreadId();
+    CaretMutexLocker locked(&s_profileMutex);
+    ProfileEvent myEvent;
+    myEvent.m_name = name;
+    myEvent.m_category = category;
+    myEvent.m_thread = getThreadNumber(thread);
+    myEvent.m_parent = getCurrentScope(thread);
+    myEvent.m_startSeconds = s_profileTimer.getElapsedTimeSeconds();
+    myEvent.m_endSeconds = myEvent.m_startSeconds;
+    myEvent.m_cpuStartSeconds = getProcessCPUSeconds();
+    myEvent.m_cpuEndSeconds = myEvent.m_cpuStartSeconds;
+    myEvent.m_bytesRead = 0;
+    myEvent.m_bytesWritten = 0;
+    myEvent.m_peakResidentBytes = -1;
+    myEvent.m_finished = false;
+    m_eventIndex = (int64_t)s_events.size();
+    s_events.push_back(myEvent);
+    s_openScopes[thread].push_back(m_eventIndex);
+}
+
+/**
+ * Finish timing the scope.
+ */
+CaretProfiler::Scope::~Scope()
+{
+    if (m_eventIndex < 0) return;
+    Qt::HANDLE thread = QThread::currentThreadId();
+    CaretMutexLocker locked(&s_profileMutex);
+    ProfileEvent& myEvent = s_events[m_eventIndex];
+    myEvent.m_endSeconds = s_profileTimer.getElapsedTimeSeconds();
+    myEvent.m_cpuEndSeconds = getProcessCPUSeconds();
+    myEvent.m_peakResidentBytes = getPeakResidentBytes();
+    myEvent.m_finished = true;
+    vector<int64_t>& myStack = s_openScopes[thread];
+    CaretAssert(!myStack.empty() && myStack.back() == m_eventIndex);//scopes are stack objects, so they always close in order
+    if (!myStack.empty()) myStack.pop_back();
+}
@@ -0,0 +1,80 @@
+#ifndef __CARET_PROFILER_H__
+#define __CARET_PROFILER_H__
+
+/*LICENSE_START*/
+/*
+ *  Copyright (C) 2014  Washington University School of Medicine
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+/*LICENSE_END*/
+
+#include "AString.h"
+
+#include <stdint.h>
+
+namespace caret {
+
+    /**
+     * \class caret::CaretProfiler
+     * \brief Collects nested timings, memory and I/O totals for one run of a command
+     *
+     * Nothing is recorded unless enable() has been called, so Scope objects
+     * can be left in place in normal code.  Scopes nest by thread, and scopes
+     * opened by worker threads that have no open scope of their own are placed
+     * under the innermost open scope of the thread that enabled profiling.
+     */
+    class CaretProfiler {
+        
+    public:
+        /// times from construction to destruction
+        class Scope {
+        public:
+            Scope(const AString& name, const AString& category);
+            
+            ~Scope();
+            
+        private:
+            Scope(const Scope&);
+            
+            Scope& operator=(const Scope&);
+            
+            int64_t m_eventIndex;
+        };
+        
+        static void enable();
+        
+        static bool isEnabled() { return s_enabled; }
+        
+        static void addBytesRead(const int64_t& bytes);
+        
+        static void addBytesWritten(const int64_t& bytes);
+        
+        static void writeSummaryJSON(const AString& fileName);
+        
+        static void writeChromeTrace(const AString& fileName);
+        
+        static double getProcessCPUSeconds();
+        
+        static int64_t getPeakResidentBytes();
+        
+    private:
+        CaretProfiler();
+        
+        static bool s_enabled;
+    };
+    
+} // namespace
+#endif  //__CARET_PROFILER_H__
@@ -25,9 +25,19 @@
 
 #include "CaretAssert.h"
 #include "CaretLogger.h"
+#include "CaretMutex.h"
 
 using namespace caret;
 
+namespace
+{
+    CaretMutex& getInitializeMutex()
+    {//function-local, so it exists even if the enum is first used while initializing another static
+        static CaretMutex s_initializeMutex;
+        return s_initializeMutex;
+    }
+}
+
 /**
  * \class caret::DataFileTypeEnum 
  * \brief An enumerated type for data files.
@@ -109,10 +119,10 @@ DataFileTypeEnum::~DataFileTypeEnum()
 void
 DataFileTypeEnum::initialize()
 {
+    CaretMutexLocker locker(&getInitializeMutex());//always lock, an unlocked check of the flag could see it set before the data it guards
     if (initializedFlag) {
         return;
     }
-    initializedFlag = true;
 
     enumData.push_back(DataFileTypeEnum(BORDER, 
                                         "BORDER", 
@@ -291,6 +301,8 @@ DataFileTypeEnum::initialize()
                                         false,
                                         "nii",
                                         "nii.gz"));
+    
+    initializedFlag = true;
 }
 
 /**
@@ -303,7 +315,7 @@ DataFileTypeEnum::initialize()
 const DataFileTypeEnum*
 DataFileTypeEnum::findData(const Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
 
     size_t num = enumData.size();
     for (size_t i = 0; i < num; i++) {
@@ -325,7 +337,7 @@ DataFileTypeEnum::findData(const Enum enumValue)
  */
 AString 
 DataFileTypeEnum::toName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const DataFileTypeEnum* enumInstance = findData(enumValue);
     return enumInstance->name;
@@ -345,7 +357,7 @@ DataFileTypeEnum::Enum
 DataFileTypeEnum::fromName(const AString& nameIn, bool* isValidOut)
 {
     AString name = nameIn;
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = UNKNOWN;
@@ -391,7 +403,7 @@ DataFileTypeEnum::fromName(const AString& nameIn, bool* isValidOut)
  */
 AString 
 DataFileTypeEnum::toGuiName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const DataFileTypeEnum* enumInstance = findData(enumValue);
     return enumInstance->guiName;
@@ -410,7 +422,7 @@ DataFileTypeEnum::toGuiName(Enum enumValue) {
 DataFileTypeEnum::Enum 
 DataFileTypeEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = UNKNOWN;
@@ -444,7 +456,7 @@ DataFileTypeEnum::fromGuiName(const AString& guiName, bool* isValidOut)
  */
 AString
 DataFileTypeEnum::toOverlayTypeName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const DataFileTypeEnum* enumInstance = findData(enumValue);
     return enumInstance->overlayTypeName;
@@ -463,7 +475,7 @@ DataFileTypeEnum::toOverlayTypeName(Enum enumValue) {
 DataFileTypeEnum::Enum
 DataFileTypeEnum::fromOverlayTypeName(const AString& overlayTypeName, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = UNKNOWN;
@@ -497,7 +509,7 @@ DataFileTypeEnum::fromOverlayTypeName(const AString& overlayTypeName, bool* isVa
 int32_t
 DataFileTypeEnum::toIntegerCode(Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     const DataFileTypeEnum* enumInstance = findData(enumValue);
     return enumInstance->integerCode;
 }
@@ -516,7 +528,7 @@ DataFileTypeEnum::Enum
 DataFileTypeEnum::fromQFileDialogFilter(const AString& qFileDialogNameFilter, 
                                         bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = UNKNOWN;
@@ -552,7 +564,7 @@ DataFileTypeEnum::fromQFileDialogFilter(const AString& qFileDialogNameFilter,
 AString 
 DataFileTypeEnum::toQFileDialogFilter(const Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     const DataFileTypeEnum* enumInstance = findData(enumValue);
     return enumInstance->qFileDialogNameFilter;
 }
@@ -566,7 +578,7 @@ DataFileTypeEnum::toQFileDialogFilter(const Enum enumValue)
 bool 
 DataFileTypeEnum::isFileUsedWithOneStructure(const Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     const DataFileTypeEnum* enumInstance = findData(enumValue);
     return enumInstance->oneStructureFlag;
 }
@@ -579,7 +591,7 @@ DataFileTypeEnum::isFileUsedWithOneStructure(const Enum enumValue)
 std::vector<AString> 
 DataFileTypeEnum::getAllFileExtensions(const Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     const DataFileTypeEnum* enumInstance = findData(enumValue);
     return enumInstance->fileExtensions;
 }
@@ -623,7 +635,7 @@ DataFileTypeEnum::addFileExtensionIfMissing(const AString& filenameIn,
 {   
     AString filename = filenameIn;
 
-    if (initializedFlag == false) initialize();
+    initialize();
     const DataFileTypeEnum* enumInstance = findData(enumValue);
     
     /*
@@ -658,7 +670,7 @@ DataFileTypeEnum::addFileExtensionIfMissing(const AString& filenameIn,
 AString 
 DataFileTypeEnum::toFileExtension(const Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     const DataFileTypeEnum* enumInstance = findData(enumValue);
     
     AString ext = "file";
@@ -682,7 +694,7 @@ bool
 DataFileTypeEnum::isValidFileExtension(const AString& filename,
                                        const Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     const DataFileTypeEnum* enumInstance = findData(enumValue);
     
     /*
@@ -714,7 +726,7 @@ DataFileTypeEnum::isValidFileExtension(const AString& filename,
 DataFileTypeEnum::Enum 
 DataFileTypeEnum::fromFileExtension(const AString& filename, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = UNKNOWN;
@@ -766,7 +778,7 @@ DataFileTypeEnum::fromFileExtension(const AString& filename, bool* isValidOut)
 DataFileTypeEnum::Enum
 DataFileTypeEnum::fromIntegerCode(const int32_t integerCode, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = UNKNOWN;
@@ -804,7 +816,7 @@ void
 DataFileTypeEnum::getAllEnums(std::vector<DataFileTypeEnum::Enum>& allEnums,
                               const bool includeUnknown)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allEnums.clear();
     
@@ -846,7 +858,7 @@ DataFileTypeEnum::isConnectivityDataType(const Enum enumValue)
 void 
 DataFileTypeEnum::getAllConnectivityEnums(std::vector<Enum>& connectivityEnumsOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     connectivityEnumsOut.clear();
     
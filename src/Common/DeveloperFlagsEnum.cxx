@@ -25,9 +25,19 @@
 #undef __DEVELOPER_FLAGS_ENUM_DECLARE__
 
 #include "CaretAssert.h"
+#include "CaretMutex.h"
 
 using namespace caret;
 
+namespace
+{
+    CaretMutex& getInitializeMutex()
+    {//function-local, so it exists even if the enum is first used while initializing another static
+        static CaretMutex s_initializeMutex;
+        return s_initializeMutex;
+    }
+}
+
     
 /**
  * \class caret::DeveloperFlagsEnum 
@@ -122,10 +132,10 @@ DeveloperFlagsEnum::~DeveloperFlagsEnum()
 void
 DeveloperFlagsEnum::initialize()
 {
+    CaretMutexLocker locker(&getInitializeMutex());//always lock, an unlocked check of the flag could see it set before the data it guards
     if (initializedFlag) {
         return;
     }
-    initializedFlag = true;
 
     enumData.push_back(DeveloperFlagsEnum(FLAG_PARCEL_REORDERING, 
                                     "FLAG_PARCEL_REORDERING", 
@@ -143,6 +153,7 @@ DeveloperFlagsEnum::initialize()
                                           "FLAG_VOLUME_CENTERING",
                                           "Volume Centering"));
     
+    initializedFlag = true;
 }
 
 /**
@@ -155,7 +166,7 @@ DeveloperFlagsEnum::initialize()
 DeveloperFlagsEnum*
 DeveloperFlagsEnum::findData(const Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
 
     size_t num = enumData.size();
     for (size_t i = 0; i < num; i++) {
@@ -177,7 +188,7 @@ DeveloperFlagsEnum::findData(const Enum enumValue)
  */
 AString 
 DeveloperFlagsEnum::toName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const DeveloperFlagsEnum* enumInstance = findData(enumValue);
     return enumInstance->name;
@@ -196,7 +207,7 @@ DeveloperFlagsEnum::toName(Enum enumValue) {
 DeveloperFlagsEnum::Enum 
 DeveloperFlagsEnum::fromName(const AString& name, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = DeveloperFlagsEnum::enumData[0].enumValue;
@@ -230,7 +241,7 @@ DeveloperFlagsEnum::fromName(const AString& name, bool* isValidOut)
  */
 AString 
 DeveloperFlagsEnum::toGuiName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const DeveloperFlagsEnum* enumInstance = findData(enumValue);
     return enumInstance->guiName;
@@ -249,7 +260,7 @@ DeveloperFlagsEnum::toGuiName(Enum enumValue) {
 DeveloperFlagsEnum::Enum 
 DeveloperFlagsEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = DeveloperFlagsEnum::enumData[0].enumValue;
@@ -283,7 +294,7 @@ DeveloperFlagsEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 int32_t
 DeveloperFlagsEnum::toIntegerCode(Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     const DeveloperFlagsEnum* enumInstance = findData(enumValue);
     return enumInstance->integerCode;
 }
@@ -302,7 +313,7 @@ DeveloperFlagsEnum::toIntegerCode(Enum enumValue)
 DeveloperFlagsEnum::Enum
 DeveloperFlagsEnum::fromIntegerCode(const int32_t integerCode, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = DeveloperFlagsEnum::enumData[0].enumValue;
@@ -337,7 +348,7 @@ DeveloperFlagsEnum::fromIntegerCode(const int32_t integerCode, bool* isValidOut)
 void
 DeveloperFlagsEnum::getAllEnums(std::vector<DeveloperFlagsEnum::Enum>& allEnums)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allEnums.clear();
     
@@ -359,7 +370,7 @@ DeveloperFlagsEnum::getAllEnums(std::vector<DeveloperFlagsEnum::Enum>& allEnums)
 void
 DeveloperFlagsEnum::getAllNames(std::vector<AString>& allNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allNames.clear();
     
@@ -385,7 +396,7 @@ DeveloperFlagsEnum::getAllNames(std::vector<AString>& allNames, const bool isSor
 void
 DeveloperFlagsEnum::getAllGuiNames(std::vector<AString>& allGuiNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allGuiNames.clear();
     
@@ -411,7 +422,7 @@ DeveloperFlagsEnum::getAllGuiNames(std::vector<AString>& allGuiNames, const bool
 bool
 DeveloperFlagsEnum::isFlag(const Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     const DeveloperFlagsEnum* enumInstance = findData(enumValue);
     return enumInstance->flagStatus;
 }
@@ -428,7 +439,7 @@ void
 DeveloperFlagsEnum::setFlag(const Enum enumValue,
                             const bool flagStatus)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     DeveloperFlagsEnum* enumInstance = findData(enumValue);
     enumInstance->flagStatus = flagStatus;
 }
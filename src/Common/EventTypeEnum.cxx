@@ -23,9 +23,19 @@
 #undef __EVENT_TYPE_ENUM_DECLARE__
 
 #include "CaretAssert.h"
+#include "CaretMutex.h"
 
 using namespace caret;
 
+namespace
+{
+    CaretMutex& getInitializeMutex()
+    {//function-local, so it exists even if the enum is first used while initializing another static
+        static CaretMutex s_initializeMutex;
+        return s_initializeMutex;
+    }
+}
+
 /**
  * Constructor.
  *
@@ -56,10 +66,10 @@ EventTypeEnum::~EventTypeEnum()
 void
 EventTypeEnum::initialize()
 {
+    CaretMutexLocker locker(&getInitializeMutex());//always lock, an unlocked check of the flag could see it set before the data it guards
     if (initializedFlag) {
         return;
     }
-    initializedFlag = true;
 
     enumData.push_back(EventTypeEnum(EVENT_INVALID, 
                                      "EVENT_INVALID", 
@@ -276,6 +286,8 @@ EventTypeEnum::initialize()
                         + AString::number(enumData.size())
                         + "   EVENT_COUNT+1="
                         + AString::number(EVENT_COUNT + 1)));
+    
+    initializedFlag = true;
 }
 
 /**
@@ -288,7 +300,7 @@ EventTypeEnum::initialize()
 const EventTypeEnum*
 EventTypeEnum::findData(const Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
 
     size_t num = enumData.size();
     for (size_t i = 0; i < num; i++) {
@@ -310,7 +322,7 @@ EventTypeEnum::findData(const Enum enumValue)
  */
 AString 
 EventTypeEnum::toName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const EventTypeEnum* enumInstance = findData(enumValue);
     return enumInstance->name;
@@ -329,7 +341,7 @@ EventTypeEnum::toName(Enum enumValue) {
 EventTypeEnum::Enum 
 EventTypeEnum::fromName(const AString& name, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = EVENT_INVALID;
@@ -363,7 +375,7 @@ EventTypeEnum::fromName(const AString& name, bool* isValidOut)
  */
 AString 
 EventTypeEnum::toGuiName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const EventTypeEnum* enumInstance = findData(enumValue);
     return enumInstance->guiName;
@@ -382,7 +394,7 @@ EventTypeEnum::toGuiName(Enum enumValue) {
 EventTypeEnum::Enum 
 EventTypeEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = EVENT_INVALID;
@@ -417,7 +429,7 @@ EventTypeEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 void
 EventTypeEnum::getAllEnums(std::vector<EventTypeEnum::Enum>& allEnums)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allEnums.clear();
     
@@ -20,15 +20,47 @@
 /*LICENSE_END*/
 
 #include "FastStatistics.h"
+#include "CaretAssert.h"
 #include "CaretPointer.h"
 
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 
 using namespace caret;
 using namespace std;
 
 const int64_t NUM_BUCKETS_PERCENTILE_HIST = 10000;//10,000 maximum to deal with some outliers outliers until I think of a better fix
+const int ACCUM_BIN_SHIFT = 11;//accumulating bins finite magnitudes by the top bits of their float representation, 12 mantissa bits is 1/4096 relative precision
+const int64_t NUM_ACCUM_BINS = (0x7F800000 >> ACCUM_BIN_SHIFT);//0x7F800000 is the bit pattern of infinity
+
+namespace
+{
+    int64_t accumulateBin(const float& magnitude)
+    {//the bit patterns of nonnegative floats sort the same as their values
+        uint32_t bits;
+        memcpy(&bits, &magnitude, sizeof(bits));
+        return bits >> ACCUM_BIN_SHIFT;
+    }
+    
+    void rebinAccumulated(const vector<int64_t>& accumBins, const float& sign, const float& histMin, const float& histMax, const int64_t& numBuckets, vector<int64_t>& bucketsOut)
+    {//put each fine bin into the linear bucket containing the middle of the fine bin
+        bucketsOut.assign(numBuckets, 0);
+        float bucketsize = (histMax - histMin) / numBuckets;
+        for (int64_t i = 0; i < NUM_ACCUM_BINS; ++i)
+        {
+            if (accumBins[i] == 0) continue;
+            uint32_t bits = (uint32_t)((i << ACCUM_BIN_SHIFT) | (1 << (ACCUM_BIN_SHIFT - 1)));
+            float value;
+            memcpy(&value, &bits, sizeof(value));
+            value = min(histMax, max(histMin, sign * value));
+            int64_t bucket = 0;
+            if (bucketsize > 0.0f) bucket = (int64_t)((value - histMin) / bucketsize);
+            if (bucket >= numBuckets) bucket = numBuckets - 1;
+            bucketsOut[bucket] += accumBins[i];
+        }
+    }
+}
 
 FastStatistics::FastStatistics()
 {
@@ -205,6 +237,95 @@ void FastStatistics::update(const float* data, const int64_t& dataCount, const f
     m_posPercentHist.update(usebuckets, positives, m_posCount);
 }
 
+void FastStatistics::startAccumulating()
+{
+    reset();
+    m_accumSum = 0.0;
+    m_accumSumSquares = 0.0;
+    m_accumLeastPos = 0.0f;
+    m_accumLeastNeg = 0.0f;
+    m_accumPosBins.assign(NUM_ACCUM_BINS, 0);
+    m_accumNegBins.assign(NUM_ACCUM_BINS, 0);
+}
+
+void FastStatistics::accumulate(const float* data, const int64_t& dataCount)
+{
+    CaretAssert((int64_t)m_accumPosBins.size() == NUM_ACCUM_BINS);
+    for (int64_t i = 0; i < dataCount; ++i)
+    {//same classification as update()
+        const float value = data[i];
+        if (value != value)
+        {
+            ++m_nanCount;
+            continue;
+        }
+        if (value == 0.0f)
+        {
+            ++m_zeroCount;
+        } else {
+            if (value < 0.0f)
+            {
+                if (value * 2.0f == value)
+                {
+                    ++m_negInfCount;
+                    continue;
+                }
+                if (m_negCount == 0 || value > m_accumLeastNeg) m_accumLeastNeg = value;
+                ++m_negCount;
+                ++m_accumNegBins[accumulateBin(-value)];
+                if (value > m_leastNeg) m_leastNeg = value;
+                if (value < m_mostNeg) m_mostNeg = value;
+            } else {
+                if (value * 2.0f == value)
+                {
+                    ++m_infCount;
+                    continue;
+                }
+                if (m_posCount == 0 || value < m_accumLeastPos) m_accumLeastPos = value;
+                ++m_posCount;
+                ++m_accumPosBins[accumulateBin(value)];
+                if (value > m_mostPos) m_mostPos = value;
+                if (value < m_leastPos) m_leastPos = value;
+            }
+        }
+        if ((m_negCount + m_zeroCount + m_posCount) == 1)
+        {
+            m_min = value;
+            m_max = value;
+        } else {
+            if (value > m_max) m_max = value;
+            if (value < m_min) m_min = value;
+        }
+        m_accumSum += value;
+        m_accumSumSquares += (double)value * value;
+    }
+}
+
+void FastStatistics::finishAccumulating()
+{
+    CaretAssert((int64_t)m_accumPosBins.size() == NUM_ACCUM_BINS);
+    int64_t totalGood = (m_negCount + m_zeroCount + m_posCount);
+    if (totalGood > 0)
+    {//one pass, so use the sum of squares, in double it is plenty stable for display purposes
+        m_mean = m_accumSum / totalGood;
+        double sum2 = max(0.0, m_accumSumSquares - m_accumSum * m_accumSum / totalGood);
+        m_stdDevPop = sqrt(sum2 / totalGood);
+        if (totalGood > 1)
+        {
+            m_stdDevSample = sqrt(sum2 / (totalGood - 1));
+        }
+    }
+    int64_t dataCount = totalGood + m_infCount + m_negInfCount + m_nanCount;
+    int64_t usebuckets = max((int64_t)1, min(NUM_BUCKETS_PERCENTILE_HIST, dataCount));
+    vector<int64_t> buckets;
+    rebinAccumulated(m_accumNegBins, -1.0f, m_mostNeg, (m_negCount > 0 ? m_accumLeastNeg : m_mostNeg), usebuckets, buckets);
+    m_negPercentHist.update(buckets, m_mostNeg, (m_negCount > 0 ? m_accumLeastNeg : m_mostNeg));
+    rebinAccumulated(m_accumPosBins, 1.0f, (m_posCount > 0 ? m_accumLeastPos : m_mostPos), m_mostPos, usebuckets, buckets);
+    m_posPercentHist.update(buckets, (m_posCount > 0 ? m_accumLeastPos : m_mostPos), m_mostPos);
+    vector<int64_t>().swap(m_accumPosBins);//release the fine bins
+    vector<int64_t>().swap(m_accumNegBins);
+}
+
 float FastStatistics::getApproxNegativePercentile(const float& percent) const
 {
     float rank = percent / 100.0f * m_negCount;//translate to rank
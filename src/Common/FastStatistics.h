@@ -34,6 +34,10 @@ namespace caret
         float m_mostPos, m_leastPos, m_leastNeg, m_mostNeg;
         ///counts of each class of number
         int64_t m_posCount, m_zeroCount, m_negCount, m_infCount, m_negInfCount, m_nanCount;
+        ///only used between startAccumulating() and finishAccumulating()
+        double m_accumSum, m_accumSumSquares;
+        float m_accumLeastPos, m_accumLeastNeg;
+        std::vector<int64_t> m_accumPosBins, m_accumNegBins;
         
         void reset();
         
@@ -47,6 +51,14 @@ namespace caret
         ///statistics and display are really not that related, so for now, only include a continuous clipping range, excluding the middle from data will do weird things to standard deviation
         void update(const float* data, const int64_t& dataCount, const float& minThreshInclusive, const float& maxThreshInclusive);
         
+        ///for data too large to have in memory at once: call startAccumulating(), give all of the data to accumulate() in pieces, then call finishAccumulating()
+        ///percentiles come from a fine histogram of the float values rather than the data itself, so they can differ very slightly from update()
+        void startAccumulating();
+        
+        void accumulate(const float* data, const int64_t& dataCount);
+        
+        void finishAccumulating();
+        
         float getApproxPositivePercentile(const float& percent) const;
         
         float getApproxNegativePercentile(const float& percent) const;
@@ -304,6 +304,26 @@ void Histogram::update(const float* data, const int64_t& dataCount, float mostPo
     }
 }
 
+void Histogram::update(const vector<int64_t>& bucketCounts, const float& bucketMin, const float& bucketMax)
+{
+    CaretAssert(!bucketCounts.empty());
+    int numBuckets = (int)bucketCounts.size();
+    resize(numBuckets);
+    reset();
+    m_bucketMin = bucketMin;
+    m_bucketMax = bucketMax;
+    m_buckets = bucketCounts;
+    computeCumulative();
+    if (bucketMax > bucketMin)
+    {
+        float bucketsize = (bucketMax - bucketMin) / numBuckets;
+        for (int i = 0; i < numBuckets; ++i)
+        {
+            m_display[i] = m_buckets[i] / bucketsize;
+        }
+    }
+}
+
 void Histogram::computeCumulative()
 {
     int numBuckets = (int)m_buckets.size();
@@ -60,6 +60,9 @@ namespace caret
                     float mostNegativeValueInclusive,
                     const bool& includeZeroValues);
         
+        ///use counts that were binned elsewhere, for data too large to have in memory at once, the value class counts are left at zero
+        void update(const std::vector<int64_t>& bucketCounts, const float& bucketMin, const float& bucketMax);
+        
         ///get raw counts (useful mathematically)
         const std::vector<int64_t>& getHistogramCounts() const { return m_buckets; }
         
@@ -25,9 +25,19 @@
 #undef __IMAGE_CAPTURE_METHOD_ENUM_DECLARE__
 
 #include "CaretAssert.h"
+#include "CaretMutex.h"
 
 using namespace caret;
 
+namespace
+{
+    CaretMutex& getInitializeMutex()
+    {//function-local, so it exists even if the enum is first used while initializing another static
+        static CaretMutex s_initializeMutex;
+        return s_initializeMutex;
+    }
+}
+
     
 /**
  * \class caret::ImageCaptureMethodEnum 
@@ -101,10 +111,10 @@ ImageCaptureMethodEnum::~ImageCaptureMethodEnum()
 void
 ImageCaptureMethodEnum::initialize()
 {
+    CaretMutexLocker locker(&getInitializeMutex());//always lock, an unlocked check of the flag could see it set before the data it guards
     if (initializedFlag) {
         return;
     }
-    initializedFlag = true;
 
     enumData.push_back(ImageCaptureMethodEnum(IMAGE_CAPTURE_WITH_RENDER_PIXMAP, 
                                     "IMAGE_CAPTURE_WITH_RENDER_PIXMAP", 
@@ -114,6 +124,7 @@ ImageCaptureMethodEnum::initialize()
                                     "IMAGE_CAPTURE_WITH_GRAB_FRAME_BUFFER", 
                                     "Grab Frame Buffer"));
     
+    initializedFlag = true;
 }
 
 /**
@@ -126,7 +137,7 @@ ImageCaptureMethodEnum::initialize()
 const ImageCaptureMethodEnum*
 ImageCaptureMethodEnum::findData(const Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
 
     size_t num = enumData.size();
     for (size_t i = 0; i < num; i++) {
@@ -148,7 +159,7 @@ ImageCaptureMethodEnum::findData(const Enum enumValue)
  */
 AString 
 ImageCaptureMethodEnum::toName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const ImageCaptureMethodEnum* enumInstance = findData(enumValue);
     return enumInstance->name;
@@ -167,7 +178,7 @@ ImageCaptureMethodEnum::toName(Enum enumValue) {
 ImageCaptureMethodEnum::Enum 
 ImageCaptureMethodEnum::fromName(const AString& name, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = ImageCaptureMethodEnum::enumData[0].enumValue;
@@ -201,7 +212,7 @@ ImageCaptureMethodEnum::fromName(const AString& name, bool* isValidOut)
  */
 AString 
 ImageCaptureMethodEnum::toGuiName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const ImageCaptureMethodEnum* enumInstance = findData(enumValue);
     return enumInstance->guiName;
@@ -220,7 +231,7 @@ ImageCaptureMethodEnum::toGuiName(Enum enumValue) {
 ImageCaptureMethodEnum::Enum 
 ImageCaptureMethodEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = ImageCaptureMethodEnum::enumData[0].enumValue;
@@ -254,7 +265,7 @@ ImageCaptureMethodEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 int32_t
 ImageCaptureMethodEnum::toIntegerCode(Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     const ImageCaptureMethodEnum* enumInstance = findData(enumValue);
     return enumInstance->integerCode;
 }
@@ -273,7 +284,7 @@ ImageCaptureMethodEnum::toIntegerCode(Enum enumValue)
 ImageCaptureMethodEnum::Enum
 ImageCaptureMethodEnum::fromIntegerCode(const int32_t integerCode, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = ImageCaptureMethodEnum::enumData[0].enumValue;
@@ -308,7 +319,7 @@ ImageCaptureMethodEnum::fromIntegerCode(const int32_t integerCode, bool* isValid
 void
 ImageCaptureMethodEnum::getAllEnums(std::vector<ImageCaptureMethodEnum::Enum>& allEnums)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allEnums.clear();
     
@@ -330,7 +341,7 @@ ImageCaptureMethodEnum::getAllEnums(std::vector<ImageCaptureMethodEnum::Enum>& a
 void
 ImageCaptureMethodEnum::getAllNames(std::vector<AString>& allNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allNames.clear();
     
@@ -356,7 +367,7 @@ ImageCaptureMethodEnum::getAllNames(std::vector<AString>& allNames, const bool i
 void
 ImageCaptureMethodEnum::getAllGuiNames(std::vector<AString>& allGuiNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allGuiNames.clear();
     
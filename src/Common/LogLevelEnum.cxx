@@ -24,9 +24,19 @@
 #undef __LOG_LEVEL_ENUM_DECLARE__
 
 #include "CaretAssert.h"
+#include "CaretMutex.h"
 
 using namespace caret;
 
+namespace
+{
+    CaretMutex& getInitializeMutex()
+    {//function-local, so it exists even if the enum is first used while initializing another static
+        static CaretMutex s_initializeMutex;
+        return s_initializeMutex;
+    }
+}
+
 /**
  * Constructor.
  *
@@ -67,10 +77,10 @@ LogLevelEnum::~LogLevelEnum()
 void
 LogLevelEnum::initialize()
 {
+    CaretMutexLocker locker(&getInitializeMutex());//always lock, an unlocked check of the flag could see it set before the data it guards
     if (initializedFlag) {
         return;
     }
-    initializedFlag = true;
 
     enumData.push_back(LogLevelEnum(SEVERE, 
                                     800, 
@@ -126,6 +136,7 @@ LogLevelEnum::initialize()
                                     "Off",
                                     "Off"));//also shouldn't get used in messages
     
+    initializedFlag = true;
 }
 
 /**
@@ -138,7 +149,7 @@ LogLevelEnum::initialize()
 const LogLevelEnum*
 LogLevelEnum::findData(const Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
 
     size_t num = enumData.size();
     for (size_t i = 0; i < num; i++) {
@@ -160,7 +171,7 @@ LogLevelEnum::findData(const Enum enumValue)
  */
 AString 
 LogLevelEnum::toName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const LogLevelEnum* enumInstance = findData(enumValue);
     return enumInstance->name;
@@ -179,7 +190,7 @@ LogLevelEnum::toName(Enum enumValue) {
 LogLevelEnum::Enum 
 LogLevelEnum::fromName(const AString& name, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = OFF;
@@ -213,7 +224,7 @@ LogLevelEnum::fromName(const AString& name, bool* isValidOut)
  */
 AString 
 LogLevelEnum::toGuiName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const LogLevelEnum* enumInstance = findData(enumValue);
     return enumInstance->guiName;
@@ -232,7 +243,7 @@ LogLevelEnum::toGuiName(Enum enumValue) {
 LogLevelEnum::Enum 
 LogLevelEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = OFF;
@@ -259,7 +270,7 @@ LogLevelEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 
 AString LogLevelEnum::toHintedName(LogLevelEnum::Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     const LogLevelEnum* enumInstance = findData(enumValue);
     CaretAssert(enumInstance != NULL);
     return enumInstance->hintedName;
@@ -267,7 +278,7 @@ AString LogLevelEnum::toHintedName(LogLevelEnum::Enum enumValue)
 
 LogLevelEnum::Enum LogLevelEnum::fromHintedName(const AString& hintedName, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     bool validFlag = false;
     Enum enumValue = OFF;
     for (std::vector<LogLevelEnum>::iterator iter = enumData.begin();
@@ -298,7 +309,7 @@ LogLevelEnum::Enum LogLevelEnum::fromHintedName(const AString& hintedName, bool*
 int32_t
 LogLevelEnum::toIntegerCode(Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     const LogLevelEnum* enumInstance = findData(enumValue);
     return enumInstance->integerCode;
 }
@@ -317,7 +328,7 @@ LogLevelEnum::toIntegerCode(Enum enumValue)
 LogLevelEnum::Enum
 LogLevelEnum::fromIntegerCode(const int32_t integerCode, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = OFF;
@@ -352,7 +363,7 @@ LogLevelEnum::fromIntegerCode(const int32_t integerCode, bool* isValidOut)
 void
 LogLevelEnum::getAllEnums(std::vector<LogLevelEnum::Enum>& allEnums)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allEnums.clear();
     
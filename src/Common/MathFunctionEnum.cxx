@@ -24,9 +24,19 @@
 #undef __MATH_FUNCTION_ENUM_DECLARE__
 
 #include "CaretAssert.h"
+#include "CaretMutex.h"
 
 using namespace caret;
 
+namespace
+{
+    CaretMutex& getInitializeMutex()
+    {//function-local, so it exists even if the enum is first used while initializing another static
+        static CaretMutex s_initializeMutex;
+        return s_initializeMutex;
+    }
+}
+
 /**
  * Constructor.
  *
@@ -62,10 +72,10 @@ MathFunctionEnum::~MathFunctionEnum()
 void
 MathFunctionEnum::initialize()
 {
+    CaretMutexLocker locker(&getInitializeMutex());//always lock, an unlocked check of the flag could see it set before the data it guards
     if (initializedFlag) {
         return;
     }
-    initializedFlag = true;
 
     //enumData.push_back(MathFunctionEnum(INVALID, "INVALID"));//should this be in the data? I don't think it should, it is a placeholder for "no matching enum value"
     enumData.push_back(MathFunctionEnum(SIN, "sin", "1 argument, the sine of the argument (units are radians)"));
@@ -93,6 +103,8 @@ MathFunctionEnum::initialize()
     enumData.push_back(MathFunctionEnum(MAX, "max", "2 arguments, max(x, y) returns y if (x < y), x otherwise"));
     enumData.push_back(MathFunctionEnum(MOD, "mod", "2 arguments, mod(x, y) = x - y * floor(x / y), or 0 if y == 0"));
     enumData.push_back(MathFunctionEnum(CLAMP, "clamp", "3 arguments, clamp(x, low, high) = min(max(x, low), high)"));
+    
+    initializedFlag = true;
 }
 
 /**
@@ -105,7 +117,7 @@ MathFunctionEnum::initialize()
 const MathFunctionEnum*
 MathFunctionEnum::findData(const Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
 
     size_t num = enumData.size();
     for (size_t i = 0; i < num; i++) {
@@ -127,7 +139,7 @@ MathFunctionEnum::findData(const Enum enumValue)
  */
 AString 
 MathFunctionEnum::toName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const MathFunctionEnum* enumInstance = findData(enumValue);
     if (enumInstance == NULL) return "";
@@ -143,7 +155,7 @@ MathFunctionEnum::toName(Enum enumValue) {
  */
 AString 
 MathFunctionEnum::toExplanation(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const MathFunctionEnum* enumInstance = findData(enumValue);
     if (enumInstance == NULL) return "";
@@ -163,7 +175,7 @@ MathFunctionEnum::toExplanation(Enum enumValue) {
 MathFunctionEnum::Enum 
 MathFunctionEnum::fromName(const AString& name, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = INVALID;
@@ -199,7 +211,7 @@ MathFunctionEnum::fromName(const AString& name, bool* isValidOut)
 void
 MathFunctionEnum::getAllEnums(std::vector<MathFunctionEnum::Enum>& allEnums)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allEnums.clear();
     
@@ -25,9 +25,19 @@
 #undef __OPEN_G_L_DRAWING_METHOD_ENUM_DECLARE__
 
 #include "CaretAssert.h"
+#include "CaretMutex.h"
 
 using namespace caret;
 
+namespace
+{
+    CaretMutex& getInitializeMutex()
+    {//function-local, so it exists even if the enum is first used while initializing another static
+        static CaretMutex s_initializeMutex;
+        return s_initializeMutex;
+    }
+}
+
     
 /**
  * \class caret::OpenGLDrawingMethodEnum 
@@ -103,10 +113,10 @@ OpenGLDrawingMethodEnum::~OpenGLDrawingMethodEnum()
 void
 OpenGLDrawingMethodEnum::initialize()
 {
+    CaretMutexLocker locker(&getInitializeMutex());//always lock, an unlocked check of the flag could see it set before the data it guards
     if (initializedFlag) {
         return;
     }
-    initializedFlag = true;
 
     enumData.push_back(OpenGLDrawingMethodEnum(DRAW_WITH_VERTEX_BUFFERS_OFF, 
                                     "DRAW_WITH_VERTEX_BUFFERS_OFF", 
@@ -116,6 +126,7 @@ OpenGLDrawingMethodEnum::initialize()
                                     "DRAW_WITH_VERTEX_BUFFERS_ON", 
                                     "On"));
     
+    initializedFlag = true;
 }
 
 /**
@@ -128,7 +139,7 @@ OpenGLDrawingMethodEnum::initialize()
 const OpenGLDrawingMethodEnum*
 OpenGLDrawingMethodEnum::findData(const Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
 
     size_t num = enumData.size();
     for (size_t i = 0; i < num; i++) {
@@ -150,7 +161,7 @@ OpenGLDrawingMethodEnum::findData(const Enum enumValue)
  */
 AString 
 OpenGLDrawingMethodEnum::toName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const OpenGLDrawingMethodEnum* enumInstance = findData(enumValue);
     return enumInstance->name;
@@ -169,7 +180,7 @@ OpenGLDrawingMethodEnum::toName(Enum enumValue) {
 OpenGLDrawingMethodEnum::Enum 
 OpenGLDrawingMethodEnum::fromName(const AString& name, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = OpenGLDrawingMethodEnum::enumData[0].enumValue;
@@ -203,7 +214,7 @@ OpenGLDrawingMethodEnum::fromName(const AString& name, bool* isValidOut)
  */
 AString 
 OpenGLDrawingMethodEnum::toGuiName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const OpenGLDrawingMethodEnum* enumInstance = findData(enumValue);
     return enumInstance->guiName;
@@ -222,7 +233,7 @@ OpenGLDrawingMethodEnum::toGuiName(Enum enumValue) {
 OpenGLDrawingMethodEnum::Enum 
 OpenGLDrawingMethodEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = OpenGLDrawingMethodEnum::enumData[0].enumValue;
@@ -256,7 +267,7 @@ OpenGLDrawingMethodEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 int32_t
 OpenGLDrawingMethodEnum::toIntegerCode(Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     const OpenGLDrawingMethodEnum* enumInstance = findData(enumValue);
     return enumInstance->integerCode;
 }
@@ -275,7 +286,7 @@ OpenGLDrawingMethodEnum::toIntegerCode(Enum enumValue)
 OpenGLDrawingMethodEnum::Enum
 OpenGLDrawingMethodEnum::fromIntegerCode(const int32_t integerCode, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = OpenGLDrawingMethodEnum::enumData[0].enumValue;
@@ -310,7 +321,7 @@ OpenGLDrawingMethodEnum::fromIntegerCode(const int32_t integerCode, bool* isVali
 void
 OpenGLDrawingMethodEnum::getAllEnums(std::vector<OpenGLDrawingMethodEnum::Enum>& allEnums)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allEnums.clear();
     
@@ -332,7 +343,7 @@ OpenGLDrawingMethodEnum::getAllEnums(std::vector<OpenGLDrawingMethodEnum::Enum>&
 void
 OpenGLDrawingMethodEnum::getAllNames(std::vector<AString>& allNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allNames.clear();
     
@@ -358,7 +369,7 @@ OpenGLDrawingMethodEnum::getAllNames(std::vector<AString>& allNames, const bool
 void
 OpenGLDrawingMethodEnum::getAllGuiNames(std::vector<AString>& allGuiNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allGuiNames.clear();
     
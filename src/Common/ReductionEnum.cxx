@@ -22,8 +22,18 @@
 #include "ReductionEnum.h"
 
 #include "CaretAssert.h"
+#include "CaretMutex.h"
 
 using namespace caret;
+
+namespace
+{
+    CaretMutex& getInitializeMutex()
+    {//function-local, so it exists even if the enum is first used while initializing another static
+        static CaretMutex s_initializeMutex;
+        return s_initializeMutex;
+    }
+}
 using namespace std;
 
 vector<ReductionEnum> ReductionEnum::enumData;
@@ -64,10 +74,10 @@ ReductionEnum::~ReductionEnum()
 void
 ReductionEnum::initialize()
 {
+    CaretMutexLocker locker(&getInitializeMutex());//always lock, an unlocked check of the flag could see it set before the data it guards
     if (initializedFlag) {
         return;
     }
-    initializedFlag = true;
 
     enumData.push_back(ReductionEnum(MAX, "MAX", "the maximum value"));
     enumData.push_back(ReductionEnum(MIN, "MIN", "the minimum value"));
@@ -81,6 +91,8 @@ ReductionEnum::initialize()
     enumData.push_back(ReductionEnum(MEDIAN, "MEDIAN", "the median of the data"));
     enumData.push_back(ReductionEnum(MODE, "MODE", "the mode of the data"));
     enumData.push_back(ReductionEnum(COUNT_NONZERO, "COUNT_NONZERO", "the number of nonzero elements in the data"));
+    
+    initializedFlag = true;
 }
 
 /**
@@ -93,7 +105,7 @@ ReductionEnum::initialize()
 const ReductionEnum*
 ReductionEnum::findData(const Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
 
     size_t num = enumData.size();
     for (size_t i = 0; i < num; i++) {
@@ -115,7 +127,7 @@ ReductionEnum::findData(const Enum enumValue)
  */
 AString 
 ReductionEnum::toName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const ReductionEnum* enumInstance = findData(enumValue);
     if (enumInstance == NULL) return "";
@@ -131,7 +143,7 @@ ReductionEnum::toName(Enum enumValue) {
  */
 AString 
 ReductionEnum::toExplanation(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const ReductionEnum* enumInstance = findData(enumValue);
     if (enumInstance == NULL) return "";
@@ -151,7 +163,7 @@ ReductionEnum::toExplanation(Enum enumValue) {
 ReductionEnum::Enum 
 ReductionEnum::fromName(const AString& name, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = INVALID;
@@ -187,7 +199,7 @@ ReductionEnum::fromName(const AString& name, bool* isValidOut)
 void
 ReductionEnum::getAllEnums(std::vector<ReductionEnum::Enum>& allEnums)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allEnums.clear();
     
@@ -25,9 +25,19 @@
 #undef __SPEC_FILE_DIALOG_VIEW_FILES_TYPE_ENUM_DECLARE__
 
 #include "CaretAssert.h"
+#include "CaretMutex.h"
 
 using namespace caret;
 
+namespace
+{
+    CaretMutex& getInitializeMutex()
+    {//function-local, so it exists even if the enum is first used while initializing another static
+        static CaretMutex s_initializeMutex;
+        return s_initializeMutex;
+    }
+}
+
     
 /**
  * \class caret::SpecFileDialogViewFilesTypeEnum 
@@ -101,10 +111,10 @@ SpecFileDialogViewFilesTypeEnum::~SpecFileDialogViewFilesTypeEnum()
 void
 SpecFileDialogViewFilesTypeEnum::initialize()
 {
+    CaretMutexLocker locker(&getInitializeMutex());//always lock, an unlocked check of the flag could see it set before the data it guards
     if (initializedFlag) {
         return;
     }
-    initializedFlag = true;
 
     enumData.push_back(SpecFileDialogViewFilesTypeEnum(VIEW_FILES_ALL, 
                                     "VIEW_FILES_ALL", 
@@ -126,6 +136,7 @@ SpecFileDialogViewFilesTypeEnum::initialize()
                                     "VIEW_FILES_NOT_LOADED", 
                                     "Not Loaded"));
     
+    initializedFlag = true;
 }
 
 /**
@@ -138,7 +149,7 @@ SpecFileDialogViewFilesTypeEnum::initialize()
 const SpecFileDialogViewFilesTypeEnum*
 SpecFileDialogViewFilesTypeEnum::findData(const Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
 
     size_t num = enumData.size();
     for (size_t i = 0; i < num; i++) {
@@ -160,7 +171,7 @@ SpecFileDialogViewFilesTypeEnum::findData(const Enum enumValue)
  */
 AString 
 SpecFileDialogViewFilesTypeEnum::toName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const SpecFileDialogViewFilesTypeEnum* enumInstance = findData(enumValue);
     return enumInstance->name;
@@ -179,7 +190,7 @@ SpecFileDialogViewFilesTypeEnum::toName(Enum enumValue) {
 SpecFileDialogViewFilesTypeEnum::Enum 
 SpecFileDialogViewFilesTypeEnum::fromName(const AString& name, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = SpecFileDialogViewFilesTypeEnum::enumData[0].enumValue;
@@ -213,7 +224,7 @@ SpecFileDialogViewFilesTypeEnum::fromName(const AString& name, bool* isValidOut)
  */
 AString 
 SpecFileDialogViewFilesTypeEnum::toGuiName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const SpecFileDialogViewFilesTypeEnum* enumInstance = findData(enumValue);
     return enumInstance->guiName;
@@ -232,7 +243,7 @@ SpecFileDialogViewFilesTypeEnum::toGuiName(Enum enumValue) {
 SpecFileDialogViewFilesTypeEnum::Enum 
 SpecFileDialogViewFilesTypeEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = SpecFileDialogViewFilesTypeEnum::enumData[0].enumValue;
@@ -266,7 +277,7 @@ SpecFileDialogViewFilesTypeEnum::fromGuiName(const AString& guiName, bool* isVal
 int32_t
 SpecFileDialogViewFilesTypeEnum::toIntegerCode(Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     const SpecFileDialogViewFilesTypeEnum* enumInstance = findData(enumValue);
     return enumInstance->integerCode;
 }
@@ -285,7 +296,7 @@ SpecFileDialogViewFilesTypeEnum::toIntegerCode(Enum enumValue)
 SpecFileDialogViewFilesTypeEnum::Enum
 SpecFileDialogViewFilesTypeEnum::fromIntegerCode(const int32_t integerCode, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = SpecFileDialogViewFilesTypeEnum::enumData[0].enumValue;
@@ -320,7 +331,7 @@ SpecFileDialogViewFilesTypeEnum::fromIntegerCode(const int32_t integerCode, bool
 void
 SpecFileDialogViewFilesTypeEnum::getAllEnums(std::vector<SpecFileDialogViewFilesTypeEnum::Enum>& allEnums)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allEnums.clear();
     
@@ -342,7 +353,7 @@ SpecFileDialogViewFilesTypeEnum::getAllEnums(std::vector<SpecFileDialogViewFiles
 void
 SpecFileDialogViewFilesTypeEnum::getAllNames(std::vector<AString>& allNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allNames.clear();
     
@@ -368,7 +379,7 @@ SpecFileDialogViewFilesTypeEnum::getAllNames(std::vector<AString>& allNames, con
 void
 SpecFileDialogViewFilesTypeEnum::getAllGuiNames(std::vector<AString>& allGuiNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allGuiNames.clear();
     
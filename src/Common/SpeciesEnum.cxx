@@ -25,9 +25,19 @@
 #undef __SPECIES_ENUM_DECLARE__
 
 #include "CaretAssert.h"
+#include "CaretMutex.h"
 
 using namespace caret;
 
+namespace
+{
+    CaretMutex& getInitializeMutex()
+    {//function-local, so it exists even if the enum is first used while initializing another static
+        static CaretMutex s_initializeMutex;
+        return s_initializeMutex;
+    }
+}
+
 /**
  * Constructor.
  *
@@ -66,10 +76,10 @@ SpeciesEnum::~SpeciesEnum()
 void
 SpeciesEnum::initialize()
 {
+    CaretMutexLocker locker(&getInitializeMutex());//always lock, an unlocked check of the flag could see it set before the data it guards
     if (initializedFlag) {
         return;
     }
-    initializedFlag = true;
 
     enumData.push_back(SpeciesEnum(TYPE_UNKNOWN, 
                                     0, 
@@ -136,6 +146,7 @@ SpeciesEnum::initialize()
                                     "TYPE_OTHER", 
                                     "Other not specified"));
     
+    initializedFlag = true;
 }
 
 /**
@@ -148,7 +159,7 @@ SpeciesEnum::initialize()
 const SpeciesEnum*
 SpeciesEnum::findData(const Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
 
     size_t num = enumData.size();
     for (size_t i = 0; i < num; i++) {
@@ -170,7 +181,7 @@ SpeciesEnum::findData(const Enum enumValue)
  */
 AString 
 SpeciesEnum::toName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const SpeciesEnum* enumInstance = findData(enumValue);
     return enumInstance->name;
@@ -189,7 +200,7 @@ SpeciesEnum::toName(Enum enumValue) {
 SpeciesEnum::Enum 
 SpeciesEnum::fromName(const AString& name, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = TYPE_UNKNOWN;
@@ -223,7 +234,7 @@ SpeciesEnum::fromName(const AString& name, bool* isValidOut)
  */
 AString 
 SpeciesEnum::toGuiName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const SpeciesEnum* enumInstance = findData(enumValue);
     return enumInstance->guiName;
@@ -242,7 +253,7 @@ SpeciesEnum::toGuiName(Enum enumValue) {
 SpeciesEnum::Enum 
 SpeciesEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = TYPE_UNKNOWN;
@@ -276,7 +287,7 @@ SpeciesEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 int32_t
 SpeciesEnum::toIntegerCode(Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     const SpeciesEnum* enumInstance = findData(enumValue);
     return enumInstance->integerCode;
 }
@@ -295,7 +306,7 @@ SpeciesEnum::toIntegerCode(Enum enumValue)
 SpeciesEnum::Enum
 SpeciesEnum::fromIntegerCode(const int32_t integerCode, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = TYPE_UNKNOWN;
@@ -330,7 +341,7 @@ SpeciesEnum::fromIntegerCode(const int32_t integerCode, bool* isValidOut)
 void
 SpeciesEnum::getAllEnums(std::vector<SpeciesEnum::Enum>& allEnums)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allEnums.clear();
     
@@ -352,7 +363,7 @@ SpeciesEnum::getAllEnums(std::vector<SpeciesEnum::Enum>& allEnums)
 void
 SpeciesEnum::getAllNames(std::vector<AString>& allNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allNames.clear();
     
@@ -378,7 +389,7 @@ SpeciesEnum::getAllNames(std::vector<AString>& allNames, const bool isSorted)
 void
 SpeciesEnum::getAllGuiNames(std::vector<AString>& allGuiNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allGuiNames.clear();
     
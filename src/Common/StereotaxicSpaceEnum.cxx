@@ -26,9 +26,19 @@
 
 #include "CaretAssert.h"
 #include "CaretLogger.h"
+#include "CaretMutex.h"
 
 using namespace caret;
 
+namespace
+{
+    CaretMutex& getInitializeMutex()
+    {//function-local, so it exists even if the enum is first used while initializing another static
+        static CaretMutex s_initializeMutex;
+        return s_initializeMutex;
+    }
+}
+
 /**
  * Constructor.
  *
@@ -137,10 +147,10 @@ StereotaxicSpaceEnum::toOrigin(const Enum enumValue,
 void
 StereotaxicSpaceEnum::initialize()
 {
+    CaretMutexLocker locker(&getInitializeMutex());//always lock, an unlocked check of the flag could see it set before the data it guards
     if (initializedFlag) {
         return;
     }
-    initializedFlag = true;
 
     enumData.push_back(StereotaxicSpaceEnum(SPACE_UNKNOWN, 
                                             "SPACE_UNKNOWN", 
@@ -370,6 +380,8 @@ StereotaxicSpaceEnum::initialize()
                                             48, 64, 48,
                                             3.0, 3.0, 3.0,
                                             -72.0, -106.5, -61.5));
+    
+    initializedFlag = true;
 }
 
 /**
@@ -382,7 +394,7 @@ StereotaxicSpaceEnum::initialize()
 const StereotaxicSpaceEnum*
 StereotaxicSpaceEnum::findData(const Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
 
     size_t num = enumData.size();
     for (size_t i = 0; i < num; i++) {
@@ -404,7 +416,7 @@ StereotaxicSpaceEnum::findData(const Enum enumValue)
  */
 AString 
 StereotaxicSpaceEnum::toName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const StereotaxicSpaceEnum* enumInstance = findData(enumValue);
     return enumInstance->name;
@@ -423,7 +435,7 @@ StereotaxicSpaceEnum::toName(Enum enumValue) {
 StereotaxicSpaceEnum::Enum 
 StereotaxicSpaceEnum::fromName(const AString& name, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = SPACE_UNKNOWN;
@@ -457,7 +469,7 @@ StereotaxicSpaceEnum::fromName(const AString& name, bool* isValidOut)
  */
 AString 
 StereotaxicSpaceEnum::toGuiName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const StereotaxicSpaceEnum* enumInstance = findData(enumValue);
     return enumInstance->guiName;
@@ -476,7 +488,7 @@ StereotaxicSpaceEnum::toGuiName(Enum enumValue) {
 StereotaxicSpaceEnum::Enum 
 StereotaxicSpaceEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = SPACE_UNKNOWN;
@@ -510,7 +522,7 @@ StereotaxicSpaceEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 int32_t
 StereotaxicSpaceEnum::toIntegerCode(Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     const StereotaxicSpaceEnum* enumInstance = findData(enumValue);
     return enumInstance->integerCode;
 }
@@ -529,7 +541,7 @@ StereotaxicSpaceEnum::toIntegerCode(Enum enumValue)
 StereotaxicSpaceEnum::Enum
 StereotaxicSpaceEnum::fromIntegerCode(const int32_t integerCode, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = SPACE_UNKNOWN;
@@ -564,7 +576,7 @@ StereotaxicSpaceEnum::fromIntegerCode(const int32_t integerCode, bool* isValidOu
 void
 StereotaxicSpaceEnum::getAllEnums(std::vector<StereotaxicSpaceEnum::Enum>& allEnums)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allEnums.clear();
     
@@ -586,7 +598,7 @@ StereotaxicSpaceEnum::getAllEnums(std::vector<StereotaxicSpaceEnum::Enum>& allEn
 void
 StereotaxicSpaceEnum::getAllNames(std::vector<AString>& allNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allNames.clear();
     
@@ -612,7 +624,7 @@ StereotaxicSpaceEnum::getAllNames(std::vector<AString>& allNames, const bool isS
 void
 StereotaxicSpaceEnum::getAllGuiNames(std::vector<AString>& allGuiNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allGuiNames.clear();
     
@@ -24,9 +24,19 @@
 #undef __STRUCTURE_ENUM_DECLARE__
 
 #include "CaretAssert.h"
+#include "CaretMutex.h"
 
 using namespace caret;
 
+namespace
+{
+    CaretMutex& getInitializeMutex()
+    {//function-local, so it exists even if the enum is first used while initializing another static
+        static CaretMutex s_initializeMutex;
+        return s_initializeMutex;
+    }
+}
+
 /**
  * Constructor.
  *
@@ -64,10 +74,10 @@ StructureEnum::~StructureEnum()
 void
 StructureEnum::initialize()
 {
+    CaretMutexLocker locker(&getInitializeMutex());//always lock, an unlocked check of the flag could see it set before the data it guards
     if (initializedFlag) {
         return;
     }
-    initializedFlag = true;
 
     enumData.push_back(StructureEnum(CORTEX_LEFT,
                                      "CORTEX_LEFT",
@@ -212,6 +222,8 @@ StructureEnum::initialize()
     enumData.push_back(StructureEnum(THALAMUS_RIGHT, 
                                      "THALAMUS_RIGHT", 
                                      "ThalamusRight"));
+    
+    initializedFlag = true;
 }
 
 /**
@@ -224,7 +236,7 @@ StructureEnum::initialize()
 const StructureEnum*
 StructureEnum::findData(const Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
 
     size_t num = enumData.size();
     for (size_t i = 0; i < num; i++) {
@@ -246,7 +258,7 @@ StructureEnum::findData(const Enum enumValue)
  */
 AString 
 StructureEnum::toName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const StructureEnum* enumInstance = findData(enumValue);
     return enumInstance->name;
@@ -265,7 +277,7 @@ StructureEnum::toName(Enum enumValue) {
 StructureEnum::Enum 
 StructureEnum::fromName(const AString& name, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = INVALID;
@@ -299,7 +311,7 @@ StructureEnum::fromName(const AString& name, bool* isValidOut)
  */
 AString 
 StructureEnum::toGuiName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const StructureEnum* enumInstance = findData(enumValue);
     return enumInstance->guiName;
@@ -318,7 +330,7 @@ StructureEnum::toGuiName(Enum enumValue) {
 StructureEnum::Enum 
 StructureEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = INVALID;
@@ -352,7 +364,7 @@ StructureEnum::fromGuiName(const AString& guiName, bool* isValidOut)
  */
 AString
 StructureEnum::toCiftiName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
 
     const StructureEnum* enumInstance = findData(enumValue);
     return "CIFTI_STRUCTURE_" + enumInstance->name;
@@ -371,7 +383,7 @@ StructureEnum::toCiftiName(Enum enumValue) {
 StructureEnum::Enum
 StructureEnum::fromCiftiName(const AString& ciftiName, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
 
     bool validFlag = false;
     Enum enumValue = INVALID;
@@ -408,7 +420,7 @@ StructureEnum::fromCiftiName(const AString& ciftiName, bool* isValidOut)
 int32_t
 StructureEnum::toIntegerCode(Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     const StructureEnum* enumInstance = findData(enumValue);
     return enumInstance->integerCode;
 }
@@ -427,7 +439,7 @@ StructureEnum::toIntegerCode(Enum enumValue)
 StructureEnum::Enum
 StructureEnum::fromIntegerCode(const int32_t integerCode, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = INVALID;
@@ -463,7 +475,7 @@ StructureEnum::fromIntegerCode(const int32_t integerCode, bool* isValidOut)
 void
 StructureEnum::getAllEnums(std::vector<StructureEnum::Enum>& allEnums)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allEnums.clear();
     
@@ -25,9 +25,19 @@
 #undef __YOKING_GROUP_ENUM_DECLARE__
 
 #include "CaretAssert.h"
+#include "CaretMutex.h"
 
 using namespace caret;
 
+namespace
+{
+    CaretMutex& getInitializeMutex()
+    {//function-local, so it exists even if the enum is first used while initializing another static
+        static CaretMutex s_initializeMutex;
+        return s_initializeMutex;
+    }
+}
+
     
 /**
  * \class caret::YokingGroupEnum 
@@ -68,10 +78,10 @@ YokingGroupEnum::~YokingGroupEnum()
 void
 YokingGroupEnum::initialize()
 {
+    CaretMutexLocker locker(&getInitializeMutex());//always lock, an unlocked check of the flag could see it set before the data it guards
     if (initializedFlag) {
         return;
     }
-    initializedFlag = true;
 
     enumData.push_back(YokingGroupEnum(YOKING_GROUP_OFF, 
                                     "YOKING_GROUP_OFF", 
@@ -109,6 +119,7 @@ YokingGroupEnum::initialize()
                                        "YOKING_GROUP_H",
                                        "Group H"));
     
+    initializedFlag = true;
 }
 
 /**
@@ -121,7 +132,7 @@ YokingGroupEnum::initialize()
 const YokingGroupEnum*
 YokingGroupEnum::findData(const Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
 
     size_t num = enumData.size();
     for (size_t i = 0; i < num; i++) {
@@ -143,7 +154,7 @@ YokingGroupEnum::findData(const Enum enumValue)
  */
 AString 
 YokingGroupEnum::toName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const YokingGroupEnum* enumInstance = findData(enumValue);
     return enumInstance->name;
@@ -162,7 +173,7 @@ YokingGroupEnum::toName(Enum enumValue) {
 YokingGroupEnum::Enum 
 YokingGroupEnum::fromName(const AString& name, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = YOKING_GROUP_OFF;
@@ -196,7 +207,7 @@ YokingGroupEnum::fromName(const AString& name, bool* isValidOut)
  */
 AString 
 YokingGroupEnum::toGuiName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const YokingGroupEnum* enumInstance = findData(enumValue);
     return enumInstance->guiName;
@@ -215,7 +226,7 @@ YokingGroupEnum::toGuiName(Enum enumValue) {
 YokingGroupEnum::Enum 
 YokingGroupEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = YOKING_GROUP_OFF;
@@ -249,7 +260,7 @@ YokingGroupEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 int32_t
 YokingGroupEnum::toIntegerCode(Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     const YokingGroupEnum* enumInstance = findData(enumValue);
     return enumInstance->integerCode;
 }
@@ -268,7 +279,7 @@ YokingGroupEnum::toIntegerCode(Enum enumValue)
 YokingGroupEnum::Enum
 YokingGroupEnum::fromIntegerCode(const int32_t integerCode, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = YOKING_GROUP_OFF;
@@ -303,7 +314,7 @@ YokingGroupEnum::fromIntegerCode(const int32_t integerCode, bool* isValidOut)
 void
 YokingGroupEnum::getAllEnums(std::vector<YokingGroupEnum::Enum>& allEnums)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allEnums.clear();
     
@@ -325,7 +336,7 @@ YokingGroupEnum::getAllEnums(std::vector<YokingGroupEnum::Enum>& allEnums)
 void
 YokingGroupEnum::getAllNames(std::vector<AString>& allNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allNames.clear();
     
@@ -351,7 +362,7 @@ YokingGroupEnum::getAllNames(std::vector<AString>& allNames, const bool isSorted
 void
 YokingGroupEnum::getAllGuiNames(std::vector<AString>& allGuiNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allGuiNames.clear();
     
@@ -58,6 +58,7 @@ Border::Border()
 : CaretObjectTracksModification()
 {
     m_copyOfBorderPriorToLastEditing = NULL;
+    m_positionModificationNumber = SurfaceProjectedItem::newModificationNumber();
     clear();
 //    m_color = CaretColorEnum::BLACK;
 //    m_selectionClassNameModificationStatus = true; // name/class is new!!
@@ -118,6 +119,7 @@ Border::Border(const Border& obj)
 : CaretObjectTracksModification(obj)
 {
     m_copyOfBorderPriorToLastEditing = NULL;
+    m_positionModificationNumber = SurfaceProjectedItem::newModificationNumber();
     copyHelperBorder(obj);
 }
 
@@ -384,6 +386,7 @@ Border::removeAllPoints()
         delete m_points[i];
     }
     m_points.clear();
+    m_positionModificationNumber = SurfaceProjectedItem::newModificationNumber();
     
     setModified();
 }
@@ -564,6 +567,7 @@ Border::addPoint(SurfaceProjectedItem* point)
         }
     }
     m_points.push_back(point);
+    m_positionModificationNumber = SurfaceProjectedItem::newModificationNumber();
     setModified();
 }
 
@@ -708,6 +712,7 @@ Border::removePoint(const int32_t indx)
     CaretAssertVectorIndex(m_points, indx);
     delete m_points[indx];
     m_points.erase(m_points.begin() + indx);
+    m_positionModificationNumber = SurfaceProjectedItem::newModificationNumber();
     setModified();
 }
 
@@ -743,6 +748,7 @@ Border::reverse()
 {
     std::reverse(m_points.begin(),
                  m_points.end());
+    m_positionModificationNumber = SurfaceProjectedItem::newModificationNumber();
     setModified();
 }
 
@@ -1585,6 +1591,24 @@ Border::undoLastBorderEditing()
     }
 }
 
+/**
+ * @return Number that changes whenever points are added to, removed from,
+ * or reordered in this border, or any of its points are modified
+ * (including a change of structure).  Positions of the border's points
+ * that are cached for a surface remain valid while this number is unchanged.
+ */
+int64_t
+Border::getPositionModificationNumber() const
+{
+    int64_t modificationNumber = m_positionModificationNumber;
+    const int32_t numPoints = getNumberOfPoints();
+    for (int32_t i = 0; i < numPoints; i++) {
+        modificationNumber = std::max(modificationNumber,
+                                      m_points[i]->getModificationNumber());
+    }
+    return modificationNumber;
+}
+
 /**
  * Get a description of this object's content.
  * @return String describing this object's content.
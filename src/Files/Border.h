@@ -155,6 +155,8 @@ namespace caret {
         
         void undoLastBorderEditing();
         
+        int64_t getPositionModificationNumber() const;
+        
         static const AString XML_TAG_BORDER;
         static const AString XML_TAG_NAME;
         static const AString XML_TAG_CLASS_NAME;
@@ -176,6 +178,9 @@ namespace caret {
         
         std::vector<SurfaceProjectedItem*> m_points;
         
+        /** Changes whenever points are added, removed, or reordered, the points track their own changes */
+        int64_t m_positionModificationNumber;
+        
         bool m_closed;
         
         /** RGBA color component assigned to border's class name */
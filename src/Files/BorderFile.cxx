@@ -50,6 +50,7 @@
 #include "MathFunctions.h"
 #include "SurfaceFile.h"
 #include "SurfaceProjectedItem.h"
+#include "SurfaceProjectedItemLocator.h"
 #include "SurfaceProjectionBarycentric.h"
 #include "TextFile.h"
 #include "XmlAttributes.h"
@@ -386,6 +387,7 @@ BorderFile::setStructure(const StructureEnum::Enum structure)
         }
     }
     m_structure = structure;
+    m_borderPointLocators.clear();
     setModified();
 }
 
@@ -427,6 +429,7 @@ BorderFile::clear()
     m_numNodes = -1;
     m_borderMDKeys.clear();
     m_borderMDValues.clear();
+    m_borderPointLocators.clear();
 }
 
 int32_t BorderFile::getNumberOfNodes() const
@@ -556,6 +559,35 @@ BorderFile::getBorder(const int32_t indx) const
     return m_borders[indx];
 }
 
+/**
+ * Reduce matches from a border point search, sorted by border, to
+ * the nearest point of each border.
+ *
+ * @param matches
+ *    Matches from the search.
+ * @param nearestOut
+ *    Output with nearest point of each border, sorted by border.
+ */
+static void
+nearestMatchOfEachBorder(const std::vector<SurfaceProjectedItemLocator::Match>& matches,
+                         std::vector<SurfaceProjectedItemLocator::Match>& nearestOut)
+{
+    nearestOut.clear();
+    const int32_t numMatches = static_cast<int32_t>(matches.size());
+    for (int32_t i = 0; i < numMatches; i++) {
+        const SurfaceProjectedItemLocator::Match& match = matches[i];
+        if (( ! nearestOut.empty())
+            && (nearestOut.back().m_ownerIndex == match.m_ownerIndex)) {
+            if (match.m_distance < nearestOut.back().m_distance) {
+                nearestOut.back() = match;
+            }
+        }
+        else {
+            nearestOut.push_back(match);
+        }
+    }
+}
+
 /**
  * Find ALL borders that have one endpoint within the given distance
  * of the first point of the given border segment.
@@ -598,72 +630,50 @@ BorderFile::findAllBordersWithEndPointNearSegmentFirstPoint(const DisplayGroupEn
         return;
     }
     
+    std::vector<SurfaceProjectedItemLocator::Match> matches;
+    getBorderPointLocator(surfaceFile,
+                          false)->findItemsWithinDistance(segFirstXYZ,
+                                                          maximumDistance,
+                                                          matches);
+    
+    /*
+     * Keep only the endpoints
+     */
+    std::vector<SurfaceProjectedItemLocator::Match> endPointMatches;
+    for (std::vector<SurfaceProjectedItemLocator::Match>::iterator iter = matches.begin();
+         iter != matches.end();
+         iter++) {
+        CaretAssertVectorIndex(m_borders, iter->m_ownerIndex);
+        const int32_t lastPointIndex = m_borders[iter->m_ownerIndex]->getNumberOfPoints() - 1;
+        if ((iter->m_itemIndex == 0)
+            || (iter->m_itemIndex == lastPointIndex)) {
+            endPointMatches.push_back(*iter);
+        }
+    }
+    std::vector<SurfaceProjectedItemLocator::Match> nearestMatches;
+    nearestMatchOfEachBorder(endPointMatches,
+                             nearestMatches);
+    
     BorderFile* nonConstBorderFile = const_cast<BorderFile*>(this);
     
-    const int32_t numBorders = getNumberOfBorders();
-    for (int32_t borderIndex = 0; borderIndex < numBorders; borderIndex++) {
+    for (std::vector<SurfaceProjectedItemLocator::Match>::iterator iter = nearestMatches.begin();
+         iter != nearestMatches.end();
+         iter++) {
+        const int32_t borderIndex = iter->m_ownerIndex;
         Border* border = m_borders[borderIndex];
         if (nonConstBorderFile->isBorderDisplayed(displayGroup,
                                                   browserTabIndex,
                                                   border) == false) {
             continue;
         }
-        if (border->getStructure() == surfaceFile->getStructure()) {
-            /*
-             * Test first endpoint
-             */
-            const int32_t numPoints = border->getNumberOfPoints();
-            float nearestPointDistanceSquared = -1.0;
-            int32_t neartestPointIndex = -1;
-            if (numPoints > 0) {
-                float pointXYZ[3];
-                if (border->getPoint(0)->getProjectedPosition(*surfaceFile,
-                                                              pointXYZ,
-                                                              false)) {
-                    nearestPointDistanceSquared = MathFunctions::distanceSquared3D(pointXYZ,
-                                                                            segFirstXYZ);
-                    neartestPointIndex = 0;
-                }
-            }
-            
-            /*
-             * Test last endpoint
-             */
-            if (numPoints > 1) {
-                const int32_t lastPointIndex = numPoints - 1;
-                float pointXYZ[3];
-                if (border->getPoint(lastPointIndex)->getProjectedPosition(*surfaceFile,
-                                                                           pointXYZ,
-                                                                           false)) {
-                    const float dist2 = MathFunctions::distanceSquared3D(pointXYZ,
-                                                                         segFirstXYZ);
-                    if (nearestPointDistanceSquared >= 0.0) {
-                        if (dist2 < nearestPointDistanceSquared) {
-                            neartestPointIndex   = lastPointIndex;
-                            nearestPointDistanceSquared = dist2;
-                        }
-                    }
-                    else {
-                        neartestPointIndex   = lastPointIndex;
-                        nearestPointDistanceSquared = dist2;
-                    }
-                }
-            }
-            
-            if (neartestPointIndex >= 0) {
-                const float nearestPointDistance = std::sqrt(nearestPointDistanceSquared);
-                if (nearestPointDistance <= maximumDistance) {
-                    BorderPointFromSearch bpo;
-                    bpo.setData(const_cast<BorderFile*>(this),
-                                border,
-                                borderIndex,
-                                neartestPointIndex,
-                                nearestPointDistance);
-                    borderPointsOut.push_back(bpo);
-                }
-            }
-        }
-    }    
+        BorderPointFromSearch bpo;
+        bpo.setData(nonConstBorderFile,
+                    border,
+                    borderIndex,
+                    iter->m_itemIndex,
+                    iter->m_distance);
+        borderPointsOut.push_back(bpo);
+    }
 }
 
 
@@ -709,51 +719,36 @@ BorderFile::findAllBordersWithAnyPointNearSegmentFirstPoint(const DisplayGroupEn
         return;
     }
     
+    std::vector<SurfaceProjectedItemLocator::Match> matches;
+    getBorderPointLocator(surfaceFile,
+                          false)->findItemsWithinDistance(segFirstXYZ,
+                                                          maximumDistance,
+                                                          matches);
+    std::vector<SurfaceProjectedItemLocator::Match> nearestMatches;
+    nearestMatchOfEachBorder(matches,
+                             nearestMatches);
+    
     BorderFile* nonConstBorderFile = const_cast<BorderFile*>(this);
     
-    const int32_t numBorders = getNumberOfBorders();
-    for (int32_t borderIndex = 0; borderIndex < numBorders; borderIndex++) {
+    for (std::vector<SurfaceProjectedItemLocator::Match>::iterator iter = nearestMatches.begin();
+         iter != nearestMatches.end();
+         iter++) {
+        const int32_t borderIndex = iter->m_ownerIndex;
+        CaretAssertVectorIndex(m_borders, borderIndex);
         Border* border = m_borders[borderIndex];
         if (nonConstBorderFile->isBorderDisplayed(displayGroup,
                                                   browserTabIndex,
                                                   border) == false) {
             continue;
         }
-        if (border->getStructure() == surfaceFile->getStructure()) {
-            /*
-             * Test all points
-             */
-            float nearestPointDistanceSquared = std::numeric_limits<float>::max();
-            int32_t nearestPointIndex = -1;
-            const int32_t numPoints = border->getNumberOfPoints();
-            for (int32_t pointIndex = 0; pointIndex < numPoints; pointIndex++) {
-                float pointXYZ[3];
-                if (border->getPoint(pointIndex)->getProjectedPosition(*surfaceFile,
-                                                              pointXYZ,
-                                                              false)) {
-                    const float distSQ = MathFunctions::distanceSquared3D(pointXYZ,
-                                                                          segFirstXYZ);
-                    if (distSQ < nearestPointDistanceSquared) {
-                        nearestPointDistanceSquared = distSQ;
-                        nearestPointIndex = pointIndex;
-                    }
-                }
-            }
-            
-            if (nearestPointIndex >= 0) {
-                const float nearestPointDistance = std::sqrt(nearestPointDistanceSquared);
-                if (nearestPointDistance <= maximumDistance) {
-                    BorderPointFromSearch bpo;
-                    bpo.setData(const_cast<BorderFile*>(this),
-                                border,
-                                borderIndex,
-                                nearestPointIndex,
-                                nearestPointDistance);
-                    borderPointsOut.push_back(bpo);
-                }
-            }
-        }
-    }    
+        BorderPointFromSearch bpo;
+        bpo.setData(nonConstBorderFile,
+                    border,
+                    borderIndex,
+                    iter->m_itemIndex,
+                    iter->m_distance);
+        borderPointsOut.push_back(bpo);
+    }
 }
 
 /**
@@ -801,44 +796,130 @@ BorderFile::findAllBordersWithPointsNearBothSegmentEndPoints(const DisplayGroupE
         return;
     }
     
+    /*
+     * Border points are unprojected onto the surface
+     * as in Border::findPointIndexNearestXYZ()
+     */
+    const SurfaceProjectedItemLocator* locator = getBorderPointLocator(surfaceFile,
+                                                                       true);
+    std::vector<SurfaceProjectedItemLocator::Match> matches;
+    std::vector<SurfaceProjectedItemLocator::Match> nearestFirst;
+    locator->findItemsWithinDistance(segFirstXYZ,
+                                     maximumDistance,
+                                     matches);
+    nearestMatchOfEachBorder(matches,
+                             nearestFirst);
+    std::vector<SurfaceProjectedItemLocator::Match> nearestLast;
+    locator->findItemsWithinDistance(segLastXYZ,
+                                     maximumDistance,
+                                     matches);
+    nearestMatchOfEachBorder(matches,
+                             nearestLast);
+    
     BorderFile* nonConstBorderFile = const_cast<BorderFile*>(this);
     
-    const int32_t numBorders = getNumberOfBorders();
-    for (int32_t borderIndex = 0; borderIndex < numBorders; borderIndex++) {
+    /*
+     * Both are sorted by border so step through them together
+     */
+    std::vector<SurfaceProjectedItemLocator::Match>::iterator lastIter = nearestLast.begin();
+    for (std::vector<SurfaceProjectedItemLocator::Match>::iterator firstIter = nearestFirst.begin();
+         firstIter != nearestFirst.end();
+         firstIter++) {
+        const int32_t borderIndex = firstIter->m_ownerIndex;
+        while ((lastIter != nearestLast.end())
+               && (lastIter->m_ownerIndex < borderIndex)) {
+            lastIter++;
+        }
+        if (lastIter == nearestLast.end()) {
+            break;
+        }
+        if (lastIter->m_ownerIndex != borderIndex) {
+            continue;
+        }
+        
+        CaretAssertVectorIndex(m_borders, borderIndex);
         Border* border = m_borders[borderIndex];
         if (nonConstBorderFile->isBorderDisplayed(displayGroup,
                                                   browserTabIndex,
                                                   border) == false) {
             continue;
         }
-        if (border->getStructure() == surfaceFile->getStructure()) {
-            /*
-             * Test first query point
-             */
-            float distance1 = 0.0;
-            const int32_t nearestIndex1 = border->findPointIndexNearestXYZ(surfaceFile,
-                                                                           segFirstXYZ,
-                                                                           maximumDistance,
-                                                                           distance1);
-            
-            float distance2 = 0.0;
-            const int32_t nearestIndex2 = border->findPointIndexNearestXYZ(surfaceFile,
-                                                                           segLastXYZ,
-                                                                           maximumDistance,
-                                                                           distance2);
-            if ((nearestIndex1 >= 0)
-                && (nearestIndex2 >= 0)) {
-                const float averageDistance = (distance1 + distance2) / 2.0;
-                BorderPointFromSearch bpo;
-                bpo.setData(const_cast<BorderFile*>(this),
-                            border,
-                            borderIndex,
-                            nearestIndex1,
-                            averageDistance);
-                borderPointsOut.push_back(bpo);
+        const float averageDistance = (firstIter->m_distance + lastIter->m_distance) / 2.0;
+        BorderPointFromSearch bpo;
+        bpo.setData(nonConstBorderFile,
+                    border,
+                    borderIndex,
+                    firstIter->m_itemIndex,
+                    averageDistance);
+        borderPointsOut.push_back(bpo);
+    }
+}
+
+/**
+ * Get the spatial index of the border points on a surface.  The
+ * index contains the points of the borders on the surface's structure
+ * and is created again after borders are added, removed, or edited,
+ * or after the surface's coordinates change.
+ *
+ * @param surfaceFile
+ *    Surface on which border points are unprojected.
+ * @param unprojectOntoSurfaceFlag
+ *    If true, points are unprojected directly onto the surface.
+ * @return
+ *    The spatial index.
+ */
+const SurfaceProjectedItemLocator*
+BorderFile::getBorderPointLocator(const SurfaceFile* surfaceFile,
+                                  const bool unprojectOntoSurfaceFlag) const
+{
+    CaretAssert(surfaceFile);
+    
+    const int32_t numBorders = getNumberOfBorders();
+    const std::pair<const SurfaceFile*, bool> key(surfaceFile,
+                                                  unprojectOntoSurfaceFlag);
+    std::map<std::pair<const SurfaceFile*, bool>, CaretPointer<SurfaceProjectedItemLocator> >::iterator iter = m_borderPointLocators.find(key);
+    if (iter != m_borderPointLocators.end()) {
+        const SurfaceProjectedItemLocator* locator = iter->second;
+        bool validFlag = (locator->isValidForSurface(surfaceFile)
+                          && (locator->getNumberOfOwners() == numBorders));
+        for (int32_t i = 0; (i < numBorders) && validFlag; i++) {
+            const Border* border = m_borders[i];
+            validFlag = locator->isOwnerUnchanged(i,
+                                                  border,
+                                                  border->getPositionModificationNumber());
+        }
+        if (validFlag) {
+            return locator;
+        }
+        m_borderPointLocators.erase(iter);
+    }
+    
+    /*
+     * Deleted surfaces are never searched again
+     * so limit the number of surfaces that are kept.
+     */
+    if (static_cast<int32_t>(m_borderPointLocators.size()) >= s_maximumNumberOfBorderPointLocators) {
+        m_borderPointLocators.clear();
+    }
+    
+    CaretPointer<SurfaceProjectedItemLocator> locator(new SurfaceProjectedItemLocator(surfaceFile,
+                                                                                     unprojectOntoSurfaceFlag));
+    const StructureEnum::Enum structure = surfaceFile->getStructure();
+    for (int32_t i = 0; i < numBorders; i++) {
+        const Border* border = m_borders[i];
+        locator->addOwner(border,
+                          border->getPositionModificationNumber());
+        if (border->getStructure() == structure) {
+            const int32_t numPoints = border->getNumberOfPoints();
+            for (int32_t j = 0; j < numPoints; j++) {
+                locator->addItem(border->getPoint(j),
+                                 j);
             }
         }
     }
+    m_borderPointLocators[key] = locator;
+    
+    return locator;
 }
 
 
@@ -41,6 +41,7 @@ namespace caret {
     class GiftiLabelTable;
     class SurfaceFile;
     class SurfaceProjectedItem;
+    class SurfaceProjectedItemLocator;
     
     class BorderFile : public CaretDataFile {
         
@@ -214,6 +215,9 @@ namespace caret {
         static std::vector<AString> parseBorderMDValues3(const AString& filename,
                                                          QXmlStreamReader& xml);
         
+        const SurfaceProjectedItemLocator* getBorderPointLocator(const SurfaceFile* surfaceFile,
+                                                                 const bool unprojectOntoSurfaceFlag) const;
+        
         GiftiMetaData* m_metadata;
         
         std::vector<Border*> m_borders;
@@ -238,6 +242,12 @@ namespace caret {
         
         std::map<std::pair<AString, AString>, std::vector<AString> > m_borderMDValues;//because each "Border" is really just a part of a border
         
+        /** Spatial index of border points for each surface and unprojection mode, created when searched */
+        mutable std::map<std::pair<const SurfaceFile*, bool>, CaretPointer<SurfaceProjectedItemLocator> > m_borderPointLocators;
+        
+        /** Maximum number of surfaces with a border point index */
+        static const int32_t s_maximumNumberOfBorderPointLocators;
+        
         /** Version of this BorderFile */
         static const int32_t s_borderFileVersion;
     };
@@ -257,6 +267,7 @@ namespace caret {
     const AString BorderFile::XML_TAG_CLASS_COLOR_TABLE = "BorderClassColorTable";
     
     const int32_t BorderFile::s_borderFileVersion = 2;
+    const int32_t BorderFile::s_maximumNumberOfBorderPointLocators = 8;
 #endif // __BORDER_FILE_DECLARE__
 
 } // namespace
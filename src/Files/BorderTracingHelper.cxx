@@ -22,6 +22,7 @@
 
 #include "Border.h"
 #include "BorderFile.h"
+#include "CaretOMP.h"
 #include "SurfaceProjectedItem.h"
 #include "SurfaceProjectionBarycentric.h"
 #include "SurfaceFile.h"
@@ -39,60 +40,137 @@ BorderTracingHelper::BorderTracingHelper(const SurfaceFile* surfIn)
 
 vector<CaretPointer<Border> > BorderTracingHelper::tracePrivate(vector<int>& marked, const float& placement)
 {
-    vector<CaretPointer<Border> > ret;
+    for (int i = 0; i < m_numNodes; ++i)
+    {
+        marked[i] = (marked[i] != 0 ? 0 : -1);//marked becomes region 0, everything else no region
+    }
+    vector<vector<CaretPointer<Border> > > regionBorders = traceRegions(marked, 1, placement);
+    return regionBorders[0];
+}
+
+void BorderTracingHelper::findBoundaryEdges(const vector<int>& regionOfNode, const int& numRegions, vector<int64_t>& regionStartOut, vector<BoundaryEdge>& edgesOut) const
+{
+    CaretAssert((int)regionOfNode.size() == m_numNodes);
+    const vector<TopologyEdgeInfo>& myEdgeInfo = m_topoHelp->getEdgeInfo();
+    vector<int64_t> nodeCount(m_numNodes, 0);
+#pragma omp CARET_PARFOR schedule(dynamic, 1024)
+    for (int i = 0; i < m_numNodes; ++i)
+    {//count first, so that the edges can be written in parallel into their final places
+        int myRegion = regionOfNode[i];
+        if (myRegion < 0) continue;
+        const vector<int32_t>& edges = m_topoHelp->getNodeEdges(i);
+        for (int j = 0; j < (int)edges.size(); ++j)
+        {
+            const TopologyEdgeInfo& thisEdge = myEdgeInfo[edges[j]];
+            int otherNode = (thisEdge.node2 == i ? thisEdge.node1 : thisEdge.node2);
+            if (regionOfNode[otherNode] != myRegion) ++nodeCount[i];
+        }
+    }
+    regionStartOut.assign(numRegions + 1, 0);
+    for (int i = 0; i < m_numNodes; ++i)
+    {
+        if (regionOfNode[i] < 0) continue;
+        CaretAssert(regionOfNode[i] < numRegions);
+        regionStartOut[regionOfNode[i] + 1] += nodeCount[i];
+    }
+    for (int r = 0; r < numRegions; ++r)
+    {
+        regionStartOut[r + 1] += regionStartOut[r];
+    }
+    vector<int64_t> nodeStart(m_numNodes, 0), regionCursor(regionStartOut.begin(), regionStartOut.end() - 1);
+    for (int i = 0; i < m_numNodes; ++i)
+    {//keep vertex order within each region, the tracing picks its starting edges by that order
+        if (regionOfNode[i] < 0) continue;
+        nodeStart[i] = regionCursor[regionOfNode[i]];
+        regionCursor[regionOfNode[i]] += nodeCount[i];
+    }
+    edgesOut.resize(regionStartOut[numRegions]);
+#pragma omp CARET_PARFOR schedule(dynamic, 1024)
+    for (int i = 0; i < m_numNodes; ++i)
+    {
+        int myRegion = regionOfNode[i];
+        if (myRegion < 0) continue;
+        int64_t cursor = nodeStart[i];
+        const vector<int32_t>& edges = m_topoHelp->getNodeEdges(i);
+        for (int j = 0; j < (int)edges.size(); ++j)
+        {
+            const TopologyEdgeInfo& thisEdge = myEdgeInfo[edges[j]];
+            int otherNode = (thisEdge.node2 == i ? thisEdge.node1 : thisEdge.node2);
+            if (regionOfNode[otherNode] != myRegion)
+            {
+                BoundaryEdge& thisBoundary = edgesOut[cursor];
+                thisBoundary.edge = edges[j];
+                thisBoundary.inNode = i;
+                thisBoundary.outNode = otherNode;
+                ++cursor;
+            }
+        }
+    }
+}
+
+vector<vector<CaretPointer<Border> > > BorderTracingHelper::traceRegions(const vector<int>& regionOfNode, const int& numRegions, const float& placement)
+{
+    CaretAssert(placement >= 0.0f && placement <= 1.0f);
+    vector<int64_t> regionStart;
+    vector<BoundaryEdge> boundaryEdges;
+    findBoundaryEdges(regionOfNode, numRegions, regionStart, boundaryEdges);
+    vector<char> sideUsed(m_topoHelp->getEdgeInfo().size() * 2, 0);//each side of an edge belongs to only one region, so regions can be traced at the same time
+    vector<vector<TracedPath> > regionPaths(numRegions);
+#pragma omp CARET_PARFOR schedule(dynamic)
+    for (int r = 0; r < numRegions; ++r)
+    {
+        if (regionStart[r + 1] == regionStart[r]) continue;
+        traceRegion(r, regionOfNode, boundaryEdges.data() + regionStart[r], regionStart[r + 1] - regionStart[r], sideUsed, regionPaths[r]);
+    }
+    vector<vector<CaretPointer<Border> > > ret(numRegions);
+    for (int r = 0; r < numRegions; ++r)
+    {//border objects are made serially
+        for (int i = 0; i < (int)regionPaths[r].size(); ++i)
+        {
+            ret[r].push_back(makeBorder(regionPaths[r][i], placement));
+        }
+    }
+    return ret;
+}
+
+void BorderTracingHelper::traceRegion(const int& region, const vector<int>& regionOfNode, const BoundaryEdge* candidates, const int64_t& numCandidates,
+                                      vector<char>& sideUsed, vector<TracedPath>& pathsOut) const
+{
     const vector<TopologyEdgeInfo>& myEdgeInfo = m_topoHelp->getEdgeInfo();
     const vector<TopologyTileInfo>& myTileInfo = m_topoHelp->getTileInfo();
-    vector<int> edgeUsed(myEdgeInfo.size(), 0);
-    float nodeWeights[3] = { 1.0f - placement, placement, 0.0f };
     while (true)
-    {
-        bool foundStart = false, closed = true;
-        int curInNode = -1, curEdge = -1, curOutNode = -1;
-        for (int i = 0; i < m_numNodes; ++i)
+    {//start from the first unused edge, unless there is an unused edge on the mesh boundary: then start from the first one on the last such vertex, so open borders are traced from an end
+        int64_t start = -1;
+        int openNode = -1;
+        for (int64_t c = 0; c < numCandidates; ++c)
         {
-            if (marked[i] != 0)
+            const BoundaryEdge& thisCand = candidates[c];
+            if (sideUsed[2 * thisCand.edge + (myEdgeInfo[thisCand.edge].node1 == thisCand.inNode ? 0 : 1)] != 0) continue;
+            if (myEdgeInfo[thisCand.edge].numTiles == 1)
             {
-                const vector<int32_t>& edges = m_topoHelp->getNodeEdges(i);
-                int numEdges = (int)edges.size();
-                for (int j = 0; j < numEdges; ++j)
+                if (thisCand.inNode != openNode)
                 {
-                    const TopologyEdgeInfo& thisEdge = myEdgeInfo[edges[j]];
-                    int testNode = (thisEdge.node2 == i ? thisEdge.node1 : thisEdge.node2);
-                    if (marked[testNode] == 0 && edgeUsed[edges[j]] == 0)
-                    {
-                        if (!foundStart || thisEdge.numTiles == 1)
-                        {
-                            foundStart = true;
-                            curInNode = i;
-                            curEdge = edges[j];
-                            curOutNode = testNode;
-                            if (thisEdge.numTiles == 1)
-                            {
-                                closed = false;
-                                break;//if we found the end of an open border, stop searching
-                            }
-                        }
-                    }
+                    start = c;
+                    openNode = thisCand.inNode;
                 }
+            } else {
+                if (start == -1) start = c;
             }
         }
-        if (!foundStart) break;
-        CaretPointer<Border> newBorder(new Border());//in case something throws
-        newBorder->setClosed(closed);
+        if (start == -1) break;
+        pathsOut.push_back(TracedPath());
+        TracedPath& myPath = pathsOut.back();
+        myPath.m_closed = (openNode == -1);
+        int curInNode = candidates[start].inNode, curEdge = candidates[start].edge, curOutNode = candidates[start].outNode;
         int startInNode = curInNode, startOutNode = curOutNode;
         int prevThirdNode = -1;
         do
         {
-            edgeUsed[curEdge] = 1;//don't start another border from this edge
             const TopologyEdgeInfo& myEdge = myEdgeInfo[curEdge];//to remove some redundant indexing
-            CaretPointer<SurfaceProjectedItem> newPoint(new SurfaceProjectedItem());//ditto
-            newPoint->setStructure(m_structure);
-            newPoint->getBarycentricProjection()->setProjectionSurfaceNumberOfNodes(m_numNodes);
-            int32_t triNodes[3] = { curInNode, curOutNode, myEdge.tiles[0].node3 };//always use the first tile, as it will always exist
-            newPoint->getBarycentricProjection()->setTriangleNodes(triNodes);
-            newPoint->getBarycentricProjection()->setTriangleAreas(nodeWeights);
-            newPoint->getBarycentricProjection()->setValid(true);
-            newBorder->addPoint(newPoint.releasePointer());//NOTE: addPoint takes ownership of a RAW POINTER - shared_ptr won't release a pointer
+            sideUsed[2 * curEdge + (myEdge.node1 == curInNode ? 0 : 1)] = 1;//don't start another border from this edge
+            myPath.m_triNodes.push_back(curInNode);
+            myPath.m_triNodes.push_back(curOutNode);
+            myPath.m_triNodes.push_back(myEdge.tiles[0].node3);//always use the first tile, as it will always exist
             int useTile = 0;
             if (myEdge.tiles[0].node3 == prevThirdNode)
             {
@@ -101,7 +179,7 @@ vector<CaretPointer<Border> > BorderTracingHelper::tracePrivate(vector<int>& mar
             }
             int nextNode = myEdge.tiles[useTile].node3;
             int edgeMove = 0;
-            if (marked[nextNode] == 0)
+            if (regionOfNode[nextNode] != region)
             {
                 edgeMove = (myEdge.tiles[useTile].edgeReversed == (myEdge.node1 == curInNode) ? 1 : 2);//some magic to find the next edge via the lookups
                 prevThirdNode = curOutNode;
@@ -116,7 +194,24 @@ vector<CaretPointer<Border> > BorderTracingHelper::tracePrivate(vector<int>& mar
             CaretAssert(myEdgeInfo[curEdge].node1 == curInNode || myEdgeInfo[curEdge].node1 == curOutNode);//assert to make sure the magic worked
             CaretAssert(myEdgeInfo[curEdge].node2 == curInNode || myEdgeInfo[curEdge].node2 == curOutNode);
         } while (curInNode != startInNode || curOutNode != startOutNode);
-        ret.push_back(newBorder);
     }
-    return ret;
+}
+
+CaretPointer<Border> BorderTracingHelper::makeBorder(const TracedPath& path, const float& placement) const
+{
+    float nodeWeights[3] = { 1.0f - placement, placement, 0.0f };
+    CaretPointer<Border> newBorder(new Border());//in case something throws
+    newBorder->setClosed(path.m_closed);
+    int numPoints = (int)path.m_triNodes.size() / 3;
+    for (int i = 0; i < numPoints; ++i)
+    {
+        CaretPointer<SurfaceProjectedItem> newPoint(new SurfaceProjectedItem());//ditto
+        newPoint->setStructure(m_structure);
+        newPoint->getBarycentricProjection()->setProjectionSurfaceNumberOfNodes(m_numNodes);
+        newPoint->getBarycentricProjection()->setTriangleNodes(path.m_triNodes.data() + i * 3);
+        newPoint->getBarycentricProjection()->setTriangleAreas(nodeWeights);
+        newPoint->getBarycentricProjection()->setValid(true);
+        newBorder->addPoint(newPoint.releasePointer());//NOTE: addPoint takes ownership of a RAW POINTER - shared_ptr won't release a pointer
+    }
+    return newBorder;
 }
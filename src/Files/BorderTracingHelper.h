@@ -35,6 +35,18 @@ namespace caret {
     
     class BorderTracingHelper
     {
+    public:
+        struct BoundaryEdge
+        {
+            int32_t edge;//index into the topology helper's edge info
+            int32_t inNode, outNode;//inNode is in the region the edge is listed under, outNode is not
+        };
+    private:
+        struct TracedPath
+        {//plain result of tracing, so tracing can run in parallel without allocating border objects
+            std::vector<int32_t> m_triNodes;//3 per point: inside node, outside node, third node of the first tile of the edge
+            bool m_closed;
+        };
         int m_numNodes;
         StructureEnum::Enum m_structure;
         CaretPointer<TopologyHelper> m_topoHelp;
@@ -42,11 +54,21 @@ namespace caret {
         BorderTracingHelper(const BorderTracingHelper&);//no copy
         BorderTracingHelper& operator=(const BorderTracingHelper&);//no assign
         std::vector<CaretPointer<Border> > tracePrivate(std::vector<int>& marked, const float& placement);
+        void traceRegion(const int& region, const std::vector<int>& regionOfNode, const BoundaryEdge* candidates, const int64_t& numCandidates,
+                         std::vector<char>& sideUsed, std::vector<TracedPath>& pathsOut) const;
+        CaretPointer<Border> makeBorder(const TracedPath& path, const float& placement) const;
     public:
         BorderTracingHelper(const SurfaceFile* surfIn);
         template<typename T, typename Test>
         std::vector<CaretPointer<Border> > traceData(T* data, const Test& myTester, const float& placement = 0.33f);
         
+        ///find all edges whose vertices are in different regions (negative means no region), listed once for each end that is in a region,
+        ///grouped by region in vertex order, region r's edges are edgesOut[regionStartOut[r]] up to edgesOut[regionStartOut[r + 1]]
+        void findBoundaryEdges(const std::vector<int>& regionOfNode, const int& numRegions, std::vector<int64_t>& regionStartOut, std::vector<BoundaryEdge>& edgesOut) const;
+        
+        ///trace the borders of all regions at once, regions are traced in parallel, the result has the borders for each region
+        std::vector<std::vector<CaretPointer<Border> > > traceRegions(const std::vector<int>& regionOfNode, const int& numRegions, const float& placement = 0.33f);
+        
         //some useful selection objects
         class LabelSelect
         {
@@ -57,6 +57,49 @@ ChartableMatrixInterface::isMatrixChartDataTypeSupported(const ChartDataTypeEnum
     return false;
 }
 
+/**
+ * @return True if the file can color a region of the matrix at reduced
+ * resolution with getMatrixDataRGBAForRegion(), so that large matrices
+ * are drawn without coloring every cell.
+ */
+bool
+ChartableMatrixInterface::isMatrixDataRGBAForRegionSupported() const
+{
+    return false;
+}
+
+/**
+ * Get the RGBA coloring for a region of the matrix at a resolution level.
+ * Each cell at resolution level L covers 2^L by 2^L cells of the matrix,
+ * so a level has ceil(rows / 2^L) rows and ceil(columns / 2^L) columns.
+ *
+ * @param resolutionLevel
+ *    The resolution level, zero for the full resolution matrix.
+ * @param firstRow
+ *    First row of the region, in cells of the level.
+ * @param firstColumn
+ *    First column of the region, in cells of the level.
+ * @param numberOfRows
+ *    Number of rows in the region.
+ * @param numberOfColumns
+ *    Number of columns in the region.
+ * @param rgbaOut
+ *    RGBA coloring output with number of elements
+ *    (numberOfRows * numberOfColumns * 4), first row first.
+ * @return
+ *    True if output data is valid, else false.
+ */
+bool
+ChartableMatrixInterface::getMatrixDataRGBAForRegion(const int32_t /*resolutionLevel*/,
+                                                     const int32_t /*firstRow*/,
+                                                     const int32_t /*firstColumn*/,
+                                                     const int32_t /*numberOfRows*/,
+                                                     const int32_t /*numberOfColumns*/,
+                                                     std::vector<uint8_t>& /*rgbaOut*/) const
+{
+    return false;
+}
+
 /**
  * @return The CaretMappableDataFile that implements this interface.
  * Will be NULL if this interface is not implemented by a CaretMappableDataFile.
@@ -70,6 +70,15 @@ namespace caret {
                                        int32_t& numberOfColumnsOut,
                                        std::vector<float>& rgbaOut) const = 0;
         
+        virtual bool isMatrixDataRGBAForRegionSupported() const;
+        
+        virtual bool getMatrixDataRGBAForRegion(const int32_t resolutionLevel,
+                                                const int32_t firstRow,
+                                                const int32_t firstColumn,
+                                                const int32_t numberOfRows,
+                                                const int32_t numberOfColumns,
+                                                std::vector<uint8_t>& rgbaOut) const;
+        
         /**
          * Get the value, row name, and column name for a cell in the matrix.
          *
@@ -25,6 +25,7 @@
 
 #include "CaretLogger.h"
 #include "ChartDataCartesian.h"
+#include "CiftiConnectivityMatrixDenseDynamicFile.h"
 #include "SceneClass.h"
 
 using namespace caret;
@@ -46,6 +47,8 @@ CiftiBrainordinateDataSeriesFile::CiftiBrainordinateDataSeriesFile()
     for (int32_t i = 0; i < BrainConstants::MAXIMUM_NUMBER_OF_BROWSER_TABS; i++) {
         m_chartingEnabledForTab[i] = false;
     }
+    
+    m_denseDynamicFile = new CiftiConnectivityMatrixDenseDynamicFile();
 }
 
 /**
@@ -53,6 +56,56 @@ CiftiBrainordinateDataSeriesFile::CiftiBrainordinateDataSeriesFile()
  */
 CiftiBrainordinateDataSeriesFile::~CiftiBrainordinateDataSeriesFile()
 {
+    delete m_denseDynamicFile;
+}
+
+/**
+ * Clear the contents of the file.
+ */
+void
+CiftiBrainordinateDataSeriesFile::clear()
+{
+    CiftiMappableDataFile::clear();
+    
+    m_denseDynamicFile->updateAfterDataSeriesFileRead(NULL,
+                                                      "");
+}
+
+/**
+ * Read the file.
+ *
+ * @param ciftiMapFileName
+ *    Name of the file to read.
+ * @throw
+ *    DataFileException if there is an error reading the file.
+ */
+void
+CiftiBrainordinateDataSeriesFile::readFile(const AString& ciftiMapFileName)
+{
+    CiftiMappableDataFile::readFile(ciftiMapFileName);
+    
+    m_denseDynamicFile->updateAfterDataSeriesFileRead(m_ciftiFile,
+                                                      getFileName());
+}
+
+/**
+ * @return The dense connectivity computed from this file's timeseries.
+ * It is empty if this file does not contain brainordinates.
+ */
+CiftiConnectivityMatrixDenseDynamicFile*
+CiftiBrainordinateDataSeriesFile::getConnectivityMatrixDenseDynamicFile()
+{
+    return m_denseDynamicFile;
+}
+
+/**
+ * @return The dense connectivity computed from this file's timeseries.
+ * It is empty if this file does not contain brainordinates.
+ */
+const CiftiConnectivityMatrixDenseDynamicFile*
+CiftiBrainordinateDataSeriesFile::getConnectivityMatrixDenseDynamicFile() const
+{
+    return m_denseDynamicFile;
 }
 
 /**
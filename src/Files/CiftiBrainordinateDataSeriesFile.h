@@ -26,6 +26,7 @@
 #include "CiftiMappableDataFile.h"
 
 namespace caret {
+    class CiftiConnectivityMatrixDenseDynamicFile;
     class PaletteFile;
 
     class CiftiBrainordinateDataSeriesFile :
@@ -37,6 +38,14 @@ namespace caret {
         
         virtual ~CiftiBrainordinateDataSeriesFile();
         
+        virtual void clear();
+        
+        virtual void readFile(const AString& ciftiMapFileName);
+        
+        CiftiConnectivityMatrixDenseDynamicFile* getConnectivityMatrixDenseDynamicFile();
+        
+        const CiftiConnectivityMatrixDenseDynamicFile* getConnectivityMatrixDenseDynamicFile() const;
+        
         virtual bool isLineSeriesChartingEnabled(const int32_t tabIndex) const;
         
         virtual void setLineSeriesChartingEnabled(const int32_t tabIndex,
@@ -73,6 +82,9 @@ namespace caret {
         // ADD_NEW_MEMBERS_HERE
 
         bool m_chartingEnabledForTab[BrainConstants::MAXIMUM_NUMBER_OF_BROWSER_TABS];
+        
+        /** Connectivity computed from this file's timeseries */
+        CiftiConnectivityMatrixDenseDynamicFile* m_denseDynamicFile;
     };
     
 #ifdef __CIFTI_BRAINORDINATE_DATA_SERIES_FILE_DECLARE__
@@ -0,0 +1,515 @@
+
+/*LICENSE_START*/
+/*
+ *  Copyright (C) 2014  Washington University School of Medicine
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+/*LICENSE_END*/
+
+#include <algorithm>
+#include <cmath>
+
+#define __CIFTI_CONNECTIVITY_MATRIX_DENSE_DYNAMIC_FILE_DECLARE__
+#include "CiftiConnectivityMatrixDenseDynamicFile.h"
+#undef __CIFTI_CONNECTIVITY_MATRIX_DENSE_DYNAMIC_FILE_DECLARE__
+
+#include "CaretAssert.h"
+#include "CaretLogger.h"
+#include "CaretOMP.h"
+#include "CiftiFile.h"
+#include "DataFileException.h"
+
+using namespace caret;
+
+namespace {
+    /*
+     * Dot product with four independent sums so that
+     * the compiler may vectorize the loop.
+     */
+    template <typename T>
+    inline float dotProduct(const float* a,
+                            const T* b,
+                            const int64_t count)
+    {
+        float sum0 = 0.0f, sum1 = 0.0f, sum2 = 0.0f, sum3 = 0.0f;
+        int64_t i = 0;
+        for (; i + 3 < count; i += 4) {
+            sum0 += a[i]     * b[i];
+            sum1 += a[i + 1] * b[i + 1];
+            sum2 += a[i + 2] * b[i + 2];
+            sum3 += a[i + 3] * b[i + 3];
+        }
+        for (; i < count; i++) {
+            sum0 += a[i] * b[i];
+        }
+        return ((sum0 + sum1) + (sum2 + sum3));
+    }
+    
+    /*
+     * Rounding can put a correlation, such as a timeseries
+     * with itself, slightly outside of [-1, 1].
+     */
+    inline float clampCorrelation(const float r)
+    {
+        if (r > 1.0f) return 1.0f;
+        if (r < -1.0f) return -1.0f;
+        return r;
+    }
+}
+
+/**
+ * \class caret::CiftiConnectivityMatrixDenseDynamicFile 
+ * \brief Dense connectivity computed from a data series file
+ * \ingroup Files
+ *
+ * Behaves as a dense connectivity file for a brainordinate data series
+ * file but instead of reading a row from a (very large) file, the row
+ * is the correlation of the selected brainordinate's timeseries with
+ * the timeseries of all brainordinates.  Timeseries are demeaned and
+ * normalized to unit length once, when data is first loaded, so that
+ * the correlation is a dot product.
+ *
+ * Since the correlation is linear in the seed timeseries, the average
+ * of the rows for many brainordinates is computed with a single pass
+ * using the average of their normalized timeseries as the seed.
+ *
+ * The instance is owned by the data series file.
+ */
+
+/**
+ * Constructor.
+ */
+CiftiConnectivityMatrixDenseDynamicFile::CiftiConnectivityMatrixDenseDynamicFile()
+: CiftiMappableConnectivityMatrixDataFile(DataFileTypeEnum::CONNECTIVITY_DENSE),
+m_dataSeriesCiftiFile(NULL),
+m_dataQuantized(false),
+m_numberOfRows(0),
+m_numberOfTimePoints(0),
+m_normalizedDataValid(false),
+m_normalizedDataMaximumBytes(s_defaultNormalizedDataMaximumBytes)
+{
+    
+}
+
+/**
+ * Destructor.
+ */
+CiftiConnectivityMatrixDenseDynamicFile::~CiftiConnectivityMatrixDenseDynamicFile()
+{
+    /*
+     * The prefetch thread computes rows from the normalized
+     * timeseries, so it must stop before they are destroyed
+     */
+    stopRowPrefetch();
+}
+
+/**
+ * @return True if this file type supports writing, else false.
+ *
+ * Dynamic files do NOT support writing.
+ */
+bool
+CiftiConnectivityMatrixDenseDynamicFile::supportsWriting() const
+{
+    return false;
+}
+
+/**
+ * Dynamic files are created from a data series file and are never read.
+ *
+ * @param filename
+ *    Name of the file.
+ * @throw DataFileException
+ *    Always.
+ */
+void
+CiftiConnectivityMatrixDenseDynamicFile::readFile(const AString& filename)
+{
+    throw DataFileException(filename,
+                            "Dynamic connectivity is created from a data series file and cannot be read.");
+}
+
+/**
+ * Dynamic files are computed and are never written.
+ *
+ * @param filename
+ *    Name of the file.
+ * @throw DataFileException
+ *    Always.
+ */
+void
+CiftiConnectivityMatrixDenseDynamicFile::writeFile(const AString& filename)
+{
+    throw DataFileException(filename,
+                            "Dynamic connectivity cannot be written.");
+}
+
+/**
+ * Update after the data series file has been read (or cleared).
+ *
+ * @param dataSeriesCiftiFile
+ *    The data series file's CIFTI data, NULL if the data series file is empty.
+ * @param dataSeriesFileName
+ *    Name of the data series file.
+ */
+void
+CiftiConnectivityMatrixDenseDynamicFile::updateAfterDataSeriesFileRead(const CiftiFile* dataSeriesCiftiFile,
+                                                                       const AString& dataSeriesFileName)
+{
+    clear();
+    
+    m_dataSeriesCiftiFile = NULL;
+    m_normalizedData.clear();
+    m_quantizedData.clear();
+    m_numberOfRows = 0;
+    m_numberOfTimePoints = 0;
+    m_normalizedDataValid = false;
+    
+    if (dataSeriesCiftiFile == NULL) {
+        return;
+    }
+    
+    const CiftiXML& seriesXML = dataSeriesCiftiFile->getCiftiXML();
+    if ((seriesXML.getNumberOfDimensions() != 2)
+        || (seriesXML.getMappingType(CiftiXML::ALONG_COLUMN) != CiftiMappingType::BRAIN_MODELS)) {
+        return;
+    }
+    
+    /*
+     * Matrix is brainordinates by brainordinates.  The CIFTI file
+     * has no data, rows are always computed.
+     */
+    CiftiXML matrixXML;
+    matrixXML.setNumberOfDimensions(2);
+    matrixXML.setMap(CiftiXML::ALONG_ROW,
+                     *seriesXML.getMap(CiftiXML::ALONG_COLUMN));
+    matrixXML.setMap(CiftiXML::ALONG_COLUMN,
+                     *seriesXML.getMap(CiftiXML::ALONG_COLUMN));
+    
+    AString fileName = dataSeriesFileName;
+    const AString seriesExtension(".dtseries.nii");
+    if (fileName.endsWith(seriesExtension)) {
+        fileName.chop(seriesExtension.length());
+    }
+    fileName += ".dynconn.nii";
+    
+    m_ciftiFile.grabNew(new CiftiFile());
+    m_ciftiFile->setCiftiXML(matrixXML);
+    initializeAfterReading(fileName);
+    
+    m_dataSeriesCiftiFile = dataSeriesCiftiFile;
+    
+    setFileName(fileName);
+    
+    /*
+     * Normalized timeseries use as much memory as the data series
+     * file, so they are only created if the user enables loading.
+     */
+    setMapDataLoadingEnabled(0,
+                             false);
+    
+    clearModified();
+}
+
+/**
+ * @return Maximum size, in bytes, of the normalized timeseries stored
+ * as floats.  Larger timeseries are stored as 16-bit integers.
+ */
+int64_t
+CiftiConnectivityMatrixDenseDynamicFile::getNormalizedDataMaximumBytes() const
+{
+    return m_normalizedDataMaximumBytes;
+}
+
+/**
+ * Set the maximum size, in bytes, of the normalized timeseries stored
+ * as floats.  Timeseries that have been created are recreated when
+ * next needed.
+ *
+ * @param maximumBytes
+ *    New maximum size.
+ */
+void
+CiftiConnectivityMatrixDenseDynamicFile::setNormalizedDataMaximumBytes(const int64_t maximumBytes)
+{
+    stopRowPrefetch();
+    
+    m_normalizedDataMaximumBytes = std::max(maximumBytes,
+                                            static_cast<int64_t>(0));
+    std::vector<float>().swap(m_normalizedData);
+    std::vector<int16_t>().swap(m_quantizedData);
+    m_normalizedDataValid = false;
+    invalidateRowCache();
+}
+
+/**
+ * Create the demeaned, unit length timeseries if they
+ * have not been created.
+ *
+ * @throw DataFileException
+ *    If there is not enough memory.
+ */
+void
+CiftiConnectivityMatrixDenseDynamicFile::validateNormalizedData() const
+{
+    if (m_normalizedDataValid) {
+        return;
+    }
+    
+    CaretAssert(m_dataSeriesCiftiFile);
+    m_numberOfRows       = m_dataSeriesCiftiFile->getNumberOfRows();
+    m_numberOfTimePoints = m_dataSeriesCiftiFile->getNumberOfColumns();
+    const int64_t numberOfValues = m_numberOfRows * m_numberOfTimePoints;
+    
+    /*
+     * If float timeseries would use more than the maximum bytes, store
+     * them as 16-bit integers, which use half the memory and give
+     * correlations accurate to about 1.0e-4.
+     */
+    const int64_t floatBytes = numberOfValues * static_cast<int64_t>(sizeof(float));
+    m_dataQuantized = (floatBytes > m_normalizedDataMaximumBytes);
+    try {
+        if (m_dataQuantized) {
+            m_quantizedData.resize(numberOfValues);
+            CaretLogInfo("Float timeseries would use "
+                         + AString::number(floatBytes / (1024 * 1024))
+                         + " MB, dynamic connectivity timeseries are stored as 16-bit integers for "
+                         + getFileName());
+        }
+        else {
+            m_normalizedData.resize(numberOfValues);
+        }
+    }
+    catch (const std::bad_alloc&) {
+        std::vector<float>().swap(m_normalizedData);
+        std::vector<int16_t>().swap(m_quantizedData);
+        throw DataFileException(getFileName(),
+                                "Not enough memory for dynamic connectivity timeseries.");
+    }
+    
+    const int64_t numberOfTimePoints = m_numberOfTimePoints;
+    const bool dataInMemory = m_dataSeriesCiftiFile->isInMemory();
+#pragma omp CARET_PAR if (dataInMemory)
+    {
+        std::vector<float> timeSeries(numberOfTimePoints);
+#pragma omp CARET_FOR schedule(dynamic, 64)
+        for (int64_t iRow = 0; iRow < m_numberOfRows; iRow++) {
+            if (numberOfTimePoints <= 0) {
+                continue;
+            }
+            m_dataSeriesCiftiFile->getRow(&timeSeries[0],
+                                          iRow);
+            
+            double sum = 0.0;
+            for (int64_t t = 0; t < numberOfTimePoints; t++) {
+                sum += timeSeries[t];
+            }
+            const float mean = sum / numberOfTimePoints;
+            
+            double sumSquared = 0.0;
+            for (int64_t t = 0; t < numberOfTimePoints; t++) {
+                timeSeries[t] -= mean;
+                sumSquared += (timeSeries[t] * timeSeries[t]);
+            }
+            
+            /*
+             * Constant timeseries (such as outside of the brain)
+             * become all zeros and have zero correlation.
+             */
+            const float scale = ((sumSquared > 0.0)
+                                 ? (1.0 / std::sqrt(sumSquared))
+                                 : 0.0f);
+            
+            const int64_t offset = iRow * numberOfTimePoints;
+            if (m_dataQuantized) {
+                int16_t* quantizedRow = &m_quantizedData[offset];
+                for (int64_t t = 0; t < numberOfTimePoints; t++) {
+                    const float value = timeSeries[t] * scale * s_quantizationScale;
+                    quantizedRow[t] = static_cast<int16_t>((value >= 0.0f)
+                                                           ? (value + 0.5f)
+                                                           : (value - 0.5f));
+                }
+            }
+            else {
+                float* normalizedRow = &m_normalizedData[offset];
+                for (int64_t t = 0; t < numberOfTimePoints; t++) {
+                    normalizedRow[t] = timeSeries[t] * scale;
+                }
+            }
+        }
+    }
+    
+    m_normalizedDataValid = true;
+    
+    CaretLogFine("Created normalized timeseries for "
+                 + AString::number(m_numberOfRows)
+                 + " brainordinates of "
+                 + getFileNameNoPath());
+}
+
+/**
+ * Get the demeaned, unit length timeseries for a row.
+ *
+ * @param rowIndex
+ *    Index of the row.
+ * @param rowOut
+ *    Output with the timeseries.
+ */
+void
+CiftiConnectivityMatrixDenseDynamicFile::getNormalizedRow(const int64_t rowIndex,
+                                                          float* rowOut) const
+{
+    CaretAssert((rowIndex >= 0) && (rowIndex < m_numberOfRows));
+    const int64_t offset = rowIndex * m_numberOfTimePoints;
+    if (m_dataQuantized) {
+        const int16_t* quantizedRow = &m_quantizedData[offset];
+        for (int64_t t = 0; t < m_numberOfTimePoints; t++) {
+            rowOut[t] = quantizedRow[t] / s_quantizationScale;
+        }
+    }
+    else {
+        const float* normalizedRow = &m_normalizedData[offset];
+        for (int64_t t = 0; t < m_numberOfTimePoints; t++) {
+            rowOut[t] = normalizedRow[t];
+        }
+    }
+}
+
+/**
+ * Compute the dot product of the seed with the normalized
+ * timeseries of every row.
+ *
+ * @param seed
+ *    The seed timeseries.
+ * @param dataOut
+ *    Output with a value for each row.
+ */
+void
+CiftiConnectivityMatrixDenseDynamicFile::computeSeedCorrelation(const float* seed,
+                                                                float* dataOut) const
+{
+    const int64_t numberOfTimePoints = m_numberOfTimePoints;
+    if (numberOfTimePoints <= 0) {
+        std::fill(dataOut,
+                  dataOut + m_numberOfRows,
+                  0.0f);
+        return;
+    }
+    
+    if (m_dataQuantized) {
+        /*
+         * Apply quantization scale to the seed instead of to every value
+         */
+        std::vector<float> scaledSeed(numberOfTimePoints);
+        for (int64_t t = 0; t < numberOfTimePoints; t++) {
+            scaledSeed[t] = seed[t] / s_quantizationScale;
+        }
+        const float* scaledSeedPointer = &scaledSeed[0];
+        const int16_t* quantizedData = &m_quantizedData[0];
+#pragma omp CARET_PARFOR schedule(static)
+        for (int64_t iRow = 0; iRow < m_numberOfRows; iRow++) {
+            dataOut[iRow] = clampCorrelation(dotProduct(scaledSeedPointer,
+                                                        quantizedData + (iRow * numberOfTimePoints),
+                                                        numberOfTimePoints));
+        }
+    }
+    else {
+        const float* normalizedData = &m_normalizedData[0];
+#pragma omp CARET_PARFOR schedule(static)
+        for (int64_t iRow = 0; iRow < m_numberOfRows; iRow++) {
+            dataOut[iRow] = clampCorrelation(dotProduct(seed,
+                                                        normalizedData + (iRow * numberOfTimePoints),
+                                                        numberOfTimePoints));
+        }
+    }
+}
+
+/**
+ * Get the correlation of a row's timeseries with all timeseries.
+ *
+ * @param dataOut
+ *    Output with data for the row.
+ * @param index
+ *    Index of the row.
+ */
+void
+CiftiConnectivityMatrixDenseDynamicFile::getProcessedDataForRow(float* dataOut,
+                                                                const int64_t& index) const
+{
+    validateNormalizedData();
+    
+    std::vector<float> seed(m_numberOfTimePoints);
+    if (m_numberOfTimePoints > 0) {
+        getNormalizedRow(index,
+                         &seed[0]);
+    }
+    
+    computeSeedCorrelation((seed.empty() ? NULL : &seed[0]),
+                           dataOut);
+}
+
+/**
+ * @return True since the average of rows is computed with
+ * one seed timeseries.
+ */
+bool
+CiftiConnectivityMatrixDenseDynamicFile::isRowAverageComputedDirectly() const
+{
+    return true;
+}
+
+/**
+ * Get the average correlation of the rows' timeseries with all timeseries.
+ * This is the correlation with the average of the rows' normalized timeseries.
+ *
+ * @param dataOut
+ *    Output with average of the rows.
+ * @param rowIndices
+ *    Indices of the rows.
+ */
+void
+CiftiConnectivityMatrixDenseDynamicFile::getProcessedDataForRowAverage(float* dataOut,
+                                                                       const std::vector<int64_t>& rowIndices) const
+{
+    validateNormalizedData();
+    
+    const int64_t numberOfTimePoints = m_numberOfTimePoints;
+    std::vector<double> seedSum(numberOfTimePoints, 0.0);
+    std::vector<float> rowData(numberOfTimePoints);
+    for (std::vector<int64_t>::const_iterator iter = rowIndices.begin();
+         iter != rowIndices.end();
+         iter++) {
+        if (numberOfTimePoints > 0) {
+            getNormalizedRow(*iter,
+                             &rowData[0]);
+        }
+        for (int64_t t = 0; t < numberOfTimePoints; t++) {
+            seedSum[t] += rowData[t];
+        }
+    }
+    
+    std::vector<float> seed(numberOfTimePoints, 0.0f);
+    if ( ! rowIndices.empty()) {
+        const double numberOfRows = rowIndices.size();
+        for (int64_t t = 0; t < numberOfTimePoints; t++) {
+            seed[t] = seedSum[t] / numberOfRows;
+        }
+    }
+    
+    computeSeedCorrelation((seed.empty() ? NULL : &seed[0]),
+                           dataOut);
+}
+
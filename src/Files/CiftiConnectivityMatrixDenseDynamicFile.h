@@ -0,0 +1,117 @@
+#ifndef __CIFTI_CONNECTIVITY_MATRIX_DENSE_DYNAMIC_FILE_H__
+#define __CIFTI_CONNECTIVITY_MATRIX_DENSE_DYNAMIC_FILE_H__
+
+/*LICENSE_START*/
+/*
+ *  Copyright (C) 2014  Washington University School of Medicine
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+/*LICENSE_END*/
+
+
+#include "CiftiMappableConnectivityMatrixDataFile.h"
+
+namespace caret {
+
+    class CiftiFile;
+    
+    class CiftiConnectivityMatrixDenseDynamicFile : public CiftiMappableConnectivityMatrixDataFile {
+        
+    public:
+        CiftiConnectivityMatrixDenseDynamicFile();
+        
+        virtual ~CiftiConnectivityMatrixDenseDynamicFile();
+        
+        virtual bool supportsWriting() const;
+        
+        virtual void readFile(const AString& filename);
+        
+        virtual void writeFile(const AString& filename);
+        
+        void updateAfterDataSeriesFileRead(const CiftiFile* dataSeriesCiftiFile,
+                                           const AString& dataSeriesFileName);
+        
+        int64_t getNormalizedDataMaximumBytes() const;
+        
+        void setNormalizedDataMaximumBytes(const int64_t maximumBytes);
+        
+    protected:
+        virtual void getProcessedDataForRow(float* dataOut,
+                                            const int64_t& index) const;
+        
+        virtual bool isRowAverageComputedDirectly() const;
+        
+        virtual void getProcessedDataForRowAverage(float* dataOut,
+                                                   const std::vector<int64_t>& rowIndices) const;
+        
+    private:
+        CiftiConnectivityMatrixDenseDynamicFile(const CiftiConnectivityMatrixDenseDynamicFile&);
+
+        CiftiConnectivityMatrixDenseDynamicFile& operator=(const CiftiConnectivityMatrixDenseDynamicFile&);
+        
+        void validateNormalizedData() const;
+        
+        void getNormalizedRow(const int64_t rowIndex,
+                              float* rowOut) const;
+        
+        void computeSeedCorrelation(const float* seed,
+                                    float* dataOut) const;
+        
+    public:
+
+        // ADD_NEW_METHODS_HERE
+
+    private:
+
+        // ADD_NEW_MEMBERS_HERE
+
+        /** The data series file's CIFTI data, owned by the data series file */
+        const CiftiFile* m_dataSeriesCiftiFile;
+        
+        /** Timeseries are stored as 16-bit integers, when floats would exceed the maximum bytes */
+        mutable bool m_dataQuantized;
+        
+        /** Number of brainordinates (rows) */
+        mutable int64_t m_numberOfRows;
+        
+        /** Number of points in each timeseries */
+        mutable int64_t m_numberOfTimePoints;
+        
+        /** Demeaned, unit length timeseries for each brainordinate, row major */
+        mutable std::vector<float> m_normalizedData;
+        
+        /** Demeaned, unit length timeseries quantized to 16-bit integers, row major */
+        mutable std::vector<int16_t> m_quantizedData;
+        
+        /** True if normalized timeseries have been created */
+        mutable bool m_normalizedDataValid;
+        
+        /** Memory allowed for the normalized timeseries stored as floats */
+        int64_t m_normalizedDataMaximumBytes;
+        
+        static const float s_quantizationScale;
+        
+        static const int64_t s_defaultNormalizedDataMaximumBytes;
+    };
+    
+#ifdef __CIFTI_CONNECTIVITY_MATRIX_DENSE_DYNAMIC_FILE_DECLARE__
+    const float CiftiConnectivityMatrixDenseDynamicFile::s_quantizationScale = 32767.0f;
+    
+    const int64_t CiftiConnectivityMatrixDenseDynamicFile::s_defaultNormalizedDataMaximumBytes = static_cast<int64_t>(2) * 1024 * 1024 * 1024;
+#endif // __CIFTI_CONNECTIVITY_MATRIX_DENSE_DYNAMIC_FILE_DECLARE__
+
+} // namespace
+#endif  //__CIFTI_CONNECTIVITY_MATRIX_DENSE_DYNAMIC_FILE_H__
@@ -50,7 +50,7 @@ CiftiConnectivityMatrixDenseFile::CiftiConnectivityMatrixDenseFile()
  */
 CiftiConnectivityMatrixDenseFile::~CiftiConnectivityMatrixDenseFile()
 {
-    
+    stopRowPrefetch();//before the derived part of the object is gone
 }
 
 /**
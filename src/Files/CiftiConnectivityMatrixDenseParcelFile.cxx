@@ -50,6 +50,6 @@ CiftiConnectivityMatrixDenseParcelFile::CiftiConnectivityMatrixDenseParcelFile()
  */
 CiftiConnectivityMatrixDenseParcelFile::~CiftiConnectivityMatrixDenseParcelFile()
 {
-    
+    stopRowPrefetch();//before the derived part of the object is gone
 }
 
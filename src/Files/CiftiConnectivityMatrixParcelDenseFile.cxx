@@ -50,6 +50,6 @@ CiftiConnectivityMatrixParcelDenseFile::CiftiConnectivityMatrixParcelDenseFile()
  */
 CiftiConnectivityMatrixParcelDenseFile::~CiftiConnectivityMatrixParcelDenseFile()
 {
-    
+    stopRowPrefetch();//before the derived part of the object is gone
 }
 
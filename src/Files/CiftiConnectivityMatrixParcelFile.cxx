@@ -92,6 +92,12 @@ CiftiConnectivityMatrixParcelFile::CiftiConnectivityMatrixParcelFile()
  */
 CiftiConnectivityMatrixParcelFile::~CiftiConnectivityMatrixParcelFile()
 {
+    /*
+     * The prefetch thread calls this file's virtual methods, so it
+     * must stop before this part of the object is destroyed
+     */
+    stopRowPrefetch();
+    
     EventManager::get()->removeAllEventsFromListener(this);
     
     for (int32_t i = 0; i < BrainConstants::MAXIMUM_NUMBER_OF_BROWSER_TABS; i++) {
@@ -204,6 +210,77 @@ CiftiConnectivityMatrixParcelFile::getMatrixDataRGBA(int32_t& numberOfRowsOut,
                                                     int32_t& numberOfColumnsOut,
                                                     std::vector<float>& rgbaOut) const
 {
+    std::vector<int32_t> rowIndices;
+    getReorderedRowIndices(rowIndices);
+    
+    return helpMatrixFileLoadChartDataMatrixRGBA(numberOfRowsOut,
+                                                 numberOfColumnsOut,
+                                                 rowIndices,
+                                                 rgbaOut);
+}
+
+/**
+ * @return True since a region of the matrix can be colored at
+ * reduced resolution.
+ */
+bool
+CiftiConnectivityMatrixParcelFile::isMatrixDataRGBAForRegionSupported() const
+{
+    return true;
+}
+
+/**
+ * Get the RGBA coloring for a region of the matrix at a resolution level.
+ *
+ * @param resolutionLevel
+ *    The resolution level, zero for the full resolution matrix.
+ * @param firstRow
+ *    First row of the region, in cells of the level.
+ * @param firstColumn
+ *    First column of the region, in cells of the level.
+ * @param numberOfRows
+ *    Number of rows in the region.
+ * @param numberOfColumns
+ *    Number of columns in the region.
+ * @param rgbaOut
+ *    RGBA coloring output with number of elements
+ *    (numberOfRows * numberOfColumns * 4).
+ * @return
+ *    True if output data is valid, else false.
+ */
+bool
+CiftiConnectivityMatrixParcelFile::getMatrixDataRGBAForRegion(const int32_t resolutionLevel,
+                                                              const int32_t firstRow,
+                                                              const int32_t firstColumn,
+                                                              const int32_t numberOfRows,
+                                                              const int32_t numberOfColumns,
+                                                              std::vector<uint8_t>& rgbaOut) const
+{
+    std::vector<int32_t> rowIndices;
+    getReorderedRowIndices(rowIndices);
+    
+    return helpMatrixFileLoadChartDataMatrixRGBAForRegion(resolutionLevel,
+                                                          firstRow,
+                                                          firstColumn,
+                                                          numberOfRows,
+                                                          numberOfColumns,
+                                                          rowIndices,
+                                                          rgbaOut);
+}
+
+/**
+ * Get the indices of the rows when the matrix is reordered by
+ * a parcel label file.
+ *
+ * @param rowIndicesOut
+ *    Output with the reordered row indices, empty if the
+ *    matrix is not reordered.
+ */
+void
+CiftiConnectivityMatrixParcelFile::getReorderedRowIndices(std::vector<int32_t>& rowIndicesOut) const
+{
+    rowIndicesOut.clear();
+    
     CiftiParcelLabelFile* parcelLabelFile = NULL;
     int32_t parcelLabelFileMapIndex = -1;
     bool enabled = false;
@@ -214,19 +291,13 @@ CiftiConnectivityMatrixParcelFile::getMatrixDataRGBA(int32_t& numberOfRowsOut,
                                                   parcelLabelFileMapIndex,
                                                   enabled);
     
-    std::vector<int32_t> rowIndices;
     if (enabled) {
         const CiftiParcelReordering* parcelReordering = getParcelReordering(parcelLabelFile,
                                                                             parcelLabelFileMapIndex);
         if (parcelReordering != NULL) {
-            rowIndices = parcelReordering->getReorderedParcelIndices();
+            rowIndicesOut = parcelReordering->getReorderedParcelIndices();
         }
     }
-    
-    return helpMatrixFileLoadChartDataMatrixRGBA(numberOfRowsOut,
-                                                 numberOfColumnsOut,
-                                                 rowIndices,
-                                                 rgbaOut);
 }
 
 /**
@@ -57,6 +57,15 @@ namespace caret {
                                        int32_t& numberOfColumnsOut,
                                        std::vector<float>& rgbaOut) const;
         
+        virtual bool isMatrixDataRGBAForRegionSupported() const;
+        
+        virtual bool getMatrixDataRGBAForRegion(const int32_t resolutionLevel,
+                                                const int32_t firstRow,
+                                                const int32_t firstColumn,
+                                                const int32_t numberOfRows,
+                                                const int32_t numberOfColumns,
+                                                std::vector<uint8_t>& rgbaOut) const;
+        
         virtual bool getMatrixCellAttributes(const int32_t rowIndex,
                                              const int32_t columnIndex,
                                              AString& cellValueOut,
@@ -129,7 +138,8 @@ namespace caret {
 //                                              const SceneClass* sceneClass);
         
     private:
-
+        void getReorderedRowIndices(std::vector<int32_t>& rowIndicesOut) const;
+        
         // ADD_NEW_MEMBERS_HERE
 
         SceneClassAssistant* m_sceneAssistant;
@@ -23,7 +23,12 @@
 #include "CiftiMappableConnectivityMatrixDataFile.h"
 #undef __CIFTI_MAPPABLE_CONNECTIVITY_MATRIX_DATA_FILE_DECLARE__
 
+#include <algorithm>
+
+#include <QThread>
+
 #include "CaretAssert.h"
+#include "CaretOMP.h"
 #include "CiftiFile.h"
 #include "CaretLogger.h"
 #include "ChartableMatrixParcelInterface.h"
@@ -36,12 +41,34 @@
 
 using namespace caret;
 
-
+namespace caret {
+    /**
+     * Reads rows for a connectivity file into the file's
+     * row cache in the background.
+     */
+    class CiftiConnectivityMatrixRowPrefetchThread : public QThread {
+    public:
+        CiftiConnectivityMatrixRowPrefetchThread(CiftiMappableConnectivityMatrixDataFile* matrixFile)
+        : m_matrixFile(matrixFile) { }
+        
+        void run() {
+            m_matrixFile->prefetchRows();
+        }
+        
+    private:
+        CiftiMappableConnectivityMatrixDataFile* m_matrixFile;
+    };
+}
     
 /**
  * \class caret::CiftiMappableConnectivityMatrixDataFile 
  * \brief Data file for Cifti Connectivity Matrix Files.
  * \ingroup Files
+ *
+ * Rows read from a file that is not in memory are kept in a cache
+ * limited by size and the least recently used rows are removed
+ * first.  Rows for the neighbors of the selected surface node are
+ * read into the cache in the background.
  */
 
 /**
@@ -51,6 +78,10 @@ CiftiMappableConnectivityMatrixDataFile::CiftiMappableConnectivityMatrixDataFile
 : CiftiMappableDataFile(dataFileType)
 {
     m_connectivityDataLoaded = new ConnectivityDataLoaded();
+    m_rowCacheBytes = 0;
+    m_rowCacheMaximumBytes = s_defaultRowCacheMaximumBytes;
+    m_rowPrefetchThread = NULL;
+    m_rowPrefetchCancelled = false;
     
     /*
      * This method initializes some members
@@ -84,6 +115,11 @@ CiftiMappableConnectivityMatrixDataFile::~CiftiMappableConnectivityMatrixDataFil
 void
 CiftiMappableConnectivityMatrixDataFile::clear()
 {
+    /*
+     * Prefetching must stop before the CIFTI file is deleted
+     */
+    stopRowPrefetch();
+    
     CiftiMappableDataFile::clear();
     clearPrivate();
 }
@@ -95,6 +131,9 @@ CiftiMappableConnectivityMatrixDataFile::clear()
 void
 CiftiMappableConnectivityMatrixDataFile::clearPrivate()
 {
+    stopRowPrefetch();
+    invalidateRowCache();
+    
     m_loadedRowData.clear();
     m_rowLoadedTextForMapName = "";
     m_rowLoadedText = "";
@@ -556,6 +595,489 @@ CiftiMappableConnectivityMatrixDataFile::setLoadedRowDataToAllZeros()
     m_rowLoadedTextForMapName.clear();
 }
 
+/**
+ * Get the data for a row.  Subclasses that compute their
+ * data instead of reading it from the file override this method.
+ *
+ * @param dataOut
+ *    Output with data for the row.
+ * @param index
+ *    Index of the row.
+ */
+void
+CiftiMappableConnectivityMatrixDataFile::getProcessedDataForRow(float* dataOut,
+                                                                const int64_t& index) const
+{
+    m_ciftiFile->getRow(dataOut,
+                        index);
+}
+
+/**
+ * @return True if a subclass computes the average of rows in one
+ * step with getProcessedDataForRowAverage() instead of the rows
+ * being obtained and averaged one at a time.
+ */
+bool
+CiftiMappableConnectivityMatrixDataFile::isRowAverageComputedDirectly() const
+{
+    return false;
+}
+
+/**
+ * Get the average of the data for rows.
+ *
+ * @param dataOut
+ *    Output with average of the rows.
+ * @param rowIndices
+ *    Indices of the rows.
+ */
+void
+CiftiMappableConnectivityMatrixDataFile::getProcessedDataForRowAverage(float* dataOut,
+                                                                       const std::vector<int64_t>& rowIndices) const
+{
+    const int64_t dataCount = m_ciftiFile->getNumberOfColumns();
+    std::vector<double> rowSum(dataCount, 0.0);
+    std::vector<float> rowData(dataCount);
+    for (std::vector<int64_t>::const_iterator iter = rowIndices.begin();
+         iter != rowIndices.end();
+         iter++) {
+        getProcessedDataForRow(&rowData[0],
+                               *iter);
+        for (int64_t j = 0; j < dataCount; j++) {
+            rowSum[j] += rowData[j];
+        }
+    }
+    
+    const double numberOfRows = rowIndices.size();
+    for (int64_t j = 0; j < dataCount; j++) {
+        dataOut[j] = ((numberOfRows > 0.0)
+                      ? (rowSum[j] / numberOfRows)
+                      : 0.0f);
+    }
+}
+
+/**
+ * @return Maximum size, in bytes, of the row cache.
+ */
+int64_t
+CiftiMappableConnectivityMatrixDataFile::getRowCacheMaximumBytes() const
+{
+    return m_rowCacheMaximumBytes;
+}
+
+/**
+ * Set the maximum size, in bytes, of the row cache.  Zero disables
+ * the row cache.
+ *
+ * @param maximumBytes
+ *    New maximum size.
+ */
+void
+CiftiMappableConnectivityMatrixDataFile::setRowCacheMaximumBytes(const int64_t maximumBytes)
+{
+    stopRowPrefetch();
+    
+    m_rowCacheMaximumBytes = std::max(maximumBytes,
+                                      static_cast<int64_t>(0));
+    invalidateRowCache();
+}
+
+/**
+ * Remove all rows from the row cache.  Subclasses that compute
+ * their rows call this when the computed rows change.
+ */
+void
+CiftiMappableConnectivityMatrixDataFile::invalidateRowCache()
+{
+    CaretMutexLocker locker(&m_rowCacheMutex);
+    m_rowCache.clear();
+    m_rowCacheRowIndices.clear();
+    m_rowCacheBytes = 0;
+}
+
+/**
+ * @return True if rows are cached.  Rows are not cached
+ * when the file is in memory unless a subclass computes them.
+ */
+bool
+CiftiMappableConnectivityMatrixDataFile::isRowCachingEnabled() const
+{
+    if (m_ciftiFile == NULL) {
+        return false;
+    }
+    if (m_rowCacheMaximumBytes <= 0) {
+        return false;
+    }
+    if (m_ciftiFile->isInMemory()
+        && ( ! isRowAverageComputedDirectly())) {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Get the data for a row using the row cache.
+ *
+ * @param dataOut
+ *    Output with data for the row.
+ * @param rowIndex
+ *    Index of the row.
+ */
+void
+CiftiMappableConnectivityMatrixDataFile::getRowData(float* dataOut,
+                                                    const int64_t rowIndex) const
+{
+    if ( ! isRowCachingEnabled()) {
+        getProcessedDataForRow(dataOut,
+                               rowIndex);
+        return;
+    }
+    
+    if (getRowFromCache(dataOut,
+                        rowIndex)) {
+        return;
+    }
+    
+    CaretMutexLocker readLocker(&m_rowReadMutex);
+    
+    /*
+     * Row may have been prefetched while waiting
+     */
+    if (getRowFromCache(dataOut,
+                        rowIndex)) {
+        return;
+    }
+    
+    getProcessedDataForRow(dataOut,
+                           rowIndex);
+    addRowToCache(dataOut,
+                  rowIndex);
+}
+
+/**
+ * Get a row from the row cache.
+ *
+ * @param dataOut
+ *    Output with data for the row.
+ * @param rowIndex
+ *    Index of the row.
+ * @return
+ *    True if the row was in the cache, else false.
+ */
+bool
+CiftiMappableConnectivityMatrixDataFile::getRowFromCache(float* dataOut,
+                                                         const int64_t rowIndex) const
+{
+    CaretMutexLocker locker(&m_rowCacheMutex);
+    
+    std::map<int64_t, std::list<RowCacheEntry>::iterator>::iterator iter = m_rowCacheRowIndices.find(rowIndex);
+    if (iter == m_rowCacheRowIndices.end()) {
+        return false;
+    }
+    
+    /*
+     * Move to front since most recently used
+     */
+    std::list<RowCacheEntry>::iterator entry = iter->second;
+    m_rowCache.splice(m_rowCache.begin(),
+                      m_rowCache,
+                      entry);
+    
+    if (dataOut != NULL) {
+        std::copy(entry->m_data.begin(),
+                  entry->m_data.end(),
+                  dataOut);
+    }
+    
+    return true;
+}
+
+/**
+ * Add a row to the row cache removing the least recently
+ * used rows if the cache is too large.
+ *
+ * @param data
+ *    Data for the row.
+ * @param rowIndex
+ *    Index of the row.
+ */
+void
+CiftiMappableConnectivityMatrixDataFile::addRowToCache(const float* data,
+                                                       const int64_t rowIndex) const
+{
+    const int64_t dataCount = m_ciftiFile->getNumberOfColumns();
+    const int64_t rowBytes = dataCount * static_cast<int64_t>(sizeof(float));
+    if (rowBytes > m_rowCacheMaximumBytes) {
+        return;
+    }
+    
+    CaretMutexLocker locker(&m_rowCacheMutex);
+    
+    if (m_rowCacheRowIndices.find(rowIndex) != m_rowCacheRowIndices.end()) {
+        return;
+    }
+    
+    while (( ! m_rowCache.empty())
+           && ((m_rowCacheBytes + rowBytes) > m_rowCacheMaximumBytes)) {
+        const RowCacheEntry& oldest = m_rowCache.back();
+        m_rowCacheBytes -= (oldest.m_data.size() * sizeof(float));
+        m_rowCacheRowIndices.erase(oldest.m_rowIndex);
+        m_rowCache.pop_back();
+    }
+    
+    m_rowCache.push_front(RowCacheEntry());
+    RowCacheEntry& entry = m_rowCache.front();
+    entry.m_rowIndex = rowIndex;
+    entry.m_data.assign(data,
+                        data + dataCount);
+    m_rowCacheRowIndices.insert(std::make_pair(rowIndex,
+                                               m_rowCache.begin()));
+    m_rowCacheBytes += rowBytes;
+}
+
+/**
+ * Get the average of rows.  Rows are read in the order they are
+ * located in the file and each row is read only once.  When the
+ * file is in memory, the rows are summed in parallel.
+ *
+ * @param dataOut
+ *    Output with average of the rows.
+ * @param rowIndices
+ *    Indices of the rows, may contain duplicates.
+ * @param progressEvent
+ *    If not NULL, progress is updated as rows are read.
+ * @return
+ *    True if successful, false if cancelled by the user.
+ */
+bool
+CiftiMappableConnectivityMatrixDataFile::getAverageOfRows(float* dataOut,
+                                                          const std::vector<int64_t>& rowIndices,
+                                                          EventProgressUpdate* progressEvent) const
+{
+    if (rowIndices.empty()) {
+        return true;
+    }
+    
+    if (isRowAverageComputedDirectly()) {
+        getProcessedDataForRowAverage(dataOut,
+                                      rowIndices);
+        return true;
+    }
+    
+    /*
+     * Sorted rows are in file order
+     */
+    std::vector<int64_t> sortedRowIndices(rowIndices);
+    std::sort(sortedRowIndices.begin(),
+              sortedRowIndices.end());
+    
+    std::vector<int64_t> uniqueRowIndices;
+    std::vector<double> uniqueRowCounts;
+    for (std::vector<int64_t>::const_iterator iter = sortedRowIndices.begin();
+         iter != sortedRowIndices.end();
+         iter++) {
+        if (( ! uniqueRowIndices.empty())
+            && (uniqueRowIndices.back() == *iter)) {
+            uniqueRowCounts.back() += 1.0;
+        }
+        else {
+            uniqueRowIndices.push_back(*iter);
+            uniqueRowCounts.push_back(1.0);
+        }
+    }
+    
+    const int64_t dataCount = m_ciftiFile->getNumberOfColumns();
+    const int64_t numberOfUniqueRows = static_cast<int64_t>(uniqueRowIndices.size());
+    std::vector<double> rowSum(dataCount, 0.0);
+    
+    if (m_ciftiFile->isInMemory()) {
+#pragma omp CARET_PAR
+        {
+            std::vector<float> rowData(dataCount);
+            std::vector<double> threadRowSum(dataCount, 0.0);
+#pragma omp CARET_FOR schedule(dynamic)
+            for (int64_t i = 0; i < numberOfUniqueRows; i++) {
+                getProcessedDataForRow(&rowData[0],
+                                       uniqueRowIndices[i]);
+                const double count = uniqueRowCounts[i];
+                for (int64_t j = 0; j < dataCount; j++) {
+                    threadRowSum[j] += (rowData[j] * count);
+                }
+            }
+#pragma omp critical
+            {
+                for (int64_t j = 0; j < dataCount; j++) {
+                    rowSum[j] += threadRowSum[j];
+                }
+            }
+        }
+    }
+    else {
+        std::vector<float> rowData(dataCount);
+        for (int64_t i = 0; i < numberOfUniqueRows; i++) {
+            if (progressEvent != NULL) {
+                progressEvent->setProgress(((i * progressEvent->getMaximumProgressValue())
+                                            / numberOfUniqueRows),
+                                           "");
+                EventManager::get()->sendEvent(progressEvent->getPointer());
+                if (progressEvent->isCancelled()) {
+                    return false;
+                }
+            }
+            
+            getRowData(&rowData[0],
+                       uniqueRowIndices[i]);
+            const double count = uniqueRowCounts[i];
+            for (int64_t j = 0; j < dataCount; j++) {
+                rowSum[j] += (rowData[j] * count);
+            }
+        }
+    }
+    
+    const double numberOfRows = rowIndices.size();
+    for (int64_t j = 0; j < dataCount; j++) {
+        dataOut[j] = rowSum[j] / numberOfRows;
+    }
+    
+    return true;
+}
+
+/**
+ * Read rows for the given surface nodes into the row cache in the
+ * background.  Any previous prefetching is stopped.  Prefetching
+ * is only performed for dense files that are not in memory and
+ * are loaded by row.
+ *
+ * @param surfaceNumberOfNodes
+ *    Number of nodes in surface.
+ * @param structure
+ *    Surface's structure.
+ * @param nodeIndices
+ *    Indices of the nodes, typically the neighbors of the
+ *    selected node.
+ */
+void
+CiftiMappableConnectivityMatrixDataFile::prefetchRowsForSurfaceNodes(const int32_t surfaceNumberOfNodes,
+                                                                     const StructureEnum::Enum structure,
+                                                                     const std::vector<int32_t>& nodeIndices)
+{
+    stopRowPrefetch();
+    
+    if (m_ciftiFile == NULL) {
+        return;
+    }
+    if ( ! m_dataLoadingEnabled) {
+        return;
+    }
+    if (getDataFileType() != DataFileTypeEnum::CONNECTIVITY_DENSE) {
+        return;
+    }
+    if ( ! isRowCachingEnabled()) {
+        return;
+    }
+    if (m_ciftiFile->isInMemory()) {
+        return;
+    }
+    
+    std::vector<int64_t> rowIndices;
+    for (std::vector<int32_t>::const_iterator iter = nodeIndices.begin();
+         iter != nodeIndices.end();
+         iter++) {
+        int64_t rowIndex = -1;
+        int64_t columnIndex = -1;
+        getRowColumnIndexForNodeWhenLoading(structure,
+                                            surfaceNumberOfNodes,
+                                            *iter,
+                                            rowIndex,
+                                            columnIndex);
+        if (rowIndex >= 0) {
+            if ( ! getRowFromCache(NULL,
+                                   rowIndex)) {
+                rowIndices.push_back(rowIndex);
+                if (static_cast<int32_t>(rowIndices.size()) >= s_maximumNumberOfPrefetchRows) {
+                    break;
+                }
+            }
+        }
+    }
+    
+    if (rowIndices.empty()) {
+        return;
+    }
+    
+    /*
+     * Sorted rows are in file order
+     */
+    std::sort(rowIndices.begin(),
+              rowIndices.end());
+    m_rowPrefetchRowIndices = rowIndices;
+    m_rowPrefetchCancelled = false;
+    
+    m_rowPrefetchThread = new CiftiConnectivityMatrixRowPrefetchThread(this);
+    m_rowPrefetchThread->start(QThread::LowPriority);
+}
+
+/**
+ * Read the prefetch rows into the row cache.  Runs in
+ * the prefetch thread.
+ */
+void
+CiftiMappableConnectivityMatrixDataFile::prefetchRows()
+{
+    const int64_t dataCount = m_ciftiFile->getNumberOfColumns();
+    std::vector<float> rowData(dataCount);
+    
+    for (std::vector<int64_t>::const_iterator iter = m_rowPrefetchRowIndices.begin();
+         iter != m_rowPrefetchRowIndices.end();
+         iter++) {
+        const int64_t rowIndex = *iter;
+        {
+            CaretMutexLocker locker(&m_rowCacheMutex);
+            if (m_rowPrefetchCancelled) {
+                return;
+            }
+            if (m_rowCacheRowIndices.find(rowIndex) != m_rowCacheRowIndices.end()) {
+                continue;
+            }
+        }
+        
+        CaretMutexLocker readLocker(&m_rowReadMutex);
+        try {
+            getProcessedDataForRow(&rowData[0],
+                                   rowIndex);
+        }
+        catch (const DataFileException& dfe) {
+            CaretLogFine("Prefetch of row "
+                         + AString::number(rowIndex)
+                         + " failed: "
+                         + dfe.whatString());
+            return;
+        }
+        addRowToCache(&rowData[0],
+                      rowIndex);
+    }
+}
+
+/**
+ * Stop prefetching of rows and wait for the prefetch thread to finish.
+ */
+void
+CiftiMappableConnectivityMatrixDataFile::stopRowPrefetch()
+{
+    if (m_rowPrefetchThread == NULL) {
+        return;
+    }
+    
+    {
+        CaretMutexLocker locker(&m_rowCacheMutex);
+        m_rowPrefetchCancelled = true;
+    }
+    m_rowPrefetchThread->wait();
+    delete m_rowPrefetchThread;
+    m_rowPrefetchThread = NULL;
+    m_rowPrefetchRowIndices.clear();
+}
+
 /**
  * Reset the loaded row data to empty.
  * 
@@ -589,6 +1111,8 @@ CiftiMappableConnectivityMatrixDataFile::resetLoadedRowDataToEmpty()
 void
 CiftiMappableConnectivityMatrixDataFile::loadDataForRowIndex(const int64_t rowIndex)
 {
+    stopRowPrefetch();
+    
     setLoadedRowDataToAllZeros();
     
     const int64_t dataCount = m_ciftiFile->getNumberOfColumns();
@@ -603,8 +1127,8 @@ CiftiMappableConnectivityMatrixDataFile::loadDataForRowIndex(const int64_t rowIn
             CaretAssert((rowIndex >= 0) && (rowIndex < m_ciftiFile->getNumberOfRows()));
             m_loadedRowData.resize(dataCount);
             
-            m_ciftiFile->getRow(&m_loadedRowData[0],
-                                rowIndex);
+            getRowData(&m_loadedRowData[0],
+                       rowIndex);
             
             CaretLogFine("Read row " + AString::number(rowIndex));
             m_connectivityDataLoaded->setRowColumnLoading(rowIndex,
@@ -635,6 +1159,8 @@ CiftiMappableConnectivityMatrixDataFile::loadDataForRowIndex(const int64_t rowIn
 void
 CiftiMappableConnectivityMatrixDataFile::loadDataForColumnIndex(const int64_t columnIndex)
 {
+    stopRowPrefetch();
+    
     setLoadedRowDataToAllZeros();
     
     const int64_t dataCount = m_ciftiFile->getNumberOfRows();
@@ -694,6 +1220,8 @@ CiftiMappableConnectivityMatrixDataFile::loadMapDataForSurfaceNode(const int32_t
                                                                    int64_t& rowIndexOut,
                                                                    int64_t& columnIndexOut)
 {
+    stopRowPrefetch();
+    
     rowIndexOut    = -1;
     columnIndexOut = -1;
     
@@ -746,8 +1274,8 @@ CiftiMappableConnectivityMatrixDataFile::loadMapDataForSurfaceNode(const int32_t
                                    + StructureEnum::toGuiName(structure));
                 CaretAssert((rowIndex >= 0) && (rowIndex < m_ciftiFile->getNumberOfRows()));
                 m_loadedRowData.resize(dataCount);
-                m_ciftiFile->getRow(&m_loadedRowData[0],
-                                         rowIndex);
+                getRowData(&m_loadedRowData[0],
+                           rowIndex);
                 
                 CaretLogFine("Read row for node " + AString::number(nodeIndex));
                 
@@ -894,6 +1422,8 @@ CiftiMappableConnectivityMatrixDataFile::loadMapAverageDataForSurfaceNodes(const
                                                                    const StructureEnum::Enum structure,
                                                                    const std::vector<int32_t>& nodeIndices)
 {
+    stopRowPrefetch();
+    
     if (m_ciftiFile == NULL) {
         setLoadedRowDataToAllZeros();
         return;
@@ -918,7 +1448,6 @@ CiftiMappableConnectivityMatrixDataFile::loadMapAverageDataForSurfaceNodes(const
     }
     
     const bool isDenseMatrix = (getDataFileType() == DataFileTypeEnum::CONNECTIVITY_DENSE);
-    const int32_t progressUpdateInterval = 1;
     
     bool dataWasLoaded = false;
     
@@ -948,6 +1477,11 @@ CiftiMappableConnectivityMatrixDataFile::loadMapAverageDataForSurfaceNodes(const
         
         int64_t successCount = 0;
         
+        /*
+         * Rows are averaged when all have been found
+         */
+        std::vector<int64_t> rowIndicesForAverage;
+        
         bool userCancelled = false;
         EventProgressUpdate progressEvent(0,
                                             numberOfNodeIndices,
@@ -959,23 +1493,11 @@ CiftiMappableConnectivityMatrixDataFile::loadMapAverageDataForSurfaceNodes(const
         EventManager::get()->sendEvent(progressEvent.getPointer());
         
         /*
-            * Read rows for each node
+            * Find rows and read columns for each node
             */
         for (int32_t i = 0; i < numberOfNodeIndices; i++) {
             const int32_t nodeIndex = nodeIndices[i];
             
-            if (isDenseMatrix) {
-                if ((i % progressUpdateInterval) == 0) {
-                    progressEvent.setProgress(i,
-                                                "");
-                    EventManager::get()->sendEvent(progressEvent.getPointer());
-                    if (progressEvent.isCancelled()) {
-                        userCancelled = true;
-                        break;
-                    }
-                }
-            }
-            
             int64_t rowIndex = -1;
             int64_t columnIndex = -1;
             getRowColumnIndexForNodeWhenLoading(structure,
@@ -989,11 +1511,7 @@ CiftiMappableConnectivityMatrixDataFile::loadMapAverageDataForSurfaceNodes(const
             
             if (rowIndex >= 0) {
                 CaretAssert((rowIndex >= 0) && (rowIndex < m_ciftiFile->getNumberOfRows()));
-                m_ciftiFile->getRow(dataRowColumn, rowIndex);
-                
-                for (int64_t j = 0; j < dataCount; j++) {
-                    dataAverage[j] += dataRowColumn[j];
-                }
+                rowIndicesForAverage.push_back(rowIndex);
                 successCount++;
                 
                 CaretLogFine("Read row for node " + AString::fromNumbers(nodeIndices, ","));
@@ -1014,6 +1532,28 @@ CiftiMappableConnectivityMatrixDataFile::loadMapAverageDataForSurfaceNodes(const
             }
         }
         
+        if ( ! rowIndicesForAverage.empty()) {
+            /*
+             * Progress is only shown for dense files since reading
+             * rows from other files is fast
+             */
+            if (getAverageOfRows(dataRowColumn,
+                                 rowIndicesForAverage,
+                                 (isDenseMatrix ? &progressEvent : NULL))) {
+                /*
+                 * Weight by number of rows so that the division below
+                 * gives the average of all rows and columns
+                 */
+                const float numberOfRows = rowIndicesForAverage.size();
+                for (int64_t j = 0; j < dataCount; j++) {
+                    dataAverage[j] += (dataRowColumn[j] * numberOfRows);
+                }
+            }
+            else {
+                userCancelled = true;
+            }
+        }
+        
         if (userCancelled) {
             m_loadedRowData.clear();
             m_loadedRowData.resize(dataCount, 0.0);
@@ -1078,6 +1618,8 @@ CiftiMappableConnectivityMatrixDataFile::loadMapDataForVoxelAtCoordinate(const i
                                                                          int64_t& rowIndexOut,
                                                                          int64_t& columnIndexOut)
 {
+    stopRowPrefetch();
+    
     rowIndexOut    = -1;
     columnIndexOut = -1;
     
@@ -1118,7 +1660,8 @@ CiftiMappableConnectivityMatrixDataFile::loadMapDataForVoxelAtCoordinate(const i
         if (dataCount > 0) {
             m_loadedRowData.resize(dataCount);
             CaretAssert((rowIndex >= 0) && (rowIndex < m_ciftiFile->getNumberOfRows()));
-            m_ciftiFile->getRow(&m_loadedRowData[0], rowIndex);
+            getRowData(&m_loadedRowData[0],
+                       rowIndex);
             
             m_rowLoadedTextForMapName = ("Row: "
                                         + AString::number(rowIndex)
@@ -1191,6 +1734,8 @@ CiftiMappableConnectivityMatrixDataFile::loadMapAverageDataForVoxelIndices(const
                                                                            const int64_t volumeDimensionIJK[3],
                                                                            const std::vector<VoxelIJK>& voxelIndices)
 {
+    stopRowPrefetch();
+    
     
     if (mapIndex != 0) { // eliminates compilation warning when compiled for release
         CaretAssert(mapIndex == 0);
@@ -1250,7 +1795,6 @@ CiftiMappableConnectivityMatrixDataFile::loadMapAverageDataForVoxelIndices(const
     const int64_t numberOfVoxelIndices = static_cast<int64_t>(voxelIndices.size());
     
     bool userCancelled = false;
-    const int32_t progressUpdateInterval = 1;
     EventProgressUpdate progressEvent(0,
                                       numberOfVoxelIndices,
                                       0,
@@ -1264,20 +1808,15 @@ CiftiMappableConnectivityMatrixDataFile::loadMapAverageDataForVoxelIndices(const
     std::vector<double> rowColumnSum(dataCount, 0.0);
     
     /*
-     * Load and sum the data for all rows/columns
+     * Rows are averaged when all have been found
+     */
+    std::vector<int64_t> rowIndicesForAverage;
+    
+    /*
+     * Find rows and load and sum the data for all columns
      */
     int64_t numberOfRowColumnsLoaded = 0;
     for (int64_t i = 0; i < numberOfVoxelIndices; i++) {
-        if ((i % progressUpdateInterval) == 0) {
-            progressEvent.setProgress(i,
-                                      "");
-            EventManager::get()->sendEvent(progressEvent.getPointer());
-            if (progressEvent.isCancelled()) {
-                userCancelled = true;
-                break;
-            }
-        }
-        
        const VoxelIJK& voxelIJK = voxelIndices[i];
         
         int64_t rowIndex;
@@ -1287,12 +1826,7 @@ CiftiMappableConnectivityMatrixDataFile::loadMapAverageDataForVoxelIndices(const
                                                   columnIndex);
         if (rowIndex >= 0) {
             CaretAssert((rowIndex >= 0) && (rowIndex < m_ciftiFile->getNumberOfRows()));
-            m_ciftiFile->getRow(&rowColumnData[0],
-                                     rowIndex);
-            
-            for (int64_t j = 0; j < dataCount; j++) {
-                rowColumnSum[j] += rowColumnData[j];
-            }
+            rowIndicesForAverage.push_back(rowIndex);
             
             numberOfRowColumnsLoaded++;
         }
@@ -1309,6 +1843,25 @@ CiftiMappableConnectivityMatrixDataFile::loadMapAverageDataForVoxelIndices(const
         }
     }
     
+    if ( ( ! userCancelled)
+        && ( ! rowIndicesForAverage.empty())) {
+        if (getAverageOfRows(&rowColumnData[0],
+                             rowIndicesForAverage,
+                             &progressEvent)) {
+            /*
+             * Weight by number of rows so that the division below
+             * gives the average of all rows and columns
+             */
+            const double numberOfRows = rowIndicesForAverage.size();
+            for (int64_t j = 0; j < dataCount; j++) {
+                rowColumnSum[j] += (rowColumnData[j] * numberOfRows);
+            }
+        }
+        else {
+            userCancelled = true;
+        }
+    }
+    
     if (userCancelled) {
         m_loadedRowData.clear();
         m_loadedRowData.resize(dataCount, 0.0);
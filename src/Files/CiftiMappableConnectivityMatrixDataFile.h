@@ -21,16 +21,21 @@
  */
 /*LICENSE_END*/
 
+#include <list>
+#include <map>
 #include <set>
 
 #include "BrainConstants.h"
+#include "CaretMutex.h"
 #include "ChartMatrixLoadingDimensionEnum.h"
 #include "CiftiMappableDataFile.h"
 #include "VoxelIJK.h"
 
 namespace caret {
 
+    class CiftiConnectivityMatrixRowPrefetchThread;
     class ConnectivityDataLoaded;
+    class EventProgressUpdate;
     class SceneClassAssistant;
     
     class CiftiMappableConnectivityMatrixDataFile :
@@ -95,6 +100,14 @@ namespace caret {
         bool getParcelNodesElementForSelectedParcel(std::set<int64_t> &parcelNodesOut,
                                                     const StructureEnum::Enum &structure) const;
         
+        void prefetchRowsForSurfaceNodes(const int32_t surfaceNumberOfNodes,
+                                         const StructureEnum::Enum structure,
+                                         const std::vector<int32_t>& nodeIndices);
+        
+        int64_t getRowCacheMaximumBytes() const;
+        
+        void setRowCacheMaximumBytes(const int64_t maximumBytes);
+        
     private:
         CiftiMappableConnectivityMatrixDataFile(const CiftiMappableConnectivityMatrixDataFile&);
 
@@ -117,6 +130,18 @@ namespace caret {
         virtual void restoreSubClassDataFromScene(const SceneAttributes* sceneAttributes,
                                                   const SceneClass* sceneClass);
 
+        virtual void getProcessedDataForRow(float* dataOut,
+                                            const int64_t& index) const;
+        
+        virtual bool isRowAverageComputedDirectly() const;
+        
+        virtual void getProcessedDataForRowAverage(float* dataOut,
+                                                   const std::vector<int64_t>& rowIndices) const;
+        
+        void invalidateRowCache();
+        
+        void stopRowPrefetch();
+        
         void resetLoadedRowDataToEmpty();
         
         ChartMatrixLoadingDimensionEnum::Enum getChartMatrixLoadingDimension() const;
@@ -124,8 +149,32 @@ namespace caret {
         void setChartMatrixLoadingDimension(const ChartMatrixLoadingDimensionEnum::Enum matrixLoadingType);
         
     private:
+        /** A row in the row cache */
+        struct RowCacheEntry {
+            int64_t m_rowIndex;
+            
+            std::vector<float> m_data;
+        };
+        
         void setLoadedRowDataToAllZeros();
         
+        bool isRowCachingEnabled() const;
+        
+        void getRowData(float* dataOut,
+                        const int64_t rowIndex) const;
+        
+        bool getRowFromCache(float* dataOut,
+                             const int64_t rowIndex) const;
+        
+        void addRowToCache(const float* data,
+                           const int64_t rowIndex) const;
+        
+        bool getAverageOfRows(float* dataOut,
+                              const std::vector<int64_t>& rowIndices,
+                              EventProgressUpdate* progressEvent) const;
+        
+        void prefetchRows();
+        
         void clearPrivate();
         
 //        int64_t getRowIndexForNodeWhenLoading(const StructureEnum::Enum structure,
@@ -174,12 +223,42 @@ namespace caret {
          */
         ChartMatrixLoadingDimensionEnum::Enum m_chartLoadingDimension;
         
+        /** Recently used rows, most recently used at front */
+        mutable std::list<RowCacheEntry> m_rowCache;
+        
+        /** Position of a row in the row cache */
+        mutable std::map<int64_t, std::list<RowCacheEntry>::iterator> m_rowCacheRowIndices;
+        
+        mutable int64_t m_rowCacheBytes;
+        
+        int64_t m_rowCacheMaximumBytes;
+        
+        /** Protects the row cache and the prefetch cancellation status */
+        mutable CaretMutex m_rowCacheMutex;
+        
+        /** Serializes reading of rows from the file */
+        mutable CaretMutex m_rowReadMutex;
+        
+        CiftiConnectivityMatrixRowPrefetchThread* m_rowPrefetchThread;
+        
+        std::vector<int64_t> m_rowPrefetchRowIndices;
+        
+        bool m_rowPrefetchCancelled;
+        
+        static const int64_t s_defaultRowCacheMaximumBytes;
+        
+        static const int32_t s_maximumNumberOfPrefetchRows;
+        
         friend class CiftiBrainordinateScalarFile;
+        
+        friend class CiftiConnectivityMatrixRowPrefetchThread;
 
     };
     
 #ifdef __CIFTI_MAPPABLE_CONNECTIVITY_MATRIX_DATA_FILE_DECLARE__
-    // <PLACE DECLARATIONS OF STATIC MEMBERS HERE>
+    const int64_t CiftiMappableConnectivityMatrixDataFile::s_defaultRowCacheMaximumBytes = 256 * 1024 * 1024;
+    
+    const int32_t CiftiMappableConnectivityMatrixDataFile::s_maximumNumberOfPrefetchRows = 64;
 #endif // __CIFTI_MAPPABLE_CONNECTIVITY_MATRIX_DATA_FILE_DECLARE__
 
 } // namespace
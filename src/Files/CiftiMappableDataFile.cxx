@@ -33,6 +33,7 @@
 #include "CiftiFiberTrajectoryFile.h"
 #include "CiftiFile.h"
 #include "CiftiMappableConnectivityMatrixDataFile.h"
+#include "CiftiMatrixPyramid.h"
 #include "CiftiParcelLabelFile.h"
 #include "CaretTemporaryFile.h"
 #include "CiftiXML.h"
@@ -92,6 +93,7 @@ CiftiMappableDataFile::CiftiMappableDataFile(const DataFileTypeEnum::Enum dataFi
     m_fileFastStatistics.grabNew(NULL);
     m_fileHistogram.grabNew(NULL);
     m_fileHistorgramLimitedValues.grabNew(NULL);
+    m_matrixPyramid.grabNew(NULL);
     
     /*
      * Note: The first palette normalization mode is assumed to
@@ -770,6 +772,9 @@ CiftiMappableDataFile::setupCiftiReadingMappingDirection()
  *
  * @param filename
  *     Name of file.
+ * @throw DataFileException
+ *     If the file's mappings are invalid or its map metadata or
+ *     label tables cannot be decoded.
  */
 void
 CiftiMappableDataFile::initializeAfterReading(const AString& filename)
@@ -922,15 +927,25 @@ CiftiMappableDataFile::initializeAfterReading(const AString& filename)
     }
     
     /*
-     * Get data for maps.
+     * Get data for maps.  CIFTI map metadata and label tables are
+     * decoded when first used, and this is where all of them are
+     * first used, so an error in any of them is reported here, while
+     * opening the file, rather than by the map metadata and label
+     * table accessors used by the GUI.
      */
-    for (int32_t i = 0; i < numberOfMaps; i++) {
-        MapContent* mc = new MapContent(m_ciftiFile,
-                                        m_fileMapDataType,
-                                        m_dataReadingDirectionForCiftiXML,
-                                        m_dataMappingDirectionForCiftiXML,
-                                        i);
-        m_mapContent.push_back(mc);
+    try {
+        for (int32_t i = 0; i < numberOfMaps; i++) {
+            MapContent* mc = new MapContent(m_ciftiFile,
+                                            m_fileMapDataType,
+                                            m_dataReadingDirectionForCiftiXML,
+                                            m_dataMappingDirectionForCiftiXML,
+                                            i);
+            m_mapContent.push_back(mc);
+        }
+    }
+    catch (const CaretException& e) {
+        throw DataFileException(filename,
+                                e.whatString());
     }
     
     m_classNameHierarchy->update(this,
@@ -941,6 +956,7 @@ CiftiMappableDataFile::initializeAfterReading(const AString& filename)
     m_fileFastStatistics.grabNew(NULL);
     m_fileHistogram.grabNew(NULL);
     m_fileHistorgramLimitedValues.grabNew(NULL);
+    m_matrixPyramid.grabNew(NULL);
     
     CaretLogFiner("CLASS/NAME Table for : "
                   + this->getFileNameNoPath()
@@ -1283,6 +1299,7 @@ CiftiMappableDataFile::updateForChangeInMapDataWithMapIndex(const int32_t mapInd
 {
     CaretAssertVectorIndex(m_mapContent, mapIndex);
     m_mapContent[mapIndex]->updateForChangeInMapData();
+    m_matrixPyramid.grabNew(NULL);
 }
 
 
@@ -5472,21 +5489,10 @@ CiftiMappableDataFile::helpMatrixFileLoadChartDataMatrixRGBA(int32_t& numberOfRo
      * Get palette for color mapping.
      */
     if (isMappedWithPalette()) {
-        const CiftiXML& ciftiXML = m_ciftiFile->getCiftiXML();
-        const PaletteColorMapping* pcm = ciftiXML.getFilePalette();
-        CaretAssert(pcm);
-        const AString paletteName = pcm->getSelectedPaletteName();
-        if (paletteName.isEmpty()) {
-            CaretLogSevere("No palette name for coloring matrix chart data.");
-            return false;
-        }
-        EventPaletteGetByName eventPaletteGetName(paletteName);
-        EventManager::get()->sendEvent(eventPaletteGetName.getPointer());
-        const Palette* palette = eventPaletteGetName.getPalette();
-        if (palette == NULL) {
-            CaretLogSevere("No palette named "
-                           + paletteName
-                           + " found for coloring matrix chart data.");
+        const PaletteColorMapping* pcm = NULL;
+        const Palette* palette = NULL;
+        if ( ! getMatrixChartPalette(pcm,
+                                     palette)) {
             return false;
         }
         
@@ -5521,6 +5527,146 @@ CiftiMappableDataFile::helpMatrixFileLoadChartDataMatrixRGBA(int32_t& numberOfRo
 }
 
 
+/**
+ * Get the palette for coloring a matrix chart of the file's data.
+ *
+ * @param paletteColorMappingOut
+ *    Output with the file's palette color mapping.
+ * @param paletteOut
+ *    Output with the palette selected in the color mapping.
+ * @return
+ *    True if the palette was found, else false.
+ */
+bool
+CiftiMappableDataFile::getMatrixChartPalette(const PaletteColorMapping*& paletteColorMappingOut,
+                                             const Palette*& paletteOut) const
+{
+    const CiftiXML& ciftiXML = m_ciftiFile->getCiftiXML();
+    paletteColorMappingOut = ciftiXML.getFilePalette();
+    CaretAssert(paletteColorMappingOut);
+    const AString paletteName = paletteColorMappingOut->getSelectedPaletteName();
+    if (paletteName.isEmpty()) {
+        CaretLogSevere("No palette name for coloring matrix chart data.");
+        return false;
+    }
+    EventPaletteGetByName eventPaletteGetName(paletteName);
+    EventManager::get()->sendEvent(eventPaletteGetName.getPointer());
+    paletteOut = eventPaletteGetName.getPalette();
+    if (paletteOut == NULL) {
+        CaretLogSevere("No palette named "
+                       + paletteName
+                       + " found for coloring matrix chart data.");
+        return false;
+    }
+    
+    return true;
+}
+
+/**
+ * Get the RGBA coloring for a region of the matrix at a resolution level,
+ * for files that contain a matrix.  Only the cells in the region are
+ * colored, and they are read from reduced resolution levels of the
+ * matrix (see CiftiMatrixPyramid) that are created the first time this
+ * is called.  Each cell is colored with the mean of the matrix cells it
+ * covers.
+ *
+ * @param resolutionLevel
+ *    The resolution level, zero for the full resolution matrix.
+ * @param firstRow
+ *    First row of the region, in cells of the level.
+ * @param firstColumn
+ *    First column of the region, in cells of the level.
+ * @param numberOfRows
+ *    Number of rows in the region.
+ * @param numberOfColumns
+ *    Number of columns in the region.
+ * @param rowIndices
+ *    Indices of rows inserted into matrix, empty for file order.
+ * @param rgbaOut
+ *    RGBA coloring output with number of elements
+ *    (numberOfRows * numberOfColumns * 4).
+ * @return
+ *    True if output data is valid, else false.
+ */
+bool
+CiftiMappableDataFile::helpMatrixFileLoadChartDataMatrixRGBAForRegion(const int32_t resolutionLevel,
+                                                                      const int32_t firstRow,
+                                                                      const int32_t firstColumn,
+                                                                      const int32_t numberOfRows,
+                                                                      const int32_t numberOfColumns,
+                                                                      const std::vector<int32_t>& rowIndices,
+                                                                      std::vector<uint8_t>& rgbaOut) const
+{
+    CaretAssert(m_ciftiFile);
+    
+    if ( ! isMappedWithPalette()) {
+        return false;
+    }
+    if ((numberOfRows <= 0)
+        || (numberOfColumns <= 0)) {
+        return false;
+    }
+    if (( ! rowIndices.empty())
+        && (static_cast<int64_t>(rowIndices.size()) != m_ciftiFile->getNumberOfRows())) {
+        CaretLogSevere(AString("rowIndices size=%1 is different than "
+                               "number of rows in the matrix=%2.").arg(rowIndices.size()).arg(m_ciftiFile->getNumberOfRows()));
+        return false;
+    }
+    
+    if ((m_matrixPyramid == NULL)
+        || ( ! m_matrixPyramid->isForRowIndices(rowIndices))) {
+        m_matrixPyramid.grabNew(new CiftiMatrixPyramid(m_ciftiFile,
+                                                       rowIndices));
+    }
+    if (resolutionLevel >= m_matrixPyramid->getNumberOfLevels()) {
+        return false;
+    }
+    int64_t levelRows, levelColumns;
+    m_matrixPyramid->getLevelDimensions(resolutionLevel,
+                                        levelRows,
+                                        levelColumns);
+    if ((firstRow < 0)
+        || (firstColumn < 0)
+        || ((firstRow + numberOfRows) > levelRows)
+        || ((firstColumn + numberOfColumns) > levelColumns)) {
+        return false;
+    }
+    
+    const PaletteColorMapping* pcm = NULL;
+    const Palette* palette = NULL;
+    if ( ! getMatrixChartPalette(pcm,
+                                 palette)) {
+        return false;
+    }
+    
+    std::vector<float> data;
+    m_matrixPyramid->getRegion(resolutionLevel,
+                               firstRow,
+                               firstColumn,
+                               numberOfRows,
+                               numberOfColumns,
+                               CiftiMatrixPyramid::REDUCTION_MEAN,
+                               data);
+    
+    /*
+     * Statistics from the pyramid, since getFileFastStatistics() would
+     * read the whole matrix
+     */
+    const FastStatistics* fileFastStats = m_matrixPyramid->getFastStatistics();
+    
+    const int64_t numberOfData = static_cast<int64_t>(data.size());
+    rgbaOut.resize(numberOfData * 4);
+    NodeAndVoxelColoring::colorScalarsWithPalette(fileFastStats,
+                                                  pcm,
+                                                  palette,
+                                                  &data[0],
+                                                  &data[0],
+                                                  numberOfData,
+                                                  &rgbaOut[0]);
+    
+    return true;
+}
+
 ///* ========================================================================== */
 
 /**
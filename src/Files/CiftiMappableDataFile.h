@@ -36,11 +36,14 @@ namespace caret {
     class ChartData;
     class ChartDataCartesian;
     class CiftiFile;
+    class CiftiMatrixPyramid;
     class CiftiParcelsMap;
     class CiftiXML;
     class FastStatistics;
     class GroupAndNameHierarchyModel;
     class Histogram;
+    class Palette;
+    class PaletteColorMapping;
     class SparseVolumeIndexer;
 
     
@@ -455,6 +458,17 @@ namespace caret {
                                                    const std::vector<int32_t>& rowIndicesIn,
                                                    std::vector<float>& rgbaOut) const;
         
+        bool helpMatrixFileLoadChartDataMatrixRGBAForRegion(const int32_t resolutionLevel,
+                                                            const int32_t firstRow,
+                                                            const int32_t firstColumn,
+                                                            const int32_t numberOfRows,
+                                                            const int32_t numberOfColumns,
+                                                            const std::vector<int32_t>& rowIndices,
+                                                            std::vector<uint8_t>& rgbaOut) const;
+        
+        bool getMatrixChartPalette(const PaletteColorMapping*& paletteColorMappingOut,
+                                   const Palette*& paletteOut) const;
+        
 //        bool helpLoadChartDataMatrixRGBA(int32_t& numberOfRowsOut,
 //                                         int32_t& numberOfColumnsOut,
 //                                         std::vector<float>& rgbaOut) const;
@@ -663,6 +677,9 @@ namespace caret {
         /** Fast statistics used when statistics computed on all data in file */
         CaretPointer<FastStatistics> m_fileFastStatistics;
         
+        /** Reduced resolution levels of the matrix for drawing large matrix charts */
+        mutable CaretPointer<CiftiMatrixPyramid> m_matrixPyramid;
+        
         /** Histogram used when statistics computed on all data in file */
         CaretPointer<Histogram> m_fileHistogram;
         
@@ -0,0 +1,586 @@
+
+/*LICENSE_START*/
+/*
+ *  Copyright (C) 2014  Washington University School of Medicine
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+/*LICENSE_END*/
+
+#define __CIFTI_MATRIX_PYRAMID_DECLARE__
+#include "CiftiMatrixPyramid.h"
+#undef __CIFTI_MATRIX_PYRAMID_DECLARE__
+
+#include <algorithm>
+#include <limits>
+
+#include "CaretAssert.h"
+#include "CiftiFile.h"
+
+using namespace caret;
+
+
+
+/**
+ * \class caret::CiftiMatrixPyramid
+ * \brief Reduced resolution levels of a CIFTI matrix for drawing matrix charts.
+ *
+ * Each cell at level L covers a block of 2^L by 2^L cells of the matrix
+ * and has the minimum, maximum, and mean of the cells it covers.  Coarse
+ * levels, starting with the first level that has no more than
+ * s_maximumStoredCells cells, are computed once by streaming through the
+ * rows of the file.  Finer levels, including the full resolution matrix,
+ * are read from the file in tiles when a region of them is requested,
+ * and the most recently used tiles are kept.  So, drawing a region at
+ * about one matrix cell per pixel never needs the whole matrix in memory.
+ *
+ * Rows are in the order used for display: row i of the file is row
+ * rowIndices[i] of the pyramid, as in matrix chart coloring.
+ */
+
+/**
+ * Constructor.
+ *
+ * @param ciftiFile
+ *    The two-dimensional CIFTI file, which must remain valid for the
+ *    lifetime of this instance.
+ * @param rowIndices
+ *    Display row for each row of the file, empty for file order.
+ */
+CiftiMatrixPyramid::CiftiMatrixPyramid(const CiftiFile* ciftiFile,
+                                       const std::vector<int32_t>& rowIndices)
+: CaretObject(),
+m_ciftiFile(ciftiFile),
+m_rowIndices(rowIndices)
+{
+    CaretAssert(ciftiFile);
+    m_numberOfRows    = ciftiFile->getNumberOfRows();
+    m_numberOfColumns = ciftiFile->getNumberOfColumns();
+    m_tileUseCounter  = 0;
+    
+    m_fileRowForRow.resize(m_numberOfRows);
+    for (int64_t i = 0; i < m_numberOfRows; i++) {
+        if (m_rowIndices.empty()) {
+            m_fileRowForRow[i] = i;
+        }
+        else {
+            CaretAssertVectorIndex(m_rowIndices, i);
+            CaretAssertVectorIndex(m_fileRowForRow, m_rowIndices[i]);
+            m_fileRowForRow[m_rowIndices[i]] = i;
+        }
+    }
+    
+    /*
+     * The last level is a single cell
+     */
+    m_numberOfLevels = 1;
+    while (((m_numberOfRows - 1) >> (m_numberOfLevels - 1)) > 0
+           || ((m_numberOfColumns - 1) >> (m_numberOfLevels - 1)) > 0) {
+        m_numberOfLevels++;
+    }
+    
+    m_firstStoredLevel = std::min(1, m_numberOfLevels - 1);
+    while (m_firstStoredLevel < (m_numberOfLevels - 1)) {
+        int64_t levelRows, levelColumns;
+        getLevelDimensions(m_firstStoredLevel, levelRows, levelColumns);
+        if ((levelRows * levelColumns) <= s_maximumStoredCells) {
+            break;
+        }
+        m_firstStoredLevel++;
+    }
+    
+    buildStoredLevels();
+}
+
+/**
+ * Destructor.
+ */
+CiftiMatrixPyramid::~CiftiMatrixPyramid()
+{
+}
+
+/**
+ * @return True if this pyramid was built with the given row reordering.
+ *
+ * @param rowIndices
+ *    Display row for each row of the file, empty for file order.
+ */
+bool
+CiftiMatrixPyramid::isForRowIndices(const std::vector<int32_t>& rowIndices) const
+{
+    return (rowIndices == m_rowIndices);
+}
+
+/**
+ * @return Number of levels, level zero is the full resolution matrix and
+ * the last level is a single cell.
+ */
+int32_t
+CiftiMatrixPyramid::getNumberOfLevels() const
+{
+    return m_numberOfLevels;
+}
+
+/**
+ * Get the number of rows and columns of cells at a level.
+ *
+ * @param level
+ *    Index of the level.
+ * @param numberOfRowsOut
+ *    Output with number of rows.
+ * @param numberOfColumnsOut
+ *    Output with number of columns.
+ */
+void
+CiftiMatrixPyramid::getLevelDimensions(const int32_t level,
+                                       int64_t& numberOfRowsOut,
+                                       int64_t& numberOfColumnsOut) const
+{
+    CaretAssert((level >= 0) && (level < m_numberOfLevels));
+    const int64_t cellSize = (int64_t(1) << level);
+    numberOfRowsOut    = (m_numberOfRows    + cellSize - 1) >> level;
+    numberOfColumnsOut = (m_numberOfColumns + cellSize - 1) >> level;
+}
+
+/**
+ * @return Number of matrix rows (or columns) covered by a cell, which is
+ * less than 2^level for the last cell of a level.
+ *
+ * @param level
+ *    Index of the level.
+ * @param levelIndex
+ *    Row (or column) of the cell in the level.
+ * @param fullSize
+ *    Number of rows (or columns) in the matrix.
+ */
+int64_t
+CiftiMatrixPyramid::getNumberOfCellsCovered(const int32_t level,
+                                            const int64_t levelIndex,
+                                            const int64_t fullSize) const
+{
+    return std::min((levelIndex + 1) << level, fullSize) - (levelIndex << level);
+}
+
+/**
+ * @return The values of a block for the given reduction.
+ */
+const std::vector<float>&
+CiftiMatrixPyramid::getValues(const CellBlock& block,
+                              const Reduction reduction)
+{
+    switch (reduction) {
+        case REDUCTION_MINIMUM:
+            return block.m_minimum;
+        case REDUCTION_MAXIMUM:
+            return block.m_maximum;
+        case REDUCTION_MEAN:
+            break;
+    }
+    return block.m_mean;
+}
+
+/**
+ * @return Statistics of all cells of the full resolution matrix, for
+ * palette coloring without reading the whole matrix again.
+ */
+const FastStatistics*
+CiftiMatrixPyramid::getFastStatistics() const
+{
+    return &m_fastStatistics;
+}
+
+/**
+ * Get the values of a region of a level, with the first row at the top,
+ * as in matrix charts.
+ *
+ * @param level
+ *    Index of the level.
+ * @param firstRow
+ *    First row of the region, in cells of the level.
+ * @param firstColumn
+ *    First column of the region, in cells of the level.
+ * @param numberOfRows
+ *    Number of rows in the region.
+ * @param numberOfColumns
+ *    Number of columns in the region.
+ * @param reduction
+ *    How the matrix cells covered by a cell are combined.
+ * @param dataOut
+ *    Output containing (numberOfRows * numberOfColumns) values, row by row.
+ */
+void
+CiftiMatrixPyramid::getRegion(const int32_t level,
+                              const int64_t firstRow,
+                              const int64_t firstColumn,
+                              const int64_t numberOfRows,
+                              const int64_t numberOfColumns,
+                              const Reduction reduction,
+                              std::vector<float>& dataOut)
+{
+    CaretAssert((level >= 0) && (level < m_numberOfLevels));
+    dataOut.resize(numberOfRows * numberOfColumns);
+    if ((numberOfRows <= 0)
+        || (numberOfColumns <= 0)) {
+        return;
+    }
+    
+    if (level >= m_firstStoredLevel) {
+        CaretAssertVectorIndex(m_storedLevels, level - m_firstStoredLevel);
+        const CellBlock& block = m_storedLevels[level - m_firstStoredLevel];
+        CaretAssert((firstRow + numberOfRows) <= block.m_numberOfRows);
+        CaretAssert((firstColumn + numberOfColumns) <= block.m_numberOfColumns);
+        const std::vector<float>& values = getValues(block, reduction);
+        for (int64_t i = 0; i < numberOfRows; i++) {
+            const float* rowValues = &values[(firstRow + i) * block.m_numberOfColumns + firstColumn];
+            std::copy(rowValues, rowValues + numberOfColumns, &dataOut[i * numberOfColumns]);
+        }
+        return;
+    }
+    
+    const int64_t lastRow    = firstRow + numberOfRows - 1;
+    const int64_t lastColumn = firstColumn + numberOfColumns - 1;
+    const int64_t firstTileColumn = firstColumn / s_tileSize;
+    const int64_t lastTileColumn  = lastColumn / s_tileSize;
+    for (int64_t tileRow = firstRow / s_tileSize; tileRow <= lastRow / s_tileSize; tileRow++) {
+        /*
+         * Tiles in a row of tiles cover the same matrix rows, so read
+         * those rows once for all of the tiles that are not cached
+         */
+        std::vector<int64_t> missingTileColumns;
+        for (int64_t tileColumn = firstTileColumn; tileColumn <= lastTileColumn; tileColumn++) {
+            if (m_tiles.find(getTileKey(level, tileRow, tileColumn)) == m_tiles.end()) {
+                missingTileColumns.push_back(tileColumn);
+            }
+        }
+        std::vector<CellBlock> loadedTiles;
+        if ( ! missingTileColumns.empty()) {
+            loadTileBand(level, tileRow, missingTileColumns, loadedTiles);
+        }
+        
+        int64_t nextLoaded = 0;
+        for (int64_t tileColumn = firstTileColumn; tileColumn <= lastTileColumn; tileColumn++) {
+            const int64_t key = getTileKey(level, tileRow, tileColumn);
+            CellBlock* loadedTile = NULL;
+            const CellBlock* tile = NULL;
+            if ((nextLoaded < static_cast<int64_t>(missingTileColumns.size()))
+                && (missingTileColumns[nextLoaded] == tileColumn)) {
+                loadedTile = &loadedTiles[nextLoaded];
+                tile = loadedTile;
+                nextLoaded++;
+            }
+            else {
+                tile = findTile(key);
+            }
+            CaretAssert(tile);
+            const std::vector<float>& values = getValues(*tile, reduction);
+            
+            /*
+             * Part of the tile inside the region, in cells of the level
+             */
+            const int64_t rowStart    = std::max(firstRow, tileRow * s_tileSize);
+            const int64_t rowEnd      = std::min(lastRow + 1, tileRow * s_tileSize + tile->m_numberOfRows);
+            const int64_t columnStart = std::max(firstColumn, tileColumn * s_tileSize);
+            const int64_t columnEnd   = std::min(lastColumn + 1, tileColumn * s_tileSize + tile->m_numberOfColumns);
+            for (int64_t row = rowStart; row < rowEnd; row++) {
+                const float* rowValues = &values[(row - tileRow * s_tileSize) * tile->m_numberOfColumns
+                                                 + (columnStart - tileColumn * s_tileSize)];
+                std::copy(rowValues,
+                          rowValues + (columnEnd - columnStart),
+                          &dataOut[(row - firstRow) * numberOfColumns + (columnStart - firstColumn)]);
+            }
+            
+            /*
+             * Cache a new tile only after it is copied, since caching
+             * it may remove other tiles
+             */
+            if (loadedTile != NULL) {
+                storeTile(key, *loadedTile);
+            }
+        }
+    }
+}
+
+/**
+ * Compute the stored levels, streaming through the file once for the
+ * finest of them and reducing it for the others.  The statistics of the
+ * matrix are accumulated during the same pass.
+ */
+void
+CiftiMatrixPyramid::buildStoredLevels()
+{
+    const int32_t numberOfStoredLevels = m_numberOfLevels - m_firstStoredLevel;
+    m_storedLevels.resize(numberOfStoredLevels);
+    
+    const int32_t level = m_firstStoredLevel;
+    CellBlock& block = m_storedLevels[0];
+    getLevelDimensions(level, block.m_numberOfRows, block.m_numberOfColumns);
+    const int64_t numberOfCells = block.m_numberOfRows * block.m_numberOfColumns;
+    block.m_minimum.assign(numberOfCells, std::numeric_limits<float>::max());
+    block.m_maximum.assign(numberOfCells, -std::numeric_limits<float>::max());
+    std::vector<double> sums(numberOfCells, 0.0);
+    
+    const int64_t rowsPerRead = std::min(CiftiFile::getRowBlockSize(m_numberOfColumns), m_numberOfRows);
+    std::vector<float> rowData(rowsPerRead * m_numberOfColumns);
+    m_fastStatistics.startAccumulating();
+    for (int64_t startRow = 0; startRow < m_numberOfRows; startRow += rowsPerRead) {
+        const int64_t numberOfRowsRead = std::min(rowsPerRead, m_numberOfRows - startRow);
+        m_ciftiFile->getRows(&rowData[0], startRow, numberOfRowsRead);
+        m_fastStatistics.accumulate(&rowData[0],
+                                    numberOfRowsRead * m_numberOfColumns);
+        for (int64_t i = 0; i < numberOfRowsRead; i++) {
+            const int64_t fileRow = startRow + i;
+            const int64_t row = (m_rowIndices.empty()
+                                 ? fileRow
+                                 : m_rowIndices[fileRow]);
+            const int64_t cellRowOffset = (row >> level) * block.m_numberOfColumns;
+            const float* values = &rowData[i * m_numberOfColumns];
+            for (int64_t j = 0; j < m_numberOfColumns; j++) {
+                const int64_t cell = cellRowOffset + (j >> level);
+                const float value = values[j];
+                if (value < block.m_minimum[cell]) block.m_minimum[cell] = value;
+                if (value > block.m_maximum[cell]) block.m_maximum[cell] = value;
+                sums[cell] += value;
+            }
+        }
+    }
+    
+    m_fastStatistics.finishAccumulating();
+    
+    block.m_mean.resize(numberOfCells);
+    for (int64_t i = 0; i < block.m_numberOfRows; i++) {
+        const int64_t rowsCovered = getNumberOfCellsCovered(level, i, m_numberOfRows);
+        for (int64_t j = 0; j < block.m_numberOfColumns; j++) {
+            const int64_t cell = i * block.m_numberOfColumns + j;
+            block.m_mean[cell] = sums[cell] / (rowsCovered * getNumberOfCellsCovered(level, j, m_numberOfColumns));
+        }
+    }
+    
+    for (int32_t i = 1; i < numberOfStoredLevels; i++) {
+        reduceBlock(m_firstStoredLevel + i - 1,
+                    m_storedLevels[i - 1],
+                    m_storedLevels[i]);
+    }
+}
+
+/**
+ * Reduce a whole level to the next coarser level.
+ *
+ * @param finerLevel
+ *    Index of the level that is reduced.
+ * @param finer
+ *    All cells of the finer level.
+ * @param coarserOut
+ *    Output with all cells of the next level.
+ */
+void
+CiftiMatrixPyramid::reduceBlock(const int32_t finerLevel,
+                                const CellBlock& finer,
+                                CellBlock& coarserOut) const
+{
+    getLevelDimensions(finerLevel + 1, coarserOut.m_numberOfRows, coarserOut.m_numberOfColumns);
+    const int64_t numberOfCells = coarserOut.m_numberOfRows * coarserOut.m_numberOfColumns;
+    coarserOut.m_minimum.resize(numberOfCells);
+    coarserOut.m_maximum.resize(numberOfCells);
+    coarserOut.m_mean.resize(numberOfCells);
+    for (int64_t i = 0; i < coarserOut.m_numberOfRows; i++) {
+        const int64_t finerRowEnd = std::min(2 * i + 2, finer.m_numberOfRows);
+        for (int64_t j = 0; j < coarserOut.m_numberOfColumns; j++) {
+            const int64_t finerColumnEnd = std::min(2 * j + 2, finer.m_numberOfColumns);
+            float minimum = std::numeric_limits<float>::max();
+            float maximum = -std::numeric_limits<float>::max();
+            double sum = 0.0;
+            int64_t count = 0;
+            for (int64_t fi = 2 * i; fi < finerRowEnd; fi++) {
+                const int64_t rowsCovered = getNumberOfCellsCovered(finerLevel, fi, m_numberOfRows);
+                for (int64_t fj = 2 * j; fj < finerColumnEnd; fj++) {
+                    const int64_t finerCell = fi * finer.m_numberOfColumns + fj;
+                    const int64_t cellsCovered = rowsCovered * getNumberOfCellsCovered(finerLevel, fj, m_numberOfColumns);
+                    minimum = std::min(minimum, finer.m_minimum[finerCell]);
+                    maximum = std::max(maximum, finer.m_maximum[finerCell]);
+                    sum   += double(finer.m_mean[finerCell]) * cellsCovered;
+                    count += cellsCovered;
+                }
+            }
+            const int64_t cell = i * coarserOut.m_numberOfColumns + j;
+            coarserOut.m_minimum[cell] = minimum;
+            coarserOut.m_maximum[cell] = maximum;
+            coarserOut.m_mean[cell]    = sum / count;
+        }
+    }
+}
+
+/**
+ * @return Key of a tile in the tile cache.
+ *
+ * @param level
+ *    Index of the level.
+ * @param tileRow
+ *    Row of the tile.
+ * @param tileColumn
+ *    Column of the tile.
+ */
+int64_t
+CiftiMatrixPyramid::getTileKey(const int32_t level,
+                               const int64_t tileRow,
+                               const int64_t tileColumn)
+{
+    return ((int64_t(level) << 56)
+            | (tileRow << 28)
+            | tileColumn);
+}
+
+/**
+ * Find a recently used tile and mark it as used.
+ *
+ * @param key
+ *    Key of the tile.
+ * @return
+ *    The tile, valid until the next call to storeTile(), or NULL if it
+ *    is not cached.
+ */
+const CiftiMatrixPyramid::CellBlock*
+CiftiMatrixPyramid::findTile(const int64_t key)
+{
+    std::map<int64_t, CellBlock>::iterator iter = m_tiles.find(key);
+    if (iter == m_tiles.end()) {
+        return NULL;
+    }
+    m_tileUseCounter++;
+    iter->second.m_lastUsed = m_tileUseCounter;
+    return &iter->second;
+}
+
+/**
+ * Add a tile to the recently used tiles, removing the least recently
+ * used tile if there are too many.
+ *
+ * @param key
+ *    Key of the tile.
+ * @param tile
+ *    The tile, its contents are moved into the cache.
+ */
+void
+CiftiMatrixPyramid::storeTile(const int64_t key,
+                              CellBlock& tile)
+{
+    if (static_cast<int64_t>(m_tiles.size()) >= s_maximumNumberOfTiles) {
+        std::map<int64_t, CellBlock>::iterator oldestIter = m_tiles.begin();
+        for (std::map<int64_t, CellBlock>::iterator tileIter = m_tiles.begin();
+             tileIter != m_tiles.end();
+             tileIter++) {
+            if (tileIter->second.m_lastUsed < oldestIter->second.m_lastUsed) {
+                oldestIter = tileIter;
+            }
+        }
+        m_tiles.erase(oldestIter);
+    }
+    
+    m_tileUseCounter++;
+    CellBlock& cached = m_tiles[key];
+    cached.m_numberOfRows    = tile.m_numberOfRows;
+    cached.m_numberOfColumns = tile.m_numberOfColumns;
+    cached.m_minimum.swap(tile.m_minimum);
+    cached.m_maximum.swap(tile.m_maximum);
+    cached.m_mean.swap(tile.m_mean);
+    cached.m_lastUsed = m_tileUseCounter;
+}
+
+/**
+ * Read the matrix rows covered by a row of tiles once, and reduce them
+ * into the given tiles of that row.  Only the columns of the given
+ * tiles are reduced.
+ *
+ * @param level
+ *    Index of the level.
+ * @param tileRow
+ *    Row of the tiles.
+ * @param tileColumns
+ *    Columns of the tiles to load, in increasing order.
+ * @param tilesOut
+ *    Output with a tile for each of tileColumns.
+ */
+void
+CiftiMatrixPyramid::loadTileBand(const int32_t level,
+                                 const int64_t tileRow,
+                                 const std::vector<int64_t>& tileColumns,
+                                 std::vector<CellBlock>& tilesOut) const
+{
+    int64_t levelRows, levelColumns;
+    getLevelDimensions(level, levelRows, levelColumns);
+    const int64_t firstRow = tileRow * s_tileSize;
+    CaretAssert(firstRow < levelRows);
+    const int64_t numberOfTileRows = std::min(s_tileSize, levelRows - firstRow);
+    
+    const int64_t numberOfTiles = static_cast<int64_t>(tileColumns.size());
+    tilesOut.resize(numberOfTiles);
+    std::vector<std::vector<double> > sums(numberOfTiles);
+    std::vector<int64_t> matrixColumnStarts(numberOfTiles), matrixColumnEnds(numberOfTiles);
+    for (int64_t t = 0; t < numberOfTiles; t++) {
+        const int64_t firstColumn = tileColumns[t] * s_tileSize;
+        CaretAssert(firstColumn < levelColumns);
+        CellBlock& tile = tilesOut[t];
+        tile.m_numberOfRows    = numberOfTileRows;
+        tile.m_numberOfColumns = std::min(s_tileSize, levelColumns - firstColumn);
+        const int64_t numberOfCells = tile.m_numberOfRows * tile.m_numberOfColumns;
+        tile.m_minimum.assign(numberOfCells, std::numeric_limits<float>::max());
+        tile.m_maximum.assign(numberOfCells, -std::numeric_limits<float>::max());
+        sums[t].assign(numberOfCells, 0.0);
+        
+        /*
+         * Matrix columns covered by the tile
+         */
+        matrixColumnStarts[t] = firstColumn << level;
+        matrixColumnEnds[t]   = std::min((firstColumn + tile.m_numberOfColumns) << level, m_numberOfColumns);
+    }
+    
+    /*
+     * Matrix rows covered by the row of tiles
+     */
+    const int64_t matrixRowStart = firstRow << level;
+    const int64_t matrixRowEnd   = std::min((firstRow + numberOfTileRows) << level, m_numberOfRows);
+    
+    std::vector<float> rowData(m_numberOfColumns);
+    for (int64_t row = matrixRowStart; row < matrixRowEnd; row++) {
+        CaretAssertVectorIndex(m_fileRowForRow, row);
+        m_ciftiFile->getRow(&rowData[0], m_fileRowForRow[row]);
+        for (int64_t t = 0; t < numberOfTiles; t++) {
+            CellBlock& tile = tilesOut[t];
+            std::vector<double>& tileSums = sums[t];
+            const int64_t firstColumn = tileColumns[t] * s_tileSize;
+            const int64_t cellRowOffset = ((row >> level) - firstRow) * tile.m_numberOfColumns;
+            for (int64_t j = matrixColumnStarts[t]; j < matrixColumnEnds[t]; j++) {
+                const int64_t cell = cellRowOffset + (j >> level) - firstColumn;
+                const float value = rowData[j];
+                if (value < tile.m_minimum[cell]) tile.m_minimum[cell] = value;
+                if (value > tile.m_maximum[cell]) tile.m_maximum[cell] = value;
+                tileSums[cell] += value;
+            }
+        }
+    }
+    
+    for (int64_t t = 0; t < numberOfTiles; t++) {
+        CellBlock& tile = tilesOut[t];
+        const int64_t firstColumn = tileColumns[t] * s_tileSize;
+        tile.m_mean.resize(tile.m_numberOfRows * tile.m_numberOfColumns);
+        for (int64_t i = 0; i < tile.m_numberOfRows; i++) {
+            const int64_t rowsCovered = getNumberOfCellsCovered(level, firstRow + i, m_numberOfRows);
+            for (int64_t j = 0; j < tile.m_numberOfColumns; j++) {
+                const int64_t cell = i * tile.m_numberOfColumns + j;
+                tile.m_mean[cell] = sums[t][cell] / (rowsCovered * getNumberOfCellsCovered(level, firstColumn + j, m_numberOfColumns));
+            }
+        }
+    }
+}
+
@@ -0,0 +1,165 @@
+#ifndef __CIFTI_MATRIX_PYRAMID_H__
+#define __CIFTI_MATRIX_PYRAMID_H__
+
+
+/*LICENSE_START*/
+/*
+ *  Copyright (C) 2014  Washington University School of Medicine
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+/*LICENSE_END*/
+
+#include <map>
+#include <stdint.h>
+#include <vector>
+
+#include "CaretObject.h"
+#include "FastStatistics.h"
+
+namespace caret {
+
+    class CiftiFile;
+    
+    class CiftiMatrixPyramid : public CaretObject {
+        
+    public:
+        /** How the matrix cells covered by a reduced resolution cell are combined */
+        enum Reduction {
+            REDUCTION_MEAN,
+            REDUCTION_MINIMUM,
+            REDUCTION_MAXIMUM
+        };
+        
+        CiftiMatrixPyramid(const CiftiFile* ciftiFile,
+                           const std::vector<int32_t>& rowIndices);
+        
+        virtual ~CiftiMatrixPyramid();
+        
+        // ADD_NEW_METHODS_HERE
+        
+        bool isForRowIndices(const std::vector<int32_t>& rowIndices) const;
+        
+        int32_t getNumberOfLevels() const;
+        
+        void getLevelDimensions(const int32_t level,
+                                int64_t& numberOfRowsOut,
+                                int64_t& numberOfColumnsOut) const;
+        
+        const FastStatistics* getFastStatistics() const;
+        
+        void getRegion(const int32_t level,
+                       const int64_t firstRow,
+                       const int64_t firstColumn,
+                       const int64_t numberOfRows,
+                       const int64_t numberOfColumns,
+                       const Reduction reduction,
+                       std::vector<float>& dataOut);
+        
+    private:
+        CiftiMatrixPyramid(const CiftiMatrixPyramid&);
+        
+        CiftiMatrixPyramid& operator=(const CiftiMatrixPyramid&);
+        
+        /** Reduced values of a rectangular block of cells at one level */
+        struct CellBlock {
+            CellBlock() : m_numberOfRows(0), m_numberOfColumns(0), m_lastUsed(0) { }
+            
+            int64_t m_numberOfRows;
+            
+            int64_t m_numberOfColumns;
+            
+            std::vector<float> m_minimum;
+            
+            std::vector<float> m_maximum;
+            
+            std::vector<float> m_mean;
+            
+            int64_t m_lastUsed;
+        };
+        
+        int64_t getNumberOfCellsCovered(const int32_t level,
+                                        const int64_t levelIndex,
+                                        const int64_t fullSize) const;
+        
+        static const std::vector<float>& getValues(const CellBlock& block,
+                                                   const Reduction reduction);
+        
+        void buildStoredLevels();
+        
+        void reduceBlock(const int32_t finerLevel,
+                         const CellBlock& finer,
+                         CellBlock& coarserOut) const;
+        
+        static int64_t getTileKey(const int32_t level,
+                                  const int64_t tileRow,
+                                  const int64_t tileColumn);
+        
+        const CellBlock* findTile(const int64_t key);
+        
+        void storeTile(const int64_t key,
+                       CellBlock& tile);
+        
+        void loadTileBand(const int32_t level,
+                          const int64_t tileRow,
+                          const std::vector<int64_t>& tileColumns,
+                          std::vector<CellBlock>& tilesOut) const;
+        
+        // ADD_NEW_MEMBERS_HERE
+        
+        const CiftiFile* m_ciftiFile;
+        
+        /** Row reordering the pyramid was built with, empty for file order */
+        std::vector<int32_t> m_rowIndices;
+        
+        /** File row for each displayed row */
+        std::vector<int64_t> m_fileRowForRow;
+        
+        int64_t m_numberOfRows;
+        
+        int64_t m_numberOfColumns;
+        
+        int32_t m_numberOfLevels;
+        
+        /** Levels at and above this one are kept in memory, finer levels are read in tiles */
+        int32_t m_firstStoredLevel;
+        
+        std::vector<CellBlock> m_storedLevels;
+        
+        /** Statistics of all cells of the matrix, computed while building the stored levels */
+        FastStatistics m_fastStatistics;
+        
+        /** Tiles of levels finer than the stored levels, most recently used are kept */
+        std::map<int64_t, CellBlock> m_tiles;
+        
+        int64_t m_tileUseCounter;
+        
+        /** Stored levels start at the first level with no more than this many cells */
+        static const int64_t s_maximumStoredCells;
+        
+        /** Width and height of a tile, in cells of its level */
+        static const int64_t s_tileSize;
+        
+        static const int64_t s_maximumNumberOfTiles;
+    };
+    
+#ifdef __CIFTI_MATRIX_PYRAMID_DECLARE__
+    const int64_t CiftiMatrixPyramid::s_maximumStoredCells = 1 << 20;
+    const int64_t CiftiMatrixPyramid::s_tileSize = 256;
+    const int64_t CiftiMatrixPyramid::s_maximumNumberOfTiles = 32;
+#endif // __CIFTI_MATRIX_PYRAMID_DECLARE__
+    
+} // namespace
+#endif  //__CIFTI_MATRIX_PYRAMID_H__
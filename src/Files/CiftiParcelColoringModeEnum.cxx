@@ -25,9 +25,19 @@
 #undef __CIFTI_PARCEL_COLORING_MODE_ENUM_DECLARE__
 
 #include "CaretAssert.h"
+#include "CaretMutex.h"
 
 using namespace caret;
 
+namespace
+{
+    CaretMutex& getInitializeMutex()
+    {//function-local, so it exists even if the enum is first used while initializing another static
+        static CaretMutex s_initializeMutex;
+        return s_initializeMutex;
+    }
+}
+
     
 /**
  * \class caret::CiftiParcelColoringModeEnum 
@@ -103,10 +113,10 @@ CiftiParcelColoringModeEnum::~CiftiParcelColoringModeEnum()
 void
 CiftiParcelColoringModeEnum::initialize()
 {
+    CaretMutexLocker locker(&getInitializeMutex());//always lock, an unlocked check of the flag could see it set before the data it guards
     if (initializedFlag) {
         return;
     }
-    initializedFlag = true;
 
     enumData.push_back(CiftiParcelColoringModeEnum(CIFTI_PARCEL_COLORING_OFF, 
                                     "CIFTI_PARCEL_COLORING_OFF", 
@@ -120,6 +130,7 @@ CiftiParcelColoringModeEnum::initialize()
                                     "CIFTI_PARCEL_COLORING_OUTLINE", 
                                     "Outline"));
     
+    initializedFlag = true;
 }
 
 /**
@@ -132,7 +143,7 @@ CiftiParcelColoringModeEnum::initialize()
 const CiftiParcelColoringModeEnum*
 CiftiParcelColoringModeEnum::findData(const Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
 
     size_t num = enumData.size();
     for (size_t i = 0; i < num; i++) {
@@ -154,7 +165,7 @@ CiftiParcelColoringModeEnum::findData(const Enum enumValue)
  */
 AString 
 CiftiParcelColoringModeEnum::toName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const CiftiParcelColoringModeEnum* enumInstance = findData(enumValue);
     return enumInstance->name;
@@ -173,7 +184,7 @@ CiftiParcelColoringModeEnum::toName(Enum enumValue) {
 CiftiParcelColoringModeEnum::Enum 
 CiftiParcelColoringModeEnum::fromName(const AString& name, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = CiftiParcelColoringModeEnum::enumData[0].enumValue;
@@ -207,7 +218,7 @@ CiftiParcelColoringModeEnum::fromName(const AString& name, bool* isValidOut)
  */
 AString 
 CiftiParcelColoringModeEnum::toGuiName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const CiftiParcelColoringModeEnum* enumInstance = findData(enumValue);
     return enumInstance->guiName;
@@ -226,7 +237,7 @@ CiftiParcelColoringModeEnum::toGuiName(Enum enumValue) {
 CiftiParcelColoringModeEnum::Enum 
 CiftiParcelColoringModeEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = CiftiParcelColoringModeEnum::enumData[0].enumValue;
@@ -260,7 +271,7 @@ CiftiParcelColoringModeEnum::fromGuiName(const AString& guiName, bool* isValidOu
 int32_t
 CiftiParcelColoringModeEnum::toIntegerCode(Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     const CiftiParcelColoringModeEnum* enumInstance = findData(enumValue);
     return enumInstance->integerCode;
 }
@@ -279,7 +290,7 @@ CiftiParcelColoringModeEnum::toIntegerCode(Enum enumValue)
 CiftiParcelColoringModeEnum::Enum
 CiftiParcelColoringModeEnum::fromIntegerCode(const int32_t integerCode, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = CiftiParcelColoringModeEnum::enumData[0].enumValue;
@@ -314,7 +325,7 @@ CiftiParcelColoringModeEnum::fromIntegerCode(const int32_t integerCode, bool* is
 void
 CiftiParcelColoringModeEnum::getAllEnums(std::vector<CiftiParcelColoringModeEnum::Enum>& allEnums)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allEnums.clear();
     
@@ -336,7 +347,7 @@ CiftiParcelColoringModeEnum::getAllEnums(std::vector<CiftiParcelColoringModeEnum
 void
 CiftiParcelColoringModeEnum::getAllNames(std::vector<AString>& allNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allNames.clear();
     
@@ -362,7 +373,7 @@ CiftiParcelColoringModeEnum::getAllNames(std::vector<AString>& allNames, const b
 void
 CiftiParcelColoringModeEnum::getAllGuiNames(std::vector<AString>& allGuiNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allGuiNames.clear();
     
@@ -248,6 +248,53 @@ CiftiScalarDataSeriesFile::getMatrixDataRGBA(int32_t& numberOfRowsOut,
                                                  rgbaOut);
 }
 
+/**
+ * @return True since a region of the matrix can be colored at
+ * reduced resolution.
+ */
+bool
+CiftiScalarDataSeriesFile::isMatrixDataRGBAForRegionSupported() const
+{
+    return true;
+}
+
+/**
+ * Get the RGBA coloring for a region of the matrix at a resolution level.
+ *
+ * @param resolutionLevel
+ *    The resolution level, zero for the full resolution matrix.
+ * @param firstRow
+ *    First row of the region, in cells of the level.
+ * @param firstColumn
+ *    First column of the region, in cells of the level.
+ * @param numberOfRows
+ *    Number of rows in the region.
+ * @param numberOfColumns
+ *    Number of columns in the region.
+ * @param rgbaOut
+ *    RGBA coloring output with number of elements
+ *    (numberOfRows * numberOfColumns * 4).
+ * @return
+ *    True if output data is valid, else false.
+ */
+bool
+CiftiScalarDataSeriesFile::getMatrixDataRGBAForRegion(const int32_t resolutionLevel,
+                                                      const int32_t firstRow,
+                                                      const int32_t firstColumn,
+                                                      const int32_t numberOfRows,
+                                                      const int32_t numberOfColumns,
+                                                      std::vector<uint8_t>& rgbaOut) const
+{
+    std::vector<int32_t> rowIndices;
+    return helpMatrixFileLoadChartDataMatrixRGBAForRegion(resolutionLevel,
+                                                          firstRow,
+                                                          firstColumn,
+                                                          numberOfRows,
+                                                          numberOfColumns,
+                                                          rowIndices,
+                                                          rgbaOut);
+}
+
 /**
  * Get the value, row name, and column name for a cell in the matrix.
  *
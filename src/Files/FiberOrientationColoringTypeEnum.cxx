@@ -25,9 +25,19 @@
 #undef __FIBER_ORIENTATION_COLORING_TYPE_ENUM_DECLARE__
 
 #include "CaretAssert.h"
+#include "CaretMutex.h"
 
 using namespace caret;
 
+namespace
+{
+    CaretMutex& getInitializeMutex()
+    {//function-local, so it exists even if the enum is first used while initializing another static
+        static CaretMutex s_initializeMutex;
+        return s_initializeMutex;
+    }
+}
+
     
 /**
  * \class caret::FiberOrientationColoringTypeEnum 
@@ -69,10 +79,10 @@ FiberOrientationColoringTypeEnum::~FiberOrientationColoringTypeEnum()
 void
 FiberOrientationColoringTypeEnum::initialize()
 {
+    CaretMutexLocker locker(&getInitializeMutex());//always lock, an unlocked check of the flag could see it set before the data it guards
     if (initializedFlag) {
         return;
     }
-    initializedFlag = true;
 
     enumData.push_back(FiberOrientationColoringTypeEnum(FIBER_COLORING_FIBER_INDEX_AS_RGB,
                                     "FIBER_COLORING_FIBER_INDEX_AS_RGB", 
@@ -82,6 +92,7 @@ FiberOrientationColoringTypeEnum::initialize()
                                                         "FIBER_COLORING_XYZ_AS_RGB",
                                                         "XYZ as RGB"));
     
+    initializedFlag = true;
 }
 
 /**
@@ -94,7 +105,7 @@ FiberOrientationColoringTypeEnum::initialize()
 const FiberOrientationColoringTypeEnum*
 FiberOrientationColoringTypeEnum::findData(const Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
 
     size_t num = enumData.size();
     for (size_t i = 0; i < num; i++) {
@@ -116,7 +127,7 @@ FiberOrientationColoringTypeEnum::findData(const Enum enumValue)
  */
 AString 
 FiberOrientationColoringTypeEnum::toName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const FiberOrientationColoringTypeEnum* enumInstance = findData(enumValue);
     return enumInstance->name;
@@ -135,7 +146,7 @@ FiberOrientationColoringTypeEnum::toName(Enum enumValue) {
 FiberOrientationColoringTypeEnum::Enum 
 FiberOrientationColoringTypeEnum::fromName(const AString& name, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = FIBER_COLORING_XYZ_AS_RGB;
@@ -169,7 +180,7 @@ FiberOrientationColoringTypeEnum::fromName(const AString& name, bool* isValidOut
  */
 AString 
 FiberOrientationColoringTypeEnum::toGuiName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const FiberOrientationColoringTypeEnum* enumInstance = findData(enumValue);
     return enumInstance->guiName;
@@ -188,7 +199,7 @@ FiberOrientationColoringTypeEnum::toGuiName(Enum enumValue) {
 FiberOrientationColoringTypeEnum::Enum 
 FiberOrientationColoringTypeEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = FIBER_COLORING_XYZ_AS_RGB;
@@ -222,7 +233,7 @@ FiberOrientationColoringTypeEnum::fromGuiName(const AString& guiName, bool* isVa
 int32_t
 FiberOrientationColoringTypeEnum::toIntegerCode(Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     const FiberOrientationColoringTypeEnum* enumInstance = findData(enumValue);
     return enumInstance->integerCode;
 }
@@ -241,7 +252,7 @@ FiberOrientationColoringTypeEnum::toIntegerCode(Enum enumValue)
 FiberOrientationColoringTypeEnum::Enum
 FiberOrientationColoringTypeEnum::fromIntegerCode(const int32_t integerCode, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = FIBER_COLORING_XYZ_AS_RGB;
@@ -276,7 +287,7 @@ FiberOrientationColoringTypeEnum::fromIntegerCode(const int32_t integerCode, boo
 void
 FiberOrientationColoringTypeEnum::getAllEnums(std::vector<FiberOrientationColoringTypeEnum::Enum>& allEnums)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allEnums.clear();
     
@@ -298,7 +309,7 @@ FiberOrientationColoringTypeEnum::getAllEnums(std::vector<FiberOrientationColori
 void
 FiberOrientationColoringTypeEnum::getAllNames(std::vector<AString>& allNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allNames.clear();
     
@@ -324,7 +335,7 @@ FiberOrientationColoringTypeEnum::getAllNames(std::vector<AString>& allNames, co
 void
 FiberOrientationColoringTypeEnum::getAllGuiNames(std::vector<AString>& allGuiNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allGuiNames.clear();
     
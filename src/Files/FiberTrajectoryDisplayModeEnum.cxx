@@ -25,9 +25,19 @@
 #undef __FIBER_TRAJECTORY_DISPLAY_MODE_ENUM_DECLARE__
 
 #include "CaretAssert.h"
+#include "CaretMutex.h"
 
 using namespace caret;
 
+namespace
+{
+    CaretMutex& getInitializeMutex()
+    {//function-local, so it exists even if the enum is first used while initializing another static
+        static CaretMutex s_initializeMutex;
+        return s_initializeMutex;
+    }
+}
+
     
 /**
  * \class caret::FiberTrajectoryDisplayModeEnum 
@@ -67,10 +77,10 @@ FiberTrajectoryDisplayModeEnum::~FiberTrajectoryDisplayModeEnum()
 void
 FiberTrajectoryDisplayModeEnum::initialize()
 {
+    CaretMutexLocker locker(&getInitializeMutex());//always lock, an unlocked check of the flag could see it set before the data it guards
     if (initializedFlag) {
         return;
     }
-    initializedFlag = true;
 
     enumData.push_back(FiberTrajectoryDisplayModeEnum(FIBER_TRAJECTORY_DISPLAY_ABSOLUTE, 
                                     "FIBER_TRAJECTORY_DISPLAY_ABSOLUTE", 
@@ -88,6 +98,7 @@ FiberTrajectoryDisplayModeEnum::initialize()
                                     "FIBER_TRAJECTORY_DISPLAY_PROPORTION", 
                                     "Proportion"));
     
+    initializedFlag = true;
 }
 
 /**
@@ -100,7 +111,7 @@ FiberTrajectoryDisplayModeEnum::initialize()
 const FiberTrajectoryDisplayModeEnum*
 FiberTrajectoryDisplayModeEnum::findData(const Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
 
     size_t num = enumData.size();
     for (size_t i = 0; i < num; i++) {
@@ -122,7 +133,7 @@ FiberTrajectoryDisplayModeEnum::findData(const Enum enumValue)
  */
 AString 
 FiberTrajectoryDisplayModeEnum::toName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const FiberTrajectoryDisplayModeEnum* enumInstance = findData(enumValue);
     return enumInstance->name;
@@ -141,7 +152,7 @@ FiberTrajectoryDisplayModeEnum::toName(Enum enumValue) {
 FiberTrajectoryDisplayModeEnum::Enum 
 FiberTrajectoryDisplayModeEnum::fromName(const AString& name, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = FIBER_TRAJECTORY_DISPLAY_PROPORTION;
@@ -175,7 +186,7 @@ FiberTrajectoryDisplayModeEnum::fromName(const AString& name, bool* isValidOut)
  */
 AString 
 FiberTrajectoryDisplayModeEnum::toGuiName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const FiberTrajectoryDisplayModeEnum* enumInstance = findData(enumValue);
     return enumInstance->guiName;
@@ -194,7 +205,7 @@ FiberTrajectoryDisplayModeEnum::toGuiName(Enum enumValue) {
 FiberTrajectoryDisplayModeEnum::Enum 
 FiberTrajectoryDisplayModeEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = FIBER_TRAJECTORY_DISPLAY_PROPORTION;
@@ -228,7 +239,7 @@ FiberTrajectoryDisplayModeEnum::fromGuiName(const AString& guiName, bool* isVali
 int32_t
 FiberTrajectoryDisplayModeEnum::toIntegerCode(Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     const FiberTrajectoryDisplayModeEnum* enumInstance = findData(enumValue);
     return enumInstance->integerCode;
 }
@@ -247,7 +258,7 @@ FiberTrajectoryDisplayModeEnum::toIntegerCode(Enum enumValue)
 FiberTrajectoryDisplayModeEnum::Enum
 FiberTrajectoryDisplayModeEnum::fromIntegerCode(const int32_t integerCode, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = FIBER_TRAJECTORY_DISPLAY_PROPORTION;
@@ -282,7 +293,7 @@ FiberTrajectoryDisplayModeEnum::fromIntegerCode(const int32_t integerCode, bool*
 void
 FiberTrajectoryDisplayModeEnum::getAllEnums(std::vector<FiberTrajectoryDisplayModeEnum::Enum>& allEnums)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allEnums.clear();
     
@@ -304,7 +315,7 @@ FiberTrajectoryDisplayModeEnum::getAllEnums(std::vector<FiberTrajectoryDisplayMo
 void
 FiberTrajectoryDisplayModeEnum::getAllNames(std::vector<AString>& allNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allNames.clear();
     
@@ -330,7 +341,7 @@ FiberTrajectoryDisplayModeEnum::getAllNames(std::vector<AString>& allNames, cons
 void
 FiberTrajectoryDisplayModeEnum::getAllGuiNames(std::vector<AString>& allGuiNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allGuiNames.clear();
     
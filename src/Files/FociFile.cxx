@@ -40,6 +40,7 @@
 #include "GiftiLabel.h"
 #include "GiftiLabelTable.h"
 #include "GiftiMetaData.h"
+#include "SurfaceFile.h"
 #include "SurfaceProjectedItem.h"
 #include "XmlAttributes.h"
 #include "XmlSaxParser.h"
@@ -213,6 +214,7 @@ FociFile::clear()
         delete m_foci[i];
     }
     m_foci.clear();
+    m_focusProjectionLocators.clear();
 }
 
 /**
@@ -320,6 +322,123 @@ FociFile::removeFocus(Focus* focus)
                     + focus->getName());
 }
 
+/**
+ * Find all focus projections within the given distance of a coordinate
+ * on a surface.  Projections are unprojected without pasting onto the
+ * surface and only projections to the surface's structure (or without a
+ * structure) are found.
+ *
+ * @param surfaceFile
+ *    Surface on which focus projections are unprojected.
+ * @param xyz
+ *    The coordinate.
+ * @param maximumDistance
+ *    Maximum distance of a focus projection from the coordinate.
+ * @param focusProjectionsOut
+ *    Output with focus index, projection index, and distance of
+ *    each projection found, sorted by focus index.
+ */
+void
+FociFile::findFocusProjectionsNearXYZ(const SurfaceFile* surfaceFile,
+                                      const float xyz[3],
+                                      const float maximumDistance,
+                                      std::vector<SurfaceProjectedItemLocator::Match>& focusProjectionsOut) const
+{
+    getFocusProjectionLocator(surfaceFile)->findItemsWithinDistance(xyz,
+                                                                    maximumDistance,
+                                                                    focusProjectionsOut);
+}
+
+/**
+ * Find the focus projection nearest a coordinate on a surface.
+ *
+ * @param surfaceFile
+ *    Surface on which focus projections are unprojected.
+ * @param xyz
+ *    The coordinate.
+ * @param maximumDistance
+ *    Maximum distance of the focus projection from the coordinate.
+ *    If negative, there is no limit on the distance.
+ * @param focusProjectionOut
+ *    Output with focus index, projection index, and distance.
+ * @return
+ *    True if a focus projection was found, else false.
+ */
+bool
+FociFile::findFocusProjectionNearestXYZ(const SurfaceFile* surfaceFile,
+                                        const float xyz[3],
+                                        const float maximumDistance,
+                                        SurfaceProjectedItemLocator::Match& focusProjectionOut) const
+{
+    return getFocusProjectionLocator(surfaceFile)->findNearestItem(xyz,
+                                                                   maximumDistance,
+                                                                   focusProjectionOut);
+}
+
+/**
+ * Get the spatial index of the focus projections on a surface.  The
+ * index is created again after foci are added, removed, or edited,
+ * or after the surface's coordinates change.
+ *
+ * @param surfaceFile
+ *    Surface on which focus projections are unprojected.
+ * @return
+ *    The spatial index.
+ */
+const SurfaceProjectedItemLocator*
+FociFile::getFocusProjectionLocator(const SurfaceFile* surfaceFile) const
+{
+    CaretAssert(surfaceFile);
+    
+    const int32_t numFoci = getNumberOfFoci();
+    std::map<const SurfaceFile*, CaretPointer<SurfaceProjectedItemLocator> >::iterator iter = m_focusProjectionLocators.find(surfaceFile);
+    if (iter != m_focusProjectionLocators.end()) {
+        const SurfaceProjectedItemLocator* locator = iter->second;
+        bool validFlag = (locator->isValidForSurface(surfaceFile)
+                          && (locator->getNumberOfOwners() == numFoci));
+        for (int32_t i = 0; (i < numFoci) && validFlag; i++) {
+            const Focus* focus = m_foci[i];
+            validFlag = locator->isOwnerUnchanged(i,
+                                                  focus,
+                                                  focus->getPositionModificationNumber());
+        }
+        if (validFlag) {
+            return locator;
+        }
+        m_focusProjectionLocators.erase(iter);
+    }
+    
+    /*
+     * Deleted surfaces are never searched again
+     * so limit the number of surfaces that are kept.
+     */
+    if (static_cast<int32_t>(m_focusProjectionLocators.size()) >= s_maximumNumberOfFocusProjectionLocators) {
+        m_focusProjectionLocators.clear();
+    }
+    
+    CaretPointer<SurfaceProjectedItemLocator> locator(new SurfaceProjectedItemLocator(surfaceFile,
+                                                                                     false));
+    const StructureEnum::Enum structure = surfaceFile->getStructure();
+    for (int32_t i = 0; i < numFoci; i++) {
+        const Focus* focus = m_foci[i];
+        locator->addOwner(focus,
+                          focus->getPositionModificationNumber());
+        const int32_t numProjections = focus->getNumberOfProjections();
+        for (int32_t j = 0; j < numProjections; j++) {
+            const SurfaceProjectedItem* spi = focus->getProjection(j);
+            const StructureEnum::Enum focusStructure = spi->getStructure();
+            if ((focusStructure == structure)
+                || (focusStructure == StructureEnum::INVALID)) {
+                locator->addItem(spi,
+                                 j);
+            }
+        }
+    }
+    m_focusProjectionLocators[surfaceFile] = locator;
+    
+    return locator;
+}
+
 /**
  * @return The class and name hierarchy.
  */
@@ -21,7 +21,11 @@
  */
 /*LICENSE_END*/
 
+#include <map>
+
 #include "CaretDataFile.h"
+#include "CaretPointer.h"
+#include "SurfaceProjectedItemLocator.h"
 
 namespace caret {
 
@@ -29,6 +33,7 @@ namespace caret {
     class Focus;
     class GiftiLabelTable;
     class GiftiMetaData;
+    class SurfaceFile;
     
     class FociFile : public CaretDataFile {
         
@@ -71,6 +76,16 @@ namespace caret {
         
         void removeFocus(Focus* focus);
         
+        void findFocusProjectionsNearXYZ(const SurfaceFile* surfaceFile,
+                                         const float xyz[3],
+                                         const float maximumDistance,
+                                         std::vector<SurfaceProjectedItemLocator::Match>& focusProjectionsOut) const;
+        
+        bool findFocusProjectionNearestXYZ(const SurfaceFile* surfaceFile,
+                                           const float xyz[3],
+                                           const float maximumDistance,
+                                           SurfaceProjectedItemLocator::Match& focusProjectionOut) const;
+        
         GiftiLabelTable* getClassColorTable();
         
         const GiftiLabelTable* getClassColorTable() const;
@@ -112,6 +127,8 @@ namespace caret {
         
         void initializeFociFile();
         
+        const SurfaceProjectedItemLocator* getFocusProjectionLocator(const SurfaceFile* surfaceFile) const;
+        
         GiftiMetaData* m_metadata;
         
         std::vector<Focus*> m_foci;
@@ -128,9 +145,15 @@ namespace caret {
         /** force an update of the class and name hierarchy */
         bool m_forceUpdateOfGroupAndNameHierarchy;
         
+        /** Spatial index of focus projections for each surface, created when searched */
+        mutable std::map<const SurfaceFile*, CaretPointer<SurfaceProjectedItemLocator> > m_focusProjectionLocators;
+        
         /** Version of this FociFile */
         static const int32_t s_fociFileVersion;
         
+        /** Maximum number of surfaces with a focus projection index */
+        static const int32_t s_maximumNumberOfFocusProjectionLocators;
+        
     };
     
 #ifdef __FOCI_FILE_DECLARE__
@@ -139,6 +162,7 @@ namespace caret {
     const AString FociFile::XML_TAG_NAME_COLOR_TABLE = "FociNameColorTable";
     const AString FociFile::XML_TAG_CLASS_COLOR_TABLE = "FociClassColorTable";
     const int32_t FociFile::s_fociFileVersion = 2;
+    const int32_t FociFile::s_maximumNumberOfFocusProjectionLocators = 8;
 #endif // __FOCI_FILE_DECLARE__
 
 } // namespace
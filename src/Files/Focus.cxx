@@ -23,6 +23,8 @@
 #include "Focus.h"
 #undef __FOCUS_DECLARE__
 
+#include <algorithm>
+
 #include "CaretAssert.h"
 #include "CaretLogger.h"
 #include "StudyMetaDataLinkSet.h"
@@ -45,6 +47,7 @@ Focus::Focus()
 : CaretObjectTracksModification()
 {
     m_studyMetaDataLinkSet = new StudyMetaDataLinkSet();
+    m_projectionsModificationNumber = SurfaceProjectedItem::newModificationNumber();
     clear();
 }
 
@@ -67,6 +70,7 @@ Focus::Focus(const Focus& obj)
 : CaretObjectTracksModification(obj)
 {
     m_studyMetaDataLinkSet = new StudyMetaDataLinkSet();
+    m_projectionsModificationNumber = SurfaceProjectedItem::newModificationNumber();
     clear();
     this->copyHelperFocus(obj);
 }
@@ -707,6 +711,7 @@ Focus::addProjection(SurfaceProjectedItem* projection)
 {
     CaretAssert(projection);
     m_projections.push_back(projection);
+    m_projectionsModificationNumber = SurfaceProjectedItem::newModificationNumber();
 }
 
 /**
@@ -723,6 +728,7 @@ Focus::removeAllProjections()
         delete m_projections[i];
     }
     m_projections.clear();
+    m_projectionsModificationNumber = SurfaceProjectedItem::newModificationNumber();
 }
 
 /**
@@ -736,6 +742,25 @@ Focus::removeExtraProjections()
         delete m_projections[i];
     }
     m_projections.resize(1);
+    m_projectionsModificationNumber = SurfaceProjectedItem::newModificationNumber();
+}
+
+/**
+ * @return Number that changes whenever projections are added to or
+ * removed from this focus, or any of its projections are modified.
+ * Positions of the focus that are cached for a surface remain valid
+ * while this number is unchanged.
+ */
+int64_t
+Focus::getPositionModificationNumber() const
+{
+    int64_t modificationNumber = m_projectionsModificationNumber;
+    const int32_t numProj = getNumberOfProjections();
+    for (int32_t i = 0; i < numProj; i++) {
+        modificationNumber = std::max(modificationNumber,
+                                      m_projections[i]->getModificationNumber());
+    }
+    return modificationNumber;
 }
 
 /**
@@ -133,6 +133,8 @@ namespace caret {
         
         void removeExtraProjections();
         
+        int64_t getPositionModificationNumber() const;
+        
         StudyMetaDataLinkSet* getStudyMetaDataLinkSet();
         
         const StudyMetaDataLinkSet* getStudyMetaDataLinkSet() const;
@@ -176,6 +178,9 @@ namespace caret {
         
         void removeAllProjections();
         
+        /** Changes whenever projections are added or removed */
+        int64_t m_projectionsModificationNumber;
+        
         AString m_area;
         
         AString m_className;
@@ -25,9 +25,19 @@
 #undef __GROUP_AND_NAME_CHECK_STATE_ENUM_DECLARE__
 
 #include "CaretAssert.h"
+#include "CaretMutex.h"
 
 using namespace caret;
 
+namespace
+{
+    CaretMutex& getInitializeMutex()
+    {//function-local, so it exists even if the enum is first used while initializing another static
+        static CaretMutex s_initializeMutex;
+        return s_initializeMutex;
+    }
+}
+
     
 /**
  * \class caret::GroupAndNameCheckStateEnum 
@@ -73,10 +83,10 @@ GroupAndNameCheckStateEnum::~GroupAndNameCheckStateEnum()
 void
 GroupAndNameCheckStateEnum::initialize()
 {
+    CaretMutexLocker locker(&getInitializeMutex());//always lock, an unlocked check of the flag could see it set before the data it guards
     if (initializedFlag) {
         return;
     }
-    initializedFlag = true;
 
     enumData.push_back(GroupAndNameCheckStateEnum(UNCHECKED,
                                                   Qt::Unchecked,
@@ -91,7 +101,9 @@ GroupAndNameCheckStateEnum::initialize()
     enumData.push_back(GroupAndNameCheckStateEnum(CHECKED,
                                                   Qt::Checked,
                                                   "CHECKED",
-                                                  "Checked"));    
+                                                  "Checked"));
+    
+    initializedFlag = true;
 }
 
 /**
@@ -104,7 +116,7 @@ GroupAndNameCheckStateEnum::initialize()
 const GroupAndNameCheckStateEnum*
 GroupAndNameCheckStateEnum::findData(const Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
 
     size_t num = enumData.size();
     for (size_t i = 0; i < num; i++) {
@@ -126,7 +138,7 @@ GroupAndNameCheckStateEnum::findData(const Enum enumValue)
  */
 AString 
 GroupAndNameCheckStateEnum::toName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const GroupAndNameCheckStateEnum* enumInstance = findData(enumValue);
     return enumInstance->name;
@@ -145,7 +157,7 @@ GroupAndNameCheckStateEnum::toName(Enum enumValue) {
 GroupAndNameCheckStateEnum::Enum 
 GroupAndNameCheckStateEnum::fromName(const AString& name, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = UNCHECKED;
@@ -179,7 +191,7 @@ GroupAndNameCheckStateEnum::fromName(const AString& name, bool* isValidOut)
  */
 AString 
 GroupAndNameCheckStateEnum::toGuiName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const GroupAndNameCheckStateEnum* enumInstance = findData(enumValue);
     return enumInstance->guiName;
@@ -198,7 +210,7 @@ GroupAndNameCheckStateEnum::toGuiName(Enum enumValue) {
 GroupAndNameCheckStateEnum::Enum 
 GroupAndNameCheckStateEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = UNCHECKED;
@@ -232,7 +244,7 @@ GroupAndNameCheckStateEnum::fromGuiName(const AString& guiName, bool* isValidOut
 int32_t
 GroupAndNameCheckStateEnum::toIntegerCode(Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     const GroupAndNameCheckStateEnum* enumInstance = findData(enumValue);
     return enumInstance->integerCode;
 }
@@ -251,7 +263,7 @@ GroupAndNameCheckStateEnum::toIntegerCode(Enum enumValue)
 GroupAndNameCheckStateEnum::Enum
 GroupAndNameCheckStateEnum::fromIntegerCode(const int32_t integerCode, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = UNCHECKED;
@@ -286,7 +298,7 @@ GroupAndNameCheckStateEnum::fromIntegerCode(const int32_t integerCode, bool* isV
 void
 GroupAndNameCheckStateEnum::getAllEnums(std::vector<GroupAndNameCheckStateEnum::Enum>& allEnums)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allEnums.clear();
     
@@ -308,7 +320,7 @@ GroupAndNameCheckStateEnum::getAllEnums(std::vector<GroupAndNameCheckStateEnum::
 void
 GroupAndNameCheckStateEnum::getAllNames(std::vector<AString>& allNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allNames.clear();
     
@@ -334,7 +346,7 @@ GroupAndNameCheckStateEnum::getAllNames(std::vector<AString>& allNames, const bo
 void
 GroupAndNameCheckStateEnum::getAllGuiNames(std::vector<AString>& allGuiNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allGuiNames.clear();
     
@@ -25,9 +25,19 @@
 #undef __IMAGE_PIXELS_PER_SPATIAL_UNITS_ENUM_DECLARE__
 
 #include "CaretAssert.h"
+#include "CaretMutex.h"
 
 using namespace caret;
 
+namespace
+{
+    CaretMutex& getInitializeMutex()
+    {//function-local, so it exists even if the enum is first used while initializing another static
+        static CaretMutex s_initializeMutex;
+        return s_initializeMutex;
+    }
+}
+
     
 /**
  * \class caret::ImagePixelsPerSpatialUnitsEnum 
@@ -101,10 +111,10 @@ ImagePixelsPerSpatialUnitsEnum::~ImagePixelsPerSpatialUnitsEnum()
 void
 ImagePixelsPerSpatialUnitsEnum::initialize()
 {
+    CaretMutexLocker locker(&getInitializeMutex());//always lock, an unlocked check of the flag could see it set before the data it guards
     if (initializedFlag) {
         return;
     }
-    initializedFlag = true;
 
     enumData.push_back(ImagePixelsPerSpatialUnitsEnum(PIXELS_PER_INCH,
                                                 "PIXELS_PER_INCH",
@@ -113,6 +123,8 @@ ImagePixelsPerSpatialUnitsEnum::initialize()
     enumData.push_back(ImagePixelsPerSpatialUnitsEnum(PIXEL_PER_CENTIMETER,
                                                 "PIXEL_PER_CENTIMETER",
                                                 "pixels/cm"));
+    
+    initializedFlag = true;
 }
 
 /**
@@ -125,7 +137,7 @@ ImagePixelsPerSpatialUnitsEnum::initialize()
 const ImagePixelsPerSpatialUnitsEnum*
 ImagePixelsPerSpatialUnitsEnum::findData(const Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
 
     size_t num = enumData.size();
     for (size_t i = 0; i < num; i++) {
@@ -147,7 +159,7 @@ ImagePixelsPerSpatialUnitsEnum::findData(const Enum enumValue)
  */
 AString 
 ImagePixelsPerSpatialUnitsEnum::toName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const ImagePixelsPerSpatialUnitsEnum* enumInstance = findData(enumValue);
     return enumInstance->name;
@@ -166,7 +178,7 @@ ImagePixelsPerSpatialUnitsEnum::toName(Enum enumValue) {
 ImagePixelsPerSpatialUnitsEnum::Enum 
 ImagePixelsPerSpatialUnitsEnum::fromName(const AString& name, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = ImagePixelsPerSpatialUnitsEnum::enumData[0].enumValue;
@@ -200,7 +212,7 @@ ImagePixelsPerSpatialUnitsEnum::fromName(const AString& name, bool* isValidOut)
  */
 AString 
 ImagePixelsPerSpatialUnitsEnum::toGuiName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const ImagePixelsPerSpatialUnitsEnum* enumInstance = findData(enumValue);
     return enumInstance->guiName;
@@ -219,7 +231,7 @@ ImagePixelsPerSpatialUnitsEnum::toGuiName(Enum enumValue) {
 ImagePixelsPerSpatialUnitsEnum::Enum 
 ImagePixelsPerSpatialUnitsEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = ImagePixelsPerSpatialUnitsEnum::enumData[0].enumValue;
@@ -253,7 +265,7 @@ ImagePixelsPerSpatialUnitsEnum::fromGuiName(const AString& guiName, bool* isVali
 int32_t
 ImagePixelsPerSpatialUnitsEnum::toIntegerCode(Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     const ImagePixelsPerSpatialUnitsEnum* enumInstance = findData(enumValue);
     return enumInstance->integerCode;
 }
@@ -272,7 +284,7 @@ ImagePixelsPerSpatialUnitsEnum::toIntegerCode(Enum enumValue)
 ImagePixelsPerSpatialUnitsEnum::Enum
 ImagePixelsPerSpatialUnitsEnum::fromIntegerCode(const int32_t integerCode, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = ImagePixelsPerSpatialUnitsEnum::enumData[0].enumValue;
@@ -307,7 +319,7 @@ ImagePixelsPerSpatialUnitsEnum::fromIntegerCode(const int32_t integerCode, bool*
 void
 ImagePixelsPerSpatialUnitsEnum::getAllEnums(std::vector<ImagePixelsPerSpatialUnitsEnum::Enum>& allEnums)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allEnums.clear();
     
@@ -329,7 +341,7 @@ ImagePixelsPerSpatialUnitsEnum::getAllEnums(std::vector<ImagePixelsPerSpatialUni
 void
 ImagePixelsPerSpatialUnitsEnum::getAllNames(std::vector<AString>& allNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allNames.clear();
     
@@ -355,7 +367,7 @@ ImagePixelsPerSpatialUnitsEnum::getAllNames(std::vector<AString>& allNames, cons
 void
 ImagePixelsPerSpatialUnitsEnum::getAllGuiNames(std::vector<AString>& allGuiNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allGuiNames.clear();
     
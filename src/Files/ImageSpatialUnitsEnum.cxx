@@ -25,9 +25,19 @@
 #undef __IMAGE_SPATIAL_UNITS_ENUM_DECLARE__
 
 #include "CaretAssert.h"
+#include "CaretMutex.h"
 
 using namespace caret;
 
+namespace
+{
+    CaretMutex& getInitializeMutex()
+    {//function-local, so it exists even if the enum is first used while initializing another static
+        static CaretMutex s_initializeMutex;
+        return s_initializeMutex;
+    }
+}
+
     
 /**
  * \class caret::ImageSpatialUnitsEnum 
@@ -103,10 +113,10 @@ ImageSpatialUnitsEnum::~ImageSpatialUnitsEnum()
 void
 ImageSpatialUnitsEnum::initialize()
 {
+    CaretMutexLocker locker(&getInitializeMutex());//always lock, an unlocked check of the flag could see it set before the data it guards
     if (initializedFlag) {
         return;
     }
-    initializedFlag = true;
 
     enumData.push_back(ImageSpatialUnitsEnum(INCHES,
                                              "INCHES",
@@ -119,6 +129,8 @@ ImageSpatialUnitsEnum::initialize()
     enumData.push_back(ImageSpatialUnitsEnum(MILLIMETERS,
                                              "MILLIMETERS",
                                              "mm"));
+    
+    initializedFlag = true;
 }
 
 /**
@@ -131,7 +143,7 @@ ImageSpatialUnitsEnum::initialize()
 const ImageSpatialUnitsEnum*
 ImageSpatialUnitsEnum::findData(const Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
 
     size_t num = enumData.size();
     for (size_t i = 0; i < num; i++) {
@@ -153,7 +165,7 @@ ImageSpatialUnitsEnum::findData(const Enum enumValue)
  */
 AString 
 ImageSpatialUnitsEnum::toName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const ImageSpatialUnitsEnum* enumInstance = findData(enumValue);
     return enumInstance->name;
@@ -172,7 +184,7 @@ ImageSpatialUnitsEnum::toName(Enum enumValue) {
 ImageSpatialUnitsEnum::Enum 
 ImageSpatialUnitsEnum::fromName(const AString& name, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = ImageSpatialUnitsEnum::enumData[0].enumValue;
@@ -206,7 +218,7 @@ ImageSpatialUnitsEnum::fromName(const AString& name, bool* isValidOut)
  */
 AString 
 ImageSpatialUnitsEnum::toGuiName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const ImageSpatialUnitsEnum* enumInstance = findData(enumValue);
     return enumInstance->guiName;
@@ -225,7 +237,7 @@ ImageSpatialUnitsEnum::toGuiName(Enum enumValue) {
 ImageSpatialUnitsEnum::Enum 
 ImageSpatialUnitsEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = ImageSpatialUnitsEnum::enumData[0].enumValue;
@@ -259,7 +271,7 @@ ImageSpatialUnitsEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 int32_t
 ImageSpatialUnitsEnum::toIntegerCode(Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     const ImageSpatialUnitsEnum* enumInstance = findData(enumValue);
     return enumInstance->integerCode;
 }
@@ -278,7 +290,7 @@ ImageSpatialUnitsEnum::toIntegerCode(Enum enumValue)
 ImageSpatialUnitsEnum::Enum
 ImageSpatialUnitsEnum::fromIntegerCode(const int32_t integerCode, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = ImageSpatialUnitsEnum::enumData[0].enumValue;
@@ -313,7 +325,7 @@ ImageSpatialUnitsEnum::fromIntegerCode(const int32_t integerCode, bool* isValidO
 void
 ImageSpatialUnitsEnum::getAllEnums(std::vector<ImageSpatialUnitsEnum::Enum>& allEnums)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allEnums.clear();
     
@@ -335,7 +347,7 @@ ImageSpatialUnitsEnum::getAllEnums(std::vector<ImageSpatialUnitsEnum::Enum>& all
 void
 ImageSpatialUnitsEnum::getAllNames(std::vector<AString>& allNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allNames.clear();
     
@@ -361,7 +373,7 @@ ImageSpatialUnitsEnum::getAllNames(std::vector<AString>& allNames, const bool is
 void
 ImageSpatialUnitsEnum::getAllGuiNames(std::vector<AString>& allGuiNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allGuiNames.clear();
     
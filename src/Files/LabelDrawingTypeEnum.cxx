@@ -25,9 +25,19 @@
 #undef __LABEL_DRAWING_TYPE_ENUM_DECLARE__
 
 #include "CaretAssert.h"
+#include "CaretMutex.h"
 
 using namespace caret;
 
+namespace
+{
+    CaretMutex& getInitializeMutex()
+    {//function-local, so it exists even if the enum is first used while initializing another static
+        static CaretMutex s_initializeMutex;
+        return s_initializeMutex;
+    }
+}
+
     
 /**
  * \class caret::LabelDrawingTypeEnum 
@@ -69,10 +79,10 @@ LabelDrawingTypeEnum::~LabelDrawingTypeEnum()
 void
 LabelDrawingTypeEnum::initialize()
 {
+    CaretMutexLocker locker(&getInitializeMutex());//always lock, an unlocked check of the flag could see it set before the data it guards
     if (initializedFlag) {
         return;
     }
-    initializedFlag = true;
 
     enumData.push_back(LabelDrawingTypeEnum(DRAW_FILLED, 
                                     "DRAW_FILLED", 
@@ -90,6 +100,7 @@ LabelDrawingTypeEnum::initialize()
                                             "DRAW_OUTLINE_LABEL_COLOR",
                                             "Outline Label Color"));
     
+    initializedFlag = true;
 }
 
 
@@ -103,7 +114,7 @@ LabelDrawingTypeEnum::initialize()
 const LabelDrawingTypeEnum*
 LabelDrawingTypeEnum::findData(const Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
 
     size_t num = enumData.size();
     for (size_t i = 0; i < num; i++) {
@@ -125,7 +136,7 @@ LabelDrawingTypeEnum::findData(const Enum enumValue)
  */
 AString 
 LabelDrawingTypeEnum::toName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const LabelDrawingTypeEnum* enumInstance = findData(enumValue);
     return enumInstance->name;
@@ -144,7 +155,7 @@ LabelDrawingTypeEnum::toName(Enum enumValue) {
 LabelDrawingTypeEnum::Enum 
 LabelDrawingTypeEnum::fromName(const AString& nameIn, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = DRAW_FILLED;
@@ -180,7 +191,7 @@ LabelDrawingTypeEnum::fromName(const AString& nameIn, bool* isValidOut)
  */
 AString 
 LabelDrawingTypeEnum::toGuiName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const LabelDrawingTypeEnum* enumInstance = findData(enumValue);
     return enumInstance->guiName;
@@ -199,7 +210,7 @@ LabelDrawingTypeEnum::toGuiName(Enum enumValue) {
 LabelDrawingTypeEnum::Enum 
 LabelDrawingTypeEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = DRAW_FILLED;
@@ -233,7 +244,7 @@ LabelDrawingTypeEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 int32_t
 LabelDrawingTypeEnum::toIntegerCode(Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     const LabelDrawingTypeEnum* enumInstance = findData(enumValue);
     return enumInstance->integerCode;
 }
@@ -252,7 +263,7 @@ LabelDrawingTypeEnum::toIntegerCode(Enum enumValue)
 LabelDrawingTypeEnum::Enum
 LabelDrawingTypeEnum::fromIntegerCode(const int32_t integerCode, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = DRAW_FILLED;
@@ -287,7 +298,7 @@ LabelDrawingTypeEnum::fromIntegerCode(const int32_t integerCode, bool* isValidOu
 void
 LabelDrawingTypeEnum::getAllEnums(std::vector<LabelDrawingTypeEnum::Enum>& allEnums)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allEnums.clear();
     
@@ -309,7 +320,7 @@ LabelDrawingTypeEnum::getAllEnums(std::vector<LabelDrawingTypeEnum::Enum>& allEn
 void
 LabelDrawingTypeEnum::getAllNames(std::vector<AString>& allNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allNames.clear();
     
@@ -335,7 +346,7 @@ LabelDrawingTypeEnum::getAllNames(std::vector<AString>& allNames, const bool isS
 void
 LabelDrawingTypeEnum::getAllGuiNames(std::vector<AString>& allGuiNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allGuiNames.clear();
     
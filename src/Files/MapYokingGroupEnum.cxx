@@ -25,10 +25,20 @@
 #undef __MAP_YOKING_GROUP_ENUM_DECLARE__
 
 #include "CaretAssert.h"
+#include "CaretMutex.h"
 #include "EventManager.h"
 
 using namespace caret;
 
+namespace
+{
+    CaretMutex& getInitializeMutex()
+    {//function-local, so it exists even if the enum is first used while initializing another static
+        static CaretMutex s_initializeMutex;
+        return s_initializeMutex;
+    }
+}
+
     
 /**
  * \class caret::MapYokingGroupEnum 
@@ -71,10 +81,10 @@ MapYokingGroupEnum::~MapYokingGroupEnum()
 void
 MapYokingGroupEnum::initialize()
 {
+    CaretMutexLocker locker(&getInitializeMutex());//always lock, an unlocked check of the flag could see it set before the data it guards
     if (initializedFlag) {
         return;
     }
-    initializedFlag = true;
 
     enumData.push_back(MapYokingGroupEnum(MAP_YOKING_GROUP_OFF, 
                                     "MAP_YOKING_GROUP_OFF", 
@@ -120,6 +130,7 @@ MapYokingGroupEnum::initialize()
                                               "MAP_YOKING_GROUP_10",
                                               "X"));
     
+    initializedFlag = true;
 }
 
 /**
@@ -132,7 +143,7 @@ MapYokingGroupEnum::initialize()
 MapYokingGroupEnum*
 MapYokingGroupEnum::findData(const Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
 
     size_t num = enumData.size();
     for (size_t i = 0; i < num; i++) {
@@ -154,7 +165,7 @@ MapYokingGroupEnum::findData(const Enum enumValue)
  */
 AString 
 MapYokingGroupEnum::toName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const MapYokingGroupEnum* enumInstance = findData(enumValue);
     return enumInstance->name;
@@ -173,7 +184,7 @@ MapYokingGroupEnum::toName(Enum enumValue) {
 MapYokingGroupEnum::Enum 
 MapYokingGroupEnum::fromName(const AString& name, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = MAP_YOKING_GROUP_OFF;
@@ -215,7 +226,7 @@ MapYokingGroupEnum::Enum
 MapYokingGroupEnum::fromOverlayYokingGroupEnumName(const AString& name,
                                                    bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = MAP_YOKING_GROUP_OFF;
@@ -285,7 +296,7 @@ MapYokingGroupEnum::fromOverlayYokingGroupEnumName(const AString& name,
  */
 AString 
 MapYokingGroupEnum::toGuiName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const MapYokingGroupEnum* enumInstance = findData(enumValue);
     return enumInstance->guiName;
@@ -304,7 +315,7 @@ MapYokingGroupEnum::toGuiName(Enum enumValue) {
 MapYokingGroupEnum::Enum 
 MapYokingGroupEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = MAP_YOKING_GROUP_OFF;
@@ -338,7 +349,7 @@ MapYokingGroupEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 int32_t
 MapYokingGroupEnum::toIntegerCode(Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     const MapYokingGroupEnum* enumInstance = findData(enumValue);
     return enumInstance->integerCode;
 }
@@ -357,7 +368,7 @@ MapYokingGroupEnum::toIntegerCode(Enum enumValue)
 MapYokingGroupEnum::Enum
 MapYokingGroupEnum::fromIntegerCode(const int32_t integerCode, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = MAP_YOKING_GROUP_OFF;
@@ -392,7 +403,7 @@ MapYokingGroupEnum::fromIntegerCode(const int32_t integerCode, bool* isValidOut)
 void
 MapYokingGroupEnum::getAllEnums(std::vector<MapYokingGroupEnum::Enum>& allEnums)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allEnums.clear();
     
@@ -414,7 +425,7 @@ MapYokingGroupEnum::getAllEnums(std::vector<MapYokingGroupEnum::Enum>& allEnums)
 void
 MapYokingGroupEnum::getAllNames(std::vector<AString>& allNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allNames.clear();
     
@@ -440,7 +451,7 @@ MapYokingGroupEnum::getAllNames(std::vector<AString>& allNames, const bool isSor
 void
 MapYokingGroupEnum::getAllGuiNames(std::vector<AString>& allGuiNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allGuiNames.clear();
     
@@ -467,7 +478,7 @@ MapYokingGroupEnum::getSelectedMapIndex(const Enum enumValue)
     CaretAssertMessage(enumValue != MAP_YOKING_GROUP_OFF,
                        "Never should be called with MAP_YOKING_GROUP_OFF");
     
-    if (initializedFlag == false) initialize();
+    initialize();
 
     MapYokingGroupEnum* enumInstance = findData(enumValue);
     return enumInstance->mapIndex;
@@ -488,7 +499,7 @@ MapYokingGroupEnum::setSelectedMapIndex(const Enum enumValue,
     CaretAssertMessage(enumValue != MAP_YOKING_GROUP_OFF,
                        "Never should be called with MAP_YOKING_GROUP_OFF");
     
-    if (initializedFlag == false) initialize();
+    initialize();
     
     MapYokingGroupEnum* enumInstance = findData(enumValue);
     enumInstance->mapIndex = mapIndex;
@@ -507,7 +518,7 @@ MapYokingGroupEnum::isEnabled(const Enum enumValue)
     CaretAssertMessage(enumValue != MAP_YOKING_GROUP_OFF,
                        "Never should be called with MAP_YOKING_GROUP_OFF");
     
-    if (initializedFlag == false) initialize();
+    initialize();
     
     MapYokingGroupEnum* enumInstance = findData(enumValue);
     return enumInstance->enabledStatus;
@@ -528,7 +539,7 @@ MapYokingGroupEnum::setEnabled(const Enum enumValue,
     CaretAssertMessage(enumValue != MAP_YOKING_GROUP_OFF,
                        "Never should be called with MAP_YOKING_GROUP_OFF");
     
-    if (initializedFlag == false) initialize();
+    initialize();
     
     MapYokingGroupEnum* enumInstance = findData(enumValue);
     enumInstance->enabledStatus = enabled;
@@ -140,6 +140,41 @@ void MetricSmoothingObject::smoothMetric(const MetricFile* metricIn, MetricFile*
     }
 }
 
+void MetricSmoothingObject::smoothNodeVectors(const float* vectorsIn, const int64_t& vectorLength, float* vectorsOut) const
+{
+    CaretAssert(vectorsIn != NULL);
+    CaretAssert(vectorsOut != NULL);
+    CaretAssert(vectorsIn != vectorsOut);
+    int32_t numNodes = (int32_t)m_weightLists.size();
+#pragma omp CARET_PARFOR schedule(dynamic)
+    for (int32_t i = 0; i < numNodes; ++i)
+    {
+        float* outVector = vectorsOut + i * vectorLength;
+        for (int64_t k = 0; k < vectorLength; ++k)
+        {
+            outVector[k] = 0.0f;
+        }
+        const WeightList& myWeightRef = m_weightLists[i];
+        if (myWeightRef.m_weightSum != 0.0f)
+        {
+            int32_t numWeights = myWeightRef.m_nodes.size();
+            for (int32_t j = 0; j < numWeights; ++j)
+            {//same order of operations as smoothColumnInternal, but a whole vector at a time
+                float weight = myWeightRef.m_weights[j];
+                const float* inVector = vectorsIn + myWeightRef.m_nodes[j] * vectorLength;
+                for (int64_t k = 0; k < vectorLength; ++k)
+                {
+                    outVector[k] += weight * inVector[k];
+                }
+            }
+            for (int64_t k = 0; k < vectorLength; ++k)
+            {
+                outVector[k] /= myWeightRef.m_weightSum;
+            }
+        }
+    }
+}
+
 void MetricSmoothingObject::smoothColumnInternal(float* scratch, const MetricFile* metricIn, const int& whichColumn, MetricFile* metricOut, const int& whichOutColumn, const bool& fixZeros) const
 {
     CaretAssert(metricIn != NULL);//asserts only, and only basic checks, these functions are private
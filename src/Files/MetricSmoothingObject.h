@@ -52,6 +52,8 @@ namespace caret {
         void smoothColumn(const MetricFile* metricIn, const int& whichColumn, MetricFile* columnOut, const MetricFile* roi = NULL, const bool& fixZeros = false) const;
         void smoothColumn(const MetricFile* metricIn, const int& whichColumn, MetricFile* metricOut, const int& whichOutColumn, const MetricFile* roi = NULL, const int& whichRoiColumn = 0, const bool& fixZeros = false) const;
         void smoothMetric(const MetricFile* metricIn, MetricFile* metricOut, const MetricFile* roi = NULL, const bool& fixZeros = false) const;
+        ///smooth node-major data (vectorLength values per node, contiguous), equivalent to smoothing each of the vectorLength columns
+        void smoothNodeVectors(const float* vectorsIn, const int64_t& vectorLength, float* vectorsOut) const;
     private:
         struct WeightList
         {
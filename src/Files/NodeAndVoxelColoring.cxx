@@ -19,6 +19,7 @@
  */
 /*LICENSE_END*/
 
+#include <algorithm>
 #include <cmath>
 #include <limits>
 
@@ -38,7 +39,7 @@
 #include "GroupAndNameHierarchyItem.h"
 #include "Palette.h"
 #include "PaletteColorMapping.h"
-#include "CaretOMP.h"
+#include "PaletteScalarAndColor.h"
 
 using namespace caret;
 
@@ -56,8 +57,189 @@ static const float negativeThresholdGreenColor[] = {
     255.0f / 255.0f
 };
 
+namespace {
+    /**
+     * Palette scalars and colors copied into flat arrays along with a
+     * table that, for evenly spaced intervals of the normalized range
+     * [-1, 1], gives the palette entry used by every value in the
+     * interval.  Only intervals containing a palette scalar must search
+     * the palette, so most values are colored without any searching.
+     * Colors are identical to those from Palette::getPaletteColor().
+     */
+    class PaletteLookupTable {
+    public:
+        PaletteLookupTable(const Palette* palette,
+                           const bool interpolateFlag)
+        : m_interpolateFlag(interpolateFlag)
+        {
+            m_numberOfEntries = palette->getNumberOfScalarsAndColors();
+            m_scalars.resize(m_numberOfEntries);
+            m_rgba.resize(m_numberOfEntries * 4);
+            m_noneColorFlags.resize(m_numberOfEntries);
+            for (int32_t i = 0; i < m_numberOfEntries; i++) {
+                const PaletteScalarAndColor* psac = palette->getScalarAndColor(i);
+                m_scalars[i] = psac->getScalar();
+                psac->getColor(&m_rgba[i * 4]);
+                m_noneColorFlags[i] = (psac->isNoneColor() ? 1 : 0);
+            }
+            
+            /*
+             * Since the palette index decreases as the normalized value
+             * increases, an interval uses one palette entry when both of
+             * its ends use the same entry.  Ends are padded slightly so
+             * that rounding when finding the interval of a value is harmless.
+             */
+            const float binWidth = 2.0f / NUMBER_OF_BINS;
+            const float binPad   = 1.0e-6f;
+            m_binPaletteIndex.resize(NUMBER_OF_BINS);
+            m_binInterpolateFlags.resize(NUMBER_OF_BINS);
+            for (int32_t iBin = 0; iBin < NUMBER_OF_BINS; iBin++) {
+                const float binLow  = -1.0f + iBin * binWidth - binPad;
+                const float binHigh = -1.0f + (iBin + 1) * binWidth + binPad;
+                bool lowInterpolateFlag = false, highInterpolateFlag = false;
+                const int32_t lowIndex  = findPaletteIndex(binLow, lowInterpolateFlag);
+                const int32_t highIndex = findPaletteIndex(binHigh, highInterpolateFlag);
+                if ((lowIndex == highIndex)
+                    && (lowInterpolateFlag == highInterpolateFlag)) {
+                    m_binPaletteIndex[iBin] = lowIndex;
+                    m_binInterpolateFlags[iBin] = (lowInterpolateFlag ? 1 : 0);
+                }
+                else {
+                    m_binPaletteIndex[iBin] = -1;
+                    m_binInterpolateFlags[iBin] = 0;
+                }
+            }
+        }
+        
+        /**
+         * Get the color for a normalized value.
+         *
+         * @param normalizedValue
+         *    Value in the range [-1, 1].
+         * @param rgbaOut
+         *    Output color.
+         */
+        void getPaletteColor(const float normalizedValue,
+                             float rgbaOut[4]) const
+        {
+            rgbaOut[0] = 0.0f;
+            rgbaOut[1] = 0.0f;
+            rgbaOut[2] = 0.0f;
+            rgbaOut[3] = 1.0f;
+            if (m_numberOfEntries <= 0) {
+                return;
+            }
+            
+            float scalar = normalizedValue;
+            if (scalar < -1.0f) scalar = -1.0f;
+            if (scalar >  1.0f) scalar =  1.0f;
+            
+            int32_t iBin = static_cast<int32_t>((scalar + 1.0f) * (NUMBER_OF_BINS / 2));
+            if (iBin >= NUMBER_OF_BINS) iBin = NUMBER_OF_BINS - 1;
+            
+            int32_t paletteIndex = m_binPaletteIndex[iBin];
+            bool interpolateFlag = (m_binInterpolateFlags[iBin] != 0);
+            if (paletteIndex < 0) {
+                paletteIndex = findPaletteIndex(scalar, interpolateFlag);
+            }
+            
+            const float* rgbaAbove = &m_rgba[paletteIndex * 4];
+            rgbaOut[0] = rgbaAbove[0];
+            rgbaOut[1] = rgbaAbove[1];
+            rgbaOut[2] = rgbaAbove[2];
+            rgbaOut[3] = rgbaAbove[3];
+            if (interpolateFlag
+                && (paletteIndex < (m_numberOfEntries - 1))) {
+                const int32_t belowIndex = paletteIndex + 1;
+                const float totalDiff = m_scalars[paletteIndex] - m_scalars[belowIndex];
+                if (totalDiff != 0.0) {
+                    if (m_noneColorFlags[belowIndex] == 0) {
+                        const float percentAbove = (scalar - m_scalars[belowIndex]) / totalDiff;
+                        const float percentBelow = 1.0f - percentAbove;
+                        const float* rgbaBelow = &m_rgba[belowIndex * 4];
+                        rgbaOut[0] = (percentAbove * rgbaAbove[0]
+                                      + percentBelow * rgbaBelow[0]);
+                        rgbaOut[1] = (percentAbove * rgbaAbove[1]
+                                      + percentBelow * rgbaBelow[1]);
+                        rgbaOut[2] = (percentAbove * rgbaAbove[2]
+                                      + percentBelow * rgbaBelow[2]);
+                    }
+                }
+            }
+            else if (m_noneColorFlags[paletteIndex] != 0) {
+                rgbaOut[3] = 0.0f;
+            }
+        }
+        
+    private:
+        /**
+         * Find the palette entry for a value in [-1, 1] using the same
+         * rules as Palette::getPaletteColor().  Palette scalars are in
+         * descending order.
+         *
+         * @param scalar
+         *    The normalized value.
+         * @param interpolateFlagOut
+         *    Output with interpolation status for the value.
+         * @return
+         *    Index of the palette entry.
+         */
+        int32_t findPaletteIndex(const float scalar,
+                                 bool& interpolateFlagOut) const
+        {
+            interpolateFlagOut = false;
+            if (m_numberOfEntries <= 1) {
+                return 0;
+            }
+            if (scalar >= m_scalars[0]) {
+                return 0;
+            }
+            const int32_t lastIndex = m_numberOfEntries - 1;
+            if (scalar <= m_scalars[lastIndex]) {
+                return lastIndex;
+            }
+            if (m_numberOfEntries == 2) {
+                interpolateFlagOut = true;
+                return 0;
+            }
+            interpolateFlagOut = m_interpolateFlag;
+            
+            /*
+             * First entry with a scalar less than the value, the
+             * entry used is the one above it.
+             */
+            int32_t low  = 1;
+            int32_t high = lastIndex;
+            while (low < high) {
+                const int32_t mid = (low + high) / 2;
+                if (m_scalars[mid] < scalar) {
+                    high = mid;
+                }
+                else {
+                    low = mid + 1;
+                }
+            }
+            return (low - 1);
+        }
+        
+        static const int32_t NUMBER_OF_BINS = 4096;
+        
+        const bool m_interpolateFlag;
+        
+        int32_t m_numberOfEntries;
+        
+        std::vector<float> m_scalars;
+        
+        std::vector<float> m_rgba;
+        
+        std::vector<uint8_t> m_noneColorFlags;
+        
+        std::vector<int32_t> m_binPaletteIndex;
+        
+        std::vector<uint8_t> m_binInterpolateFlags;
+    };
+}
 
-    
 /**
  * \class NodeAndVoxelColoring 
  * \brief Static methods for coloring nodes and voxels. 
@@ -171,13 +353,10 @@ NodeAndVoxelColoring::colorScalarsWithPalettePrivate(const FastStatistics* stati
     const bool interpolateFlag = paletteColorMapping->isInterpolatePaletteFlag();
     
     /*
-     * Convert data values to normalized palette values.
+     * Table for quickly finding palette colors without searching the palette
      */
-    std::vector<float> normalizedValues(numberOfScalars);
-    paletteColorMapping->mapDataToPaletteNormalizedValues(statistics,
-                                                          scalarValues,
-                                                          &normalizedValues[0],
-                                                          numberOfScalars);
+    const PaletteLookupTable paletteLookupTable(palette,
+                                                interpolateFlag);
     
     /*
      * Get color for normalized values of -1.0 and 1.0.
@@ -195,175 +374,196 @@ NodeAndVoxelColoring::colorScalarsWithPalettePrivate(const FastStatistics* stati
     const bool rgbaNegativeOneValid = (rgbaNegativeOne[3] > 0.0);
     
     /*
-     * Color all scalars.
+     * Color all scalars.  Scalars are processed in blocks so that
+     * normalization, coloring, and thresholding of a block are done
+     * while it is in cache, and blocks are colored in parallel.
      */
-#pragma omp CARET_FOR
-	for (int64_t i = 0; i < numberOfScalars; i++) {
-        const int64_t i4 = i * 4;
-        
-        /*
-         * Initialize coloring for node since one of the
-         * continue statements below may cause moving
-         * on to next node
-         */
-        switch (colorDataType) {
-            case COLOR_TYPE_FLOAT:
-                rgbaFloat[i4]   =  0.0;
-                rgbaFloat[i4+1] =  0.0;
-                rgbaFloat[i4+2] =  0.0;
-                rgbaFloat[i4+3] =  0.0;
-                break;
-            case COLOR_TYPE_UNSIGNED_BTYE:
-                rgbaUnsignedByte[i4]   =  0;
-                rgbaUnsignedByte[i4+1] =  0;
-                rgbaUnsignedByte[i4+2] =  0;
-                rgbaUnsignedByte[i4+3] =  0;
-                break;
-        }
+    const int64_t numberOfBlocks = ((numberOfScalars + COLORING_BLOCK_SIZE - 1)
+                                    / COLORING_BLOCK_SIZE);
+#pragma omp CARET_PAR if (numberOfBlocks > 1)
+    {
+        std::vector<float> normalizedValues(COLORING_BLOCK_SIZE);
         
-        float scalar = scalarValues[i];
-        const float threshold = thresholdValues[i];
-        
-        /*
-         * Positive/Zero/Negative Test
-         */
-        if (scalar > NodeAndVoxelColoring::SMALL_POSITIVE) {
-            if (hidePositiveValues) {
-                continue;
-            }
-        }
-        else if (scalar < NodeAndVoxelColoring::SMALL_NEGATIVE) {
-            if (hideNegativeValues) {
-                continue;
-            }
-        }
-        else {
-            /*
-             * May be very near zero so force to zero.
-             */
-            normalizedValues[i] = 0.0;
-            if (hideZeroValues) {
-                continue;
-            }
-        }
-        
-        /*
-         * Temporary for rgba coloring now that past possible
-         * continue statements
-         */
-        float rgbaOut[4] = {
-             0.0,
-             0.0,
-             0.0,
-             0.0
-        };
-        
-        const float normalValue = normalizedValues[i];
-        
-        /*
-         * RGBA colors have been mapped for extreme values
-         */
-        if (normalValue >= 1.0) {
-            if (rgbaPositiveOneValid) {
-                rgbaOut[0] = rgbaPositiveOne[0];
-                rgbaOut[1] = rgbaPositiveOne[1];
-                rgbaOut[2] = rgbaPositiveOne[2];
-                rgbaOut[3] = rgbaPositiveOne[3];
-            }
-        }
-        else if (normalValue <= -1.0) {
-            if (rgbaNegativeOneValid) {
-                rgbaOut[0] = rgbaNegativeOne[0];
-                rgbaOut[1] = rgbaNegativeOne[1];
-                rgbaOut[2] = rgbaNegativeOne[2];
-                rgbaOut[3] = rgbaNegativeOne[3];
-            }
-        }
-        else {
+#pragma omp CARET_FOR schedule(dynamic)
+        for (int64_t iBlock = 0; iBlock < numberOfBlocks; iBlock++) {
+            const int64_t blockStart = iBlock * COLORING_BLOCK_SIZE;
+            const int64_t blockEnd   = std::min(blockStart + COLORING_BLOCK_SIZE,
+                                                numberOfScalars);
+            
             /*
-             * Color scalar using palette
+             * Convert data values to normalized palette values.
              */
-            float rgba[4];
-            palette->getPaletteColor(normalValue,
-                                     interpolateFlag,
-                                     rgba);
-            if (rgba[3] > 0.0f) {
-                rgbaOut[0] = rgba[0];
-                rgbaOut[1] = rgba[1];
-                rgbaOut[2] = rgba[2];
-                rgbaOut[3] = rgba[3];
-            }
-        }
-        
-        /*
-         * Threshold Test
-         * Threshold is done last so colors are still set
-         * but if threshold test fails, alpha is set invalid.
-         */
-        bool thresholdPassedFlag = false;
-        if (skipThresholdTesting) {
-            thresholdPassedFlag = true;
-        }
-        else if (showOutsideFlag) {
-            if (threshold > thresholdMaximum) {
-                thresholdPassedFlag = true;
-            }
-            else if (threshold < thresholdMinimum) {
-                thresholdPassedFlag = true;
-            }
-        }
-        else {
-            if ((threshold >= thresholdMinimum) &&
-                (threshold <= thresholdMaximum)) {
-                thresholdPassedFlag = true;
-            }
-        }
-        if (thresholdPassedFlag == false) {
-            rgbaOut[3] = 0.0;
-            if (showMappedThresholdFailuresInGreen) {
-                if (thresholdType == PaletteThresholdTypeEnum::THRESHOLD_TYPE_MAPPED) {
-                    if (threshold > 0.0f) {
-                        if ((threshold < thresholdMappedPositive) &&
-                            (threshold > thresholdMappedPositiveAverageArea)) {
-                            rgbaOut[0] = positiveThresholdGreenColor[0];
-                            rgbaOut[1] = positiveThresholdGreenColor[1];
-                            rgbaOut[2] = positiveThresholdGreenColor[2];
-                            rgbaOut[3] = positiveThresholdGreenColor[3];
-                        }
+            paletteColorMapping->mapDataToPaletteNormalizedValues(statistics,
+                                                                  scalarValues + blockStart,
+                                                                  &normalizedValues[0],
+                                                                  blockEnd - blockStart);
+            
+            for (int64_t i = blockStart; i < blockEnd; i++) {
+                const int64_t i4 = i * 4;
+                
+                /*
+                 * Initialize coloring for node since one of the
+                 * continue statements below may cause moving
+                 * on to next node
+                 */
+                switch (colorDataType) {
+                    case COLOR_TYPE_FLOAT:
+                        rgbaFloat[i4]   =  0.0;
+                        rgbaFloat[i4+1] =  0.0;
+                        rgbaFloat[i4+2] =  0.0;
+                        rgbaFloat[i4+3] =  0.0;
+                        break;
+                    case COLOR_TYPE_UNSIGNED_BTYE:
+                        rgbaUnsignedByte[i4]   =  0;
+                        rgbaUnsignedByte[i4+1] =  0;
+                        rgbaUnsignedByte[i4+2] =  0;
+                        rgbaUnsignedByte[i4+3] =  0;
+                        break;
+                }
+                
+                float scalar = scalarValues[i];
+                const float threshold = thresholdValues[i];
+                float normalValue = normalizedValues[i - blockStart];
+                
+                /*
+                 * Positive/Zero/Negative Test
+                 */
+                if (scalar > NodeAndVoxelColoring::SMALL_POSITIVE) {
+                    if (hidePositiveValues) {
+                        continue;
                     }
-                    else if (threshold < 0.0f) {
-                        if ((threshold > thresholdMappedNegative) &&
-                            (threshold < thresholdMappedNegativeAverageArea)) {
-                            rgbaOut[0] = negativeThresholdGreenColor[0];
-                            rgbaOut[1] = negativeThresholdGreenColor[1];
-                            rgbaOut[2] = negativeThresholdGreenColor[2];
-                            rgbaOut[3] = negativeThresholdGreenColor[3];
-                        }
+                }
+                else if (scalar < NodeAndVoxelColoring::SMALL_NEGATIVE) {
+                    if (hideNegativeValues) {
+                        continue;
                     }
                 }
-            }
-        }
-
-        switch (colorDataType) {
-            case COLOR_TYPE_FLOAT:
-                CaretAssertArrayIndex(rgbaFloat, numberOfScalars * 4, i*4+3);
-                rgbaFloat[i4]   = rgbaOut[0];
-                rgbaFloat[i4+1] = rgbaOut[1];
-                rgbaFloat[i4+2] = rgbaOut[2];
-                rgbaFloat[i4+3] = rgbaOut[3];
-                break;
-            case COLOR_TYPE_UNSIGNED_BTYE:
-                CaretAssertArrayIndex(rgbaUnsignedByte, numberOfScalars * 4, i*4+3);
-                rgbaUnsignedByte[i4]   = rgbaOut[0] * 255.0;
-                rgbaUnsignedByte[i4+1] = rgbaOut[1] * 255.0;
-                rgbaUnsignedByte[i4+2] = rgbaOut[2] * 255.0;
-                if (rgbaOut[3] > 0.0) {
-                    rgbaUnsignedByte[i4+3] = rgbaOut[3] * 255.0;
+                else {
+                    /*
+                     * May be very near zero so force to zero.
+                     */
+                    normalValue = 0.0;
+                    if (hideZeroValues) {
+                        continue;
+                    }
+                }
+                
+                /*
+                 * Temporary for rgba coloring now that past possible
+                 * continue statements
+                 */
+                float rgbaOut[4] = {
+                    0.0,
+                    0.0,
+                    0.0,
+                    0.0
+                };
+                
+                /*
+                 * RGBA colors have been mapped for extreme values
+                 */
+                if (normalValue >= 1.0) {
+                    if (rgbaPositiveOneValid) {
+                        rgbaOut[0] = rgbaPositiveOne[0];
+                        rgbaOut[1] = rgbaPositiveOne[1];
+                        rgbaOut[2] = rgbaPositiveOne[2];
+                        rgbaOut[3] = rgbaPositiveOne[3];
+                    }
+                }
+                else if (normalValue <= -1.0) {
+                    if (rgbaNegativeOneValid) {
+                        rgbaOut[0] = rgbaNegativeOne[0];
+                        rgbaOut[1] = rgbaNegativeOne[1];
+                        rgbaOut[2] = rgbaNegativeOne[2];
+                        rgbaOut[3] = rgbaNegativeOne[3];
+                    }
                 }
                 else {
-                    rgbaUnsignedByte[i4+3] = 0;
+                    /*
+                     * Color scalar using palette
+                     */
+                    float rgba[4];
+                    paletteLookupTable.getPaletteColor(normalValue,
+                                                       rgba);
+                    if (rgba[3] > 0.0f) {
+                        rgbaOut[0] = rgba[0];
+                        rgbaOut[1] = rgba[1];
+                        rgbaOut[2] = rgba[2];
+                        rgbaOut[3] = rgba[3];
+                    }
+                }
+                
+                /*
+                 * Threshold Test
+                 * Threshold is done last so colors are still set
+                 * but if threshold test fails, alpha is set invalid.
+                 */
+                bool thresholdPassedFlag = false;
+                if (skipThresholdTesting) {
+                    thresholdPassedFlag = true;
+                }
+                else if (showOutsideFlag) {
+                    if (threshold > thresholdMaximum) {
+                        thresholdPassedFlag = true;
+                    }
+                    else if (threshold < thresholdMinimum) {
+                        thresholdPassedFlag = true;
+                    }
                 }
-                break;
+                else {
+                    if ((threshold >= thresholdMinimum) &&
+                        (threshold <= thresholdMaximum)) {
+                        thresholdPassedFlag = true;
+                    }
+                }
+                if (thresholdPassedFlag == false) {
+                    rgbaOut[3] = 0.0;
+                    if (showMappedThresholdFailuresInGreen) {
+                        if (thresholdType == PaletteThresholdTypeEnum::THRESHOLD_TYPE_MAPPED) {
+                            if (threshold > 0.0f) {
+                                if ((threshold < thresholdMappedPositive) &&
+                                    (threshold > thresholdMappedPositiveAverageArea)) {
+                                    rgbaOut[0] = positiveThresholdGreenColor[0];
+                                    rgbaOut[1] = positiveThresholdGreenColor[1];
+                                    rgbaOut[2] = positiveThresholdGreenColor[2];
+                                    rgbaOut[3] = positiveThresholdGreenColor[3];
+                                }
+                            }
+                            else if (threshold < 0.0f) {
+                                if ((threshold > thresholdMappedNegative) &&
+                                    (threshold < thresholdMappedNegativeAverageArea)) {
+                                    rgbaOut[0] = negativeThresholdGreenColor[0];
+                                    rgbaOut[1] = negativeThresholdGreenColor[1];
+                                    rgbaOut[2] = negativeThresholdGreenColor[2];
+                                    rgbaOut[3] = negativeThresholdGreenColor[3];
+                                }
+                            }
+                        }
+                    }
+                }
+                
+                switch (colorDataType) {
+                    case COLOR_TYPE_FLOAT:
+                        CaretAssertArrayIndex(rgbaFloat, numberOfScalars * 4, i*4+3);
+                        rgbaFloat[i4]   = rgbaOut[0];
+                        rgbaFloat[i4+1] = rgbaOut[1];
+                        rgbaFloat[i4+2] = rgbaOut[2];
+                        rgbaFloat[i4+3] = rgbaOut[3];
+                        break;
+                    case COLOR_TYPE_UNSIGNED_BTYE:
+                        CaretAssertArrayIndex(rgbaUnsignedByte, numberOfScalars * 4, i*4+3);
+                        rgbaUnsignedByte[i4]   = rgbaOut[0] * 255.0;
+                        rgbaUnsignedByte[i4+1] = rgbaOut[1] * 255.0;
+                        rgbaUnsignedByte[i4+2] = rgbaOut[2] * 255.0;
+                        if (rgbaOut[3] > 0.0) {
+                            rgbaUnsignedByte[i4+3] = rgbaOut[3] * 255.0;
+                        }
+                        else {
+                            rgbaUnsignedByte[i4+3] = 0;
+                        }
+                        break;
+                }
+            }
         }
     }
 }
@@ -120,12 +120,16 @@ namespace caret {
         NodeAndVoxelColoring& operator=(const NodeAndVoxelColoring&);
 
         static const int32_t INVALID_TAB_INDEX;
+        
+        /** Number of scalars normalized and colored together by a thread */
+        static const int64_t COLORING_BLOCK_SIZE;
     };
     
 #ifdef __NODE_AND_VOXEL_COLORING_DECLARE__
     const float NodeAndVoxelColoring::SMALL_POSITIVE =  0.00001;
     const float NodeAndVoxelColoring::SMALL_NEGATIVE = -0.00001;
     const int32_t NodeAndVoxelColoring::INVALID_TAB_INDEX = -1;
+    const int64_t NodeAndVoxelColoring::COLORING_BLOCK_SIZE = 4096;
 #endif // __NODE_AND_VOXEL_COLORING_DECLARE__
 
 } // namespace
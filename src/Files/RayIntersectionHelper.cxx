@@ -0,0 +1,330 @@
+/*LICENSE_START*/
+/*
+ *  Copyright (C) 2014  Washington University School of Medicine
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+/*LICENSE_END*/
+
+#include "RayIntersectionHelper.h"
+
+#include "CaretAssert.h"
+#include "SurfaceFile.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace caret;
+using namespace std;
+
+namespace
+{
+    struct CentroidCompare
+    {//sorts triangle indices by one axis of their centroids
+        const float* m_centroids;
+        int m_axis;
+        CentroidCompare(const float* centroids, const int axis) : m_centroids(centroids), m_axis(axis) { }
+        bool operator()(const int32_t left, const int32_t right) const
+        {
+            return m_centroids[left * 3 + m_axis] < m_centroids[right * 3 + m_axis];
+        }
+    };
+    
+    struct HitDistanceCompare
+    {
+        bool operator()(const RayIntersection& left, const RayIntersection& right) const
+        {
+            return left.distance < right.distance;
+        }
+    };
+    
+    bool rayHitsBox(const float boxMin[3], const float boxMax[3], const float origin[3], const float invDir[3], float& tNearOut)
+    {
+        float tNear = 0.0f, tFar = numeric_limits<float>::max();//only look forward along the ray
+        for (int i = 0; i < 3; ++i)
+        {
+            float t1 = (boxMin[i] - origin[i]) * invDir[i];
+            float t2 = (boxMax[i] - origin[i]) * invDir[i];
+            if (t1 > t2) swap(t1, t2);
+            if (t1 > tNear) tNear = t1;
+            if (t2 < tFar) tFar = t2;
+            if (tNear > tFar) return false;
+        }
+        tNearOut = tNear;
+        return true;
+    }
+    
+    void computeInverseDirection(const float direction[3], float invDirOut[3])
+    {
+        const float HUGE_INVERSE = 1.0e30f;//finite, so that an origin on a box face gives 0 rather than NaN
+        for (int i = 0; i < 3; ++i)
+        {
+            if (direction[i] == 0.0f)
+            {
+                invDirOut[i] = HUGE_INVERSE;
+            } else {
+                invDirOut[i] = 1.0f / direction[i];
+            }
+        }
+    }
+}
+
+/**
+ * \class caret::RayIntersectionHelper
+ * \brief Finds where a ray hits the triangles of a surface
+ *
+ * Builds a bounding volume hierarchy over the triangles (median split on the
+ * longest axis of the centroids), so that a ray can be tested against a large
+ * surface without visiting most of its triangles.  Queries do not modify the
+ * helper, so one instance can be shared between threads.
+ */
+
+RayIntersectionHelper::RayIntersectionHelper(const SurfaceFile* mySurf)
+{
+    CaretAssert(mySurf != NULL);
+    m_numNodes = mySurf->getNumberOfNodes();
+    m_numTris = mySurf->getNumberOfTriangles();
+    const float* myCoordData = mySurf->getCoordinateData();
+    m_coordList.assign(myCoordData, myCoordData + m_numNodes * 3);
+    m_triangleList.resize(m_numTris * 3);
+    m_centroids.resize(m_numTris * 3);
+    m_triOrder.resize(m_numTris);
+    for (int32_t i = 0; i < m_numTris; ++i)
+    {
+        const int32_t* thisTri = mySurf->getTriangle(i);
+        const int32_t i3 = i * 3;
+        for (int j = 0; j < 3; ++j)
+        {
+            m_triangleList[i3 + j] = thisTri[j];
+        }
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            m_centroids[i3 + axis] = (m_coordList[thisTri[0] * 3 + axis] + m_coordList[thisTri[1] * 3 + axis] + m_coordList[thisTri[2] * 3 + axis]) / 3.0f;
+        }
+        m_triOrder[i] = i;
+    }
+    if (m_numTris > 0)
+    {
+        m_nodes.reserve(2 * (m_numTris / LEAF_SIZE + 1));
+        buildNode(0, m_numTris);
+    }
+    vector<float>().swap(m_centroids);//only needed during construction
+}
+
+int32_t RayIntersectionHelper::buildNode(const int32_t start, const int32_t end)
+{
+    const int32_t myIndex = (int32_t)m_nodes.size();
+    m_nodes.push_back(BoundsNode());
+    BoundsNode myNode;
+    myNode.m_start = start;
+    myNode.m_count = end - start;
+    myNode.m_second = -1;
+    float centMin[3], centMax[3];
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        myNode.m_min[axis] = numeric_limits<float>::max();
+        myNode.m_max[axis] = -numeric_limits<float>::max();
+        centMin[axis] = numeric_limits<float>::max();
+        centMax[axis] = -numeric_limits<float>::max();
+    }
+    for (int32_t i = start; i < end; ++i)
+    {
+        const int32_t tri = m_triOrder[i];
+        for (int j = 0; j < 3; ++j)
+        {
+            const float* coord = &m_coordList[0] + m_triangleList[tri * 3 + j] * 3;
+            for (int axis = 0; axis < 3; ++axis)
+            {
+                if (coord[axis] < myNode.m_min[axis]) myNode.m_min[axis] = coord[axis];
+                if (coord[axis] > myNode.m_max[axis]) myNode.m_max[axis] = coord[axis];
+            }
+        }
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            const float cent = m_centroids[tri * 3 + axis];
+            if (cent < centMin[axis]) centMin[axis] = cent;
+            if (cent > centMax[axis]) centMax[axis] = cent;
+        }
+    }
+    int splitAxis = 0;
+    for (int axis = 1; axis < 3; ++axis)
+    {
+        if (centMax[axis] - centMin[axis] > centMax[splitAxis] - centMin[splitAxis]) splitAxis = axis;
+    }
+    if (myNode.m_count > LEAF_SIZE && centMax[splitAxis] > centMin[splitAxis])//don't split if all centroids coincide
+    {
+        const int32_t middle = start + myNode.m_count / 2;
+        nth_element(m_triOrder.begin() + start, m_triOrder.begin() + middle, m_triOrder.begin() + end, CentroidCompare(&m_centroids[0], splitAxis));
+        buildNode(start, middle);//first child is always at myIndex + 1
+        myNode.m_second = buildNode(middle, end);
+        myNode.m_count = 0;
+    }
+    m_nodes[myIndex] = myNode;//vector may have reallocated during recursion, so assign by index at the end
+    return myIndex;
+}
+
+bool RayIntersectionHelper::intersectTriangle(const int32_t triangle, const float origin[3], const float direction[3], RayIntersection& hitOut) const
+{//Moller-Trumbore, in double to avoid trouble with long thin triangles, both windings count as a hit
+    const int32_t* tri = &m_triangleList[0] + triangle * 3;
+    const float* v0 = &m_coordList[0] + tri[0] * 3;
+    const float* v1 = &m_coordList[0] + tri[1] * 3;
+    const float* v2 = &m_coordList[0] + tri[2] * 3;
+    double edge1[3], edge2[3], pvec[3], tvec[3], qvec[3];
+    for (int i = 0; i < 3; ++i)
+    {
+        edge1[i] = v1[i] - v0[i];
+        edge2[i] = v2[i] - v0[i];
+        tvec[i] = origin[i] - v0[i];
+    }
+    pvec[0] = direction[1] * edge2[2] - direction[2] * edge2[1];
+    pvec[1] = direction[2] * edge2[0] - direction[0] * edge2[2];
+    pvec[2] = direction[0] * edge2[1] - direction[1] * edge2[0];
+    const double det = edge1[0] * pvec[0] + edge1[1] * pvec[1] + edge1[2] * pvec[2];
+    if (det == 0.0) return false;//ray parallel to triangle, or degenerate triangle
+    const double invDet = 1.0 / det;
+    const double TOLERANCE = 1.0e-6;//so that a ray through a shared edge doesn't fall between triangles
+    const double u = (tvec[0] * pvec[0] + tvec[1] * pvec[1] + tvec[2] * pvec[2]) * invDet;
+    if (u < -TOLERANCE || u > 1.0 + TOLERANCE) return false;
+    qvec[0] = tvec[1] * edge1[2] - tvec[2] * edge1[1];
+    qvec[1] = tvec[2] * edge1[0] - tvec[0] * edge1[2];
+    qvec[2] = tvec[0] * edge1[1] - tvec[1] * edge1[0];
+    const double v = (direction[0] * qvec[0] + direction[1] * qvec[1] + direction[2] * qvec[2]) * invDet;
+    if (v < -TOLERANCE || u + v > 1.0 + TOLERANCE) return false;
+    const double t = (edge2[0] * qvec[0] + edge2[1] * qvec[1] + edge2[2] * qvec[2]) * invDet;
+    if (t < 0.0) return false;
+    double weights[3] = { 1.0 - u - v, u, v };
+    double weightSum = 0.0;
+    for (int i = 0; i < 3; ++i)
+    {
+        if (weights[i] < 0.0) weights[i] = 0.0;
+        weightSum += weights[i];
+    }
+    hitOut.triangle = triangle;
+    hitOut.distance = (float)t;
+    float bestDist2 = -1.0f;
+    for (int i = 0; i < 3; ++i)
+    {
+        hitOut.point[i] = (float)(origin[i] + t * direction[i]);
+        hitOut.nodes[i] = tri[i];
+        hitOut.baryWeights[i] = (float)(weights[i] / weightSum);
+    }
+    for (int i = 0; i < 3; ++i)
+    {
+        const float* vert = &m_coordList[0] + tri[i] * 3;
+        float dist2 = 0.0f;
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            const float diff = vert[axis] - hitOut.point[axis];
+            dist2 += diff * diff;
+        }
+        if (bestDist2 < 0.0f || dist2 < bestDist2)
+        {
+            bestDist2 = dist2;
+            hitOut.nearestNode = tri[i];
+        }
+    }
+    return true;
+}
+
+bool RayIntersectionHelper::closestIntersection(const float origin[3], const float direction[3], RayIntersection& hitOut) const
+{
+    if (m_nodes.empty()) return false;
+    float invDir[3];
+    computeInverseDirection(direction, invDir);
+    bool found = false;
+    RayIntersection tempHit;
+    vector<int32_t> nodeStack;
+    nodeStack.reserve(64);
+    nodeStack.push_back(0);
+    while (!nodeStack.empty())
+    {
+        const int32_t thisIndex = nodeStack.back();
+        const BoundsNode& thisNode = m_nodes[thisIndex];
+        nodeStack.pop_back();
+        float tNear;
+        if (!rayHitsBox(thisNode.m_min, thisNode.m_max, origin, invDir, tNear)) continue;
+        if (found && tNear > hitOut.distance) continue;//can't contain anything closer
+        if (thisNode.m_second == -1)
+        {
+            for (int32_t i = thisNode.m_start; i < thisNode.m_start + thisNode.m_count; ++i)
+            {
+                if (intersectTriangle(m_triOrder[i], origin, direction, tempHit))
+                {
+                    if (!found || tempHit.distance < hitOut.distance)
+                    {
+                        hitOut = tempHit;
+                        found = true;
+                    }
+                }
+            }
+        } else {//push the farther child first, so the nearer one gets searched first and can prune the other
+            const int32_t first = thisIndex + 1, second = thisNode.m_second;
+            float tFirst = 0.0f, tSecond = 0.0f;
+            const bool hitFirst = rayHitsBox(m_nodes[first].m_min, m_nodes[first].m_max, origin, invDir, tFirst);
+            const bool hitSecond = rayHitsBox(m_nodes[second].m_min, m_nodes[second].m_max, origin, invDir, tSecond);
+            if (hitFirst && hitSecond)
+            {
+                if (tFirst <= tSecond)
+                {
+                    nodeStack.push_back(second);
+                    nodeStack.push_back(first);
+                } else {
+                    nodeStack.push_back(first);
+                    nodeStack.push_back(second);
+                }
+            } else if (hitFirst) {
+                nodeStack.push_back(first);
+            } else if (hitSecond) {
+                nodeStack.push_back(second);
+            }
+        }
+    }
+    return found;
+}
+
+void RayIntersectionHelper::allIntersections(const float origin[3], const float direction[3], vector<RayIntersection>& hitsOut) const
+{
+    hitsOut.clear();
+    if (m_nodes.empty()) return;
+    float invDir[3];
+    computeInverseDirection(direction, invDir);
+    RayIntersection tempHit;
+    vector<int32_t> nodeStack;
+    nodeStack.reserve(64);
+    nodeStack.push_back(0);
+    while (!nodeStack.empty())
+    {
+        const int32_t thisIndex = nodeStack.back();
+        const BoundsNode& thisNode = m_nodes[thisIndex];
+        nodeStack.pop_back();
+        float tNear;
+        if (!rayHitsBox(thisNode.m_min, thisNode.m_max, origin, invDir, tNear)) continue;
+        if (thisNode.m_second == -1)
+        {
+            for (int32_t i = thisNode.m_start; i < thisNode.m_start + thisNode.m_count; ++i)
+            {
+                if (intersectTriangle(m_triOrder[i], origin, direction, tempHit))
+                {
+                    hitsOut.push_back(tempHit);
+                }
+            }
+        } else {
+            nodeStack.push_back(thisNode.m_second);
+            nodeStack.push_back(thisIndex + 1);
+        }
+    }
+    sort(hitsOut.begin(), hitsOut.end(), HitDistanceCompare());
+}
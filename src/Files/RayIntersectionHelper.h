@@ -0,0 +1,71 @@
+#ifndef __RAY_INTERSECTION_HELPER_H__
+#define __RAY_INTERSECTION_HELPER_H__
+
+/*LICENSE_START*/
+/*
+ *  Copyright (C) 2014  Washington University School of Medicine
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+/*LICENSE_END*/
+
+#include <stdint.h>
+#include <vector>
+
+namespace caret {
+
+    class SurfaceFile;
+    
+    struct RayIntersection
+    {
+        int32_t triangle;
+        float distance;//along the ray, in units of the ray direction length
+        float point[3];
+        int32_t nodes[3];
+        float baryWeights[3];//sum to 1, in the order of nodes
+        int32_t nearestNode;
+    };
+    
+    class RayIntersectionHelper
+    {
+        struct BoundsNode
+        {//flat bounding volume hierarchy, children of an inner node are at index + 1 and m_second
+            float m_min[3], m_max[3];
+            int32_t m_start, m_count;//leaf triangles are m_triOrder[m_start] to m_triOrder[m_start + m_count - 1]
+            int32_t m_second;//-1 for leaves
+        };
+        static const int32_t LEAF_SIZE = 4;//stop splitting at this many triangles
+        std::vector<BoundsNode> m_nodes;
+        std::vector<int32_t> m_triOrder;
+        std::vector<float> m_coordList;//copy what we need from SurfaceFile so that if the SurfaceFile gets destroyed, we don't crash
+        std::vector<int32_t> m_triangleList;
+        std::vector<float> m_centroids;
+        int32_t m_numTris, m_numNodes;
+        int32_t buildNode(const int32_t start, const int32_t end);
+        bool intersectTriangle(const int32_t triangle, const float origin[3], const float direction[3], RayIntersection& hitOut) const;
+        RayIntersectionHelper();
+    public:
+        RayIntersectionHelper(const SurfaceFile* mySurf);
+        
+        ///find the closest intersection with a triangle along the ray (distance >= 0), returns false if the ray misses the surface
+        bool closestIntersection(const float origin[3], const float direction[3], RayIntersection& hitOut) const;
+        
+        ///find all intersections along the ray (distance >= 0), sorted nearest first
+        void allIntersections(const float origin[3], const float direction[3], std::vector<RayIntersection>& hitsOut) const;
+    };
+
+}
+
+#endif //__RAY_INTERSECTION_HELPER_H__
@@ -43,6 +43,7 @@
 #include "CaretPointLocator.h"
 #include "GeodesicHelper.h"
 #include "PlainTextStringBuilder.h"
+#include "RayIntersectionHelper.h"
 #include "SignedDistanceHelper.h"
 #include "TopologyHelper.h"
 
@@ -502,6 +503,12 @@ SurfaceFile::initializeMembersSurfaceFile()
     m_geoHelperIndex = 0;
     m_topoHelperIndex = 0;
     m_normalsComputed = false;
+    m_geometryModificationNumber = newModificationNumber();
+    for (int32_t i = 0; i < BrainConstants::MAXIMUM_NUMBER_OF_BROWSER_TABS; i++) {
+        m_surfaceNodeColoringModificationNumbers[i] = newModificationNumber();
+        m_surfaceMontageNodeColoringModificationNumbers[i] = newModificationNumber();
+        m_wholeBrainNodeColoringModificationNumbers[i] = newModificationNumber();
+    }
 }
 
 /**
@@ -554,6 +561,7 @@ SurfaceFile::computeNormals()
         return;
     }
     m_normalsComputed = true;
+    m_geometryModificationNumber = newModificationNumber();
     int32_t numCoords = this->getNumberOfNodes();
     if (numCoords > 0) {
         this->normalVectors.resize(numCoords * 3);
@@ -855,6 +863,7 @@ CaretPointer<SignedDistanceHelper> SurfaceFile::getSignedDistanceHelper() const
 
 void SurfaceFile::invalidateHelpers()
 {
+    m_geometryModificationNumber = newModificationNumber();
     if (m_geoBase != NULL)
     {
         CaretMutexLocker myLock(&m_geoHelperMutex);//make this function threadsafe
@@ -881,6 +890,11 @@ void SurfaceFile::invalidateHelpers()
         CaretMutexLocker myLock3(&m_locatorMutex);
         m_locator.grabNew(NULL);
     }
+    if (m_rayHelper != NULL)
+    {
+        CaretMutexLocker myLock5(&m_rayHelperMutex);
+        m_rayHelper.grabNew(NULL);
+    }
 }
 
 /**
@@ -1158,10 +1172,71 @@ SurfaceFile::setModified()
         delete this->boundingBox;
         this->boundingBox = NULL;
     }
+    m_geometryModificationNumber = newModificationNumber();
     
     GiftiTypeFile::setModified();
 }
 
+/**
+ * @return Number that changes whenever the coordinates, normal vectors,
+ * or triangles of this surface change.  Numbers are unique across all
+ * surface files so that a number cached for a deleted surface never
+ * matches a surface that is later created at the same address.
+ */
+int64_t
+SurfaceFile::getGeometryModificationNumber() const
+{
+    return m_geometryModificationNumber;
+}
+
+/**
+ * Get the modification number of one of this surface's node colorings
+ * for a browser tab.  The number changes only when that coloring is set
+ * or invalidated, so setting the coloring of one tab does not change
+ * the number for the other tabs.
+ *
+ * @param nodeColoringRGBA
+ *    Coloring returned by one of the get...NodeColoringRgbaForBrowserTab()
+ *    methods.
+ * @return
+ *    Modification number of the coloring, or a new number if it is not
+ *    one of this surface's colorings.
+ */
+int64_t
+SurfaceFile::getNodeColoringModificationNumber(const float* nodeColoringRGBA) const
+{
+    if (nodeColoringRGBA != NULL) {
+        for (int32_t i = 0; i < BrainConstants::MAXIMUM_NUMBER_OF_BROWSER_TABS; i++) {
+            if ( ! surfaceNodeColoringForBrowserTabs[i].empty()
+                && (nodeColoringRGBA == &surfaceNodeColoringForBrowserTabs[i][0])) {
+                return m_surfaceNodeColoringModificationNumbers[i];
+            }
+            if ( ! surfaceMontageNodeColoringForBrowserTabs[i].empty()
+                && (nodeColoringRGBA == &surfaceMontageNodeColoringForBrowserTabs[i][0])) {
+                return m_surfaceMontageNodeColoringModificationNumbers[i];
+            }
+            if ( ! wholeBrainNodeColoringForBrowserTabs[i].empty()
+                && (nodeColoringRGBA == &wholeBrainNodeColoringForBrowserTabs[i][0])) {
+                return m_wholeBrainNodeColoringModificationNumbers[i];
+            }
+        }
+    }
+    
+    return newModificationNumber();
+}
+
+/**
+ * @return A new modification number, greater than any previously returned.
+ */
+int64_t
+SurfaceFile::newModificationNumber()
+{
+    static CaretMutex counterMutex;
+    static int64_t counter = 0;
+    CaretMutexLocker locker(&counterMutex);
+    return ++counter;
+}
+
 int32_t SurfaceFile::closestNode(const float target[3], const float maxDist) const
 {
     if (maxDist > 0.0f)
@@ -1185,6 +1260,19 @@ CaretPointer<const CaretPointLocator> SurfaceFile::getPointLocator() const
     return m_locator;
 }
 
+CaretPointer<const RayIntersectionHelper> SurfaceFile::getRayIntersectionHelper() const
+{
+    if (m_rayHelper == NULL)
+    {
+        CaretMutexLocker myLock(&m_rayHelperMutex);
+        if (m_rayHelper == NULL)
+        {
+            m_rayHelper.grabNew(new RayIntersectionHelper(this));
+        }
+    }
+    return m_rayHelper;
+}
+
 /**
  * @return Information about the surface.
  */
@@ -1321,6 +1409,9 @@ SurfaceFile::invalidateNodeColoringForBrowserTabs()
         this->surfaceNodeColoringForBrowserTabs[i].clear();
         this->surfaceMontageNodeColoringForBrowserTabs[i].clear();
         this->wholeBrainNodeColoringForBrowserTabs[i].clear();
+        m_surfaceNodeColoringModificationNumbers[i] = newModificationNumber();
+        m_surfaceMontageNodeColoringModificationNumbers[i] = newModificationNumber();
+        m_wholeBrainNodeColoringModificationNumbers[i] = newModificationNumber();
     }    
 }
 
@@ -1450,6 +1541,7 @@ SurfaceFile::setSurfaceNodeColoringRgbaForBrowserTab(const int32_t browserTabInd
     for (int32_t i = 0; i < numberOfComponentsRGBA; i++) {
         rgba[i] = rgbaNodeColorComponents[i];
     }
+    m_surfaceNodeColoringModificationNumbers[browserTabIndex] = newModificationNumber();
 }
 
 /**
@@ -1497,6 +1589,7 @@ SurfaceFile::setSurfaceMontageNodeColoringRgbaForBrowserTab(const int32_t browse
     for (int32_t i = 0; i < numberOfComponentsRGBA; i++) {
         rgba[i] = rgbaNodeColorComponents[i];
     }
+    m_surfaceMontageNodeColoringModificationNumbers[browserTabIndex] = newModificationNumber();
 }
 
 
@@ -1544,6 +1637,7 @@ SurfaceFile::setWholeBrainNodeColoringRgbaForBrowserTab(const int32_t browserTab
     for (int32_t i = 0; i < numberOfComponentsRGBA; i++) {
         rgba[i] = rgbaNodeColorComponents[i];
     }
+    m_wholeBrainNodeColoringModificationNumbers[browserTabIndex] = newModificationNumber();
 }
 
 /**
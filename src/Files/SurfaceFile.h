@@ -44,6 +44,7 @@ namespace caret {
     class GiftiDataArray;
     class Matrix4x4;
     class PlainTextStringBuilder;
+    class RayIntersectionHelper;
     class SignedDistanceHelper;
     class SignedDistanceHelperBase;
     class TopologyHelper;
@@ -140,6 +141,8 @@ namespace caret {
         
         CaretPointer<const CaretPointLocator> getPointLocator() const;
         
+        CaretPointer<const RayIntersectionHelper> getRayIntersectionHelper() const;
+        
         const BoundingBox* getBoundingBox() const;
         
         void matchSurfaceBoundingBox(const SurfaceFile* surfaceFile);
@@ -174,6 +177,10 @@ namespace caret {
         void setWholeBrainNodeColoringRgbaForBrowserTab(const int32_t browserTabIndex,
                                               const float* rgbaNodeColorComponents);
 
+        int64_t getGeometryModificationNumber() const;
+        
+        int64_t getNodeColoringModificationNumber(const float* nodeColoringRGBA) const;
+        
         void invalidateNormals();
         
         void translateToCenterOfMass();
@@ -207,6 +214,8 @@ namespace caret {
     private:
         void invalidateNodeColoringForBrowserTabs();
         
+        static int64_t newModificationNumber();
+        
         void allocateSurfaceNodeColoringForBrowserTab(const int32_t browserTabIndex,
                                                       const bool zeroizeColorsFlag);
         
@@ -290,12 +299,23 @@ namespace caret {
         ///used to search for the closest point in the surface
         mutable CaretPointer<CaretPointLocator> m_locator;
         
+        ///used to find where a ray (such as from the mouse) hits the surface
+        mutable CaretPointer<RayIntersectionHelper> m_rayHelper;
+        
         ///used to track when the surface file gets changed
         void invalidateHelpers();
         
         mutable BoundingBox* boundingBox;
         
-        mutable CaretMutex m_topoHelperMutex, m_geoHelperMutex, m_locatorMutex, m_distHelperMutex;
+        ///changes whenever coordinates, normals, or triangles change, unique across all surface files
+        int64_t m_geometryModificationNumber;
+        
+        ///change whenever the node coloring of that kind for that browser tab is set or invalidated, so a tab's coloring change doesn't mark the others as changed
+        int64_t m_surfaceNodeColoringModificationNumbers[BrainConstants::MAXIMUM_NUMBER_OF_BROWSER_TABS];
+        int64_t m_surfaceMontageNodeColoringModificationNumbers[BrainConstants::MAXIMUM_NUMBER_OF_BROWSER_TABS];
+        int64_t m_wholeBrainNodeColoringModificationNumbers[BrainConstants::MAXIMUM_NUMBER_OF_BROWSER_TABS];
+        
+        mutable CaretMutex m_topoHelperMutex, m_geoHelperMutex, m_locatorMutex, m_distHelperMutex, m_rayHelperMutex;
     };
 
 } // namespace
@@ -24,6 +24,7 @@
 
 #include "CaretAssert.h"
 #include "CaretLogger.h"
+#include "CaretMutex.h"
 #include "DataFileException.h"
 #include "SurfaceProjectionBarycentric.h"
 #include "SurfaceProjectionVanEssen.h"
@@ -151,6 +152,7 @@ SurfaceProjectedItem::reset()
 void
 SurfaceProjectedItem::initializeMembersSurfaceProjectedItem()
 {
+    this->modificationNumber = newModificationNumber();
     this->barycentricProjection = new SurfaceProjectionBarycentric();
     this->vanEssenProjection    = new SurfaceProjectionVanEssen();
     this->reset();
@@ -456,6 +458,8 @@ SurfaceProjectedItem::setStructure(const StructureEnum::Enum structure)
 SurfaceProjectionBarycentric* 
 SurfaceProjectedItem::getBarycentricProjection()
 {
+    /* caller may change the projection */
+    this->modificationNumber = newModificationNumber();
     return this->barycentricProjection;
 }
 
@@ -474,6 +478,8 @@ SurfaceProjectedItem::getBarycentricProjection() const
 SurfaceProjectionVanEssen* 
 SurfaceProjectedItem::getVanEssenProjection()
 {
+    /* caller may change the projection */
+    this->modificationNumber = newModificationNumber();
     return this->vanEssenProjection;
 }
 
@@ -563,6 +569,16 @@ void SurfaceProjectedItem::readBorderFileXML1(QXmlStreamReader& xml)
     if (!haveStructure) throw DataFileException("SurfaceProjectedItem is missing Structure element");
 }
 
+/**
+ * Set the status to modified.
+ */
+void
+SurfaceProjectedItem::setModified()
+{
+    CaretObjectTracksModification::setModified();
+    this->modificationNumber = newModificationNumber();
+}
+
 /**
  * Set the status to unmodified.
  */
@@ -594,6 +610,33 @@ SurfaceProjectedItem::isModified() const
     return false;
 }
 
+/**
+ * @return Number that changes whenever the item is modified or its
+ * projections are accessed for modification.  Unlike the modified
+ * status, it is not reset when the item is saved, so it is used to
+ * find out if positions cached from the item are still valid.
+ */
+int64_t
+SurfaceProjectedItem::getModificationNumber() const
+{
+    return this->modificationNumber;
+}
+
+/**
+ * @return A new modification number, greater than any previously returned.
+ * Numbers are unique across all items (and the borders and foci that
+ * contain them) so that a number cached for a deleted item never matches
+ * an item later created at the same address.
+ */
+int64_t
+SurfaceProjectedItem::newModificationNumber()
+{
+    static CaretMutex counterMutex;
+    static int64_t counter = 0;
+    CaretMutexLocker locker(&counterMutex);
+    return ++counter;
+}
+
 /**
  * @return True if a projection (barycentric, vanessen)
  * is valid.  Otherwise, false.
@@ -106,10 +106,16 @@ namespace caret {
         
         void readBorderFileXML1(QXmlStreamReader& xml);
         
+        virtual void setModified();
+        
         virtual void clearModified();
         
         virtual bool isModified() const;
         
+        int64_t getModificationNumber() const;
+        
+        static int64_t newModificationNumber();
+        
         static AString XML_TAG_SURFACE_PROJECTED_ITEM;
         static AString XML_TAG_STEREOTAXIC_XYZ;
         static AString XML_TAG_VOLUME_XYZ;
@@ -136,6 +142,9 @@ namespace caret {
         
         /** The Van Essen projection */
         SurfaceProjectionVanEssen* vanEssenProjection;
+        
+        /** Changes whenever the position of the item may have changed */
+        int64_t modificationNumber;
     };
     
 #ifdef __SURFACE_PROJECTED_ITEM_DEFINE__
@@ -0,0 +1,264 @@
+
+/*LICENSE_START*/
+/*
+ *  Copyright (C) 2014  Washington University School of Medicine
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+/*LICENSE_END*/
+
+#define __SURFACE_PROJECTED_ITEM_LOCATOR_DECLARE__
+#include "SurfaceProjectedItemLocator.h"
+#undef __SURFACE_PROJECTED_ITEM_LOCATOR_DECLARE__
+
+#include <cmath>
+#include <set>
+
+#include "CaretAssert.h"
+#include "CaretPointLocator.h"
+#include "SurfaceFile.h"
+#include "SurfaceProjectedItem.h"
+
+using namespace caret;
+
+
+    
+/**
+ * \class caret::SurfaceProjectedItemLocator 
+ * \brief Spatial index of border points or focus projections on a surface.
+ *
+ * Items are unprojected to the surface once, when they are added, and
+ * their coordinates are placed into a point locator so that searches
+ * for items near a coordinate do not unproject and test every item.
+ *
+ * An item belongs to an owner (a border or a focus).  The position
+ * modification number of each owner is kept so that the file holding
+ * the owners can find out if the locator is still valid, and create a
+ * new locator after the owners or the surface's coordinates change.
+ */
+
+/**
+ * Constructor.
+ *
+ * @param surfaceFile
+ *    Surface on which items are unprojected.
+ * @param unprojectOntoSurfaceFlag
+ *    If true, items are unprojected directly onto the surface, else
+ *    items are unprojected including their distance above the surface.
+ */
+SurfaceProjectedItemLocator::SurfaceProjectedItemLocator(const SurfaceFile* surfaceFile,
+                                                         const bool unprojectOntoSurfaceFlag)
+: CaretObject(),
+m_surfaceFile(surfaceFile),
+m_unprojectOntoSurfaceFlag(unprojectOntoSurfaceFlag),
+m_surfaceGeometryModificationNumber(surfaceFile->getGeometryModificationNumber())
+{
+    CaretAssert(surfaceFile);
+}
+
+/**
+ * Destructor.
+ */
+SurfaceProjectedItemLocator::~SurfaceProjectedItemLocator()
+{
+}
+
+/**
+ * Add an owner of items.  Items added after this call belong to this owner.
+ *
+ * @param owner
+ *    The owner (border or focus).
+ * @param positionModificationNumber
+ *    Current position modification number of the owner.
+ */
+void
+SurfaceProjectedItemLocator::addOwner(const void* owner,
+                                      const int64_t positionModificationNumber)
+{
+    m_owners.push_back(std::make_pair(owner,
+                                      positionModificationNumber));
+}
+
+/**
+ * Add an item belonging to the most recently added owner.  The item
+ * is ignored if it does not unproject to the surface.
+ *
+ * @param item
+ *    The item.
+ * @param itemIndex
+ *    Index of the item in its owner.
+ */
+void
+SurfaceProjectedItemLocator::addItem(const SurfaceProjectedItem* item,
+                                     const int32_t itemIndex)
+{
+    CaretAssert(item);
+    CaretAssert( ! m_owners.empty());
+    
+    float xyz[3];
+    if ( ! item->getProjectedPosition(*m_surfaceFile,
+                                      xyz,
+                                      m_unprojectOntoSurfaceFlag)) {
+        return;
+    }
+    
+    m_itemXYZ.push_back(xyz[0]);
+    m_itemXYZ.push_back(xyz[1]);
+    m_itemXYZ.push_back(xyz[2]);
+    m_itemOwnerIndices.push_back(static_cast<int32_t>(m_owners.size()) - 1);
+    m_itemIndices.push_back(itemIndex);
+    
+    m_pointLocator.grabNew(NULL);
+}
+
+/**
+ * @return True if this locator was created for the given surface and
+ * the coordinates of the surface have not changed since.
+ *
+ * @param surfaceFile
+ *    The surface.
+ */
+bool
+SurfaceProjectedItemLocator::isValidForSurface(const SurfaceFile* surfaceFile) const
+{
+    return ((surfaceFile == m_surfaceFile)
+            && (surfaceFile->getGeometryModificationNumber() == m_surfaceGeometryModificationNumber));
+}
+
+/**
+ * @return Number of owners that have been added.
+ */
+int32_t
+SurfaceProjectedItemLocator::getNumberOfOwners() const
+{
+    return static_cast<int32_t>(m_owners.size());
+}
+
+/**
+ * Is the owner at the given index the same, and unchanged, since it was added?
+ *
+ * @param ownerIndex
+ *    Index of the owner.
+ * @param owner
+ *    The owner now at the index.
+ * @param positionModificationNumber
+ *    Current position modification number of the owner.
+ * @return
+ *    True if the owner's items in this locator are still valid.
+ */
+bool
+SurfaceProjectedItemLocator::isOwnerUnchanged(const int32_t ownerIndex,
+                                              const void* owner,
+                                              const int64_t positionModificationNumber) const
+{
+    CaretAssertVectorIndex(m_owners, ownerIndex);
+    return ((m_owners[ownerIndex].first == owner)
+            && (m_owners[ownerIndex].second == positionModificationNumber));
+}
+
+/**
+ * Find all items within the given distance of a coordinate.
+ *
+ * @param xyz
+ *    The coordinate.
+ * @param maximumDistance
+ *    Maximum distance of an item from the coordinate.
+ * @param matchesOut
+ *    Output with the items, sorted by owner index and then item index.
+ */
+void
+SurfaceProjectedItemLocator::findItemsWithinDistance(const float xyz[3],
+                                                     const float maximumDistance,
+                                                     std::vector<Match>& matchesOut) const
+{
+    matchesOut.clear();
+    if (m_itemIndices.empty()) {
+        return;
+    }
+    createPointLocator();
+    
+    /*
+     * Points are added in owner order so the set,
+     * sorted by point index, is in owner order too
+     */
+    const std::set<LocatorInfo> pointsFound = m_pointLocator->pointsInRange(xyz,
+                                                                            maximumDistance);
+    matchesOut.reserve(pointsFound.size());
+    for (std::set<LocatorInfo>::const_iterator iter = pointsFound.begin();
+         iter != pointsFound.end();
+         iter++) {
+        const int32_t pointIndex = iter->index;
+        CaretAssertVectorIndex(m_itemIndices, pointIndex);
+        Match match;
+        match.m_ownerIndex = m_itemOwnerIndices[pointIndex];
+        match.m_itemIndex  = m_itemIndices[pointIndex];
+        match.m_distance   = (iter->coords - Vector3D(xyz)).length();
+        matchesOut.push_back(match);
+    }
+}
+
+/**
+ * Find the item nearest a coordinate.
+ *
+ * @param xyz
+ *    The coordinate.
+ * @param maximumDistance
+ *    Maximum distance of the item from the coordinate.  If negative,
+ *    there is no limit on the distance.
+ * @param matchOut
+ *    Output with the nearest item.
+ * @return
+ *    True if an item was found, else false.
+ */
+bool
+SurfaceProjectedItemLocator::findNearestItem(const float xyz[3],
+                                             const float maximumDistance,
+                                             Match& matchOut) const
+{
+    if (m_itemIndices.empty()) {
+        return false;
+    }
+    createPointLocator();
+    
+    LocatorInfo info(-1, -1, Vector3D());
+    const int32_t pointIndex = ((maximumDistance >= 0.0)
+                                ? m_pointLocator->closestPointLimited(xyz,
+                                                                      maximumDistance,
+                                                                      &info)
+                                : m_pointLocator->closestPoint(xyz,
+                                                               &info));
+    if (pointIndex < 0) {
+        return false;
+    }
+    
+    CaretAssertVectorIndex(m_itemIndices, pointIndex);
+    matchOut.m_ownerIndex = m_itemOwnerIndices[pointIndex];
+    matchOut.m_itemIndex  = m_itemIndices[pointIndex];
+    matchOut.m_distance   = (info.coords - Vector3D(xyz)).length();
+    return true;
+}
+
+/**
+ * Create the point locator if items were added since it was last created.
+ */
+void
+SurfaceProjectedItemLocator::createPointLocator() const
+{
+    if (m_pointLocator == NULL) {
+        m_pointLocator.grabNew(new CaretPointLocator(&m_itemXYZ[0],
+                                                     static_cast<int32_t>(m_itemIndices.size())));
+    }
+}
+
@@ -0,0 +1,117 @@
+#ifndef __SURFACE_PROJECTED_ITEM_LOCATOR_H__
+#define __SURFACE_PROJECTED_ITEM_LOCATOR_H__
+
+
+/*LICENSE_START*/
+/*
+ *  Copyright (C) 2014  Washington University School of Medicine
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+/*LICENSE_END*/
+
+#include <stdint.h>
+#include <vector>
+
+#include "CaretObject.h"
+#include "CaretPointer.h"
+
+namespace caret {
+
+    class CaretPointLocator;
+    class SurfaceFile;
+    class SurfaceProjectedItem;
+    
+    class SurfaceProjectedItemLocator : public CaretObject {
+        
+    public:
+        /** An item found by a search */
+        struct Match {
+            Match() : m_ownerIndex(-1), m_itemIndex(-1), m_distance(0.0) { }
+            
+            /** Index of the border or focus containing the item */
+            int32_t m_ownerIndex;
+            
+            /** Index of the item (border point or focus projection) in its owner */
+            int32_t m_itemIndex;
+            
+            /** Distance from the search coordinate to the item */
+            float m_distance;
+        };
+        
+        SurfaceProjectedItemLocator(const SurfaceFile* surfaceFile,
+                                    const bool unprojectOntoSurfaceFlag);
+        
+        virtual ~SurfaceProjectedItemLocator();
+        
+        // ADD_NEW_METHODS_HERE
+        
+        void addOwner(const void* owner,
+                      const int64_t positionModificationNumber);
+        
+        void addItem(const SurfaceProjectedItem* item,
+                     const int32_t itemIndex);
+        
+        bool isValidForSurface(const SurfaceFile* surfaceFile) const;
+        
+        int32_t getNumberOfOwners() const;
+        
+        bool isOwnerUnchanged(const int32_t ownerIndex,
+                              const void* owner,
+                              const int64_t positionModificationNumber) const;
+        
+        void findItemsWithinDistance(const float xyz[3],
+                                     const float maximumDistance,
+                                     std::vector<Match>& matchesOut) const;
+        
+        bool findNearestItem(const float xyz[3],
+                             const float maximumDistance,
+                             Match& matchOut) const;
+        
+    private:
+        SurfaceProjectedItemLocator(const SurfaceProjectedItemLocator&);
+
+        SurfaceProjectedItemLocator& operator=(const SurfaceProjectedItemLocator&);
+        
+        void createPointLocator() const;
+        
+        // ADD_NEW_MEMBERS_HERE
+
+        const SurfaceFile* m_surfaceFile;
+        
+        const bool m_unprojectOntoSurfaceFlag;
+        
+        const int64_t m_surfaceGeometryModificationNumber;
+        
+        /** Owner and its position modification number when its items were added */
+        std::vector<std::pair<const void*, int64_t> > m_owners;
+        
+        /** Projected coordinates of the items, three per item */
+        std::vector<float> m_itemXYZ;
+        
+        std::vector<int32_t> m_itemOwnerIndices;
+        
+        std::vector<int32_t> m_itemIndices;
+        
+        /** Created at the first search after items are added */
+        mutable CaretPointer<CaretPointLocator> m_pointLocator;
+    };
+    
+#ifdef __SURFACE_PROJECTED_ITEM_LOCATOR_DECLARE__
+    // <PLACE DECLARATIONS OF STATIC MEMBERS HERE>
+#endif // __SURFACE_PROJECTED_ITEM_LOCATOR_DECLARE__
+
+} // namespace
+#endif  //__SURFACE_PROJECTED_ITEM_LOCATOR_H__
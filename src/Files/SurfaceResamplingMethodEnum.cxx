@@ -23,9 +23,19 @@
 #include "SurfaceResamplingMethodEnum.h"
 
 #include "CaretAssert.h"
+#include "CaretMutex.h"
 
 using namespace caret;
 
+namespace
+{
+    CaretMutex& getInitializeMutex()
+    {//function-local, so it exists even if the enum is first used while initializing another static
+        static CaretMutex s_initializeMutex;
+        return s_initializeMutex;
+    }
+}
+
 std::vector<SurfaceResamplingMethodEnum> SurfaceResamplingMethodEnum::enumData;
 bool SurfaceResamplingMethodEnum::initializedFlag = false;
 
@@ -74,10 +84,10 @@ SurfaceResamplingMethodEnum::~SurfaceResamplingMethodEnum()
 void
 SurfaceResamplingMethodEnum::initialize()
 {
+    CaretMutexLocker locker(&getInitializeMutex());//always lock, an unlocked check of the flag could see it set before the data it guards
     if (initializedFlag) {
         return;
     }
-    initializedFlag = true;
 
     enumData.push_back(SurfaceResamplingMethodEnum(ADAP_BARY_AREA, 
                                     0, 
@@ -89,6 +99,7 @@ SurfaceResamplingMethodEnum::initialize()
                                     "BARYCENTRIC", 
                                     "barycentric"));
     
+    initializedFlag = true;
 }
 
 /**
@@ -101,7 +112,7 @@ SurfaceResamplingMethodEnum::initialize()
 const SurfaceResamplingMethodEnum*
 SurfaceResamplingMethodEnum::findData(const Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
 
     size_t num = enumData.size();
     for (size_t i = 0; i < num; i++) {
@@ -123,7 +134,7 @@ SurfaceResamplingMethodEnum::findData(const Enum enumValue)
  */
 AString 
 SurfaceResamplingMethodEnum::toName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const SurfaceResamplingMethodEnum* enumInstance = findData(enumValue);
     return enumInstance->name;
@@ -142,7 +153,7 @@ SurfaceResamplingMethodEnum::toName(Enum enumValue) {
 SurfaceResamplingMethodEnum::Enum 
 SurfaceResamplingMethodEnum::fromName(const AString& name, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = ADAP_BARY_AREA;
@@ -176,7 +187,7 @@ SurfaceResamplingMethodEnum::fromName(const AString& name, bool* isValidOut)
  */
 AString 
 SurfaceResamplingMethodEnum::toGuiName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const SurfaceResamplingMethodEnum* enumInstance = findData(enumValue);
     return enumInstance->guiName;
@@ -195,7 +206,7 @@ SurfaceResamplingMethodEnum::toGuiName(Enum enumValue) {
 SurfaceResamplingMethodEnum::Enum 
 SurfaceResamplingMethodEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = ADAP_BARY_AREA;
@@ -229,7 +240,7 @@ SurfaceResamplingMethodEnum::fromGuiName(const AString& guiName, bool* isValidOu
 int32_t
 SurfaceResamplingMethodEnum::toIntegerCode(Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     const SurfaceResamplingMethodEnum* enumInstance = findData(enumValue);
     return enumInstance->integerCode;
 }
@@ -248,7 +259,7 @@ SurfaceResamplingMethodEnum::toIntegerCode(Enum enumValue)
 SurfaceResamplingMethodEnum::Enum
 SurfaceResamplingMethodEnum::fromIntegerCode(const int32_t integerCode, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = ADAP_BARY_AREA;
@@ -283,7 +294,7 @@ SurfaceResamplingMethodEnum::fromIntegerCode(const int32_t integerCode, bool* is
 void
 SurfaceResamplingMethodEnum::getAllEnums(std::vector<SurfaceResamplingMethodEnum::Enum>& allEnums)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allEnums.clear();
     
@@ -305,7 +316,7 @@ SurfaceResamplingMethodEnum::getAllEnums(std::vector<SurfaceResamplingMethodEnum
 void
 SurfaceResamplingMethodEnum::getAllNames(std::vector<AString>& allNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allNames.clear();
     
@@ -331,7 +342,7 @@ SurfaceResamplingMethodEnum::getAllNames(std::vector<AString>& allNames, const b
 void
 SurfaceResamplingMethodEnum::getAllGuiNames(std::vector<AString>& allGuiNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allGuiNames.clear();
     
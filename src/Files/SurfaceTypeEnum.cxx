@@ -23,8 +23,19 @@
 #include "SurfaceTypeEnum.h"
 #undef __SURFACE_TYPE_ENUM_DECLARE__
 
+#include "CaretMutex.h"
+
 using namespace caret;
 
+namespace
+{
+    CaretMutex& getInitializeMutex()
+    {//function-local, so it exists even if the enum is first used while initializing another static
+        static CaretMutex s_initializeMutex;
+        return s_initializeMutex;
+    }
+}
+
 /**
  * Constructor.
  *
@@ -58,10 +69,10 @@ SurfaceTypeEnum::~SurfaceTypeEnum()
 void
 SurfaceTypeEnum::initialize()
 {
+    CaretMutexLocker locker(&getInitializeMutex());//always lock, an unlocked check of the flag could see it set before the data it guards
     if (initializedFlag) {
         return;
     }
-    initializedFlag = true;
 
     enumData.push_back(SurfaceTypeEnum(UNKNOWN, 
                                        "UNKNOWN", 
@@ -103,6 +114,8 @@ SurfaceTypeEnum::initialize()
                                        "HULL", 
                                        "Hull",
                                        "Hull"));
+    
+    initializedFlag = true;
 }
 
 /**
@@ -338,7 +351,7 @@ SurfaceTypeEnum::fromGiftiName(const AString& s, bool* isValidOut)
 void
 SurfaceTypeEnum::getAllEnums(std::vector<SurfaceTypeEnum::Enum>& allEnums)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allEnums.clear();
     
@@ -418,10 +431,10 @@ SecondarySurfaceTypeEnum::SecondarySurfaceTypeEnum(const Enum e,
 void
 SecondarySurfaceTypeEnum::initialize()
 {
+    CaretMutexLocker locker(&getInitializeMutex());//always lock, an unlocked check of the flag could see it set before the data it guards
     if (initializedFlag) {
         return;
     }
-    initializedFlag = true;
 
     enumData.push_back(SecondarySurfaceTypeEnum(INVALID, 
                                        "INVALID", 
@@ -439,6 +452,8 @@ SecondarySurfaceTypeEnum::initialize()
                                        "PIAL", 
                                        "Pial",
                                        "Pial"));
+    
+    initializedFlag = true;
 }
 
 /**
@@ -674,7 +689,7 @@ SecondarySurfaceTypeEnum::fromGiftiName(const AString& s, bool* isValidOut)
 void
 SecondarySurfaceTypeEnum::getAllEnums(std::vector<SecondarySurfaceTypeEnum::Enum>& allEnums)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allEnums.clear();
     
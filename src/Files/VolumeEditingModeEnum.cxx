@@ -25,9 +25,19 @@
 #undef __VOLUME_EDITING_MODE_DECLARE__
 
 #include "CaretAssert.h"
+#include "CaretMutex.h"
 
 using namespace caret;
 
+namespace
+{
+    CaretMutex& getInitializeMutex()
+    {//function-local, so it exists even if the enum is first used while initializing another static
+        static CaretMutex s_initializeMutex;
+        return s_initializeMutex;
+    }
+}
+
     
 /**
  * \class caret::VolumeEditingModeEnum 
@@ -106,10 +116,10 @@ VolumeEditingModeEnum::~VolumeEditingModeEnum()
 void
 VolumeEditingModeEnum::initialize()
 {
+    CaretMutexLocker locker(&getInitializeMutex());//always lock, an unlocked check of the flag could see it set before the data it guards
     if (initializedFlag) {
         return;
     }
-    initializedFlag = true;
 
     enumData.push_back(VolumeEditingModeEnum(VOLUME_EDITING_MODE_ON,
                                              "VOLUME_EDITING_MODE_ON",
@@ -160,6 +170,7 @@ VolumeEditingModeEnum::initialize()
                                              "Retain 3D",
                                              "Remove voxel not connected to region (3D) at mouse click"));
     
+    initializedFlag = true;
 }
 
 /**
@@ -172,7 +183,7 @@ VolumeEditingModeEnum::initialize()
 const VolumeEditingModeEnum*
 VolumeEditingModeEnum::findData(const Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
 
     size_t num = enumData.size();
     for (size_t i = 0; i < num; i++) {
@@ -195,7 +206,7 @@ VolumeEditingModeEnum::findData(const Enum enumValue)
 AString
 VolumeEditingModeEnum::toToolTip(Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const VolumeEditingModeEnum* enumInstance = findData(enumValue);
     return enumInstance->toolTipText;
@@ -211,7 +222,7 @@ VolumeEditingModeEnum::toToolTip(Enum enumValue)
  */
 AString 
 VolumeEditingModeEnum::toName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const VolumeEditingModeEnum* enumInstance = findData(enumValue);
     return enumInstance->name;
@@ -230,7 +241,7 @@ VolumeEditingModeEnum::toName(Enum enumValue) {
 VolumeEditingModeEnum::Enum 
 VolumeEditingModeEnum::fromName(const AString& name, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = VolumeEditingModeEnum::enumData[0].enumValue;
@@ -264,7 +275,7 @@ VolumeEditingModeEnum::fromName(const AString& name, bool* isValidOut)
  */
 AString 
 VolumeEditingModeEnum::toGuiName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const VolumeEditingModeEnum* enumInstance = findData(enumValue);
     return enumInstance->guiName;
@@ -283,7 +294,7 @@ VolumeEditingModeEnum::toGuiName(Enum enumValue) {
 VolumeEditingModeEnum::Enum 
 VolumeEditingModeEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = VolumeEditingModeEnum::enumData[0].enumValue;
@@ -317,7 +328,7 @@ VolumeEditingModeEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 int32_t
 VolumeEditingModeEnum::toIntegerCode(Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     const VolumeEditingModeEnum* enumInstance = findData(enumValue);
     return enumInstance->integerCode;
 }
@@ -336,7 +347,7 @@ VolumeEditingModeEnum::toIntegerCode(Enum enumValue)
 VolumeEditingModeEnum::Enum
 VolumeEditingModeEnum::fromIntegerCode(const int32_t integerCode, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = VolumeEditingModeEnum::enumData[0].enumValue;
@@ -371,7 +382,7 @@ VolumeEditingModeEnum::fromIntegerCode(const int32_t integerCode, bool* isValidO
 void
 VolumeEditingModeEnum::getAllEnums(std::vector<VolumeEditingModeEnum::Enum>& allEnums)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allEnums.clear();
     
@@ -393,7 +404,7 @@ VolumeEditingModeEnum::getAllEnums(std::vector<VolumeEditingModeEnum::Enum>& all
 void
 VolumeEditingModeEnum::getAllNames(std::vector<AString>& allNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allNames.clear();
     
@@ -419,7 +430,7 @@ VolumeEditingModeEnum::getAllNames(std::vector<AString>& allNames, const bool is
 void
 VolumeEditingModeEnum::getAllGuiNames(std::vector<AString>& allGuiNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allGuiNames.clear();
     
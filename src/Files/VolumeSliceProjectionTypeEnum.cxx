@@ -25,9 +25,19 @@
 #undef __VOLUME_SLICE_PROJECTION_TYPE_ENUM_DECLARE__
 
 #include "CaretAssert.h"
+#include "CaretMutex.h"
 
 using namespace caret;
 
+namespace
+{
+    CaretMutex& getInitializeMutex()
+    {//function-local, so it exists even if the enum is first used while initializing another static
+        static CaretMutex s_initializeMutex;
+        return s_initializeMutex;
+    }
+}
+
     
 /**
  * \class caret::VolumeSliceProjectionTypeEnum 
@@ -103,10 +113,10 @@ VolumeSliceProjectionTypeEnum::~VolumeSliceProjectionTypeEnum()
 void
 VolumeSliceProjectionTypeEnum::initialize()
 {
+    CaretMutexLocker locker(&getInitializeMutex());//always lock, an unlocked check of the flag could see it set before the data it guards
     if (initializedFlag) {
         return;
     }
-    initializedFlag = true;
 
     enumData.push_back(VolumeSliceProjectionTypeEnum(VOLUME_SLICE_PROJECTION_OBLIQUE, 
                                     "VOLUME_SLICE_PROJECTION_OBLIQUE", 
@@ -116,6 +126,7 @@ VolumeSliceProjectionTypeEnum::initialize()
                                     "VOLUME_SLICE_PROJECTION_ORTHOGONAL", 
                                     "Orthogonal"));
     
+    initializedFlag = true;
 }
 
 /**
@@ -128,7 +139,7 @@ VolumeSliceProjectionTypeEnum::initialize()
 const VolumeSliceProjectionTypeEnum*
 VolumeSliceProjectionTypeEnum::findData(const Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
 
     size_t num = enumData.size();
     for (size_t i = 0; i < num; i++) {
@@ -150,7 +161,7 @@ VolumeSliceProjectionTypeEnum::findData(const Enum enumValue)
  */
 AString 
 VolumeSliceProjectionTypeEnum::toName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const VolumeSliceProjectionTypeEnum* enumInstance = findData(enumValue);
     return enumInstance->name;
@@ -169,7 +180,7 @@ VolumeSliceProjectionTypeEnum::toName(Enum enumValue) {
 VolumeSliceProjectionTypeEnum::Enum 
 VolumeSliceProjectionTypeEnum::fromName(const AString& name, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = VolumeSliceProjectionTypeEnum::enumData[0].enumValue;
@@ -203,7 +214,7 @@ VolumeSliceProjectionTypeEnum::fromName(const AString& name, bool* isValidOut)
  */
 AString 
 VolumeSliceProjectionTypeEnum::toGuiName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const VolumeSliceProjectionTypeEnum* enumInstance = findData(enumValue);
     return enumInstance->guiName;
@@ -222,7 +233,7 @@ VolumeSliceProjectionTypeEnum::toGuiName(Enum enumValue) {
 VolumeSliceProjectionTypeEnum::Enum 
 VolumeSliceProjectionTypeEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = VolumeSliceProjectionTypeEnum::enumData[0].enumValue;
@@ -256,7 +267,7 @@ VolumeSliceProjectionTypeEnum::fromGuiName(const AString& guiName, bool* isValid
 int32_t
 VolumeSliceProjectionTypeEnum::toIntegerCode(Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     const VolumeSliceProjectionTypeEnum* enumInstance = findData(enumValue);
     return enumInstance->integerCode;
 }
@@ -275,7 +286,7 @@ VolumeSliceProjectionTypeEnum::toIntegerCode(Enum enumValue)
 VolumeSliceProjectionTypeEnum::Enum
 VolumeSliceProjectionTypeEnum::fromIntegerCode(const int32_t integerCode, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = VolumeSliceProjectionTypeEnum::enumData[0].enumValue;
@@ -310,7 +321,7 @@ VolumeSliceProjectionTypeEnum::fromIntegerCode(const int32_t integerCode, bool*
 void
 VolumeSliceProjectionTypeEnum::getAllEnums(std::vector<VolumeSliceProjectionTypeEnum::Enum>& allEnums)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allEnums.clear();
     
@@ -332,7 +343,7 @@ VolumeSliceProjectionTypeEnum::getAllEnums(std::vector<VolumeSliceProjectionType
 void
 VolumeSliceProjectionTypeEnum::getAllNames(std::vector<AString>& allNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allNames.clear();
     
@@ -358,7 +369,7 @@ VolumeSliceProjectionTypeEnum::getAllNames(std::vector<AString>& allNames, const
 void
 VolumeSliceProjectionTypeEnum::getAllGuiNames(std::vector<AString>& allGuiNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allGuiNames.clear();
     
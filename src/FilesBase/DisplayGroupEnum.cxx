@@ -25,9 +25,19 @@
 #undef __DISPLAY_GROUP_ENUM_DECLARE__
 
 #include "CaretAssert.h"
+#include "CaretMutex.h"
 
 using namespace caret;
 
+namespace
+{
+    CaretMutex& getInitializeMutex()
+    {//function-local, so it exists even if the enum is first used while initializing another static
+        static CaretMutex s_initializeMutex;
+        return s_initializeMutex;
+    }
+}
+
     
 /**
  * \class caret::DisplayGroupEnum 
@@ -71,10 +81,10 @@ DisplayGroupEnum::~DisplayGroupEnum()
 void
 DisplayGroupEnum::initialize()
 {
+    CaretMutexLocker locker(&getInitializeMutex());//always lock, an unlocked check of the flag could see it set before the data it guards
     if (initializedFlag) {
         return;
     }
-    initializedFlag = true;
 
     enumData.push_back(DisplayGroupEnum(DISPLAY_GROUP_TAB, 
                                         "DISPLAY_GROUP_TAB", 
@@ -101,6 +111,7 @@ DisplayGroupEnum::initialize()
         CaretAssertMessage(0, "NUMBER_OF_GROUPS constant is incorrect.  New ENUMs added?");
     }
     
+    initializedFlag = true;
 }
 
 /**
@@ -113,7 +124,7 @@ DisplayGroupEnum::initialize()
 const DisplayGroupEnum*
 DisplayGroupEnum::findData(const Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
 
     size_t num = enumData.size();
     for (size_t i = 0; i < num; i++) {
@@ -135,7 +146,7 @@ DisplayGroupEnum::findData(const Enum enumValue)
  */
 AString 
 DisplayGroupEnum::toName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const DisplayGroupEnum* enumInstance = findData(enumValue);
     return enumInstance->name;
@@ -154,7 +165,7 @@ DisplayGroupEnum::toName(Enum enumValue) {
 DisplayGroupEnum::Enum 
 DisplayGroupEnum::fromName(const AString& name, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = getDefaultValue();
@@ -188,7 +199,7 @@ DisplayGroupEnum::fromName(const AString& name, bool* isValidOut)
  */
 AString 
 DisplayGroupEnum::toGuiName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const DisplayGroupEnum* enumInstance = findData(enumValue);
     return enumInstance->guiName;
@@ -207,7 +218,7 @@ DisplayGroupEnum::toGuiName(Enum enumValue) {
 DisplayGroupEnum::Enum 
 DisplayGroupEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = getDefaultValue();
@@ -241,7 +252,7 @@ DisplayGroupEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 int32_t
 DisplayGroupEnum::toIntegerCode(Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     const DisplayGroupEnum* enumInstance = findData(enumValue);
     return enumInstance->integerCode;
 }
@@ -260,7 +271,7 @@ DisplayGroupEnum::toIntegerCode(Enum enumValue)
 DisplayGroupEnum::Enum
 DisplayGroupEnum::fromIntegerCode(const int32_t integerCode, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = getDefaultValue();
@@ -295,7 +306,7 @@ DisplayGroupEnum::fromIntegerCode(const int32_t integerCode, bool* isValidOut)
 void
 DisplayGroupEnum::getAllEnums(std::vector<DisplayGroupEnum::Enum>& allEnums)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allEnums.clear();
     
@@ -317,7 +328,7 @@ DisplayGroupEnum::getAllEnums(std::vector<DisplayGroupEnum::Enum>& allEnums)
 void
 DisplayGroupEnum::getAllNames(std::vector<AString>& allNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allNames.clear();
     
@@ -343,7 +354,7 @@ DisplayGroupEnum::getAllNames(std::vector<AString>& allNames, const bool isSorte
 void
 DisplayGroupEnum::getAllGuiNames(std::vector<AString>& allGuiNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allGuiNames.clear();
     
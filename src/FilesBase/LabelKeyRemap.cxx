@@ -0,0 +1,156 @@
+/*LICENSE_START*/
+/*
+ *  Copyright (C) 2014  Washington University School of Medicine
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+/*LICENSE_END*/
+
+#include "LabelKeyRemap.h"
+
+#include "CaretOMP.h"
+
+#include <algorithm>
+#include <cmath>
+#include <set>
+
+using namespace caret;
+using namespace std;
+
+namespace
+{
+    const int64_t MAX_TABLE_SIZE = ((int64_t)1) << 24;//64MB of keys, beyond that use binary search
+    const int64_t SMALL_TABLE_SIZE = ((int64_t)1) << 16;//a table this small is always fine, bigger ones must be mostly filled by the remapping
+    const int64_t MAX_TABLE_PER_KEY = 4;
+    const int64_t PARALLEL_MIN_COUNT = ((int64_t)1) << 15;//fewer values than this aren't worth starting threads for
+    
+    inline int32_t roundToKey(const float& value)
+    {
+        return (int32_t)floor(value + 0.5f);
+    }
+}
+
+LabelKeyRemap::LabelKeyRemap(const map<int32_t, int32_t>& remap)
+{
+    m_passThrough = true;
+    m_unmappedKey = 0;
+    initialize(remap);
+}
+
+LabelKeyRemap::LabelKeyRemap(const map<int32_t, int32_t>& remap, const int32_t& unmappedKey)
+{
+    m_passThrough = false;
+    m_unmappedKey = unmappedKey;
+    initialize(remap);
+}
+
+void LabelKeyRemap::initialize(const map<int32_t, int32_t>& remap)
+{
+    m_tableStart = 0;
+    if (remap.empty()) return;
+    const int64_t first = remap.begin()->first, range = (int64_t)remap.rbegin()->first - first + 1;
+    if (range <= MAX_TABLE_SIZE && range <= max(MAX_TABLE_PER_KEY * (int64_t)remap.size(), SMALL_TABLE_SIZE))
+    {//a few far-apart keys would otherwise fill and scan a table far bigger than the data being remapped
+        m_tableStart = first;
+        m_table.resize(range);
+        for (int64_t i = 0; i < range; ++i)
+        {
+            m_table[i] = (m_passThrough ? (int32_t)(first + i) : m_unmappedKey);
+        }
+        for (map<int32_t, int32_t>::const_iterator iter = remap.begin(); iter != remap.end(); ++iter)
+        {
+            m_table[iter->first - first] = iter->second;
+        }
+    } else {
+        m_sparseKeys.reserve(remap.size());
+        m_sparseValues.reserve(remap.size());
+        for (map<int32_t, int32_t>::const_iterator iter = remap.begin(); iter != remap.end(); ++iter)
+        {//map iterates in sorted order
+            m_sparseKeys.push_back(iter->first);
+            m_sparseValues.push_back(iter->second);
+        }
+    }
+}
+
+int32_t LabelKeyRemap::remapOutsideTable(const int32_t& key) const
+{
+    if (!m_sparseKeys.empty())
+    {
+        vector<int32_t>::const_iterator iter = lower_bound(m_sparseKeys.begin(), m_sparseKeys.end(), key);
+        if (iter != m_sparseKeys.end() && *iter == key) return m_sparseValues[iter - m_sparseKeys.begin()];
+    }
+    return (m_passThrough ? key : m_unmappedKey);
+}
+
+void LabelKeyRemap::apply(const int32_t* keysIn, int32_t* keysOut, const int64_t& count) const
+{
+#pragma omp CARET_PARFOR schedule(static) if (count >= PARALLEL_MIN_COUNT)
+    for (int64_t i = 0; i < count; ++i)
+    {
+        keysOut[i] = remap(keysIn[i]);
+    }
+}
+
+void LabelKeyRemap::apply(const float* valuesIn, int32_t* keysOut, const int64_t& count) const
+{
+#pragma omp CARET_PARFOR schedule(static) if (count >= PARALLEL_MIN_COUNT)
+    for (int64_t i = 0; i < count; ++i)
+    {
+        keysOut[i] = remap(roundToKey(valuesIn[i]));
+    }
+}
+
+void LabelKeyRemap::apply(const float* valuesIn, float* valuesOut, const int64_t& count) const
+{
+#pragma omp CARET_PARFOR schedule(static) if (count >= PARALLEL_MIN_COUNT)
+    for (int64_t i = 0; i < count; ++i)
+    {
+        valuesOut[i] = remap(roundToKey(valuesIn[i]));
+    }
+}
+
+vector<int32_t> LabelKeyRemap::findKeysInOrder(const float* valuesIn, const int64_t& count)
+{
+    int numChunks = 1;
+#ifdef CARET_OMP
+    if (count >= PARALLEL_MIN_COUNT) numChunks = omp_get_max_threads();
+#endif
+    vector<vector<int32_t> > chunkKeys(numChunks);
+#pragma omp CARET_PARFOR schedule(static, 1)
+    for (int chunk = 0; chunk < numChunks; ++chunk)
+    {//each chunk finds its own first appearances, merging the chunks in order then gives the first appearances of the whole array
+        const int64_t start = count * chunk / numChunks, end = count * (chunk + 1) / numChunks;
+        vector<int32_t>& myKeys = chunkKeys[chunk];
+        set<int32_t> seen;
+        int32_t lastKey = 0;
+        for (int64_t i = start; i < end; ++i)
+        {
+            int32_t key = roundToKey(valuesIn[i]);
+            if (i > start && key == lastKey) continue;//label data is mostly runs of the same key, skip the set lookup for them
+            lastKey = key;
+            if (seen.insert(key).second) myKeys.push_back(key);
+        }
+    }
+    vector<int32_t> ret;
+    set<int32_t> seen;
+    for (int chunk = 0; chunk < numChunks; ++chunk)
+    {
+        for (size_t i = 0; i < chunkKeys[chunk].size(); ++i)
+        {
+            if (seen.insert(chunkKeys[chunk][i]).second) ret.push_back(chunkKeys[chunk][i]);
+        }
+    }
+    return ret;
+}
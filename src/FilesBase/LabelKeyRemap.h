@@ -0,0 +1,68 @@
+#ifndef __LABEL_KEY_REMAP_H__
+#define __LABEL_KEY_REMAP_H__
+
+/*LICENSE_START*/
+/*
+ *  Copyright (C) 2014  Washington University School of Medicine
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+/*LICENSE_END*/
+
+#include <map>
+#include <stdint.h>
+#include <vector>
+
+namespace caret {
+    
+    ///compiles a key remapping into a dense lookup table, to apply it to many label values in parallel
+    class LabelKeyRemap
+    {
+        bool m_passThrough;
+        int32_t m_unmappedKey;
+        int64_t m_tableStart;
+        std::vector<int32_t> m_table;//m_table[key - m_tableStart], covers the range of keys in the remapping
+        std::vector<int32_t> m_sparseKeys, m_sparseValues;//used instead of the table when the keys are too spread out for the table to be mostly filled
+        
+        void initialize(const std::map<int32_t, int32_t>& remap);
+        int32_t remapOutsideTable(const int32_t& key) const;
+    public:
+        ///keys that aren't in the remapping keep their value
+        explicit LabelKeyRemap(const std::map<int32_t, int32_t>& remap);
+        
+        ///keys that aren't in the remapping get unmappedKey
+        LabelKeyRemap(const std::map<int32_t, int32_t>& remap, const int32_t& unmappedKey);
+        
+        int32_t remap(const int32_t& key) const
+        {
+            int64_t index = (int64_t)key - m_tableStart;
+            if (index >= 0 && index < (int64_t)m_table.size()) return m_table[index];
+            return remapOutsideTable(key);
+        }
+        
+        void apply(const int32_t* keysIn, int32_t* keysOut, const int64_t& count) const;
+        
+        ///values are rounded to the nearest key first, as label data stored as float may not be exact
+        void apply(const float* valuesIn, int32_t* keysOut, const int64_t& count) const;
+        
+        void apply(const float* valuesIn, float* valuesOut, const int64_t& count) const;
+        
+        ///distinct keys after rounding, in the order they first appear, so labels can be created in the same order as a serial scan would
+        static std::vector<int32_t> findKeysInOrder(const float* valuesIn, const int64_t& count);
+    };
+    
+}
+
+#endif //__LABEL_KEY_REMAP_H__
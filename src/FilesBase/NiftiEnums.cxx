@@ -22,9 +22,19 @@
 #include "NiftiEnums.h"
 #undef __NIFTI_ENUMS_DECLARE__
 
+#include "CaretMutex.h"
 
 using namespace caret;
 
+namespace
+{
+    CaretMutex& getInitializeMutex()
+    {//function-local, so it exists even if the enum is first used while initializing another static
+        static CaretMutex s_initializeMutex;
+        return s_initializeMutex;
+    }
+}
+
 ///Nifti Data Type Enum
 NiftiDataTypeEnum::NiftiDataTypeEnum()
 {
@@ -517,10 +527,10 @@ NiftiSpacingUnitsEnum::~NiftiSpacingUnitsEnum()
 void 
 NiftiSpacingUnitsEnum::initializeSpacingUnits()
 {
+    CaretMutexLocker locker(&getInitializeMutex());//always lock, an unlocked check of the flag could see it set before the data it guards
     if (initializedFlag) {
         return;
     }
-    initializedFlag = true;
 
     spacingUnits.push_back(NiftiSpacingUnitsEnum(NIFTI_UNITS_UNKNOWN,
                                                  0,
@@ -534,6 +544,8 @@ NiftiSpacingUnitsEnum::initializeSpacingUnits()
     spacingUnits.push_back(NiftiSpacingUnitsEnum(NIFTI_UNITS_MICRON,
                                                  3,
                                                  "NIFTI_UNITS_MICRON"));
+    
+    initializedFlag = true;
 }
 
 /**
@@ -696,10 +708,10 @@ NiftiTimeUnitsEnum::~NiftiTimeUnitsEnum()
 void
 NiftiTimeUnitsEnum::initializeTimeUnits()
 {
+    CaretMutexLocker locker(&getInitializeMutex());//always lock, an unlocked check of the flag could see it set before the data it guards
     if (initializedFlag) {
         return;
     }
-    initializedFlag = true;
 
     enumData.push_back(NiftiTimeUnitsEnum(NIFTI_UNITS_UNKNOWN, 0,"NIFTI_UNITS_UNKNOWN","Unknown"));
     enumData.push_back(NiftiTimeUnitsEnum(NIFTI_UNITS_SEC, 8,"NIFTI_UNITS_SEC","Seconds"));
@@ -707,6 +719,8 @@ NiftiTimeUnitsEnum::initializeTimeUnits()
     enumData.push_back(NiftiTimeUnitsEnum(NIFTI_UNITS_USEC, 24,"NIFTI_UNITS_USEC","Microseconds"));
     enumData.push_back(NiftiTimeUnitsEnum(NIFTI_UNITS_HZ, 32,"NIFTI_UNITS_HZ","Hertz"));
     enumData.push_back(NiftiTimeUnitsEnum(NIFTI_UNITS_PPM, 40,"NIFTI_UNITS_PPM","Parts Per Million"));
+    
+    initializedFlag = true;
 }
 
 /**
@@ -881,16 +895,18 @@ NiftiTransformEnum::~NiftiTransformEnum()
 void
 NiftiTransformEnum::initialize()
 {
+    CaretMutexLocker locker(&getInitializeMutex());//always lock, an unlocked check of the flag could see it set before the data it guards
     if (initializedFlag) {
         return;
     }
-    initializedFlag = true;
 
     enumData.push_back(NiftiTransformEnum(NIFTI_XFORM_UNKNOWN, 0,"NIFTI_XFORM_UNKNOWN"));
     enumData.push_back(NiftiTransformEnum(NIFTI_XFORM_SCANNER_ANAT, 1,"NIFTI_XFORM_SCANNER_ANAT"));
     enumData.push_back(NiftiTransformEnum(NIFTI_XFORM_ALIGNED_ANAT, 2,"NIFTI_XFORM_ALIGNED_ANAT"));
     enumData.push_back(NiftiTransformEnum(NIFTI_XFORM_TALAIRACH, 3,"NIFTI_XFORM_TALAIRACH"));
     enumData.push_back(NiftiTransformEnum(NIFTI_XFORM_MNI_152, 4,"NIFTI_XFORM_MNI_152"));
+    
+    initializedFlag = true;
 }
 
 /**
@@ -1045,13 +1061,15 @@ NiftiVersionEnum::~NiftiVersionEnum()
 void
 NiftiVersionEnum::initialize()
 {
+    CaretMutexLocker locker(&getInitializeMutex());//always lock, an unlocked check of the flag could see it set before the data it guards
     if (initializedFlag) {
         return;
     }
-    initializedFlag = true;
 
     enumData.push_back(NiftiVersionEnum(NIFTI_VERSION_1, 348, "NIFTI_VERSION_1"));
     enumData.push_back(NiftiVersionEnum(NIFTI_VERSION_2, 540, "NIFTI_VERSION_2"));
+    
+    initializedFlag = true;
 }
 
 /**
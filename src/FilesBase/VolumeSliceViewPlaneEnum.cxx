@@ -25,9 +25,19 @@
 #undef __VOLUME_SLICE_VIEW_AXIS_ENUM_DECLARE__
 
 #include "CaretAssert.h"
+#include "CaretMutex.h"
 
 using namespace caret;
 
+namespace
+{
+    CaretMutex& getInitializeMutex()
+    {//function-local, so it exists even if the enum is first used while initializing another static
+        static CaretMutex s_initializeMutex;
+        return s_initializeMutex;
+    }
+}
+
     
 /**
  * \class VolumeSliceViewPlaneEnum 
@@ -73,10 +83,10 @@ VolumeSliceViewPlaneEnum::~VolumeSliceViewPlaneEnum()
 void
 VolumeSliceViewPlaneEnum::initialize()
 {
+    CaretMutexLocker locker(&getInitializeMutex());//always lock, an unlocked check of the flag could see it set before the data it guards
     if (initializedFlag) {
         return;
     }
-    initializedFlag = true;
 
     enumData.push_back(VolumeSliceViewPlaneEnum(ALL, 
                                                "ALL", 
@@ -96,7 +106,9 @@ VolumeSliceViewPlaneEnum::initialize()
     enumData.push_back(VolumeSliceViewPlaneEnum(PARASAGITTAL, 
                                                "PARASAGITTAL", 
                                                "Parasagittal",
-                                               "P"));    
+                                               "P"));
+    
+    initializedFlag = true;
 }
 
 /**
@@ -109,7 +121,7 @@ VolumeSliceViewPlaneEnum::initialize()
 const VolumeSliceViewPlaneEnum*
 VolumeSliceViewPlaneEnum::findData(const Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
 
     size_t num = enumData.size();
     for (size_t i = 0; i < num; i++) {
@@ -131,7 +143,7 @@ VolumeSliceViewPlaneEnum::findData(const Enum enumValue)
  */
 AString 
 VolumeSliceViewPlaneEnum::toName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const VolumeSliceViewPlaneEnum* enumInstance = findData(enumValue);
     return enumInstance->name;
@@ -150,7 +162,7 @@ VolumeSliceViewPlaneEnum::toName(Enum enumValue) {
 VolumeSliceViewPlaneEnum::Enum 
 VolumeSliceViewPlaneEnum::fromName(const AString& name, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = AXIAL;
@@ -184,7 +196,7 @@ VolumeSliceViewPlaneEnum::fromName(const AString& name, bool* isValidOut)
  */
 AString 
 VolumeSliceViewPlaneEnum::toGuiName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const VolumeSliceViewPlaneEnum* enumInstance = findData(enumValue);
     return enumInstance->guiName;
@@ -203,7 +215,7 @@ VolumeSliceViewPlaneEnum::toGuiName(Enum enumValue) {
 VolumeSliceViewPlaneEnum::Enum 
 VolumeSliceViewPlaneEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = AXIAL;
@@ -237,7 +249,7 @@ VolumeSliceViewPlaneEnum::fromGuiName(const AString& guiName, bool* isValidOut)
  */
 AString 
 VolumeSliceViewPlaneEnum::toGuiNameAbbreviation(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const VolumeSliceViewPlaneEnum* enumInstance = findData(enumValue);
     return enumInstance->guiNameAbbreviation;
@@ -256,7 +268,7 @@ VolumeSliceViewPlaneEnum::toGuiNameAbbreviation(Enum enumValue) {
 VolumeSliceViewPlaneEnum::Enum 
 VolumeSliceViewPlaneEnum::fromGuiNameAbbreviation(const AString& guiNameAbbreviation, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = AXIAL;
@@ -290,7 +302,7 @@ VolumeSliceViewPlaneEnum::fromGuiNameAbbreviation(const AString& guiNameAbbrevia
 int32_t
 VolumeSliceViewPlaneEnum::toIntegerCode(Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     const VolumeSliceViewPlaneEnum* enumInstance = findData(enumValue);
     return enumInstance->integerCode;
 }
@@ -309,7 +321,7 @@ VolumeSliceViewPlaneEnum::toIntegerCode(Enum enumValue)
 VolumeSliceViewPlaneEnum::Enum
 VolumeSliceViewPlaneEnum::fromIntegerCode(const int32_t integerCode, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = AXIAL;
@@ -344,7 +356,7 @@ VolumeSliceViewPlaneEnum::fromIntegerCode(const int32_t integerCode, bool* isVal
 void
 VolumeSliceViewPlaneEnum::getAllEnums(std::vector<VolumeSliceViewPlaneEnum::Enum>& allEnums)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allEnums.clear();
     
@@ -366,7 +378,7 @@ VolumeSliceViewPlaneEnum::getAllEnums(std::vector<VolumeSliceViewPlaneEnum::Enum
 void
 VolumeSliceViewPlaneEnum::getAllNames(std::vector<AString>& allNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allNames.clear();
     
@@ -392,7 +404,7 @@ VolumeSliceViewPlaneEnum::getAllNames(std::vector<AString>& allNames, const bool
 void
 VolumeSliceViewPlaneEnum::getAllGuiNames(std::vector<AString>& allGuiNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allGuiNames.clear();
     
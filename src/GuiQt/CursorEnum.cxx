@@ -25,9 +25,19 @@
 #undef __CURSOR_ENUM_DECLARE__
 
 #include "CaretAssert.h"
+#include "CaretMutex.h"
 
 using namespace caret;
 
+namespace
+{
+    CaretMutex& getInitializeMutex()
+    {//function-local, so it exists even if the enum is first used while initializing another static
+        static CaretMutex s_initializeMutex;
+        return s_initializeMutex;
+    }
+}
+
     
 /**
  * \class caret::CursorEnum 
@@ -71,10 +81,10 @@ CursorEnum::~CursorEnum()
 void
 CursorEnum::initialize()
 {
+    CaretMutexLocker locker(&getInitializeMutex());//always lock, an unlocked check of the flag could see it set before the data it guards
     if (initializedFlag) {
         return;
     }
-    initializedFlag = true;
 
     enumData.push_back(CursorEnum(CURSOR_DEFAULT, 
                                     "CURSOR_DEFAULT", 
@@ -104,6 +114,7 @@ CursorEnum::initialize()
                                   "CURSOR_WHATS_THIS",
                                   "What's this Cursor"));
     
+    initializedFlag = true;
 }
 
 /**
@@ -116,7 +127,7 @@ CursorEnum::initialize()
 const CursorEnum*
 CursorEnum::findData(const Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
 
     size_t num = enumData.size();
     for (size_t i = 0; i < num; i++) {
@@ -138,7 +149,7 @@ CursorEnum::findData(const Enum enumValue)
  */
 AString 
 CursorEnum::toName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const CursorEnum* enumInstance = findData(enumValue);
     return enumInstance->name;
@@ -157,7 +168,7 @@ CursorEnum::toName(Enum enumValue) {
 CursorEnum::Enum 
 CursorEnum::fromName(const AString& name, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = CURSOR_DEFAULT;
@@ -191,7 +202,7 @@ CursorEnum::fromName(const AString& name, bool* isValidOut)
  */
 AString 
 CursorEnum::toGuiName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const CursorEnum* enumInstance = findData(enumValue);
     return enumInstance->guiName;
@@ -210,7 +221,7 @@ CursorEnum::toGuiName(Enum enumValue) {
 CursorEnum::Enum 
 CursorEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = CURSOR_DEFAULT;
@@ -244,7 +255,7 @@ CursorEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 int32_t
 CursorEnum::toIntegerCode(Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     const CursorEnum* enumInstance = findData(enumValue);
     return enumInstance->integerCode;
 }
@@ -263,7 +274,7 @@ CursorEnum::toIntegerCode(Enum enumValue)
 CursorEnum::Enum
 CursorEnum::fromIntegerCode(const int32_t integerCode, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = CURSOR_DEFAULT;
@@ -298,7 +309,7 @@ CursorEnum::fromIntegerCode(const int32_t integerCode, bool* isValidOut)
 void
 CursorEnum::getAllEnums(std::vector<CursorEnum::Enum>& allEnums)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allEnums.clear();
     
@@ -320,7 +331,7 @@ CursorEnum::getAllEnums(std::vector<CursorEnum::Enum>& allEnums)
 void
 CursorEnum::getAllNames(std::vector<AString>& allNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allNames.clear();
     
@@ -346,7 +357,7 @@ CursorEnum::getAllNames(std::vector<AString>& allNames, const bool isSorted)
 void
 CursorEnum::getAllGuiNames(std::vector<AString>& allGuiNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allGuiNames.clear();
     
@@ -23,9 +23,19 @@
 #include "ViewModeEnum.h"
 #undef __VIEW_MODE_DECLARE__
 
+#include "CaretMutex.h"
 
 using namespace caret;
 
+namespace
+{
+    CaretMutex& getInitializeMutex()
+    {//function-local, so it exists even if the enum is first used while initializing another static
+        static CaretMutex s_initializeMutex;
+        return s_initializeMutex;
+    }
+}
+
 /**
  * Constructor.
  *
@@ -58,10 +68,10 @@ ViewModeEnum::~ViewModeEnum()
 void
 ViewModeEnum::initialize()
 {
+    CaretMutexLocker locker(&getInitializeMutex());//always lock, an unlocked check of the flag could see it set before the data it guards
     if (initializedFlag) {
         return;
     }
-    initializedFlag = true;
 
     enumData.push_back(ViewModeEnum(VIEW_MODE_INVALID, 
                                     0, 
@@ -82,6 +92,8 @@ ViewModeEnum::initialize()
                                     3, 
                                     "VIEW_MODE_WHOLE_BRAIN", 
                                     "Whole Brain"));
+    
+    initializedFlag = true;
 }
 
 /**
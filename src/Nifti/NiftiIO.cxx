@@ -20,11 +20,94 @@
 
 #include "NiftiIO.h"
 
+#include "CaretException.h"
 #include "DataFileException.h"
 
+#include <QThread>
+
+#include <algorithm>
+#include <cstring>
+#include <exception>
+
 using namespace std;
 using namespace caret;
 
+const int64_t NiftiIO::CONVERT_BLOCK_ELEMS = 1 << 12;
+const int64_t NiftiIO::CONVERT_PARALLEL_ELEMS = 1 << 16;
+
+namespace
+{
+    const int64_t OVERLAP_CHUNK_BYTES = 1 << 23;//reads or writes bigger than two of these overlap conversion with file access, and use at most two chunks of scratch
+    
+    class ChunkIOThread : public QThread
+    {//does the file access for one chunk while the calling thread converts another
+        CaretBinaryFile* m_file;
+        char* m_buffer;
+        int64_t m_numBytes, m_numDone;
+        bool m_writing;
+        QString m_error;
+    public:
+        ChunkIOThread(CaretBinaryFile* file)
+        {
+            m_file = file;
+            m_buffer = NULL;
+            m_numBytes = 0;
+            m_numDone = 0;
+            m_writing = false;
+        }
+        void startRead(char* buffer, const int64_t& numBytes)
+        {
+            m_buffer = buffer;
+            m_numBytes = numBytes;
+            m_writing = false;
+            start();
+        }
+        void startWrite(char* buffer, const int64_t& numBytes)
+        {
+            m_buffer = buffer;
+            m_numBytes = numBytes;
+            m_writing = true;
+            start();
+        }
+        int64_t getNumDone() const { return m_numDone; }
+        void checkError() const
+        {
+            if (!m_error.isEmpty()) throw DataFileException(m_error);
+        }
+    protected:
+        void run()
+        {//exceptions can't cross threads, so save the message for checkError()
+            try
+            {
+                if (m_writing)
+                {
+                    m_file->write(m_buffer, m_numBytes);
+                    m_numDone = m_numBytes;
+                } else {
+                    m_numDone = 0;
+                    m_file->read(m_buffer, m_numBytes, &m_numDone);
+                }
+            } catch (CaretException& e) {
+                m_error = e.whatString();
+            } catch (exception& e) {
+                m_error = e.what();
+            }
+        }
+    };
+    
+    void checkShortRead(char* buffer, const int64_t& numRead, const int64_t& numBytes, const bool& tolerateShortRead, const QString& filename)
+    {
+        if ((numRead != numBytes && !tolerateShortRead) || numRead < 0)//for now, assume read giving -1 is always a problem
+        {
+            throw DataFileException("error while reading from file '" + filename + "'");
+        }
+        if (numRead < numBytes)
+        {
+            memset(buffer + numRead, 0, numBytes - numRead);//past the end of a file being written, treat it as zeros, like readDirect
+        }
+    }
+}
+
 void NiftiIO::openRead(const QString& filename)
 {
     m_file.open(filename);
@@ -124,3 +207,111 @@ int NiftiIO::numBytesPerElem()
             throw DataFileException("internal error, report what you did to the developers");
     }
 }
+
+bool NiftiIO::isNativeFloat() const
+{
+    double mult, offset;
+    return m_header.getDataType() == NIFTI_TYPE_FLOAT32 && !m_header.isSwapped() && !m_header.getDataScaling(mult, offset);
+}
+
+bool NiftiIO::readDirect(float* dataOut, const int64_t& numElems, const bool& tolerateShortRead)
+{
+    if (!isNativeFloat()) return false;
+    int64_t numRead = 0;
+    m_file.read(dataOut, numElems * sizeof(float), &numRead);
+    if ((numRead != numElems * (int64_t)sizeof(float) && !tolerateShortRead) || numRead < 0)
+    {
+        throw DataFileException("error while reading from file '" + m_file.getFilename() + "'");
+    }
+    int64_t numFull = numRead / sizeof(float);
+    for (int64_t i = numFull; i < numElems; ++i)//past the end of a file being written, treat it as zeros
+    {
+        dataOut[i] = 0.0f;
+    }
+    return true;
+}
+
+bool NiftiIO::writeDirect(const float* dataIn, const int64_t& numElems)
+{
+    if (!isNativeFloat()) return false;
+    m_file.write(dataIn, numElems * sizeof(float));
+    return true;
+}
+
+void NiftiIO::readChunks(const int64_t& numElems, ChunkConverter* converter, const bool& tolerateShortRead)
+{
+    const int64_t bytesPerElem = numBytesPerElem();
+    const int64_t chunkElems = max((int64_t)1, OVERLAP_CHUNK_BYTES / bytesPerElem);
+    if (numElems <= 2 * chunkElems)
+    {//not worth a thread
+        const int64_t numBytes = numElems * bytesPerElem;
+        m_scratch.resize(numBytes);
+        int64_t numRead = 0;
+        m_file.read(m_scratch.data(), numBytes, &numRead);
+        checkShortRead(m_scratch.data(), numRead, numBytes, tolerateShortRead, m_file.getFilename());
+        converter->convert(m_scratch.data(), 0, numElems);
+        return;
+    }
+    const int64_t chunkBytes = chunkElems * bytesPerElem, numChunks = (numElems + chunkElems - 1) / chunkElems;
+    m_scratch.resize(2 * chunkBytes);
+    char* buffers[2] = { m_scratch.data(), m_scratch.data() + chunkBytes };
+    int64_t numRead = 0;
+    m_file.read(buffers[0], chunkBytes, &numRead);
+    checkShortRead(buffers[0], numRead, chunkBytes, tolerateShortRead, m_file.getFilename());
+    ChunkIOThread ioThread(&m_file);
+    for (int64_t chunk = 0; chunk < numChunks; ++chunk)
+    {
+        const int64_t start = chunk * chunkElems;
+        const int64_t nextBytes = min(chunkElems, numElems - start - chunkElems) * bytesPerElem;//not positive on the last chunk
+        if (nextBytes > 0) ioThread.startRead(buffers[(chunk + 1) % 2], nextBytes);
+        try
+        {
+            converter->convert(buffers[chunk % 2], start, min(chunkElems, numElems - start));
+        } catch (...) {
+            ioThread.wait();//don't let the thread outlive the buffers
+            throw;
+        }
+        if (nextBytes > 0)
+        {
+            ioThread.wait();
+            ioThread.checkError();
+            checkShortRead(buffers[(chunk + 1) % 2], ioThread.getNumDone(), nextBytes, tolerateShortRead, m_file.getFilename());
+        }
+    }
+}
+
+void NiftiIO::writeChunks(const int64_t& numElems, ChunkConverter* converter)
+{
+    const int64_t bytesPerElem = numBytesPerElem();
+    const int64_t chunkElems = max((int64_t)1, OVERLAP_CHUNK_BYTES / bytesPerElem);
+    if (numElems <= 2 * chunkElems)
+    {
+        const int64_t numBytes = numElems * bytesPerElem;
+        m_scratch.resize(numBytes);
+        converter->convert(m_scratch.data(), 0, numElems);
+        m_file.write(m_scratch.data(), numBytes);
+        return;
+    }
+    const int64_t chunkBytes = chunkElems * bytesPerElem, numChunks = (numElems + chunkElems - 1) / chunkElems;
+    m_scratch.resize(2 * chunkBytes);
+    char* buffers[2] = { m_scratch.data(), m_scratch.data() + chunkBytes };
+    converter->convert(buffers[0], 0, chunkElems);
+    ChunkIOThread ioThread(&m_file);
+    for (int64_t chunk = 0; chunk < numChunks; ++chunk)
+    {
+        const int64_t start = chunk * chunkElems;
+        ioThread.startWrite(buffers[chunk % 2], min(chunkElems, numElems - start) * bytesPerElem);
+        if (chunk + 1 < numChunks)
+        {
+            try
+            {
+                converter->convert(buffers[(chunk + 1) % 2], start + chunkElems, min(chunkElems, numElems - start - chunkElems));
+            } catch (...) {
+                ioThread.wait();
+                throw;
+            }
+        }
+        ioThread.wait();
+        ioThread.checkError();
+    }
+}
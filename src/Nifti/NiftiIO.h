@@ -24,6 +24,7 @@
 #include "ByteSwapping.h"
 #include "CaretAssert.h"
 #include "CaretBinaryFile.h"
+#include "CaretOMP.h"
 #include "DataFileException.h"
 #include "NiftiHeader.h"
 
@@ -36,17 +37,56 @@
 namespace caret
 {
     
+    //precision to do slope/intercept scaling in, double is exact for every on-disk type of 32 bits or less, and vectorizes where long double can't
+    template<typename T>
+    struct NiftiScalingType { typedef double type; };
+    template<>
+    struct NiftiScalingType<int64_t> { typedef long double type; };
+    template<>
+    struct NiftiScalingType<uint64_t> { typedef long double type; };
+    template<>
+    struct NiftiScalingType<long double> { typedef long double type; };
+    
     class NiftiIO
     {
         CaretBinaryFile m_file;
         NiftiHeader m_header;
         std::vector<int64_t> m_dims;
         std::vector<char> m_scratch;//scratch memory for byteswapping, type conversion, etc
+        static const int64_t CONVERT_BLOCK_ELEMS;//elements swapped and converted together while they are in cache
+        static const int64_t CONVERT_PARALLEL_ELEMS;//below this many elements, threading the conversion isn't worth it
+        class ChunkConverter
+        {//converts one chunk of a large read or write, so that the file access for the next chunk can overlap it
+        public:
+            virtual void convert(char* fileBytes, const int64_t& startElem, const int64_t& numElems) = 0;
+            virtual ~ChunkConverter() { }
+        };
+        template<typename T>
+        class ReadConverter;
+        template<typename T>
+        class WriteConverter;
         int numBytesPerElem();//for resizing scratch
         template<typename TO, typename FROM>
         void convertRead(TO* out, FROM* in, const int64_t& count);//for reading from file
         template<typename TO, typename FROM>
         void convertWrite(TO* out, const FROM* in, const int64_t& count);//for writing to file
+        template<typename T>
+        void convertReadBytes(T* dataOut, char* fileBytes, const int64_t& numElems);//dispatch on the on-disk type
+        template<typename T>
+        void convertWriteBytes(char* fileBytes, const T* dataIn, const int64_t& numElems);
+        void readChunks(const int64_t& numElems, ChunkConverter* converter, const bool& tolerateShortRead);//reads from the current position
+        void writeChunks(const int64_t& numElems, ChunkConverter* converter);
+        template<typename T>
+        void readElements(T* dataOut, const int64_t& startElem, const int64_t& numElems, const bool& tolerateShortRead);
+        template<typename T>
+        void writeElements(const T* dataIn, const int64_t& startElem, const int64_t& numElems);
+        bool isNativeFloat() const;//float32, native byte order, no scaling: the bytes in the file are already the floats we want
+        bool readDirect(float* dataOut, const int64_t& numElems, const bool& tolerateShortRead);//skip the scratch copy when possible, returns false if not
+        template<typename T>
+        bool readDirect(T*, const int64_t&, const bool&) { return false; }
+        bool writeDirect(const float* dataIn, const int64_t& numElems);
+        template<typename T>
+        bool writeDirect(const T*, const int64_t&) { return false; }
     public:
         void openRead(const QString& filename);
         void writeNew(const QString& filename, const NiftiHeader& header, const int& version = 1, const bool& withRead = false, const bool& swapEndian = false);
@@ -62,6 +102,12 @@ namespace caret
         void readData(T* dataOut, const int& fullDims, const std::vector<int64_t>& indexSelect, const bool& tolerateShortRead = false);
         template<typename T>
         void writeData(const T* dataIn, const int& fullDims, const std::vector<int64_t>& indexSelect);
+        //read/write numBlocks consecutive blocks of the first fullDims dimensions, starting at startBlock counted across all the remaining dimensions
+        //with fullDims = 5 on cifti, this is a range of rows, done as a single large read or write
+        template<typename T>
+        void readBlocks(T* dataOut, const int& fullDims, const int64_t& startBlock, const int64_t& numBlocks, const bool& tolerateShortRead = false);
+        template<typename T>
+        void writeBlocks(const T* dataIn, const int& fullDims, const int64_t& startBlock, const int64_t& numBlocks);
     };
     
     template<typename T>
@@ -82,52 +128,151 @@ namespace caret
             numSkip += indexSelect[curDim - fullDims] * numDimSkip;
             numDimSkip *= m_dims[curDim];
         }
-        m_scratch.resize(numElems * numBytesPerElem());
-        m_file.seek(numSkip * numBytesPerElem() + m_header.getDataOffset());
-        int64_t numRead = 0;
-        m_file.read(m_scratch.data(), m_scratch.size(), &numRead);
-        if ((numRead != (int64_t)m_scratch.size() && !tolerateShortRead) || numRead < 0)//for now, assume read giving -1 is always a problem
+        readElements(dataOut, numSkip, numElems, tolerateShortRead);
+    }
+    
+    template<typename T>
+    void NiftiIO::readBlocks(T* dataOut, const int& fullDims, const int64_t& startBlock, const int64_t& numBlocks, const bool& tolerateShortRead)
+    {
+        CaretAssert(fullDims >= 0 && fullDims <= (int)m_dims.size());
+        int64_t blockElems = getNumComponents(), numBlocksTotal = 1;
+        for (int curDim = 0; curDim < (int)m_dims.size(); ++curDim)
+        {
+            if (curDim < fullDims)
+            {
+                blockElems *= m_dims[curDim];
+            } else {
+                numBlocksTotal *= m_dims[curDim];
+            }
+        }
+        CaretAssert(startBlock >= 0 && numBlocks >= 0 && startBlock + numBlocks <= numBlocksTotal);
+        readElements(dataOut, startBlock * blockElems, numBlocks * blockElems, tolerateShortRead);
+    }
+    
+    template<typename T>
+    void NiftiIO::readElements(T* dataOut, const int64_t& startElem, const int64_t& numElems, const bool& tolerateShortRead)
+    {
+        m_file.seek(startElem * numBytesPerElem() + m_header.getDataOffset());
+        if (readDirect(dataOut, numElems, tolerateShortRead)) return;
+        ReadConverter<T> myConverter(this, dataOut);
+        readChunks(numElems, &myConverter, tolerateShortRead);
+    }
+    
+    template<typename T>
+    void NiftiIO::writeData(const T* dataIn, const int& fullDims, const std::vector<int64_t>& indexSelect)
+    {
+        CaretAssert(fullDims >= 0 && fullDims <= (int)m_dims.size());
+        CaretAssert((size_t)fullDims + indexSelect.size() == m_dims.size());//could be >=, but should catch more stupid mistakes as ==
+        int64_t numElems = getNumComponents();//for now, calculate read size on the fly, as the read call will be the slowest part
+        int curDim;
+        for (curDim = 0; curDim < fullDims; ++curDim)
+        {
+            numElems *= m_dims[curDim];
+        }
+        int64_t numDimSkip = numElems, numSkip = 0;
+        for (; curDim < (int)m_dims.size(); ++curDim)
+        {
+            CaretAssert(indexSelect[curDim - fullDims] >= 0 && indexSelect[curDim - fullDims] < m_dims[curDim]);
+            numSkip += indexSelect[curDim - fullDims] * numDimSkip;
+            numDimSkip *= m_dims[curDim];
+        }
+        writeElements(dataIn, numSkip, numElems);
+    }
+    
+    template<typename T>
+    void NiftiIO::writeBlocks(const T* dataIn, const int& fullDims, const int64_t& startBlock, const int64_t& numBlocks)
+    {
+        CaretAssert(fullDims >= 0 && fullDims <= (int)m_dims.size());
+        int64_t blockElems = getNumComponents(), numBlocksTotal = 1;
+        for (int curDim = 0; curDim < (int)m_dims.size(); ++curDim)
+        {
+            if (curDim < fullDims)
+            {
+                blockElems *= m_dims[curDim];
+            } else {
+                numBlocksTotal *= m_dims[curDim];
+            }
+        }
+        CaretAssert(startBlock >= 0 && numBlocks >= 0 && startBlock + numBlocks <= numBlocksTotal);
+        writeElements(dataIn, startBlock * blockElems, numBlocks * blockElems);
+    }
+    
+    template<typename T>
+    void NiftiIO::writeElements(const T* dataIn, const int64_t& startElem, const int64_t& numElems)
+    {
+        m_file.seek(startElem * numBytesPerElem() + m_header.getDataOffset());
+        if (writeDirect(dataIn, numElems)) return;
+        WriteConverter<T> myConverter(this, dataIn);
+        writeChunks(numElems, &myConverter);
+    }
+    
+    template<typename T>
+    class NiftiIO::ReadConverter : public NiftiIO::ChunkConverter
+    {
+        NiftiIO* m_io;
+        T* m_dataOut;
+    public:
+        ReadConverter(NiftiIO* io, T* dataOut) : m_io(io), m_dataOut(dataOut) { }
+        void convert(char* fileBytes, const int64_t& startElem, const int64_t& numElems)
+        {
+            m_io->convertReadBytes(m_dataOut + startElem, fileBytes, numElems);
+        }
+    };
+    
+    template<typename T>
+    class NiftiIO::WriteConverter : public NiftiIO::ChunkConverter
+    {
+        NiftiIO* m_io;
+        const T* m_dataIn;
+    public:
+        WriteConverter(NiftiIO* io, const T* dataIn) : m_io(io), m_dataIn(dataIn) { }
+        void convert(char* fileBytes, const int64_t& startElem, const int64_t& numElems)
         {
-            throw DataFileException("error while reading from file '" + m_file.getFilename() + "'");
+            m_io->convertWriteBytes(fileBytes, m_dataIn + startElem, numElems);
         }
+    };
+    
+    template<typename T>
+    void NiftiIO::convertReadBytes(T* dataOut, char* fileBytes, const int64_t& numElems)
+    {
         switch (m_header.getDataType())
         {
             case NIFTI_TYPE_UINT8:
             case NIFTI_TYPE_RGB24://handled by components
-                convertRead(dataOut, (uint8_t*)m_scratch.data(), numElems);
+                convertRead(dataOut, (uint8_t*)fileBytes, numElems);
                 break;
             case NIFTI_TYPE_INT8:
-                convertRead(dataOut, (int8_t*)m_scratch.data(), numElems);
+                convertRead(dataOut, (int8_t*)fileBytes, numElems);
                 break;
             case NIFTI_TYPE_UINT16:
-                convertRead(dataOut, (uint16_t*)m_scratch.data(), numElems);
+                convertRead(dataOut, (uint16_t*)fileBytes, numElems);
                 break;
             case NIFTI_TYPE_INT16:
-                convertRead(dataOut, (int16_t*)m_scratch.data(), numElems);
+                convertRead(dataOut, (int16_t*)fileBytes, numElems);
                 break;
             case NIFTI_TYPE_UINT32:
-                convertRead(dataOut, (uint32_t*)m_scratch.data(), numElems);
+                convertRead(dataOut, (uint32_t*)fileBytes, numElems);
                 break;
             case NIFTI_TYPE_INT32:
-                convertRead(dataOut, (int32_t*)m_scratch.data(), numElems);
+                convertRead(dataOut, (int32_t*)fileBytes, numElems);
                 break;
             case NIFTI_TYPE_UINT64:
-                convertRead(dataOut, (uint64_t*)m_scratch.data(), numElems);
+                convertRead(dataOut, (uint64_t*)fileBytes, numElems);
                 break;
             case NIFTI_TYPE_INT64:
-                convertRead(dataOut, (int64_t*)m_scratch.data(), numElems);
+                convertRead(dataOut, (int64_t*)fileBytes, numElems);
                 break;
             case NIFTI_TYPE_FLOAT32:
             case NIFTI_TYPE_COMPLEX64://components
-                convertRead(dataOut, (float*)m_scratch.data(), numElems);
+                convertRead(dataOut, (float*)fileBytes, numElems);
                 break;
             case NIFTI_TYPE_FLOAT64:
             case NIFTI_TYPE_COMPLEX128:
-                convertRead(dataOut, (double*)m_scratch.data(), numElems);
+                convertRead(dataOut, (double*)fileBytes, numElems);
                 break;
             case NIFTI_TYPE_FLOAT128:
             case NIFTI_TYPE_COMPLEX256:
-                convertRead(dataOut, (long double*)m_scratch.data(), numElems);
+                convertRead(dataOut, (long double*)fileBytes, numElems);
                 break;
             default:
                 CaretAssert(0);
@@ -136,105 +281,95 @@ namespace caret
     }
     
     template<typename T>
-    void NiftiIO::writeData(const T* dataIn, const int& fullDims, const std::vector<int64_t>& indexSelect)
+    void NiftiIO::convertWriteBytes(char* fileBytes, const T* dataIn, const int64_t& numElems)
     {
-        CaretAssert(fullDims >= 0 && fullDims <= (int)m_dims.size());
-        CaretAssert((size_t)fullDims + indexSelect.size() == m_dims.size());//could be >=, but should catch more stupid mistakes as ==
-        int64_t numElems = getNumComponents();//for now, calculate read size on the fly, as the read call will be the slowest part
-        int curDim;
-        for (curDim = 0; curDim < fullDims; ++curDim)
-        {
-            numElems *= m_dims[curDim];
-        }
-        int64_t numDimSkip = numElems, numSkip = 0;
-        for (; curDim < (int)m_dims.size(); ++curDim)
-        {
-            CaretAssert(indexSelect[curDim - fullDims] >= 0 && indexSelect[curDim - fullDims] < m_dims[curDim]);
-            numSkip += indexSelect[curDim - fullDims] * numDimSkip;
-            numDimSkip *= m_dims[curDim];
-        }
-        m_scratch.resize(numElems * numBytesPerElem());
-        m_file.seek(numSkip * numBytesPerElem() + m_header.getDataOffset());
         switch (m_header.getDataType())
         {
             case NIFTI_TYPE_UINT8:
             case NIFTI_TYPE_RGB24://handled by components
-                convertWrite((uint8_t*)m_scratch.data(), dataIn, numElems);
+                convertWrite((uint8_t*)fileBytes, dataIn, numElems);
                 break;
             case NIFTI_TYPE_INT8:
-                convertWrite((int8_t*)m_scratch.data(), dataIn, numElems);
+                convertWrite((int8_t*)fileBytes, dataIn, numElems);
                 break;
             case NIFTI_TYPE_UINT16:
-                convertWrite((uint16_t*)m_scratch.data(), dataIn, numElems);
+                convertWrite((uint16_t*)fileBytes, dataIn, numElems);
                 break;
             case NIFTI_TYPE_INT16:
-                convertWrite((int16_t*)m_scratch.data(), dataIn, numElems);
+                convertWrite((int16_t*)fileBytes, dataIn, numElems);
                 break;
             case NIFTI_TYPE_UINT32:
-                convertWrite((uint32_t*)m_scratch.data(), dataIn, numElems);
+                convertWrite((uint32_t*)fileBytes, dataIn, numElems);
                 break;
             case NIFTI_TYPE_INT32:
-                convertWrite((int32_t*)m_scratch.data(), dataIn, numElems);
+                convertWrite((int32_t*)fileBytes, dataIn, numElems);
                 break;
             case NIFTI_TYPE_UINT64:
-                convertWrite((uint64_t*)m_scratch.data(), dataIn, numElems);
+                convertWrite((uint64_t*)fileBytes, dataIn, numElems);
                 break;
             case NIFTI_TYPE_INT64:
-                convertWrite((int64_t*)m_scratch.data(), dataIn, numElems);
+                convertWrite((int64_t*)fileBytes, dataIn, numElems);
                 break;
             case NIFTI_TYPE_FLOAT32:
             case NIFTI_TYPE_COMPLEX64://components
-                convertWrite((float*)m_scratch.data(), dataIn, numElems);
+                convertWrite((float*)fileBytes, dataIn, numElems);
                 break;
             case NIFTI_TYPE_FLOAT64:
             case NIFTI_TYPE_COMPLEX128:
-                convertWrite((double*)m_scratch.data(), dataIn, numElems);
+                convertWrite((double*)fileBytes, dataIn, numElems);
                 break;
             case NIFTI_TYPE_FLOAT128:
             case NIFTI_TYPE_COMPLEX256:
-                convertWrite((long double*)m_scratch.data(), dataIn, numElems);
+                convertWrite((long double*)fileBytes, dataIn, numElems);
                 break;
             default:
                 CaretAssert(0);
                 throw DataFileException("internal error, tell the developers what you just tried to do");
         }
-        m_file.write(m_scratch.data(), m_scratch.size());
     }
     
     template<typename TO, typename FROM>
     void NiftiIO::convertRead(TO* out, FROM* in, const int64_t& count)
     {
-        if (m_header.isSwapped())
-        {
-            ByteSwapping::swapArray(in, count);
-        }
+        typedef typename NiftiScalingType<FROM>::type ScaleT;
         double mult, offset;
-        bool doScale = m_header.getDataScaling(mult, offset);
-        if (std::numeric_limits<TO>::is_integer)//do round to nearest when integer output type
-        {
-            if (doScale)
+        const bool doScale = m_header.getDataScaling(mult, offset), doSwap = m_header.isSwapped();
+        const ScaleT scaleMult = mult, scaleOffset = offset;
+        const int64_t numBlocks = (count + CONVERT_BLOCK_ELEMS - 1) / CONVERT_BLOCK_ELEMS;
+#pragma omp CARET_PARFOR schedule(static) if (count >= CONVERT_PARALLEL_ELEMS)
+        for (int64_t block = 0; block < numBlocks; ++block)
+        {//swap each block right before converting it, so it is still in cache, and keep the branches out of the element loops so they vectorize
+            const int64_t start = block * CONVERT_BLOCK_ELEMS;
+            const int64_t blockCount = (count - start < CONVERT_BLOCK_ELEMS ? count - start : CONVERT_BLOCK_ELEMS);
+            FROM* blockIn = in + start;
+            TO* blockOut = out + start;
+            if (doSwap) ByteSwapping::swapArray(blockIn, blockCount);
+            if (std::numeric_limits<TO>::is_integer)//do round to nearest when integer output type
             {
-                for (int64_t i = 0; i < count; ++i)
+                if (doScale)
                 {
-                    out[i] = (TO)floor(0.5 + offset + mult * (long double)in[i]);//we don't always need that much precision, but it will still be faster than hard drives
+                    for (int64_t i = 0; i < blockCount; ++i)
+                    {
+                        blockOut[i] = (TO)std::floor(0.5 + scaleOffset + scaleMult * (ScaleT)blockIn[i]);
+                    }
+                } else {
+                    for (int64_t i = 0; i < blockCount; ++i)
+                    {
+                        blockOut[i] = (TO)std::floor(0.5 + (ScaleT)blockIn[i]);
+                    }
                 }
             } else {
-                for (int64_t i = 0; i < count; ++i)
+                if (doScale)
                 {
-                    out[i] = (TO)floor(0.5 + in[i]);
-                }
-            }
-        } else {
-            if (doScale)
-            {
-                for (int64_t i = 0; i < count; ++i)
-                {
-                    out[i] = (TO)(offset + mult * (long double)in[i]);//we don't always need that much precision, but it will still be faster than hard drives
-                }
-            } else {
-                for (int64_t i = 0; i < count; ++i)
-                {
-                    out[i] = (TO)in[i];//explicit cast to make sure the compiler doesn't squawk
+                    for (int64_t i = 0; i < blockCount; ++i)
+                    {
+                        blockOut[i] = (TO)(scaleOffset + scaleMult * (ScaleT)blockIn[i]);
+                    }
+                } else {
+                    for (int64_t i = 0; i < blockCount; ++i)
+                    {
+                        blockOut[i] = (TO)blockIn[i];//explicit cast to make sure the compiler doesn't squawk
+                    }
                 }
             }
         }
@@ -243,37 +378,48 @@ namespace caret
     template<typename TO, typename FROM>
     void NiftiIO::convertWrite(TO* out, const FROM* in, const int64_t& count)
     {
+        typedef typename NiftiScalingType<TO>::type ScaleT;
         double mult, offset;
-        bool doScale = m_header.getDataScaling(mult, offset);
-        if (std::numeric_limits<TO>::is_integer)//do round to nearest when integer output type
-        {
-            if (doScale)
-            {
-                for (int64_t i = 0; i < count; ++i)
-                {
-                    out[i] = (TO)floor(0.5 + ((long double)in[i] - offset) / mult);//we don't always need that much precision, but it will still be faster than hard drives
-                }
-            } else {
-                for (int64_t i = 0; i < count; ++i)
-                {
-                    out[i] = (TO)floor(0.5 + in[i]);
-                }
-            }
-        } else {
-            if (doScale)
+        const bool doScale = m_header.getDataScaling(mult, offset), doSwap = m_header.isSwapped();
+        const ScaleT scaleMult = mult, scaleOffset = offset;
+        const int64_t numBlocks = (count + CONVERT_BLOCK_ELEMS - 1) / CONVERT_BLOCK_ELEMS;
+#pragma omp CARET_PARFOR schedule(static) if (count >= CONVERT_PARALLEL_ELEMS)
+        for (int64_t block = 0; block < numBlocks; ++block)
+        {//quantize, then swap while the block is still in cache
+            const int64_t start = block * CONVERT_BLOCK_ELEMS;
+            const int64_t blockCount = (count - start < CONVERT_BLOCK_ELEMS ? count - start : CONVERT_BLOCK_ELEMS);
+            const FROM* blockIn = in + start;
+            TO* blockOut = out + start;
+            if (std::numeric_limits<TO>::is_integer)//do round to nearest when integer output type
             {
-                for (int64_t i = 0; i < count; ++i)
+                if (doScale)
                 {
-                    out[i] = (TO)(((long double)in[i] - offset) / mult);//we don't always need that much precision, but it will still be faster than hard drives
+                    for (int64_t i = 0; i < blockCount; ++i)
+                    {
+                        blockOut[i] = (TO)std::floor(0.5 + ((ScaleT)blockIn[i] - scaleOffset) / scaleMult);
+                    }
+                } else {
+                    for (int64_t i = 0; i < blockCount; ++i)
+                    {
+                        blockOut[i] = (TO)std::floor(0.5 + (ScaleT)blockIn[i]);
+                    }
                 }
             } else {
-                for (int64_t i = 0; i < count; ++i)
+                if (doScale)
                 {
-                    out[i] = (TO)in[i];//explicit cast to make sure the compiler doesn't squawk
+                    for (int64_t i = 0; i < blockCount; ++i)
+                    {
+                        blockOut[i] = (TO)(((ScaleT)blockIn[i] - scaleOffset) / scaleMult);
+                    }
+                } else {
+                    for (int64_t i = 0; i < blockCount; ++i)
+                    {
+                        blockOut[i] = (TO)blockIn[i];//explicit cast to make sure the compiler doesn't squawk
+                    }
                 }
             }
+            if (doSwap) ByteSwapping::swapArray(blockOut, blockCount);
         }
-        if (m_header.isSwapped()) ByteSwapping::swapArray(out, count);
     }
     
 }
@@ -22,14 +22,18 @@
 #include "OperationException.h"
 
 #include "CaretLogger.h"
+#include "CaretOMP.h"
 #include "CiftiFile.h"
+#include "CiftiRowStreamHelper.h"
 #include "FileInformation.h"
 #include "GiftiLabel.h"
 #include "GiftiLabelTable.h"
+#include "LabelImportHelper.h"
+#include "LabelKeyRemap.h"
 
+#include <algorithm>
 #include <cctype>
 #include <cmath>
-#include <cstdlib>
 #include <fstream>
 #include <map>
 #include <set>
@@ -39,6 +43,20 @@
 using namespace caret;
 using namespace std;
 
+namespace
+{
+    class LabelImportRowFunction : public CiftiRowStreamHelper::RowFunction
+    {
+        const LabelKeyRemap& m_remap;
+    public:
+        LabelImportRowFunction(const LabelKeyRemap& remap) : m_remap(remap) { }
+        void processRow(const float* inRow, const int64_t& inRowLength, float* outRow, const int64_t&, const int64_t&)
+        {
+            m_remap.apply(inRow, outRow, inRowLength);
+        }
+    };
+}
+
 AString OperationCiftiLabelImport::getCommandSwitch()
 {
     return "-cifti-label-import";
@@ -201,56 +219,37 @@ void OperationCiftiLabelImport::useParameters(OperationParameters* myParams, Pro
     CiftiXMLOld xmlOut = xmlIn;
     xmlOut.resetRowsToLabels(rowSize);
     vector<set<int32_t> > usedArray(rowSize);
-    vector<float> rowScratch(rowSize);
-    vector<vector<float> > matrixOut(colSize, vector<float>(rowSize));//because the label table gets modified as we scan values, store the translated values instead of going back for a second pass
-    for (int row = 0; row < colSize; ++row)
-    {
-        ciftiIn->getRow(rowScratch.data(), row);
-        for (int col = 0; col < rowSize; ++col)
+    vector<int32_t> foundValues;//in order of first appearance in a scan through the rows, so new labels are made in the same order regardless of block size
+    {//the label table gets modified as we find new values, so find them all in a first pass, then translate in a second pass instead of storing the whole matrix
+        set<int32_t> seen;
+        const int64_t blockRows = min((int64_t)colSize, CiftiFile::getRowBlockSize(rowSize));
+        vector<float> blockScratch(blockRows * rowSize);
+        for (int64_t start = 0; start < colSize; start += blockRows)
         {
-            int32_t labelval = (int32_t)floor(rowScratch[col] + 0.5f);//just in case it somehow got poorly encoded, round to nearest
-            if (dropUnused)
+            const int64_t thisBlock = min(blockRows, colSize - start);
+            ciftiIn->getRows(blockScratch.data(), start, thisBlock);
+            vector<int32_t> blockValues = LabelKeyRemap::findKeysInOrder(blockScratch.data(), thisBlock * rowSize);
+            for (int i = 0; i < (int)blockValues.size(); ++i)
             {
-                usedArray[col].insert(labelval);
+                if (seen.insert(blockValues[i]).second) foundValues.push_back(blockValues[i]);
             }
-            map<int32_t, int32_t>::iterator myiter = translate.find(labelval);
-            if (myiter == translate.end())
+            if (dropUnused)
             {
-                if (discardOthers)
+#pragma omp CARET_PARFOR schedule(dynamic)
+                for (int col = 0; col < rowSize; ++col)
                 {
-                    matrixOut[row][col] = unusedLabel;
-                } else {//use a random color, but fully opaque for the label
-                    GiftiLabel myLabel(labelval, AString("LABEL_") + AString::number(labelval), rand() & 255, rand() & 255, rand() & 255, 255);
-                    if (myTable.getLabelKeyFromName(myLabel.getName()) != GiftiLabel::getInvalidLabelKey())
+                    for (int64_t row = 0; row < thisBlock; ++row)
                     {
-                        AString nameBase = myLabel.getName(), newName;//resolve collision by generating a name with an additional number on it
-                        bool success = false;
-                        for (int extra = 1; extra < 100; ++extra)//but stop at 100, because really...
-                        {
-                            newName = nameBase + "_" + AString::number(extra);
-                            if (myTable.getLabelKeyFromName(newName) == GiftiLabel::getInvalidLabelKey())
-                            {
-                                success = true;
-                                break;
-                            }
-                        }
-                        if (success)
-                        {
-                            CaretLogWarning("name collision in auto-generated name '" + nameBase + "', changed to '" + newName + "'");
-                        } else {
-                            throw OperationException("giving up on resolving name collision for auto-generated name '" + nameBase + "'");
-                        }
-                        myLabel.setName(newName);
+                        usedArray[col].insert((int32_t)floor(blockScratch[row * rowSize + col] + 0.5f));//just in case it somehow got poorly encoded, round to nearest
                     }
-                    int32_t newValue = myTable.addLabel(&myLabel);//don't overwrite any values in the table
-                    translate[labelval] = newValue;
-                    matrixOut[row][col] = newValue;
                 }
-            } else {
-                matrixOut[row][col] = myiter->second;
             }
         }
     }
+    if (!discardOthers)
+    {
+        LabelImportHelper::addLabelsForKeys(foundValues, myTable, translate);
+    }
     for (int i = 0; i < rowSize; ++i)
     {
         xmlOut.setMapNameForIndex(CiftiXMLOld::ALONG_ROW, i, xmlIn.getMapName(CiftiXMLOld::ALONG_ROW, i));
@@ -264,8 +263,7 @@ void OperationCiftiLabelImport::useParameters(OperationParameters* myParams, Pro
         }
     }
     ciftiOut->setCiftiXML(xmlOut);
-    for (int row = 0; row < colSize; ++row)
-    {
-        ciftiOut->setRow(matrixOut[row].data(), row);
-    }
+    const LabelKeyRemap myRemap(translate, unusedLabel);//every value is now in translate unless we are discarding the others
+    LabelImportRowFunction myFunction(myRemap);
+    CiftiRowStreamHelper::streamRows(ciftiIn, ciftiOut, &myFunction);
 }
@@ -148,9 +148,9 @@ void OperationCiftiMerge::useParameters(OperationParameters* myParams, ProgressO
         const CiftiXML& thisXML = ciftiIn->getCiftiXML();
         const vector<ParameterComponent*>& columnOpts = *(myInputs[i]->getRepeatableParameterInstances(2));
         int numColumnOpts = (int)columnOpts.size();
+        scratchRowLength = max(scratchRowLength, thisXML.getDimensionLength(CiftiXML::ALONG_ROW));//whole input rows are read in blocks, then copied into the output rows
         if (numColumnOpts > 0)
         {
-            scratchRowLength = max(scratchRowLength, thisXML.getDimensionLength(CiftiXML::ALONG_ROW));//if we use the entire row, we don't need a separate scratch row for it
             if (doLoop)
             {
                 for (int j = 0; j < numColumnOpts; ++j)
@@ -256,9 +256,11 @@ void OperationCiftiMerge::useParameters(OperationParameters* myParams, ProgressO
     }
     ciftiOut->setCiftiXML(outXML);
     int64_t numRows = baseColMapping.getLength();
-    vector<float> outRow(numOutColumns), scratchRow(scratchRowLength);
-    for (int64_t row = 0; row < numRows; ++row)
+    int64_t blockRows = min(numRows, CiftiFile::getRowBlockSize(numOutColumns + scratchRowLength));//read and write many rows per call, rather than one row from each input at a time, budgeting the output block and the widest input block together
+    vector<float> outRows(blockRows * numOutColumns), scratchRows(blockRows * scratchRowLength);
+    for (int64_t start = 0; start < numRows; start += blockRows)
     {
+        int64_t thisBlock = min(blockRows, numRows - start);
         curCol = 0;
         for (int i = 0; i < numInputs; ++i)
         {
@@ -266,42 +268,58 @@ void OperationCiftiMerge::useParameters(OperationParameters* myParams, ProgressO
             vector<int64_t> thisDims = ciftiIn->getDimensions();
             const vector<ParameterComponent*>& columnOpts = *(myInputs[i]->getRepeatableParameterInstances(2));
             int numColumnOpts = (int)columnOpts.size();
+            ciftiIn->getRows(scratchRows.data(), start, thisBlock);
             if (numColumnOpts > 0)
             {
-                ciftiIn->getRow(scratchRow.data(), row);
-                for (int j = 0; j < numColumnOpts; ++j)
+                int64_t blockCol = curCol;
+                for (int64_t row = 0; row < thisBlock; ++row)
                 {
-                    int64_t initialColumn = columnOpts[j]->getInteger(1) - 1;//1-based indexing convention
-                    OptionalParameter* upToOpt = columnOpts[j]->getOptionalParameter(2);
-                    if (upToOpt->m_present)
+                    const float* scratchRow = scratchRows.data() + row * thisDims[0];
+                    float* outRow = outRows.data() + row * numOutColumns;
+                    blockCol = curCol;
+                    for (int j = 0; j < numColumnOpts; ++j)
                     {
-                        int finalColumn = upToOpt->getInteger(1) - 1;//ditto
-                        bool reverse = upToOpt->getOptionalParameter(2)->m_present;
-                        if (reverse)
+                        int64_t initialColumn = columnOpts[j]->getInteger(1) - 1;//1-based indexing convention
+                        OptionalParameter* upToOpt = columnOpts[j]->getOptionalParameter(2);
+                        if (upToOpt->m_present)
                         {
-                            for (int c = finalColumn; c >= initialColumn; --c)
+                            int finalColumn = upToOpt->getInteger(1) - 1;//ditto
+                            bool reverse = upToOpt->getOptionalParameter(2)->m_present;
+                            if (reverse)
                             {
-                                outRow[curCol] = scratchRow[c];
-                                ++curCol;
+                                for (int c = finalColumn; c >= initialColumn; --c)
+                                {
+                                    outRow[blockCol] = scratchRow[c];
+                                    ++blockCol;
+                                }
+                            } else {
+                                for (int c = initialColumn; c <= finalColumn; ++c)
+                                {
+                                    outRow[blockCol] = scratchRow[c];
+                                    ++blockCol;
+                                }
                             }
                         } else {
-                            for (int c = initialColumn; c <= finalColumn; ++c)
-                            {
-                                outRow[curCol] = scratchRow[c];
-                                ++curCol;
-                            }
+                            outRow[blockCol] = scratchRow[initialColumn];
+                            ++blockCol;
                         }
-                    } else {
-                        outRow[curCol] = scratchRow[initialColumn];
-                        ++curCol;
                     }
                 }
+                curCol = blockCol;
             } else {
-                ciftiIn->getRow(outRow.data() + curCol, row);
+                for (int64_t row = 0; row < thisBlock; ++row)
+                {
+                    const float* scratchRow = scratchRows.data() + row * thisDims[0];
+                    float* outRow = outRows.data() + row * numOutColumns + curCol;
+                    for (int64_t c = 0; c < thisDims[0]; ++c)
+                    {
+                        outRow[c] = scratchRow[c];
+                    }
+                }
                 curCol += thisDims[0];
             }
         }
         CaretAssert(curCol == numOutColumns);
-        ciftiOut->setRow(outRow.data(), row);
+        ciftiOut->setRows(outRows.data(), start, thisBlock);
     }
 }
@@ -23,6 +23,7 @@
 
 #include "GiftiLabelTable.h"
 #include "LabelFile.h"
+#include "LabelKeyRemap.h"
 
 #include <map>
 #include <vector>
@@ -64,25 +65,6 @@ OperationParameters* OperationLabelMerge::getParameters()
     return ret;
 }
 
-namespace _operation_label_merge
-{//private namespace for helper functions
-    void doRemap(const int32_t* input, const map<int32_t, int32_t>& remap, const int numElems, const int32_t& unlabeledValue, int32_t* output)
-    {
-        for (int i = 0; i < numElems; ++i)
-        {
-            map<int32_t, int32_t>::const_iterator iter = remap.find(input[i]);
-            if (iter != remap.end())
-            {
-                output[i] = iter->second;
-            } else {//values that have no key
-                output[i] = unlabeledValue;
-            }
-        }
-    }
-}
-
-using namespace _operation_label_merge;
-
 void OperationLabelMerge::useParameters(OperationParameters* myParams, ProgressObject* myProgObj)
 {
     LevelProgress myProgress(myProgObj);
@@ -134,6 +116,7 @@ void OperationLabelMerge::useParameters(OperationParameters* myParams, ProgressO
     for (int i = 0; i < numInputs; ++i)
     {
         const LabelFile* inputLabel = myInputs[i]->getLabel(1);
+        const LabelKeyRemap myRemap(fileRemap[i], outTable.getUnassignedLabelKey());//values that have no key become unlabeled
         const vector<ParameterComponent*>& columnOpts = *(myInputs[i]->getRepeatableParameterInstances(2));
         int numColumnOpts = (int)columnOpts.size();
         if (numColumnOpts > 0)
@@ -150,7 +133,7 @@ void OperationLabelMerge::useParameters(OperationParameters* myParams, ProgressO
                     {
                         for (int c = finalColumn; c >= initialColumn; --c)
                         {
-                            doRemap(inputLabel->getLabelKeyPointerForColumn(c), fileRemap[i], numNodes, outTable.getUnassignedLabelKey(), scratchCol.data());
+                            myRemap.apply(inputLabel->getLabelKeyPointerForColumn(c), scratchCol.data(), numNodes);
                             myLabelOut->setLabelKeysForColumn(curColumn, scratchCol.data());
                             myLabelOut->setColumnName(curColumn, inputLabel->getColumnName(c));
                             ++curColumn;
@@ -158,14 +141,14 @@ void OperationLabelMerge::useParameters(OperationParameters* myParams, ProgressO
                     } else {
                         for (int c = initialColumn; c <= finalColumn; ++c)
                         {
-                            doRemap(inputLabel->getLabelKeyPointerForColumn(c), fileRemap[i], numNodes, outTable.getUnassignedLabelKey(), scratchCol.data());
+                            myRemap.apply(inputLabel->getLabelKeyPointerForColumn(c), scratchCol.data(), numNodes);
                             myLabelOut->setLabelKeysForColumn(curColumn, scratchCol.data());
                             myLabelOut->setColumnName(curColumn, inputLabel->getColumnName(c));
                             ++curColumn;
                         }
                     }
                 } else {
-                    doRemap(inputLabel->getLabelKeyPointerForColumn(initialColumn), fileRemap[i], numNodes, outTable.getUnassignedLabelKey(), scratchCol.data());
+                    myRemap.apply(inputLabel->getLabelKeyPointerForColumn(initialColumn), scratchCol.data(), numNodes);
                     myLabelOut->setLabelKeysForColumn(curColumn, scratchCol.data());
                     myLabelOut->setColumnName(curColumn, inputLabel->getColumnName(initialColumn));
                     ++curColumn;
@@ -175,7 +158,7 @@ void OperationLabelMerge::useParameters(OperationParameters* myParams, ProgressO
             int numColumns = inputLabel->getNumberOfColumns();
             for (int j = 0; j < numColumns; ++j)
             {
-                doRemap(inputLabel->getLabelKeyPointerForColumn(j), fileRemap[i], numNodes, outTable.getUnassignedLabelKey(), scratchCol.data());
+                myRemap.apply(inputLabel->getLabelKeyPointerForColumn(j), scratchCol.data(), numNodes);
                 myLabelOut->setLabelKeysForColumn(curColumn, scratchCol.data());
                 myLabelOut->setColumnName(curColumn, inputLabel->getColumnName(j));
                 ++curColumn;
@@ -25,11 +25,11 @@
 #include "FileInformation.h"
 #include "GiftiLabel.h"
 #include "GiftiLabelTable.h"
+#include "LabelImportHelper.h"
 #include "LabelFile.h"
 #include "MetricFile.h"
 
 #include <cmath>
-#include <cstdlib>
 #include <cctype>
 #include <fstream>
 #include <string>
@@ -218,7 +218,7 @@ void OperationMetricLabelImport::useParameters(OperationParameters* myParams, Pr
         set<int32_t> usedValues;
         for (int col = 0; col < numCols; ++col)
         {
-            translateLabels(myMetric->getValuePointerForColumn(col), colScratch.data(), numNodes, myTable, translate, usedValues, dropUnused, discardOthers, unusedLabel);
+            LabelImportHelper::translateLabels(myMetric->getValuePointerForColumn(col), colScratch.data(), numNodes, myTable, translate, usedValues, dropUnused, discardOthers, unusedLabel);
             myLabelOut->setLabelKeysForColumn(col, colScratch.data());
         }
         if (dropUnused)
@@ -230,7 +230,7 @@ void OperationMetricLabelImport::useParameters(OperationParameters* myParams, Pr
         myLabelOut->setNumberOfNodesAndColumns(numNodes, 1);
         myLabelOut->setStructure(myMetric->getStructure());
         set<int32_t> usedValues;
-        translateLabels(myMetric->getValuePointerForColumn(columnNum), colScratch.data(), numNodes, myTable, translate, usedValues, dropUnused, discardOthers, unusedLabel);
+        LabelImportHelper::translateLabels(myMetric->getValuePointerForColumn(columnNum), colScratch.data(), numNodes, myTable, translate, usedValues, dropUnused, discardOthers, unusedLabel);
         myLabelOut->setLabelKeysForColumn(0, colScratch.data());
         if (dropUnused)
         {
@@ -239,52 +239,3 @@ void OperationMetricLabelImport::useParameters(OperationParameters* myParams, Pr
         *(myLabelOut->getLabelTable()) = myTable;
     }
 }
-
-void OperationMetricLabelImport::translateLabels(const float* valuesIn, int32_t* labelsOut, const int& numNodes, GiftiLabelTable& myTable, map<int32_t, int32_t>& translate,
-                                                 set<int32_t>& usedValues, const bool& dropUnused, const bool& discardOthers, const int32_t& unusedLabel)
-{
-    for (int node = 0; node < numNodes; ++node)
-    {
-        int32_t labelval = (int32_t)floor(valuesIn[node] + 0.5f);//just in case it somehow got poorly encoded, round to nearest
-        if (dropUnused)
-        {
-            usedValues.insert(labelval);
-        }
-        map<int32_t, int32_t>::iterator myiter = translate.find(labelval);
-        if (myiter == translate.end())
-        {
-            if (discardOthers)
-            {
-                labelsOut[node] = unusedLabel;
-            } else {//use a random color, but fully opaque for the label
-                GiftiLabel myLabel(labelval, AString("LABEL_") + AString::number(labelval), rand() & 255, rand() & 255, rand() & 255, 255);
-                if (myTable.getLabelKeyFromName(myLabel.getName()) != GiftiLabel::getInvalidLabelKey())
-                {
-                    AString nameBase = myLabel.getName(), newName;//resolve collision by generating a name with an additional number on it
-                    bool success = false;
-                    for (int extra = 1; extra < 100; ++extra)//but stop at 100, because really...
-                    {
-                        newName = nameBase + "_" + AString::number(extra);
-                        if (myTable.getLabelKeyFromName(newName) == GiftiLabel::getInvalidLabelKey())
-                        {
-                            success = true;
-                            break;
-                        }
-                    }
-                    if (success)
-                    {
-                        CaretLogWarning("name collision in auto-generated name '" + nameBase + "', changed to '" + newName + "'");
-                    } else {
-                        throw OperationException("giving up on resolving name collision for auto-generated name '" + nameBase + "'");
-                    }
-                    myLabel.setName(newName);
-                }
-                int32_t newValue = myTable.addLabel(&myLabel);//don't overwrite any values in the table
-                translate[labelval] = newValue;
-                labelsOut[node] = newValue;
-            }
-        } else {
-            labelsOut[node] = myiter->second;
-        }
-    }
-}
@@ -23,17 +23,10 @@
 
 #include "AbstractOperation.h"
 
-#include <map>
-#include <set>
-
 namespace caret {
     
-    class GiftiLabelTable;
-    
     class OperationMetricLabelImport : public AbstractOperation
     {
-        static void translateLabels(const float* valuesIn, int32_t* labelsOut, const int& numNodes, GiftiLabelTable& myTable, std::map<int32_t, int32_t>& translate,
-                             std::set<int32_t>& usedValues, const bool& dropUnused, const bool& discardOthers, const int32_t& unusedLabel);
     public:
         static OperationParameters* getParameters();
         static void useParameters(OperationParameters* myParams, ProgressObject* myProgObj);
@@ -168,7 +168,7 @@ void OperationMetricMath::useParameters(OperationParameters* myParams, ProgressO
     {
         if (varMetrics[i] == NULL) throw OperationException("no -var option specified for variable '" + myVarNames[i] + "'");
     }
-    vector<float> values(numVars), colScratch(numNodes);
+    vector<float> colScratch(numNodes);
     vector<const float*> columnPointers(numVars);
     myMetricOut->setNumberOfNodesAndColumns(numNodes, numColumns);
     myMetricOut->setStructure(myStructure);
@@ -183,18 +183,26 @@ void OperationMetricMath::useParameters(OperationParameters* myParams, ProgressO
                 columnPointers[v] = varMetrics[v]->getValuePointerForColumn(metricColumns[v]);
             }
         }
-        for (int i = 0; i < numNodes; ++i)
+        evaluateColumn(myExpr, columnPointers, numNodes, colScratch.data(), nanfix, nanfixval);
+        myMetricOut->setValuesForColumn(j, colScratch.data());
+    }
+}
+
+void OperationMetricMath::evaluateColumn(const CaretMathExpression& myExpr, const vector<const float*>& varColumns, const int& numNodes, float* colOut,
+                                         const bool& nanfix, const float& nanfixval)
+{
+    int numVars = (int)varColumns.size();
+    vector<float> values(numVars);
+    for (int i = 0; i < numNodes; ++i)
+    {
+        for (int v = 0; v < numVars; ++v)
         {
-            for (int v = 0; v < numVars; ++v)
-            {
-                values[v] = columnPointers[v][i];
-            }
-            colScratch[i] = (float)myExpr.evaluate(values);
-            if (nanfix && colScratch[i] != colScratch[i])
-            {
-                colScratch[i] = nanfixval;
-            }
+            values[v] = varColumns[v][i];
+        }
+        colOut[i] = (float)myExpr.evaluate(values);
+        if (nanfix && colOut[i] != colOut[i])
+        {
+            colOut[i] = nanfixval;
         }
-        myMetricOut->setValuesForColumn(j, colScratch.data());
     }
 }
@@ -23,8 +23,12 @@
 
 #include "AbstractOperation.h"
 
+#include <vector>
+
 namespace caret {
     
+    class CaretMathExpression;
+    
     class OperationMetricMath : public AbstractOperation
     {
     public:
@@ -32,6 +36,9 @@ namespace caret {
         static void useParameters(OperationParameters* myParams, ProgressObject* myProgObj);
         static AString getCommandSwitch();
         static AString getShortDescription();
+        ///evaluates the expression at each vertex of one output column, varColumns has a column of input values for each variable of the expression, in order
+        static void evaluateColumn(const CaretMathExpression& myExpr, const std::vector<const float*>& varColumns, const int& numNodes, float* colOut,
+                                   const bool& nanfix = false, const float& nanfixval = 0.0f);
     };
 
     typedef TemplateAutoOperation<OperationMetricMath> AutoOperationMetricMath;
@@ -19,7 +19,9 @@
  */
 /*LICENSE_END*/
 
+#include <algorithm>
 #include <cstdio>
+#include <exception>
 #include <fstream>
 
 #ifdef HAVE_OSMESA
@@ -33,17 +35,25 @@
 #include "Brain.h"
 #include "BrainOpenGLFixedPipeline.h"
 #include "BrainOpenGLViewportContent.h"
+#include "BrowserTabContent.h"
 #include "CaretAssert.h"
 #include "CaretLogger.h"
+#include "CaretMappableDataFile.h"
+#include "CaretOMP.h"
 #include "DataFileException.h"
 #include "EventBrowserTabGet.h"
 #include "EventManager.h"
+#include "EventMapYokingSelectMap.h"
+#include "EventSurfaceColoringInvalidate.h"
 #include "FileInformation.h"
 #include "DummyFontTextRenderer.h"
 #include "FtglFontTextRenderer.h"
 #include "ImageFile.h"
+#include "Matrix4x4.h"
 #include "OperationShowScene.h"
 #include "OperationException.h"
+#include "Overlay.h"
+#include "OverlaySet.h"
 #include "Scene.h"
 #include "SceneAttributes.h"
 #include "SceneClass.h"
@@ -99,6 +109,17 @@ OperationShowScene::getParameters()
 
     ret->addIntegerParameter(5, "image-height", "height of output image(s)");
     
+    OptionalParameter* mapsOpt = ret->createOptionalParameter(6, "-animate-maps", "render a frame for each map in a range of a layer's file");
+    mapsOpt->addIntegerParameter(1, "layer", "the layer to animate, starting at one for the top layer");
+    mapsOpt->addIntegerParameter(2, "first-map", "the first map to render, starting at one");
+    mapsOpt->addIntegerParameter(3, "last-map", "the last map to render, starting at one");
+    
+    OptionalParameter* rotateOpt = ret->createOptionalParameter(7, "-rotate", "rotate the view from one frame to the next");
+    rotateOpt->addDoubleParameter(1, "degrees", "degrees of rotation about the screen's vertical axis per frame");
+    
+    OptionalParameter* framesOpt = ret->createOptionalParameter(8, "-frames", "number of frames to render when not animating maps");
+    framesOpt->addIntegerParameter(1, "number", "the number of frames");
+    
     AString helpText("Render content of browser windows displayed in a scene "
                      "into image file(s).  The image file name should be "
                      "similar to \"capture.png\".  If there is only one image "
@@ -107,6 +128,15 @@ OperationShowScene::getParameters()
                      "into the image name: \"capture_01.png\", \"capture_02.png\" "
                      "etc.\n"
                      "\n"
+                     "To render a movie, use -animate-maps to step through maps "
+                     "(such as the timepoints of a series file) of a layer in each "
+                     "window's selected tab, and/or -rotate to turn the view a fixed "
+                     "angle per frame.  With -rotate alone, -frames gives the number of "
+                     "frames, which is required.  The scene is loaded only once and "
+                     "frames are numbered with at least four digits after the window's "
+                     "image name: \"capture_0001.png\", etc.  "
+                     "Frames are encoded and written to disk in parallel.\n"
+                     "\n"
                      "The image format is determined by the image file extension.\n"
                      "Image formats available on this system are:\n");
     
@@ -159,6 +189,55 @@ OperationShowScene::useParameters(OperationParameters* myParams,
         throw OperationException("image height is invalid");
     }
     
+    int32_t animateLayerIndex = -1;
+    int32_t firstMapIndex = 0;
+    int32_t lastMapIndex = 0;
+    int32_t numberOfFrames = 1;
+    OptionalParameter* mapsOpt = myParams->getOptionalParameter(6);
+    if (mapsOpt->m_present) {
+        animateLayerIndex = mapsOpt->getInteger(1) - 1;
+        if (animateLayerIndex < 0) {
+            throw OperationException("animation layer must be one or greater");
+        }
+        firstMapIndex = mapsOpt->getInteger(2) - 1;
+        lastMapIndex  = mapsOpt->getInteger(3) - 1;
+        if ((firstMapIndex < 0)
+            || (lastMapIndex < firstMapIndex)) {
+            throw OperationException("animation map range is invalid");
+        }
+        numberOfFrames = lastMapIndex - firstMapIndex + 1;
+    }
+    double degreesPerFrame = 0.0;
+    OptionalParameter* rotateOpt = myParams->getOptionalParameter(7);
+    if (rotateOpt->m_present) {
+        degreesPerFrame = rotateOpt->getDouble(1);
+    }
+    OptionalParameter* framesOpt = myParams->getOptionalParameter(8);
+    if (framesOpt->m_present) {
+        if (mapsOpt->m_present) {
+            throw OperationException("-frames may not be used with -animate-maps");
+        }
+        numberOfFrames = framesOpt->getInteger(1);
+        if (numberOfFrames < 1) {
+            throw OperationException("number of frames must be one or greater");
+        }
+    }
+    
+    if (rotateOpt->m_present
+        && ( ! framesOpt->m_present)
+        && ( ! mapsOpt->m_present)) {
+        throw OperationException("-rotate requires -frames or -animate-maps");
+    }
+    
+    /*
+     * Digits in frame number, at least four so that the frames of
+     * most movies sort in order by name.
+     */
+    int32_t frameNumberDigits = 4;
+    for (int32_t n = numberOfFrames; n >= 10000; n /= 10) {
+        frameNumberDigits++;
+    }
+    
     SceneFile sceneFile;
     sceneFile.readFile(sceneFileName);
     
@@ -312,17 +391,129 @@ OperationShowScene::useParameters(OperationParameters* myParams,
                 std::vector<BrainOpenGLViewportContent*> viewportContents;
                 viewportContents.push_back(&content);
                 
-                brainOpenGL->drawModels(viewportContents);
+                const AString windowImageFileName = ((numBrowserClasses > 1)
+                                                     ? insertImageNumber(imageFileName,
+                                                                         i + 1,
+                                                                         2)
+                                                     : imageFileName);
                 
-                const int32_t outputImageIndex = ((numBrowserClasses > 1)
-                                             ? i
-                                             : -1);
-                
-                writeImage(imageFileName,
-                           outputImageIndex,
-                           imageBuffer,
-                           imageWidth,
-                           imageHeight);
+                if (numberOfFrames == 1) {
+                    brainOpenGL->drawModels(viewportContents);
+                    
+                    writeImage(windowImageFileName,
+                               imageBuffer,
+                               imageWidth,
+                               imageHeight);
+                }
+                else {
+                    /*
+                     * Map selection and rotation are restored after
+                     * the window's frames are rendered
+                     */
+                    Overlay* animateOverlay = NULL;
+                    CaretMappableDataFile* animateMapFile = NULL;
+                    int32_t originalMapIndex = -1;
+                    if (animateLayerIndex >= 0) {
+                        OverlaySet* overlaySet = tabContent->getOverlaySet();
+                        if (animateLayerIndex >= overlaySet->getNumberOfDisplayedOverlays()) {
+                            throw OperationException("Animation layer "
+                                                     + AString::number(animateLayerIndex + 1)
+                                                     + " is not displayed in window "
+                                                     + AString::number(i + 1));
+                        }
+                        animateOverlay = overlaySet->getOverlay(animateLayerIndex);
+                        animateOverlay->getSelectionData(animateMapFile,
+                                                         originalMapIndex);
+                        if (animateMapFile == NULL) {
+                            throw OperationException("No file is selected in animation layer of window "
+                                                     + AString::number(i + 1));
+                        }
+                        if (lastMapIndex >= animateMapFile->getNumberOfMaps()) {
+                            throw OperationException("Animation map range exceeds the "
+                                                     + AString::number(animateMapFile->getNumberOfMaps())
+                                                     + " maps in "
+                                                     + animateMapFile->getFileNameNoPath());
+                        }
+                    }
+                    const Matrix4x4 originalRotationMatrix = tabContent->getRotationMatrix();
+                    
+                    /*
+                     * Scene content is shared by all drawing so frames are
+                     * rendered one at a time, but encoding and writing of images
+                     * is slow in comparison and is done in parallel for a
+                     * batch of rendered frames.
+                     */
+#ifdef CARET_OMP
+                    const int32_t framesPerBatch = std::max(1, omp_get_max_threads());
+#else  // CARET_OMP
+                    const int32_t framesPerBatch = 1;
+#endif // CARET_OMP
+                    const int64_t imageBytes = (static_cast<int64_t>(imageWidth) * imageHeight * 4);
+                    std::vector<std::vector<unsigned char> > frameImages(framesPerBatch);
+                    
+                    for (int32_t batchStart = 0; batchStart < numberOfFrames; batchStart += framesPerBatch) {
+                        const int32_t batchEnd = std::min(batchStart + framesPerBatch,
+                                                          numberOfFrames);
+                        for (int32_t iFrame = batchStart; iFrame < batchEnd; iFrame++) {
+                            if (animateOverlay != NULL) {
+                                selectAnimationMap(animateOverlay,
+                                                   animateMapFile,
+                                                   firstMapIndex + iFrame);
+                            }
+                            if (degreesPerFrame != 0.0) {
+                                Matrix4x4 rotationMatrix = originalRotationMatrix;
+                                rotationMatrix.rotateY(degreesPerFrame * iFrame);
+                                tabContent->setRotationMatrix(rotationMatrix);
+                            }
+                            
+                            brainOpenGL->drawModels(viewportContents);
+                            
+                            frameImages[iFrame - batchStart].assign(imageBuffer,
+                                                                    imageBuffer + imageBytes);
+                        }
+                        
+                        AString writeErrorMessage;
+#pragma omp CARET_PARFOR schedule(dynamic)
+                        for (int32_t iFrame = batchStart; iFrame < batchEnd; iFrame++) {
+                            try {
+                                writeImage(insertImageNumber(windowImageFileName,
+                                                             iFrame + 1,
+                                                             frameNumberDigits),
+                                           &frameImages[iFrame - batchStart][0],
+                                           imageWidth,
+                                           imageHeight);
+                            }
+                            catch (const CaretException& e) {
+#pragma omp critical
+                                {
+                                    if (writeErrorMessage.isEmpty()) {
+                                        writeErrorMessage = e.whatString();
+                                    }
+                                }
+                            }
+                            catch (const std::exception& e) {
+#pragma omp critical
+                                {
+                                    if (writeErrorMessage.isEmpty()) {
+                                        writeErrorMessage = AString("Writing image failed: ") + e.what();
+                                    }
+                                }
+                            }
+                        }
+                        if ( ! writeErrorMessage.isEmpty()) {
+                            throw OperationException(writeErrorMessage);
+                        }
+                    }
+                    
+                    if (animateOverlay != NULL) {
+                        selectAnimationMap(animateOverlay,
+                                           animateMapFile,
+                                           originalMapIndex);
+                    }
+                    if (degreesPerFrame != 0.0) {
+                        tabContent->setRotationMatrix(originalRotationMatrix);
+                    }
+                }
             }
         }
     }
@@ -341,13 +532,76 @@ OperationShowScene::useParameters(OperationParameters* myParams,
 }
 #endif // HAVE_OSMESA
 
+/**
+ * Select a map in the animated layer and update coloring.
+ *
+ * @param overlay
+ *     Overlay that is animated.
+ * @param mapFile
+ *     File selected in the overlay.
+ * @param mapIndex
+ *     Index of the map.
+ */
+void
+OperationShowScene::selectAnimationMap(Overlay* overlay,
+                                       CaretMappableDataFile* mapFile,
+                                       const int32_t mapIndex)
+{
+    overlay->setSelectionData(mapFile,
+                              mapIndex);
+    
+    const MapYokingGroupEnum::Enum mapYoking = overlay->getMapYokingGroup();
+    if (mapYoking != MapYokingGroupEnum::MAP_YOKING_GROUP_OFF) {
+        EventMapYokingSelectMap selectMapEvent(mapYoking,
+                                               mapFile,
+                                               mapIndex,
+                                               overlay->isEnabled());
+        EventManager::get()->sendEvent(selectMapEvent.getPointer());
+    }
+    
+    EventManager::get()->sendEvent(EventSurfaceColoringInvalidate().getPointer());
+}
+
+/**
+ * Insert a number into an image file name before the extension.
+ *
+ * @param imageFileName
+ *     Name of image file.
+ * @param imageNumber
+ *     Number inserted into the name.
+ * @param numberOfDigits
+ *     Minimum digits in the number, padded with zeros.
+ * @return
+ *     Name such as "capture_01.png".
+ */
+AString
+OperationShowScene::insertImageNumber(const AString& imageFileName,
+                                      const int32_t imageNumber,
+                                      const int32_t numberOfDigits)
+{
+    QString outputName(imageFileName);
+    const AString imageNumberText = QString("_%1").arg((int)imageNumber,
+                                                       numberOfDigits, // width
+                                                       10, // base
+                                                       QChar('0')); // fill character
+    const int dotOffset = outputName.lastIndexOf(".");
+    if (dotOffset >= 0) {
+        outputName.insert(dotOffset,
+                          imageNumberText);
+    }
+    else {
+        outputName += (imageNumberText
+                       + ".png");
+    }
+    
+    return outputName;
+}
+
 /**
  * Write the image data to a Image File.
  *
  * @param imageFileName
  *     Name of image file.
- * @param imageIndex
- *     Index of image.
  * @param imageContent
  *     content of image.
  * @param imageWidth
@@ -357,38 +611,17 @@ OperationShowScene::useParameters(OperationParameters* myParams,
  */
 void
 OperationShowScene::writeImage(const AString& imageFileName,
-                               const int32_t imageIndex,
                                const unsigned char* imageContent,
                                const int32_t imageWidth,
                                const int32_t imageHeight)
 {
-    /*
-     * Create name of image
-     */
-    QString outputName(imageFileName);
-    if (imageIndex >= 0) {
-        const AString imageNumber = QString("_%1").arg((int)(imageIndex + 1),
-                                                       2, // width
-                                                       10, // base
-                                                       QChar('0')); // fill character
-        const int dotOffset = outputName.lastIndexOf(".");
-        if (dotOffset >= 0) {
-            outputName.insert(dotOffset,
-                              imageNumber);
-        }
-        else {
-            outputName += (imageNumber
-                           + ".png");
-        }
-    }
-    
     try {
         //ImageFile imageFile(image);
         ImageFile imageFile(imageContent,
                             imageWidth,
                             imageHeight,
                             ImageFile::IMAGE_DATA_ORIGIN_AT_BOTTOM);
-        imageFile.writeFile(outputName);
+        imageFile.writeFile(imageFileName);
     }
     catch (const DataFileException& dfe) {
         throw OperationException(dfe);
@@ -26,6 +26,9 @@
 
 namespace caret {
 
+    class CaretMappableDataFile;
+    class Overlay;
+    
     class OperationShowScene : public AbstractOperation {
 
     public:
@@ -41,11 +44,18 @@ namespace caret {
         static bool isShowSceneCommandAvailable();
         
     private:
+        static void selectAnimationMap(Overlay* overlay,
+                                       CaretMappableDataFile* mapFile,
+                                       const int32_t mapIndex);
+        
+        static AString insertImageNumber(const AString& imageFileName,
+                                         const int32_t imageNumber,
+                                         const int32_t numberOfDigits);
+        
         static void writeImage(const AString& imageFileName,
-                                  const int32_t imageIndex,
-                                  const unsigned char* imageContent,
-                                  const int32_t imageWidth,
-                                  const int32_t imageHeight);
+                               const unsigned char* imageContent,
+                               const int32_t imageWidth,
+                               const int32_t imageHeight);
     };
 
     typedef TemplateAutoOperation<OperationShowScene> AutoOperationShowScene;
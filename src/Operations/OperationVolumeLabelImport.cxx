@@ -24,10 +24,11 @@
 #include "CaretLogger.h"
 #include "FileInformation.h"
 #include "GiftiLabel.h"
+#include "GiftiLabelTable.h"
+#include "LabelImportHelper.h"
 #include "VolumeFile.h"
 
 #include <cmath>
-#include <cstdlib>
 #include <cctype>
 #include <fstream>
 #include <map>
@@ -225,50 +226,7 @@ void OperationVolumeLabelImport::useParameters(OperationParameters* myParams, Pr
             for (int c = 0; c < myDims[4]; ++c)//hopefully noone wants a multi-component label volume, that would be silly, but do it anyway
             {
                 const float* frameIn = myVol->getFrame(s, c);//TODO: rework this when support is added for VolumeFile to handle non-float data
-                for (int i = 0; i < FRAMESIZE; ++i)
-                {
-                    int32_t labelval = (int32_t)floor(frameIn[i] + 0.5f);//just in case it somehow got poorly encoded, round to nearest
-                    if (dropUnused)
-                    {
-                        usedValues.insert(labelval);
-                    }
-                    map<int32_t, int32_t>::iterator myiter = translate.find(labelval);
-                    if (myiter == translate.end())
-                    {
-                        if (discardOthers)
-                        {
-                            frameOut[i] = unusedLabel;
-                        } else {//use a random color, but fully opaque for the label
-                            GiftiLabel myLabel(labelval, AString("LABEL_") + AString::number(labelval), rand() & 255, rand() & 255, rand() & 255, 255);
-                            if (myTable.getLabelKeyFromName(myLabel.getName()) != GiftiLabel::getInvalidLabelKey())
-                            {
-                                AString nameBase = myLabel.getName(), newName;//resolve collision by generating a name with an additional number on it
-                                bool success = false;
-                                for (int extra = 1; extra < 100; ++extra)//but stop at 100, because really...
-                                {
-                                    newName = nameBase + "_" + AString::number(extra);
-                                    if (myTable.getLabelKeyFromName(newName) == GiftiLabel::getInvalidLabelKey())
-                                    {
-                                        success = true;
-                                        break;
-                                    }
-                                }
-                                if (success)
-                                {
-                                    CaretLogWarning("name collision in auto-generated name '" + nameBase + "', changed to '" + newName + "'");
-                                } else {
-                                    throw OperationException("giving up on resolving name collision for auto-generated name '" + nameBase + "'");
-                                }
-                                myLabel.setName(newName);
-                            }
-                            int32_t newValue = myTable.addLabel(&myLabel);//don't overwrite any values in the table
-                            translate[labelval] = newValue;
-                            frameOut[i] = newValue;
-                        }
-                    } else {
-                        frameOut[i] = myiter->second;
-                    }
-                }
+                LabelImportHelper::translateLabels(frameIn, frameOut, FRAMESIZE, myTable, translate, usedValues, dropUnused, discardOthers, unusedLabel);
                 outVol->setFrame(frameOut, s, c);
             }
             if (dropUnused)
@@ -288,50 +246,7 @@ void OperationVolumeLabelImport::useParameters(OperationParameters* myParams, Pr
         for (int c = 0; c < myDims[4]; ++c)//hopefully noone wants a multi-component label volume, that would be silly, but do it anyway
         {
             const float* frameIn = myVol->getFrame(subvol, c);//TODO: rework this when support is added for VolumeFile to handle non-float data
-            for (int i = 0; i < FRAMESIZE; ++i)
-            {
-                int32_t labelval = (int32_t)floor(frameIn[i] + 0.5f);//just in case it somehow got poorly encoded, round to nearest
-                if (dropUnused)
-                {
-                    usedValues.insert(labelval);
-                }
-                map<int32_t, int32_t>::iterator myiter = translate.find(labelval);
-                if (myiter == translate.end())
-                {
-                    if (discardOthers)
-                    {
-                        frameOut[i] = unusedLabel;
-                    } else {//use a random color, but fully opaque for the label
-                        GiftiLabel myLabel(labelval, AString("LABEL_") + AString::number(labelval), rand() & 255, rand() & 255, rand() & 255, 255);
-                        if (myTable.getLabelKeyFromName(myLabel.getName()) != GiftiLabel::getInvalidLabelKey())
-                        {
-                            AString nameBase = myLabel.getName(), newName;//resolve collision by generating a name with an additional number on it
-                            bool success = false;
-                            for (int extra = 1; extra < 100; ++extra)//but stop at 100, because really...
-                            {
-                                newName = nameBase + "_" + AString::number(extra);
-                                if (myTable.getLabelKeyFromName(newName) == GiftiLabel::getInvalidLabelKey())
-                                {
-                                    success = true;
-                                    break;
-                                }
-                            }
-                            if (success)
-                            {
-                                CaretLogWarning("name collision in auto-generated name '" + nameBase + "', changed to '" + newName + "'");
-                            } else {
-                                throw OperationException("giving up on resolving name collision for auto-generated name '" + nameBase + "'");
-                            }
-                            myLabel.setName(newName);
-                        }
-                        int32_t newValue = myTable.addLabel(&myLabel);//don't overwrite any values in the table
-                        translate[labelval] = newValue;
-                        frameOut[i] = newValue;
-                    }
-                } else {
-                    frameOut[i] = myiter->second;
-                }
-            }
+            LabelImportHelper::translateLabels(frameIn, frameOut, FRAMESIZE, myTable, translate, usedValues, dropUnused, discardOthers, unusedLabel);
             outVol->setFrame(frameOut, 0, c);
         }
         if (dropUnused)
@@ -23,9 +23,19 @@
 #include "OperationParametersEnum.h"
 
 #include "CaretAssert.h"
+#include "CaretMutex.h"
 
 using namespace caret;
 
+namespace
+{
+    CaretMutex& getInitializeMutex()
+    {//function-local, so it exists even if the enum is first used while initializing another static
+        static CaretMutex s_initializeMutex;
+        return s_initializeMutex;
+    }
+}
+
 std::vector<OperationParametersEnum> OperationParametersEnum::enumData;
 bool OperationParametersEnum::initializedFlag = false;
     
@@ -73,10 +83,10 @@ OperationParametersEnum::~OperationParametersEnum()
 void
 OperationParametersEnum::initialize()
 {
+    CaretMutexLocker locker(&getInitializeMutex());//always lock, an unlocked check of the flag could see it set before the data it guards
     if (initializedFlag) {
         return;
     }
-    initializedFlag = true;
 
     enumData.push_back(OperationParametersEnum(SURFACE, 
                                     0, 
@@ -133,6 +143,7 @@ OperationParametersEnum::initialize()
                                     "Boolean", 
                                     "Boolean"));
     
+    initializedFlag = true;
 }
 
 /**
@@ -145,7 +156,7 @@ OperationParametersEnum::initialize()
 const OperationParametersEnum*
 OperationParametersEnum::findData(const Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
 
     size_t num = enumData.size();
     for (size_t i = 0; i < num; i++) {
@@ -167,7 +178,7 @@ OperationParametersEnum::findData(const Enum enumValue)
  */
 AString 
 OperationParametersEnum::toName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const OperationParametersEnum* enumInstance = findData(enumValue);
     return enumInstance->name;
@@ -186,7 +197,7 @@ OperationParametersEnum::toName(Enum enumValue) {
 OperationParametersEnum::Enum 
 OperationParametersEnum::fromName(const AString& name, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = SURFACE;
@@ -220,7 +231,7 @@ OperationParametersEnum::fromName(const AString& name, bool* isValidOut)
  */
 AString 
 OperationParametersEnum::toGuiName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const OperationParametersEnum* enumInstance = findData(enumValue);
     return enumInstance->guiName;
@@ -239,7 +250,7 @@ OperationParametersEnum::toGuiName(Enum enumValue) {
 OperationParametersEnum::Enum 
 OperationParametersEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = SURFACE;
@@ -273,7 +284,7 @@ OperationParametersEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 int32_t
 OperationParametersEnum::toIntegerCode(Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     const OperationParametersEnum* enumInstance = findData(enumValue);
     return enumInstance->integerCode;
 }
@@ -292,7 +303,7 @@ OperationParametersEnum::toIntegerCode(Enum enumValue)
 OperationParametersEnum::Enum
 OperationParametersEnum::fromIntegerCode(const int32_t integerCode, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = SURFACE;
@@ -327,7 +338,7 @@ OperationParametersEnum::fromIntegerCode(const int32_t integerCode, bool* isVali
 void
 OperationParametersEnum::getAllEnums(std::vector<OperationParametersEnum::Enum>& allEnums)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allEnums.clear();
     
@@ -349,7 +360,7 @@ OperationParametersEnum::getAllEnums(std::vector<OperationParametersEnum::Enum>&
 void
 OperationParametersEnum::getAllNames(std::vector<AString>& allNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allNames.clear();
     
@@ -375,7 +386,7 @@ OperationParametersEnum::getAllNames(std::vector<AString>& allNames, const bool
 void
 OperationParametersEnum::getAllGuiNames(std::vector<AString>& allGuiNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allGuiNames.clear();
     
@@ -24,9 +24,19 @@
 #undef __PALETTE_ENUMS_DECLARE__
 
 #include "CaretAssert.h"
+#include "CaretMutex.h"
 
 using namespace caret;
 
+namespace
+{
+    CaretMutex& getInitializeMutex()
+    {//function-local, so it exists even if the enum is first used while initializing another static
+        static CaretMutex s_initializeMutex;
+        return s_initializeMutex;
+    }
+}
+
 /**
  * Constructor.
  *
@@ -57,14 +67,16 @@ PaletteScaleModeEnum::~PaletteScaleModeEnum()
 void
 PaletteScaleModeEnum::initialize()
 {
+    CaretMutexLocker locker(&getInitializeMutex());//always lock, an unlocked check of the flag could see it set before the data it guards
     if (initializedFlag) {
         return;
     }
-    initializedFlag = true;
 
     enumData.push_back(PaletteScaleModeEnum(MODE_AUTO_SCALE, 0, "MODE_AUTO_SCALE", "Auto Scale"));
     enumData.push_back(PaletteScaleModeEnum(MODE_AUTO_SCALE_PERCENTAGE, 1, "MODE_AUTO_SCALE_PERCENTAGE", "Auto Scale - Percentage"));
     enumData.push_back(PaletteScaleModeEnum(MODE_USER_SCALE, 2, "MODE_USER_SCALE", "User Scale"));
+    
+    initializedFlag = true;
 }
 
 /**
@@ -294,13 +306,15 @@ PaletteThresholdTestEnum::~PaletteThresholdTestEnum()
 void
 PaletteThresholdTestEnum::initialize()
 {
+    CaretMutexLocker locker(&getInitializeMutex());//always lock, an unlocked check of the flag could see it set before the data it guards
     if (initializedFlag) {
         return;
     }
-    initializedFlag = true;
 
     enumData.push_back(PaletteThresholdTestEnum(THRESHOLD_TEST_SHOW_OUTSIDE, 0, "THRESHOLD_TEST_SHOW_OUTSIDE", "Show Data Outside Thresholds"));
     enumData.push_back(PaletteThresholdTestEnum(THRESHOLD_TEST_SHOW_INSIDE, 1, "THRESHOLD_TEST_SHOW_INSIDE", "Show Data Below Threshold"));
+    
+    initializedFlag = true;
 }
 
 /**
@@ -524,10 +538,10 @@ PaletteThresholdTypeEnum::~PaletteThresholdTypeEnum()
 void
 PaletteThresholdTypeEnum::initialize()
 {
+    CaretMutexLocker locker(&getInitializeMutex());//always lock, an unlocked check of the flag could see it set before the data it guards
     if (initializedFlag) {
         return;
     }
-    initializedFlag = true;
 
     enumData.push_back(PaletteThresholdTypeEnum(THRESHOLD_TYPE_OFF, 0, "THRESHOLD_TYPE_OFF", "Off"));
     if (PaletteThresholdTypeEnum::mappedThresholdsEnabled) {
@@ -538,6 +552,8 @@ PaletteThresholdTypeEnum::initialize()
     else {
         enumData.push_back(PaletteThresholdTypeEnum(THRESHOLD_TYPE_NORMAL, 1, "THRESHOLD_TYPE_NORMAL", "On"));
     }
+    
+    initializedFlag = true;
 }
 
 /**
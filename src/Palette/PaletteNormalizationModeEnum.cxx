@@ -25,9 +25,19 @@
 #undef __PALETTE_NORMALIZATION_MODE_ENUM_DECLARE__
 
 #include "CaretAssert.h"
+#include "CaretMutex.h"
 
 using namespace caret;
 
+namespace
+{
+    CaretMutex& getInitializeMutex()
+    {//function-local, so it exists even if the enum is first used while initializing another static
+        static CaretMutex s_initializeMutex;
+        return s_initializeMutex;
+    }
+}
+
     
 /**
  * \class caret::PaletteNormalizationModeEnum 
@@ -101,10 +111,10 @@ PaletteNormalizationModeEnum::~PaletteNormalizationModeEnum()
 void
 PaletteNormalizationModeEnum::initialize()
 {
+    CaretMutexLocker locker(&getInitializeMutex());//always lock, an unlocked check of the flag could see it set before the data it guards
     if (initializedFlag) {
         return;
     }
-    initializedFlag = true;
 
     enumData.push_back(PaletteNormalizationModeEnum(NORMALIZATION_ALL_MAP_DATA, 
                                     "NORMALIZATION_ALL_MAP_DATA", 
@@ -114,6 +124,7 @@ PaletteNormalizationModeEnum::initialize()
                                     "NORMALIZATION_SELECTED_MAP_DATA", 
                                     "Selected Map In File"));
     
+    initializedFlag = true;
 }
 
 /**
@@ -126,7 +137,7 @@ PaletteNormalizationModeEnum::initialize()
 const PaletteNormalizationModeEnum*
 PaletteNormalizationModeEnum::findData(const Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
 
     size_t num = enumData.size();
     for (size_t i = 0; i < num; i++) {
@@ -148,7 +159,7 @@ PaletteNormalizationModeEnum::findData(const Enum enumValue)
  */
 AString 
 PaletteNormalizationModeEnum::toName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const PaletteNormalizationModeEnum* enumInstance = findData(enumValue);
     return enumInstance->name;
@@ -167,7 +178,7 @@ PaletteNormalizationModeEnum::toName(Enum enumValue) {
 PaletteNormalizationModeEnum::Enum 
 PaletteNormalizationModeEnum::fromName(const AString& name, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = PaletteNormalizationModeEnum::enumData[0].enumValue;
@@ -201,7 +212,7 @@ PaletteNormalizationModeEnum::fromName(const AString& name, bool* isValidOut)
  */
 AString 
 PaletteNormalizationModeEnum::toGuiName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const PaletteNormalizationModeEnum* enumInstance = findData(enumValue);
     return enumInstance->guiName;
@@ -220,7 +231,7 @@ PaletteNormalizationModeEnum::toGuiName(Enum enumValue) {
 PaletteNormalizationModeEnum::Enum 
 PaletteNormalizationModeEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = PaletteNormalizationModeEnum::enumData[0].enumValue;
@@ -254,7 +265,7 @@ PaletteNormalizationModeEnum::fromGuiName(const AString& guiName, bool* isValidO
 int32_t
 PaletteNormalizationModeEnum::toIntegerCode(Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     const PaletteNormalizationModeEnum* enumInstance = findData(enumValue);
     return enumInstance->integerCode;
 }
@@ -273,7 +284,7 @@ PaletteNormalizationModeEnum::toIntegerCode(Enum enumValue)
 PaletteNormalizationModeEnum::Enum
 PaletteNormalizationModeEnum::fromIntegerCode(const int32_t integerCode, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = PaletteNormalizationModeEnum::enumData[0].enumValue;
@@ -308,7 +319,7 @@ PaletteNormalizationModeEnum::fromIntegerCode(const int32_t integerCode, bool* i
 void
 PaletteNormalizationModeEnum::getAllEnums(std::vector<PaletteNormalizationModeEnum::Enum>& allEnums)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allEnums.clear();
     
@@ -330,7 +341,7 @@ PaletteNormalizationModeEnum::getAllEnums(std::vector<PaletteNormalizationModeEn
 void
 PaletteNormalizationModeEnum::getAllNames(std::vector<AString>& allNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allNames.clear();
     
@@ -356,7 +367,7 @@ PaletteNormalizationModeEnum::getAllNames(std::vector<AString>& allNames, const
 void
 PaletteNormalizationModeEnum::getAllGuiNames(std::vector<AString>& allGuiNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allGuiNames.clear();
     
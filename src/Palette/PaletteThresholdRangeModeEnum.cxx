@@ -25,9 +25,19 @@
 #undef __PALETTE_THRESHOLD_RANGE_MODE_ENUM_DECLARE__
 
 #include "CaretAssert.h"
+#include "CaretMutex.h"
 
 using namespace caret;
 
+namespace
+{
+    CaretMutex& getInitializeMutex()
+    {//function-local, so it exists even if the enum is first used while initializing another static
+        static CaretMutex s_initializeMutex;
+        return s_initializeMutex;
+    }
+}
+
     
 /**
  * \class caret::PaletteThresholdRangeModeEnum 
@@ -69,10 +79,10 @@ PaletteThresholdRangeModeEnum::~PaletteThresholdRangeModeEnum()
 void
 PaletteThresholdRangeModeEnum::initialize()
 {
+    CaretMutexLocker locker(&getInitializeMutex());//always lock, an unlocked check of the flag could see it set before the data it guards
     if (initializedFlag) {
         return;
     }
-    initializedFlag = true;
 
     enumData.push_back(PaletteThresholdRangeModeEnum(PALETTE_THRESHOLD_RANGE_MODE_FILE, 
                                     "PALETTE_THRESHOLD_RANGE_MODE_FILE", 
@@ -86,6 +96,7 @@ PaletteThresholdRangeModeEnum::initialize()
                                     "PALETTE_THRESHOLD_RANGE_MODE_UNLIMITED", 
                                     "Unlimited"));
     
+    initializedFlag = true;
 }
 
 /**
@@ -98,7 +109,7 @@ PaletteThresholdRangeModeEnum::initialize()
 const PaletteThresholdRangeModeEnum*
 PaletteThresholdRangeModeEnum::findData(const Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
 
     size_t num = enumData.size();
     for (size_t i = 0; i < num; i++) {
@@ -120,7 +131,7 @@ PaletteThresholdRangeModeEnum::findData(const Enum enumValue)
  */
 AString 
 PaletteThresholdRangeModeEnum::toName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const PaletteThresholdRangeModeEnum* enumInstance = findData(enumValue);
     return enumInstance->name;
@@ -139,7 +150,7 @@ PaletteThresholdRangeModeEnum::toName(Enum enumValue) {
 PaletteThresholdRangeModeEnum::Enum 
 PaletteThresholdRangeModeEnum::fromName(const AString& name, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = PALETTE_THRESHOLD_RANGE_MODE_MAP;
@@ -173,7 +184,7 @@ PaletteThresholdRangeModeEnum::fromName(const AString& name, bool* isValidOut)
  */
 AString 
 PaletteThresholdRangeModeEnum::toGuiName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const PaletteThresholdRangeModeEnum* enumInstance = findData(enumValue);
     return enumInstance->guiName;
@@ -192,7 +203,7 @@ PaletteThresholdRangeModeEnum::toGuiName(Enum enumValue) {
 PaletteThresholdRangeModeEnum::Enum 
 PaletteThresholdRangeModeEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = PALETTE_THRESHOLD_RANGE_MODE_MAP;
@@ -226,7 +237,7 @@ PaletteThresholdRangeModeEnum::fromGuiName(const AString& guiName, bool* isValid
 int32_t
 PaletteThresholdRangeModeEnum::toIntegerCode(Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     const PaletteThresholdRangeModeEnum* enumInstance = findData(enumValue);
     return enumInstance->integerCode;
 }
@@ -245,7 +256,7 @@ PaletteThresholdRangeModeEnum::toIntegerCode(Enum enumValue)
 PaletteThresholdRangeModeEnum::Enum
 PaletteThresholdRangeModeEnum::fromIntegerCode(const int32_t integerCode, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = PALETTE_THRESHOLD_RANGE_MODE_MAP;
@@ -280,7 +291,7 @@ PaletteThresholdRangeModeEnum::fromIntegerCode(const int32_t integerCode, bool*
 void
 PaletteThresholdRangeModeEnum::getAllEnums(std::vector<PaletteThresholdRangeModeEnum::Enum>& allEnums)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allEnums.clear();
     
@@ -302,7 +313,7 @@ PaletteThresholdRangeModeEnum::getAllEnums(std::vector<PaletteThresholdRangeMode
 void
 PaletteThresholdRangeModeEnum::getAllNames(std::vector<AString>& allNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allNames.clear();
     
@@ -328,7 +339,7 @@ PaletteThresholdRangeModeEnum::getAllNames(std::vector<AString>& allNames, const
 void
 PaletteThresholdRangeModeEnum::getAllGuiNames(std::vector<AString>& allGuiNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allGuiNames.clear();
     
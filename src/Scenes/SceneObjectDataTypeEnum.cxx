@@ -25,9 +25,19 @@
 #undef __SCENE_OBJECT_DATA_TYPE_ENUM_DECLARE__
 
 #include "CaretAssert.h"
+#include "CaretMutex.h"
 
 using namespace caret;
 
+namespace
+{
+    CaretMutex& getInitializeMutex()
+    {//function-local, so it exists even if the enum is first used while initializing another static
+        static CaretMutex s_initializeMutex;
+        return s_initializeMutex;
+    }
+}
+
     
 /**
  * \class caret::SceneObjectDataTypeEnum 
@@ -74,10 +84,10 @@ SceneObjectDataTypeEnum::~SceneObjectDataTypeEnum()
 void
 SceneObjectDataTypeEnum::initialize()
 {
+    CaretMutexLocker locker(&getInitializeMutex());//always lock, an unlocked check of the flag could see it set before the data it guards
     if (initializedFlag) {
         return;
     }
-    initializedFlag = true;
 
     enumData.push_back(SceneObjectDataTypeEnum(SCENE_INVALID, 
                                                "SCENE_INVALID", 
@@ -119,6 +129,7 @@ SceneObjectDataTypeEnum::initialize()
                                                "string",
                                                "string"));
     
+    initializedFlag = true;
 }
 
 /**
@@ -131,7 +142,7 @@ SceneObjectDataTypeEnum::initialize()
 const SceneObjectDataTypeEnum*
 SceneObjectDataTypeEnum::findData(const Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
 
     size_t num = enumData.size();
     for (size_t i = 0; i < num; i++) {
@@ -153,7 +164,7 @@ SceneObjectDataTypeEnum::findData(const Enum enumValue)
  */
 AString 
 SceneObjectDataTypeEnum::toName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const SceneObjectDataTypeEnum* enumInstance = findData(enumValue);
     return enumInstance->name;
@@ -172,7 +183,7 @@ SceneObjectDataTypeEnum::toName(Enum enumValue) {
 SceneObjectDataTypeEnum::Enum 
 SceneObjectDataTypeEnum::fromName(const AString& name, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = SCENE_INVALID;
@@ -206,7 +217,7 @@ SceneObjectDataTypeEnum::fromName(const AString& name, bool* isValidOut)
  */
 AString 
 SceneObjectDataTypeEnum::toGuiName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const SceneObjectDataTypeEnum* enumInstance = findData(enumValue);
     return enumInstance->guiName;
@@ -225,7 +236,7 @@ SceneObjectDataTypeEnum::toGuiName(Enum enumValue) {
 SceneObjectDataTypeEnum::Enum 
 SceneObjectDataTypeEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = SCENE_INVALID;
@@ -259,7 +270,7 @@ SceneObjectDataTypeEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 int32_t
 SceneObjectDataTypeEnum::toIntegerCode(Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     const SceneObjectDataTypeEnum* enumInstance = findData(enumValue);
     return enumInstance->integerCode;
 }
@@ -278,7 +289,7 @@ SceneObjectDataTypeEnum::toIntegerCode(Enum enumValue)
 SceneObjectDataTypeEnum::Enum
 SceneObjectDataTypeEnum::fromIntegerCode(const int32_t integerCode, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = SCENE_INVALID;
@@ -313,7 +324,7 @@ SceneObjectDataTypeEnum::fromIntegerCode(const int32_t integerCode, bool* isVali
 void
 SceneObjectDataTypeEnum::getAllEnums(std::vector<SceneObjectDataTypeEnum::Enum>& allEnums)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allEnums.clear();
     
@@ -335,7 +346,7 @@ SceneObjectDataTypeEnum::getAllEnums(std::vector<SceneObjectDataTypeEnum::Enum>&
 void
 SceneObjectDataTypeEnum::getAllNames(std::vector<AString>& allNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allNames.clear();
     
@@ -361,7 +372,7 @@ SceneObjectDataTypeEnum::getAllNames(std::vector<AString>& allNames, const bool
 void
 SceneObjectDataTypeEnum::getAllGuiNames(std::vector<AString>& allGuiNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allGuiNames.clear();
     
@@ -387,7 +398,7 @@ SceneObjectDataTypeEnum::getAllGuiNames(std::vector<AString>& allGuiNames, const
 void
 SceneObjectDataTypeEnum::getAllXmlNames(std::vector<AString>& allXmlNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allXmlNames.clear();
     
@@ -411,7 +422,7 @@ SceneObjectDataTypeEnum::getAllXmlNames(std::vector<AString>& allXmlNames, const
  */
 AString 
 SceneObjectDataTypeEnum::toXmlName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const SceneObjectDataTypeEnum* enumInstance = findData(enumValue);
     return enumInstance->xmlName;
@@ -430,7 +441,7 @@ SceneObjectDataTypeEnum::toXmlName(Enum enumValue) {
 SceneObjectDataTypeEnum::Enum 
 SceneObjectDataTypeEnum::fromXmlName(const AString& xmlName, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = SCENE_INVALID;
@@ -25,9 +25,19 @@
 #undef __SCENE_TYPE_ENUM_DECLARE__
 
 #include "CaretAssert.h"
+#include "CaretMutex.h"
 
 using namespace caret;
 
+namespace
+{
+    CaretMutex& getInitializeMutex()
+    {//function-local, so it exists even if the enum is first used while initializing another static
+        static CaretMutex s_initializeMutex;
+        return s_initializeMutex;
+    }
+}
+
     
 /**
  * \class caret::SceneTypeEnum 
@@ -70,10 +80,10 @@ SceneTypeEnum::~SceneTypeEnum()
 void
 SceneTypeEnum::initialize()
 {
+    CaretMutexLocker locker(&getInitializeMutex());//always lock, an unlocked check of the flag could see it set before the data it guards
     if (initializedFlag) {
         return;
     }
-    initializedFlag = true;
 
     enumData.push_back(SceneTypeEnum(SCENE_TYPE_FULL, 
                                     "SCENE_TYPE_FULL", 
@@ -83,6 +93,7 @@ SceneTypeEnum::initialize()
                                     "SCENE_TYPE_GENERIC", 
                                     "Generic Scene"));
     
+    initializedFlag = true;
 }
 
 /**
@@ -95,7 +106,7 @@ SceneTypeEnum::initialize()
 const SceneTypeEnum*
 SceneTypeEnum::findData(const Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
 
     size_t num = enumData.size();
     for (size_t i = 0; i < num; i++) {
@@ -117,7 +128,7 @@ SceneTypeEnum::findData(const Enum enumValue)
  */
 AString 
 SceneTypeEnum::toName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const SceneTypeEnum* enumInstance = findData(enumValue);
     return enumInstance->name;
@@ -136,7 +147,7 @@ SceneTypeEnum::toName(Enum enumValue) {
 SceneTypeEnum::Enum 
 SceneTypeEnum::fromName(const AString& name, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = SCENE_TYPE_FULL;
@@ -170,7 +181,7 @@ SceneTypeEnum::fromName(const AString& name, bool* isValidOut)
  */
 AString 
 SceneTypeEnum::toGuiName(Enum enumValue) {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     const SceneTypeEnum* enumInstance = findData(enumValue);
     return enumInstance->guiName;
@@ -189,7 +200,7 @@ SceneTypeEnum::toGuiName(Enum enumValue) {
 SceneTypeEnum::Enum 
 SceneTypeEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = SCENE_TYPE_FULL;
@@ -223,7 +234,7 @@ SceneTypeEnum::fromGuiName(const AString& guiName, bool* isValidOut)
 int32_t
 SceneTypeEnum::toIntegerCode(Enum enumValue)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     const SceneTypeEnum* enumInstance = findData(enumValue);
     return enumInstance->integerCode;
 }
@@ -242,7 +253,7 @@ SceneTypeEnum::toIntegerCode(Enum enumValue)
 SceneTypeEnum::Enum
 SceneTypeEnum::fromIntegerCode(const int32_t integerCode, bool* isValidOut)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     bool validFlag = false;
     Enum enumValue = SCENE_TYPE_FULL;
@@ -277,7 +288,7 @@ SceneTypeEnum::fromIntegerCode(const int32_t integerCode, bool* isValidOut)
 void
 SceneTypeEnum::getAllEnums(std::vector<SceneTypeEnum::Enum>& allEnums)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allEnums.clear();
     
@@ -299,7 +310,7 @@ SceneTypeEnum::getAllEnums(std::vector<SceneTypeEnum::Enum>& allEnums)
 void
 SceneTypeEnum::getAllNames(std::vector<AString>& allNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allNames.clear();
     
@@ -325,7 +336,7 @@ SceneTypeEnum::getAllNames(std::vector<AString>& allNames, const bool isSorted)
 void
 SceneTypeEnum::getAllGuiNames(std::vector<AString>& allGuiNames, const bool isSorted)
 {
-    if (initializedFlag == false) initialize();
+    initialize();
     
     allGuiNames.clear();
     
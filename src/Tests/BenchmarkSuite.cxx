@@ -0,0 +1,607 @@
+/*LICENSE_START*/
+/*
+ *  Copyright (C) 2014  Washington University School of Medicine
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+/*LICENSE_END*/
+#include "BenchmarkSuite.h"
+
+#include "AlgorithmCiftiCorrelation.h"
+#include "AlgorithmCiftiParcellate.h"
+#include "AlgorithmMetricDilate.h"
+#include "AlgorithmMetricResample.h"
+#include "AlgorithmMetricSmoothing.h"
+#include "AlgorithmMetricTFCE.h"
+#include "AlgorithmSurfaceCreateSphere.h"
+#include "AlgorithmVolumeSmoothing.h"
+#include "CaretMathExpression.h"
+#include "CaretOMP.h"
+#include "CaretSparseFile.h"
+#include "CiftiFile.h"
+#include "ElapsedTimer.h"
+#include "MetricFile.h"
+#include "OperationMetricMath.h"
+#include "SurfaceFile.h"
+#include "VolumeFile.h"
+
+#include <QFile>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace caret;
+using namespace std;
+
+namespace
+{
+   ///the data must be the same on every run so that results are comparable, so don't use rand()
+   float pseudoRandom(uint32_t& state)
+   {
+      state = state * 1664525u + 1013904223u;
+      return (state >> 8) / 16777216.0f;
+   }
+}
+
+BenchmarkSuite::Settings::Settings()
+{
+   m_numVertices = 32492;
+   m_numMetricColumns = 10;
+   m_numTimepoints = 400;
+   m_volumeDim = 128;
+   m_numCorrelationRows = 4000;
+   m_numParcels = 100;
+   m_numSparseEntries = 200;
+   m_numRepeats = 3;
+   m_tempDirectory = ".";
+}
+
+BenchmarkSuite::BenchmarkSuite(const Settings& settings) : m_settings(settings)
+{
+   m_benchmarks.push_back(make_pair(AString("cifti-correlation"), &BenchmarkSuite::benchCiftiCorrelation));
+   m_benchmarks.push_back(make_pair(AString("metric-smoothing"), &BenchmarkSuite::benchMetricSmoothing));
+   m_benchmarks.push_back(make_pair(AString("volume-smoothing"), &BenchmarkSuite::benchVolumeSmoothing));
+   m_benchmarks.push_back(make_pair(AString("metric-resample"), &BenchmarkSuite::benchMetricResample));
+   m_benchmarks.push_back(make_pair(AString("cifti-parcellate"), &BenchmarkSuite::benchCiftiParcellate));
+   m_benchmarks.push_back(make_pair(AString("metric-dilate"), &BenchmarkSuite::benchMetricDilate));
+   m_benchmarks.push_back(make_pair(AString("metric-tfce"), &BenchmarkSuite::benchMetricTFCE));
+   m_benchmarks.push_back(make_pair(AString("metric-math"), &BenchmarkSuite::benchMetricMath));
+   m_benchmarks.push_back(make_pair(AString("cifti-write-ondisk"), &BenchmarkSuite::benchCiftiWriteOnDisk));
+   m_benchmarks.push_back(make_pair(AString("cifti-write-inmemory"), &BenchmarkSuite::benchCiftiWriteInMemory));
+   m_benchmarks.push_back(make_pair(AString("cifti-read-ondisk"), &BenchmarkSuite::benchCiftiReadOnDisk));
+   m_benchmarks.push_back(make_pair(AString("cifti-read-inmemory"), &BenchmarkSuite::benchCiftiReadInMemory));
+   m_benchmarks.push_back(make_pair(AString("gifti-write"), &BenchmarkSuite::benchGiftiWrite));
+   m_benchmarks.push_back(make_pair(AString("gifti-read"), &BenchmarkSuite::benchGiftiRead));
+   m_benchmarks.push_back(make_pair(AString("sparse-write"), &BenchmarkSuite::benchSparseWrite));
+   m_benchmarks.push_back(make_pair(AString("sparse-read"), &BenchmarkSuite::benchSparseRead));
+}
+
+BenchmarkSuite::~BenchmarkSuite()
+{
+   m_denseSeries.grabNew(NULL);//close anything that may still have a temporary file open before removing them
+   m_correlationSeries.grabNew(NULL);
+   m_denseLabel.grabNew(NULL);
+   for (int i = 0; i < (int)m_tempFiles.size(); ++i)
+   {
+      QFile::remove(m_tempFiles[i]);
+   }
+}
+
+vector<AString> BenchmarkSuite::getBenchmarkNames() const
+{
+   vector<AString> ret;
+   for (int i = 0; i < (int)m_benchmarks.size(); ++i)
+   {
+      ret.push_back(m_benchmarks[i].first);
+   }
+   return ret;
+}
+
+bool BenchmarkSuite::run(const AString& name)
+{
+   for (int i = 0; i < (int)m_benchmarks.size(); ++i)
+   {
+      if (m_benchmarks[i].first == name)
+      {
+         Result myResult;
+         myResult.m_name = name;
+         myResult.m_items = 0;
+         for (int repeat = 0; repeat < m_settings.m_numRepeats; ++repeat)
+         {
+            myResult.m_seconds.push_back((this->*(m_benchmarks[i].second))(myResult.m_items));
+         }
+         m_results.push_back(myResult);
+         return true;
+      }
+   }
+   return false;
+}
+
+void BenchmarkSuite::writeJSON(ostream& out) const
+{
+   int numThreads = 1;
+#ifdef CARET_OMP
+   numThreads = omp_get_max_threads();
+#endif
+   out << "{" << endl;
+   out << "   \"settings\": {" << endl;
+   out << "      \"vertices\": " << (m_sphere != NULL ? m_sphere->getNumberOfNodes() : m_settings.m_numVertices) << "," << endl;
+   out << "      \"metric_columns\": " << m_settings.m_numMetricColumns << "," << endl;
+   out << "      \"timepoints\": " << m_settings.m_numTimepoints << "," << endl;
+   out << "      \"volume_dim\": " << m_settings.m_volumeDim << "," << endl;
+   out << "      \"correlation_rows\": " << m_settings.m_numCorrelationRows << "," << endl;
+   out << "      \"parcels\": " << m_settings.m_numParcels << "," << endl;
+   out << "      \"sparse_entries\": " << m_settings.m_numSparseEntries << "," << endl;
+   out << "      \"repeats\": " << m_settings.m_numRepeats << "," << endl;
+   out << "      \"threads\": " << numThreads << endl;
+   out << "   }," << endl;
+   out << "   \"results\": [";
+   for (int i = 0; i < (int)m_results.size(); ++i)
+   {
+      const Result& myResult = m_results[i];
+      vector<double> sorted = myResult.m_seconds;
+      sort(sorted.begin(), sorted.end());
+      double median = 0.0;
+      if (!sorted.empty())
+      {
+         size_t half = sorted.size() / 2;
+         median = (sorted.size() % 2 == 1 ? sorted[half] : (sorted[half - 1] + sorted[half]) / 2.0);
+      }
+      out << (i == 0 ? "" : ",") << endl;
+      out << "      {" << endl;
+      out << "         \"name\": \"" << myResult.m_name << "\"," << endl;
+      out << "         \"items\": " << myResult.m_items << "," << endl;
+      out << "         \"seconds\": [";
+      for (int j = 0; j < (int)myResult.m_seconds.size(); ++j)
+      {
+         out << (j == 0 ? "" : ", ") << myResult.m_seconds[j];
+      }
+      out << "]," << endl;
+      out << "         \"min_seconds\": " << (sorted.empty() ? 0.0 : sorted[0]) << "," << endl;
+      out << "         \"median_seconds\": " << median << "," << endl;
+      out << "         \"items_per_second\": " << (median > 0.0 ? myResult.m_items / median : 0.0) << endl;
+      out << "      }";
+   }
+   out << endl << "   ]" << endl;
+   out << "}" << endl;
+}
+
+AString BenchmarkSuite::getTempFileName(const AString& suffix)
+{
+   AString ret = m_settings.m_tempDirectory + "/wb_benchmark_" + suffix;
+   if (find(m_tempFiles.begin(), m_tempFiles.end(), ret) == m_tempFiles.end())
+   {
+      m_tempFiles.push_back(ret);//removed by the destructor
+   }
+   return ret;
+}
+
+void BenchmarkSuite::makeSurfaces()
+{
+   if (m_sphere != NULL) return;
+   m_sphere.grabNew(new SurfaceFile());
+   AlgorithmSurfaceCreateSphere(NULL, m_settings.m_numVertices, m_sphere);//actual vertex count is only close to what was asked for
+   m_sphere->setStructure(StructureEnum::CORTEX_LEFT);
+   m_resampleSphere.grabNew(new SurfaceFile());
+   AlgorithmSurfaceCreateSphere(NULL, max(m_settings.m_numVertices / 2, 12), m_resampleSphere);
+   m_resampleSphere->setStructure(StructureEnum::CORTEX_LEFT);
+}
+
+void BenchmarkSuite::makeMetrics()
+{
+   if (m_metric != NULL) return;
+   makeSurfaces();
+   int32_t numNodes = m_sphere->getNumberOfNodes();
+   const float* coords = m_sphere->getCoordinateData();
+   uint32_t state = 1;
+   vector<float> scratch(numNodes);
+   m_metric.grabNew(new MetricFile());
+   m_metric->setNumberOfNodesAndColumns(numNodes, m_settings.m_numMetricColumns);
+   m_metric->setStructure(StructureEnum::CORTEX_LEFT);
+   for (int32_t col = 0; col < m_settings.m_numMetricColumns; ++col)
+   {//smooth blobs plus noise, so that TFCE and dilation have some structure to work on
+      for (int32_t i = 0; i < numNodes; ++i)
+      {
+         scratch[i] = 2.0f + 2.0f * sin(coords[i * 3] * (col + 1) / 20.0f) * cos(coords[i * 3 + 1] / 20.0f) + pseudoRandom(state) - 0.5f;
+      }
+      m_metric->setValuesForColumn(col, scratch.data());
+   }
+   m_dilateRoi.grabNew(new MetricFile());
+   m_dilateRoi->setNumberOfNodesAndColumns(numNodes, 1);
+   m_dilateRoi->setStructure(StructureEnum::CORTEX_LEFT);
+   for (int32_t i = 0; i < numNodes; ++i)
+   {
+      scratch[i] = (i % 10 == 0 ? 1.0f : 0.0f);//every tenth vertex is "bad"
+   }
+   m_dilateRoi->setValuesForColumn(0, scratch.data());
+}
+
+void BenchmarkSuite::makeVolume()
+{
+   if (m_volume != NULL) return;
+   int64_t dim = m_settings.m_volumeDim;
+   vector<int64_t> dims(3, dim);
+   vector<vector<float> > sform(3, vector<float>(4, 0.0f));
+   for (int i = 0; i < 3; ++i)
+   {
+      sform[i][i] = 2.0f;
+      sform[i][3] = -dim;
+   }
+   m_volume.grabNew(new VolumeFile(dims, sform));
+   uint32_t state = 2;
+   vector<float> frame(dim * dim * dim);
+   for (int64_t k = 0; k < dim; ++k)
+   {
+      for (int64_t j = 0; j < dim; ++j)
+      {
+         for (int64_t i = 0; i < dim; ++i)
+         {
+            frame[i + dim * (j + dim * k)] = sin(i / 8.0f) * cos(j / 8.0f) + sin(k / 8.0f) + pseudoRandom(state) - 0.5f;
+         }
+      }
+   }
+   m_volume->setFrame(frame.data());
+}
+
+void BenchmarkSuite::makeDenseSeries()
+{
+   if (m_denseSeries != NULL) return;
+   makeSurfaces();
+   int32_t numNodes = m_sphere->getNumberOfNodes();
+   CiftiBrainModelsMap brainModels;
+   brainModels.addSurfaceModel(numNodes, StructureEnum::CORTEX_LEFT);
+   m_denseSeriesXML = CiftiXML();
+   m_denseSeriesXML.setNumberOfDimensions(2);
+   m_denseSeriesXML.setMap(CiftiXML::ALONG_ROW, CiftiSeriesMap(m_settings.m_numTimepoints));
+   m_denseSeriesXML.setMap(CiftiXML::ALONG_COLUMN, brainModels);
+   m_denseSeries.grabNew(new CiftiFile());
+   m_denseSeries->setCiftiXML(m_denseSeriesXML);
+   uint32_t state = 3;
+   vector<float> scratch(m_settings.m_numTimepoints);
+   for (int32_t row = 0; row < numNodes; ++row)
+   {
+      float phase = (row % 97) / 10.0f;
+      for (int32_t t = 0; t < m_settings.m_numTimepoints; ++t)
+      {
+         scratch[t] = 100.0f + sin(t / 10.0f + phase) + pseudoRandom(state);
+      }
+      m_denseSeries->setRow(scratch.data(), row);
+   }
+}
+
+void BenchmarkSuite::makeCorrelationSeries()
+{
+   if (m_correlationSeries != NULL) return;
+   int32_t numRows = m_settings.m_numCorrelationRows;//the output is square, so this is kept separate from the vertex count
+   CiftiBrainModelsMap brainModels;
+   brainModels.addSurfaceModel(numRows, StructureEnum::CORTEX_LEFT);
+   CiftiXML myXML;
+   myXML.setNumberOfDimensions(2);
+   myXML.setMap(CiftiXML::ALONG_ROW, CiftiSeriesMap(m_settings.m_numTimepoints));
+   myXML.setMap(CiftiXML::ALONG_COLUMN, brainModels);
+   m_correlationSeries.grabNew(new CiftiFile());
+   m_correlationSeries->setCiftiXML(myXML);
+   uint32_t state = 4;
+   vector<float> scratch(m_settings.m_numTimepoints);
+   for (int32_t row = 0; row < numRows; ++row)
+   {
+      float phase = (row % 97) / 10.0f;
+      for (int32_t t = 0; t < m_settings.m_numTimepoints; ++t)
+      {
+         scratch[t] = sin(t / 10.0f + phase) + pseudoRandom(state);
+      }
+      m_correlationSeries->setRow(scratch.data(), row);
+   }
+}
+
+void BenchmarkSuite::makeDenseLabel()
+{
+   if (m_denseLabel != NULL) return;
+   makeSurfaces();
+   int32_t numNodes = m_sphere->getNumberOfNodes();
+   int32_t numParcels = max(1, min(m_settings.m_numParcels, numNodes));
+   CiftiBrainModelsMap brainModels;
+   brainModels.addSurfaceModel(numNodes, StructureEnum::CORTEX_LEFT);
+   CiftiLabelsMap labelsMap;
+   labelsMap.setLength(1);
+   labelsMap.setMapName(0, "parcels");
+   GiftiLabelTable* myTable = labelsMap.getMapLabelTable(0);
+   vector<int32_t> keys(numParcels);
+   for (int32_t p = 0; p < numParcels; ++p)
+   {
+      keys[p] = myTable->addLabel("parcel_" + AString::number(p + 1), (int32_t)((p * 53) % 256), (int32_t)((p * 97) % 256), (int32_t)((p * 193) % 256));
+   }
+   CiftiXML myXML;
+   myXML.setNumberOfDimensions(2);
+   myXML.setMap(CiftiXML::ALONG_ROW, labelsMap);
+   myXML.setMap(CiftiXML::ALONG_COLUMN, brainModels);
+   m_denseLabel.grabNew(new CiftiFile());
+   m_denseLabel->setCiftiXML(myXML);
+   for (int32_t row = 0; row < numNodes; ++row)
+   {
+      float value = keys[(int64_t)row * numParcels / numNodes];//contiguous parcels of about equal size
+      m_denseLabel->setRow(&value, row);
+   }
+}
+
+double BenchmarkSuite::benchCiftiCorrelation(int64_t& itemsOut)
+{
+   makeCorrelationSeries();
+   CiftiFile output;
+   ElapsedTimer timer;
+   timer.start();
+   AlgorithmCiftiCorrelation(NULL, m_correlationSeries, &output);
+   double ret = timer.getElapsedTimeSeconds();
+   itemsOut = (int64_t)m_settings.m_numCorrelationRows * m_settings.m_numCorrelationRows;
+   return ret;
+}
+
+double BenchmarkSuite::benchMetricSmoothing(int64_t& itemsOut)
+{
+   makeMetrics();
+   MetricFile output;
+   ElapsedTimer timer;
+   timer.start();
+   AlgorithmMetricSmoothing(NULL, m_sphere, m_metric, 4.0, &output);
+   double ret = timer.getElapsedTimeSeconds();
+   itemsOut = (int64_t)m_metric->getNumberOfNodes() * m_metric->getNumberOfColumns();
+   return ret;
+}
+
+double BenchmarkSuite::benchVolumeSmoothing(int64_t& itemsOut)
+{
+   makeVolume();
+   VolumeFile output;
+   ElapsedTimer timer;
+   timer.start();
+   AlgorithmVolumeSmoothing(NULL, m_volume, 4.0f, &output);
+   double ret = timer.getElapsedTimeSeconds();
+   itemsOut = (int64_t)m_settings.m_volumeDim * m_settings.m_volumeDim * m_settings.m_volumeDim;
+   return ret;
+}
+
+double BenchmarkSuite::benchMetricResample(int64_t& itemsOut)
+{
+   makeMetrics();
+   MetricFile output;
+   ElapsedTimer timer;
+   timer.start();
+   AlgorithmMetricResample(NULL, m_metric, m_sphere, m_resampleSphere, SurfaceResamplingMethodEnum::BARYCENTRIC, &output);
+   double ret = timer.getElapsedTimeSeconds();
+   itemsOut = (int64_t)m_resampleSphere->getNumberOfNodes() * m_metric->getNumberOfColumns();
+   return ret;
+}
+
+double BenchmarkSuite::benchCiftiParcellate(int64_t& itemsOut)
+{
+   makeDenseSeries();
+   makeDenseLabel();
+   CiftiFile output;
+   ElapsedTimer timer;
+   timer.start();
+   AlgorithmCiftiParcellate(NULL, m_denseSeries, m_denseLabel, CiftiXML::ALONG_COLUMN, &output);
+   double ret = timer.getElapsedTimeSeconds();
+   itemsOut = (int64_t)m_sphere->getNumberOfNodes() * m_settings.m_numTimepoints;
+   return ret;
+}
+
+double BenchmarkSuite::benchMetricDilate(int64_t& itemsOut)
+{
+   makeMetrics();
+   MetricFile output;
+   ElapsedTimer timer;
+   timer.start();
+   AlgorithmMetricDilate(NULL, m_metric, m_sphere, 10.0f, &output, m_dilateRoi);
+   double ret = timer.getElapsedTimeSeconds();
+   itemsOut = (int64_t)m_metric->getNumberOfNodes() * m_metric->getNumberOfColumns();
+   return ret;
+}
+
+double BenchmarkSuite::benchMetricTFCE(int64_t& itemsOut)
+{
+   makeMetrics();
+   MetricFile output;
+   ElapsedTimer timer;
+   timer.start();
+   AlgorithmMetricTFCE(NULL, m_sphere, m_metric, &output);
+   double ret = timer.getElapsedTimeSeconds();
+   itemsOut = (int64_t)m_metric->getNumberOfNodes() * m_metric->getNumberOfColumns();
+   return ret;
+}
+
+double BenchmarkSuite::benchMetricMath(int64_t& itemsOut)
+{//the evaluation used by -metric-math, without its parameter and file handling
+   makeMetrics();
+   int32_t numNodes = m_metric->getNumberOfNodes(), numCols = m_metric->getNumberOfColumns();
+   CaretMathExpression myExpr("exp(-abs(x)) * y + sin(x)");
+   vector<AString> varNames = myExpr.getVarNames();
+   int numVars = (int)varNames.size();
+   vector<const float*> varColumns(numVars);
+   vector<float> outCol(numNodes);
+   ElapsedTimer timer;
+   timer.start();
+   for (int32_t col = 0; col < numCols; ++col)
+   {
+      for (int v = 0; v < numVars; ++v)
+      {
+         varColumns[v] = m_metric->getValuePointerForColumn(varNames[v] == "x" ? col : (col + 1) % numCols);
+      }
+      OperationMetricMath::evaluateColumn(myExpr, varColumns, numNodes, outCol.data());
+   }
+   double ret = timer.getElapsedTimeSeconds();
+   itemsOut = (int64_t)numNodes * numCols;
+   return ret;
+}
+
+double BenchmarkSuite::benchCiftiWriteOnDisk(int64_t& itemsOut)
+{
+   makeDenseSeries();
+   AString fileName = getTempFileName("ondisk.dtseries.nii");
+   int64_t numRows = m_denseSeriesXML.getDimensionLength(CiftiXML::ALONG_COLUMN), rowLength = m_denseSeriesXML.getDimensionLength(CiftiXML::ALONG_ROW);
+   vector<float> scratch(rowLength);
+   ElapsedTimer timer;
+   timer.start();
+   {
+      CiftiFile output;
+      output.setWritingFile(fileName);
+      output.setCiftiXML(m_denseSeriesXML);
+      for (int64_t row = 0; row < numRows; ++row)
+      {
+         m_denseSeries->getRow(scratch.data(), row);
+         output.setRow(scratch.data(), row);
+      }
+   }//file is finished when it goes out of scope
+   double ret = timer.getElapsedTimeSeconds();
+   itemsOut = numRows * rowLength;
+   return ret;
+}
+
+double BenchmarkSuite::benchCiftiWriteInMemory(int64_t& itemsOut)
+{
+   makeDenseSeries();
+   AString fileName = getTempFileName("inmemory.dtseries.nii");
+   ElapsedTimer timer;
+   timer.start();
+   m_denseSeries->writeFile(fileName);
+   double ret = timer.getElapsedTimeSeconds();
+   itemsOut = m_denseSeriesXML.getDimensionLength(CiftiXML::ALONG_COLUMN) * m_denseSeriesXML.getDimensionLength(CiftiXML::ALONG_ROW);
+   return ret;
+}
+
+double BenchmarkSuite::benchCiftiReadOnDisk(int64_t& itemsOut)
+{
+   makeDenseSeries();
+   if (m_denseSeriesFileName.isEmpty())
+   {
+      m_denseSeriesFileName = getTempFileName("read.dtseries.nii");
+      m_denseSeries->writeFile(m_denseSeriesFileName);
+   }
+   int64_t numRows = m_denseSeriesXML.getDimensionLength(CiftiXML::ALONG_COLUMN), rowLength = m_denseSeriesXML.getDimensionLength(CiftiXML::ALONG_ROW);
+   vector<float> scratch(rowLength);
+   ElapsedTimer timer;
+   timer.start();
+   CiftiFile input(m_denseSeriesFileName);
+   for (int64_t row = 0; row < numRows; ++row)
+   {
+      input.getRow(scratch.data(), row);
+   }
+   double ret = timer.getElapsedTimeSeconds();
+   itemsOut = numRows * rowLength;
+   return ret;
+}
+
+double BenchmarkSuite::benchCiftiReadInMemory(int64_t& itemsOut)
+{
+   makeDenseSeries();
+   if (m_denseSeriesFileName.isEmpty())
+   {
+      m_denseSeriesFileName = getTempFileName("read.dtseries.nii");
+      m_denseSeries->writeFile(m_denseSeriesFileName);
+   }
+   ElapsedTimer timer;
+   timer.start();
+   CiftiFile input(m_denseSeriesFileName);
+   input.convertToInMemory();
+   double ret = timer.getElapsedTimeSeconds();
+   itemsOut = m_denseSeriesXML.getDimensionLength(CiftiXML::ALONG_COLUMN) * m_denseSeriesXML.getDimensionLength(CiftiXML::ALONG_ROW);
+   return ret;
+}
+
+double BenchmarkSuite::benchGiftiWrite(int64_t& itemsOut)
+{
+   makeMetrics();
+   AString fileName = getTempFileName("write.func.gii");
+   ElapsedTimer timer;
+   timer.start();
+   m_metric->writeFile(fileName);//metric arrays are written as gzipped base64
+   double ret = timer.getElapsedTimeSeconds();
+   itemsOut = (int64_t)m_metric->getNumberOfNodes() * m_metric->getNumberOfColumns();
+   return ret;
+}
+
+double BenchmarkSuite::benchGiftiRead(int64_t& itemsOut)
+{
+   makeMetrics();
+   if (m_metricFileName.isEmpty())
+   {
+      m_metricFileName = getTempFileName("read.func.gii");
+      m_metric->writeFile(m_metricFileName);
+   }
+   MetricFile input;
+   ElapsedTimer timer;
+   timer.start();
+   input.readFile(m_metricFileName);
+   double ret = timer.getElapsedTimeSeconds();
+   itemsOut = (int64_t)input.getNumberOfNodes() * input.getNumberOfColumns();
+   return ret;
+}
+
+double BenchmarkSuite::benchSparseWrite(int64_t& itemsOut)
+{
+   makeSurfaces();
+   int64_t numNodes = m_sphere->getNumberOfNodes();
+   int64_t numEntries = max((int64_t)1, min((int64_t)m_settings.m_numSparseEntries, numNodes));
+   int64_t step = numNodes / numEntries;
+   CiftiBrainModelsMap brainModels;
+   brainModels.addSurfaceModel(numNodes, StructureEnum::CORTEX_LEFT);
+   CiftiXML myXML;
+   myXML.setNumberOfDimensions(2);
+   myXML.setMap(CiftiXML::ALONG_ROW, brainModels);
+   myXML.setMap(CiftiXML::ALONG_COLUMN, brainModels);
+   AString fileName = getTempFileName("write.trajTEMP.wbsparse");
+   vector<int64_t> indices(numEntries), values(numEntries);
+   ElapsedTimer timer;
+   timer.start();
+   {
+      CaretSparseFileWriter writer(fileName, myXML);
+      for (int64_t row = 0; row < numNodes; ++row)
+      {
+         for (int64_t k = 0; k < numEntries; ++k)
+         {//evenly spaced and already sorted, as the writer expects
+            indices[k] = row % step + k * step;
+            values[k] = k + 1;
+         }
+         writer.writeRowSparse(row, indices, values);
+      }
+      writer.finish();
+   }
+   double ret = timer.getElapsedTimeSeconds();
+   if (m_sparseFileName.isEmpty()) m_sparseFileName = fileName;//keep the first one for the read benchmark
+   itemsOut = numNodes * numEntries;
+   return ret;
+}
+
+double BenchmarkSuite::benchSparseRead(int64_t& itemsOut)
+{
+   if (m_sparseFileName.isEmpty())
+   {
+      int64_t dummy;
+      benchSparseWrite(dummy);
+   }
+   vector<int64_t> indices, values;
+   int64_t total = 0;
+   ElapsedTimer timer;
+   timer.start();
+   CaretSparseFile input(m_sparseFileName);
+   int64_t numRows = input.getDimensions()[1];
+   for (int64_t row = 0; row < numRows; ++row)
+   {
+      input.getRowSparse(row, indices, values);
+      total += (int64_t)indices.size();
+   }
+   double ret = timer.getElapsedTimeSeconds();
+   itemsOut = total;
+   return ret;
+}
@@ -0,0 +1,109 @@
+#ifndef __BENCHMARK_SUITE_H__
+#define __BENCHMARK_SUITE_H__
+
+/*LICENSE_START*/
+/*
+ *  Copyright (C) 2014  Washington University School of Medicine
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+/*LICENSE_END*/
+#include "AString.h"
+#include "CaretPointer.h"
+#include "CiftiXML.h"
+
+#include <ostream>
+#include <stdint.h>
+#include <utility>
+#include <vector>
+
+namespace caret {
+
+   class CiftiFile;
+   class MetricFile;
+   class SurfaceFile;
+   class VolumeFile;
+
+   ///times algorithms and file I/O on generated data, the results are written as JSON so that runs can be compared by scripts
+   class BenchmarkSuite
+   {
+   public:
+      struct Settings
+      {
+         int32_t m_numVertices, m_numMetricColumns, m_numTimepoints, m_volumeDim;
+         int32_t m_numCorrelationRows, m_numParcels, m_numSparseEntries, m_numRepeats;
+         AString m_tempDirectory;
+         Settings();
+      };
+      BenchmarkSuite(const Settings& settings);
+      ~BenchmarkSuite();
+      std::vector<AString> getBenchmarkNames() const;
+      ///returns false if there is no benchmark with that name
+      bool run(const AString& name);
+      void writeJSON(std::ostream& out) const;
+   private:
+      BenchmarkSuite(const BenchmarkSuite&);
+      BenchmarkSuite& operator=(const BenchmarkSuite&);
+      
+      ///performs one repetition, returns the seconds spent in the timed part, and the number of elements processed in itemsOut
+      typedef double (BenchmarkSuite::*BenchmarkFunction)(int64_t& itemsOut);
+      
+      struct Result
+      {
+         AString m_name;
+         int64_t m_items;
+         std::vector<double> m_seconds;
+      };
+      
+      void makeSurfaces();
+      void makeMetrics();
+      void makeVolume();
+      void makeDenseSeries();
+      void makeCorrelationSeries();
+      void makeDenseLabel();
+      AString getTempFileName(const AString& suffix);
+      
+      double benchCiftiCorrelation(int64_t& itemsOut);
+      double benchMetricSmoothing(int64_t& itemsOut);
+      double benchVolumeSmoothing(int64_t& itemsOut);
+      double benchMetricResample(int64_t& itemsOut);
+      double benchCiftiParcellate(int64_t& itemsOut);
+      double benchMetricDilate(int64_t& itemsOut);
+      double benchMetricTFCE(int64_t& itemsOut);
+      double benchMetricMath(int64_t& itemsOut);
+      double benchCiftiWriteOnDisk(int64_t& itemsOut);
+      double benchCiftiWriteInMemory(int64_t& itemsOut);
+      double benchCiftiReadOnDisk(int64_t& itemsOut);
+      double benchCiftiReadInMemory(int64_t& itemsOut);
+      double benchGiftiWrite(int64_t& itemsOut);
+      double benchGiftiRead(int64_t& itemsOut);
+      double benchSparseWrite(int64_t& itemsOut);
+      double benchSparseRead(int64_t& itemsOut);
+      
+      Settings m_settings;
+      std::vector<std::pair<AString, BenchmarkFunction> > m_benchmarks;
+      std::vector<Result> m_results;
+      std::vector<AString> m_tempFiles;
+      
+      CaretPointer<SurfaceFile> m_sphere, m_resampleSphere;
+      CaretPointer<MetricFile> m_metric, m_dilateRoi;
+      CaretPointer<VolumeFile> m_volume;
+      CaretPointer<CiftiFile> m_denseSeries, m_correlationSeries, m_denseLabel;
+      CiftiXML m_denseSeriesXML;
+      AString m_denseSeriesFileName, m_metricFileName, m_sparseFileName;
+   };
+
+}
+#endif //__BENCHMARK_SUITE_H__
@@ -0,0 +1,97 @@
+/*LICENSE_START*/
+/*
+ *  Copyright (C) 2014  Washington University School of Medicine
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+/*LICENSE_END*/
+#include "DenseDynamicTest.h"
+
+#include "AlgorithmCiftiCorrelation.h"
+#include "CiftiConnectivityMatrixDenseDynamicFile.h"
+#include "CiftiFile.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+using namespace caret;
+using namespace std;
+
+DenseDynamicTest::DenseDynamicTest(const AString& identifier) : TestInterface(identifier)
+{
+}
+
+void DenseDynamicTest::execute()
+{
+    const int NUM_ROWS = 300, NUM_TIMEPOINTS = 80;
+    CiftiBrainModelsMap brainModels;
+    brainModels.addSurfaceModel(NUM_ROWS, StructureEnum::CORTEX_LEFT);
+    CiftiXML myXML;
+    myXML.setNumberOfDimensions(2);
+    myXML.setMap(CiftiXML::ALONG_ROW, CiftiSeriesMap(NUM_TIMEPOINTS));
+    myXML.setMap(CiftiXML::ALONG_COLUMN, brainModels);
+    CiftiFile mySeries;
+    mySeries.setCiftiXML(myXML);
+    vector<float> scratch(NUM_TIMEPOINTS);
+    for (int row = 0; row < NUM_ROWS; ++row)
+    {
+        float phase = (row % 17) / 3.0f;//many strongly correlated and anticorrelated rows, so values near +/-1 get checked
+        for (int t = 0; t < NUM_TIMEPOINTS; ++t)
+        {
+            scratch[t] = 100.0f + 10.0f * sin(t / 5.0f + phase) + rand() * 0.5f / RAND_MAX;
+        }
+        mySeries.setRow(scratch.data(), row);
+    }
+    CiftiFile myCorrelation;
+    AlgorithmCiftiCorrelation(NULL, &mySeries, &myCorrelation);//the general path, the dynamic file should match it
+    CiftiConnectivityMatrixDenseDynamicFile myDynamic;
+    myDynamic.updateAfterDataSeriesFileRead(&mySeries, "test.dtseries.nii");
+    myDynamic.setMapDataLoadingEnabled(0, true);
+    compareRows(myDynamic, myCorrelation, 0.0001f, "float");
+    myDynamic.setNormalizedDataMaximumBytes(0);//force 16-bit timeseries
+    compareRows(myDynamic, myCorrelation, 0.002f, "16-bit");
+}
+
+void DenseDynamicTest::compareRows(CiftiConnectivityMatrixDenseDynamicFile& dynamicFile, const CiftiFile& correlation, const float& tolerance, const AString& mode)
+{
+    const int64_t numRows = correlation.getNumberOfRows();
+    vector<float> dynamicRow, generalRow(correlation.getNumberOfColumns());
+    for (int64_t row = 0; row < numRows; row += 7)
+    {
+        dynamicFile.loadDataForRowIndex(row);
+        dynamicFile.getMapData(0, dynamicRow);
+        correlation.getRow(generalRow.data(), row);
+        if (dynamicRow.size() != generalRow.size())
+        {
+            setFailed("dynamic " + mode + " row " + AString::number(row) + " has length " + AString::number(dynamicRow.size()) + ", expected " + AString::number(generalRow.size()));
+            return;
+        }
+        for (int64_t col = 0; col < (int64_t)generalRow.size(); ++col)
+        {
+            if (dynamicRow[col] > 1.0f || dynamicRow[col] < -1.0f)
+            {
+                setFailed("dynamic " + mode + " correlation out of range at row " + AString::number(row) + ", column " + AString::number(col) + ": " + AString::number(dynamicRow[col]));
+                return;
+            }
+            if (abs(dynamicRow[col] - generalRow[col]) > tolerance)
+            {
+                setFailed("mismatch in " + mode + " correlation at row " + AString::number(row) + ", column " + AString::number(col) + ", general: " +
+                            AString::number(generalRow[col]) + ", dynamic: " + AString::number(dynamicRow[col]));
+                return;
+            }
+        }
+    }
+}
@@ -0,0 +1,144 @@
+/*LICENSE_START*/
+/*
+ *  Copyright (C) 2014  Washington University School of Medicine
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+/*LICENSE_END*/
+
+//program for timing algorithms and file I/O on generated data, prints JSON results
+
+#include <QCoreApplication>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#include "BenchmarkSuite.h"
+#include "CaretCommandLine.h"
+#include "CaretException.h"
+#include "SessionManager.h"
+
+using namespace std;
+using namespace caret;
+
+void printUsage(const BenchmarkSuite& mySuite)
+{
+    cerr << "usage: benchmark_driver [options] <benchmark>... | all" << endl << endl;
+    cerr << "options (defaults in parentheses):" << endl;
+    BenchmarkSuite::Settings defaults;
+    cerr << "   -vertices <n>          vertices of the generated sphere (" << defaults.m_numVertices << ")" << endl;
+    cerr << "   -metric-columns <n>    columns in the generated metric (" << defaults.m_numMetricColumns << ")" << endl;
+    cerr << "   -timepoints <n>        length of the generated dtseries (" << defaults.m_numTimepoints << ")" << endl;
+    cerr << "   -volume-dim <n>        size of each dimension of the generated volume (" << defaults.m_volumeDim << ")" << endl;
+    cerr << "   -correlation-rows <n>  rows of the dtseries used for correlation (" << defaults.m_numCorrelationRows << ")" << endl;
+    cerr << "   -parcels <n>           parcels in the generated dlabel (" << defaults.m_numParcels << ")" << endl;
+    cerr << "   -sparse-entries <n>    nonzero entries per row of the generated sparse file (" << defaults.m_numSparseEntries << ")" << endl;
+    cerr << "   -repeats <n>           times to run each benchmark (" << defaults.m_numRepeats << ")" << endl;
+    cerr << "   -temp-dir <dir>        where to put temporary files (" << defaults.m_tempDirectory << ")" << endl;
+    cerr << "   -output <file>         write the JSON results to a file instead of standard output" << endl << endl;
+    cerr << "benchmarks:" << endl;
+    vector<AString> names = mySuite.getBenchmarkNames();
+    for (int i = 0; i < (int)names.size(); ++i)
+    {
+        cerr << "   " << names[i] << endl;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    int ret = 0;
+    {
+        QCoreApplication myApp(argc, argv);
+        caret_global_commandLine_init(argc, argv);
+        SessionManager::createSessionManager(ApplicationTypeEnum::APPLICATION_TYPE_COMMAND_LINE);
+        try
+        {
+            BenchmarkSuite::Settings mySettings;
+            AString outputName;
+            vector<AString> toRun;
+            bool badArgs = false;
+            for (int i = 1; i < argc; ++i)
+            {
+                AString arg(argv[i]);
+                if (arg.startsWith("-"))
+                {
+                    if (i + 1 >= argc)
+                    {
+                        badArgs = true;
+                        break;
+                    }
+                    AString value(argv[++i]);
+                    bool ok = true;
+                    if (arg == "-vertices") mySettings.m_numVertices = value.toInt(&ok);
+                    else if (arg == "-metric-columns") mySettings.m_numMetricColumns = value.toInt(&ok);
+                    else if (arg == "-timepoints") mySettings.m_numTimepoints = value.toInt(&ok);
+                    else if (arg == "-volume-dim") mySettings.m_volumeDim = value.toInt(&ok);
+                    else if (arg == "-correlation-rows") mySettings.m_numCorrelationRows = value.toInt(&ok);
+                    else if (arg == "-parcels") mySettings.m_numParcels = value.toInt(&ok);
+                    else if (arg == "-sparse-entries") mySettings.m_numSparseEntries = value.toInt(&ok);
+                    else if (arg == "-repeats") mySettings.m_numRepeats = value.toInt(&ok);
+                    else if (arg == "-temp-dir") mySettings.m_tempDirectory = value;
+                    else if (arg == "-output") outputName = value;
+                    else ok = false;
+                    if (!ok)
+                    {
+                        cerr << "invalid option or value: " << arg << " " << value << endl;
+                        badArgs = true;
+                        break;
+                    }
+                } else {
+                    toRun.push_back(arg);
+                }
+            }
+            BenchmarkSuite mySuite(mySettings);
+            if (badArgs || toRun.empty())
+            {
+                printUsage(mySuite);
+                ret = 1;
+            } else {
+                if (toRun.size() == 1 && toRun[0] == "all")
+                {
+                    toRun = mySuite.getBenchmarkNames();
+                }
+                for (int i = 0; i < (int)toRun.size(); ++i)
+                {
+                    cerr << "running " << toRun[i] << endl;
+                    if (!mySuite.run(toRun[i]))
+                    {
+                        cerr << "unknown benchmark: " << toRun[i] << endl;
+                        ret = 1;
+                    }
+                }
+                if (outputName.isEmpty())
+                {
+                    mySuite.writeJSON(cout);
+                } else {
+                    ofstream outFile(outputName.toLocal8Bit().constData());
+                    if (!outFile)
+                    {
+                        throw CaretException("failed to open output file: " + outputName);
+                    }
+                    mySuite.writeJSON(outFile);
+                }
+            }
+        } catch (CaretException& e) {
+            cerr << "benchmark failed, exception: " << e.whatString() << endl;
+            ret = 1;
+        }
+        SessionManager::deleteSessionManager();
+    }
+    return ret;
+}